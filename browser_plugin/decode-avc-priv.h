@@ -74,7 +74,11 @@ struct AVC_Decoder {
 
     AVC_Video_Frame     *ad_Frames[NUM_FRAMES_BUFFERED];
 
-    AVC_Video_Frame     *ad_LastFrame;  /**< Last returned one, for freeing */
+    AVC_Video_Frame     *ad_DispFrames; /**< One per shared display buffer */
+
+    UWORD8              *ad_DispBufs[IVD_VIDDEC_MAX_IO_BUFFERS];
+
+    UWORD32             ad_NumDispBufs;
 
     int                 ad_NumBuffered;
 
@@ -96,12 +100,6 @@ struct AVC_Decoder {
 
     UWORD64 u8_ip_frm_ts;
 
-    UWORD8 *pBuf;
-
-    UWORD8 *yBuf;
-    UWORD8 *uBuf;
-    UWORD8 *vBuf;
-
     UWORD32 u4_num_cores;
 
     UWORD32 current_time;
@@ -179,6 +177,15 @@ int resetDecoder(AVC_Decoder *ad);
  */
 int resetPlugin(AVC_Decoder *ad);
 
+/**
+ *  API used for handing the display buffers to the decoder. The decoder
+ *  writes NV12 pictures straight into them and JS reads them in place
+ *
+ * @return
+ *      Success or Error.
+ */
+int setDisplayBuffers(AVC_Decoder *ad);
+
 /**
  *  to decode header and get the input stream params
  *
@@ -218,6 +225,8 @@ int AVC_Decoder_get_height(AVC_Decoder *ad);
 
 AVC_Video_Frame *AVC_Decoder_get_frame(AVC_Decoder *ad);
 
+void AVC_Decoder_release_frame(AVC_Decoder *ad, AVC_Video_Frame *avf);
+
 void AVC_Decoder_set_source(AVC_Decoder *ad, Buffer_Handler *handle);
 
 void AVC_Decoder_set_num_cores(AVC_Video_Init_Params *avip, int num_cores);
@@ -76,8 +76,10 @@ UWORD32 total_bytes_comsumed = 0;
 struct AVC_Video_Frame
 {
     void *y_Buffer;
-    void *u_Buffer;
-    void *v_Buffer;
+    void *u_Buffer;   /* Interleaved CbCr plane, NV12 */
+    void *v_Buffer;   /* Unused for NV12 */
+
+    UWORD32 disp_buf_id;
 
     iv_yuv_buf_t disp_stats;
 };
@@ -151,14 +153,6 @@ void AVC_Decoder_destroy(AVC_Decoder *ad, AVC_Video_Init_Params *avip)
         UWORD32 u4_num_mem_recs;
 
         Buffer_Handler_close(ad->ad_Buffer);
-        if(ad->ad_LastFrame != NULL)
-        {
-            free(ad->ad_LastFrame);
-        }
-        for(i = 0; i < ad->ad_NumBuffered; i++)
-        {
-            free(ad->ad_Frames[i]);
-        }
 
         if(ad->codec_obj)
         {
@@ -185,9 +179,14 @@ void AVC_Decoder_destroy(AVC_Decoder *ad, AVC_Video_Init_Params *avip)
             free(ad->ad_InputBuffer);
         }
 
-        if(ad->pBuf != NULL)
+        for(i = 0; i < (int) ad->ad_NumDispBufs; i++)
         {
-            free(ad->pBuf);
+            free(ad->ad_DispBufs[i]);
+        }
+
+        if(ad->ad_DispFrames != NULL)
+        {
+            free(ad->ad_DispFrames);
         }
         free(ad);
     }
@@ -418,7 +417,7 @@ int setProcessor(AVC_Decoder *ad)
     s_ctl_set_num_processor_ip.e_cmd = IVD_CMD_VIDEO_CTL;
     s_ctl_set_num_processor_ip.e_sub_cmd =
         (IVD_CONTROL_API_COMMAND_TYPE_T) IH264D_CMD_CTL_SET_PROCESSOR;
-    s_ctl_set_num_processor_ip.u4_arch = ARCH_X86_SSE42;
+    s_ctl_set_num_processor_ip.u4_arch = ARCH_WASM_SIMD128;
     s_ctl_set_num_processor_ip.u4_soc = SOC_GENERIC;
     s_ctl_set_num_processor_ip.u4_size = sizeof(ih264d_ctl_set_processor_ip_t);
     s_ctl_set_num_processor_op.u4_size = sizeof(ih264d_ctl_set_processor_op_t);
@@ -434,6 +433,98 @@ int setProcessor(AVC_Decoder *ad)
     return 0;
 }
 
+int setDisplayBuffers(AVC_Decoder *ad)
+{
+    WORD32 ret;
+    UWORD32 i;
+    UWORD32 outlen;
+    ivd_ctl_getbufinfo_ip_t s_ctl_ip;
+    ivd_ctl_getbufinfo_op_t s_ctl_op;
+    ivd_set_display_frame_ip_t *ps_set_display_frame_ip;
+    ivd_set_display_frame_op_t s_set_display_frame_op;
+
+    /* Sizes reported once the header is decoded match the stream, not the */
+    /* 4K maximum the instance was created for                             */
+    s_ctl_ip.e_cmd = IVD_CMD_VIDEO_CTL;
+    s_ctl_ip.e_sub_cmd = IVD_CMD_CTL_GETBUFINFO;
+    s_ctl_ip.u4_size = sizeof(ivd_ctl_getbufinfo_ip_t);
+    s_ctl_op.u4_size = sizeof(ivd_ctl_getbufinfo_op_t);
+
+    ret = ih264d_api_function((iv_obj_t *) ad->codec_obj, (void *) &s_ctl_ip, (void *) &s_ctl_op);
+    if(ret != IV_SUCCESS)
+    {
+        printf("\nError in Get Buf Info %x", s_ctl_op.u4_error_code);
+        return -1;
+    }
+
+    /* Frames queued for JS hold on to their buffers until released */
+    s_ctl_op.u4_num_disp_bufs += EXTRA_DISP_BUFFERS;
+    if(s_ctl_op.u4_num_disp_bufs > IVD_VIDDEC_MAX_IO_BUFFERS)
+    {
+        s_ctl_op.u4_num_disp_bufs = IVD_VIDDEC_MAX_IO_BUFFERS;
+    }
+
+    /* Too large for the stack of a WASM thread */
+    ps_set_display_frame_ip =
+        (ivd_set_display_frame_ip_t *) malloc(sizeof(ivd_set_display_frame_ip_t));
+    ad->ad_DispFrames =
+        (AVC_Video_Frame *) calloc(s_ctl_op.u4_num_disp_bufs, sizeof(AVC_Video_Frame));
+    if((NULL == ps_set_display_frame_ip) || (NULL == ad->ad_DispFrames))
+    {
+        printf("\nAllocation failure for display buffer descriptors");
+        free(ps_set_display_frame_ip);
+        return -1;
+    }
+
+    outlen = s_ctl_op.u4_min_out_buf_size[0];
+    if(s_ctl_op.u4_min_num_out_bufs > 1) outlen += s_ctl_op.u4_min_out_buf_size[1];
+
+    for(i = 0; i < s_ctl_op.u4_num_disp_bufs; i++)
+    {
+        ivd_out_bufdesc_t *ps_disp_buf = &ps_set_display_frame_ip->s_disp_buffer[i];
+
+        ad->ad_DispBufs[i] = (UWORD8 *) ih264a_aligned_malloc(64, outlen);
+        if(NULL == ad->ad_DispBufs[i])
+        {
+            printf("\nAllocation failure for display buffer of size %d", outlen);
+            free(ps_set_display_frame_ip);
+            return -1;
+        }
+        ad->ad_NumDispBufs++;
+
+        /* NV12: luma followed by the interleaved chroma plane */
+        ps_disp_buf->u4_min_out_buf_size[0] = s_ctl_op.u4_min_out_buf_size[0];
+        ps_disp_buf->u4_min_out_buf_size[1] = s_ctl_op.u4_min_out_buf_size[1];
+        ps_disp_buf->u4_min_out_buf_size[2] = 0;
+        ps_disp_buf->pu1_bufs[0] = ad->ad_DispBufs[i];
+        ps_disp_buf->pu1_bufs[1] = ad->ad_DispBufs[i] + s_ctl_op.u4_min_out_buf_size[0];
+        ps_disp_buf->pu1_bufs[2] = NULL;
+        ps_disp_buf->u4_num_bufs = s_ctl_op.u4_min_num_out_bufs;
+    }
+
+    ps_set_display_frame_ip->e_cmd = IVD_CMD_SET_DISPLAY_FRAME;
+    ps_set_display_frame_ip->u4_size = sizeof(ivd_set_display_frame_ip_t);
+    ps_set_display_frame_ip->num_disp_bufs = ad->ad_NumDispBufs;
+    s_set_display_frame_op.u4_size = sizeof(ivd_set_display_frame_op_t);
+
+    ret = ih264d_api_function((iv_obj_t *) ad->codec_obj, (void *) ps_set_display_frame_ip,
+                              (void *) &s_set_display_frame_op);
+    free(ps_set_display_frame_ip);
+    if(IV_SUCCESS != ret)
+    {
+        printf("\nError in Set display frame");
+        return -1;
+    }
+
+    /* Shared buffers start out held by the application; hand them all over */
+    for(i = 0; i < ad->ad_NumDispBufs; i++)
+    {
+        release_disp_frame(ad, i);
+    }
+
+    return 0;
+}
+
 int AVC_initDecoder(AVC_Decoder *ad, AVC_Video_Init_Params *avip)
 {
     WORD32 width = 0, height = 0;
@@ -446,15 +537,12 @@ int AVC_initDecoder(AVC_Decoder *ad, AVC_Video_Init_Params *avip)
     WORD32 ret;
     UWORD32 u4_ip_buf_len;
     UWORD8 *pu1_bs_buf = NULL;
-    ivd_out_bufdesc_t *ps_out_buf = NULL;
     void *pv_mem_rec_location;
 
     /***********************************************************************/
     /*                      Create decoder instance                        */
     /***********************************************************************/
     {
-        ps_out_buf = (ivd_out_bufdesc_t *) malloc(sizeof(ivd_out_bufdesc_t));
-
         {
             iv_num_mem_rec_ip_t s_no_of_mem_rec_query_ip;
             iv_num_mem_rec_op_t s_no_of_mem_rec_query_op;
@@ -500,9 +588,14 @@ int AVC_initDecoder(AVC_Decoder *ad, AVC_Video_Init_Params *avip)
             s_fill_mem_rec_ip.i4_level = MAX_LEVEL_SUPPORTED;
             s_fill_mem_rec_ip.u4_num_ref_frames = MAX_REF_FRAMES;
             s_fill_mem_rec_ip.u4_num_reorder_frames = MAX_REORDER_FRAMES;
-            s_fill_mem_rec_ip.u4_share_disp_buf = 0;
-            s_fill_mem_rec_ip.e_output_format = IV_YUV_420P;
+            s_fill_mem_rec_ip.u4_share_disp_buf = 1;
+            s_fill_mem_rec_ip.e_output_format = IV_YUV_420SP_UV;
             s_fill_mem_rec_ip.u4_num_extra_disp_buf = EXTRA_DISP_BUFFERS;
+            s_fill_mem_rec_ip.u4_alloc_per_sps = 0;
+            s_fill_mem_rec_ip.pe_mem_placement = NULL;
+            s_fill_mem_rec_ip.u4_mem_budget = 0;
+            s_fill_mem_rec_ip.u4_film_grain = 0;
+            s_fill_mem_rec_ip.u4_intra_only = 0;
 
             s_fill_mem_rec_ip.s_ivd_fill_mem_rec_ip_t.u4_size = sizeof(ih264d_fill_mem_rec_ip_t);
             s_fill_mem_rec_op.s_ivd_fill_mem_rec_op_t.u4_size = sizeof(ih264d_fill_mem_rec_op_t);
@@ -564,10 +657,14 @@ int AVC_initDecoder(AVC_Decoder *ad, AVC_Video_Init_Params *avip)
             s_init_ip.i4_level = MAX_LEVEL_SUPPORTED;
             s_init_ip.u4_num_ref_frames = MAX_REF_FRAMES;
             s_init_ip.u4_num_reorder_frames = MAX_REORDER_FRAMES;
-            s_init_ip.u4_share_disp_buf = 0;
+            s_init_ip.u4_share_disp_buf = 1;
             s_init_ip.u4_num_extra_disp_buf = EXTRA_DISP_BUFFERS;
+            s_init_ip.u4_alloc_per_sps = 0;
+            s_init_ip.u4_mem_budget = 0;
+            s_init_ip.u4_film_grain = 0;
+            s_init_ip.u4_intra_only = 0;
             s_init_ip.s_ivd_init_ip_t.u4_num_mem_rec = u4_num_mem_recs;
-            s_init_ip.s_ivd_init_ip_t.e_output_format = IV_YUV_420P;
+            s_init_ip.s_ivd_init_ip_t.e_output_format = IV_YUV_420SP_UV;
             s_init_ip.s_ivd_init_ip_t.u4_size = sizeof(ih264d_init_ip_t);
             s_init_op.s_ivd_init_op_t.u4_size = sizeof(ih264d_init_op_t);
 
@@ -584,7 +681,8 @@ int AVC_initDecoder(AVC_Decoder *ad, AVC_Video_Init_Params *avip)
             }
 
             /*****************************************************************************/
-            /*  Input and output buffer allocation */
+            /*  Input buffer allocation. Display buffers are shared with the decoder     */
+            /*  and are handed over by setDisplayBuffers() once the header is known      */
             /*****************************************************************************/
             {
                 ivd_ctl_getbufinfo_ip_t s_ctl_ip;
@@ -612,41 +710,6 @@ int AVC_initDecoder(AVC_Decoder *ad, AVC_Video_Init_Params *avip)
                     printf("\nAllocation failure for input buffer of i4_size");
                     return -1;
                 }
-                /* Allocate output buffer only if display buffers are not shared */
-                /* Or if shared and output is 420P */
-                {
-                    UWORD32 outlen;
-                    ps_out_buf->u4_min_out_buf_size[0] = s_ctl_op.u4_min_out_buf_size[0];
-                    ps_out_buf->u4_min_out_buf_size[1] = s_ctl_op.u4_min_out_buf_size[1];
-                    ps_out_buf->u4_min_out_buf_size[2] = s_ctl_op.u4_min_out_buf_size[2];
-
-                    outlen = s_ctl_op.u4_min_out_buf_size[0];
-                    if(s_ctl_op.u4_min_num_out_bufs > 1) outlen += s_ctl_op.u4_min_out_buf_size[1];
-
-                    if(s_ctl_op.u4_min_num_out_bufs > 2) outlen += s_ctl_op.u4_min_out_buf_size[2];
-
-                    ps_out_buf->pu1_bufs[0] = (UWORD8 *) malloc(outlen);
-
-                    if(ps_out_buf->pu1_bufs[0] == NULL)
-                    {
-                        printf("\nAllocation failure for output buffer of i4_size");
-                        return -1;
-                    }
-
-                    if(s_ctl_op.u4_min_num_out_bufs > 1)
-                    {
-                        ps_out_buf->pu1_bufs[1] =
-                            ps_out_buf->pu1_bufs[0] + (s_ctl_op.u4_min_out_buf_size[0]);
-                    }
-
-                    if(s_ctl_op.u4_min_num_out_bufs > 2)
-                    {
-                        ps_out_buf->pu1_bufs[2] =
-                            ps_out_buf->pu1_bufs[1] + (s_ctl_op.u4_min_out_buf_size[1]);
-                    }
-
-                    ps_out_buf->u4_num_bufs = s_ctl_op.u4_min_num_out_bufs;
-                }
             }
         }
     }
@@ -684,7 +747,7 @@ int AVC_initDecoder(AVC_Decoder *ad, AVC_Video_Init_Params *avip)
         s_ctl_set_num_processor_ip.e_cmd = IVD_CMD_VIDEO_CTL;
         s_ctl_set_num_processor_ip.e_sub_cmd =
             (IVD_CONTROL_API_COMMAND_TYPE_T) IH264D_CMD_CTL_SET_PROCESSOR;
-        s_ctl_set_num_processor_ip.u4_arch = ARCH_X86_GENERIC;
+        s_ctl_set_num_processor_ip.u4_arch = ARCH_WASM_GENERIC;
         s_ctl_set_num_processor_ip.u4_soc = SOC_GENERIC;
         s_ctl_set_num_processor_ip.u4_size = sizeof(ih264d_ctl_set_processor_ip_t);
         s_ctl_set_num_processor_op.u4_size = sizeof(ih264d_ctl_set_processor_op_t);
@@ -847,7 +910,7 @@ void AVC_Decoder_run(AVC_Decoder *ad, int multi_frame)
     UWORD64 u8_ip_frm_ts = 0, u8_op_frm_ts = 0;
     WORD32 u4_bytes_remaining = 0;
     UWORD32 i;
-    UWORD32 u4_ip_buf_len = (1920 * 1080 * 3) / 2;
+    UWORD32 u4_ip_buf_len;
     UWORD32 frm_cnt = 0;
     UWORD32 max_op_frm_ts;
 
@@ -877,32 +940,20 @@ void AVC_Decoder_run(AVC_Decoder *ad, int multi_frame)
         }
         ad->is_header_decoded = 1;
         setParams(ad, ad->frame_width);
-    }
-
-    if(NULL == ad->ad_InputBuffer)
-    {
-        ad->ad_InputBuffer =
-            (unsigned char *) malloc((ad->frame_width * ad->frame_height * 3) >> 1);
-    }
-
-    if(NULL == ad->pBuf)
-    {
-        ad->pBuf = (uint8_t *) malloc((ad->frame_width * ad->frame_height * 3) >> 1);
-    }
-
-    if(NULL == ad->yBuf)
-    {
-        ad->yBuf = (uint8_t *) malloc(ad->frame_width * ad->frame_height);
-    }
 
-    if(NULL == ad->uBuf)
-    {
-        ad->uBuf = (uint8_t *) malloc((ad->frame_width * ad->frame_height) >> 2);
+        status = setDisplayBuffers(ad);
+        if(0 != status)
+        {
+            printf("failed to set display buffers, return error");
+            return;
+        }
     }
 
-    if(NULL == ad->vBuf)
+    /* Reads must not run past the input buffer sized from the stream */
+    u4_ip_buf_len = (ad->frame_width * ad->frame_height * 3) >> 1;
+    if(NULL == ad->ad_InputBuffer)
     {
-        ad->vBuf = (uint8_t *) malloc((ad->frame_width * ad->frame_height) >> 2);
+        ad->ad_InputBuffer = (unsigned char *) malloc(u4_ip_buf_len);
     }
 
     size_t frame_size = 0;
@@ -925,23 +976,13 @@ void AVC_Decoder_run(AVC_Decoder *ad, int multi_frame)
         WORD32 timeDelay, timeTaken;
         size_t timeStampIx;
 
-        size_t sizeY = ad->frame_width * ad->frame_height;
-        size_t sizeUV;
-
-        sizeUV = sizeY / 4;
-
         s_video_decode_ip.e_cmd = IVD_CMD_VIDEO_DECODE;
         s_video_decode_ip.u4_ts = ad->u8_ip_frm_ts;
         s_video_decode_ip.pv_stream_buffer = ad->ad_InputBuffer;
         s_video_decode_ip.u4_num_Bytes = u4_bytes_remaining;
         s_video_decode_ip.u4_size = sizeof(ivd_video_decode_ip_t);
-        s_video_decode_ip.s_out_buffer.u4_min_out_buf_size[0] = sizeY;
-        s_video_decode_ip.s_out_buffer.u4_min_out_buf_size[1] = sizeUV;
-        s_video_decode_ip.s_out_buffer.u4_min_out_buf_size[2] = sizeUV;
-        s_video_decode_ip.s_out_buffer.pu1_bufs[0] = ad->yBuf;
-        s_video_decode_ip.s_out_buffer.pu1_bufs[1] = ad->uBuf;
-        s_video_decode_ip.s_out_buffer.pu1_bufs[2] = ad->vBuf;
-        s_video_decode_ip.s_out_buffer.u4_num_bufs = 3;
+        /* Pictures land in the shared display buffers, nothing to convert into */
+        memset(&s_video_decode_ip.s_out_buffer, 0, sizeof(ivd_out_bufdesc_t));
         s_video_decode_op.u4_size = sizeof(ivd_video_decode_op_t);
 
         IV_API_CALL_STATUS_T status;
@@ -954,6 +995,13 @@ void AVC_Decoder_run(AVC_Decoder *ad, int multi_frame)
         total_bytes_comsumed += u4_num_bytes_dec;
         Buffer_Handler_update_pos(ad->ad_Buffer, file_pos);
 
+        /* Every display buffer is still held by JS; retry once frames are released */
+        if((IV_SUCCESS != status) &&
+           (IVD_DEC_REF_BUF_NULL == (s_video_decode_op.u4_error_code & 0xFF)))
+        {
+            return;
+        }
+
         ad->u8_ip_frm_ts++;
 
         ad->output_present = s_video_decode_op.u4_output_present;
@@ -988,10 +1036,11 @@ void AVC_Decoder_run(AVC_Decoder *ad, int multi_frame)
             }
 
             AVC_Video_Frame *avf;
-            avf = (AVC_Video_Frame *) malloc(sizeof(AVC_Video_Frame));
-            avf->y_Buffer = (unsigned char *) ad->yBuf;
-            avf->u_Buffer = (unsigned char *) ad->uBuf;
-            avf->v_Buffer = (unsigned char *) ad->vBuf;
+            avf = &ad->ad_DispFrames[s_video_decode_op.u4_disp_buf_id];
+            avf->y_Buffer = s_video_decode_op.s_disp_frm_buf.pv_y_buf;
+            avf->u_Buffer = s_video_decode_op.s_disp_frm_buf.pv_u_buf;
+            avf->v_Buffer = NULL;
+            avf->disp_buf_id = s_video_decode_op.u4_disp_buf_id;
 
             avf->disp_stats = s_video_decode_op.s_disp_frm_buf;
             // Append the buffered frame
@@ -1137,12 +1186,8 @@ void *AVC_Video_Frame_get_v_buffer(AVC_Video_Frame *avf)
 
 AVC_Video_Frame *AVC_Decoder_get_frame(AVC_Decoder *ad)
 {
-    // free up the memory from any previous frame returned
-    if(ad->ad_LastFrame != NULL)
-    {
-        free(ad->ad_LastFrame);
-        ad->ad_LastFrame = NULL;
-    }
+    // The frame points into a decoder display buffer, which stays with JS
+    // until it calls AVC_Decoder_release_frame()
     if(ad->ad_NumBuffered > 0)
     {
         AVC_Video_Frame *frame;
@@ -1154,9 +1199,16 @@ AVC_Video_Frame *AVC_Decoder_get_frame(AVC_Decoder *ad)
             memmove(ad->ad_Frames, &ad->ad_Frames[1],
                     ad->ad_NumBuffered * sizeof(AVC_Video_Frame *));
         }
-        // Hang on to this refernce so we can free the memory
-        ad->ad_LastFrame = frame;
         return frame;
     }
     return NULL;
 }
+
+void AVC_Decoder_release_frame(AVC_Decoder *ad, AVC_Video_Frame *avf)
+{
+    if((ad == NULL) || (avf == NULL))
+    {
+        return;
+    }
+    release_disp_frame(ad, avf->disp_buf_id);
+}
@@ -171,6 +171,8 @@ static INLINE UWORD32 CTZ(UWORD32 u4_word)
 #define NOP(nop_cnt)    {UWORD32 nop_i; for (nop_i = 0; nop_i < nop_cnt; nop_i++);}
 
 
+#define PREFETCH(ptr, type) __builtin_prefetch(ptr);
+
 #define MEM_ALIGN8 __attribute__ ((aligned (8)))
 #define MEM_ALIGN16 __attribute__ ((aligned (16)))
 #define MEM_ALIGN32 __attribute__ ((aligned (32)))
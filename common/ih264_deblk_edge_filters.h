@@ -191,4 +191,17 @@ ih264_deblk_chroma_edge_bslt4_ft ih264_deblk_chroma_horz_bslt4_ssse3;
 ih264_deblk_chroma_edge_bslt4_ft ih264_deblk_chroma_vert_bslt4_mbaff_ssse3;
 ih264_deblk_chroma_edge_bslt4_ft ih264_deblk_chroma_horz_bslt4_mbaff_ssse3;
 
+/*WASM SIMD128*/
+ih264_deblk_edge_bs4_ft ih264_deblk_luma_horz_bs4_simd128;
+ih264_deblk_edge_bs4_ft ih264_deblk_luma_vert_bs4_simd128;
+
+ih264_deblk_edge_bslt4_ft ih264_deblk_luma_horz_bslt4_simd128;
+ih264_deblk_edge_bslt4_ft ih264_deblk_luma_vert_bslt4_simd128;
+
+ih264_deblk_chroma_edge_bs4_ft ih264_deblk_chroma_vert_bs4_simd128;
+ih264_deblk_chroma_edge_bs4_ft ih264_deblk_chroma_horz_bs4_simd128;
+
+ih264_deblk_chroma_edge_bslt4_ft ih264_deblk_chroma_vert_bslt4_simd128;
+ih264_deblk_chroma_edge_bslt4_ft ih264_deblk_chroma_horz_bslt4_simd128;
+
 #endif /* IH264_DEBLK_H_ */
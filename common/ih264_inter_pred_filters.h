@@ -244,6 +244,27 @@ ih264_inter_pred_luma_ft ih264_inter_pred_luma_horz_hpel_vert_qpel_ssse3;
 
 ih264_inter_pred_chroma_ft ih264_inter_pred_chroma_ssse3;
 
+/* WASM SIMD128 Intrinsic Declarations */
+ih264_inter_pred_luma_ft ih264_inter_pred_luma_copy_simd128;
+
+ih264_inter_pred_luma_ft ih264_inter_pred_luma_horz_simd128;
+
+ih264_inter_pred_luma_ft ih264_inter_pred_luma_vert_simd128;
+
+ih264_inter_pred_luma_ft ih264_inter_pred_luma_horz_hpel_vert_hpel_simd128;
+
+ih264_inter_pred_luma_ft ih264_inter_pred_luma_horz_qpel_simd128;
+
+ih264_inter_pred_luma_ft ih264_inter_pred_luma_vert_qpel_simd128;
+
+ih264_inter_pred_luma_ft ih264_inter_pred_luma_horz_qpel_vert_qpel_simd128;
+
+ih264_inter_pred_luma_ft ih264_inter_pred_luma_horz_qpel_vert_hpel_simd128;
+
+ih264_inter_pred_luma_ft ih264_inter_pred_luma_horz_hpel_vert_qpel_simd128;
+
+ih264_inter_pred_chroma_ft ih264_inter_pred_chroma_simd128;
+
 #endif
 
 /** Nothing past this point */
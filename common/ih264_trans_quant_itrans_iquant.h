@@ -197,5 +197,14 @@ ih264_iquant_itrans_recon_chroma_ft ih264_iquant_itrans_recon_chroma_4x4_sse42;
 ih264_ihadamard_scaling_ft ih264_ihadamard_scaling_4x4_sse42;
 ih264_hadamard_quant_ft ih264_hadamard_quant_4x4_sse42;
 ih264_hadamard_quant_ft ih264_hadamard_quant_2x2_uv_sse42;
+/*WASM SIMD128 Declarations*/
+ih264_iquant_itrans_recon_ft ih264_iquant_itrans_recon_4x4_simd128;
+ih264_iquant_itrans_recon_ft ih264_iquant_itrans_recon_4x4_dc_simd128;
+ih264_iquant_itrans_recon_ft ih264_iquant_itrans_recon_8x8_simd128;
+ih264_iquant_itrans_recon_ft ih264_iquant_itrans_recon_8x8_dc_simd128;
+ih264_iquant_itrans_recon_chroma_ft
+    ih264_iquant_itrans_recon_chroma_4x4_simd128;
+ih264_iquant_itrans_recon_chroma_ft
+    ih264_iquant_itrans_recon_chroma_4x4_dc_simd128;
 
 #endif /* IH264_TRANS_QUANT_H_ */
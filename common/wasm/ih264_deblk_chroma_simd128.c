@@ -0,0 +1,398 @@
+/* Copyright (c) [2020]-[2023] Ittiam Systems Pvt. Ltd.
+   All rights reserved.
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted (subject to the limitations in the
+   disclaimer below) provided that the following conditions are met:
+   •    Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+   •    Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+   •    None of the names of Ittiam Systems Pvt. Ltd., its affiliates,
+   investors, business partners, nor the names of its contributors may be
+   used to endorse or promote products derived from this software without
+   specific prior written permission.
+
+   NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED
+   BY THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+   BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+   FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+   HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+   OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+   WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+   OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+   EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+   This Software is an implementation of the AVC/H.264
+   standard by Ittiam Systems Pvt. Ltd. (“Ittiam”).
+   Additional patent licenses may be required for this Software,
+   including, but not limited to, a license from MPEG LA’s AVC/H.264
+   licensing program (see https://www.mpegla.com/programs/avc-h-264/).
+
+   NOTWITHSTANDING ANYTHING TO THE CONTRARY, THIS DOES NOT GRANT ANY
+   EXPRESS OR IMPLIED LICENSES TO ANY PATENT CLAIMS OF ANY AFFILIATE
+   (TO THE EXTENT NOT IN THE LEGAL ENTITY), INVESTOR, OR OTHER
+   BUSINESS PARTNER OF ITTIAM. You may only use this software or
+   modifications thereto for purposes that are authorized by
+   appropriate patent licenses. You should seek legal advice based
+   upon your implementation details.
+
+---------------------------------------------------------------
+*/
+/*****************************************************************************/
+/*                                                                           */
+/*  File Name         : ih264_deblk_chroma_simd128.c                         */
+/*                                                                           */
+/*  Description       : Contains function definitions for the deblocking     */
+/*                      edge filters of interleaved chroma in WebAssembly    */
+/*                      SIMD128 intrinsics. Cb and Cr stay interleaved in    */
+/*                      the lanes, with alpha, beta and tc alternating to    */
+/*                      match.                                               */
+/*                                                                           */
+/*  List of Functions : ih264_deblk_chroma_vert_bs4_simd128()                */
+/*                      ih264_deblk_chroma_horz_bs4_simd128()                */
+/*                      ih264_deblk_chroma_vert_bslt4_simd128()              */
+/*                      ih264_deblk_chroma_horz_bslt4_simd128()              */
+/*                                                                           */
+/*  Issues / Problems : None                                                 */
+/*                                                                           */
+/*****************************************************************************/
+/*****************************************************************************/
+/*  File Includes                                                            */
+/*****************************************************************************/
+
+#include <stddef.h>
+#include <wasm_simd128.h>
+#include "ih264_typedefs.h"
+#include "ih264_macros.h"
+#include "ih264_deblk_edge_filters.h"
+
+/*****************************************************************************/
+/*  Static Function Definitions                                              */
+/*****************************************************************************/
+
+/*
+ * Loads the 8 rows of a vertical chroma edge and returns p1, p0, q0 and q1
+ * with a CbCr pair of a row in each 16 bit lane of the 8 bit vectors
+ */
+static __inline void ih264_load_chroma_vert_edge_simd128(UWORD8 *pu1_src,
+                                                         WORD32 src_strd,
+                                                         v128_t *pix_16x8b) {
+  v128_t r0, r1, r2, r3, t0, t1, t2, t3;
+
+  r0 = wasm_v128_load64_zero(pu1_src);
+  r0 = wasm_v128_load64_lane(pu1_src + src_strd, r0, 1);
+  r1 = wasm_v128_load64_zero(pu1_src + 2 * src_strd);
+  r1 = wasm_v128_load64_lane(pu1_src + 3 * src_strd, r1, 1);
+  r2 = wasm_v128_load64_zero(pu1_src + 4 * src_strd);
+  r2 = wasm_v128_load64_lane(pu1_src + 5 * src_strd, r2, 1);
+  r3 = wasm_v128_load64_zero(pu1_src + 6 * src_strd);
+  r3 = wasm_v128_load64_lane(pu1_src + 7 * src_strd, r3, 1);
+
+  t0 = wasm_i16x8_shuffle(r0, r1, 0, 4, 8, 12, 1, 5, 9, 13);
+  t1 = wasm_i16x8_shuffle(r0, r1, 2, 6, 10, 14, 3, 7, 11, 15);
+  t2 = wasm_i16x8_shuffle(r2, r3, 0, 4, 8, 12, 1, 5, 9, 13);
+  t3 = wasm_i16x8_shuffle(r2, r3, 2, 6, 10, 14, 3, 7, 11, 15);
+
+  pix_16x8b[0] = wasm_i64x2_shuffle(t0, t2, 0, 2);
+  pix_16x8b[1] = wasm_i64x2_shuffle(t0, t2, 1, 3);
+  pix_16x8b[2] = wasm_i64x2_shuffle(t1, t3, 0, 2);
+  pix_16x8b[3] = wasm_i64x2_shuffle(t1, t3, 1, 3);
+}
+
+/* Stores back the vectors of ih264_load_chroma_vert_edge_simd128() */
+static __inline void ih264_store_chroma_vert_edge_simd128(UWORD8 *pu1_src,
+                                                          WORD32 src_strd,
+                                                          v128_t *pix_16x8b) {
+  v128_t s0, s1, s2, s3, r;
+
+  s0 = wasm_i16x8_shuffle(pix_16x8b[0], pix_16x8b[1], 0, 8, 1, 9, 2, 10, 3,
+                          11);
+  s1 = wasm_i16x8_shuffle(pix_16x8b[2], pix_16x8b[3], 0, 8, 1, 9, 2, 10, 3,
+                          11);
+  s2 = wasm_i16x8_shuffle(pix_16x8b[0], pix_16x8b[1], 4, 12, 5, 13, 6, 14, 7,
+                          15);
+  s3 = wasm_i16x8_shuffle(pix_16x8b[2], pix_16x8b[3], 4, 12, 5, 13, 6, 14, 7,
+                          15);
+
+  r = wasm_i32x4_shuffle(s0, s1, 0, 4, 1, 5);
+  wasm_v128_store64_lane(pu1_src, r, 0);
+  wasm_v128_store64_lane(pu1_src + src_strd, r, 1);
+  r = wasm_i32x4_shuffle(s0, s1, 2, 6, 3, 7);
+  wasm_v128_store64_lane(pu1_src + 2 * src_strd, r, 0);
+  wasm_v128_store64_lane(pu1_src + 3 * src_strd, r, 1);
+  r = wasm_i32x4_shuffle(s2, s3, 0, 4, 1, 5);
+  wasm_v128_store64_lane(pu1_src + 4 * src_strd, r, 0);
+  wasm_v128_store64_lane(pu1_src + 5 * src_strd, r, 1);
+  r = wasm_i32x4_shuffle(s2, s3, 2, 6, 3, 7);
+  wasm_v128_store64_lane(pu1_src + 6 * src_strd, r, 0);
+  wasm_v128_store64_lane(pu1_src + 7 * src_strd, r, 1);
+}
+
+/*
+ * Filters 8 interleaved samples, pix_8x16b[] holding p1, p0, q0 and q1.
+ * With a NULL tc the bs = 4 filter is applied, else the bs < 4 filter
+ * with tc0 + 1 in tc and 0 in the lanes of a zero bs
+ */
+static __inline void ih264_deblk_chroma_8x16b_simd128(v128_t *pix_8x16b,
+                                                      v128_t alpha_8x16b,
+                                                      v128_t beta_8x16b,
+                                                      const v128_t *pv_tc) {
+  v128_t p1 = pix_8x16b[0], p0 = pix_8x16b[1];
+  v128_t q0 = pix_8x16b[2], q1 = pix_8x16b[3];
+  v128_t mask, np0, nq0;
+  const v128_t two_8x16b = wasm_i16x8_splat(2);
+
+  mask = wasm_i16x8_lt(wasm_i16x8_abs(wasm_i16x8_sub(p0, q0)), alpha_8x16b);
+  mask = wasm_v128_and(
+      mask, wasm_i16x8_lt(wasm_i16x8_abs(wasm_i16x8_sub(q1, q0)), beta_8x16b));
+  mask = wasm_v128_and(
+      mask, wasm_i16x8_lt(wasm_i16x8_abs(wasm_i16x8_sub(p1, p0)), beta_8x16b));
+
+  if (NULL == pv_tc) {
+    np0 = wasm_i16x8_add(wasm_i16x8_shl(p1, 1), wasm_i16x8_add(p0, q1));
+    np0 = wasm_u16x8_shr(wasm_i16x8_add(np0, two_8x16b), 2);
+    nq0 = wasm_i16x8_add(wasm_i16x8_shl(q1, 1), wasm_i16x8_add(q0, p1));
+    nq0 = wasm_u16x8_shr(wasm_i16x8_add(nq0, two_8x16b), 2);
+  } else {
+    v128_t delta;
+
+    mask = wasm_v128_and(mask, wasm_i16x8_ne(*pv_tc, wasm_i16x8_splat(0)));
+    delta = wasm_i16x8_add(wasm_i16x8_shl(wasm_i16x8_sub(q0, p0), 2),
+                           wasm_i16x8_sub(p1, q1));
+    delta = wasm_i16x8_shr(wasm_i16x8_add(delta, wasm_i16x8_splat(4)), 3);
+    delta = wasm_i16x8_max(wasm_i16x8_min(delta, *pv_tc),
+                           wasm_i16x8_neg(*pv_tc));
+    np0 = wasm_i16x8_add(p0, delta);
+    nq0 = wasm_i16x8_sub(q0, delta);
+  }
+  pix_8x16b[1] = wasm_v128_bitselect(np0, p0, mask);
+  pix_8x16b[2] = wasm_v128_bitselect(nq0, q0, mask);
+}
+
+/*
+ * Filters the 16 interleaved samples across an edge, 4 samples per edge
+ * of u4_bs, or all of them at bs = 4 if pu1_cliptab_cb is NULL
+ */
+static void ih264_deblk_chroma_16x8b_simd128(
+    v128_t *pix_16x8b, WORD32 alpha_cb, WORD32 beta_cb, WORD32 alpha_cr,
+    WORD32 beta_cr, UWORD32 u4_bs, const UWORD8 *pu1_cliptab_cb,
+    const UWORD8 *pu1_cliptab_cr) {
+  v128_t lo_8x16b[4], hi_8x16b[4], alpha_8x16b, beta_8x16b;
+  WORD32 k;
+
+  alpha_8x16b = wasm_i16x8_make(alpha_cb, alpha_cr, alpha_cb, alpha_cr,
+                                alpha_cb, alpha_cr, alpha_cb, alpha_cr);
+  beta_8x16b = wasm_i16x8_make(beta_cb, beta_cr, beta_cb, beta_cr, beta_cb,
+                               beta_cr, beta_cb, beta_cr);
+
+  for (k = 0; k < 4; k++) {
+    lo_8x16b[k] = wasm_u16x8_extend_low_u8x16(pix_16x8b[k]);
+    hi_8x16b[k] = wasm_u16x8_extend_high_u8x16(pix_16x8b[k]);
+  }
+
+  if (NULL == pu1_cliptab_cb) {
+    ih264_deblk_chroma_8x16b_simd128(lo_8x16b, alpha_8x16b, beta_8x16b, NULL);
+    ih264_deblk_chroma_8x16b_simd128(hi_8x16b, alpha_8x16b, beta_8x16b, NULL);
+  } else {
+    WORD16 ai2_tc[4][2];
+    v128_t tc_8x16b;
+
+    for (k = 0; k < 4; k++) {
+      UWORD8 u1_bs = (UWORD8) (u4_bs >> ((3 - k) << 3));
+
+      ai2_tc[k][0] = u1_bs ? pu1_cliptab_cb[u1_bs] + 1 : 0;
+      ai2_tc[k][1] = u1_bs ? pu1_cliptab_cr[u1_bs] + 1 : 0;
+    }
+    tc_8x16b = wasm_i16x8_make(ai2_tc[0][0], ai2_tc[0][1], ai2_tc[0][0],
+                               ai2_tc[0][1], ai2_tc[1][0], ai2_tc[1][1],
+                               ai2_tc[1][0], ai2_tc[1][1]);
+    ih264_deblk_chroma_8x16b_simd128(lo_8x16b, alpha_8x16b, beta_8x16b,
+                                     &tc_8x16b);
+    tc_8x16b = wasm_i16x8_make(ai2_tc[2][0], ai2_tc[2][1], ai2_tc[2][0],
+                               ai2_tc[2][1], ai2_tc[3][0], ai2_tc[3][1],
+                               ai2_tc[3][0], ai2_tc[3][1]);
+    ih264_deblk_chroma_8x16b_simd128(hi_8x16b, alpha_8x16b, beta_8x16b,
+                                     &tc_8x16b);
+  }
+
+  pix_16x8b[1] = wasm_u8x16_narrow_i16x8(lo_8x16b[1], hi_8x16b[1]);
+  pix_16x8b[2] = wasm_u8x16_narrow_i16x8(lo_8x16b[2], hi_8x16b[2]);
+}
+
+/*****************************************************************************/
+/*  Function Definitions                                                     */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264_deblk_chroma_vert_bs4_simd128                      */
+/*                                                                           */
+/*  Description   : This function performs filtering of a chroma block       */
+/*                  vertical edge when the boundary strength is set to 4 in  */
+/*                  high profile                                             */
+/*                                                                           */
+/*  Inputs        : pu1_src    - pointer to the src sample q0 of U           */
+/*                  src_strd   - source stride                               */
+/*                  alpha_cb   - alpha value for the boundary in U           */
+/*                  beta_cb    - beta value for the boundary in U            */
+/*                  alpha_cr   - alpha value for the boundary in V           */
+/*                  beta_cr    - beta value for the boundary in V            */
+/*                                                                           */
+/*  Globals       : None                                                     */
+/*                                                                           */
+/*  Processing    : This operation is described in Sec. 8.7.2.4 under the    */
+/*                  title "Filtering process for edges for bS equal to 4"    */
+/*                  in ITU T Rec H.264.                                      */
+/*                                                                           */
+/*  Outputs       : None                                                     */
+/*                                                                           */
+/*  Returns       : None                                                     */
+/*                                                                           */
+/*****************************************************************************/
+void ih264_deblk_chroma_vert_bs4_simd128(UWORD8 *pu1_src, WORD32 src_strd,
+                                         WORD32 alpha_cb, WORD32 beta_cb,
+                                         WORD32 alpha_cr, WORD32 beta_cr) {
+  v128_t pix_16x8b[4];
+
+  ih264_load_chroma_vert_edge_simd128(pu1_src - 4, src_strd, pix_16x8b);
+  ih264_deblk_chroma_16x8b_simd128(pix_16x8b, alpha_cb, beta_cb, alpha_cr,
+                                   beta_cr, 0, NULL, NULL);
+  ih264_store_chroma_vert_edge_simd128(pu1_src - 4, src_strd, pix_16x8b);
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264_deblk_chroma_horz_bs4_simd128                      */
+/*                                                                           */
+/*  Description   : This function performs filtering of a chroma block       */
+/*                  horizontal edge when the boundary strength is set to 4   */
+/*                  in high profile                                          */
+/*                                                                           */
+/*  Inputs        : pu1_src    - pointer to the src sample q0 of U           */
+/*                  src_strd   - source stride                               */
+/*                  alpha_cb   - alpha value for the boundary in U           */
+/*                  beta_cb    - beta value for the boundary in U            */
+/*                  alpha_cr   - alpha value for the boundary in V           */
+/*                  beta_cr    - beta value for the boundary in V            */
+/*                                                                           */
+/*  Globals       : None                                                     */
+/*                                                                           */
+/*  Processing    : This operation is described in Sec. 8.7.2.4 under the    */
+/*                  title "Filtering process for edges for bS equal to 4"    */
+/*                  in ITU T Rec H.264.                                      */
+/*                                                                           */
+/*  Outputs       : None                                                     */
+/*                                                                           */
+/*  Returns       : None                                                     */
+/*                                                                           */
+/*****************************************************************************/
+void ih264_deblk_chroma_horz_bs4_simd128(UWORD8 *pu1_src, WORD32 src_strd,
+                                         WORD32 alpha_cb, WORD32 beta_cb,
+                                         WORD32 alpha_cr, WORD32 beta_cr) {
+  v128_t pix_16x8b[4];
+  WORD32 k;
+
+  for (k = 0; k < 4; k++)
+    pix_16x8b[k] = wasm_v128_load(pu1_src + (k - 2) * src_strd);
+  ih264_deblk_chroma_16x8b_simd128(pix_16x8b, alpha_cb, beta_cb, alpha_cr,
+                                   beta_cr, 0, NULL, NULL);
+  wasm_v128_store(pu1_src - src_strd, pix_16x8b[1]);
+  wasm_v128_store(pu1_src, pix_16x8b[2]);
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264_deblk_chroma_vert_bslt4_simd128                    */
+/*                                                                           */
+/*  Description   : This function performs filtering of a chroma block       */
+/*                  vertical edge when the boundary strength is less than 4  */
+/*                  in high profile                                          */
+/*                                                                           */
+/*  Inputs        : pu1_src          - pointer to the src sample q0 of U     */
+/*                  src_strd         - source stride                         */
+/*                  alpha_cb         - alpha value for the boundary in U     */
+/*                  beta_cb          - beta value for the boundary in U      */
+/*                  alpha_cr         - alpha value for the boundary in V     */
+/*                  beta_cr          - beta value for the boundary in V      */
+/*                  u4_bs            - packed Boundary strength array        */
+/*                  pu1_cliptab_cb   - tc0_table for U                       */
+/*                  pu1_cliptab_cr   - tc0_table for V                       */
+/*                                                                           */
+/*  Globals       : None                                                     */
+/*                                                                           */
+/*  Processing    : This operation is described in Sec. 8.7.2.3 under the    */
+/*                  title "Filtering process for edges for bS less than 4"   */
+/*                  in ITU T Rec H.264.                                      */
+/*                                                                           */
+/*  Outputs       : None                                                     */
+/*                                                                           */
+/*  Returns       : None                                                     */
+/*                                                                           */
+/*****************************************************************************/
+void ih264_deblk_chroma_vert_bslt4_simd128(UWORD8 *pu1_src, WORD32 src_strd,
+                                           WORD32 alpha_cb, WORD32 beta_cb,
+                                           WORD32 alpha_cr, WORD32 beta_cr,
+                                           UWORD32 u4_bs,
+                                           const UWORD8 *pu1_cliptab_cb,
+                                           const UWORD8 *pu1_cliptab_cr) {
+  v128_t pix_16x8b[4];
+
+  if (0 == u4_bs) return;
+  ih264_load_chroma_vert_edge_simd128(pu1_src - 4, src_strd, pix_16x8b);
+  ih264_deblk_chroma_16x8b_simd128(pix_16x8b, alpha_cb, beta_cb, alpha_cr,
+                                   beta_cr, u4_bs, pu1_cliptab_cb,
+                                   pu1_cliptab_cr);
+  ih264_store_chroma_vert_edge_simd128(pu1_src - 4, src_strd, pix_16x8b);
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264_deblk_chroma_horz_bslt4_simd128                    */
+/*                                                                           */
+/*  Description   : This function performs filtering of a chroma block       */
+/*                  horizontal edge when the boundary strength is less than  */
+/*                  4 in high profile                                        */
+/*                                                                           */
+/*  Inputs        : pu1_src          - pointer to the src sample q0 of U     */
+/*                  src_strd         - source stride                         */
+/*                  alpha_cb         - alpha value for the boundary in U     */
+/*                  beta_cb          - beta value for the boundary in U      */
+/*                  alpha_cr         - alpha value for the boundary in V     */
+/*                  beta_cr          - beta value for the boundary in V      */
+/*                  u4_bs            - packed Boundary strength array        */
+/*                  pu1_cliptab_cb   - tc0_table for U                       */
+/*                  pu1_cliptab_cr   - tc0_table for V                       */
+/*                                                                           */
+/*  Globals       : None                                                     */
+/*                                                                           */
+/*  Processing    : This operation is described in Sec. 8.7.2.3 under the    */
+/*                  title "Filtering process for edges for bS less than 4"   */
+/*                  in ITU T Rec H.264.                                      */
+/*                                                                           */
+/*  Outputs       : None                                                     */
+/*                                                                           */
+/*  Returns       : None                                                     */
+/*                                                                           */
+/*****************************************************************************/
+void ih264_deblk_chroma_horz_bslt4_simd128(UWORD8 *pu1_src, WORD32 src_strd,
+                                           WORD32 alpha_cb, WORD32 beta_cb,
+                                           WORD32 alpha_cr, WORD32 beta_cr,
+                                           UWORD32 u4_bs,
+                                           const UWORD8 *pu1_cliptab_cb,
+                                           const UWORD8 *pu1_cliptab_cr) {
+  v128_t pix_16x8b[4];
+  WORD32 k;
+
+  if (0 == u4_bs) return;
+  for (k = 0; k < 4; k++)
+    pix_16x8b[k] = wasm_v128_load(pu1_src + (k - 2) * src_strd);
+  ih264_deblk_chroma_16x8b_simd128(pix_16x8b, alpha_cb, beta_cb, alpha_cr,
+                                   beta_cr, u4_bs, pu1_cliptab_cb,
+                                   pu1_cliptab_cr);
+  wasm_v128_store(pu1_src - src_strd, pix_16x8b[1]);
+  wasm_v128_store(pu1_src, pix_16x8b[2]);
+}
@@ -0,0 +1,484 @@
+/* Copyright (c) [2020]-[2023] Ittiam Systems Pvt. Ltd.
+   All rights reserved.
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted (subject to the limitations in the
+   disclaimer below) provided that the following conditions are met:
+   •    Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+   •    Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+   •    None of the names of Ittiam Systems Pvt. Ltd., its affiliates,
+   investors, business partners, nor the names of its contributors may be
+   used to endorse or promote products derived from this software without
+   specific prior written permission.
+
+   NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED
+   BY THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+   BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+   FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+   HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+   OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+   WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+   OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+   EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+   This Software is an implementation of the AVC/H.264
+   standard by Ittiam Systems Pvt. Ltd. (“Ittiam”).
+   Additional patent licenses may be required for this Software,
+   including, but not limited to, a license from MPEG LA’s AVC/H.264
+   licensing program (see https://www.mpegla.com/programs/avc-h-264/).
+
+   NOTWITHSTANDING ANYTHING TO THE CONTRARY, THIS DOES NOT GRANT ANY
+   EXPRESS OR IMPLIED LICENSES TO ANY PATENT CLAIMS OF ANY AFFILIATE
+   (TO THE EXTENT NOT IN THE LEGAL ENTITY), INVESTOR, OR OTHER
+   BUSINESS PARTNER OF ITTIAM. You may only use this software or
+   modifications thereto for purposes that are authorized by
+   appropriate patent licenses. You should seek legal advice based
+   upon your implementation details.
+
+---------------------------------------------------------------
+*/
+/*****************************************************************************/
+/*                                                                           */
+/*  File Name         : ih264_deblk_luma_simd128.c                           */
+/*                                                                           */
+/*  Description       : Contains function definitions for the luma           */
+/*                      deblocking edge filters in WebAssembly SIMD128       */
+/*                      intrinsics. The samples across an edge are widened   */
+/*                      to 16 bit lanes, 8 lines of the edge at a time;      */
+/*                      vertical edges are transposed in and out of that     */
+/*                      layout.                                              */
+/*                                                                           */
+/*  List of Functions : ih264_deblk_luma_vert_bs4_simd128()                  */
+/*                      ih264_deblk_luma_horz_bs4_simd128()                  */
+/*                      ih264_deblk_luma_vert_bslt4_simd128()                */
+/*                      ih264_deblk_luma_horz_bslt4_simd128()                */
+/*                                                                           */
+/*  Issues / Problems : None                                                 */
+/*                                                                           */
+/*****************************************************************************/
+/*****************************************************************************/
+/*  File Includes                                                            */
+/*****************************************************************************/
+
+#include <wasm_simd128.h>
+#include "ih264_typedefs.h"
+#include "ih264_macros.h"
+#include "ih264_deblk_edge_filters.h"
+
+/*****************************************************************************/
+/*  Static Function Definitions                                              */
+/*****************************************************************************/
+
+/* Transposes 8x8 bytes held as pairs of 8 byte rows, (r0|r1) .. (r6|r7) */
+static __inline void ih264_transpose_8x8b_simd128(v128_t *pv_0, v128_t *pv_1,
+                                                  v128_t *pv_2, v128_t *pv_3) {
+  v128_t t0, t1, t2, t3, u0, u1, u2, u3;
+
+  t0 = wasm_i8x16_shuffle(*pv_0, *pv_0, 0, 8, 1, 9, 2, 10, 3, 11, 4, 12, 5, 13,
+                          6, 14, 7, 15);
+  t1 = wasm_i8x16_shuffle(*pv_1, *pv_1, 0, 8, 1, 9, 2, 10, 3, 11, 4, 12, 5, 13,
+                          6, 14, 7, 15);
+  t2 = wasm_i8x16_shuffle(*pv_2, *pv_2, 0, 8, 1, 9, 2, 10, 3, 11, 4, 12, 5, 13,
+                          6, 14, 7, 15);
+  t3 = wasm_i8x16_shuffle(*pv_3, *pv_3, 0, 8, 1, 9, 2, 10, 3, 11, 4, 12, 5, 13,
+                          6, 14, 7, 15);
+
+  u0 = wasm_i16x8_shuffle(t0, t1, 0, 8, 1, 9, 2, 10, 3, 11);
+  u1 = wasm_i16x8_shuffle(t0, t1, 4, 12, 5, 13, 6, 14, 7, 15);
+  u2 = wasm_i16x8_shuffle(t2, t3, 0, 8, 1, 9, 2, 10, 3, 11);
+  u3 = wasm_i16x8_shuffle(t2, t3, 4, 12, 5, 13, 6, 14, 7, 15);
+
+  *pv_0 = wasm_i32x4_shuffle(u0, u2, 0, 4, 1, 5);
+  *pv_1 = wasm_i32x4_shuffle(u0, u2, 2, 6, 3, 7);
+  *pv_2 = wasm_i32x4_shuffle(u1, u3, 0, 4, 1, 5);
+  *pv_3 = wasm_i32x4_shuffle(u1, u3, 2, 6, 3, 7);
+}
+
+/* Loads 8 rows of the 8 samples p3..q3 across a vertical edge as columns */
+static __inline void ih264_load_vert_edge_simd128(UWORD8 *pu1_src,
+                                                  WORD32 src_strd,
+                                                  v128_t *pix_8x16b) {
+  v128_t r0, r1, r2, r3;
+
+  r0 = wasm_v128_load64_zero(pu1_src);
+  r0 = wasm_v128_load64_lane(pu1_src + src_strd, r0, 1);
+  r1 = wasm_v128_load64_zero(pu1_src + 2 * src_strd);
+  r1 = wasm_v128_load64_lane(pu1_src + 3 * src_strd, r1, 1);
+  r2 = wasm_v128_load64_zero(pu1_src + 4 * src_strd);
+  r2 = wasm_v128_load64_lane(pu1_src + 5 * src_strd, r2, 1);
+  r3 = wasm_v128_load64_zero(pu1_src + 6 * src_strd);
+  r3 = wasm_v128_load64_lane(pu1_src + 7 * src_strd, r3, 1);
+
+  ih264_transpose_8x8b_simd128(&r0, &r1, &r2, &r3);
+
+  pix_8x16b[0] = wasm_u16x8_extend_low_u8x16(r0);
+  pix_8x16b[1] = wasm_u16x8_extend_high_u8x16(r0);
+  pix_8x16b[2] = wasm_u16x8_extend_low_u8x16(r1);
+  pix_8x16b[3] = wasm_u16x8_extend_high_u8x16(r1);
+  pix_8x16b[4] = wasm_u16x8_extend_low_u8x16(r2);
+  pix_8x16b[5] = wasm_u16x8_extend_high_u8x16(r2);
+  pix_8x16b[6] = wasm_u16x8_extend_low_u8x16(r3);
+  pix_8x16b[7] = wasm_u16x8_extend_high_u8x16(r3);
+}
+
+/* Stores back the columns of ih264_load_vert_edge_simd128() */
+static __inline void ih264_store_vert_edge_simd128(UWORD8 *pu1_src,
+                                                   WORD32 src_strd,
+                                                   v128_t *pix_8x16b) {
+  v128_t r0, r1, r2, r3;
+
+  r0 = wasm_u8x16_narrow_i16x8(pix_8x16b[0], pix_8x16b[1]);
+  r1 = wasm_u8x16_narrow_i16x8(pix_8x16b[2], pix_8x16b[3]);
+  r2 = wasm_u8x16_narrow_i16x8(pix_8x16b[4], pix_8x16b[5]);
+  r3 = wasm_u8x16_narrow_i16x8(pix_8x16b[6], pix_8x16b[7]);
+
+  ih264_transpose_8x8b_simd128(&r0, &r1, &r2, &r3);
+
+  wasm_v128_store64_lane(pu1_src, r0, 0);
+  wasm_v128_store64_lane(pu1_src + src_strd, r0, 1);
+  wasm_v128_store64_lane(pu1_src + 2 * src_strd, r1, 0);
+  wasm_v128_store64_lane(pu1_src + 3 * src_strd, r1, 1);
+  wasm_v128_store64_lane(pu1_src + 4 * src_strd, r2, 0);
+  wasm_v128_store64_lane(pu1_src + 5 * src_strd, r2, 1);
+  wasm_v128_store64_lane(pu1_src + 6 * src_strd, r3, 0);
+  wasm_v128_store64_lane(pu1_src + 7 * src_strd, r3, 1);
+}
+
+/* Filter decision |p0 - q0| < alpha, |q1 - q0| < beta, |p1 - p0| < beta */
+static __inline v128_t ih264_deblk_mask_simd128(v128_t *pix_8x16b,
+                                                v128_t alpha_8x16b,
+                                                v128_t beta_8x16b) {
+  v128_t mask_8x16b;
+
+  mask_8x16b = wasm_i16x8_lt(
+      wasm_i16x8_abs(wasm_i16x8_sub(pix_8x16b[3], pix_8x16b[4])), alpha_8x16b);
+  mask_8x16b = wasm_v128_and(
+      mask_8x16b,
+      wasm_i16x8_lt(wasm_i16x8_abs(wasm_i16x8_sub(pix_8x16b[5], pix_8x16b[4])),
+                    beta_8x16b));
+  return wasm_v128_and(
+      mask_8x16b,
+      wasm_i16x8_lt(wasm_i16x8_abs(wasm_i16x8_sub(pix_8x16b[2], pix_8x16b[3])),
+                    beta_8x16b));
+}
+
+/* bs = 4 filter of 8 lines, pix_8x16b[] holding p3, p2, .. q3 */
+static __inline void ih264_deblk_luma_bs4_8x16b_simd128(v128_t *pix_8x16b,
+                                                        WORD32 alpha,
+                                                        WORD32 beta) {
+  v128_t p3, p2, p1, p0, q0, q1, q2, q3;
+  v128_t mask, strong, ap, aq, p0q0, t0, t1;
+  const v128_t two_8x16b = wasm_i16x8_splat(2);
+  const v128_t four_8x16b = wasm_i16x8_splat(4);
+  const v128_t beta_8x16b = wasm_i16x8_splat(beta);
+
+  mask = ih264_deblk_mask_simd128(pix_8x16b, wasm_i16x8_splat(alpha),
+                                  beta_8x16b);
+  if (!wasm_v128_any_true(mask)) return;
+
+  p3 = pix_8x16b[0];
+  p2 = pix_8x16b[1];
+  p1 = pix_8x16b[2];
+  p0 = pix_8x16b[3];
+  q0 = pix_8x16b[4];
+  q1 = pix_8x16b[5];
+  q2 = pix_8x16b[6];
+  q3 = pix_8x16b[7];
+
+  strong = wasm_i16x8_lt(wasm_i16x8_abs(wasm_i16x8_sub(p0, q0)),
+                         wasm_i16x8_splat((alpha >> 2) + 2));
+  strong = wasm_v128_and(strong, mask);
+  ap = wasm_i16x8_lt(wasm_i16x8_abs(wasm_i16x8_sub(p2, p0)), beta_8x16b);
+  aq = wasm_i16x8_lt(wasm_i16x8_abs(wasm_i16x8_sub(q2, q0)), beta_8x16b);
+  ap = wasm_v128_and(ap, strong);
+  aq = wasm_v128_and(aq, strong);
+  p0q0 = wasm_i16x8_add(p0, q0);
+
+  /* p0', p1', p2' */
+  t0 = wasm_i16x8_add(wasm_i16x8_add(p1, p0q0), wasm_i16x8_add(p1, q1));
+  t0 = wasm_i16x8_add(wasm_i16x8_add(t0, p0q0), wasm_i16x8_add(p2, four_8x16b));
+  t1 = wasm_i16x8_add(wasm_i16x8_shl(p1, 1), wasm_i16x8_add(p0, q1));
+  t1 = wasm_u16x8_shr(wasm_i16x8_add(t1, two_8x16b), 2);
+  t1 = wasm_v128_bitselect(t1, p0, mask);
+  pix_8x16b[3] = wasm_v128_bitselect(wasm_u16x8_shr(t0, 3), t1, ap);
+
+  t0 = wasm_i16x8_add(wasm_i16x8_add(p2, p1), wasm_i16x8_add(p0q0, two_8x16b));
+  pix_8x16b[2] = wasm_v128_bitselect(wasm_u16x8_shr(t0, 2), p1, ap);
+
+  t0 = wasm_i16x8_add(wasm_i16x8_shl(wasm_i16x8_add(p3, p2), 1), p2);
+  t0 = wasm_i16x8_add(wasm_i16x8_add(t0, p1),
+                      wasm_i16x8_add(p0q0, four_8x16b));
+  pix_8x16b[1] = wasm_v128_bitselect(wasm_u16x8_shr(t0, 3), p2, ap);
+
+  /* q0', q1', q2' */
+  t0 = wasm_i16x8_add(wasm_i16x8_add(q1, p0q0), wasm_i16x8_add(q1, p1));
+  t0 = wasm_i16x8_add(wasm_i16x8_add(t0, p0q0), wasm_i16x8_add(q2, four_8x16b));
+  t1 = wasm_i16x8_add(wasm_i16x8_shl(q1, 1), wasm_i16x8_add(q0, p1));
+  t1 = wasm_u16x8_shr(wasm_i16x8_add(t1, two_8x16b), 2);
+  t1 = wasm_v128_bitselect(t1, q0, mask);
+  pix_8x16b[4] = wasm_v128_bitselect(wasm_u16x8_shr(t0, 3), t1, aq);
+
+  t0 = wasm_i16x8_add(wasm_i16x8_add(q2, q1), wasm_i16x8_add(p0q0, two_8x16b));
+  pix_8x16b[5] = wasm_v128_bitselect(wasm_u16x8_shr(t0, 2), q1, aq);
+
+  t0 = wasm_i16x8_add(wasm_i16x8_shl(wasm_i16x8_add(q3, q2), 1), q2);
+  t0 = wasm_i16x8_add(wasm_i16x8_add(t0, q1),
+                      wasm_i16x8_add(p0q0, four_8x16b));
+  pix_8x16b[6] = wasm_v128_bitselect(wasm_u16x8_shr(t0, 3), q2, aq);
+}
+
+/* bs < 4 filter of 8 lines, the lines of a zero bs having a zero valid */
+static __inline void ih264_deblk_luma_bslt4_8x16b_simd128(v128_t *pix_8x16b,
+                                                          WORD32 alpha,
+                                                          WORD32 beta,
+                                                          v128_t tc0_8x16b,
+                                                          v128_t valid_8x16b) {
+  v128_t p2, p1, p0, q0, q1, q2;
+  v128_t mask, ap, aq, tc, delta, avg, t0;
+  const v128_t beta_8x16b = wasm_i16x8_splat(beta);
+
+  mask = ih264_deblk_mask_simd128(pix_8x16b, wasm_i16x8_splat(alpha),
+                                  beta_8x16b);
+  mask = wasm_v128_and(mask, valid_8x16b);
+  if (!wasm_v128_any_true(mask)) return;
+
+  p2 = pix_8x16b[1];
+  p1 = pix_8x16b[2];
+  p0 = pix_8x16b[3];
+  q0 = pix_8x16b[4];
+  q1 = pix_8x16b[5];
+  q2 = pix_8x16b[6];
+
+  ap = wasm_i16x8_lt(wasm_i16x8_abs(wasm_i16x8_sub(p2, p0)), beta_8x16b);
+  aq = wasm_i16x8_lt(wasm_i16x8_abs(wasm_i16x8_sub(q2, q0)), beta_8x16b);
+
+  /* tc = tc0 + (a_p < beta) + (a_q < beta), the masks being -1 */
+  tc = wasm_i16x8_sub(wasm_i16x8_sub(tc0_8x16b, ap), aq);
+
+  delta = wasm_i16x8_add(wasm_i16x8_shl(wasm_i16x8_sub(q0, p0), 2),
+                         wasm_i16x8_sub(p1, q1));
+  delta = wasm_i16x8_shr(wasm_i16x8_add(delta, wasm_i16x8_splat(4)), 3);
+  delta = wasm_i16x8_max(wasm_i16x8_min(delta, tc), wasm_i16x8_neg(tc));
+
+  pix_8x16b[3] = wasm_v128_bitselect(wasm_i16x8_add(p0, delta), p0, mask);
+  pix_8x16b[4] = wasm_v128_bitselect(wasm_i16x8_sub(q0, delta), q0, mask);
+
+  /* p1' and q1' */
+  avg = wasm_u16x8_avgr(p0, q0);
+  t0 = wasm_i16x8_sub(wasm_i16x8_add(p2, avg), wasm_i16x8_shl(p1, 1));
+  t0 = wasm_i16x8_shr(t0, 1);
+  t0 = wasm_i16x8_max(wasm_i16x8_min(t0, tc0_8x16b), wasm_i16x8_neg(tc0_8x16b));
+  pix_8x16b[2] =
+      wasm_v128_bitselect(wasm_i16x8_add(p1, t0), p1, wasm_v128_and(ap, mask));
+
+  t0 = wasm_i16x8_sub(wasm_i16x8_add(q2, avg), wasm_i16x8_shl(q1, 1));
+  t0 = wasm_i16x8_shr(t0, 1);
+  t0 = wasm_i16x8_max(wasm_i16x8_min(t0, tc0_8x16b), wasm_i16x8_neg(tc0_8x16b));
+  pix_8x16b[5] =
+      wasm_v128_bitselect(wasm_i16x8_add(q1, t0), q1, wasm_v128_and(aq, mask));
+}
+
+/* tc0 of the two edges of 8 lines starting at edge, -1 where bs is non 0 */
+static __inline WORD32 ih264_deblk_luma_tc0_simd128(UWORD32 u4_bs, WORD32 edge,
+                                                    const UWORD8 *pu1_cliptab,
+                                                    v128_t *pv_tc0,
+                                                    v128_t *pv_valid) {
+  UWORD8 u1_bs0 = (UWORD8) (u4_bs >> ((3 - edge) << 3));
+  UWORD8 u1_bs1 = (UWORD8) (u4_bs >> ((2 - edge) << 3));
+  WORD16 i2_tc0 = pu1_cliptab[u1_bs0];
+  WORD16 i2_tc1 = pu1_cliptab[u1_bs1];
+  WORD16 i2_v0 = u1_bs0 ? -1 : 0;
+  WORD16 i2_v1 = u1_bs1 ? -1 : 0;
+
+  *pv_tc0 = wasm_i16x8_make(i2_tc0, i2_tc0, i2_tc0, i2_tc0, i2_tc1, i2_tc1,
+                            i2_tc1, i2_tc1);
+  *pv_valid =
+      wasm_i16x8_make(i2_v0, i2_v0, i2_v0, i2_v0, i2_v1, i2_v1, i2_v1, i2_v1);
+  return (u1_bs0 | u1_bs1) != 0;
+}
+
+/*****************************************************************************/
+/*  Function Definitions                                                     */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264_deblk_luma_vert_bs4_simd128                        */
+/*                                                                           */
+/*  Description   : This function performs filtering of a luma block         */
+/*                  vertical edge when the boundary strength is set to 4     */
+/*                                                                           */
+/*  Inputs        : pu1_src  - pointer to the src sample q0                  */
+/*                  src_strd - source stride                                 */
+/*                  alpha    - alpha value for the boundary                  */
+/*                  beta     - beta value for the boundary                   */
+/*                                                                           */
+/*  Globals       : None                                                     */
+/*                                                                           */
+/*  Processing    : This operation is described in Sec. 8.7.2.4 under the    */
+/*                  title "Filtering process for edges for bS equal to 4"    */
+/*                  in ITU T Rec H.264.                                      */
+/*                                                                           */
+/*  Outputs       : None                                                     */
+/*                                                                           */
+/*  Returns       : None                                                     */
+/*                                                                           */
+/*****************************************************************************/
+void ih264_deblk_luma_vert_bs4_simd128(UWORD8 *pu1_src, WORD32 src_strd,
+                                       WORD32 alpha, WORD32 beta) {
+  v128_t pix_8x16b[8];
+  WORD32 half;
+
+  for (half = 0; half < 2; half++) {
+    UWORD8 *pu1_blk = pu1_src - 4 + half * 8 * src_strd;
+
+    ih264_load_vert_edge_simd128(pu1_blk, src_strd, pix_8x16b);
+    ih264_deblk_luma_bs4_8x16b_simd128(pix_8x16b, alpha, beta);
+    ih264_store_vert_edge_simd128(pu1_blk, src_strd, pix_8x16b);
+  }
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264_deblk_luma_horz_bs4_simd128                        */
+/*                                                                           */
+/*  Description   : This function performs filtering of a luma block         */
+/*                  horizontal edge when the boundary strength is set to 4   */
+/*                                                                           */
+/*  Inputs        : pu1_src  - pointer to the src sample q0                  */
+/*                  src_strd - source stride                                 */
+/*                  alpha    - alpha value for the boundary                  */
+/*                  beta     - beta value for the boundary                   */
+/*                                                                           */
+/*  Globals       : None                                                     */
+/*                                                                           */
+/*  Processing    : This operation is described in Sec. 8.7.2.4 under the    */
+/*                  title "Filtering process for edges for bS equal to 4"    */
+/*                  in ITU T Rec H.264.                                      */
+/*                                                                           */
+/*  Outputs       : None                                                     */
+/*                                                                           */
+/*  Returns       : None                                                     */
+/*                                                                           */
+/*****************************************************************************/
+void ih264_deblk_luma_horz_bs4_simd128(UWORD8 *pu1_src, WORD32 src_strd,
+                                       WORD32 alpha, WORD32 beta) {
+  v128_t row_16x8b[8], lo_8x16b[8], hi_8x16b[8];
+  WORD32 k;
+
+  for (k = 0; k < 8; k++) {
+    row_16x8b[k] = wasm_v128_load(pu1_src + (k - 4) * src_strd);
+    lo_8x16b[k] = wasm_u16x8_extend_low_u8x16(row_16x8b[k]);
+    hi_8x16b[k] = wasm_u16x8_extend_high_u8x16(row_16x8b[k]);
+  }
+
+  ih264_deblk_luma_bs4_8x16b_simd128(lo_8x16b, alpha, beta);
+  ih264_deblk_luma_bs4_8x16b_simd128(hi_8x16b, alpha, beta);
+
+  /* p3 and q3 are never modified */
+  for (k = 1; k < 7; k++)
+    wasm_v128_store(pu1_src + (k - 4) * src_strd,
+                    wasm_u8x16_narrow_i16x8(lo_8x16b[k], hi_8x16b[k]));
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264_deblk_luma_vert_bslt4_simd128                      */
+/*                                                                           */
+/*  Description   : This function performs filtering of a luma block         */
+/*                  vertical edge when the boundary strength is less than 4  */
+/*                                                                           */
+/*  Inputs        : pu1_src       - pointer to the src sample q0             */
+/*                  src_strd      - source stride                            */
+/*                  alpha         - alpha value for the boundary             */
+/*                  beta          - beta value for the boundary              */
+/*                  u4_bs         - packed Boundary strength array           */
+/*                  pu1_cliptab   - tc0_table                                */
+/*                                                                           */
+/*  Globals       : None                                                     */
+/*                                                                           */
+/*  Processing    : This operation is described in Sec. 8.7.2.3 under the    */
+/*                  title "Filtering process for edges for bS less than 4"   */
+/*                  in ITU T Rec H.264.                                      */
+/*                                                                           */
+/*  Outputs       : None                                                     */
+/*                                                                           */
+/*  Returns       : None                                                     */
+/*                                                                           */
+/*****************************************************************************/
+void ih264_deblk_luma_vert_bslt4_simd128(UWORD8 *pu1_src, WORD32 src_strd,
+                                         WORD32 alpha, WORD32 beta,
+                                         UWORD32 u4_bs,
+                                         const UWORD8 *pu1_cliptab) {
+  v128_t pix_8x16b[8], tc0_8x16b, valid_8x16b;
+  WORD32 half;
+
+  for (half = 0; half < 2; half++) {
+    UWORD8 *pu1_blk = pu1_src - 4 + half * 8 * src_strd;
+
+    if (!ih264_deblk_luma_tc0_simd128(u4_bs, half << 1, pu1_cliptab,
+                                      &tc0_8x16b, &valid_8x16b))
+      continue;
+    ih264_load_vert_edge_simd128(pu1_blk, src_strd, pix_8x16b);
+    ih264_deblk_luma_bslt4_8x16b_simd128(pix_8x16b, alpha, beta, tc0_8x16b,
+                                         valid_8x16b);
+    ih264_store_vert_edge_simd128(pu1_blk, src_strd, pix_8x16b);
+  }
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264_deblk_luma_horz_bslt4_simd128                      */
+/*                                                                           */
+/*  Description   : This function performs filtering of a luma block         */
+/*                  horizontal edge when boundary strength is less than 4    */
+/*                                                                           */
+/*  Inputs        : pu1_src       - pointer to the src sample q0             */
+/*                  src_strd      - source stride                            */
+/*                  alpha         - alpha value for the boundary             */
+/*                  beta          - beta value for the boundary              */
+/*                  u4_bs         - packed Boundary strength array           */
+/*                  pu1_cliptab   - tc0_table                                */
+/*                                                                           */
+/*  Globals       : None                                                     */
+/*                                                                           */
+/*  Processing    : This operation is described in Sec. 8.7.2.3 under the    */
+/*                  title "Filtering process for edges for bS less than 4"   */
+/*                  in ITU T Rec H.264.                                      */
+/*                                                                           */
+/*  Outputs       : None                                                     */
+/*                                                                           */
+/*  Returns       : None                                                     */
+/*                                                                           */
+/*****************************************************************************/
+void ih264_deblk_luma_horz_bslt4_simd128(UWORD8 *pu1_src, WORD32 src_strd,
+                                         WORD32 alpha, WORD32 beta,
+                                         UWORD32 u4_bs,
+                                         const UWORD8 *pu1_cliptab) {
+  v128_t row_16x8b, pix_8x16b[2][8], tc0_8x16b, valid_8x16b;
+  WORD32 half, k;
+
+  for (k = 1; k < 7; k++) {
+    row_16x8b = wasm_v128_load(pu1_src + (k - 4) * src_strd);
+    pix_8x16b[0][k] = wasm_u16x8_extend_low_u8x16(row_16x8b);
+    pix_8x16b[1][k] = wasm_u16x8_extend_high_u8x16(row_16x8b);
+  }
+
+  for (half = 0; half < 2; half++) {
+    if (!ih264_deblk_luma_tc0_simd128(u4_bs, half << 1, pu1_cliptab,
+                                      &tc0_8x16b, &valid_8x16b))
+      continue;
+    ih264_deblk_luma_bslt4_8x16b_simd128(pix_8x16b[half], alpha, beta,
+                                         tc0_8x16b, valid_8x16b);
+  }
+
+  /* only p1, p0, q0 and q1 can change */
+  for (k = 2; k < 6; k++)
+    wasm_v128_store(pu1_src + (k - 4) * src_strd,
+                    wasm_u8x16_narrow_i16x8(pix_8x16b[0][k], pix_8x16b[1][k]));
+}
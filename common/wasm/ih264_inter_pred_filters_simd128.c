@@ -0,0 +1,645 @@
+/* Copyright (c) [2020]-[2023] Ittiam Systems Pvt. Ltd.
+   All rights reserved.
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted (subject to the limitations in the
+   disclaimer below) provided that the following conditions are met:
+   •    Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+   •    Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+   •    None of the names of Ittiam Systems Pvt. Ltd., its affiliates,
+   investors, business partners, nor the names of its contributors may be
+   used to endorse or promote products derived from this software without
+   specific prior written permission.
+
+   NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED
+   BY THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+   BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+   FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+   HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+   OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+   WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+   OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+   EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+   This Software is an implementation of the AVC/H.264
+   standard by Ittiam Systems Pvt. Ltd. (“Ittiam”).
+   Additional patent licenses may be required for this Software,
+   including, but not limited to, a license from MPEG LA’s AVC/H.264
+   licensing program (see https://www.mpegla.com/programs/avc-h-264/).
+
+   NOTWITHSTANDING ANYTHING TO THE CONTRARY, THIS DOES NOT GRANT ANY
+   EXPRESS OR IMPLIED LICENSES TO ANY PATENT CLAIMS OF ANY AFFILIATE
+   (TO THE EXTENT NOT IN THE LEGAL ENTITY), INVESTOR, OR OTHER
+   BUSINESS PARTNER OF ITTIAM. You may only use this software or
+   modifications thereto for purposes that are authorized by
+   appropriate patent licenses. You should seek legal advice based
+   upon your implementation details.
+
+---------------------------------------------------------------
+*/
+/*****************************************************************************/
+/*                                                                           */
+/*  File Name         : ih264_inter_pred_filters_simd128.c                   */
+/*                                                                           */
+/*  Description       : Contains function definitions for the inter          */
+/*                      prediction filters in WebAssembly SIMD128            */
+/*                      intrinsics. Six tap sums are formed in 16 bit        */
+/*                      lanes, the second pass of the 2D half pel filter     */
+/*                      in 32 bit lanes                                      */
+/*                                                                           */
+/*  List of Functions : ih264_inter_pred_luma_copy_simd128()                 */
+/*                      ih264_inter_pred_luma_horz_simd128()                 */
+/*                      ih264_inter_pred_luma_vert_simd128()                 */
+/*                      ih264_inter_pred_luma_horz_hpel_vert_hpel_simd128()  */
+/*                      ih264_inter_pred_luma_horz_qpel_simd128()            */
+/*                      ih264_inter_pred_luma_vert_qpel_simd128()            */
+/*                      ih264_inter_pred_luma_horz_qpel_vert_qpel_simd128()  */
+/*                      ih264_inter_pred_luma_horz_hpel_vert_qpel_simd128()  */
+/*                      ih264_inter_pred_luma_horz_qpel_vert_hpel_simd128()  */
+/*                      ih264_inter_pred_chroma_simd128()                    */
+/*                                                                           */
+/*  Issues / Problems : None                                                 */
+/*                                                                           */
+/*****************************************************************************/
+/*****************************************************************************/
+/*  File Includes                                                            */
+/*****************************************************************************/
+
+#include <wasm_simd128.h>
+#include "ih264_typedefs.h"
+#include "ih264_macros.h"
+#include "ih264_inter_pred_filters.h"
+
+/*****************************************************************************/
+/*  Static Function Definitions                                              */
+/*****************************************************************************/
+
+/* Unrounded six tap sum of 8 outputs, the taps being step bytes apart */
+static __inline v128_t ih264_six_tap_8x16b_simd128(const UWORD8 *pu1_src,
+                                                   WORD32 step) {
+  v128_t a_8x16b, b_8x16b, c_8x16b, d_8x16b, e_8x16b, f_8x16b;
+
+  a_8x16b = wasm_u16x8_load8x8(pu1_src - 2 * step);
+  b_8x16b = wasm_u16x8_load8x8(pu1_src - step);
+  c_8x16b = wasm_u16x8_load8x8(pu1_src);
+  d_8x16b = wasm_u16x8_load8x8(pu1_src + step);
+  e_8x16b = wasm_u16x8_load8x8(pu1_src + 2 * step);
+  f_8x16b = wasm_u16x8_load8x8(pu1_src + 3 * step);
+
+  a_8x16b = wasm_i16x8_add(a_8x16b, f_8x16b);
+  b_8x16b = wasm_i16x8_add(b_8x16b, e_8x16b);
+  c_8x16b = wasm_i16x8_add(c_8x16b, d_8x16b);
+
+  c_8x16b = wasm_i16x8_mul(c_8x16b, wasm_i16x8_splat(20));
+  b_8x16b = wasm_i16x8_mul(b_8x16b, wasm_i16x8_splat(5));
+  return wasm_i16x8_sub(wasm_i16x8_add(a_8x16b, c_8x16b), b_8x16b);
+}
+
+/* (x + 16) >> 5 of a six tap sum, clipped to 8 bits by the narrowing */
+static __inline v128_t ih264_hpel_8x8b_simd128(v128_t sum_8x16b) {
+  sum_8x16b = wasm_i16x8_shr(wasm_i16x8_add(sum_8x16b, wasm_i16x8_splat(16)),
+                             5);
+  return wasm_u8x16_narrow_i16x8(sum_8x16b, sum_8x16b);
+}
+
+/* Second pass of the 2D filter on six unrounded first pass sums */
+static __inline v128_t ih264_six_tap_2d_8x8b_simd128(v128_t s0_8x16b,
+                                                     v128_t s1_8x16b,
+                                                     v128_t s2_8x16b,
+                                                     v128_t s3_8x16b,
+                                                     v128_t s4_8x16b,
+                                                     v128_t s5_8x16b) {
+  v128_t af_8x16b, be_8x16b, cd_8x16b, lo_4x32b, hi_4x32b;
+  const v128_t c20_8x16b = wasm_i16x8_splat(20);
+  const v128_t c5_8x16b = wasm_i16x8_splat(5);
+  const v128_t rnd_4x32b = wasm_i32x4_splat(512);
+
+  /* first pass sums lie in [-2550, 10710], pair sums still fit 16 bits */
+  af_8x16b = wasm_i16x8_add(s0_8x16b, s5_8x16b);
+  be_8x16b = wasm_i16x8_add(s1_8x16b, s4_8x16b);
+  cd_8x16b = wasm_i16x8_add(s2_8x16b, s3_8x16b);
+
+  lo_4x32b = wasm_i32x4_sub(wasm_i32x4_extmul_low_i16x8(cd_8x16b, c20_8x16b),
+                            wasm_i32x4_extmul_low_i16x8(be_8x16b, c5_8x16b));
+  hi_4x32b = wasm_i32x4_sub(wasm_i32x4_extmul_high_i16x8(cd_8x16b, c20_8x16b),
+                            wasm_i32x4_extmul_high_i16x8(be_8x16b, c5_8x16b));
+  lo_4x32b = wasm_i32x4_add(lo_4x32b, wasm_i32x4_extend_low_i16x8(af_8x16b));
+  hi_4x32b = wasm_i32x4_add(hi_4x32b, wasm_i32x4_extend_high_i16x8(af_8x16b));
+  lo_4x32b = wasm_i32x4_shr(wasm_i32x4_add(lo_4x32b, rnd_4x32b), 10);
+  hi_4x32b = wasm_i32x4_shr(wasm_i32x4_add(hi_4x32b, rnd_4x32b), 10);
+
+  lo_4x32b = wasm_i16x8_narrow_i32x4(lo_4x32b, hi_4x32b);
+  return wasm_u8x16_narrow_i16x8(lo_4x32b, lo_4x32b);
+}
+
+/* Stores the low 8 bytes, or the low 4 bytes for a 4 wide block */
+static __inline void ih264_store_8x8b_simd128(UWORD8 *pu1_dst, v128_t res,
+                                              WORD32 wd) {
+  if (wd == 4)
+    wasm_v128_store32_lane(pu1_dst, res, 0);
+  else
+    wasm_v128_store64_lane(pu1_dst, res, 0);
+}
+
+/*****************************************************************************/
+/*  Function definitions                                                     */
+/*****************************************************************************/
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264_inter_pred_luma_copy_simd128                       */
+/*                                                                           */
+/*  Description   : This function copies the contents of ht x wd block from  */
+/*                  source to destination. (ht,wd) can be (4,4), (8,4),      */
+/*                  (4,8), (8,8), (16,8), (8,16) or (16,16).                 */
+/*                                                                           */
+/*  Inputs        : pu1_src  - pointer to source                             */
+/*                  pu1_dst  - pointer to destination                        */
+/*                  src_strd - stride for source                             */
+/*                  dst_strd - stride for destination                        */
+/*                  ht       - height of the block                           */
+/*                  wd       - width of the block                            */
+/*                                                                           */
+/*  Issues        : None                                                     */
+/*                                                                           */
+/*****************************************************************************/
+void ih264_inter_pred_luma_copy_simd128(UWORD8 *pu1_src, UWORD8 *pu1_dst,
+                                        WORD32 src_strd, WORD32 dst_strd,
+                                        WORD32 ht, WORD32 wd, UWORD8 *pu1_tmp,
+                                        WORD32 dydx) {
+  WORD32 row;
+
+  UNUSED(pu1_tmp);
+  UNUSED(dydx);
+
+  for (row = 0; row < ht; row++) {
+    if (wd == 16)
+      wasm_v128_store(pu1_dst, wasm_v128_load(pu1_src));
+    else if (wd == 8)
+      wasm_v128_store64_lane(pu1_dst, wasm_v128_load64_zero(pu1_src), 0);
+    else
+      wasm_v128_store32_lane(pu1_dst, wasm_v128_load32_zero(pu1_src), 0);
+    pu1_src += src_strd;
+    pu1_dst += dst_strd;
+  }
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264_inter_pred_luma_horz_simd128                       */
+/*                                                                           */
+/*  Description   : This function applies a horizontal 6-tap filter on       */
+/*                  ht x wd block as mentioned in sec. 8.4.2.2.1 titled      */
+/*                  "Luma sample interpolation process"                      */
+/*                                                                           */
+/*  Inputs        : pu1_src  - pointer to source                             */
+/*                  pu1_dst  - pointer to destination                        */
+/*                  src_strd - stride for source                             */
+/*                  dst_strd - stride for destination                        */
+/*                  ht       - height of the block                           */
+/*                  wd       - width of the block                            */
+/*                                                                           */
+/*  Issues        : None                                                     */
+/*                                                                           */
+/*****************************************************************************/
+void ih264_inter_pred_luma_horz_simd128(UWORD8 *pu1_src, UWORD8 *pu1_dst,
+                                        WORD32 src_strd, WORD32 dst_strd,
+                                        WORD32 ht, WORD32 wd, UWORD8 *pu1_tmp,
+                                        WORD32 dydx) {
+  WORD32 row, col;
+
+  UNUSED(pu1_tmp);
+  UNUSED(dydx);
+
+  for (row = 0; row < ht; row++) {
+    for (col = 0; col < wd; col += 8) {
+      v128_t res_16x8b = ih264_hpel_8x8b_simd128(
+          ih264_six_tap_8x16b_simd128(pu1_src + col, 1));
+
+      ih264_store_8x8b_simd128(pu1_dst + col, res_16x8b, wd);
+    }
+    pu1_src += src_strd;
+    pu1_dst += dst_strd;
+  }
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264_inter_pred_luma_vert_simd128                       */
+/*                                                                           */
+/*  Description   : This function applies a vertical 6-tap filter on         */
+/*                  ht x wd block as mentioned in sec. 8.4.2.2.1 titled      */
+/*                  "Luma sample interpolation process"                      */
+/*                                                                           */
+/*  Inputs        : pu1_src  - pointer to source                             */
+/*                  pu1_dst  - pointer to destination                        */
+/*                  src_strd - stride for source                             */
+/*                  dst_strd - stride for destination                        */
+/*                  ht       - height of the block                           */
+/*                  wd       - width of the block                            */
+/*                                                                           */
+/*  Issues        : None                                                     */
+/*                                                                           */
+/*****************************************************************************/
+void ih264_inter_pred_luma_vert_simd128(UWORD8 *pu1_src, UWORD8 *pu1_dst,
+                                        WORD32 src_strd, WORD32 dst_strd,
+                                        WORD32 ht, WORD32 wd, UWORD8 *pu1_tmp,
+                                        WORD32 dydx) {
+  WORD32 row, col;
+
+  UNUSED(pu1_tmp);
+  UNUSED(dydx);
+
+  for (row = 0; row < ht; row++) {
+    for (col = 0; col < wd; col += 8) {
+      v128_t res_16x8b = ih264_hpel_8x8b_simd128(
+          ih264_six_tap_8x16b_simd128(pu1_src + col, src_strd));
+
+      ih264_store_8x8b_simd128(pu1_dst + col, res_16x8b, wd);
+    }
+    pu1_src += src_strd;
+    pu1_dst += dst_strd;
+  }
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264_inter_pred_luma_horz_hpel_vert_hpel_simd128        */
+/*                                                                           */
+/*  Description   : This function implements a two stage cascaded six tap    */
+/*                  filter, horizontal first. The unrounded horizontal sums  */
+/*                  of the six rows around an output row are kept in a       */
+/*                  sliding window of registers.                             */
+/*                                                                           */
+/*  Inputs        : pu1_src  - pointer to source                             */
+/*                  pu1_dst  - pointer to destination                        */
+/*                  src_strd - stride for source                             */
+/*                  dst_strd - stride for destination                        */
+/*                  ht       - height of the block                           */
+/*                  wd       - width of the block                            */
+/*                                                                           */
+/*  Issues        : None                                                     */
+/*                                                                           */
+/*****************************************************************************/
+void ih264_inter_pred_luma_horz_hpel_vert_hpel_simd128(
+    UWORD8 *pu1_src, UWORD8 *pu1_dst, WORD32 src_strd, WORD32 dst_strd,
+    WORD32 ht, WORD32 wd, UWORD8 *pu1_tmp, WORD32 dydx) {
+  WORD32 row, col;
+
+  UNUSED(pu1_tmp);
+  UNUSED(dydx);
+
+  for (col = 0; col < wd; col += 8) {
+    UWORD8 *pu1_src_col = pu1_src + col - 2 * src_strd;
+    UWORD8 *pu1_dst_col = pu1_dst + col;
+    v128_t h0_8x16b, h1_8x16b, h2_8x16b, h3_8x16b, h4_8x16b, h5_8x16b;
+
+    h0_8x16b = ih264_six_tap_8x16b_simd128(pu1_src_col, 1);
+    h1_8x16b = ih264_six_tap_8x16b_simd128(pu1_src_col + src_strd, 1);
+    h2_8x16b = ih264_six_tap_8x16b_simd128(pu1_src_col + 2 * src_strd, 1);
+    h3_8x16b = ih264_six_tap_8x16b_simd128(pu1_src_col + 3 * src_strd, 1);
+    h4_8x16b = ih264_six_tap_8x16b_simd128(pu1_src_col + 4 * src_strd, 1);
+    pu1_src_col += 5 * src_strd;
+
+    for (row = 0; row < ht; row++) {
+      v128_t res_16x8b;
+
+      h5_8x16b = ih264_six_tap_8x16b_simd128(pu1_src_col, 1);
+      res_16x8b = ih264_six_tap_2d_8x8b_simd128(h0_8x16b, h1_8x16b, h2_8x16b,
+                                                h3_8x16b, h4_8x16b, h5_8x16b);
+      ih264_store_8x8b_simd128(pu1_dst_col, res_16x8b, wd);
+
+      h0_8x16b = h1_8x16b;
+      h1_8x16b = h2_8x16b;
+      h2_8x16b = h3_8x16b;
+      h3_8x16b = h4_8x16b;
+      h4_8x16b = h5_8x16b;
+      pu1_src_col += src_strd;
+      pu1_dst_col += dst_strd;
+    }
+  }
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264_inter_pred_luma_horz_qpel_simd128                  */
+/*                                                                           */
+/*  Description   : This function implements a six-tap filter horizontally   */
+/*                  and averages the values with the integer pel sample to   */
+/*                  its left or right, as selected by dydx                   */
+/*                                                                           */
+/*  Inputs        : pu1_src  - pointer to source                             */
+/*                  pu1_dst  - pointer to destination                        */
+/*                  src_strd - stride for source                             */
+/*                  dst_strd - stride for destination                        */
+/*                  ht       - height of the block                           */
+/*                  wd       - width of the block                            */
+/*                  dydx     - x and y reference offset for qpel             */
+/*                             calculations: dydx = (dy << 2) + dx           */
+/*                                                                           */
+/*  Issues        : None                                                     */
+/*                                                                           */
+/*****************************************************************************/
+void ih264_inter_pred_luma_horz_qpel_simd128(UWORD8 *pu1_src, UWORD8 *pu1_dst,
+                                             WORD32 src_strd, WORD32 dst_strd,
+                                             WORD32 ht, WORD32 wd,
+                                             UWORD8 *pu1_tmp, WORD32 dydx) {
+  WORD32 row, col;
+  UWORD8 *pu1_pred = pu1_src + ((dydx & 3) >> 1);
+
+  UNUSED(pu1_tmp);
+
+  for (row = 0; row < ht; row++) {
+    for (col = 0; col < wd; col += 8) {
+      v128_t res_16x8b = ih264_hpel_8x8b_simd128(
+          ih264_six_tap_8x16b_simd128(pu1_src + col, 1));
+
+      res_16x8b =
+          wasm_u8x16_avgr(res_16x8b, wasm_v128_load64_zero(pu1_pred + col));
+      ih264_store_8x8b_simd128(pu1_dst + col, res_16x8b, wd);
+    }
+    pu1_src += src_strd;
+    pu1_pred += src_strd;
+    pu1_dst += dst_strd;
+  }
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264_inter_pred_luma_vert_qpel_simd128                  */
+/*                                                                           */
+/*  Description   : This function implements a six-tap filter vertically     */
+/*                  and averages the values with the integer pel sample      */
+/*                  above or below it, as selected by dydx                   */
+/*                                                                           */
+/*  Inputs        : pu1_src  - pointer to source                             */
+/*                  pu1_dst  - pointer to destination                        */
+/*                  src_strd - stride for source                             */
+/*                  dst_strd - stride for destination                        */
+/*                  ht       - height of the block                           */
+/*                  wd       - width of the block                            */
+/*                  dydx     - x and y reference offset for qpel             */
+/*                             calculations: dydx = (dy << 2) + dx           */
+/*                                                                           */
+/*  Issues        : None                                                     */
+/*                                                                           */
+/*****************************************************************************/
+void ih264_inter_pred_luma_vert_qpel_simd128(UWORD8 *pu1_src, UWORD8 *pu1_dst,
+                                             WORD32 src_strd, WORD32 dst_strd,
+                                             WORD32 ht, WORD32 wd,
+                                             UWORD8 *pu1_tmp, WORD32 dydx) {
+  WORD32 row, col;
+  UWORD8 *pu1_pred = pu1_src + (((dydx >> 2) & 3) >> 1) * src_strd;
+
+  UNUSED(pu1_tmp);
+
+  for (row = 0; row < ht; row++) {
+    for (col = 0; col < wd; col += 8) {
+      v128_t res_16x8b = ih264_hpel_8x8b_simd128(
+          ih264_six_tap_8x16b_simd128(pu1_src + col, src_strd));
+
+      res_16x8b =
+          wasm_u8x16_avgr(res_16x8b, wasm_v128_load64_zero(pu1_pred + col));
+      ih264_store_8x8b_simd128(pu1_dst + col, res_16x8b, wd);
+    }
+    pu1_src += src_strd;
+    pu1_pred += src_strd;
+    pu1_dst += dst_strd;
+  }
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264_inter_pred_luma_horz_qpel_vert_qpel_simd128        */
+/*                                                                           */
+/*  Description   : This function averages the vertical half pel sample      */
+/*                  left or right of the output with the horizontal half     */
+/*                  pel sample above or below it, as selected by dydx        */
+/*                                                                           */
+/*  Inputs        : pu1_src  - pointer to source                             */
+/*                  pu1_dst  - pointer to destination                        */
+/*                  src_strd - stride for source                             */
+/*                  dst_strd - stride for destination                        */
+/*                  ht       - height of the block                           */
+/*                  wd       - width of the block                            */
+/*                  dydx     - x and y reference offset for qpel             */
+/*                             calculations: dydx = (dy << 2) + dx           */
+/*                                                                           */
+/*  Issues        : None                                                     */
+/*                                                                           */
+/*****************************************************************************/
+void ih264_inter_pred_luma_horz_qpel_vert_qpel_simd128(
+    UWORD8 *pu1_src, UWORD8 *pu1_dst, WORD32 src_strd, WORD32 dst_strd,
+    WORD32 ht, WORD32 wd, UWORD8 *pu1_tmp, WORD32 dydx) {
+  WORD32 row, col;
+  UWORD8 *pu1_pred_vert = pu1_src + ((dydx & 3) >> 1);
+  UWORD8 *pu1_pred_horz = pu1_src + (((dydx >> 2) & 3) >> 1) * src_strd;
+
+  UNUSED(pu1_tmp);
+
+  for (row = 0; row < ht; row++) {
+    for (col = 0; col < wd; col += 8) {
+      v128_t vert_16x8b = ih264_hpel_8x8b_simd128(
+          ih264_six_tap_8x16b_simd128(pu1_pred_vert + col, src_strd));
+      v128_t horz_16x8b = ih264_hpel_8x8b_simd128(
+          ih264_six_tap_8x16b_simd128(pu1_pred_horz + col, 1));
+
+      ih264_store_8x8b_simd128(pu1_dst + col,
+                               wasm_u8x16_avgr(vert_16x8b, horz_16x8b), wd);
+    }
+    pu1_pred_vert += src_strd;
+    pu1_pred_horz += src_strd;
+    pu1_dst += dst_strd;
+  }
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264_inter_pred_luma_horz_qpel_vert_hpel_simd128        */
+/*                                                                           */
+/*  Description   : This function averages the centre half pel sample with   */
+/*                  the vertical half pel sample to its left or right. The   */
+/*                  vertical sums of columns -2 to 13 of a group of 8        */
+/*                  outputs are formed once and shifted for every tap.       */
+/*                                                                           */
+/*  Inputs        : pu1_src  - pointer to source                             */
+/*                  pu1_dst  - pointer to destination                        */
+/*                  src_strd - stride for source                             */
+/*                  dst_strd - stride for destination                        */
+/*                  ht       - height of the block                           */
+/*                  wd       - width of the block                            */
+/*                  dydx     - x and y reference offset for qpel             */
+/*                             calculations: dydx = (dy << 2) + dx           */
+/*                                                                           */
+/*  Issues        : None                                                     */
+/*                                                                           */
+/*****************************************************************************/
+void ih264_inter_pred_luma_horz_qpel_vert_hpel_simd128(
+    UWORD8 *pu1_src, UWORD8 *pu1_dst, WORD32 src_strd, WORD32 dst_strd,
+    WORD32 ht, WORD32 wd, UWORD8 *pu1_tmp, WORD32 dydx) {
+  WORD32 row, col;
+  WORD32 x_half = (dydx & 3) >> 1;
+
+  UNUSED(pu1_tmp);
+
+  for (row = 0; row < ht; row++) {
+    for (col = 0; col < wd; col += 8) {
+      v128_t lo_8x16b, hi_8x16b, s1_8x16b, s2_8x16b, s3_8x16b, s4_8x16b;
+      v128_t s5_8x16b, res_16x8b, vert_16x8b;
+
+      lo_8x16b = ih264_six_tap_8x16b_simd128(pu1_src + col - 2, src_strd);
+      hi_8x16b = ih264_six_tap_8x16b_simd128(pu1_src + col + 6, src_strd);
+
+      s1_8x16b = wasm_i16x8_shuffle(lo_8x16b, hi_8x16b, 1, 2, 3, 4, 5, 6, 7, 8);
+      s2_8x16b = wasm_i16x8_shuffle(lo_8x16b, hi_8x16b, 2, 3, 4, 5, 6, 7, 8, 9);
+      s3_8x16b =
+          wasm_i16x8_shuffle(lo_8x16b, hi_8x16b, 3, 4, 5, 6, 7, 8, 9, 10);
+      s4_8x16b =
+          wasm_i16x8_shuffle(lo_8x16b, hi_8x16b, 4, 5, 6, 7, 8, 9, 10, 11);
+      s5_8x16b =
+          wasm_i16x8_shuffle(lo_8x16b, hi_8x16b, 5, 6, 7, 8, 9, 10, 11, 12);
+
+      res_16x8b = ih264_six_tap_2d_8x8b_simd128(lo_8x16b, s1_8x16b, s2_8x16b,
+                                                s3_8x16b, s4_8x16b, s5_8x16b);
+      vert_16x8b = ih264_hpel_8x8b_simd128(x_half ? s3_8x16b : s2_8x16b);
+
+      ih264_store_8x8b_simd128(pu1_dst + col,
+                               wasm_u8x16_avgr(res_16x8b, vert_16x8b), wd);
+    }
+    pu1_src += src_strd;
+    pu1_dst += dst_strd;
+  }
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264_inter_pred_luma_horz_hpel_vert_qpel_simd128        */
+/*                                                                           */
+/*  Description   : This function averages the centre half pel sample with   */
+/*                  the horizontal half pel sample above or below it. The    */
+/*                  horizontal sums are kept in a sliding window of six      */
+/*                  rows as in the hpel-hpel case.                           */
+/*                                                                           */
+/*  Inputs        : pu1_src  - pointer to source                             */
+/*                  pu1_dst  - pointer to destination                        */
+/*                  src_strd - stride for source                             */
+/*                  dst_strd - stride for destination                        */
+/*                  ht       - height of the block                           */
+/*                  wd       - width of the block                            */
+/*                  dydx     - x and y reference offset for qpel             */
+/*                             calculations: dydx = (dy << 2) + dx           */
+/*                                                                           */
+/*  Issues        : None                                                     */
+/*                                                                           */
+/*****************************************************************************/
+void ih264_inter_pred_luma_horz_hpel_vert_qpel_simd128(
+    UWORD8 *pu1_src, UWORD8 *pu1_dst, WORD32 src_strd, WORD32 dst_strd,
+    WORD32 ht, WORD32 wd, UWORD8 *pu1_tmp, WORD32 dydx) {
+  WORD32 row, col;
+  WORD32 y_half = ((dydx >> 2) & 3) >> 1;
+
+  UNUSED(pu1_tmp);
+
+  for (col = 0; col < wd; col += 8) {
+    UWORD8 *pu1_src_col = pu1_src + col - 2 * src_strd;
+    UWORD8 *pu1_dst_col = pu1_dst + col;
+    v128_t h0_8x16b, h1_8x16b, h2_8x16b, h3_8x16b, h4_8x16b, h5_8x16b;
+
+    h0_8x16b = ih264_six_tap_8x16b_simd128(pu1_src_col, 1);
+    h1_8x16b = ih264_six_tap_8x16b_simd128(pu1_src_col + src_strd, 1);
+    h2_8x16b = ih264_six_tap_8x16b_simd128(pu1_src_col + 2 * src_strd, 1);
+    h3_8x16b = ih264_six_tap_8x16b_simd128(pu1_src_col + 3 * src_strd, 1);
+    h4_8x16b = ih264_six_tap_8x16b_simd128(pu1_src_col + 4 * src_strd, 1);
+    pu1_src_col += 5 * src_strd;
+
+    for (row = 0; row < ht; row++) {
+      v128_t res_16x8b, horz_16x8b;
+
+      h5_8x16b = ih264_six_tap_8x16b_simd128(pu1_src_col, 1);
+      res_16x8b = ih264_six_tap_2d_8x8b_simd128(h0_8x16b, h1_8x16b, h2_8x16b,
+                                                h3_8x16b, h4_8x16b, h5_8x16b);
+      horz_16x8b = ih264_hpel_8x8b_simd128(y_half ? h3_8x16b : h2_8x16b);
+      ih264_store_8x8b_simd128(pu1_dst_col,
+                               wasm_u8x16_avgr(res_16x8b, horz_16x8b), wd);
+
+      h0_8x16b = h1_8x16b;
+      h1_8x16b = h2_8x16b;
+      h2_8x16b = h3_8x16b;
+      h3_8x16b = h4_8x16b;
+      h4_8x16b = h5_8x16b;
+      pu1_src_col += src_strd;
+      pu1_dst_col += dst_strd;
+    }
+  }
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264_inter_pred_chroma_simd128                          */
+/*                                                                           */
+/*  Description   : This function implements a four-tap 2D filter as         */
+/*                  mentioned in sec. 8.4.2.2.2 titled "Chroma sample        */
+/*                  "interpolation process". (ht,wd) can be (2,2), (4,2),    */
+/*                  (2,4), (4,4), (8,4), (4,8) or (8,8). The U and V         */
+/*                  samples stay interleaved; the weighted sum fits 16 bits. */
+/*                                                                           */
+/*  Inputs        : pu1_src  - pointer to source                             */
+/*                  pu1_dst  - pointer to destination                        */
+/*                  src_strd - stride for source                             */
+/*                  dst_strd - stride for destination                        */
+/*                  dx       - x position of destination value               */
+/*                  dy       - y position of destination value               */
+/*                  ht       - height of the block                           */
+/*                  wd       - width of the block                            */
+/*                                                                           */
+/*  Issues        : None                                                     */
+/*                                                                           */
+/*****************************************************************************/
+void ih264_inter_pred_chroma_simd128(UWORD8 *pu1_src, UWORD8 *pu1_dst,
+                                     WORD32 src_strd, WORD32 dst_strd,
+                                     WORD32 dx, WORD32 dy, WORD32 ht,
+                                     WORD32 wd) {
+  WORD32 row, col;
+  const v128_t a_8x16b = wasm_i16x8_splat((8 - dx) * (8 - dy));
+  const v128_t b_8x16b = wasm_i16x8_splat(dx * (8 - dy));
+  const v128_t c_8x16b = wasm_i16x8_splat((8 - dx) * dy);
+  const v128_t d_8x16b = wasm_i16x8_splat(dx * dy);
+  const v128_t rnd_8x16b = wasm_i16x8_splat(32);
+
+  wd <<= 1;
+  for (col = 0; col < wd; col += 8) {
+    UWORD8 *pu1_src_col = pu1_src + col;
+    UWORD8 *pu1_dst_col = pu1_dst + col;
+    v128_t cur0_8x16b, cur2_8x16b;
+
+    cur0_8x16b = wasm_u16x8_load8x8(pu1_src_col);
+    cur2_8x16b = wasm_u16x8_load8x8(pu1_src_col + 2);
+
+    for (row = 0; row < ht; row++) {
+      v128_t nxt0_8x16b, nxt2_8x16b, res_8x16b;
+
+      pu1_src_col += src_strd;
+      nxt0_8x16b = wasm_u16x8_load8x8(pu1_src_col);
+      nxt2_8x16b = wasm_u16x8_load8x8(pu1_src_col + 2);
+
+      res_8x16b = wasm_i16x8_add(wasm_i16x8_mul(a_8x16b, cur0_8x16b),
+                                 wasm_i16x8_mul(b_8x16b, cur2_8x16b));
+      res_8x16b =
+          wasm_i16x8_add(res_8x16b, wasm_i16x8_mul(c_8x16b, nxt0_8x16b));
+      res_8x16b =
+          wasm_i16x8_add(res_8x16b, wasm_i16x8_mul(d_8x16b, nxt2_8x16b));
+      res_8x16b = wasm_u16x8_shr(wasm_i16x8_add(res_8x16b, rnd_8x16b), 6);
+
+      ih264_store_8x8b_simd128(pu1_dst_col,
+                               wasm_u8x16_narrow_i16x8(res_8x16b, res_8x16b),
+                               wd);
+      pu1_dst_col += dst_strd;
+      cur0_8x16b = nxt0_8x16b;
+      cur2_8x16b = nxt2_8x16b;
+    }
+  }
+}
@@ -0,0 +1,769 @@
+/* Copyright (c) [2020]-[2023] Ittiam Systems Pvt. Ltd.
+   All rights reserved.
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted (subject to the limitations in the
+   disclaimer below) provided that the following conditions are met:
+   •    Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+   •    Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+   •    None of the names of Ittiam Systems Pvt. Ltd., its affiliates,
+   investors, business partners, nor the names of its contributors may be
+   used to endorse or promote products derived from this software without
+   specific prior written permission.
+
+   NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED
+   BY THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+   BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+   FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+   HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+   OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+   WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+   OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+   EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+   This Software is an implementation of the AVC/H.264
+   standard by Ittiam Systems Pvt. Ltd. (“Ittiam”).
+   Additional patent licenses may be required for this Software,
+   including, but not limited to, a license from MPEG LA’s AVC/H.264
+   licensing program (see https://www.mpegla.com/programs/avc-h-264/).
+
+   NOTWITHSTANDING ANYTHING TO THE CONTRARY, THIS DOES NOT GRANT ANY
+   EXPRESS OR IMPLIED LICENSES TO ANY PATENT CLAIMS OF ANY AFFILIATE
+   (TO THE EXTENT NOT IN THE LEGAL ENTITY), INVESTOR, OR OTHER
+   BUSINESS PARTNER OF ITTIAM. You may only use this software or
+   modifications thereto for purposes that are authorized by
+   appropriate patent licenses. You should seek legal advice based
+   upon your implementation details.
+
+---------------------------------------------------------------
+*/
+/**
+ *******************************************************************************
+ * @file
+ *  ih264_iquant_itrans_recon_simd128.c
+ *
+ * @brief
+ *  Contains function definitions for inverse quantization, inverse
+ * transform and reconstruction in WebAssembly SIMD128 intrinsics
+ *
+ * @par List of Functions:
+ *  - ih264_iquant_itrans_recon_4x4_simd128()
+ *  - ih264_iquant_itrans_recon_4x4_dc_simd128()
+ *  - ih264_iquant_itrans_recon_8x8_simd128()
+ *  - ih264_iquant_itrans_recon_8x8_dc_simd128()
+ *  - ih264_iquant_itrans_recon_chroma_4x4_simd128()
+ *  - ih264_iquant_itrans_recon_chroma_4x4_dc_simd128()
+ *
+ * @remarks
+ *  Inverse quantization is done in 32 bit lanes and its result truncated to
+ *  16 bits, the transforms in 16 bit lanes, so that the intermediate values
+ *  wrap exactly as in the C functions
+ *
+ *******************************************************************************
+ */
+/* User include files */
+#include <wasm_simd128.h>
+#include "ih264_typedefs.h"
+#include "ih264_defs.h"
+#include "ih264_trans_macros.h"
+#include "ih264_macros.h"
+#include "ih264_size_defs.h"
+#include "ih264_trans_quant_itrans_iquant.h"
+
+/* (x * scale * weight + rnd) << qp_div >> qbits of 4 coefficients */
+static __inline v128_t ih264_iquant_4x32b_simd128(const WORD16 *pi2_src,
+                                                  const UWORD16 *pu2_iscal_mat,
+                                                  const UWORD16 *pu2_weigh_mat,
+                                                  v128_t rnd_4x32b,
+                                                  UWORD32 u4_qp_div_6,
+                                                  UWORD32 u4_qbits) {
+  v128_t q_4x32b = wasm_i32x4_load16x4(pi2_src);
+
+  q_4x32b = wasm_i32x4_mul(q_4x32b, wasm_u32x4_load16x4(pu2_iscal_mat));
+  q_4x32b = wasm_i32x4_mul(q_4x32b, wasm_u32x4_load16x4(pu2_weigh_mat));
+  q_4x32b = wasm_i32x4_shl(wasm_i32x4_add(q_4x32b, rnd_4x32b), u4_qp_div_6);
+  return wasm_i32x4_shr(q_4x32b, u4_qbits);
+}
+
+/* Low 16 bits of the 32 bit lanes of a followed by those of b */
+static __inline v128_t ih264_trunc_8x16b_simd128(v128_t a_4x32b,
+                                                 v128_t b_4x32b) {
+  return wasm_i16x8_shuffle(a_4x32b, b_4x32b, 0, 2, 4, 6, 8, 10, 12, 14);
+}
+
+/*
+ * Shared by the luma and chroma 4x4 functions, which differ in the DC and
+ * in the sample spacing of pred and out. Returns rows 0 | 1 and 3 | 2 of
+ * the residue, (x + 32) >> 6 already applied
+ */
+static __inline void ih264_itrans_4x4_simd128(v128_t r0, v128_t r1, v128_t r2,
+                                              v128_t r3, v128_t *pv_res01,
+                                              v128_t *pv_res32) {
+  v128_t t0, t1, t2, t3, x0, x1, x2, x3, s, d, e, f;
+  const v128_t rnd_8x16b = wasm_i16x8_splat(16);
+
+  /* horizontal inverse transform, a lane per row */
+  t0 = wasm_i32x4_shuffle(r0, r1, 0, 4, 1, 5);
+  t1 = wasm_i32x4_shuffle(r2, r3, 0, 4, 1, 5);
+  t2 = wasm_i32x4_shuffle(r0, r1, 2, 6, 3, 7);
+  t3 = wasm_i32x4_shuffle(r2, r3, 2, 6, 3, 7);
+  r0 = wasm_i64x2_shuffle(t0, t1, 0, 2);
+  r1 = wasm_i64x2_shuffle(t0, t1, 1, 3);
+  r2 = wasm_i64x2_shuffle(t2, t3, 0, 2);
+  r3 = wasm_i64x2_shuffle(t2, t3, 1, 3);
+
+  x0 = wasm_i32x4_add(r0, r2);
+  x1 = wasm_i32x4_sub(r0, r2);
+  x2 = wasm_i32x4_sub(wasm_i32x4_shr(r1, 1), r3);
+  x3 = wasm_i32x4_add(r1, wasm_i32x4_shr(r3, 1));
+
+  t0 = ih264_trunc_8x16b_simd128(wasm_i32x4_add(x0, x3),
+                                 wasm_i32x4_add(x1, x2));
+  t1 = ih264_trunc_8x16b_simd128(wasm_i32x4_sub(x1, x2),
+                                 wasm_i32x4_sub(x0, x3));
+
+  /* back to a row per 4 lanes: (w0 | w1), (w2 | w3) */
+  t2 = wasm_i16x8_shuffle(t0, t1, 0, 4, 8, 12, 1, 5, 9, 13);
+  t3 = wasm_i16x8_shuffle(t0, t1, 2, 6, 10, 14, 3, 7, 11, 15);
+
+  /* vertical inverse transform */
+  s = wasm_i16x8_add(t2, t3);
+  d = wasm_i16x8_sub(t2, t3);
+  e = wasm_i16x8_sub(wasm_i16x8_shr(t2, 1), t3);
+  f = wasm_i16x8_add(t2, wasm_i16x8_shr(t3, 1));
+  x0 = wasm_i64x2_shuffle(s, d, 0, 2);
+  x1 = wasm_i64x2_shuffle(f, e, 1, 3);
+
+  /* (x + 32) >> 6 as ((x >> 1) + 16) >> 5 to stay within 16 bits */
+  t0 = wasm_i16x8_shr(wasm_i16x8_add(x0, x1), 1);
+  t1 = wasm_i16x8_shr(wasm_i16x8_sub(x0, x1), 1);
+  *pv_res01 = wasm_i16x8_shr(wasm_i16x8_add(t0, rnd_8x16b), 5);
+  *pv_res32 = wasm_i16x8_shr(wasm_i16x8_add(t1, rnd_8x16b), 5);
+}
+
+/* Transposes 8x8 16 bit values in place */
+static __inline void ih264_transpose_8x8_16b_simd128(v128_t *pv_row) {
+  v128_t a0, a1, a2, a3, a4, a5, a6, a7, b0, b1, b2, b3, b4, b5, b6, b7;
+
+  a0 = wasm_i16x8_shuffle(pv_row[0], pv_row[1], 0, 8, 1, 9, 2, 10, 3, 11);
+  a1 = wasm_i16x8_shuffle(pv_row[0], pv_row[1], 4, 12, 5, 13, 6, 14, 7, 15);
+  a2 = wasm_i16x8_shuffle(pv_row[2], pv_row[3], 0, 8, 1, 9, 2, 10, 3, 11);
+  a3 = wasm_i16x8_shuffle(pv_row[2], pv_row[3], 4, 12, 5, 13, 6, 14, 7, 15);
+  a4 = wasm_i16x8_shuffle(pv_row[4], pv_row[5], 0, 8, 1, 9, 2, 10, 3, 11);
+  a5 = wasm_i16x8_shuffle(pv_row[4], pv_row[5], 4, 12, 5, 13, 6, 14, 7, 15);
+  a6 = wasm_i16x8_shuffle(pv_row[6], pv_row[7], 0, 8, 1, 9, 2, 10, 3, 11);
+  a7 = wasm_i16x8_shuffle(pv_row[6], pv_row[7], 4, 12, 5, 13, 6, 14, 7, 15);
+
+  b0 = wasm_i32x4_shuffle(a0, a2, 0, 4, 1, 5);
+  b1 = wasm_i32x4_shuffle(a0, a2, 2, 6, 3, 7);
+  b2 = wasm_i32x4_shuffle(a1, a3, 0, 4, 1, 5);
+  b3 = wasm_i32x4_shuffle(a1, a3, 2, 6, 3, 7);
+  b4 = wasm_i32x4_shuffle(a4, a6, 0, 4, 1, 5);
+  b5 = wasm_i32x4_shuffle(a4, a6, 2, 6, 3, 7);
+  b6 = wasm_i32x4_shuffle(a5, a7, 0, 4, 1, 5);
+  b7 = wasm_i32x4_shuffle(a5, a7, 2, 6, 3, 7);
+
+  pv_row[0] = wasm_i64x2_shuffle(b0, b4, 0, 2);
+  pv_row[1] = wasm_i64x2_shuffle(b0, b4, 1, 3);
+  pv_row[2] = wasm_i64x2_shuffle(b1, b5, 0, 2);
+  pv_row[3] = wasm_i64x2_shuffle(b1, b5, 1, 3);
+  pv_row[4] = wasm_i64x2_shuffle(b2, b6, 0, 2);
+  pv_row[5] = wasm_i64x2_shuffle(b2, b6, 1, 3);
+  pv_row[6] = wasm_i64x2_shuffle(b3, b7, 0, 2);
+  pv_row[7] = wasm_i64x2_shuffle(b3, b7, 1, 3);
+}
+
+/* One pass of the 8 point inverse transform across the 8 vectors of pv_w */
+static __inline void ih264_itrans_8_simd128(v128_t *pv_w, v128_t *pv_z) {
+  v128_t y0, y1, y2, y3, y4, y5, y6, y7;
+
+  y0 = wasm_i16x8_add(pv_w[0], pv_w[4]);
+  y1 = wasm_i16x8_sub(wasm_i16x8_sub(pv_w[5], pv_w[3]),
+                      wasm_i16x8_add(pv_w[7], wasm_i16x8_shr(pv_w[7], 1)));
+  y2 = wasm_i16x8_sub(pv_w[0], pv_w[4]);
+  y3 = wasm_i16x8_sub(wasm_i16x8_add(pv_w[1], pv_w[7]),
+                      wasm_i16x8_add(pv_w[3], wasm_i16x8_shr(pv_w[3], 1)));
+  y4 = wasm_i16x8_sub(wasm_i16x8_shr(pv_w[2], 1), pv_w[6]);
+  y5 = wasm_i16x8_add(wasm_i16x8_sub(pv_w[7], pv_w[1]),
+                      wasm_i16x8_add(pv_w[5], wasm_i16x8_shr(pv_w[5], 1)));
+  y6 = wasm_i16x8_add(pv_w[2], wasm_i16x8_shr(pv_w[6], 1));
+  y7 = wasm_i16x8_add(wasm_i16x8_add(pv_w[3], pv_w[5]),
+                      wasm_i16x8_add(pv_w[1], wasm_i16x8_shr(pv_w[1], 1)));
+
+  pv_z[0] = wasm_i16x8_add(y0, y6);
+  pv_z[1] = wasm_i16x8_add(y1, wasm_i16x8_shr(y7, 2));
+  pv_z[2] = wasm_i16x8_add(y2, y4);
+  pv_z[3] = wasm_i16x8_add(y3, wasm_i16x8_shr(y5, 2));
+  pv_z[4] = wasm_i16x8_sub(y2, y4);
+  pv_z[5] = wasm_i16x8_sub(wasm_i16x8_shr(y3, 2), y5);
+  pv_z[6] = wasm_i16x8_sub(y0, y6);
+  pv_z[7] = wasm_i16x8_sub(y7, wasm_i16x8_shr(y1, 2));
+}
+
+/* (a + b + 32) >> 6 or (a - b + 32) >> 6 in 32 bits, added to 8 pred */
+static __inline v128_t ih264_recon_8x8b_simd128(v128_t a_8x16b, v128_t b_8x16b,
+                                                WORD32 i4_sub,
+                                                const UWORD8 *pu1_pred) {
+  v128_t lo_4x32b, hi_4x32b;
+  const v128_t rnd_4x32b = wasm_i32x4_splat(32);
+
+  lo_4x32b = wasm_i32x4_extend_low_i16x8(a_8x16b);
+  hi_4x32b = wasm_i32x4_extend_high_i16x8(a_8x16b);
+  if (i4_sub) {
+    lo_4x32b = wasm_i32x4_sub(lo_4x32b, wasm_i32x4_extend_low_i16x8(b_8x16b));
+    hi_4x32b = wasm_i32x4_sub(hi_4x32b, wasm_i32x4_extend_high_i16x8(b_8x16b));
+  } else {
+    lo_4x32b = wasm_i32x4_add(lo_4x32b, wasm_i32x4_extend_low_i16x8(b_8x16b));
+    hi_4x32b = wasm_i32x4_add(hi_4x32b, wasm_i32x4_extend_high_i16x8(b_8x16b));
+  }
+  lo_4x32b = wasm_i32x4_shr(wasm_i32x4_add(lo_4x32b, rnd_4x32b), 6);
+  hi_4x32b = wasm_i32x4_shr(wasm_i32x4_add(hi_4x32b, rnd_4x32b), 6);
+
+  lo_4x32b = wasm_i16x8_add(wasm_i16x8_narrow_i32x4(lo_4x32b, hi_4x32b),
+                            wasm_u16x8_load8x8(pu1_pred));
+  return wasm_u8x16_narrow_i16x8(lo_4x32b, lo_4x32b);
+}
+
+/**
+ *******************************************************************************
+ *
+ * @brief
+ *  This function reconstructs a 4x4 sub block from quantized residue and
+ *  prediction buffer
+ *
+ * @par Description:
+ *  The quantized residue is first inverse quantized, then inverse transformed.
+ *  This inverse transformed content is added to the prediction buffer to
+ *  reconstruct the end output
+ *
+ * @param[in] pi2_src
+ *  quantized 4x4 block
+ *
+ * @param[in] pu1_pred
+ *  prediction 4x4 block
+ *
+ * @param[out] pu1_out
+ *  reconstructed 4x4 block
+ *
+ * @param[in] pred_strd,
+ *  Prediction buffer stride
+ *
+ * @param[in] out_strd
+ *  recon buffer Stride
+ *
+ * @param[in] pu2_iscal_mat
+ *  pointer to inverse scale matrix
+ *
+ * @param[in] pu2_weigh_mat
+ *  pointer to weight matrix
+ *
+ * @param[in] u4_qp_div_6
+ *  Floor (qp/6)
+ *
+ * @param[in] pi2_tmp
+ *  temporary buffer of size 1*16, unused
+ *
+ * @param[in] iq_start_idx
+ *  1 if the DC is taken from pi2_dc_ld_addr, else 0
+ *
+ * @param[in] pi2_dc_ld_addr
+ *  DC coefficient, already inverse quantized
+ *
+ * @returns none
+ *
+ * @remarks none
+ *
+ *******************************************************************************
+ */
+void ih264_iquant_itrans_recon_4x4_simd128(
+    WORD16 *pi2_src, UWORD8 *pu1_pred, UWORD8 *pu1_out, WORD32 pred_strd,
+    WORD32 out_strd, const UWORD16 *pu2_iscal_mat, const UWORD16 *pu2_weigh_mat,
+    UWORD32 u4_qp_div_6, WORD16 *pi2_tmp, WORD32 iq_start_idx,
+    WORD16 *pi2_dc_ld_addr) {
+  v128_t r0, r1, r2, r3, res01, res32, pred01, pred32;
+  const v128_t rnd_4x32b =
+      wasm_i32x4_splat((u4_qp_div_6 < 4) ? 1 << (3 - u4_qp_div_6) : 0);
+  UNUSED(pi2_tmp);
+
+  r0 = ih264_iquant_4x32b_simd128(pi2_src, pu2_iscal_mat, pu2_weigh_mat,
+                                  rnd_4x32b, u4_qp_div_6, 4);
+  r1 = ih264_iquant_4x32b_simd128(pi2_src + 4, pu2_iscal_mat + 4,
+                                  pu2_weigh_mat + 4, rnd_4x32b, u4_qp_div_6, 4);
+  r2 = ih264_iquant_4x32b_simd128(pi2_src + 8, pu2_iscal_mat + 8,
+                                  pu2_weigh_mat + 8, rnd_4x32b, u4_qp_div_6, 4);
+  r3 = ih264_iquant_4x32b_simd128(pi2_src + 12, pu2_iscal_mat + 12,
+                                  pu2_weigh_mat + 12, rnd_4x32b, u4_qp_div_6,
+                                  4);
+  if (iq_start_idx == 1) r0 = wasm_i32x4_replace_lane(r0, 0, pi2_dc_ld_addr[0]);
+
+  ih264_itrans_4x4_simd128(r0, r1, r2, r3, &res01, &res32);
+
+  pred01 = wasm_v128_load32_zero(pu1_pred);
+  pred01 = wasm_v128_load32_lane(pu1_pred + pred_strd, pred01, 1);
+  pred32 = wasm_v128_load32_zero(pu1_pred + 3 * pred_strd);
+  pred32 = wasm_v128_load32_lane(pu1_pred + 2 * pred_strd, pred32, 1);
+  res01 = wasm_i16x8_add(res01, wasm_u16x8_extend_low_u8x16(pred01));
+  res32 = wasm_i16x8_add(res32, wasm_u16x8_extend_low_u8x16(pred32));
+  res01 = wasm_u8x16_narrow_i16x8(res01, res32);
+
+  wasm_v128_store32_lane(pu1_out, res01, 0);
+  wasm_v128_store32_lane(pu1_out + out_strd, res01, 1);
+  wasm_v128_store32_lane(pu1_out + 3 * out_strd, res01, 2);
+  wasm_v128_store32_lane(pu1_out + 2 * out_strd, res01, 3);
+}
+
+/**
+ *******************************************************************************
+ *
+ * @brief
+ *  This function reconstructs a 4x4 sub block whose only non zero
+ *  coefficient is the DC
+ *
+ * @par Description:
+ *  The rounded DC is added to all the samples of the prediction block
+ *
+ * @param[in] pi2_src
+ *  quantized 4x4 block
+ *
+ * @param[in] pu1_pred
+ *  prediction 4x4 block
+ *
+ * @param[out] pu1_out
+ *  reconstructed 4x4 block
+ *
+ * @param[in] pred_strd,
+ *  Prediction buffer stride
+ *
+ * @param[in] out_strd
+ *  recon buffer Stride
+ *
+ * @param[in] pu2_iscal_mat
+ *  pointer to inverse scale matrix
+ *
+ * @param[in] pu2_weigh_mat
+ *  pointer to weight matrix
+ *
+ * @param[in] u4_qp_div_6
+ *  Floor (qp/6)
+ *
+ * @param[in] pi2_tmp
+ *  temporary buffer, unused
+ *
+ * @param[in] iq_start_idx
+ *  1 if the DC is taken from pi2_dc_ld_addr, else 0
+ *
+ * @param[in] pi2_dc_ld_addr
+ *  DC coefficient, already inverse quantized
+ *
+ * @returns none
+ *
+ * @remarks none
+ *
+ *******************************************************************************
+ */
+void ih264_iquant_itrans_recon_4x4_dc_simd128(
+    WORD16 *pi2_src, UWORD8 *pu1_pred, UWORD8 *pu1_out, WORD32 pred_strd,
+    WORD32 out_strd, const UWORD16 *pu2_iscal_mat, const UWORD16 *pu2_weigh_mat,
+    UWORD32 u4_qp_div_6, WORD16 *pi2_tmp, WORD32 iq_start_idx,
+    WORD16 *pi2_dc_ld_addr) {
+  WORD32 q0;
+  WORD16 i_macro;
+  WORD16 rnd_fact = (u4_qp_div_6 < 4) ? 1 << (3 - u4_qp_div_6) : 0;
+  v128_t dc_8x16b, pred_16x8b, lo_8x16b, hi_8x16b;
+  UNUSED(pi2_tmp);
+
+  if (iq_start_idx == 0) {
+    q0 = pi2_src[0];
+    INV_QUANT(q0, pu2_iscal_mat[0], pu2_weigh_mat[0], u4_qp_div_6, rnd_fact, 4);
+  } else {
+    q0 = pi2_dc_ld_addr[0];
+  }
+  i_macro = ((q0 + 32) >> 6);
+  dc_8x16b = wasm_i16x8_splat(i_macro);
+
+  pred_16x8b = wasm_v128_load32_zero(pu1_pred);
+  pred_16x8b = wasm_v128_load32_lane(pu1_pred + pred_strd, pred_16x8b, 1);
+  pred_16x8b = wasm_v128_load32_lane(pu1_pred + 2 * pred_strd, pred_16x8b, 2);
+  pred_16x8b = wasm_v128_load32_lane(pu1_pred + 3 * pred_strd, pred_16x8b, 3);
+  lo_8x16b = wasm_i16x8_add(wasm_u16x8_extend_low_u8x16(pred_16x8b), dc_8x16b);
+  hi_8x16b =
+      wasm_i16x8_add(wasm_u16x8_extend_high_u8x16(pred_16x8b), dc_8x16b);
+  pred_16x8b = wasm_u8x16_narrow_i16x8(lo_8x16b, hi_8x16b);
+
+  wasm_v128_store32_lane(pu1_out, pred_16x8b, 0);
+  wasm_v128_store32_lane(pu1_out + out_strd, pred_16x8b, 1);
+  wasm_v128_store32_lane(pu1_out + 2 * out_strd, pred_16x8b, 2);
+  wasm_v128_store32_lane(pu1_out + 3 * out_strd, pred_16x8b, 3);
+}
+
+/**
+ *******************************************************************************
+ *
+ * @brief
+ *  This function reconstructs an 8x8 block from quantized residue and
+ *  prediction buffer
+ *
+ * @par Description:
+ *  The 64 coefficients are inverse quantized a row at a time, each pass of
+ *  the inverse transform works across 8 vectors after a transpose
+ *
+ * @param[in] pi2_src
+ *  quantized 8x8 block
+ *
+ * @param[in] pu1_pred
+ *  prediction 8x8 block
+ *
+ * @param[out] pu1_out
+ *  reconstructed 8x8 block
+ *
+ * @param[in] pred_strd,
+ *  Prediction buffer stride
+ *
+ * @param[in] out_strd
+ *  recon buffer Stride
+ *
+ * @param[in] pu2_iscale_mat
+ *  pointer to inverse scale matrix
+ *
+ * @param[in] pu2_weigh_mat
+ *  pointer to weight matrix
+ *
+ * @param[in] qp_div
+ *  Floor (qp/6)
+ *
+ * @param[in] pi2_tmp
+ *  temporary buffer, unused
+ *
+ * @param[in] iq_start_idx
+ *  unused
+ *
+ * @param[in] pi2_dc_ld_addr
+ *  unused
+ *
+ * @returns none
+ *
+ * @remarks none
+ *
+ *******************************************************************************
+ */
+void ih264_iquant_itrans_recon_8x8_simd128(
+    WORD16 *pi2_src, UWORD8 *pu1_pred, UWORD8 *pu1_out, WORD32 pred_strd,
+    WORD32 out_strd, const UWORD16 *pu2_iscale_mat,
+    const UWORD16 *pu2_weigh_mat, UWORD32 qp_div, WORD16 *pi2_tmp,
+    WORD32 iq_start_idx, WORD16 *pi2_dc_ld_addr) {
+  v128_t w_8x16b[8], z_8x16b[8], res_16x8b;
+  const v128_t rnd_4x32b =
+      wasm_i32x4_splat((qp_div < 6) ? (1 << (5 - qp_div)) : 0);
+  WORD32 i;
+  UNUSED(pi2_tmp);
+  UNUSED(iq_start_idx);
+  UNUSED(pi2_dc_ld_addr);
+
+  for (i = 0; i < SUB_BLK_WIDTH_8x8; i++) {
+    WORD32 k = i * SUB_BLK_WIDTH_8x8;
+
+    w_8x16b[i] = ih264_trunc_8x16b_simd128(
+        ih264_iquant_4x32b_simd128(pi2_src + k, pu2_iscale_mat + k,
+                                   pu2_weigh_mat + k, rnd_4x32b, qp_div, 6),
+        ih264_iquant_4x32b_simd128(pi2_src + k + 4, pu2_iscale_mat + k + 4,
+                                   pu2_weigh_mat + k + 4, rnd_4x32b, qp_div,
+                                   6));
+  }
+
+  /* horizontal transform, a lane per row */
+  ih264_transpose_8x8_16b_simd128(w_8x16b);
+  ih264_itrans_8_simd128(w_8x16b, z_8x16b);
+  w_8x16b[0] = wasm_i16x8_add(z_8x16b[0], z_8x16b[7]);
+  w_8x16b[1] = wasm_i16x8_add(z_8x16b[2], z_8x16b[5]);
+  w_8x16b[2] = wasm_i16x8_add(z_8x16b[4], z_8x16b[3]);
+  w_8x16b[3] = wasm_i16x8_add(z_8x16b[6], z_8x16b[1]);
+  w_8x16b[4] = wasm_i16x8_sub(z_8x16b[6], z_8x16b[1]);
+  w_8x16b[5] = wasm_i16x8_sub(z_8x16b[4], z_8x16b[3]);
+  w_8x16b[6] = wasm_i16x8_sub(z_8x16b[2], z_8x16b[5]);
+  w_8x16b[7] = wasm_i16x8_sub(z_8x16b[0], z_8x16b[7]);
+
+  /* vertical transform, a lane per column */
+  ih264_transpose_8x8_16b_simd128(w_8x16b);
+  ih264_itrans_8_simd128(w_8x16b, z_8x16b);
+
+  res_16x8b = ih264_recon_8x8b_simd128(z_8x16b[0], z_8x16b[7], 0, pu1_pred);
+  wasm_v128_store64_lane(pu1_out, res_16x8b, 0);
+  res_16x8b = ih264_recon_8x8b_simd128(z_8x16b[2], z_8x16b[5], 0,
+                                       pu1_pred + pred_strd);
+  wasm_v128_store64_lane(pu1_out + out_strd, res_16x8b, 0);
+  res_16x8b = ih264_recon_8x8b_simd128(z_8x16b[4], z_8x16b[3], 0,
+                                       pu1_pred + 2 * pred_strd);
+  wasm_v128_store64_lane(pu1_out + 2 * out_strd, res_16x8b, 0);
+  res_16x8b = ih264_recon_8x8b_simd128(z_8x16b[6], z_8x16b[1], 0,
+                                       pu1_pred + 3 * pred_strd);
+  wasm_v128_store64_lane(pu1_out + 3 * out_strd, res_16x8b, 0);
+  res_16x8b = ih264_recon_8x8b_simd128(z_8x16b[6], z_8x16b[1], 1,
+                                       pu1_pred + 4 * pred_strd);
+  wasm_v128_store64_lane(pu1_out + 4 * out_strd, res_16x8b, 0);
+  res_16x8b = ih264_recon_8x8b_simd128(z_8x16b[4], z_8x16b[3], 1,
+                                       pu1_pred + 5 * pred_strd);
+  wasm_v128_store64_lane(pu1_out + 5 * out_strd, res_16x8b, 0);
+  res_16x8b = ih264_recon_8x8b_simd128(z_8x16b[2], z_8x16b[5], 1,
+                                       pu1_pred + 6 * pred_strd);
+  wasm_v128_store64_lane(pu1_out + 6 * out_strd, res_16x8b, 0);
+  res_16x8b = ih264_recon_8x8b_simd128(z_8x16b[0], z_8x16b[7], 1,
+                                       pu1_pred + 7 * pred_strd);
+  wasm_v128_store64_lane(pu1_out + 7 * out_strd, res_16x8b, 0);
+}
+
+/**
+ *******************************************************************************
+ *
+ * @brief
+ *  This function reconstructs an 8x8 block whose only non zero coefficient
+ *  is the DC
+ *
+ * @par Description:
+ *  The rounded DC is added to all the samples of the prediction block
+ *
+ * @param[in] pi2_src
+ *  quantized 8x8 block
+ *
+ * @param[in] pu1_pred
+ *  prediction 8x8 block
+ *
+ * @param[out] pu1_out
+ *  reconstructed 8x8 block
+ *
+ * @param[in] pred_strd,
+ *  Prediction buffer stride
+ *
+ * @param[in] out_strd
+ *  recon buffer Stride
+ *
+ * @param[in] pu2_iscale_mat
+ *  pointer to inverse scale matrix
+ *
+ * @param[in] pu2_weigh_mat
+ *  pointer to weight matrix
+ *
+ * @param[in] qp_div
+ *  Floor (qp/6)
+ *
+ * @param[in] pi2_tmp
+ *  temporary buffer, unused
+ *
+ * @param[in] iq_start_idx
+ *  unused
+ *
+ * @param[in] pi2_dc_ld_addr
+ *  unused
+ *
+ * @returns none
+ *
+ * @remarks none
+ *
+ *******************************************************************************
+ */
+void ih264_iquant_itrans_recon_8x8_dc_simd128(
+    WORD16 *pi2_src, UWORD8 *pu1_pred, UWORD8 *pu1_out, WORD32 pred_strd,
+    WORD32 out_strd, const UWORD16 *pu2_iscale_mat,
+    const UWORD16 *pu2_weigh_mat, UWORD32 qp_div, WORD16 *pi2_tmp,
+    WORD32 iq_start_idx, WORD16 *pi2_dc_ld_addr) {
+  WORD32 q, i;
+  WORD16 i_macro;
+  WORD32 rnd_fact = (qp_div < 6) ? (1 << (5 - qp_div)) : 0;
+  v128_t dc_8x16b;
+  UNUSED(pi2_tmp);
+  UNUSED(iq_start_idx);
+  UNUSED(pi2_dc_ld_addr);
+
+  q = pi2_src[0];
+  INV_QUANT(q, pu2_iscale_mat[0], pu2_weigh_mat[0], qp_div, rnd_fact, 6);
+  i_macro = (q + 32) >> 6;
+  dc_8x16b = wasm_i16x8_splat(i_macro);
+
+  for (i = 0; i < SUB_BLK_WIDTH_8x8; i += 2) {
+    v128_t pred_16x8b, lo_8x16b, hi_8x16b;
+
+    pred_16x8b = wasm_v128_load64_zero(pu1_pred);
+    pred_16x8b = wasm_v128_load64_lane(pu1_pred + pred_strd, pred_16x8b, 1);
+    lo_8x16b =
+        wasm_i16x8_add(wasm_u16x8_extend_low_u8x16(pred_16x8b), dc_8x16b);
+    hi_8x16b =
+        wasm_i16x8_add(wasm_u16x8_extend_high_u8x16(pred_16x8b), dc_8x16b);
+    pred_16x8b = wasm_u8x16_narrow_i16x8(lo_8x16b, hi_8x16b);
+    wasm_v128_store64_lane(pu1_out, pred_16x8b, 0);
+    wasm_v128_store64_lane(pu1_out + out_strd, pred_16x8b, 1);
+
+    pu1_pred += 2 * pred_strd;
+    pu1_out += 2 * out_strd;
+  }
+}
+
+/* Adds residue rows to the U or V samples of two interleaved rows */
+static __inline void ih264_recon_chroma_2x4_simd128(v128_t res_8x16b,
+                                                    const UWORD8 *pu1_pred0,
+                                                    const UWORD8 *pu1_pred1,
+                                                    UWORD8 *pu1_out0,
+                                                    UWORD8 *pu1_out1) {
+  v128_t pred_8x16b, out_16x8b;
+  const v128_t mask_8x16b = wasm_i16x8_splat(0x00ff);
+
+  pred_8x16b = wasm_v128_load64_zero(pu1_pred0);
+  pred_8x16b = wasm_v128_load64_lane(pu1_pred1, pred_8x16b, 1);
+  out_16x8b = wasm_v128_load64_zero(pu1_out0);
+  out_16x8b = wasm_v128_load64_lane(pu1_out1, out_16x8b, 1);
+
+  res_8x16b = wasm_i16x8_add(res_8x16b, wasm_v128_and(pred_8x16b, mask_8x16b));
+  res_8x16b = wasm_i16x8_min(wasm_i16x8_max(res_8x16b, wasm_i16x8_splat(0)),
+                             mask_8x16b);
+  out_16x8b = wasm_v128_bitselect(res_8x16b, out_16x8b, mask_8x16b);
+
+  wasm_v128_store64_lane(pu1_out0, out_16x8b, 0);
+  wasm_v128_store64_lane(pu1_out1, out_16x8b, 1);
+}
+
+/**
+ *******************************************************************************
+ *
+ * @brief
+ *  This function reconstructs a 4x4 sub block of one chroma component of
+ *  an interleaved buffer from quantized residue and prediction buffer
+ *
+ * @par Description:
+ *  As the luma 4x4 function, with the DC taken from pi2_dc_src and only
+ *  every other sample of pred and out being touched
+ *
+ * @param[in] pi2_src
+ *  quantized 4x4 block
+ *
+ * @param[in] pu1_pred
+ *  prediction 4x4 block
+ *
+ * @param[out] pu1_out
+ *  reconstructed 4x4 block
+ *
+ * @param[in] pred_strd,
+ *  Prediction buffer stride
+ *
+ * @param[in] out_strd
+ *  recon buffer Stride
+ *
+ * @param[in] pu2_iscal_mat
+ *  pointer to inverse scale matrix
+ *
+ * @param[in] pu2_weigh_mat
+ *  pointer to weight matrix
+ *
+ * @param[in] u4_qp_div_6
+ *  Floor (qp/6)
+ *
+ * @param[in] pi2_tmp
+ *  temporary buffer, unused
+ *
+ * @param[in] pi2_dc_src
+ *  DC coefficient, already inverse quantized
+ *
+ * @returns none
+ *
+ * @remarks none
+ *
+ *******************************************************************************
+ */
+void ih264_iquant_itrans_recon_chroma_4x4_simd128(
+    WORD16 *pi2_src, UWORD8 *pu1_pred, UWORD8 *pu1_out, WORD32 pred_strd,
+    WORD32 out_strd, const UWORD16 *pu2_iscal_mat, const UWORD16 *pu2_weigh_mat,
+    UWORD32 u4_qp_div_6, WORD16 *pi2_tmp, WORD16 *pi2_dc_src) {
+  v128_t r0, r1, r2, r3, res01, res32;
+  const v128_t rnd_4x32b =
+      wasm_i32x4_splat((u4_qp_div_6 < 4) ? 1 << (3 - u4_qp_div_6) : 0);
+  UNUSED(pi2_tmp);
+
+  r0 = ih264_iquant_4x32b_simd128(pi2_src, pu2_iscal_mat, pu2_weigh_mat,
+                                  rnd_4x32b, u4_qp_div_6, 4);
+  r1 = ih264_iquant_4x32b_simd128(pi2_src + 4, pu2_iscal_mat + 4,
+                                  pu2_weigh_mat + 4, rnd_4x32b, u4_qp_div_6, 4);
+  r2 = ih264_iquant_4x32b_simd128(pi2_src + 8, pu2_iscal_mat + 8,
+                                  pu2_weigh_mat + 8, rnd_4x32b, u4_qp_div_6, 4);
+  r3 = ih264_iquant_4x32b_simd128(pi2_src + 12, pu2_iscal_mat + 12,
+                                  pu2_weigh_mat + 12, rnd_4x32b, u4_qp_div_6,
+                                  4);
+  r0 = wasm_i32x4_replace_lane(r0, 0, pi2_dc_src[0]);
+
+  ih264_itrans_4x4_simd128(r0, r1, r2, r3, &res01, &res32);
+
+  ih264_recon_chroma_2x4_simd128(res01, pu1_pred, pu1_pred + pred_strd,
+                                 pu1_out, pu1_out + out_strd);
+  ih264_recon_chroma_2x4_simd128(res32, pu1_pred + 3 * pred_strd,
+                                 pu1_pred + 2 * pred_strd,
+                                 pu1_out + 3 * out_strd,
+                                 pu1_out + 2 * out_strd);
+}
+
+/**
+ *******************************************************************************
+ *
+ * @brief
+ *  This function reconstructs a 4x4 sub block of one chroma component of
+ *  an interleaved buffer whose only non zero coefficient is the DC
+ *
+ * @par Description:
+ *  The rounded DC is added to every other sample of the prediction block
+ *
+ * @param[in] pi2_src
+ *  unused
+ *
+ * @param[in] pu1_pred
+ *  prediction 4x4 block
+ *
+ * @param[out] pu1_out
+ *  reconstructed 4x4 block
+ *
+ * @param[in] pred_strd,
+ *  Prediction buffer stride
+ *
+ * @param[in] out_strd
+ *  recon buffer Stride
+ *
+ * @param[in] pu2_iscal_mat
+ *  unused
+ *
+ * @param[in] pu2_weigh_mat
+ *  unused
+ *
+ * @param[in] u4_qp_div_6
+ *  unused
+ *
+ * @param[in] pi2_tmp
+ *  unused
+ *
+ * @param[in] pi2_dc_src
+ *  DC coefficient, already inverse quantized
+ *
+ * @returns none
+ *
+ * @remarks none
+ *
+ *******************************************************************************
+ */
+void ih264_iquant_itrans_recon_chroma_4x4_dc_simd128(
+    WORD16 *pi2_src, UWORD8 *pu1_pred, UWORD8 *pu1_out, WORD32 pred_strd,
+    WORD32 out_strd, const UWORD16 *pu2_iscal_mat, const UWORD16 *pu2_weigh_mat,
+    UWORD32 u4_qp_div_6, WORD16 *pi2_tmp, WORD16 *pi2_dc_src) {
+  WORD32 q0 = pi2_dc_src[0];
+  WORD16 i_macro = ((q0 + 32) >> 6);
+  v128_t dc_8x16b = wasm_i16x8_splat(i_macro);
+  UNUSED(pi2_src);
+  UNUSED(pu2_iscal_mat);
+  UNUSED(pu2_weigh_mat);
+  UNUSED(u4_qp_div_6);
+  UNUSED(pi2_tmp);
+
+  ih264_recon_chroma_2x4_simd128(dc_8x16b, pu1_pred, pu1_pred + pred_strd,
+                                 pu1_out, pu1_out + out_strd);
+  ih264_recon_chroma_2x4_simd128(dc_8x16b, pu1_pred + 2 * pred_strd,
+                                 pu1_pred + 3 * pred_strd,
+                                 pu1_out + 2 * out_strd,
+                                 pu1_out + 3 * out_strd);
+}
@@ -107,6 +107,44 @@ typedef enum {
 
 } IH264D_ERROR_CODES_T;
 
+/* Placement hint of a memory record, see ih264d_fill_mem_rec_ip_t */
+typedef enum {
+  /* Accessed at random for every MB, e.g. reference pictures read by MC. */
+  /* Worth huge pages and memory local to the decoding threads            */
+  IH264D_MEM_PLACEMENT_HOT = 0,
+
+  /* Written or read once per picture in MB order */
+  IH264D_MEM_PLACEMENT_STREAMING = 1,
+
+  /* Touched a few times per picture or per call */
+  IH264D_MEM_PLACEMENT_COLD = 2,
+} IH264D_MEM_PLACEMENT_T;
+
+/* Components the memory records are reported under by fill mem rec, see */
+/* ih264d_fill_mem_rec_op_t                                               */
+typedef enum {
+  /* Reference and display pictures and their managers */
+  IH264D_MEM_COMPONENT_DPB = 0,
+
+  /* MV bank, co-located MVs and zero flags, and the MV buffer manager */
+  IH264D_MEM_COMPONENT_MV_BANK = 1,
+
+  /* Bitstream buffer */
+  IH264D_MEM_COMPONENT_BITSTREAM = 2,
+
+  /* Per MB and per MB row context: MB info, coefficients, prediction */
+  /* info, slice headers and deblocking data                          */
+  IH264D_MEM_COMPONENT_MB_CONTEXT = 3,
+
+  /* Thread handles, parse and process maps and scratch */
+  IH264D_MEM_COMPONENT_THREAD_SCRATCH = 4,
+
+  /* Codec object, parameter sets, SEI and the rest */
+  IH264D_MEM_COMPONENT_OTHER = 5,
+
+  IH264D_MEM_COMPONENT_CNT = 6,
+} IH264D_MEM_COMPONENT_T;
+
 /*****************************************************************************/
 /* Extended Structures                                                       */
 /*****************************************************************************/
@@ -141,11 +179,52 @@ typedef struct {
    * pipeline depth */
   UWORD32 u4_num_extra_disp_buf;
 
+  /* When 1, records whose size scales with the picture are reported at a */
+  /* minimal size. They are allocated through the callbacks given at init */
+  /* when an SPS is activated, sized to that SPS instead of the maximum   */
+  UWORD32 u4_alloc_per_sps;
+
+  /* Optional array with an entry per memory record, i.e. the count from  */
+  /* IV_CMD_GET_NUM_MEM_REC. When not NULL it is filled with the placement */
+  /* hint of each record                                                  */
+  IH264D_MEM_PLACEMENT_T *pe_mem_placement;
+
+  /* When not 0, u4_num_extra_disp_buf and then u4_num_reorder_frames are */
+  /* lowered until the total of ih264d_fill_mem_rec_op_t fits in this    */
+  /* many bytes. Init must be given the same budget, so that it uses the  */
+  /* same values                                                          */
+  UWORD32 u4_mem_budget;
+
+  /* When 1, film grain signalled by film grain characteristics SEI is    */
+  /* synthesised and added to the display buffer during format            */
+  /* conversion. Needs an output format other than RGB565 and buffers     */
+  /* that are not shared                                                  */
+  UWORD32 u4_film_grain;
+
+  /* When 1, the stream has I slices only, see                            */
+  /* IH264D_CMD_CTL_SET_INTRA_ONLY. No picture is kept for reference, so  */
+  /* the reference picture record holds the picture being decoded, the    */
+  /* one being format converted, u4_num_reorder_frames and                */
+  /* u4_num_extra_disp_buf, and u4_num_ref_frames is ignored. The MV      */
+  /* bank records hold no co-located MVs, only the working MV bank of the */
+  /* picture being decoded, which deblocking and error concealment read   */
+  UWORD32 u4_intra_only;
+
 } ih264d_fill_mem_rec_ip_t;
 
 typedef struct {
   iv_fill_mem_rec_op_t s_ivd_fill_mem_rec_op_t;
 
+  /* Bytes of the memory records under each IH264D_MEM_COMPONENT_T and  */
+  /* their total, excluding alignment. With u4_alloc_per_sps, records    */
+  /* allocated on SPS activation are counted at the maximum dimensions  */
+  UWORD32 au4_component_size[IH264D_MEM_COMPONENT_CNT];
+  UWORD32 u4_total_size;
+
+  /* Reorder depth and extra display buffers the records are sized for */
+  UWORD32 u4_num_reorder_frames;
+  UWORD32 u4_num_extra_disp_buf;
+
 } ih264d_fill_mem_rec_op_t;
 
 /*****************************************************************************/
@@ -174,6 +253,26 @@ typedef struct {
    * pipeline depth */
   UWORD32 u4_num_extra_disp_buf;
 
+  /* Allocate picture sized records on SPS activation, see                */
+  /* ih264d_fill_mem_rec_ip_t. Both callbacks are required in that mode   */
+  /* and memory got from them is freed before retrieve memory records     */
+  /* returns                                                              */
+  UWORD32 u4_alloc_per_sps;
+  void *(*pf_aligned_alloc)(void *pv_mem_ctxt, WORD32 alignment, WORD32 size);
+  void (*pf_aligned_free)(void *pv_mem_ctxt, void *pv_buf);
+  void *pv_mem_ctxt;
+
+  /* Memory budget given to fill mem rec, see ih264d_fill_mem_rec_ip_t */
+  UWORD32 u4_mem_budget;
+
+  /* Film grain synthesis, see ih264d_fill_mem_rec_ip_t */
+  UWORD32 u4_film_grain;
+
+  /* Intra only decode with records sized for it, see                  */
+  /* ih264d_fill_mem_rec_ip_t. Enables IH264D_CMD_CTL_SET_INTRA_ONLY,   */
+  /* which can then not be cleared, not even by IVD_CMD_CTL_RESET       */
+  UWORD32 u4_intra_only;
+
 } ih264d_init_ip_t;
 
 typedef struct {
@@ -235,12 +334,36 @@ typedef enum {
   /** Set processor details */
   IH264D_CMD_CTL_SET_PROCESSOR = IVD_CMD_CTL_CODEC_SUBCMD_START + 0x001,
 
+  /** Set MC reference prefetch distance */
+  IH264D_CMD_CTL_SET_MC_PREFETCH = IVD_CMD_CTL_CODEC_SUBCMD_START + 0x002,
+
+  /** Return the memory allocated on SPS activation to the application */
+  IH264D_CMD_CTL_RELEASE_MEM = IVD_CMD_CTL_CODEC_SUBCMD_START + 0x003,
+
+  /** Output each picture in the decode call that decodes it */
+  IH264D_CMD_CTL_SET_LOW_DELAY = IVD_CMD_CTL_CODEC_SUBCMD_START + 0x004,
+
+  /** Degrade non-reference pictures to keep within a decode time budget */
+  IH264D_CMD_CTL_SET_DEADLINE = IVD_CMD_CTL_CODEC_SUBCMD_START + 0x005,
+
+  /** Promise a stream of I slices only, to skip the inter prediction setup */
+  IH264D_CMD_CTL_SET_INTRA_ONLY = IVD_CMD_CTL_CODEC_SUBCMD_START + 0x006,
+
   /** Get display buffer dimensions */
   IH264D_CMD_CTL_GET_BUFFER_DIMENSIONS = IVD_CMD_CTL_CODEC_SUBCMD_START + 0x100,
 
   /** Get VUI parameters */
   IH264D_CMD_CTL_GET_VUI_PARAMS = IVD_CMD_CTL_CODEC_SUBCMD_START + 0x101,
 
+  /** Get profiling counters, needs a library built with PERF_STATS_ENABLE */
+  IH264D_CMD_CTL_GET_PERF_STATS = IVD_CMD_CTL_CODEC_SUBCMD_START + 0x102,
+
+  /** Get trace events, needs a library built with TRACE_ENABLE */
+  IH264D_CMD_CTL_GET_TRACE_EVENTS = IVD_CMD_CTL_CODEC_SUBCMD_START + 0x103,
+
+  /** Get what the deadline controller measured and did */
+  IH264D_CMD_CTL_GET_DEADLINE_STATS = IVD_CMD_CTL_CODEC_SUBCMD_START + 0x104,
+
   /** Enable/disable GPU, supported on select platforms */
   IH264D_CMD_CTL_GPU_ENABLE_DISABLE = IVD_CMD_CTL_CODEC_SUBCMD_START + 0x200,
 
@@ -363,8 +486,9 @@ typedef struct {
   /**
    * bit position (lsb is zero): Type of degradation
    * 1 : Disable deblocking
-   * 2 : Faster inter prediction filters
-   * 3 : Fastest inter prediction filters
+   * 2 : Faster inter prediction filters, full pel luma MVs
+   * 3 : Fastest inter prediction filters, full pel luma and chroma MVs
+   * Inter prediction is degraded only on non-reference pictures
    */
   WORD32 i4_degrade_type;
 
@@ -382,6 +506,151 @@ typedef struct {
   UWORD32 u4_error_code;
 } ih264d_ctl_degrade_op_t;
 
+/*****************************************************************************/
+/*   Video control: Set deadline                                             */
+/*****************************************************************************/
+
+/* Measures the time taken by each decode call and degrades non-reference
+ * pictures when the running average exceeds the deadline. The levels are
+ * applied in order: deblocking off, then full pel luma MVs, then the
+ * pictures are dropped. A level is relaxed once the average is back under
+ * three quarters of the deadline. Each decode call is expected to carry one
+ * picture. A dropped picture is returned with IVD_DEC_FRM_SKIPPED and is not
+ * displayed. IVD_CMD_CTL_RESET disables it */
+typedef struct {
+  /**
+   * u4_size
+   */
+  UWORD32 u4_size;
+
+  /**
+   * cmd
+   */
+  IVD_API_COMMAND_TYPE_T e_cmd;
+
+  /**
+   * sub_cmd
+   */
+  IVD_CONTROL_API_COMMAND_TYPE_T e_sub_cmd;
+
+  /**
+   * Decode time allowed per picture in microseconds
+   */
+  UWORD32 u4_deadline_us;
+
+  /**
+   * Used for the deadline when u4_deadline_us is 0. Both 0 disables the
+   * controller
+   */
+  UWORD32 u4_target_fps;
+} ih264d_ctl_set_deadline_ip_t;
+
+typedef struct {
+  /**
+   * u4_size
+   */
+  UWORD32 u4_size;
+
+  /**
+   * error_code
+   */
+  UWORD32 u4_error_code;
+} ih264d_ctl_set_deadline_op_t;
+
+/** Degrade levels of the deadline controller, each adds to the previous */
+typedef enum {
+  /** Pictures are decoded in full */
+  IH264D_DEADLINE_LEVEL_NONE = 0,
+
+  /** Non-reference pictures are not deblocked */
+  IH264D_DEADLINE_LEVEL_NO_DEBLK,
+
+  /** Non-reference pictures use full pel luma MVs */
+  IH264D_DEADLINE_LEVEL_FULL_PEL,
+
+  /** Non-reference pictures are dropped */
+  IH264D_DEADLINE_LEVEL_DROP,
+
+  IH264D_DEADLINE_NUM_LEVELS
+} IH264D_DEADLINE_LEVEL_T;
+
+typedef struct {
+  /**
+   * u4_size
+   */
+  UWORD32 u4_size;
+
+  /**
+   * cmd
+   */
+  IVD_API_COMMAND_TYPE_T e_cmd;
+
+  /**
+   * sub_cmd
+   */
+  IVD_CONTROL_API_COMMAND_TYPE_T e_sub_cmd;
+} ih264d_ctl_get_deadline_stats_ip_t;
+
+typedef struct {
+  /**
+   * u4_size
+   */
+  UWORD32 u4_size;
+
+  /**
+   * error_code
+   */
+  UWORD32 u4_error_code;
+
+  /**
+   * Deadline in use in microseconds, 0 when the controller is off
+   */
+  UWORD32 u4_deadline_us;
+
+  /**
+   * Level applied to the next picture, one of IH264D_DEADLINE_LEVEL_T
+   */
+  UWORD32 u4_level;
+
+  /**
+   * Highest level reached
+   */
+  UWORD32 u4_max_level;
+
+  /**
+   * Running average of the decode call time in microseconds
+   */
+  UWORD32 u4_avg_us;
+
+  /**
+   * Running average of the decode call time of I, P and B pictures
+   */
+  UWORD32 au4_type_avg_us[3];
+
+  /**
+   * Decode calls measured, dropped pictures included
+   */
+  UWORD32 u4_num_pics;
+
+  /**
+   * Decode calls that took longer than the deadline
+   */
+  UWORD32 u4_num_over_deadline;
+
+  /**
+   * Number of times the level was raised and lowered
+   */
+  UWORD32 u4_num_escalations;
+  UWORD32 u4_num_relaxations;
+
+  /**
+   * Pictures decoded without deblocking, with full pel MVs and dropped
+   */
+  UWORD32 u4_num_deblk_skipped;
+  UWORD32 u4_num_full_pel;
+  UWORD32 u4_num_dropped;
+} ih264d_ctl_get_deadline_stats_op_t;
+
 typedef struct {
   UWORD32 u4_size;
   IVD_API_COMMAND_TYPE_T e_cmd;
@@ -446,6 +715,168 @@ typedef struct {
   UWORD32 u4_error_code;
 } ih264d_ctl_set_processor_op_t;
 
+typedef struct {
+  /**
+   * i4_size
+   */
+  UWORD32 u4_size;
+  /**
+   * cmd
+   */
+  IVD_API_COMMAND_TYPE_T e_cmd;
+  /**
+   * sub cmd
+   */
+  IVD_CONTROL_API_COMMAND_TYPE_T e_sub_cmd;
+  /**
+   * Number of MBs ahead of the current MB (within an MB group) whose
+   * reference blocks are prefetched before MC. 0 disables prefetch
+   */
+  UWORD32 u4_prefetch_dist;
+
+} ih264d_ctl_set_mc_prefetch_ip_t;
+
+typedef struct {
+  /**
+   * i4_size
+   */
+  UWORD32 u4_size;
+  /**
+   * error_code
+   */
+  UWORD32 u4_error_code;
+} ih264d_ctl_set_mc_prefetch_op_t;
+
+/*****************************************************************************/
+/*   Video control: Release memory                                           */
+/*****************************************************************************/
+
+/* Hands the block obtained through pf_aligned_alloc back to pf_aligned_free
+ * while the decoder holds no pictures, i.e. before the first decode or after
+ * IVD_CMD_CTL_RESET. It is allocated again on the next SPS activation. Lets
+ * an idle instance return its picture and MV buffers to a shared pool */
+typedef struct {
+  /**
+   * i4_size
+   */
+  UWORD32 u4_size;
+  /**
+   * cmd
+   */
+  IVD_API_COMMAND_TYPE_T e_cmd;
+  /**
+   * sub cmd
+   */
+  IVD_CONTROL_API_COMMAND_TYPE_T e_sub_cmd;
+} ih264d_ctl_release_mem_ip_t;
+
+typedef struct {
+  /**
+   * i4_size
+   */
+  UWORD32 u4_size;
+  /**
+   * error_code
+   */
+  UWORD32 u4_error_code;
+  /**
+   * Bytes handed back to pf_aligned_free, 0 when nothing was held
+   */
+  UWORD32 u4_mem_released;
+} ih264d_ctl_release_mem_op_t;
+
+/*****************************************************************************/
+/*   Video control: Set low delay                                            */
+/*****************************************************************************/
+
+/* Sends each picture to display in the decode call that decodes it instead
+ * of holding it for the reorder depth. Used as is when the SPS has
+ * bitstream_restriction with max_num_reorder_frames 0 or uses POC type 2,
+ * never when it has a non zero max_num_reorder_frames. Otherwise POCs are
+ * checked, and the first picture lower than the previous one is output late
+ * and the usual delay is used from then on. Must be set before the first
+ * picture is decoded, IVD_CMD_CTL_RESET clears it. Init with
+ * u4_num_reorder_frames 0 always outputs this way */
+typedef struct {
+  /**
+   * i4_size
+   */
+  UWORD32 u4_size;
+  /**
+   * cmd
+   */
+  IVD_API_COMMAND_TYPE_T e_cmd;
+  /**
+   * sub cmd
+   */
+  IVD_CONTROL_API_COMMAND_TYPE_T e_sub_cmd;
+  /**
+   * 1 to enable, 0 to disable
+   */
+  UWORD32 u4_low_delay;
+} ih264d_ctl_set_low_delay_ip_t;
+
+typedef struct {
+  /**
+   * i4_size
+   */
+  UWORD32 u4_size;
+  /**
+   * error_code
+   */
+  UWORD32 u4_error_code;
+} ih264d_ctl_set_low_delay_op_t;
+
+/*****************************************************************************/
+/*   Video control: Set intra only                                           */
+/*****************************************************************************/
+
+/* Tells the decoder that every slice of the stream is an I slice, as in
+ * all-IDR and High Intra content. Pictures are then not padded and not kept
+ * for reference, and the co-located MVs that only temporal direct reads are
+ * not stored. The same is done without the hint for sequences that can not
+ * be inter predicted: max_num_ref_frames 0, CAVLC 4:4:4 Intra, or High
+ * 10/4:2:2/4:4:4 with constraint_set3_flag. P and B slices are reported as
+ * ERROR_INV_SLC_TYPE_T and concealed. Must be set before the first picture
+ * is decoded, IVD_CMD_CTL_RESET clears it.
+ * The memory records are sized for intra only decode only when u4_intra_only
+ * is also given to fill mem rec and init: two picture buffers, the one
+ * decoded and the one format converted, plus the reorder and extra display
+ * ones, and no co-located MVs. The hint can then not be cleared. The
+ * working MV bank of one picture is still allocated, deblocking and
+ * concealment read reference indices from it. Intra only decode does not
+ * decode slices in parallel, the slices of a picture are decoded one after
+ * the other as for other streams */
+typedef struct {
+  /**
+   * i4_size
+   */
+  UWORD32 u4_size;
+  /**
+   * cmd
+   */
+  IVD_API_COMMAND_TYPE_T e_cmd;
+  /**
+   * sub cmd
+   */
+  IVD_CONTROL_API_COMMAND_TYPE_T e_sub_cmd;
+  /**
+   * 1 to enable, 0 to disable
+   */
+  UWORD32 u4_intra_only;
+} ih264d_ctl_set_intra_only_ip_t;
+
+typedef struct {
+  /**
+   * i4_size
+   */
+  UWORD32 u4_size;
+  /**
+   * error_code
+   */
+  UWORD32 u4_error_code;
+} ih264d_ctl_set_intra_only_op_t;
+
 typedef struct {
   UWORD32 u4_size;
   IVD_API_COMMAND_TYPE_T e_cmd;
@@ -701,6 +1132,244 @@ typedef struct
   UWORD32 u4_film_grain_characteristics_repetition_period;
 } ih264d_ctl_get_sei_fgc_params_op_t;
 
+/** Decoding stages timed by the profiling counters */
+typedef enum {
+  /** Main thread time in decode and get display frame calls that is not
+   accounted to any other stage, which is mostly parsing */
+  IH264D_PERF_STAGE_PARSE = 0,
+
+  /** Motion compensation, including the MV to address derivation */
+  IH264D_PERF_STAGE_MC,
+
+  /** Inverse quantization, inverse transform and intra prediction */
+  IH264D_PERF_STAGE_RECON,
+
+  /** Boundary strength computation */
+  IH264D_PERF_STAGE_BS,
+
+  /** Deblocking */
+  IH264D_PERF_STAGE_DEBLK,
+
+  /** Conversion to the output format */
+  IH264D_PERF_STAGE_FMT_CONV,
+
+  /** Threads waiting on each other, spinning or joining */
+  IH264D_PERF_STAGE_WAIT,
+
+  IH264D_PERF_NUM_STAGES
+} IH264D_PERF_STAGE_T;
+
+/** MB types counted by the profiling counters */
+typedef enum {
+  IH264D_PERF_MB_I4x4 = 0,
+  IH264D_PERF_MB_I8x8,
+  IH264D_PERF_MB_I16x16,
+  IH264D_PERF_MB_IPCM,
+  IH264D_PERF_MB_P,
+  IH264D_PERF_MB_P_SKIP,
+  IH264D_PERF_MB_B,
+  IH264D_PERF_MB_B_SKIP,
+  IH264D_PERF_NUM_MB_TYPES
+} IH264D_PERF_MB_TYPE_T;
+
+typedef struct {
+  /**
+   * u4_size
+   */
+  UWORD32 u4_size;
+
+  /**
+   * cmd
+   */
+  IVD_API_COMMAND_TYPE_T e_cmd;
+
+  /**
+   * sub_cmd
+   */
+  IVD_CONTROL_API_COMMAND_TYPE_T e_sub_cmd;
+
+  /**
+   * Clear the counters once they are read
+   */
+  UWORD32 u4_reset;
+} ih264d_ctl_get_perf_stats_ip_t;
+
+typedef struct {
+  /**
+   * u4_size
+   */
+  UWORD32 u4_size;
+
+  /**
+   * error_code
+   */
+  UWORD32 u4_error_code;
+
+  /**
+   * Timer ticks per second, 0 if it could not be determined. Ticks are time
+   * stamp counter cycles on x86 and nanoseconds elsewhere
+   */
+  UWORD64 u8_ticks_per_sec;
+
+  /**
+   * Main thread ticks spent in decode and get display frame calls
+   */
+  UWORD64 u8_call_ticks;
+
+  /**
+   * Ticks spent in each stage, summed over all the threads. With more than
+   * one core the sum can exceed the elapsed time
+   */
+  UWORD64 au8_stage_ticks[IH264D_PERF_NUM_STAGES];
+
+  /**
+   * Number of reconstructed MBs of each type
+   */
+  UWORD64 au8_num_mbs[IH264D_PERF_NUM_MB_TYPES];
+
+  /**
+   * Number of CABAC bins decoded, including bypass and terminate bins
+   */
+  UWORD64 u8_num_bins;
+
+  /**
+   * Number of CABAC bypass bins decoded
+   */
+  UWORD64 u8_num_bypass_bins;
+
+  /**
+   * Number of iterations of the threads' spin-wait loops
+   */
+  UWORD64 u8_num_spin_waits;
+} ih264d_ctl_get_perf_stats_op_t;
+
+/** Spans recorded by the trace events */
+typedef enum {
+  /** Decode call, argument is 0 */
+  IH264D_TRACE_CALL = 0,
+
+  /** Slice, argument is the slice number in the picture */
+  IH264D_TRACE_SLICE,
+
+  /** Transfer of a reconstructed MB group, argument is the number of MBs */
+  IH264D_TRACE_MB_GROUP,
+
+  /** Deblocking of a band of MBs, argument is the MB row */
+  IH264D_TRACE_DEBLK,
+
+  /** Conversion to the output format, argument is the first row */
+  IH264D_TRACE_FMT_CONV,
+
+  /** Thread spinning on, or joining, another thread, argument is 0 */
+  IH264D_TRACE_WAIT,
+
+  IH264D_TRACE_NUM_EVENTS
+} IH264D_TRACE_EVENT_T;
+
+/** Threads owning the trace events */
+typedef enum {
+  /** Thread calling the decoder, parsing the slices */
+  IH264D_TRACE_THREAD_MAIN = 0,
+
+  /** Decode thread */
+  IH264D_TRACE_THREAD_DEC,
+
+  /** Compute bs and deblocking thread */
+  IH264D_TRACE_THREAD_BS,
+
+  /** First of the other deblocking workers */
+  IH264D_TRACE_THREAD_DEBLK_WORKER
+} IH264D_TRACE_THREAD_T;
+
+typedef struct {
+  /**
+   * Time stamp, in the ticks of the profiling counters
+   */
+  UWORD64 u8_ts;
+
+  /**
+   * Argument, depends on the event
+   */
+  UWORD32 u4_arg;
+
+  /**
+   * Span, of type IH264D_TRACE_EVENT_T
+   */
+  UWORD8 u1_event;
+
+  /**
+   * 1 at the start of the span, 0 at its end
+   */
+  UWORD8 u1_begin;
+
+  /**
+   * Thread, deblocking worker i being IH264D_TRACE_THREAD_DEBLK_WORKER + i - 1
+   */
+  UWORD8 u1_thread;
+
+  /**
+   * Reserved
+   */
+  UWORD8 u1_rsvd;
+} ih264d_trace_event_t;
+
+typedef struct {
+  /**
+   * u4_size
+   */
+  UWORD32 u4_size;
+
+  /**
+   * cmd
+   */
+  IVD_API_COMMAND_TYPE_T e_cmd;
+
+  /**
+   * sub_cmd
+   */
+  IVD_CONTROL_API_COMMAND_TYPE_T e_sub_cmd;
+
+  /**
+   * Buffer the events are copied to, grouped by thread and in time order
+   * within a thread. Events copied out are removed from the decoder, the
+   * ones that do not fit are kept for the next call
+   */
+  ih264d_trace_event_t *ps_events;
+
+  /**
+   * Number of events the buffer can hold
+   */
+  UWORD32 u4_max_events;
+} ih264d_ctl_get_trace_events_ip_t;
+
+typedef struct {
+  /**
+   * u4_size
+   */
+  UWORD32 u4_size;
+
+  /**
+   * error_code
+   */
+  UWORD32 u4_error_code;
+
+  /**
+   * Timer ticks per second, as for IH264D_CMD_CTL_GET_PERF_STATS
+   */
+  UWORD64 u8_ticks_per_sec;
+
+  /**
+   * Number of events copied
+   */
+  UWORD32 u4_num_events;
+
+  /**
+   * Number of events lost since the last call, overwritten in the decoder
+   * before they were read
+   */
+  UWORD32 u4_num_dropped;
+} ih264d_ctl_get_trace_events_op_t;
+
 #ifdef __cplusplus
 } /* closing brace for extern "C" */
 #endif
@@ -104,7 +104,9 @@ typedef enum {
   ARCH_X86_SSE42,
   ARCH_X86_AVX2,
   ARCH_MIPS_GENERIC = 0x200,
-  ARCH_MIPS_32
+  ARCH_MIPS_32,
+  ARCH_WASM_GENERIC = 0x300,
+  ARCH_WASM_SIMD128
 } IVD_ARCH_T;
 
 /* IVD_SOC_T: SOC Enumeration                               */
@@ -7,9 +7,11 @@ list(
   "${LIB264_ROOT}/decoder/ih264d_cabac.c"
   "${LIB264_ROOT}/decoder/ih264d_cabac_init_tables.c"
   "${LIB264_ROOT}/decoder/ih264d_compute_bs.c"
+  "${LIB264_ROOT}/decoder/ih264d_deadline.c"
   "${LIB264_ROOT}/decoder/ih264d_deblocking.c"
   "${LIB264_ROOT}/decoder/ih264d_debug.c"
   "${LIB264_ROOT}/decoder/ih264d_dpb_mgr.c"
+  "${LIB264_ROOT}/decoder/ih264d_film_grain.c"
   "${LIB264_ROOT}/decoder/ih264d_format_conv.c"
   "${LIB264_ROOT}/decoder/ih264d_function_selector_generic.c"
   "${LIB264_ROOT}/decoder/ih264d_inter_pred.c"
@@ -24,6 +26,7 @@ list(
   "${LIB264_ROOT}/decoder/ih264d_parse_mb_header.c"
   "${LIB264_ROOT}/decoder/ih264d_parse_pslice.c"
   "${LIB264_ROOT}/decoder/ih264d_parse_slice.c"
+  "${LIB264_ROOT}/decoder/ih264d_perf_stats.c"
   "${LIB264_ROOT}/decoder/ih264d_process_bslice.c"
   "${LIB264_ROOT}/decoder/ih264d_process_intra_mb.c"
   "${LIB264_ROOT}/decoder/ih264d_process_pslice.c"
@@ -32,6 +35,7 @@ list(
   "${LIB264_ROOT}/decoder/ih264d_tables.c"
   "${LIB264_ROOT}/decoder/ih264d_thread_compute_bs.c"
   "${LIB264_ROOT}/decoder/ih264d_thread_parse_decode.c"
+  "${LIB264_ROOT}/decoder/ih264d_trace.c"
   "${LIB264_ROOT}/decoder/ih264d_utils.c"
   "${LIB264_ROOT}/decoder/ih264d_vui.c")
 
@@ -48,11 +52,28 @@ else()
   list(
     APPEND LIB264DEC_SRCS "${LIB264_ROOT}/decoder/x86/ih264d_function_selector.c"
     "${LIB264_ROOT}/decoder/x86/ih264d_function_selector_sse42.c"
-    "${LIB264_ROOT}/decoder/x86/ih264d_function_selector_ssse3.c")
+    "${LIB264_ROOT}/decoder/x86/ih264d_function_selector_ssse3.c"
+    "${LIB264_ROOT}/decoder/x86/ih264d_compute_bs_sse42.c"
+    "${LIB264_ROOT}/decoder/x86/ih264d_deblk_row_sse42.c"
+    "${LIB264_ROOT}/decoder/x86/ih264d_film_grain_sse42.c"
+    "${LIB264_ROOT}/decoder/x86/ih264d_iquant_itrans_recon_mb_sse42.c")
 endif()
 
 add_library(lib264_library STATIC ${LIB264_COMMON_SRCS} ${LIB264_COMMON_ASMS}
                              ${LIB264DEC_SRCS} ${LIB264DEC_ASMS})
 target_link_libraries(
   lib264_library
-  PRIVATE ithread)
\ No newline at end of file
+  PRIVATE ithread)
+
+option(LIB264DEC_PERF_STATS
+       "Update the profiling counters read by IH264D_CMD_CTL_GET_PERF_STATS"
+       OFF)
+if(LIB264DEC_PERF_STATS)
+  target_compile_definitions(lib264_library PRIVATE PERF_STATS_ENABLE)
+endif()
+
+option(LIB264DEC_TRACE
+       "Record the trace events read by IH264D_CMD_CTL_GET_TRACE_EVENTS" OFF)
+if(LIB264DEC_TRACE)
+  target_compile_definitions(lib264_library PRIVATE TRACE_ENABLE)
+endif()
@@ -74,6 +74,14 @@
 /*          ih264d_set_degrade                                               */
 /*          ih264d_get_frame_dimensions                                      */
 /*          ih264d_set_num_cores                                             */
+/*          ih264d_set_mc_prefetch                                           */
+/*          ih264d_release_mem                                               */
+/*          ih264d_set_low_delay_mode                                        */
+/*          ih264d_set_intra_only_mode                                       */
+/*          ih264d_set_deadline                                              */
+/*          ih264d_get_deadline_stats                                        */
+/*          ih264d_get_perf_stats                                            */
+/*          ih264d_get_trace_events                                          */
 /*          ih264d_fill_output_struct_from_context                           */
 /*          ih264d_api_function                                              */
 /*                                                                           */
@@ -116,7 +124,12 @@
 #include "ih264d_parse_cavlc.h"
 #include "ih264d_parse_cabac.h"
 #include "ih264d_utils.h"
+#include "ih264d_mem_request.h"
 #include "ih264d_format_conv.h"
+#include "ih264d_perf_stats.h"
+#include "ih264d_trace.h"
+#include "ih264d_deadline.h"
+#include "ih264d_film_grain.h"
 #include "ih264d_parse_headers.h"
 #include <assert.h>
 
@@ -181,8 +194,36 @@ WORD32 ih264d_get_sei_fgc_params(iv_obj_t *dec_hdl, void *pv_api_ip,
 WORD32 ih264d_set_num_cores(iv_obj_t *dec_hdl, void *pv_api_ip,
                             void *pv_api_op);
 
+WORD32 ih264d_set_mc_prefetch(iv_obj_t *dec_hdl, void *pv_api_ip,
+                              void *pv_api_op);
+
+WORD32 ih264d_release_mem(iv_obj_t *dec_hdl, void *pv_api_ip,
+                          void *pv_api_op);
+
+WORD32 ih264d_set_low_delay_mode(iv_obj_t *dec_hdl, void *pv_api_ip,
+                                 void *pv_api_op);
+
+WORD32 ih264d_set_intra_only_mode(iv_obj_t *dec_hdl, void *pv_api_ip,
+                                  void *pv_api_op);
+
+WORD32 ih264d_set_deadline(iv_obj_t *dec_hdl, void *pv_api_ip,
+                           void *pv_api_op);
+
+WORD32 ih264d_get_deadline_stats(iv_obj_t *dec_hdl, void *pv_api_ip,
+                                 void *pv_api_op);
+
+WORD32 ih264d_get_perf_stats(iv_obj_t *dec_hdl, void *pv_api_ip,
+                             void *pv_api_op);
+
+WORD32 ih264d_get_trace_events(iv_obj_t *dec_hdl, void *pv_api_ip,
+                               void *pv_api_op);
+
 WORD32 ih264d_deblock_display(dec_struct_t *ps_dec);
 
+WORD32 ih264d_fill_num_mem_rec(void *pv_api_ip, void *pv_api_op);
+
+WORD32 ih264d_fill_mem_rec_to_budget(void *pv_api_ip, void *pv_api_op);
+
 void ih264d_signal_decode_thread(dec_struct_t *ps_dec);
 
 void ih264d_signal_bs_deblk_thread(dec_struct_t *ps_dec);
@@ -484,6 +525,20 @@ static IV_API_CALL_STATUS_T api_check_struct_sanity(iv_obj_t *ps_handle,
         return (IV_FAIL);
       }
 
+      if ((ps_ip->s_ivd_init_ip_t.u4_size >
+           offsetof(ih264d_init_ip_t, u4_alloc_per_sps)) &&
+          (1 == ps_ip->u4_alloc_per_sps)) {
+        if ((ps_ip->s_ivd_init_ip_t.u4_size < sizeof(ih264d_init_ip_t)) ||
+            (NULL == ps_ip->pf_aligned_alloc) ||
+            (NULL == ps_ip->pf_aligned_free)) {
+          ps_op->s_ivd_init_op_t.u4_error_code |= 1 << IVD_UNSUPPORTEDPARAM;
+          ps_op->s_ivd_init_op_t.u4_error_code |=
+              IVD_INIT_DEC_MEM_REC_BASE_NULL;
+          H264_DEC_DEBUG_PRINT("\n");
+          return (IV_FAIL);
+        }
+      }
+
       if ((ps_ip->s_ivd_init_ip_t.e_output_format != IV_YUV_420P) &&
           (ps_ip->s_ivd_init_ip_t.e_output_format != IV_YUV_422ILE) &&
           (ps_ip->s_ivd_init_ip_t.e_output_format != IV_RGB_565) &&
@@ -623,6 +678,35 @@ static IV_API_CALL_STATUS_T api_check_struct_sanity(iv_obj_t *ps_handle,
           s_fill_mem_rec_ip.u4_share_disp_buf = 0;
         }
 
+        if (ps_ip->s_ivd_init_ip_t.u4_size >
+            offsetof(ih264d_init_ip_t, u4_alloc_per_sps)) {
+          s_fill_mem_rec_ip.u4_alloc_per_sps = ps_ip->u4_alloc_per_sps;
+        } else {
+          s_fill_mem_rec_ip.u4_alloc_per_sps = 0;
+        }
+        s_fill_mem_rec_ip.pe_mem_placement = NULL;
+
+        if (ps_ip->s_ivd_init_ip_t.u4_size >
+            offsetof(ih264d_init_ip_t, u4_mem_budget)) {
+          s_fill_mem_rec_ip.u4_mem_budget = ps_ip->u4_mem_budget;
+        } else {
+          s_fill_mem_rec_ip.u4_mem_budget = 0;
+        }
+
+        if (ps_ip->s_ivd_init_ip_t.u4_size >
+            offsetof(ih264d_init_ip_t, u4_film_grain)) {
+          s_fill_mem_rec_ip.u4_film_grain = ps_ip->u4_film_grain;
+        } else {
+          s_fill_mem_rec_ip.u4_film_grain = 0;
+        }
+
+        if (ps_ip->s_ivd_init_ip_t.u4_size >
+            offsetof(ih264d_init_ip_t, u4_intra_only)) {
+          s_fill_mem_rec_ip.u4_intra_only = ps_ip->u4_intra_only;
+        } else {
+          s_fill_mem_rec_ip.u4_intra_only = 0;
+        }
+
         s_fill_mem_rec_ip.e_output_format =
             ps_ip->s_ivd_init_ip_t.e_output_format;
 
@@ -1211,8 +1295,8 @@ static IV_API_CALL_STATUS_T api_check_struct_sanity(iv_obj_t *ps_handle,
             return IV_FAIL;
           }
 
-          if ((ps_ip->u4_num_cores != 1) && (ps_ip->u4_num_cores != 2) &&
-              (ps_ip->u4_num_cores != 3) && (ps_ip->u4_num_cores != 4)) {
+          if ((ps_ip->u4_num_cores < 1) ||
+              (ps_ip->u4_num_cores > H264_MAX_NUM_CORES)) {
             ps_op->u4_error_code |= 1 << IVD_UNSUPPORTEDPARAM;
             return IV_FAIL;
           }
@@ -1239,6 +1323,187 @@ static IV_API_CALL_STATUS_T api_check_struct_sanity(iv_obj_t *ps_handle,
 
           break;
         }
+        case IH264D_CMD_CTL_SET_MC_PREFETCH: {
+          ih264d_ctl_set_mc_prefetch_ip_t *ps_ip;
+          ih264d_ctl_set_mc_prefetch_op_t *ps_op;
+
+          ps_ip = (ih264d_ctl_set_mc_prefetch_ip_t *) pv_api_ip;
+          ps_op = (ih264d_ctl_set_mc_prefetch_op_t *) pv_api_op;
+
+          if (ps_ip->u4_size != sizeof(ih264d_ctl_set_mc_prefetch_ip_t)) {
+            ps_op->u4_error_code |= 1 << IVD_UNSUPPORTEDPARAM;
+            ps_op->u4_error_code |= IVD_IP_API_STRUCT_SIZE_INCORRECT;
+            return IV_FAIL;
+          }
+
+          if (ps_op->u4_size != sizeof(ih264d_ctl_set_mc_prefetch_op_t)) {
+            ps_op->u4_error_code |= 1 << IVD_UNSUPPORTEDPARAM;
+            ps_op->u4_error_code |= IVD_OP_API_STRUCT_SIZE_INCORRECT;
+            return IV_FAIL;
+          }
+
+          if (ps_ip->u4_prefetch_dist > MAX_MC_PREFETCH_DIST) {
+            ps_op->u4_error_code |= 1 << IVD_UNSUPPORTEDPARAM;
+            return IV_FAIL;
+          }
+          break;
+        }
+        case IH264D_CMD_CTL_RELEASE_MEM: {
+          ih264d_ctl_release_mem_ip_t *ps_ip;
+          ih264d_ctl_release_mem_op_t *ps_op;
+
+          ps_ip = (ih264d_ctl_release_mem_ip_t *) pv_api_ip;
+          ps_op = (ih264d_ctl_release_mem_op_t *) pv_api_op;
+
+          if (ps_ip->u4_size != sizeof(ih264d_ctl_release_mem_ip_t)) {
+            ps_op->u4_error_code |= 1 << IVD_UNSUPPORTEDPARAM;
+            ps_op->u4_error_code |= IVD_IP_API_STRUCT_SIZE_INCORRECT;
+            return IV_FAIL;
+          }
+
+          if (ps_op->u4_size != sizeof(ih264d_ctl_release_mem_op_t)) {
+            ps_op->u4_error_code |= 1 << IVD_UNSUPPORTEDPARAM;
+            ps_op->u4_error_code |= IVD_OP_API_STRUCT_SIZE_INCORRECT;
+            return IV_FAIL;
+          }
+          break;
+        }
+        case IH264D_CMD_CTL_SET_LOW_DELAY: {
+          ih264d_ctl_set_low_delay_ip_t *ps_ip;
+          ih264d_ctl_set_low_delay_op_t *ps_op;
+
+          ps_ip = (ih264d_ctl_set_low_delay_ip_t *) pv_api_ip;
+          ps_op = (ih264d_ctl_set_low_delay_op_t *) pv_api_op;
+
+          if (ps_ip->u4_size != sizeof(ih264d_ctl_set_low_delay_ip_t)) {
+            ps_op->u4_error_code |= 1 << IVD_UNSUPPORTEDPARAM;
+            ps_op->u4_error_code |= IVD_IP_API_STRUCT_SIZE_INCORRECT;
+            return IV_FAIL;
+          }
+
+          if (ps_op->u4_size != sizeof(ih264d_ctl_set_low_delay_op_t)) {
+            ps_op->u4_error_code |= 1 << IVD_UNSUPPORTEDPARAM;
+            ps_op->u4_error_code |= IVD_OP_API_STRUCT_SIZE_INCORRECT;
+            return IV_FAIL;
+          }
+
+          if (ps_ip->u4_low_delay > 1) {
+            ps_op->u4_error_code |= 1 << IVD_UNSUPPORTEDPARAM;
+            return IV_FAIL;
+          }
+          break;
+        }
+        case IH264D_CMD_CTL_SET_INTRA_ONLY: {
+          ih264d_ctl_set_intra_only_ip_t *ps_ip;
+          ih264d_ctl_set_intra_only_op_t *ps_op;
+
+          ps_ip = (ih264d_ctl_set_intra_only_ip_t *) pv_api_ip;
+          ps_op = (ih264d_ctl_set_intra_only_op_t *) pv_api_op;
+
+          if (ps_ip->u4_size != sizeof(ih264d_ctl_set_intra_only_ip_t)) {
+            ps_op->u4_error_code |= 1 << IVD_UNSUPPORTEDPARAM;
+            ps_op->u4_error_code |= IVD_IP_API_STRUCT_SIZE_INCORRECT;
+            return IV_FAIL;
+          }
+
+          if (ps_op->u4_size != sizeof(ih264d_ctl_set_intra_only_op_t)) {
+            ps_op->u4_error_code |= 1 << IVD_UNSUPPORTEDPARAM;
+            ps_op->u4_error_code |= IVD_OP_API_STRUCT_SIZE_INCORRECT;
+            return IV_FAIL;
+          }
+
+          if (ps_ip->u4_intra_only > 1) {
+            ps_op->u4_error_code |= 1 << IVD_UNSUPPORTEDPARAM;
+            return IV_FAIL;
+          }
+          break;
+        }
+        case IH264D_CMD_CTL_SET_DEADLINE: {
+          ih264d_ctl_set_deadline_ip_t *ps_ip;
+          ih264d_ctl_set_deadline_op_t *ps_op;
+
+          ps_ip = (ih264d_ctl_set_deadline_ip_t *) pv_api_ip;
+          ps_op = (ih264d_ctl_set_deadline_op_t *) pv_api_op;
+
+          if (ps_ip->u4_size != sizeof(ih264d_ctl_set_deadline_ip_t)) {
+            ps_op->u4_error_code |= 1 << IVD_UNSUPPORTEDPARAM;
+            ps_op->u4_error_code |= IVD_IP_API_STRUCT_SIZE_INCORRECT;
+            return IV_FAIL;
+          }
+
+          if (ps_op->u4_size != sizeof(ih264d_ctl_set_deadline_op_t)) {
+            ps_op->u4_error_code |= 1 << IVD_UNSUPPORTEDPARAM;
+            ps_op->u4_error_code |= IVD_OP_API_STRUCT_SIZE_INCORRECT;
+            return IV_FAIL;
+          }
+
+          if ((ps_ip->u4_deadline_us > MAX_DEADLINE_US) ||
+              (ps_ip->u4_target_fps > MAX_DEADLINE_FPS)) {
+            ps_op->u4_error_code |= 1 << IVD_UNSUPPORTEDPARAM;
+            return IV_FAIL;
+          }
+          break;
+        }
+        case IH264D_CMD_CTL_GET_DEADLINE_STATS: {
+          ih264d_ctl_get_deadline_stats_ip_t *ps_ip;
+          ih264d_ctl_get_deadline_stats_op_t *ps_op;
+
+          ps_ip = (ih264d_ctl_get_deadline_stats_ip_t *) pv_api_ip;
+          ps_op = (ih264d_ctl_get_deadline_stats_op_t *) pv_api_op;
+
+          if (ps_ip->u4_size != sizeof(ih264d_ctl_get_deadline_stats_ip_t)) {
+            ps_op->u4_error_code |= 1 << IVD_UNSUPPORTEDPARAM;
+            ps_op->u4_error_code |= IVD_IP_API_STRUCT_SIZE_INCORRECT;
+            return IV_FAIL;
+          }
+
+          if (ps_op->u4_size != sizeof(ih264d_ctl_get_deadline_stats_op_t)) {
+            ps_op->u4_error_code |= 1 << IVD_UNSUPPORTEDPARAM;
+            ps_op->u4_error_code |= IVD_OP_API_STRUCT_SIZE_INCORRECT;
+            return IV_FAIL;
+          }
+          break;
+        }
+        case IH264D_CMD_CTL_GET_PERF_STATS: {
+          ih264d_ctl_get_perf_stats_ip_t *ps_ip;
+          ih264d_ctl_get_perf_stats_op_t *ps_op;
+
+          ps_ip = (ih264d_ctl_get_perf_stats_ip_t *) pv_api_ip;
+          ps_op = (ih264d_ctl_get_perf_stats_op_t *) pv_api_op;
+
+          if (ps_ip->u4_size != sizeof(ih264d_ctl_get_perf_stats_ip_t)) {
+            ps_op->u4_error_code |= 1 << IVD_UNSUPPORTEDPARAM;
+            ps_op->u4_error_code |= IVD_IP_API_STRUCT_SIZE_INCORRECT;
+            return IV_FAIL;
+          }
+
+          if (ps_op->u4_size != sizeof(ih264d_ctl_get_perf_stats_op_t)) {
+            ps_op->u4_error_code |= 1 << IVD_UNSUPPORTEDPARAM;
+            ps_op->u4_error_code |= IVD_OP_API_STRUCT_SIZE_INCORRECT;
+            return IV_FAIL;
+          }
+          break;
+        }
+        case IH264D_CMD_CTL_GET_TRACE_EVENTS: {
+          ih264d_ctl_get_trace_events_ip_t *ps_ip;
+          ih264d_ctl_get_trace_events_op_t *ps_op;
+
+          ps_ip = (ih264d_ctl_get_trace_events_ip_t *) pv_api_ip;
+          ps_op = (ih264d_ctl_get_trace_events_op_t *) pv_api_op;
+
+          if (ps_ip->u4_size != sizeof(ih264d_ctl_get_trace_events_ip_t)) {
+            ps_op->u4_error_code |= 1 << IVD_UNSUPPORTEDPARAM;
+            ps_op->u4_error_code |= IVD_IP_API_STRUCT_SIZE_INCORRECT;
+            return IV_FAIL;
+          }
+
+          if (ps_op->u4_size != sizeof(ih264d_ctl_get_trace_events_op_t)) {
+            ps_op->u4_error_code |= 1 << IVD_UNSUPPORTEDPARAM;
+            ps_op->u4_error_code |= IVD_OP_API_STRUCT_SIZE_INCORRECT;
+            return IV_FAIL;
+          }
+          break;
+        }
         default:
           *(pu4_api_op + 1) |= 1 << IVD_UNSUPPORTEDPARAM;
           *(pu4_api_op + 1) |= IVD_UNSUPPORTED_API_CMD;
@@ -1358,11 +1623,20 @@ void ih264d_init_decoder(void *ps_dec_params) {
   ps_dec->init_done = 0;
 
   ps_dec->u4_num_cores = 1;
+  ps_dec->u4_num_deblk_cores = 1;
+  ps_dec->u4_num_deblk_workers = 1;
+  ps_dec->u4_mc_prefetch_dist = DEFAULT_MC_PREFETCH_DIST;
+  ps_dec->u4_low_delay = 0;
+  ps_dec->u1_low_delay_dropped = 0;
+  ps_dec->u4_intra_only = ps_dec->u4_intra_only_at_init;
+  ps_dec->u1_intra_only = 0;
+  ih264d_deadline_reset(ps_dec);
 
   ps_dec->u2_pic_ht = ps_dec->u2_pic_wd = 0;
 
   ps_dec->u1_separate_parse = DEFAULT_SEPARATE_PARSE;
   ps_dec->u4_app_disable_deblk_frm = 0;
+  ps_dec->i4_mv_frac_mask = ~0;
   ps_dec->i4_degrade_type = 0;
   ps_dec->i4_degrade_pics = 0;
 
@@ -1482,15 +1756,6 @@ void ih264d_init_decoder(void *ps_dec_params) {
   ps_dec->pf_cavlc_parse_8x8block[3] =
       ih264d_cavlc_parse_8x8block_both_available;
 
-  /***************************************************************************/
-  /* Initialize Bs calculation function pointers for P and B, 16x16/non16x16 */
-  /***************************************************************************/
-  ps_dec->pf_fill_bs1[0][0] = ih264d_fill_bs1_16x16mb_pslice;
-  ps_dec->pf_fill_bs1[0][1] = ih264d_fill_bs1_non16x16mb_pslice;
-
-  ps_dec->pf_fill_bs1[1][0] = ih264d_fill_bs1_16x16mb_bslice;
-  ps_dec->pf_fill_bs1[1][1] = ih264d_fill_bs1_non16x16mb_bslice;
-
   ps_dec->pf_fill_bs_xtra_left_edge[0] = ih264d_fill_bs_xtra_left_edge_cur_frm;
   ps_dec->pf_fill_bs_xtra_left_edge[1] = ih264d_fill_bs_xtra_left_edge_cur_fld;
 
@@ -1559,6 +1824,7 @@ WORD32 ih264d_init_video_decoder(iv_obj_t *dec_hdl,
   dec_struct_t *ps_dec;
   iv_mem_rec_t *memtab;
   UWORD8 *pu1_extra_mem_base, *pu1_mem_base;
+  UWORD32 i;
 
   memtab = ps_init_ip->s_ivd_init_ip_t.pv_mem_rec_location;
 
@@ -1612,6 +1878,33 @@ WORD32 ih264d_init_video_decoder(iv_obj_t *dec_hdl,
     ps_dec->u4_share_disp_buf = 0;
   }
 
+  if (ps_init_ip->s_ivd_init_ip_t.u4_size >
+      offsetof(ih264d_init_ip_t, u4_alloc_per_sps)) {
+    ps_dec->u4_alloc_per_sps = ps_init_ip->u4_alloc_per_sps;
+  } else {
+    ps_dec->u4_alloc_per_sps = 0;
+  }
+
+  if (ps_init_ip->s_ivd_init_ip_t.u4_size >
+      offsetof(ih264d_init_ip_t, u4_film_grain)) {
+    ps_dec->u4_film_grain = (0 != ps_init_ip->u4_film_grain);
+  } else {
+    ps_dec->u4_film_grain = 0;
+  }
+
+  if (ps_init_ip->s_ivd_init_ip_t.u4_size >
+      offsetof(ih264d_init_ip_t, u4_intra_only)) {
+    ps_dec->u4_intra_only_at_init = (0 != ps_init_ip->u4_intra_only);
+  } else {
+    ps_dec->u4_intra_only_at_init = 0;
+  }
+
+  if (1 == ps_dec->u4_alloc_per_sps) {
+    ps_dec->pf_aligned_alloc = ps_init_ip->pf_aligned_alloc;
+    ps_dec->pf_aligned_free = ps_init_ip->pf_aligned_free;
+    ps_dec->pv_mem_ctxt = ps_init_ip->pv_mem_ctxt;
+  }
+
   if ((ps_dec->u4_level_at_init < MIN_LEVEL_SUPPORTED) ||
       (ps_dec->u4_level_at_init > MAX_LEVEL_SUPPORTED)) {
     ps_init_op->s_ivd_init_op_t.u4_error_code |= ERROR_LEVEL_UNSUPPORTED;
@@ -1644,6 +1937,54 @@ WORD32 ih264d_init_video_decoder(iv_obj_t *dec_hdl,
   ps_dec->u4_width_at_init = ALIGN16(ps_dec->u4_width_at_init);
   ps_dec->u4_height_at_init = ALIGN16(ps_dec->u4_height_at_init);
 
+  /* Same fit as the one the records were filled for, so the depths match */
+  if ((ps_init_ip->s_ivd_init_ip_t.u4_size >
+       offsetof(ih264d_init_ip_t, u4_mem_budget)) &&
+      (0 != ps_init_ip->u4_mem_budget)) {
+    iv_mem_rec_t as_mem_rec[MEM_REC_CNT];
+    ih264d_fill_mem_rec_ip_t s_fill_mem_rec_ip;
+    ih264d_fill_mem_rec_op_t s_fill_mem_rec_op;
+
+    s_fill_mem_rec_ip.s_ivd_fill_mem_rec_ip_t.u4_size =
+        sizeof(ih264d_fill_mem_rec_ip_t);
+    s_fill_mem_rec_op.s_ivd_fill_mem_rec_op_t.u4_size =
+        sizeof(ih264d_fill_mem_rec_op_t);
+    s_fill_mem_rec_ip.s_ivd_fill_mem_rec_ip_t.e_cmd = IV_CMD_FILL_NUM_MEM_REC;
+    s_fill_mem_rec_ip.s_ivd_fill_mem_rec_ip_t.pv_mem_rec_location = as_mem_rec;
+    s_fill_mem_rec_ip.s_ivd_fill_mem_rec_ip_t.u4_max_frm_wd =
+        ps_init_ip->s_ivd_init_ip_t.u4_frm_max_wd;
+    s_fill_mem_rec_ip.s_ivd_fill_mem_rec_ip_t.u4_max_frm_ht =
+        ps_init_ip->s_ivd_init_ip_t.u4_frm_max_ht;
+    s_fill_mem_rec_ip.i4_level = ps_dec->u4_level_at_init;
+    s_fill_mem_rec_ip.u4_num_ref_frames = ps_dec->u4_num_ref_frames_at_init;
+    s_fill_mem_rec_ip.u4_num_reorder_frames =
+        ps_dec->u4_num_reorder_frames_at_init;
+    s_fill_mem_rec_ip.u4_num_extra_disp_buf =
+        ps_dec->u4_num_extra_disp_bufs_at_init;
+    s_fill_mem_rec_ip.u4_share_disp_buf = ps_dec->u4_share_disp_buf;
+    s_fill_mem_rec_ip.e_output_format =
+        ps_init_ip->s_ivd_init_ip_t.e_output_format;
+    s_fill_mem_rec_ip.u4_alloc_per_sps = ps_dec->u4_alloc_per_sps;
+    s_fill_mem_rec_ip.pe_mem_placement = NULL;
+    s_fill_mem_rec_ip.u4_mem_budget = ps_init_ip->u4_mem_budget;
+    s_fill_mem_rec_ip.u4_film_grain = ps_dec->u4_film_grain;
+    s_fill_mem_rec_ip.u4_intra_only = ps_dec->u4_intra_only_at_init;
+
+    for (i = 0; i < MEM_REC_CNT; i++)
+      as_mem_rec[i].u4_size = sizeof(iv_mem_rec_t);
+
+    if (IV_SUCCESS != ih264d_fill_num_mem_rec((void *) &s_fill_mem_rec_ip,
+                                              (void *) &s_fill_mem_rec_op)) {
+      ps_init_op->s_ivd_init_op_t.u4_error_code |=
+          s_fill_mem_rec_op.s_ivd_fill_mem_rec_op_t.u4_error_code;
+      return (IV_FAIL);
+    }
+    ps_dec->u4_num_reorder_frames_at_init =
+        s_fill_mem_rec_op.u4_num_reorder_frames;
+    ps_dec->u4_num_extra_disp_bufs_at_init =
+        s_fill_mem_rec_op.u4_num_extra_disp_buf;
+  }
+
   ps_dec->pv_dec_thread_handle = memtab[MEM_REC_THREAD_HANDLE].pv_base;
   memset(ps_dec->pv_dec_thread_handle, 0,
          memtab[MEM_REC_THREAD_HANDLE].u4_mem_size);
@@ -1652,6 +1993,24 @@ WORD32 ih264d_init_video_decoder(iv_obj_t *dec_hdl,
   ps_dec->pv_bs_deblk_thread_handle = pu1_mem_base + ithread_get_handle_size();
   memset(pu1_mem_base, 0, memtab[MEM_REC_THREAD_HANDLE].u4_mem_size);
 
+  /* Worker 0 runs in the thread that does picture or compute bs deblocking */
+  pu1_mem_base += (2 + MAX_DEBLK_WORKERS - 1) * ithread_get_handle_size();
+  for (i = 0; i < MAX_DEBLK_WORKERS; i++) {
+    deblk_worker_ctxt_t *ps_worker = &ps_dec->as_deblk_worker[i];
+
+    ps_worker->pv_dec = ps_dec;
+    ps_worker->u4_id = i;
+    if (i) {
+      ps_worker->pv_thread_handle =
+          (UWORD8 *) ps_dec->pv_dec_thread_handle +
+          (i + 1) * ithread_get_handle_size();
+      ps_worker->pv_park_mutex = pu1_mem_base;
+      pu1_mem_base += ithread_get_mutex_lock_size();
+      ps_worker->pv_park_cond = pu1_mem_base;
+      pu1_mem_base += ithread_get_cond_struct_size();
+    }
+  }
+
   ps_dec->u4_extra_mem_used = 0;
 
   pu1_extra_mem_base = memtab[MEM_REC_EXTRA_MEM].pv_base;
@@ -1666,6 +2025,9 @@ WORD32 ih264d_init_video_decoder(iv_obj_t *dec_hdl,
 
   memcpy(ps_dec->ps_mem_tab, memtab, sizeof(iv_mem_rec_t) * MEM_REC_CNT);
 
+  for (i = 0; i < NUM_SPS_MEM_RECS; i++)
+    ps_dec->as_sps_mem_rec_app[i] = memtab[gau1_ih264d_sps_mem_recs[i]];
+
   ps_dec->ps_pps = memtab[MEM_REC_PPS].pv_base;
   memset(ps_dec->ps_pps, 0, memtab[MEM_REC_PPS].u4_mem_size);
 
@@ -1699,9 +2061,6 @@ WORD32 ih264d_init_video_decoder(iv_obj_t *dec_hdl,
 
   ps_dec->u4_extra_mem_used +=
       MAX(sizeof(dec_seq_params_t), sizeof(dec_pic_params_t));
-  ps_dec->ps_pred_pkd = memtab[MEM_REC_PRED_INFO_PKD].pv_base;
-  memset(ps_dec->ps_pred_pkd, 0, memtab[MEM_REC_PRED_INFO_PKD].u4_mem_size);
-
   ps_dec->ps_dpb_mgr->pv_codec_handle = ps_dec;
 
   ps_dec->pv_dec_out = (void *) ps_init_op;
@@ -1711,6 +2070,13 @@ WORD32 ih264d_init_video_decoder(iv_obj_t *dec_hdl,
       (UWORD8) (ps_init_ip->s_ivd_init_ip_t.e_output_format);
 
   ih264d_init_decoder(ps_dec);
+  ih264d_perf_reset(ps_dec);
+  ih264d_trace_reset(ps_dec, memtab[MEM_REC_TRACE].pv_base);
+  ps_dec->ps_film_grain = NULL;
+  if (ps_dec->u4_film_grain)
+    ps_dec->ps_film_grain = ih264d_film_grain_init(
+        ps_dec, memtab[MEM_REC_FILM_GRAIN].pv_base,
+        (ps_dec->u4_height_at_init >> 4) + 1);
 
   return (IV_SUCCESS);
 }
@@ -1744,6 +2110,7 @@ WORD32 ih264d_fill_num_mem_rec(void *pv_api_ip, void *pv_api_op) {
   iv_mem_rec_t *memTab;
 
   UWORD32 chroma_format, u4_share_disp_buf;
+  UWORD32 u4_alloc_per_sps, u4_film_grain, u4_intra_only;
   UWORD32 u4_total_num_mbs;
   UWORD32 luma_width, luma_width_in_mbs;
   UWORD32 luma_height, luma_height_in_mbs;
@@ -1752,6 +2119,12 @@ WORD32 ih264d_fill_num_mem_rec(void *pv_api_ip, void *pv_api_op) {
   ps_mem_q_ip = (ih264d_fill_mem_rec_ip_t *) pv_api_ip;
   ps_mem_q_op = (ih264d_fill_mem_rec_op_t *) pv_api_op;
 
+  if ((ps_mem_q_ip->s_ivd_fill_mem_rec_ip_t.u4_size >
+       offsetof(ih264d_fill_mem_rec_ip_t, u4_mem_budget)) &&
+      (0 != ps_mem_q_ip->u4_mem_budget)) {
+    return ih264d_fill_mem_rec_to_budget(pv_api_ip, pv_api_op);
+  }
+
   if (ps_mem_q_ip->s_ivd_fill_mem_rec_ip_t.u4_size >
       offsetof(ih264d_fill_mem_rec_ip_t, i4_level)) {
     level = ps_mem_q_ip->i4_level;
@@ -1804,6 +2177,27 @@ WORD32 ih264d_fill_num_mem_rec(void *pv_api_ip, void *pv_api_op) {
   }
   if (0 == u4_share_disp_buf) num_extra_disp_bufs = 0;
 
+  if (ps_mem_q_ip->s_ivd_fill_mem_rec_ip_t.u4_size >
+      offsetof(ih264d_fill_mem_rec_ip_t, u4_alloc_per_sps)) {
+    u4_alloc_per_sps = ps_mem_q_ip->u4_alloc_per_sps;
+  } else {
+    u4_alloc_per_sps = 0;
+  }
+
+  if (ps_mem_q_ip->s_ivd_fill_mem_rec_ip_t.u4_size >
+      offsetof(ih264d_fill_mem_rec_ip_t, u4_film_grain)) {
+    u4_film_grain = ps_mem_q_ip->u4_film_grain;
+  } else {
+    u4_film_grain = 0;
+  }
+
+  if (ps_mem_q_ip->s_ivd_fill_mem_rec_ip_t.u4_size >
+      offsetof(ih264d_fill_mem_rec_ip_t, u4_intra_only)) {
+    u4_intra_only = ps_mem_q_ip->u4_intra_only;
+  } else {
+    u4_intra_only = 0;
+  }
+
   {
     luma_height = ps_mem_q_ip->s_ivd_fill_mem_rec_ip_t.u4_max_frm_ht;
     luma_width = ps_mem_q_ip->s_ivd_fill_mem_rec_ip_t.u4_max_frm_wd;
@@ -1851,7 +2245,7 @@ WORD32 ih264d_fill_num_mem_rec(void *pv_api_ip, void *pv_api_op) {
 
   {
     UWORD32 mvinfo_size, mv_info_size_pad;
-    UWORD32 MVbank, MVbank_pad;
+    UWORD32 MVbank, MVbank_pad, col_mv_size;
     UWORD32 Ysize;
     UWORD32 UVsize;
     UWORD32 one_frm_size;
@@ -1879,6 +2273,13 @@ WORD32 ih264d_fill_num_mem_rec(void *pv_api_ip, void *pv_api_op) {
 
       num_buf = MIN(num_bufs_level, num_bufs_app);
 
+      /* No reference pictures: the picture being decoded, the ones      */
+      /* waiting for display and the one format converted for display    */
+      /* while the next picture is decoded                               */
+      if (u4_intra_only) {
+        num_buf = MIN(max_dpb_size, num_reorder_frames) + 2;
+      }
+
       num_buf += num_extra_disp_bufs;
     }
 
@@ -1911,18 +2312,24 @@ WORD32 ih264d_fill_num_mem_rec(void *pv_api_ip, void *pv_api_op) {
 
     // Note that for ARM RVDS WS the sizeof(mv_pred_t) is 16
 
-    /*Add memory for colocated MB*/
+    /* One working MV bank for the picture being decoded, plus the        */
+    /* co-located MVs of each MV buffer, sized for one per 4x4 block.     */
+    /* Intra only decode stores no co-located MVs                         */
     MVbank = sizeof(mv_pred_t) * mvinfo_size;
     MVbank_pad = sizeof(mv_pred_t) * mv_info_size_pad;
+    col_mv_size = u4_intra_only ? 0 : sizeof(col_mv_t) * mvinfo_size;
 
     MVbank = (((MVbank + 127) >> 7) << 7);
 
     MVbank_pad = (((MVbank_pad + 127) >> 7) << 7);
 
+    col_mv_size = (((col_mv_size + 127) >> 7) << 7);
+
     memTab[MEM_REC_MVBANK].u4_mem_alignment = (128 * 8) / CHAR_BIT;
     memTab[MEM_REC_MVBANK].e_mem_type = IV_EXTERNAL_CACHEABLE_PERSISTENT_MEM;
     memTab[MEM_REC_MVBANK].u4_mem_size =
-        (MVbank + MVbank_pad) * (MIN(max_dpb_size, num_ref_frames) + 1);
+        MVbank + MVbank_pad +
+        col_mv_size * (MIN(max_dpb_size, num_ref_frames) + 1);
 
     memTab[MEM_REC_REF_PIC].u4_mem_alignment = (128 * 8) / CHAR_BIT;
     memTab[MEM_REC_REF_PIC].e_mem_type = IV_EXTERNAL_CACHEABLE_PERSISTENT_MEM;
@@ -2131,7 +2538,12 @@ WORD32 ih264d_fill_num_mem_rec(void *pv_api_ip, void *pv_api_op) {
     memTab[MEM_REC_THREAD_HANDLE].u4_mem_alignment = (128 * 8) / CHAR_BIT;
     memTab[MEM_REC_THREAD_HANDLE].e_mem_type =
         IV_EXTERNAL_CACHEABLE_PERSISTENT_MEM;
-    memTab[MEM_REC_THREAD_HANDLE].u4_mem_size = u4_thread_struct_size * 2;
+    /* Decode and compute bs threads followed by deblocking workers, then */
+    /* the mutex and condition each worker is parked on                   */
+    memTab[MEM_REC_THREAD_HANDLE].u4_mem_size =
+        u4_thread_struct_size * (2 + MAX_DEBLK_WORKERS - 1) +
+        (ithread_get_mutex_lock_size() + ithread_get_cond_struct_size()) *
+            (MAX_DEBLK_WORKERS - 1);
   }
 
   memTab[MEM_REC_PARSE_MAP].u4_mem_alignment = (128 * 8) / CHAR_BIT;
@@ -2175,8 +2587,9 @@ WORD32 ih264d_fill_num_mem_rec(void *pv_api_ip, void *pv_api_op) {
     u4_mem_size = sizeof(buf_mgr_t) + ithread_get_mutex_lock_size();
     u4_mem_size += sizeof(col_mv_buf_t) * (H264_MAX_REF_PICS * 2);
     u4_mem_size = ALIGN128(u4_mem_size);
-    u4_mem_size += ((luma_width * luma_height) >> 4) *
-                   (MIN(max_dpb_size, num_ref_frames) + 1);
+    if (0 == u4_intra_only)
+      u4_mem_size += ((luma_width * luma_height) >> 4) *
+                     (MIN(max_dpb_size, num_ref_frames) + 1);
     memTab[MEM_REC_MV_BUF_MGR].u4_mem_alignment = (128 * 8) / CHAR_BIT;
     memTab[MEM_REC_MV_BUF_MGR].e_mem_type =
         IV_EXTERNAL_CACHEABLE_PERSISTENT_MEM;
@@ -2200,10 +2613,161 @@ WORD32 ih264d_fill_num_mem_rec(void *pv_api_ip, void *pv_api_op) {
         sizeof(pred_info_pkd_t) * u4_num_entries;
   }
 
+  {
+    UWORD32 u4_mem_size;
+
+#ifdef TRACE_ENABLE
+    u4_mem_size =
+        sizeof(ih264d_trace_event_t) * TRACE_EVENTS_PER_SLOT * PERF_NUM_SLOTS;
+#else
+    /* No rings are needed, the size is kept small instead of zero */
+    u4_mem_size = 64;
+#endif
+    memTab[MEM_REC_TRACE].u4_mem_alignment = (128 * 8) / CHAR_BIT;
+    memTab[MEM_REC_TRACE].e_mem_type = IV_EXTERNAL_CACHEABLE_PERSISTENT_MEM;
+    memTab[MEM_REC_TRACE].u4_mem_size = u4_mem_size;
+  }
+
+  {
+    UWORD32 u4_mem_size;
+
+    if (u4_film_grain) {
+      /* Context followed by the seeds of each row of random offset blocks */
+      u4_mem_size = ALIGN64(sizeof(film_grain_ctxt_t));
+      u4_mem_size += sizeof(UWORD32) * 3 * (luma_height_in_mbs + 1);
+    } else {
+      /* Not used, the size is kept small instead of zero */
+      u4_mem_size = 64;
+    }
+    memTab[MEM_REC_FILM_GRAIN].u4_mem_alignment = (128 * 8) / CHAR_BIT;
+    memTab[MEM_REC_FILM_GRAIN].e_mem_type =
+        IV_EXTERNAL_CACHEABLE_PERSISTENT_MEM;
+    memTab[MEM_REC_FILM_GRAIN].u4_mem_size = u4_mem_size;
+  }
+
+  /* Counted before the records allocated on SPS activation are shrunk */
+  if (ps_mem_q_op->s_ivd_fill_mem_rec_op_t.u4_size >=
+      sizeof(ih264d_fill_mem_rec_op_t)) {
+    UWORD32 i;
+
+    memset(ps_mem_q_op->au4_component_size, 0,
+           sizeof(ps_mem_q_op->au4_component_size));
+    ps_mem_q_op->u4_total_size = 0;
+    for (i = 0; i < MEM_REC_CNT; i++) {
+      ps_mem_q_op->au4_component_size[gau1_ih264d_mem_rec_component[i]] +=
+          memTab[i].u4_mem_size;
+      ps_mem_q_op->u4_total_size += memTab[i].u4_mem_size;
+    }
+    ps_mem_q_op->u4_num_reorder_frames = num_reorder_frames;
+    ps_mem_q_op->u4_num_extra_disp_buf = num_extra_disp_bufs;
+  }
+
+  if (1 == u4_alloc_per_sps) {
+    UWORD32 i;
+
+    /* Allocated on SPS activation, the size is kept small instead of zero */
+    for (i = 0; i < NUM_SPS_MEM_RECS; i++)
+      memTab[gau1_ih264d_sps_mem_recs[i]].u4_mem_size = 64;
+  }
+
+  if ((ps_mem_q_ip->s_ivd_fill_mem_rec_ip_t.u4_size >
+       offsetof(ih264d_fill_mem_rec_ip_t, pe_mem_placement)) &&
+      (NULL != ps_mem_q_ip->pe_mem_placement)) {
+    UWORD32 i;
+
+    for (i = 0; i < MEM_REC_CNT; i++)
+      ps_mem_q_ip->pe_mem_placement[i] =
+          (IH264D_MEM_PLACEMENT_T) gau1_ih264d_mem_rec_placement[i];
+  }
+
   ps_mem_q_op->s_ivd_fill_mem_rec_op_t.u4_num_mem_rec_filled = MEM_REC_CNT;
 
   return IV_SUCCESS;
 }
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264d_fill_mem_rec_to_budget                            */
+/*                                                                           */
+/*  Description   : Fills memory records for the largest display buffer     */
+/*                  count and reorder depth, up to the ones asked for, that  */
+/*                  fit in u4_mem_budget                                     */
+/*                                                                           */
+/*  Inputs        : pv_api_ip input api structure                            */
+/*                : pv_api_op output api structure                           */
+/*  Outputs       : Memory records, footprint and the values used            */
+/*  Returns       : IV_SUCCESS, IV_FAIL when even no extra display buffer   */
+/*                  and no reordering do not fit                             */
+/*                                                                           */
+/*  Issues        : Extra display buffers are dropped first, as they only    */
+/*                  add display pipeline depth. The number of reference      */
+/*                  frames is never lowered, the streams would not decode    */
+/*                                                                           */
+/*****************************************************************************/
+WORD32 ih264d_fill_mem_rec_to_budget(void *pv_api_ip, void *pv_api_op) {
+  ih264d_fill_mem_rec_ip_t *ps_mem_q_ip;
+  ih264d_fill_mem_rec_op_t *ps_mem_q_op;
+  ih264d_fill_mem_rec_ip_t s_fill_mem_rec_ip;
+  ih264d_fill_mem_rec_op_t s_fill_mem_rec_op;
+  UWORD32 u4_mem_budget;
+  WORD32 ret;
+
+  ps_mem_q_ip = (ih264d_fill_mem_rec_ip_t *) pv_api_ip;
+  ps_mem_q_op = (ih264d_fill_mem_rec_op_t *) pv_api_op;
+  u4_mem_budget = ps_mem_q_ip->u4_mem_budget;
+
+  s_fill_mem_rec_ip = *ps_mem_q_ip;
+  s_fill_mem_rec_ip.u4_mem_budget = 0;
+  if (s_fill_mem_rec_ip.u4_num_reorder_frames > H264_MAX_REF_PICS)
+    s_fill_mem_rec_ip.u4_num_reorder_frames = H264_MAX_REF_PICS;
+  if (s_fill_mem_rec_ip.u4_num_extra_disp_buf > H264_MAX_REF_PICS)
+    s_fill_mem_rec_ip.u4_num_extra_disp_buf = H264_MAX_REF_PICS;
+
+  memset(&s_fill_mem_rec_op, 0, sizeof(ih264d_fill_mem_rec_op_t));
+  s_fill_mem_rec_op.s_ivd_fill_mem_rec_op_t.u4_size =
+      sizeof(ih264d_fill_mem_rec_op_t);
+
+  while (1) {
+    ret = ih264d_fill_num_mem_rec((void *) &s_fill_mem_rec_ip,
+                                  (void *) &s_fill_mem_rec_op);
+    if (IV_SUCCESS != ret) break;
+
+    if (s_fill_mem_rec_op.u4_total_size <= u4_mem_budget) break;
+
+    /* Stepped down from the values used, which may be clamped already */
+    if (s_fill_mem_rec_op.u4_num_extra_disp_buf > 0) {
+      s_fill_mem_rec_ip.u4_num_extra_disp_buf =
+          s_fill_mem_rec_op.u4_num_extra_disp_buf - 1;
+    } else if (s_fill_mem_rec_op.u4_num_reorder_frames > 0) {
+      s_fill_mem_rec_ip.u4_num_extra_disp_buf = 0;
+      s_fill_mem_rec_ip.u4_num_reorder_frames =
+          s_fill_mem_rec_op.u4_num_reorder_frames - 1;
+    } else {
+      s_fill_mem_rec_op.s_ivd_fill_mem_rec_op_t.u4_error_code |=
+          ERROR_MEM_BUDGET_TOO_SMALL;
+      ret = IV_FAIL;
+      break;
+    }
+  }
+
+  ps_mem_q_op->s_ivd_fill_mem_rec_op_t.u4_error_code |=
+      s_fill_mem_rec_op.s_ivd_fill_mem_rec_op_t.u4_error_code;
+  ps_mem_q_op->s_ivd_fill_mem_rec_op_t.u4_num_mem_rec_filled =
+      s_fill_mem_rec_op.s_ivd_fill_mem_rec_op_t.u4_num_mem_rec_filled;
+  if (ps_mem_q_op->s_ivd_fill_mem_rec_op_t.u4_size >=
+      sizeof(ih264d_fill_mem_rec_op_t)) {
+    memcpy(ps_mem_q_op->au4_component_size,
+           s_fill_mem_rec_op.au4_component_size,
+           sizeof(ps_mem_q_op->au4_component_size));
+    ps_mem_q_op->u4_total_size = s_fill_mem_rec_op.u4_total_size;
+    ps_mem_q_op->u4_num_reorder_frames =
+        s_fill_mem_rec_op.u4_num_reorder_frames;
+    ps_mem_q_op->u4_num_extra_disp_buf =
+        s_fill_mem_rec_op.u4_num_extra_disp_buf;
+  }
+
+  return ret;
+}
 /*****************************************************************************/
 /*                                                                           */
 /*  Function Name :  ih264d_clr                                              */
@@ -2233,13 +2797,23 @@ WORD32 ih264d_clr(iv_obj_t *dec_hdl, void *pv_api_ip, void *pv_api_op) {
   dec_clr_op = (iv_retrieve_mem_rec_op_t *) pv_api_op;
   ps_dec = (dec_struct_t *) (dec_hdl->pv_codec_handle);
 
+  /* Deblocking workers stay parked between pictures, and across resets, */
+  /* until the memory is retrieved                                       */
+  ih264d_stop_deblk_workers(ps_dec);
+
   if (ps_dec->init_done != 1) {
     // return a proper Error Code
     return IV_FAIL;
   }
 
-  ih264_buf_mgr_free((buf_mgr_t *) ps_dec->pv_pic_buf_mgr);
-  ih264_buf_mgr_free((buf_mgr_t *) ps_dec->pv_mv_buf_mgr);
+  /* Managers are set up on the first SPS activation */
+  if (NULL != ps_dec->pv_pic_buf_mgr)
+    ih264_buf_mgr_free((buf_mgr_t *) ps_dec->pv_pic_buf_mgr);
+  if (NULL != ps_dec->pv_mv_buf_mgr)
+    ih264_buf_mgr_free((buf_mgr_t *) ps_dec->pv_mv_buf_mgr);
+
+  /* Hand back the records given by the application in per SPS mode */
+  ih264d_free_sps_mem(ps_dec);
 
   memcpy(dec_clr_ip->pv_mem_rec_location, ps_dec->ps_mem_tab,
          MEM_REC_CNT * (sizeof(iv_mem_rec_t)));
@@ -2353,6 +2927,8 @@ UWORD32 ih264d_map_error(UWORD32 i4_err_status) {
       break;
 
     case ERROR_NOT_SUPP_RESOLUTION:
+    case ERROR_NOT_SUPP_BIT_DEPTH:
+    case ERROR_NOT_SUPP_CHROMA_FMT:
     case ERROR_FEATURE_UNAVAIL:
     case ERROR_ACTUAL_LEVEL_GREATER_THAN_INIT:
       temp = 1 << IVD_UNSUPPORTEDINPUT;
@@ -2617,9 +3193,14 @@ WORD32 ih264d_video_decode(iv_obj_t *dec_hdl, void *pv_api_ip,
     if (0 == ps_dec->s_disp_op.u4_error_code) {
       ps_dec->u4_fmt_conv_cur_row = 0;
       ps_dec->u4_fmt_conv_num_rows = ps_dec->s_disp_frame_info.u4_y_ht;
+      PERF_STAGE_BEGIN(ps_dec, PERF_SLOT_MAIN, IH264D_PERF_STAGE_FMT_CONV);
+      TRACE_BEGIN(ps_dec, PERF_SLOT_MAIN, IH264D_TRACE_FMT_CONV,
+                  ps_dec->u4_fmt_conv_cur_row);
       ih264d_format_convert(ps_dec, &(ps_dec->s_disp_op),
                             ps_dec->u4_fmt_conv_cur_row,
                             ps_dec->u4_fmt_conv_num_rows);
+      TRACE_END(ps_dec, PERF_SLOT_MAIN, IH264D_TRACE_FMT_CONV);
+      PERF_STAGE_END(ps_dec, PERF_SLOT_MAIN, IH264D_PERF_STAGE_FMT_CONV);
       ps_dec->u4_fmt_conv_cur_row += ps_dec->u4_fmt_conv_num_rows;
       ps_dec->u4_output_present = 1;
     }
@@ -2725,6 +3306,35 @@ WORD32 ih264d_video_decode(iv_obj_t *dec_hdl, void *pv_api_ip,
       }
     }
 
+    if (ih264d_deadline_drop_nal(ps_dec, pu1_buf + u4_length_of_start_code,
+                                 buflen)) {
+      /* Dropped by the deadline controller, the following slices of the
+       * picture are dropped in the same call */
+      header_data_left = 0;
+      frame_data_left =
+          (ps_dec_op->u4_num_bytes_consumed < ps_dec_ip->u4_num_Bytes);
+      if (frame_data_left) continue;
+      bytes_consumed = 0;
+    }
+
+    if (ps_dec->s_deadline.u4_dropped_in_call) {
+      /* Return the dropped picture to app before the next one is started */
+      ps_dec_op->u4_num_bytes_consumed -= bytes_consumed;
+      ps_dec_op->e_pic_type = IV_NA_FRAME;
+      ps_dec_op->u4_error_code = IVD_DEC_FRM_SKIPPED;
+      ps_dec_op->u4_error_code |= (1 << IVD_UNSUPPORTEDPARAM);
+      ps_dec_op->u4_frame_decoded_flag = 0;
+      /*signal the decode thread*/
+      ps_dec->as_fmt_conv_part[1].u4_flag = 0;
+      ih264d_signal_decode_thread(ps_dec);
+      /* close deblock thread if it is not closed yet*/
+      if (ps_dec->u4_num_cores == 3) {
+        ih264d_signal_bs_deblk_thread(ps_dec);
+      }
+
+      return (IV_FAIL);
+    }
+
     {
       UWORD8 u1_firstbyte, u1_nal_ref_idc;
 
@@ -2867,9 +3477,14 @@ WORD32 ih264d_video_decode(iv_obj_t *dec_hdl, void *pv_api_ip,
           ps_dec->as_fmt_conv_part[1].u4_flag = 0;
         }
 
+        PERF_STAGE_BEGIN(ps_dec, PERF_SLOT_MAIN, IH264D_PERF_STAGE_FMT_CONV);
+        TRACE_BEGIN(ps_dec, PERF_SLOT_MAIN, IH264D_TRACE_FMT_CONV,
+                    ps_dec->u4_fmt_conv_cur_row);
         ih264d_format_convert(ps_dec, &(ps_dec->s_disp_op),
                               ps_dec->u4_fmt_conv_cur_row,
                               ps_dec->u4_fmt_conv_num_rows);
+        TRACE_END(ps_dec, PERF_SLOT_MAIN, IH264D_TRACE_FMT_CONV);
+        PERF_STAGE_END(ps_dec, PERF_SLOT_MAIN, IH264D_PERF_STAGE_FMT_CONV);
         ps_dec->u4_fmt_conv_cur_row += ps_dec->u4_fmt_conv_num_rows;
       } else {
         ps_dec->as_fmt_conv_part[1].u4_flag = 0;
@@ -2986,8 +3601,8 @@ WORD32 ih264d_video_decode(iv_obj_t *dec_hdl, void *pv_api_ip,
      * and adds to the codec cycles
      */
 
-    if ((0 == ps_dec->u4_num_reorder_frames_at_init) &&
-        ps_dec->u1_init_dec_flag) {
+    if (ps_dec->u1_low_delay && ps_dec->u1_init_dec_flag &&
+        !ps_dec->u4_output_present) {
       ih264d_get_next_display_field(ps_dec, ps_dec->ps_out_buffer,
                                     &(ps_dec->s_disp_op));
       if (0 == ps_dec->s_disp_op.u4_error_code) {
@@ -3008,9 +3623,14 @@ WORD32 ih264d_video_decode(iv_obj_t *dec_hdl, void *pv_api_ip,
       ps_dec->u4_fmt_conv_num_rows = MIN(
           ps_dec->u4_fmt_conv_num_rows,
           (ps_dec->s_disp_frame_info.u4_y_ht - ps_dec->u4_fmt_conv_cur_row));
+      PERF_STAGE_BEGIN(ps_dec, PERF_SLOT_MAIN, IH264D_PERF_STAGE_FMT_CONV);
+      TRACE_BEGIN(ps_dec, PERF_SLOT_MAIN, IH264D_TRACE_FMT_CONV,
+                  ps_dec->u4_fmt_conv_cur_row);
       ih264d_format_convert(ps_dec, &(ps_dec->s_disp_op),
                             ps_dec->u4_fmt_conv_cur_row,
                             ps_dec->u4_fmt_conv_num_rows);
+      TRACE_END(ps_dec, PERF_SLOT_MAIN, IH264D_TRACE_FMT_CONV);
+      PERF_STAGE_END(ps_dec, PERF_SLOT_MAIN, IH264D_PERF_STAGE_FMT_CONV);
       ps_dec->u4_fmt_conv_cur_row += ps_dec->u4_fmt_conv_num_rows;
     }
 
@@ -3135,9 +3755,14 @@ WORD32 ih264d_get_display_frame(iv_obj_t *dec_hdl, void *pv_api_ip,
     if (0 == dec_disp_op->u4_error_code) {
       ps_dec->u4_fmt_conv_cur_row = 0;
       ps_dec->u4_fmt_conv_num_rows = ps_dec->s_disp_frame_info.u4_y_ht;
+      PERF_STAGE_BEGIN(ps_dec, PERF_SLOT_MAIN, IH264D_PERF_STAGE_FMT_CONV);
+      TRACE_BEGIN(ps_dec, PERF_SLOT_MAIN, IH264D_TRACE_FMT_CONV,
+                  ps_dec->u4_fmt_conv_cur_row);
       ih264d_format_convert(ps_dec, &(ps_dec->s_disp_op),
                             ps_dec->u4_fmt_conv_cur_row,
                             ps_dec->u4_fmt_conv_num_rows);
+      TRACE_END(ps_dec, PERF_SLOT_MAIN, IH264D_TRACE_FMT_CONV);
+      PERF_STAGE_END(ps_dec, PERF_SLOT_MAIN, IH264D_PERF_STAGE_FMT_CONV);
       ps_dec->u4_fmt_conv_cur_row += ps_dec->u4_fmt_conv_num_rows;
     }
     ih264d_release_display_field(ps_dec, dec_disp_op);
@@ -3843,6 +4468,36 @@ WORD32 ih264d_ctl(iv_obj_t *dec_hdl, void *pv_api_ip, void *pv_api_op) {
       ret =
           ih264d_set_processor(dec_hdl, (void *) pv_api_ip, (void *) pv_api_op);
       break;
+    case IH264D_CMD_CTL_SET_MC_PREFETCH:
+      ret = ih264d_set_mc_prefetch(dec_hdl, (void *) pv_api_ip,
+                                   (void *) pv_api_op);
+      break;
+    case IH264D_CMD_CTL_RELEASE_MEM:
+      ret = ih264d_release_mem(dec_hdl, (void *) pv_api_ip, (void *) pv_api_op);
+      break;
+    case IH264D_CMD_CTL_SET_LOW_DELAY:
+      ret = ih264d_set_low_delay_mode(dec_hdl, (void *) pv_api_ip,
+                                      (void *) pv_api_op);
+      break;
+    case IH264D_CMD_CTL_SET_INTRA_ONLY:
+      ret = ih264d_set_intra_only_mode(dec_hdl, (void *) pv_api_ip,
+                                       (void *) pv_api_op);
+      break;
+    case IH264D_CMD_CTL_SET_DEADLINE:
+      ret = ih264d_set_deadline(dec_hdl, (void *) pv_api_ip, (void *) pv_api_op);
+      break;
+    case IH264D_CMD_CTL_GET_DEADLINE_STATS:
+      ret = ih264d_get_deadline_stats(dec_hdl, (void *) pv_api_ip,
+                                      (void *) pv_api_op);
+      break;
+    case IH264D_CMD_CTL_GET_PERF_STATS:
+      ret = ih264d_get_perf_stats(dec_hdl, (void *) pv_api_ip,
+                                  (void *) pv_api_op);
+      break;
+    case IH264D_CMD_CTL_GET_TRACE_EVENTS:
+      ret = ih264d_get_trace_events(dec_hdl, (void *) pv_api_ip,
+                                    (void *) pv_api_op);
+      break;
     default:
       H264_DEC_DEBUG_PRINT("\ndo nothing\n");
       break;
@@ -4148,6 +4803,7 @@ WORD32 ih264d_set_num_cores(iv_obj_t *dec_hdl, void *pv_api_ip,
   ps_op = (ih264d_ctl_set_num_cores_op_t *) pv_api_op;
   ps_op->u4_error_code = 0;
   ps_dec->u4_num_cores = ps_ip->u4_num_cores;
+  ps_dec->u4_num_deblk_cores = MIN(ps_ip->u4_num_cores, MAX_DEBLK_WORKERS);
   if (ps_dec->u4_num_cores == 1) {
     ps_dec->u1_separate_parse = 0;
     ps_dec->pi4_ctxt_save_register_dec = ps_dec->pi4_ctxt_save_register;
@@ -4155,12 +4811,191 @@ WORD32 ih264d_set_num_cores(iv_obj_t *dec_hdl, void *pv_api_ip,
     ps_dec->u1_separate_parse = 1;
   }
 
-  /*using only upto three threads currently*/
+  /* Parse, decode and compute bs use upto three threads, the remaining cores
+   * are used for deblocking */
   if (ps_dec->u4_num_cores > 3) ps_dec->u4_num_cores = 3;
 
   return IV_SUCCESS;
 }
 
+WORD32 ih264d_set_mc_prefetch(iv_obj_t *dec_hdl, void *pv_api_ip,
+                              void *pv_api_op) {
+  ih264d_ctl_set_mc_prefetch_ip_t *ps_ip;
+  ih264d_ctl_set_mc_prefetch_op_t *ps_op;
+  dec_struct_t *ps_dec = dec_hdl->pv_codec_handle;
+
+  ps_ip = (ih264d_ctl_set_mc_prefetch_ip_t *) pv_api_ip;
+  ps_op = (ih264d_ctl_set_mc_prefetch_op_t *) pv_api_op;
+  ps_op->u4_error_code = 0;
+  ps_dec->u4_mc_prefetch_dist = ps_ip->u4_prefetch_dist;
+
+  return IV_SUCCESS;
+}
+
+WORD32 ih264d_release_mem(iv_obj_t *dec_hdl, void *pv_api_ip,
+                          void *pv_api_op) {
+  ih264d_ctl_release_mem_op_t *ps_op;
+  dec_struct_t *ps_dec = dec_hdl->pv_codec_handle;
+
+  UNUSED(pv_api_ip);
+  ps_op = (ih264d_ctl_release_mem_op_t *) pv_api_op;
+  ps_op->u4_error_code = 0;
+  ps_op->u4_mem_released = 0;
+
+  /* Pictures of the active sequence live in the block until a reset */
+  if (ps_dec->u1_init_dec_flag) {
+    ps_op->u4_error_code |= 1 << IVD_UNSUPPORTEDPARAM;
+    return IV_FAIL;
+  }
+
+  if (NULL != ps_dec->pv_sps_mem) {
+    ps_op->u4_mem_released = ps_dec->u4_sps_mem_size;
+
+    /* The MV buffer manager and its mutex are carved from the block */
+    ih264_buf_mgr_free((buf_mgr_t *) ps_dec->pv_mv_buf_mgr);
+    ps_dec->pv_mv_buf_mgr = NULL;
+    ih264d_free_sps_mem(ps_dec);
+
+    /* Leave nothing in the DPB for a flush to release, as before init */
+    ps_dec->u1_pic_bufs = 0;
+  }
+
+  return IV_SUCCESS;
+}
+
+WORD32 ih264d_set_low_delay_mode(iv_obj_t *dec_hdl, void *pv_api_ip,
+                                 void *pv_api_op) {
+  ih264d_ctl_set_low_delay_ip_t *ps_ip;
+  ih264d_ctl_set_low_delay_op_t *ps_op;
+  dec_struct_t *ps_dec = dec_hdl->pv_codec_handle;
+
+  ps_ip = (ih264d_ctl_set_low_delay_ip_t *) pv_api_ip;
+  ps_op = (ih264d_ctl_set_low_delay_op_t *) pv_api_op;
+  ps_op->u4_error_code = 0;
+
+  /* Pictures held for display would stay queued ahead of the later ones */
+  if (ps_dec->u1_init_dec_flag) {
+    ps_op->u4_error_code |= 1 << IVD_UNSUPPORTEDPARAM;
+    return IV_FAIL;
+  }
+  ps_dec->u4_low_delay = ps_ip->u4_low_delay;
+
+  return IV_SUCCESS;
+}
+
+WORD32 ih264d_set_intra_only_mode(iv_obj_t *dec_hdl, void *pv_api_ip,
+                                  void *pv_api_op) {
+  ih264d_ctl_set_intra_only_ip_t *ps_ip;
+  ih264d_ctl_set_intra_only_op_t *ps_op;
+  dec_struct_t *ps_dec = dec_hdl->pv_codec_handle;
+
+  ps_ip = (ih264d_ctl_set_intra_only_ip_t *) pv_api_ip;
+  ps_op = (ih264d_ctl_set_intra_only_op_t *) pv_api_op;
+  ps_op->u4_error_code = 0;
+
+  /* A change mid-stream would mix padded and unpadded reference pictures */
+  if (ps_dec->u1_init_dec_flag) {
+    ps_op->u4_error_code |= 1 << IVD_UNSUPPORTEDPARAM;
+    return IV_FAIL;
+  }
+  /* There is no room for co-located MVs or reference pictures */
+  if (ps_dec->u4_intra_only_at_init && (0 == ps_ip->u4_intra_only)) {
+    ps_op->u4_error_code |= 1 << IVD_UNSUPPORTEDPARAM;
+    return IV_FAIL;
+  }
+  ps_dec->u4_intra_only = ps_ip->u4_intra_only;
+
+  return IV_SUCCESS;
+}
+
+WORD32 ih264d_set_deadline(iv_obj_t *dec_hdl, void *pv_api_ip,
+                           void *pv_api_op) {
+  ih264d_ctl_set_deadline_ip_t *ps_ip;
+  ih264d_ctl_set_deadline_op_t *ps_op;
+  dec_struct_t *ps_dec = dec_hdl->pv_codec_handle;
+  UWORD32 u4_deadline_us;
+
+  ps_ip = (ih264d_ctl_set_deadline_ip_t *) pv_api_ip;
+  ps_op = (ih264d_ctl_set_deadline_op_t *) pv_api_op;
+  ps_op->u4_error_code = 0;
+
+  u4_deadline_us = ps_ip->u4_deadline_us;
+  if ((0 == u4_deadline_us) && ps_ip->u4_target_fps)
+    u4_deadline_us = 1000000 / ps_ip->u4_target_fps;
+  ih264d_deadline_set(ps_dec, u4_deadline_us);
+
+  return IV_SUCCESS;
+}
+
+WORD32 ih264d_get_deadline_stats(iv_obj_t *dec_hdl, void *pv_api_ip,
+                                 void *pv_api_op) {
+  ih264d_ctl_get_deadline_stats_op_t *ps_op;
+  dec_struct_t *ps_dec = dec_hdl->pv_codec_handle;
+
+  UNUSED(pv_api_ip);
+  ps_op = (ih264d_ctl_get_deadline_stats_op_t *) pv_api_op;
+  ps_op->u4_error_code = 0;
+
+  ih264d_deadline_get_stats(ps_dec, ps_op);
+
+  return IV_SUCCESS;
+}
+
+WORD32 ih264d_get_perf_stats(iv_obj_t *dec_hdl, void *pv_api_ip,
+                             void *pv_api_op) {
+  ih264d_ctl_get_perf_stats_ip_t *ps_ip;
+  ih264d_ctl_get_perf_stats_op_t *ps_op;
+  dec_struct_t *ps_dec = dec_hdl->pv_codec_handle;
+
+  ps_ip = (ih264d_ctl_get_perf_stats_ip_t *) pv_api_ip;
+  ps_op = (ih264d_ctl_get_perf_stats_op_t *) pv_api_op;
+  ps_op->u4_error_code = 0;
+
+#ifdef PERF_STATS_ENABLE
+  ih264d_perf_get_stats(ps_dec, ps_op);
+  if (ps_ip->u4_reset) ih264d_perf_reset(ps_dec);
+
+  return IV_SUCCESS;
+#else
+  /* Counters are not updated without PERF_STATS_ENABLE */
+  UNUSED(ps_ip);
+  UNUSED(ps_dec);
+  ps_op->u4_error_code |= 1 << IVD_UNSUPPORTEDPARAM;
+  ps_op->u4_error_code |= IVD_UNSUPPORTED_API_CMD;
+
+  return IV_FAIL;
+#endif
+}
+
+WORD32 ih264d_get_trace_events(iv_obj_t *dec_hdl, void *pv_api_ip,
+                               void *pv_api_op) {
+  ih264d_ctl_get_trace_events_ip_t *ps_ip;
+  ih264d_ctl_get_trace_events_op_t *ps_op;
+  dec_struct_t *ps_dec = dec_hdl->pv_codec_handle;
+
+  ps_ip = (ih264d_ctl_get_trace_events_ip_t *) pv_api_ip;
+  ps_op = (ih264d_ctl_get_trace_events_op_t *) pv_api_op;
+  ps_op->u4_error_code = 0;
+
+#ifdef TRACE_ENABLE
+  if ((NULL == ps_ip->ps_events) && ps_ip->u4_max_events) {
+    ps_op->u4_error_code |= 1 << IVD_UNSUPPORTEDPARAM;
+    return IV_FAIL;
+  }
+  ih264d_trace_get_events(ps_dec, ps_ip, ps_op);
+
+  return IV_SUCCESS;
+#else
+  /* Events are not recorded without TRACE_ENABLE */
+  UNUSED(ps_ip);
+  UNUSED(ps_dec);
+  ps_op->u4_error_code |= 1 << IVD_UNSUPPORTEDPARAM;
+  ps_op->u4_error_code |= IVD_UNSUPPORTED_API_CMD;
+
+  return IV_FAIL;
+#endif
+}
+
 void ih264d_fill_output_struct_from_context(dec_struct_t *ps_dec,
                                             ivd_video_decode_op_t *ps_dec_op) {
   if ((ps_dec_op->u4_error_code & 0xff) !=
@@ -4350,13 +5185,28 @@ IV_API_CALL_STATUS_T ih264d_api_function(iv_obj_t *dec_hdl, void *pv_api_ip,
       break;
 
     case IVD_CMD_VIDEO_DECODE:
+      PERF_STAGE_BEGIN((dec_struct_t *) dec_hdl->pv_codec_handle,
+                       PERF_SLOT_MAIN, PERF_TIMER_CALL);
+      TRACE_BEGIN((dec_struct_t *) dec_hdl->pv_codec_handle, PERF_SLOT_MAIN,
+                  IH264D_TRACE_CALL, 0);
+      ih264d_deadline_start_call((dec_struct_t *) dec_hdl->pv_codec_handle);
       u4_api_ret =
           ih264d_video_decode(dec_hdl, (void *) pv_api_ip, (void *) pv_api_op);
+      ih264d_deadline_end_call((dec_struct_t *) dec_hdl->pv_codec_handle,
+                               (ivd_video_decode_op_t *) pv_api_op);
+      TRACE_END((dec_struct_t *) dec_hdl->pv_codec_handle, PERF_SLOT_MAIN,
+                IH264D_TRACE_CALL);
+      PERF_STAGE_END((dec_struct_t *) dec_hdl->pv_codec_handle, PERF_SLOT_MAIN,
+                     PERF_TIMER_CALL);
       break;
 
     case IVD_CMD_GET_DISPLAY_FRAME:
+      PERF_STAGE_BEGIN((dec_struct_t *) dec_hdl->pv_codec_handle,
+                       PERF_SLOT_MAIN, PERF_TIMER_CALL);
       u4_api_ret = ih264d_get_display_frame(dec_hdl, (void *) pv_api_ip,
                                             (void *) pv_api_op);
+      PERF_STAGE_END((dec_struct_t *) dec_hdl->pv_codec_handle, PERF_SLOT_MAIN,
+                     PERF_TIMER_CALL);
 
       break;
 
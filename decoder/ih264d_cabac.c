@@ -292,7 +292,7 @@ UWORD32 ih264d_decode_bin(UWORD32 u4_ctx_inc, bin_ctxt_model_t *ps_src_bin_ctxt,
     ps_bitstrm->u4_ofst = u4_offset;
   }
 
-  INC_BIN_COUNT(ps_cab_env)
+  INC_BIN_COUNT(ps_cab_env);
 
   ps_cab_env->u4_code_int_val_ofst = u4_code_int_val_ofst;
   ps_cab_env->u4_code_int_range = u4_code_int_range;
@@ -357,7 +357,7 @@ UWORD8 ih264d_decode_terminate(decoding_envirnoment_t *ps_cab_env,
   ps_cab_env->u4_code_int_range = u4_code_int_range;
   ps_cab_env->u4_code_int_val_ofst = u4_code_int_val_ofst;
 
-  INC_BIN_COUNT(ps_cab_env)
+  INC_BIN_COUNT(ps_cab_env);
 
   return (u4_symbol);
 }
@@ -143,6 +143,8 @@ typedef struct {
   UWORD32 u4_code_int_val_ofst;
   const void *cabac_table;
   void *pv_codec_handle; /* For Error Handling */
+  UWORD64 u8_num_bins;   /* Bins decoded, counted with PERF_STATS_ENABLE */
+  UWORD64 u8_num_bypass_bins;
 } decoding_envirnoment_t;
 
 WORD32 ih264d_init_cabac_dec_envirnoment(decoding_envirnoment_t *ps_cab_env,
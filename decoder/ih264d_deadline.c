@@ -0,0 +1,337 @@
+/* Copyright (c) [2020]-[2023] Ittiam Systems Pvt. Ltd.
+   All rights reserved.
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted (subject to the limitations in the
+   disclaimer below) provided that the following conditions are met:
+   •    Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+   •    Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+   •    None of the names of Ittiam Systems Pvt. Ltd., its affiliates,
+   investors, business partners, nor the names of its contributors may be
+   used to endorse or promote products derived from this software without
+   specific prior written permission.
+
+   NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED
+   BY THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+   BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+   FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+   HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+   OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+   WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+   OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+   EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+   This Software is an implementation of the AVC/H.264
+   standard by Ittiam Systems Pvt. Ltd. (“Ittiam”).
+   Additional patent licenses may be required for this Software,
+   including, but not limited to, a license from MPEG LA’s AVC/H.264
+   licensing program (see https://www.mpegla.com/programs/avc-h-264/).
+
+   NOTWITHSTANDING ANYTHING TO THE CONTRARY, THIS DOES NOT GRANT ANY
+   EXPRESS OR IMPLIED LICENSES TO ANY PATENT CLAIMS OF ANY AFFILIATE
+   (TO THE EXTENT NOT IN THE LEGAL ENTITY), INVESTOR, OR OTHER
+   BUSINESS PARTNER OF ITTIAM. You may only use this software or
+   modifications thereto for purposes that are authorized by
+   appropriate patent licenses. You should seek legal advice based
+   upon your implementation details.
+
+---------------------------------------------------------------
+*/
+/*****************************************************************************/
+/*                                                                           */
+/*  File Name         : ih264d_deadline.c                                    */
+/*                                                                           */
+/*  Description       : Contains the controller degrading non-reference      */
+/*                      pictures when the decode calls take longer than the  */
+/*                      deadline. The time of each call is averaged, the     */
+/*                      level is raised while the average is over the        */
+/*                      deadline and lowered once it is back under           */
+/*                      DEADLINE_RELAX_PCT of it                             */
+/*                                                                           */
+/*  List of Functions : ih264d_deadline_avg()                                */
+/*                      ih264d_deadline_reset()                              */
+/*                      ih264d_deadline_set()                                */
+/*                      ih264d_deadline_start_call()                         */
+/*                      ih264d_deadline_end_call()                           */
+/*                      ih264d_deadline_degrade_pic()                        */
+/*                      ih264d_deadline_drop_nal()                           */
+/*                      ih264d_deadline_get_stats()                          */
+/*                                                                           */
+/*  Issues / Problems : None                                                 */
+/*                                                                           */
+/*****************************************************************************/
+/*****************************************************************************/
+/* File Includes                                                             */
+/*****************************************************************************/
+
+/* System include files */
+#include <string.h>
+
+/* User include files */
+#include "ih264_typedefs.h"
+#include "ih264_macros.h"
+#include "ih264_platform_macros.h"
+#include "ih264d_defs.h"
+#include "ih264d_structs.h"
+#include "ih264d_perf_stats.h"
+#include "ih264d_deadline.h"
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264d_deadline_avg                                      */
+/*                                                                           */
+/*  Description   : Adds a sample to a running average, the first sample     */
+/*                  starts it                                                */
+/*                                                                           */
+/*  Inputs        : u4_avg    - running average, 0 if there is none yet      */
+/*                  u4_sample - new sample                                   */
+/*  Returns       : Updated average                                          */
+/*                                                                           */
+/*****************************************************************************/
+static UWORD32 ih264d_deadline_avg(UWORD32 u4_avg, UWORD32 u4_sample) {
+  if (0 == u4_avg) return u4_sample;
+
+  return u4_avg - (u4_avg >> DEADLINE_AVG_SHIFT) +
+         (u4_sample >> DEADLINE_AVG_SHIFT);
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264d_deadline_reset                                    */
+/*                                                                           */
+/*  Description   : Turns the controller off and clears its counters         */
+/*                                                                           */
+/*  Inputs        : ps_dec - decoder context                                 */
+/*                                                                           */
+/*****************************************************************************/
+void ih264d_deadline_reset(dec_struct_t *ps_dec) {
+  memset(&ps_dec->s_deadline, 0, sizeof(ps_dec->s_deadline));
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264d_deadline_set                                      */
+/*                                                                           */
+/*  Description   : Sets the deadline. The averages are kept, so that a new  */
+/*                  deadline acts from the next decode call. Turning the     */
+/*                  controller off goes back to full decoding                */
+/*                                                                           */
+/*  Inputs        : ps_dec         - decoder context                         */
+/*                  u4_deadline_us - deadline in microseconds, 0 for off     */
+/*                                                                           */
+/*****************************************************************************/
+void ih264d_deadline_set(dec_struct_t *ps_dec, UWORD32 u4_deadline_us) {
+  deadline_ctxt_t *ps_dl = &ps_dec->s_deadline;
+
+  ps_dl->u4_deadline_us = u4_deadline_us;
+  ps_dl->u4_hold = 0;
+  if (0 == u4_deadline_us) ps_dl->u4_level = IH264D_DEADLINE_LEVEL_NONE;
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264d_deadline_start_call                               */
+/*                                                                           */
+/*  Description   : Notes the start of a decode call                         */
+/*                                                                           */
+/*  Inputs        : ps_dec - decoder context                                 */
+/*                                                                           */
+/*****************************************************************************/
+void ih264d_deadline_start_call(dec_struct_t *ps_dec) {
+  deadline_ctxt_t *ps_dl = &ps_dec->s_deadline;
+
+  ps_dl->u4_dropped_in_call = 0;
+  if (ps_dl->u4_deadline_us) ps_dl->u8_call_start_ns = ih264d_perf_clock_ns();
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264d_deadline_end_call                                 */
+/*                                                                           */
+/*  Description   : Adds the time of a decode call that decoded or dropped a */
+/*                  picture, other than the first one, to the averages and   */
+/*                  moves the level by at most one step. Raising the level   */
+/*                  helps only when there are non-reference pictures.        */
+/*                  Relaxing from dropping uses the last measured time of    */
+/*                  the non-reference pictures, as the average no longer     */
+/*                  includes their decode                                    */
+/*                                                                           */
+/*  Inputs        : ps_dec    - decoder context                              */
+/*                  ps_dec_op - output structure of the decode call          */
+/*                                                                           */
+/*****************************************************************************/
+void ih264d_deadline_end_call(dec_struct_t *ps_dec,
+                              ivd_video_decode_op_t *ps_dec_op) {
+  deadline_ctxt_t *ps_dl = &ps_dec->s_deadline;
+  UWORD32 u4_time_us, u4_non_ref, u4_expected_us;
+
+  if (0 == ps_dl->u4_deadline_us) return;
+  if ((0 == ps_dec_op->u4_frame_decoded_flag) && !ps_dl->u4_dropped_in_call)
+    return;
+
+  u4_time_us =
+      (UWORD32) ((ih264d_perf_clock_ns() - ps_dl->u8_call_start_ns) / 1000);
+
+  ps_dl->u4_num_pics++;
+  if (u4_time_us > ps_dl->u4_deadline_us) ps_dl->u4_num_over_deadline++;
+
+  /* The first picture also sets up the picture buffers, keep it out of the */
+  /* averages */
+  if (1 == ps_dl->u4_num_pics) return;
+  ps_dl->u4_avg_us = ih264d_deadline_avg(ps_dl->u4_avg_us, u4_time_us);
+
+  if (ps_dl->u4_dropped_in_call) {
+    u4_non_ref = 1;
+  } else {
+    UWORD32 u4_type;
+
+    u4_non_ref = (0 == ps_dec->ps_cur_slice->u1_nal_ref_idc);
+    if (u4_non_ref)
+      ps_dl->u4_non_ref_avg_us =
+          ih264d_deadline_avg(ps_dl->u4_non_ref_avg_us, u4_time_us);
+    else
+      ps_dl->u4_ref_avg_us =
+          ih264d_deadline_avg(ps_dl->u4_ref_avg_us, u4_time_us);
+
+    if (IV_B_FRAME == ps_dec->i4_frametype)
+      u4_type = 2;
+    else if (IV_P_FRAME == ps_dec->i4_frametype)
+      u4_type = 1;
+    else
+      u4_type = 0;
+    ps_dl->au4_type_avg_us[u4_type] =
+        ih264d_deadline_avg(ps_dl->au4_type_avg_us[u4_type], u4_time_us);
+  }
+  ps_dl->u4_non_ref_share = ps_dl->u4_non_ref_share -
+                            (ps_dl->u4_non_ref_share >> DEADLINE_AVG_SHIFT) +
+                            (u4_non_ref ? (256 >> DEADLINE_AVG_SHIFT) : 0);
+
+  if (ps_dl->u4_hold) {
+    ps_dl->u4_hold--;
+    return;
+  }
+
+  if ((ps_dl->u4_avg_us > ps_dl->u4_deadline_us) &&
+      (ps_dl->u4_level < IH264D_DEADLINE_LEVEL_DROP) &&
+      ps_dl->u4_non_ref_share) {
+    ps_dl->u4_level++;
+    ps_dl->u4_num_escalations++;
+    ps_dl->u4_hold = DEADLINE_HOLD_CALLS;
+    if (ps_dl->u4_level > ps_dl->u4_max_level)
+      ps_dl->u4_max_level = ps_dl->u4_level;
+    return;
+  }
+
+  if (IH264D_DEADLINE_LEVEL_NONE == ps_dl->u4_level) return;
+
+  u4_expected_us = ps_dl->u4_avg_us;
+  if (IH264D_DEADLINE_LEVEL_DROP == ps_dl->u4_level)
+    u4_expected_us = (UWORD32) (((UWORD64) (256 - ps_dl->u4_non_ref_share) *
+                                     ps_dl->u4_ref_avg_us +
+                                 (UWORD64) ps_dl->u4_non_ref_share *
+                                     ps_dl->u4_non_ref_avg_us) >>
+                                8);
+
+  if ((UWORD64) u4_expected_us * 100 <
+      (UWORD64) ps_dl->u4_deadline_us * DEADLINE_RELAX_PCT) {
+    ps_dl->u4_level--;
+    ps_dl->u4_num_relaxations++;
+    ps_dl->u4_hold = DEADLINE_HOLD_CALLS;
+  }
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264d_deadline_degrade_pic                              */
+/*                                                                           */
+/*  Description   : Sets the degrade flags of the current level, at the      */
+/*                  start of a non-reference picture                         */
+/*                                                                           */
+/*  Inputs        : ps_dec - decoder context                                 */
+/*                                                                           */
+/*****************************************************************************/
+void ih264d_deadline_degrade_pic(dec_struct_t *ps_dec) {
+  deadline_ctxt_t *ps_dl = &ps_dec->s_deadline;
+
+  if ((0 == ps_dl->u4_deadline_us) || ps_dec->ps_cur_slice->u1_nal_ref_idc)
+    return;
+
+  if (ps_dl->u4_level >= IH264D_DEADLINE_LEVEL_NO_DEBLK) {
+    ps_dec->u4_app_disable_deblk_frm = 1;
+    ps_dl->u4_num_deblk_skipped++;
+  }
+  if (ps_dl->u4_level >= IH264D_DEADLINE_LEVEL_FULL_PEL) {
+    ps_dec->i4_mv_frac_mask = ~0x3;
+    ps_dl->u4_num_full_pel++;
+  }
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264d_deadline_drop_nal                                 */
+/*                                                                           */
+/*  Description   : Decides whether a NAL unit is dropped. At the drop level */
+/*                  the slices of non-reference pictures are dropped before  */
+/*                  a picture is started in the decode call                  */
+/*                                                                           */
+/*  Inputs        : ps_dec     - decoder context                             */
+/*                  pu1_nal    - NAL unit, from the header byte              */
+/*                  i4_nal_len - NAL unit size in bytes                      */
+/*  Returns       : 1 if the NAL unit is dropped, else 0                     */
+/*                                                                           */
+/*****************************************************************************/
+WORD32 ih264d_deadline_drop_nal(dec_struct_t *ps_dec, UWORD8 *pu1_nal,
+                                WORD32 i4_nal_len) {
+  deadline_ctxt_t *ps_dl = &ps_dec->s_deadline;
+
+  if ((0 == ps_dl->u4_deadline_us) ||
+      (ps_dl->u4_level < IH264D_DEADLINE_LEVEL_DROP))
+    return 0;
+
+  if (ps_dec->u4_pic_buf_got || ps_dec->i4_decode_header ||
+      (3 != ps_dec->i4_header_decoded) || (i4_nal_len < 2))
+    return 0;
+
+  if ((SLICE_NAL != NAL_UNIT_TYPE(pu1_nal[0])) || NAL_REF_IDC(pu1_nal[0]))
+    return 0;
+
+  /* first_mb_in_slice 0 is coded as a single 1 bit */
+  if (pu1_nal[1] & 0x80) ps_dl->u4_num_dropped++;
+  ps_dl->u4_dropped_in_call = 1;
+
+  return 1;
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264d_deadline_get_stats                                */
+/*                                                                           */
+/*  Description   : Copies out the state and the counters                    */
+/*                                                                           */
+/*  Inputs        : ps_dec - decoder context                                 */
+/*                  ps_op  - output structure of the control call            */
+/*                                                                           */
+/*****************************************************************************/
+void ih264d_deadline_get_stats(dec_struct_t *ps_dec,
+                               ih264d_ctl_get_deadline_stats_op_t *ps_op) {
+  deadline_ctxt_t *ps_dl = &ps_dec->s_deadline;
+
+  ps_op->u4_deadline_us = ps_dl->u4_deadline_us;
+  ps_op->u4_level = ps_dl->u4_level;
+  ps_op->u4_max_level = ps_dl->u4_max_level;
+  ps_op->u4_avg_us = ps_dl->u4_avg_us;
+  memcpy(ps_op->au4_type_avg_us, ps_dl->au4_type_avg_us,
+         sizeof(ps_op->au4_type_avg_us));
+  ps_op->u4_num_pics = ps_dl->u4_num_pics;
+  ps_op->u4_num_over_deadline = ps_dl->u4_num_over_deadline;
+  ps_op->u4_num_escalations = ps_dl->u4_num_escalations;
+  ps_op->u4_num_relaxations = ps_dl->u4_num_relaxations;
+  ps_op->u4_num_deblk_skipped = ps_dl->u4_num_deblk_skipped;
+  ps_op->u4_num_full_pel = ps_dl->u4_num_full_pel;
+  ps_op->u4_num_dropped = ps_dl->u4_num_dropped;
+}
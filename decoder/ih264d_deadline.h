@@ -0,0 +1,95 @@
+/* Copyright (c) [2020]-[2023] Ittiam Systems Pvt. Ltd.
+   All rights reserved.
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted (subject to the limitations in the
+   disclaimer below) provided that the following conditions are met:
+   •    Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+   •    Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+   •    None of the names of Ittiam Systems Pvt. Ltd., its affiliates,
+   investors, business partners, nor the names of its contributors may be
+   used to endorse or promote products derived from this software without
+   specific prior written permission.
+
+   NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED
+   BY THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+   BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+   FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+   HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+   OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+   WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+   OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+   EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+   This Software is an implementation of the AVC/H.264
+   standard by Ittiam Systems Pvt. Ltd. (“Ittiam”).
+   Additional patent licenses may be required for this Software,
+   including, but not limited to, a license from MPEG LA’s AVC/H.264
+   licensing program (see https://www.mpegla.com/programs/avc-h-264/).
+
+   NOTWITHSTANDING ANYTHING TO THE CONTRARY, THIS DOES NOT GRANT ANY
+   EXPRESS OR IMPLIED LICENSES TO ANY PATENT CLAIMS OF ANY AFFILIATE
+   (TO THE EXTENT NOT IN THE LEGAL ENTITY), INVESTOR, OR OTHER
+   BUSINESS PARTNER OF ITTIAM. You may only use this software or
+   modifications thereto for purposes that are authorized by
+   appropriate patent licenses. You should seek legal advice based
+   upon your implementation details.
+
+---------------------------------------------------------------
+*/
+/*****************************************************************************/
+/*                                                                           */
+/*  File Name         : ih264d_deadline.h                                    */
+/*                                                                           */
+/*  Description       : Functions of the controller degrading non-reference  */
+/*                      pictures to keep the decode calls within the         */
+/*                      deadline set through IH264D_CMD_CTL_SET_DEADLINE     */
+/*                                                                           */
+/*  List of Functions : ih264d_deadline_reset()                              */
+/*                      ih264d_deadline_set()                                */
+/*                      ih264d_deadline_start_call()                         */
+/*                      ih264d_deadline_end_call()                           */
+/*                      ih264d_deadline_degrade_pic()                        */
+/*                      ih264d_deadline_drop_nal()                           */
+/*                      ih264d_deadline_get_stats()                          */
+/*                                                                           */
+/*  Issues / Problems : None                                                 */
+/*                                                                           */
+/*****************************************************************************/
+
+#ifndef _IH264D_DEADLINE_H_
+#define _IH264D_DEADLINE_H_
+
+/* Decode calls measured at a level before it may change again */
+#define DEADLINE_HOLD_CALLS 4
+
+/* Running averages weigh the last sample by 1 / (1 << DEADLINE_AVG_SHIFT) */
+#define DEADLINE_AVG_SHIFT 2
+
+/* A level is relaxed once the average is under this share of the */
+/* deadline, in percent                                            */
+#define DEADLINE_RELAX_PCT 75
+
+void ih264d_deadline_reset(dec_struct_t *ps_dec);
+
+void ih264d_deadline_set(dec_struct_t *ps_dec, UWORD32 u4_deadline_us);
+
+void ih264d_deadline_start_call(dec_struct_t *ps_dec);
+
+void ih264d_deadline_end_call(dec_struct_t *ps_dec,
+                              ivd_video_decode_op_t *ps_dec_op);
+
+void ih264d_deadline_degrade_pic(dec_struct_t *ps_dec);
+
+WORD32 ih264d_deadline_drop_nal(dec_struct_t *ps_dec, UWORD8 *pu1_nal,
+                                WORD32 i4_nal_len);
+
+void ih264d_deadline_get_stats(dec_struct_t *ps_dec,
+                               ih264d_ctl_get_deadline_stats_op_t *ps_op);
+
+#endif /* _IH264D_DEADLINE_H_ */
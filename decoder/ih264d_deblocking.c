@@ -63,6 +63,9 @@
 #include "ih264d_format_conv.h"
 #include "ih264d_deblocking.h"
 #include "ih264d_tables.h"
+#include "ithread.h"
+#include "ih264d_perf_stats.h"
+#include "ih264d_trace.h"
 // extern UWORD8 *g_dest_y, *g_dest_uv;
 
 /*!
@@ -137,11 +140,11 @@ void ih264d_filter_boundary_left_nonmbaff(
 
   /* Chroma cb values */
   {
-    UWORD8 u1_mb_qp1, u1_mb_qp2;
-    u1_mb_qp1 = (ps_cur_mb->u1_left_mb_qp + i1_cb_qp_idx_ofst);
-    u1_mb_qp2 = (ps_cur_mb->u1_mb_qp + i1_cb_qp_idx_ofst);
-    qp_avg = (UWORD8) ((gau1_ih264d_qp_scale_cr[12 + u1_mb_qp1] +
-                        gau1_ih264d_qp_scale_cr[12 + u1_mb_qp2] + 1) >>
+    WORD32 i4_mb_qp1, i4_mb_qp2;
+    i4_mb_qp1 = (ps_cur_mb->u1_left_mb_qp + i1_cb_qp_idx_ofst);
+    i4_mb_qp2 = (ps_cur_mb->u1_mb_qp + i1_cb_qp_idx_ofst);
+    qp_avg = (UWORD8) ((gau1_ih264d_qp_scale_cr[12 + i4_mb_qp1] +
+                        gau1_ih264d_qp_scale_cr[12 + i4_mb_qp2] + 1) >>
                        1);
   }
   idx_a_u = qp_avg + ofst_a;
@@ -150,11 +153,11 @@ void ih264d_filter_boundary_left_nonmbaff(
   beta_u = gau1_ih264d_beta_table[12 + idx_b_u];
   /* Chroma cr values */
   {
-    UWORD8 u1_mb_qp1, u1_mb_qp2;
-    u1_mb_qp1 = (ps_cur_mb->u1_left_mb_qp + i1_cr_qp_idx_ofst);
-    u1_mb_qp2 = (ps_cur_mb->u1_mb_qp + i1_cr_qp_idx_ofst);
-    qp_avg = (UWORD8) ((gau1_ih264d_qp_scale_cr[12 + u1_mb_qp1] +
-                        gau1_ih264d_qp_scale_cr[12 + u1_mb_qp2] + 1) >>
+    WORD32 i4_mb_qp1, i4_mb_qp2;
+    i4_mb_qp1 = (ps_cur_mb->u1_left_mb_qp + i1_cr_qp_idx_ofst);
+    i4_mb_qp2 = (ps_cur_mb->u1_mb_qp + i1_cr_qp_idx_ofst);
+    qp_avg = (UWORD8) ((gau1_ih264d_qp_scale_cr[12 + i4_mb_qp1] +
+                        gau1_ih264d_qp_scale_cr[12 + i4_mb_qp2] + 1) >>
                        1);
   }
   idx_a_v = qp_avg + ofst_a;
@@ -221,11 +224,11 @@ void ih264d_filter_boundary_left_nonmbaff(
     u4_bs_val = pu4_bs_tab[9];
 
     {
-      UWORD8 u1_mb_qp1, u1_mb_qp2;
-      u1_mb_qp1 = ((ps_left_mb + 1)->u1_mb_qp + i1_cb_qp_idx_ofst);
-      u1_mb_qp2 = (ps_cur_mb->u1_mb_qp + i1_cb_qp_idx_ofst);
-      qp_avg = (UWORD8) ((gau1_ih264d_qp_scale_cr[12 + u1_mb_qp1] +
-                          gau1_ih264d_qp_scale_cr[12 + u1_mb_qp2] + 1) >>
+      WORD32 i4_mb_qp1, i4_mb_qp2;
+      i4_mb_qp1 = ((ps_left_mb + 1)->u1_mb_qp + i1_cb_qp_idx_ofst);
+      i4_mb_qp2 = (ps_cur_mb->u1_mb_qp + i1_cb_qp_idx_ofst);
+      qp_avg = (UWORD8) ((gau1_ih264d_qp_scale_cr[12 + i4_mb_qp1] +
+                          gau1_ih264d_qp_scale_cr[12 + i4_mb_qp2] + 1) >>
                          1);
     }
     idx_a_u = qp_avg + ofst_a;
@@ -234,11 +237,11 @@ void ih264d_filter_boundary_left_nonmbaff(
     beta_u = gau1_ih264d_beta_table[12 + idx_b_u];
     u4_bs_val = pu4_bs_tab[9];
     {
-      UWORD8 u1_mb_qp1, u1_mb_qp2;
-      u1_mb_qp1 = ((ps_left_mb + 1)->u1_mb_qp + i1_cr_qp_idx_ofst);
-      u1_mb_qp2 = (ps_cur_mb->u1_mb_qp + i1_cr_qp_idx_ofst);
-      qp_avg = (UWORD8) ((gau1_ih264d_qp_scale_cr[12 + u1_mb_qp1] +
-                          gau1_ih264d_qp_scale_cr[12 + u1_mb_qp2] + 1) >>
+      WORD32 i4_mb_qp1, i4_mb_qp2;
+      i4_mb_qp1 = ((ps_left_mb + 1)->u1_mb_qp + i1_cr_qp_idx_ofst);
+      i4_mb_qp2 = (ps_cur_mb->u1_mb_qp + i1_cr_qp_idx_ofst);
+      qp_avg = (UWORD8) ((gau1_ih264d_qp_scale_cr[12 + i4_mb_qp1] +
+                          gau1_ih264d_qp_scale_cr[12 + i4_mb_qp2] + 1) >>
                          1);
     }
     idx_a_v = qp_avg + ofst_a;
@@ -308,11 +311,11 @@ void ih264d_filter_boundary_top_nonmbaff(
 
   /* CHROMA cb values */
   {
-    UWORD8 u1_mb_qp1, u1_mb_qp2;
-    u1_mb_qp1 = (ps_cur_mb->u1_topmb_qp + i1_cb_qp_idx_ofst);
-    u1_mb_qp2 = (ps_cur_mb->u1_mb_qp + i1_cb_qp_idx_ofst);
-    qp_avg = (UWORD8) ((gau1_ih264d_qp_scale_cr[12 + u1_mb_qp1] +
-                        gau1_ih264d_qp_scale_cr[12 + u1_mb_qp2] + 1) >>
+    WORD32 i4_mb_qp1, i4_mb_qp2;
+    i4_mb_qp1 = (ps_cur_mb->u1_topmb_qp + i1_cb_qp_idx_ofst);
+    i4_mb_qp2 = (ps_cur_mb->u1_mb_qp + i1_cb_qp_idx_ofst);
+    qp_avg = (UWORD8) ((gau1_ih264d_qp_scale_cr[12 + i4_mb_qp1] +
+                        gau1_ih264d_qp_scale_cr[12 + i4_mb_qp2] + 1) >>
                        1);
   }
 
@@ -322,11 +325,11 @@ void ih264d_filter_boundary_top_nonmbaff(
   beta_u = gau1_ih264d_beta_table[12 + idx_b_u];
   /* CHROMA cr values */
   {
-    UWORD8 u1_mb_qp1, u1_mb_qp2;
-    u1_mb_qp1 = (ps_cur_mb->u1_topmb_qp + i1_cr_qp_idx_ofst);
-    u1_mb_qp2 = (ps_cur_mb->u1_mb_qp + i1_cr_qp_idx_ofst);
-    qp_avg = (UWORD8) ((gau1_ih264d_qp_scale_cr[12 + u1_mb_qp1] +
-                        gau1_ih264d_qp_scale_cr[12 + u1_mb_qp2] + 1) >>
+    WORD32 i4_mb_qp1, i4_mb_qp2;
+    i4_mb_qp1 = (ps_cur_mb->u1_topmb_qp + i1_cr_qp_idx_ofst);
+    i4_mb_qp2 = (ps_cur_mb->u1_mb_qp + i1_cr_qp_idx_ofst);
+    qp_avg = (UWORD8) ((gau1_ih264d_qp_scale_cr[12 + i4_mb_qp1] +
+                        gau1_ih264d_qp_scale_cr[12 + i4_mb_qp2] + 1) >>
                        1);
   }
 
@@ -503,6 +506,109 @@ void ih264d_deblock_mb_nonmbaff(dec_struct_t *ps_dec, tfr_ctxt_t *ps_tfr_cxt,
   }
 }
 
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264d_deblk_row_nonmbaff                                */
+/*                                                                           */
+/*  Description   : Deblocks a run of MBs of a row without MBAFF using the   */
+/*                  edge filters. For each MB the vertical edges are         */
+/*                  filtered before the horizontal edges                     */
+/*                                                                           */
+/*  Inputs        : ps_dec     - decoder context                             */
+/*                  pu1_y      - luma of the first MB                        */
+/*                  pu1_uv     - interleaved chroma of the first MB          */
+/*                  i4_strd_y  - luma stride                                 */
+/*                  i4_strd_uv - chroma stride                               */
+/*                  ps_row_mb  - filter parameters of the MBs                */
+/*                  i4_num_mbs - number of MBs                               */
+/*                                                                           */
+/*****************************************************************************/
+void ih264d_deblk_row_nonmbaff(dec_struct_t *ps_dec, UWORD8 *pu1_y,
+                               UWORD8 *pu1_uv, WORD32 i4_strd_y,
+                               WORD32 i4_strd_uv, deblk_row_mb_t *ps_row_mb,
+                               WORD32 i4_num_mbs) {
+  WORD32 i, edge;
+
+  for (i = 0; i < i4_num_mbs; i++, ps_row_mb++) {
+    UWORD32 *pu4_bs = ps_row_mb->au4_bs;
+    UWORD8 *pu1_alpha, *pu1_beta;
+    const UWORD8 **ppu1_cliptab;
+
+    /* Left edge */
+    pu1_alpha = ps_row_mb->au1_alpha[DEBLK_EDGE_LEFT];
+    pu1_beta = ps_row_mb->au1_beta[DEBLK_EDGE_LEFT];
+    ppu1_cliptab = ps_row_mb->apu1_cliptab[DEBLK_EDGE_LEFT];
+    if (0x04040404 == pu4_bs[4]) {
+      ps_dec->pf_deblk_luma_vert_bs4(pu1_y, i4_strd_y, pu1_alpha[0],
+                                     pu1_beta[0]);
+      ps_dec->pf_deblk_chroma_vert_bs4(pu1_uv, i4_strd_uv, pu1_alpha[1],
+                                       pu1_beta[1], pu1_alpha[2], pu1_beta[2]);
+    } else if (pu4_bs[4]) {
+      ps_dec->pf_deblk_luma_vert_bslt4(pu1_y, i4_strd_y, pu1_alpha[0],
+                                       pu1_beta[0], pu4_bs[4],
+                                       ppu1_cliptab[0]);
+      ps_dec->pf_deblk_chroma_vert_bslt4(
+          pu1_uv, i4_strd_uv, pu1_alpha[1], pu1_beta[1], pu1_alpha[2],
+          pu1_beta[2], pu4_bs[4], ppu1_cliptab[1], ppu1_cliptab[2]);
+    }
+
+    /* Other vertical edges */
+    pu1_alpha = ps_row_mb->au1_alpha[DEBLK_EDGE_INNER];
+    pu1_beta = ps_row_mb->au1_beta[DEBLK_EDGE_INNER];
+    ppu1_cliptab = ps_row_mb->apu1_cliptab[DEBLK_EDGE_INNER];
+    for (edge = 1; edge < 4; edge++) {
+      if (!pu4_bs[4 + edge]) continue;
+
+      ps_dec->pf_deblk_luma_vert_bslt4(pu1_y + (edge << 2), i4_strd_y,
+                                       pu1_alpha[0], pu1_beta[0],
+                                       pu4_bs[4 + edge], ppu1_cliptab[0]);
+      if (2 == edge)
+        ps_dec->pf_deblk_chroma_vert_bslt4(
+            pu1_uv + 4 * YUV420SP_FACTOR, i4_strd_uv, pu1_alpha[1],
+            pu1_beta[1], pu1_alpha[2], pu1_beta[2], pu4_bs[6],
+            ppu1_cliptab[1], ppu1_cliptab[2]);
+    }
+
+    /* Top edge */
+    pu1_alpha = ps_row_mb->au1_alpha[DEBLK_EDGE_TOP];
+    pu1_beta = ps_row_mb->au1_beta[DEBLK_EDGE_TOP];
+    ppu1_cliptab = ps_row_mb->apu1_cliptab[DEBLK_EDGE_TOP];
+    if (0x04040404 == pu4_bs[0]) {
+      ps_dec->pf_deblk_luma_horz_bs4(pu1_y, i4_strd_y, pu1_alpha[0],
+                                     pu1_beta[0]);
+      ps_dec->pf_deblk_chroma_horz_bs4(pu1_uv, i4_strd_uv, pu1_alpha[1],
+                                       pu1_beta[1], pu1_alpha[2], pu1_beta[2]);
+    } else if (pu4_bs[0]) {
+      ps_dec->pf_deblk_luma_horz_bslt4(pu1_y, i4_strd_y, pu1_alpha[0],
+                                       pu1_beta[0], pu4_bs[0],
+                                       ppu1_cliptab[0]);
+      ps_dec->pf_deblk_chroma_horz_bslt4(
+          pu1_uv, i4_strd_uv, pu1_alpha[1], pu1_beta[1], pu1_alpha[2],
+          pu1_beta[2], pu4_bs[0], ppu1_cliptab[1], ppu1_cliptab[2]);
+    }
+
+    /* Other horizontal edges */
+    pu1_alpha = ps_row_mb->au1_alpha[DEBLK_EDGE_INNER];
+    pu1_beta = ps_row_mb->au1_beta[DEBLK_EDGE_INNER];
+    ppu1_cliptab = ps_row_mb->apu1_cliptab[DEBLK_EDGE_INNER];
+    for (edge = 1; edge < 4; edge++) {
+      if (!pu4_bs[edge]) continue;
+
+      ps_dec->pf_deblk_luma_horz_bslt4(pu1_y + edge * (i4_strd_y << 2),
+                                       i4_strd_y, pu1_alpha[0], pu1_beta[0],
+                                       pu4_bs[edge], ppu1_cliptab[0]);
+      if (2 == edge)
+        ps_dec->pf_deblk_chroma_horz_bslt4(
+            pu1_uv + (i4_strd_uv << 2), i4_strd_uv, pu1_alpha[1],
+            pu1_beta[1], pu1_alpha[2], pu1_beta[2], pu4_bs[2],
+            ppu1_cliptab[1], ppu1_cliptab[2]);
+    }
+
+    pu1_y += MB_SIZE;
+    pu1_uv += BLK8x8SIZE * YUV420SP_FACTOR;
+  }
+}
+
 /**************************************************************************
  *
  *  Function Name : ih264d_init_deblk_tfr_ctxt
@@ -538,8 +644,9 @@ void ih264d_init_deblk_tfr_ctxt(dec_struct_t *ps_dec, pad_mgr_t *ps_pad_mgr,
   ps_tfr_cxt->u4_uv_inc =
       (i4_wd_uv << u1_mbaff) * 8 - (ps_dec->u2_frm_wd_in_mbs << 4);
 
-  /* padding related initialisations */
-  if (ps_dec->ps_cur_slice->u1_nal_ref_idc) {
+  /* padding related initialisations, only pictures that can be inter */
+  /* predicted from need the border                                   */
+  if (ps_dec->ps_cur_slice->u1_nal_ref_idc && !ps_dec->u1_intra_only) {
     ps_pad_mgr->u1_vert_pad_top = !(ps_dec->ps_cur_slice->u1_field_pic_flag &&
                                     ps_dec->ps_cur_slice->u1_bottom_field_flag);
     ps_pad_mgr->u1_vert_pad_bot = ((!ps_dec->ps_cur_slice->u1_field_pic_flag) ||
@@ -552,6 +659,574 @@ void ih264d_init_deblk_tfr_ctxt(dec_struct_t *ps_dec, pad_mgr_t *ps_pad_mgr,
   }
 }
 
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264d_check_deblk_top_row                               */
+/*                                                                           */
+/*  Description   : Checks if the row above the current MB (MB pair for      */
+/*                  MBAFF) is deblocked upto the top right unit, by the      */
+/*                  worker handling that row                                 */
+/*                                                                           */
+/*  Inputs        : ps_dec   - decoder context                               */
+/*                  u4_x     - horizontal position of the current unit       */
+/*                  u4_y     - row of the current unit                       */
+/*                                                                           */
+/*  Returns       : 1 if the current unit can be deblocked, 0 otherwise      */
+/*                                                                           */
+/*****************************************************************************/
+UWORD32 ih264d_check_deblk_top_row(dec_struct_t *ps_dec, UWORD32 u4_x,
+                                   UWORD32 u4_y) {
+  UWORD32 u4_num_workers = ps_dec->u4_num_deblk_workers;
+  UWORD32 u4_wd = ps_dec->u2_frm_wd_in_mbs;
+  deblk_worker_ctxt_t *ps_top_worker;
+
+  if ((u4_num_workers <= 1) || (0 == u4_y)) return 1;
+
+  ps_top_worker = &ps_dec->as_deblk_worker[(u4_y - 1) % u4_num_workers];
+
+  /* Left edge of the top right unit modifies the top unit */
+  return (ps_top_worker->u4_deblk_num >=
+          (u4_y - 1) * u4_wd + MIN(u4_x + 2, u4_wd));
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264d_set_deblk_edge_params                             */
+/*                                                                           */
+/*  Description   : Sets alpha, beta and tc0 table of Y, Cb and Cr for an    */
+/*                  edge type of a MB from the qps across the edge           */
+/*                                                                           */
+/*  Inputs        : ps_row_mb         - filter parameters of the MB          */
+/*                  u4_edge           - edge type                            */
+/*                  i4_qp_p           - qp of the MB on the p side           */
+/*                  i4_qp_q           - qp of the MB on the q side           */
+/*                  ps_cur_mb         - deblocking info of the MB            */
+/*                  i1_cb_qp_idx_ofst - Cb qp offset                         */
+/*                  i1_cr_qp_idx_ofst - Cr qp offset                         */
+/*                                                                           */
+/*****************************************************************************/
+static void ih264d_set_deblk_edge_params(deblk_row_mb_t *ps_row_mb,
+                                         UWORD32 u4_edge, WORD32 i4_qp_p,
+                                         WORD32 i4_qp_q, deblk_mb_t *ps_cur_mb,
+                                         WORD8 i1_cb_qp_idx_ofst,
+                                         WORD8 i1_cr_qp_idx_ofst) {
+  WORD32 ofst_a = ps_cur_mb->i1_slice_alpha_c0_offset;
+  WORD32 ofst_b = ps_cur_mb->i1_slice_beta_offset;
+  WORD32 ai4_qp_avg[3];
+  WORD32 i;
+
+  /* Deblock rounding change */
+  ai4_qp_avg[0] = (i4_qp_p + i4_qp_q + 1) >> 1;
+  ai4_qp_avg[1] = (gau1_ih264d_qp_scale_cr[12 + i4_qp_p + i1_cb_qp_idx_ofst] +
+                   gau1_ih264d_qp_scale_cr[12 + i4_qp_q + i1_cb_qp_idx_ofst] +
+                   1) >>
+                  1;
+  ai4_qp_avg[2] = (gau1_ih264d_qp_scale_cr[12 + i4_qp_p + i1_cr_qp_idx_ofst] +
+                   gau1_ih264d_qp_scale_cr[12 + i4_qp_q + i1_cr_qp_idx_ofst] +
+                   1) >>
+                  1;
+
+  for (i = 0; i < 3; i++) {
+    WORD32 idx_a = ai4_qp_avg[i] + ofst_a;
+    WORD32 idx_b = ai4_qp_avg[i] + ofst_b;
+
+    ps_row_mb->au1_alpha[u4_edge][i] = gau1_ih264d_alpha_table[12 + idx_a];
+    ps_row_mb->au1_beta[u4_edge][i] = gau1_ih264d_beta_table[12 + idx_b];
+    ps_row_mb->apu1_cliptab[u4_edge][i] =
+        (const UWORD8 *) &gau1_ih264d_clip_table[12 + idx_a];
+  }
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264d_fill_deblk_row_mb                                 */
+/*                                                                           */
+/*  Description   : Fills the filter parameters of a MB without MBAFF for    */
+/*                  the row deblocking. Edges which are not to be filtered   */
+/*                  get a Bs of zero                                         */
+/*                                                                           */
+/*  Inputs        : ps_row_mb         - filter parameters to be filled       */
+/*                  ps_cur_mb         - deblocking info of the MB            */
+/*                  u4_left           - left edge is inside the picture      */
+/*                  u4_top            - top edge is inside the picture       */
+/*                  i1_cb_qp_idx_ofst - Cb qp offset                         */
+/*                  i1_cr_qp_idx_ofst - Cr qp offset                         */
+/*                                                                           */
+/*****************************************************************************/
+static void ih264d_fill_deblk_row_mb(deblk_row_mb_t *ps_row_mb,
+                                     deblk_mb_t *ps_cur_mb, UWORD32 u4_left,
+                                     UWORD32 u4_top, WORD8 i1_cb_qp_idx_ofst,
+                                     WORD8 i1_cr_qp_idx_ofst) {
+  UWORD8 u1_deb_mode = ps_cur_mb->u1_deblocking_mode;
+  UWORD32 *pu4_bs = ps_row_mb->au4_bs;
+
+  if (u1_deb_mode & MB_DISABLE_FILTERING) {
+    memset(pu4_bs, 0, sizeof(ps_row_mb->au4_bs));
+    return;
+  }
+
+  memcpy(pu4_bs, ps_cur_mb->u4_bs_table, sizeof(ps_row_mb->au4_bs));
+  if (!u4_left || (u1_deb_mode & MB_DISABLE_LEFT_EDGE)) pu4_bs[4] = 0;
+  if (!u4_top || (u1_deb_mode & MB_DISABLE_TOP_EDGE)) pu4_bs[0] = 0;
+
+  if (pu4_bs[4])
+    ih264d_set_deblk_edge_params(ps_row_mb, DEBLK_EDGE_LEFT,
+                                 ps_cur_mb->u1_left_mb_qp, ps_cur_mb->u1_mb_qp,
+                                 ps_cur_mb, i1_cb_qp_idx_ofst,
+                                 i1_cr_qp_idx_ofst);
+  if (pu4_bs[0])
+    ih264d_set_deblk_edge_params(ps_row_mb, DEBLK_EDGE_TOP,
+                                 ps_cur_mb->u1_topmb_qp, ps_cur_mb->u1_mb_qp,
+                                 ps_cur_mb, i1_cb_qp_idx_ofst,
+                                 i1_cr_qp_idx_ofst);
+  if (pu4_bs[1] | pu4_bs[2] | pu4_bs[3] | pu4_bs[5] | pu4_bs[6] | pu4_bs[7])
+    ih264d_set_deblk_edge_params(ps_row_mb, DEBLK_EDGE_INNER,
+                                 ps_cur_mb->u1_mb_qp, ps_cur_mb->u1_mb_qp,
+                                 ps_cur_mb, i1_cb_qp_idx_ofst,
+                                 i1_cr_qp_idx_ofst);
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264d_deblock_row_non_mbaff                             */
+/*                                                                           */
+/*  Description   : Deblocks one MB row of a picture without MBAFF, in runs  */
+/*                  of DEBLK_ROW_MBS MBs handed to the row deblocking        */
+/*                                                                           */
+/*  Inputs        : ps_dec     - decoder context                             */
+/*                  ps_tfr_cxt - transfer context pointing to the row start  */
+/*                  u4_mb_y    - MB row                                      */
+/*                  ps_worker  - worker handling the row                     */
+/*                                                                           */
+/*****************************************************************************/
+static void ih264d_deblock_row_non_mbaff(dec_struct_t *ps_dec,
+                                         tfr_ctxt_t *ps_tfr_cxt,
+                                         UWORD32 u4_mb_y,
+                                         deblk_worker_ctxt_t *ps_worker) {
+  deblk_row_mb_t as_row_mb[DEBLK_ROW_MBS];
+  UWORD32 u4_mb_x, u4_num_mbs, i;
+  deblk_mb_t *ps_cur_mb;
+  WORD32 i4_wd_y, i4_wd_uv;
+
+  UWORD8 u1_field_pic_flag = ps_dec->ps_cur_slice->u1_field_pic_flag;
+  UWORD32 u4_image_wd_mb = ps_dec->u2_frm_wd_in_mbs;
+  UWORD32 u4_num_workers = ps_dec->u4_num_deblk_workers;
+  WORD8 i1_cb_qp_idx_ofst = ps_dec->ps_cur_pps->i1_chroma_qp_index_offset;
+  WORD8 i1_cr_qp_idx_ofst =
+      ps_dec->ps_cur_pps->i1_second_chroma_qp_index_offset;
+  const UWORD32 u4_perf_slot =
+      PERF_DEBLK_SLOT(ps_worker->u4_id, PERF_SLOT_MAIN);
+
+  i4_wd_y = ps_dec->u2_frm_wd_y << u1_field_pic_flag;
+  i4_wd_uv = ps_dec->u2_frm_wd_uv << u1_field_pic_flag;
+  ps_cur_mb = ps_dec->ps_deblk_pic + u4_mb_y * u4_image_wd_mb;
+
+  for (u4_mb_x = 0; u4_mb_x < u4_image_wd_mb; u4_mb_x += u4_num_mbs) {
+    u4_num_mbs = MIN(DEBLK_ROW_MBS, u4_image_wd_mb - u4_mb_x);
+
+    PERF_STAGE_BEGIN(ps_dec, u4_perf_slot, IH264D_PERF_STAGE_DEBLK);
+    for (i = 0; i < u4_num_mbs; i++, ps_cur_mb++)
+      ih264d_fill_deblk_row_mb(&as_row_mb[i], ps_cur_mb, u4_mb_x + i, u4_mb_y,
+                               i1_cb_qp_idx_ofst, i1_cr_qp_idx_ofst);
+
+    PERF_STAGE_END(ps_dec, u4_perf_slot, IH264D_PERF_STAGE_DEBLK);
+
+    if (u4_num_workers > 1) {
+      while (!ih264d_check_deblk_top_row(ps_dec, u4_mb_x + u4_num_mbs - 1,
+                                         u4_mb_y))
+        PERF_NOP(ps_dec, u4_perf_slot, 32);
+      TRACE_WAIT_END(ps_dec, u4_perf_slot);
+    }
+
+    PERF_STAGE_BEGIN(ps_dec, u4_perf_slot, IH264D_PERF_STAGE_DEBLK);
+    ps_dec->pf_deblk_row_nonmbaff(ps_dec, ps_tfr_cxt->pu1_mb_y,
+                                  ps_tfr_cxt->pu1_mb_u, i4_wd_y, i4_wd_uv,
+                                  as_row_mb, u4_num_mbs);
+    PERF_STAGE_END(ps_dec, u4_perf_slot, IH264D_PERF_STAGE_DEBLK);
+
+    ps_tfr_cxt->pu1_mb_y += u4_num_mbs << 4;
+    ps_tfr_cxt->pu1_mb_u += (u4_num_mbs << 3) * YUV420SP_FACTOR;
+    ps_tfr_cxt->pu1_mb_v += u4_num_mbs << 3;
+
+    if (u4_num_workers > 1) {
+      DATA_SYNC();
+      ps_worker->u4_deblk_num =
+          u4_mb_y * u4_image_wd_mb + u4_mb_x + u4_num_mbs;
+    }
+  }
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264d_deblock_row_mbaff                                 */
+/*                                                                           */
+/*  Description   : Deblocks one MB pair row of a picture with MBAFF         */
+/*                                                                           */
+/*  Inputs        : ps_dec     - decoder context                             */
+/*                  ps_tfr_cxt - transfer context pointing to the row start  */
+/*                  u4_mb_y    - MB pair row                                 */
+/*                  ps_worker  - worker handling the row                     */
+/*                                                                           */
+/*****************************************************************************/
+static void ih264d_deblock_row_mbaff(dec_struct_t *ps_dec,
+                                     tfr_ctxt_t *ps_tfr_cxt, UWORD32 u4_mb_y,
+                                     deblk_worker_ctxt_t *ps_worker) {
+  UWORD32 u4_mb_x;
+  deblk_mb_t *ps_cur_mb;
+  deblk_mb_t *ps_top_mb;
+  deblk_mb_t *ps_left_mb;
+
+  UWORD8 u1_cur_fld, u1_top_fld, u1_left_fld;
+  UWORD8 u1_first_row = (0 == u4_mb_y);
+
+  UWORD8 *pu1_deb_y, *pu1_deb_u, *pu1_deb_v;
+  UWORD8 u1_deb_mode, u1_extra_top_edge;
+  WORD32 i4_wd_y, i4_wd_uv;
+
+  UWORD8 u1_field_pic_flag = ps_dec->ps_cur_slice->u1_field_pic_flag;
+  UWORD32 u4_image_wd_mb = ps_dec->u2_frm_wd_in_mbs;
+  UWORD32 u4_num_workers = ps_dec->u4_num_deblk_workers;
+  WORD8 i1_cb_qp_idx_ofst = ps_dec->ps_cur_pps->i1_chroma_qp_index_offset;
+  WORD8 i1_cr_qp_idx_ofst =
+      ps_dec->ps_cur_pps->i1_second_chroma_qp_index_offset;
+  const UWORD32 u4_perf_slot =
+      PERF_DEBLK_SLOT(ps_worker->u4_id, PERF_SLOT_MAIN);
+
+  i4_wd_y = ps_dec->u2_frm_wd_y << u1_field_pic_flag;
+  i4_wd_uv = ps_dec->u2_frm_wd_uv << u1_field_pic_flag;
+
+  pu1_deb_y = ps_tfr_cxt->pu1_mb_y;
+  pu1_deb_u = ps_tfr_cxt->pu1_mb_u;
+  pu1_deb_v = ps_tfr_cxt->pu1_mb_v;
+  ps_cur_mb = ps_dec->ps_deblk_pic + ((u4_mb_y * u4_image_wd_mb) << 1);
+
+  for (u4_mb_x = 0; u4_mb_x < u4_image_wd_mb; u4_mb_x++) {
+    if (u4_num_workers > 1) {
+      while (!ih264d_check_deblk_top_row(ps_dec, u4_mb_x, u4_mb_y))
+        PERF_NOP(ps_dec, u4_perf_slot, 32);
+      TRACE_WAIT_END(ps_dec, u4_perf_slot);
+    }
+
+    PERF_STAGE_BEGIN(ps_dec, u4_perf_slot, IH264D_PERF_STAGE_DEBLK);
+
+    u1_deb_mode = ps_cur_mb->u1_deblocking_mode;
+    if (!(u1_deb_mode & MB_DISABLE_FILTERING)) {
+      ps_tfr_cxt->pu1_mb_y = pu1_deb_y;
+      ps_tfr_cxt->pu1_mb_u = pu1_deb_u;
+      ps_tfr_cxt->pu1_mb_v = pu1_deb_v;
+
+      u1_cur_fld = (ps_cur_mb->u1_mb_type & D_FLD_MB) >> 7;
+      u1_cur_fld &= 1;
+      if (u4_mb_x) {
+        ps_left_mb = ps_cur_mb - 2;
+      } else {
+        ps_left_mb = NULL;
+      }
+      if (!u1_first_row) {
+        ps_top_mb = ps_cur_mb - (u4_image_wd_mb << 1) + 1;
+        u1_top_fld = (ps_top_mb->u1_mb_type & D_FLD_MB) >> 7;
+      } else {
+        ps_top_mb = NULL;
+        u1_top_fld = 0;
+      }
+
+      if ((!u1_first_row) & u1_top_fld & u1_cur_fld) ps_top_mb--;
+
+      /********************************************************/
+      /* if top MB and MB AFF and cur MB is frame and top is  */
+      /* field, then one extra top edge needs to be deblocked */
+      /********************************************************/
+      u1_extra_top_edge = (!u1_cur_fld) & u1_top_fld;
+
+      if (u1_deb_mode & MB_DISABLE_LEFT_EDGE) ps_left_mb = NULL;
+      if (u1_deb_mode & MB_DISABLE_TOP_EDGE) ps_top_mb = NULL;
+
+      ih264d_deblock_mb_mbaff(ps_dec, ps_tfr_cxt, i1_cb_qp_idx_ofst,
+                              i1_cr_qp_idx_ofst, ps_cur_mb, i4_wd_y, i4_wd_uv,
+                              ps_top_mb, ps_left_mb, u1_cur_fld,
+                              u1_extra_top_edge);
+    }
+
+    ps_cur_mb++;
+
+    u1_deb_mode = ps_cur_mb->u1_deblocking_mode;
+    if (!(u1_deb_mode & MB_DISABLE_FILTERING)) {
+      ps_tfr_cxt->pu1_mb_y = pu1_deb_y;
+      ps_tfr_cxt->pu1_mb_u = pu1_deb_u;
+      ps_tfr_cxt->pu1_mb_v = pu1_deb_v;
+
+      u1_cur_fld = (ps_cur_mb->u1_mb_type & D_FLD_MB) >> 7;
+      u1_cur_fld &= 1;
+      if (u4_mb_x) {
+        ps_left_mb = ps_cur_mb - 2;
+        u1_left_fld = (ps_left_mb->u1_mb_type & D_FLD_MB) >> 7;
+      } else {
+        ps_left_mb = NULL;
+        u1_left_fld = u1_cur_fld;
+      }
+      if (!u1_first_row) {
+        ps_top_mb = ps_cur_mb - (u4_image_wd_mb << 1);
+      } else {
+        ps_top_mb = NULL;
+      }
+
+      {
+        UWORD8 u1_row_shift_y = 0, u1_row_shift_uv = 0;
+        if (!u1_cur_fld) {
+          ps_top_mb = ps_cur_mb - 1;
+          u1_top_fld = (ps_top_mb->u1_mb_type & D_FLD_MB) >> 7;
+          u1_row_shift_y = 4;
+          u1_row_shift_uv = 3;
+        }
+        ps_tfr_cxt->pu1_mb_y += i4_wd_y << u1_row_shift_y;
+        ps_tfr_cxt->pu1_mb_u += (i4_wd_uv << u1_row_shift_uv);
+        ps_tfr_cxt->pu1_mb_v += i4_wd_uv << u1_row_shift_uv;
+      }
+
+      /* point to A if top else A+1 */
+      if (u1_left_fld ^ u1_cur_fld) ps_left_mb--;
+
+      /********************************************************/
+      /* if top MB and MB AFF and cur MB is frame and top is  */
+      /* field, then one extra top edge needs to be deblocked */
+      /********************************************************/
+      u1_extra_top_edge = 0;
+
+      if (u1_deb_mode & MB_DISABLE_LEFT_EDGE) ps_left_mb = NULL;
+      if (u1_deb_mode & MB_DISABLE_TOP_EDGE) ps_top_mb = NULL;
+
+      ih264d_deblock_mb_mbaff(ps_dec, ps_tfr_cxt, i1_cb_qp_idx_ofst,
+                              i1_cr_qp_idx_ofst, ps_cur_mb, i4_wd_y, i4_wd_uv,
+                              ps_top_mb, ps_left_mb, u1_cur_fld,
+                              u1_extra_top_edge);
+    }
+
+    ps_cur_mb++;
+
+    pu1_deb_y += 16;
+    pu1_deb_u += 8 * YUV420SP_FACTOR;
+    pu1_deb_v += 8;
+    PERF_STAGE_END(ps_dec, u4_perf_slot, IH264D_PERF_STAGE_DEBLK);
+
+    if (u4_num_workers > 1) {
+      DATA_SYNC();
+      ps_worker->u4_deblk_num = u4_mb_y * u4_image_wd_mb + u4_mb_x + 1;
+    }
+  }
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264d_deblock_picture_worker                            */
+/*                                                                           */
+/*  Description   : Deblocks the MB (pair) rows of the picture handled by a  */
+/*                  worker. A row is deblocked lagging two units behind the  */
+/*                  row above, which is handled by the previous worker       */
+/*                                                                           */
+/*  Inputs        : ps_worker - worker context                               */
+/*                                                                           */
+/*****************************************************************************/
+static void ih264d_deblock_picture_worker(deblk_worker_ctxt_t *ps_worker) {
+  dec_struct_t *ps_dec = (dec_struct_t *) ps_worker->pv_dec;
+  tfr_ctxt_t *ps_pic_tfr_cxt = ps_worker->ps_tfr_cxt;
+  tfr_ctxt_t s_tfr_ctxt;
+  UWORD8 u1_mbaff = ps_dec->ps_cur_slice->u1_mbaff_frame_flag;
+  UWORD32 u4_image_wd_mb = ps_dec->u2_frm_wd_in_mbs;
+  UWORD32 u4_num_rows = ps_dec->u2_frm_ht_in_mbs >> u1_mbaff;
+  UWORD32 u4_num_workers = ps_dec->u4_num_deblk_workers;
+  UWORD32 u4_row_strd_y, u4_row_strd_uv, u4_row_strd_v;
+  UWORD32 u4_mb_y;
+  const UWORD32 u4_perf_slot =
+      PERF_DEBLK_SLOT(ps_worker->u4_id, PERF_SLOT_MAIN);
+
+  s_tfr_ctxt = *ps_pic_tfr_cxt;
+  u4_row_strd_y = (u4_image_wd_mb << 4) + ps_pic_tfr_cxt->u4_y_inc;
+  u4_row_strd_uv = (u4_image_wd_mb << 4) + ps_pic_tfr_cxt->u4_uv_inc;
+  u4_row_strd_v = (u4_image_wd_mb << 3) + ps_pic_tfr_cxt->u4_uv_inc;
+
+  for (u4_mb_y = ps_worker->u4_id; u4_mb_y < u4_num_rows;
+       u4_mb_y += u4_num_workers) {
+    s_tfr_ctxt.pu1_mb_y =
+        ps_pic_tfr_cxt->pu1_src_y + 4 + u4_mb_y * u4_row_strd_y;
+    s_tfr_ctxt.pu1_mb_u =
+        ps_pic_tfr_cxt->pu1_src_u + 4 + u4_mb_y * u4_row_strd_uv;
+    s_tfr_ctxt.pu1_mb_v =
+        ps_pic_tfr_cxt->pu1_src_v + 4 + u4_mb_y * u4_row_strd_v;
+
+    TRACE_BEGIN(ps_dec, u4_perf_slot, IH264D_TRACE_DEBLK, u4_mb_y);
+    if (u1_mbaff)
+      ih264d_deblock_row_mbaff(ps_dec, &s_tfr_ctxt, u4_mb_y, ps_worker);
+    else
+      ih264d_deblock_row_non_mbaff(ps_dec, &s_tfr_ctxt, u4_mb_y, ps_worker);
+    TRACE_END(ps_dec, u4_perf_slot, IH264D_TRACE_DEBLK);
+  }
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264d_deblk_worker_park_thread                          */
+/*                                                                           */
+/*  Description   : Thread of a deblocking worker other than worker 0. The   */
+/*                  thread sleeps until a picture is dispatched to it, runs  */
+/*                  the deblocking of the picture and goes back to sleep,    */
+/*                  until it is asked to exit                                */
+/*                                                                           */
+/*  Inputs        : ps_worker - worker context                               */
+/*                                                                           */
+/*****************************************************************************/
+static void ih264d_deblk_worker_park_thread(deblk_worker_ctxt_t *ps_worker) {
+  ithread_set_name("ih264d_deblk_worker_thread");
+
+  while (1) {
+    ithread_mutex_lock(ps_worker->pv_park_mutex);
+    while ((0 == ps_worker->u4_job_pending) && (0 == ps_worker->u4_exit))
+      ithread_cond_wait(ps_worker->pv_park_cond, ps_worker->pv_park_mutex);
+    ithread_mutex_unlock(ps_worker->pv_park_mutex);
+
+    if (0 == ps_worker->u4_job_pending) break;
+
+    ps_worker->pf_job(ps_worker);
+
+    ithread_mutex_lock(ps_worker->pv_park_mutex);
+    ps_worker->u4_job_pending = 0;
+    ithread_cond_signal(ps_worker->pv_park_cond);
+    ithread_mutex_unlock(ps_worker->pv_park_mutex);
+  }
+
+  ithread_exit(0);
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264d_start_deblk_workers                               */
+/*                                                                           */
+/*  Description   : Dispatches the current picture to deblocking workers 1   */
+/*                  to (u4_num_deblk_workers - 1). The thread of a worker is */
+/*                  created the first time it is needed and is parked        */
+/*                  between pictures                                         */
+/*                                                                           */
+/*  Inputs        : ps_dec - decoder context                                 */
+/*                  pf_job - deblocking run by each worker                   */
+/*                                                                           */
+/*****************************************************************************/
+void ih264d_start_deblk_workers(dec_struct_t *ps_dec,
+                                void (*pf_job)(deblk_worker_ctxt_t *)) {
+  UWORD32 i;
+
+  for (i = 1; i < ps_dec->u4_num_deblk_workers; i++) {
+    deblk_worker_ctxt_t *ps_worker = &ps_dec->as_deblk_worker[i];
+
+    if (0 == ps_worker->u4_thread_created) {
+      ithread_mutex_init(ps_worker->pv_park_mutex);
+      ithread_cond_init(ps_worker->pv_park_cond);
+      ps_worker->u4_job_pending = 0;
+      ps_worker->u4_exit = 0;
+      ithread_create(ps_worker->pv_thread_handle, NULL,
+                     (void *) ih264d_deblk_worker_park_thread,
+                     (void *) ps_worker);
+      ps_worker->u4_thread_created = 1;
+    }
+
+    ithread_mutex_lock(ps_worker->pv_park_mutex);
+    ps_worker->pf_job = pf_job;
+    ps_worker->u4_job_pending = 1;
+    ithread_cond_signal(ps_worker->pv_park_cond);
+    ithread_mutex_unlock(ps_worker->pv_park_mutex);
+  }
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264d_wait_deblk_workers                                */
+/*                                                                           */
+/*  Description   : Waits until the workers started by                       */
+/*                  ih264d_start_deblk_workers are done with the picture     */
+/*                                                                           */
+/*  Inputs        : ps_dec - decoder context                                 */
+/*                                                                           */
+/*****************************************************************************/
+void ih264d_wait_deblk_workers(dec_struct_t *ps_dec) {
+  UWORD32 i;
+
+  for (i = 1; i < ps_dec->u4_num_deblk_workers; i++) {
+    deblk_worker_ctxt_t *ps_worker = &ps_dec->as_deblk_worker[i];
+
+    if (0 == ps_worker->u4_thread_created) continue;
+
+    ithread_mutex_lock(ps_worker->pv_park_mutex);
+    while (ps_worker->u4_job_pending)
+      ithread_cond_wait(ps_worker->pv_park_cond, ps_worker->pv_park_mutex);
+    ithread_mutex_unlock(ps_worker->pv_park_mutex);
+  }
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264d_stop_deblk_workers                                */
+/*                                                                           */
+/*  Description   : Makes the parked worker threads exit and joins them      */
+/*                                                                           */
+/*  Inputs        : ps_dec - decoder context                                 */
+/*                                                                           */
+/*****************************************************************************/
+void ih264d_stop_deblk_workers(dec_struct_t *ps_dec) {
+  UWORD32 i;
+
+  for (i = 1; i < MAX_DEBLK_WORKERS; i++) {
+    deblk_worker_ctxt_t *ps_worker = &ps_dec->as_deblk_worker[i];
+
+    if (0 == ps_worker->u4_thread_created) continue;
+
+    ithread_mutex_lock(ps_worker->pv_park_mutex);
+    ps_worker->u4_exit = 1;
+    ithread_cond_signal(ps_worker->pv_park_cond);
+    ithread_mutex_unlock(ps_worker->pv_park_mutex);
+
+    ithread_join(ps_worker->pv_thread_handle, NULL);
+    ithread_cond_destroy(ps_worker->pv_park_cond);
+    ithread_mutex_destroy(ps_worker->pv_park_mutex);
+    ps_worker->u4_thread_created = 0;
+  }
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264d_deblock_picture_rows                              */
+/*                                                                           */
+/*  Description   : Deblocks all the MB (pair) rows of the picture, split    */
+/*                  across the number of cores set by the application. The   */
+/*                  calling thread is worker 0                               */
+/*                                                                           */
+/*  Inputs        : ps_dec     - decoder context                             */
+/*                  ps_tfr_cxt - transfer context of the picture             */
+/*                                                                           */
+/*****************************************************************************/
+static void ih264d_deblock_picture_rows(dec_struct_t *ps_dec,
+                                        tfr_ctxt_t *ps_tfr_cxt) {
+  UWORD8 u1_mbaff = ps_dec->ps_cur_slice->u1_mbaff_frame_flag;
+  UWORD32 u4_num_rows = ps_dec->u2_frm_ht_in_mbs >> u1_mbaff;
+  UWORD32 i;
+
+  ps_dec->u4_num_deblk_workers =
+      MAX(1, MIN(ps_dec->u4_num_deblk_cores, u4_num_rows));
+
+  for (i = 0; i < ps_dec->u4_num_deblk_workers; i++) {
+    ps_dec->as_deblk_worker[i].ps_tfr_cxt = ps_tfr_cxt;
+    ps_dec->as_deblk_worker[i].u4_deblk_num = 0;
+  }
+  DATA_SYNC();
+
+  ih264d_start_deblk_workers(ps_dec, ih264d_deblock_picture_worker);
+
+  ih264d_deblock_picture_worker(&ps_dec->as_deblk_worker[0]);
+
+  PERF_STAGE_BEGIN(ps_dec, PERF_SLOT_MAIN, IH264D_PERF_STAGE_WAIT);
+  TRACE_BEGIN(ps_dec, PERF_SLOT_MAIN, IH264D_TRACE_WAIT, 0);
+  ih264d_wait_deblk_workers(ps_dec);
+  TRACE_END(ps_dec, PERF_SLOT_MAIN, IH264D_TRACE_WAIT);
+  PERF_STAGE_END(ps_dec, PERF_SLOT_MAIN, IH264D_PERF_STAGE_WAIT);
+}
+
 /*****************************************************************************/
 /*                                                                           */
 /*  Function Name : ih264d_deblock_picture_mbaff */
@@ -573,21 +1248,6 @@ void ih264d_init_deblk_tfr_ctxt(dec_struct_t *ps_dec, pad_mgr_t *ps_pad_mgr,
 /*****************************************************************************/
 
 void ih264d_deblock_picture_mbaff(dec_struct_t *ps_dec) {
-  WORD16 i2_mb_x, i2_mb_y;
-  deblk_mb_t *ps_cur_mb;
-  deblk_mb_t *ps_top_mb;
-  deblk_mb_t *ps_left_mb;
-
-  UWORD8 u1_cur_fld, u1_top_fld, u1_left_fld;
-  UWORD8 u1_first_row;
-
-  UWORD8 *pu1_deb_y, *pu1_deb_u, *pu1_deb_v;
-  UWORD8 u1_deb_mode, u1_extra_top_edge;
-  WORD32 i4_wd_y, i4_wd_uv;
-
-  UWORD8 u1_field_pic_flag =
-      ps_dec->ps_cur_slice->u1_field_pic_flag; /*< Field u4_flag */
-
   /**************************************************/
   /* one time loads from ps_dec which will be used  */
   /* frequently throughout the deblocking procedure */
@@ -597,146 +1257,15 @@ void ih264d_deblock_picture_mbaff(dec_struct_t *ps_dec) {
   tfr_ctxt_t *ps_tfr_cxt = &s_tfr_ctxt;
 
   UWORD16 u2_image_wd_mb = ps_dec->u2_frm_wd_in_mbs;
-  UWORD16 u2_image_ht_mb = ps_dec->u2_frm_ht_in_mbs;
   UWORD8 u1_mbaff = ps_dec->ps_cur_slice->u1_mbaff_frame_flag;
-  WORD8 i1_cb_qp_idx_ofst = ps_dec->ps_cur_pps->i1_chroma_qp_index_offset;
-  WORD8 i1_cr_qp_idx_ofst =
-      ps_dec->ps_cur_pps->i1_second_chroma_qp_index_offset;
 
   /* Set up Parameter for  DMA transfer */
   ih264d_init_deblk_tfr_ctxt(ps_dec, ps_pad_mgr, ps_tfr_cxt, u2_image_wd_mb,
                              u1_mbaff);
 
-  /* Pic level Initialisations */
-  i2_mb_y = u2_image_ht_mb;
-  i2_mb_x = 0;
-  u1_extra_top_edge = 0;
-
-  u1_first_row = 1;
-
-  i4_wd_y = ps_dec->u2_frm_wd_y << u1_field_pic_flag;
-  i4_wd_uv = ps_dec->u2_frm_wd_uv << u1_field_pic_flag;
-  /* Initial filling of the buffers with deblocking data */
-
-  pu1_deb_y = ps_tfr_cxt->pu1_src_y + 4;
-  pu1_deb_u = ps_tfr_cxt->pu1_src_u + 4;
-  pu1_deb_v = ps_tfr_cxt->pu1_src_v + 4;
-  ps_cur_mb = ps_dec->ps_deblk_pic;
-
   if (ps_dec->u4_app_disable_deblk_frm == 0) {
     if (ps_dec->u4_mb_level_deblk == 0 || ps_dec->u4_num_cores >= 3) {
-      while (i2_mb_y > 0) {
-        do {
-          u1_deb_mode = ps_cur_mb->u1_deblocking_mode;
-          if (!(u1_deb_mode & MB_DISABLE_FILTERING)) {
-            ps_tfr_cxt->pu1_mb_y = pu1_deb_y;
-            ps_tfr_cxt->pu1_mb_u = pu1_deb_u;
-            ps_tfr_cxt->pu1_mb_v = pu1_deb_v;
-
-            u1_cur_fld = (ps_cur_mb->u1_mb_type & D_FLD_MB) >> 7;
-            u1_cur_fld &= 1;
-            if (i2_mb_x) {
-              ps_left_mb = ps_cur_mb - 2;
-            } else {
-              ps_left_mb = NULL;
-            }
-            if (!u1_first_row) {
-              ps_top_mb = ps_cur_mb - (u2_image_wd_mb << 1) + 1;
-              u1_top_fld = (ps_top_mb->u1_mb_type & D_FLD_MB) >> 7;
-            } else {
-              ps_top_mb = NULL;
-              u1_top_fld = 0;
-            }
-
-            if ((!u1_first_row) & u1_top_fld & u1_cur_fld) ps_top_mb--;
-
-            /********************************************************/
-            /* if top MB and MB AFF and cur MB is frame and top is  */
-            /* field, then one extra top edge needs to be deblocked */
-            /********************************************************/
-            u1_extra_top_edge = (!u1_cur_fld) & u1_top_fld;
-
-            if (u1_deb_mode & MB_DISABLE_LEFT_EDGE) ps_left_mb = NULL;
-            if (u1_deb_mode & MB_DISABLE_TOP_EDGE) ps_top_mb = NULL;
-
-            ih264d_deblock_mb_mbaff(ps_dec, ps_tfr_cxt, i1_cb_qp_idx_ofst,
-                                    i1_cr_qp_idx_ofst, ps_cur_mb, i4_wd_y,
-                                    i4_wd_uv, ps_top_mb, ps_left_mb, u1_cur_fld,
-                                    u1_extra_top_edge);
-          }
-
-          ps_cur_mb++;
-
-          u1_deb_mode = ps_cur_mb->u1_deblocking_mode;
-          if (!(u1_deb_mode & MB_DISABLE_FILTERING)) {
-            ps_tfr_cxt->pu1_mb_y = pu1_deb_y;
-            ps_tfr_cxt->pu1_mb_u = pu1_deb_u;
-            ps_tfr_cxt->pu1_mb_v = pu1_deb_v;
-
-            u1_cur_fld = (ps_cur_mb->u1_mb_type & D_FLD_MB) >> 7;
-            u1_cur_fld &= 1;
-            if (i2_mb_x) {
-              ps_left_mb = ps_cur_mb - 2;
-              u1_left_fld = (ps_left_mb->u1_mb_type & D_FLD_MB) >> 7;
-            } else {
-              ps_left_mb = NULL;
-              u1_left_fld = u1_cur_fld;
-            }
-            if (!u1_first_row) {
-              ps_top_mb = ps_cur_mb - (u2_image_wd_mb << 1);
-            } else {
-              ps_top_mb = NULL;
-            }
-
-            {
-              UWORD8 u1_row_shift_y = 0, u1_row_shift_uv = 0;
-              if (!u1_cur_fld) {
-                ps_top_mb = ps_cur_mb - 1;
-                u1_top_fld = (ps_top_mb->u1_mb_type & D_FLD_MB) >> 7;
-                u1_row_shift_y = 4;
-                u1_row_shift_uv = 3;
-              }
-              ps_tfr_cxt->pu1_mb_y += i4_wd_y << u1_row_shift_y;
-              ps_tfr_cxt->pu1_mb_u += (i4_wd_uv << u1_row_shift_uv);
-              ps_tfr_cxt->pu1_mb_v += i4_wd_uv << u1_row_shift_uv;
-            }
-
-            /* point to A if top else A+1 */
-            if (u1_left_fld ^ u1_cur_fld) ps_left_mb--;
-
-            /********************************************************/
-            /* if top MB and MB AFF and cur MB is frame and top is  */
-            /* field, then one extra top edge needs to be deblocked */
-            /********************************************************/
-            u1_extra_top_edge = 0;
-
-            if (u1_deb_mode & MB_DISABLE_LEFT_EDGE) ps_left_mb = NULL;
-            if (u1_deb_mode & MB_DISABLE_TOP_EDGE) ps_top_mb = NULL;
-
-            ih264d_deblock_mb_mbaff(ps_dec, ps_tfr_cxt, i1_cb_qp_idx_ofst,
-                                    i1_cr_qp_idx_ofst, ps_cur_mb, i4_wd_y,
-                                    i4_wd_uv, ps_top_mb, ps_left_mb, u1_cur_fld,
-                                    u1_extra_top_edge);
-          }
-
-          ps_cur_mb++;
-          i2_mb_x++;
-
-          pu1_deb_y += 16;
-          pu1_deb_u += 8 * YUV420SP_FACTOR;
-          pu1_deb_v += 8;
-
-        } while (u2_image_wd_mb > i2_mb_x);
-
-        pu1_deb_y += ps_tfr_cxt->u4_y_inc;
-        pu1_deb_u += ps_tfr_cxt->u4_uv_inc;
-        pu1_deb_v += ps_tfr_cxt->u4_uv_inc;
-
-        i2_mb_x = 0;
-        i2_mb_y -= 2;
-
-        u1_first_row = 0;
-      }
+      ih264d_deblock_picture_rows(ps_dec, ps_tfr_cxt);
     }
   }
   // Padd the Picture
@@ -811,18 +1340,6 @@ void ih264d_deblock_picture_mbaff(dec_struct_t *ps_dec) {
 /*****************************************************************************/
 
 void ih264d_deblock_picture_non_mbaff(dec_struct_t *ps_dec) {
-  WORD16 i2_mb_x, i2_mb_y;
-  deblk_mb_t *ps_cur_mb;
-  deblk_mb_t *ps_top_mb;
-  deblk_mb_t *ps_left_mb;
-
-  UWORD8 u1_first_row;
-  UWORD8 u1_deb_mode;
-  WORD32 i4_wd_y, i4_wd_uv;
-
-  UWORD8 u1_field_pic_flag =
-      ps_dec->ps_cur_slice->u1_field_pic_flag; /*< Field u4_flag */
-
   /**************************************************/
   /* one time loads from ps_dec which will be used  */
   /* frequently throughout the deblocking procedure */
@@ -832,71 +1349,13 @@ void ih264d_deblock_picture_non_mbaff(dec_struct_t *ps_dec) {
   tfr_ctxt_t *ps_tfr_cxt = &s_tfr_ctxt;  // = &ps_dec->s_tran_addrecon;
 
   UWORD16 u2_image_wd_mb = ps_dec->u2_frm_wd_in_mbs;
-  UWORD16 u2_image_ht_mb = ps_dec->u2_frm_ht_in_mbs;
-  WORD8 i1_cb_qp_idx_ofst = ps_dec->ps_cur_pps->i1_chroma_qp_index_offset;
-  WORD8 i1_cr_qp_idx_ofst =
-      ps_dec->ps_cur_pps->i1_second_chroma_qp_index_offset;
 
   /* Set up Parameter for  DMA transfer */
   ih264d_init_deblk_tfr_ctxt(ps_dec, ps_pad_mgr, ps_tfr_cxt, u2_image_wd_mb, 0);
 
-  /* Pic level Initialisations */
-  i2_mb_y = u2_image_ht_mb;
-  i2_mb_x = 0;
-
-  u1_first_row = 1;
-
-  i4_wd_y = ps_dec->u2_frm_wd_y << u1_field_pic_flag;
-  i4_wd_uv = ps_dec->u2_frm_wd_uv << u1_field_pic_flag;
-  /* Initial filling of the buffers with deblocking data */
-
-  ps_tfr_cxt->pu1_mb_y = ps_tfr_cxt->pu1_src_y + 4;
-  ps_tfr_cxt->pu1_mb_u = ps_tfr_cxt->pu1_src_u + 4;
-  ps_tfr_cxt->pu1_mb_v = ps_tfr_cxt->pu1_src_v + 4;
-  ps_cur_mb = ps_dec->ps_deblk_pic;
-
   if (ps_dec->u4_app_disable_deblk_frm == 0) {
     if ((ps_dec->u4_mb_level_deblk == 0) && (ps_dec->u4_num_cores != 3)) {
-      while (i2_mb_y > 0) {
-        do {
-          u1_deb_mode = ps_cur_mb->u1_deblocking_mode;
-          if (!(u1_deb_mode & MB_DISABLE_FILTERING)) {
-            if (i2_mb_x) {
-              ps_left_mb = ps_cur_mb - 1;
-            } else {
-              ps_left_mb = NULL;
-            }
-            if (!u1_first_row) {
-              ps_top_mb = ps_cur_mb - (u2_image_wd_mb);
-            } else {
-              ps_top_mb = NULL;
-            }
-
-            if (u1_deb_mode & MB_DISABLE_LEFT_EDGE) ps_left_mb = NULL;
-            if (u1_deb_mode & MB_DISABLE_TOP_EDGE) ps_top_mb = NULL;
-
-            ih264d_deblock_mb_nonmbaff(ps_dec, ps_tfr_cxt, i1_cb_qp_idx_ofst,
-                                       i1_cr_qp_idx_ofst, ps_cur_mb, i4_wd_y,
-                                       i4_wd_uv, ps_top_mb, ps_left_mb);
-          }
-
-          ps_cur_mb++;
-          i2_mb_x++;
-
-          ps_tfr_cxt->pu1_mb_y += 16;
-          ps_tfr_cxt->pu1_mb_u += 8 * YUV420SP_FACTOR;
-          ps_tfr_cxt->pu1_mb_v += 8;
-
-        } while (i2_mb_x < u2_image_wd_mb);
-
-        ps_tfr_cxt->pu1_mb_y += ps_tfr_cxt->u4_y_inc;
-        ps_tfr_cxt->pu1_mb_u += ps_tfr_cxt->u4_uv_inc;
-        ps_tfr_cxt->pu1_mb_v += ps_tfr_cxt->u4_uv_inc;
-
-        i2_mb_x = 0;
-        i2_mb_y--;
-        u1_first_row = 0;
-      }
+      ih264d_deblock_picture_rows(ps_dec, ps_tfr_cxt);
     }
   }
 
@@ -951,91 +1410,22 @@ void ih264d_deblock_picture_non_mbaff(dec_struct_t *ps_dec) {
 }
 
 void ih264d_deblock_picture_progressive(dec_struct_t *ps_dec) {
-  WORD16 i2_mb_x, i2_mb_y;
-
-  deblk_mb_t *ps_cur_mb;
-  deblk_mb_t *ps_top_mb;
-  deblk_mb_t *ps_left_mb;
-
-  UWORD8 u1_mbs_next, u1_first_row;
-  UWORD8 u1_deb_mode;
-  WORD32 i4_wd_y, i4_wd_uv;
-
   /**************************************************/
   /* one time loads from ps_dec which will be used  */
   /* frequently throughout the deblocking procedure */
   /**************************************************/
   pad_mgr_t *ps_pad_mgr = &ps_dec->s_pad_mgr;
-
   tfr_ctxt_t s_tfr_ctxt;
   tfr_ctxt_t *ps_tfr_cxt = &s_tfr_ctxt;  // = &ps_dec->s_tran_addrecon;
-  UWORD16 u2_image_wd_mb = ps_dec->u2_frm_wd_in_mbs;
-  UWORD16 u2_image_ht_mb = ps_dec->u2_frm_ht_in_mbs;
 
-  WORD8 i1_cb_qp_idx_ofst = ps_dec->ps_cur_pps->i1_chroma_qp_index_offset;
-  WORD8 i1_cr_qp_idx_ofst =
-      ps_dec->ps_cur_pps->i1_second_chroma_qp_index_offset;
+  UWORD16 u2_image_wd_mb = ps_dec->u2_frm_wd_in_mbs;
 
   /* Set up Parameter for  deblocking */
   ih264d_init_deblk_tfr_ctxt(ps_dec, ps_pad_mgr, ps_tfr_cxt, u2_image_wd_mb, 0);
 
-  /* Pic level Initialisations */
-  i2_mb_y = u2_image_ht_mb;
-  i2_mb_x = 0;
-
-  u1_first_row = 1;
-
-  i4_wd_y = ps_dec->u2_frm_wd_y;
-  i4_wd_uv = ps_dec->u2_frm_wd_uv;
-  /* Initial filling of the buffers with deblocking data */
-
-  ps_tfr_cxt->pu1_mb_y = ps_tfr_cxt->pu1_src_y + 4;
-  ps_tfr_cxt->pu1_mb_u = ps_tfr_cxt->pu1_src_u + 4;
-  ps_tfr_cxt->pu1_mb_v = ps_tfr_cxt->pu1_src_v + 4;
-  ps_cur_mb = ps_dec->ps_deblk_pic;
-
   if (ps_dec->u4_app_disable_deblk_frm == 0) {
     if ((ps_dec->u4_mb_level_deblk == 0) && (ps_dec->u4_num_cores != 3)) {
-      while (i2_mb_y > 0) {
-        u1_deb_mode = ps_cur_mb->u1_deblocking_mode;
-        if (!(u1_deb_mode & MB_DISABLE_FILTERING)) {
-          if (i2_mb_x) {
-            ps_left_mb = ps_cur_mb - 1;
-          } else {
-            ps_left_mb = NULL;
-          }
-          if (!u1_first_row) {
-            ps_top_mb = ps_cur_mb - (u2_image_wd_mb);
-          } else {
-            ps_top_mb = NULL;
-          }
-
-          if (u1_deb_mode & MB_DISABLE_LEFT_EDGE) ps_left_mb = NULL;
-          if (u1_deb_mode & MB_DISABLE_TOP_EDGE) ps_top_mb = NULL;
-
-          ih264d_deblock_mb_nonmbaff(ps_dec, ps_tfr_cxt, i1_cb_qp_idx_ofst,
-                                     i1_cr_qp_idx_ofst, ps_cur_mb, i4_wd_y,
-                                     i4_wd_uv, ps_top_mb, ps_left_mb);
-        }
-
-        ps_cur_mb++;
-        i2_mb_x++;
-        u1_mbs_next = u2_image_wd_mb - i2_mb_x;
-
-        ps_tfr_cxt->pu1_mb_y += 16;
-        ps_tfr_cxt->pu1_mb_u += 8 * YUV420SP_FACTOR;
-        ps_tfr_cxt->pu1_mb_v += 8;
-
-        if (!u1_mbs_next) {
-          ps_tfr_cxt->pu1_mb_y += ps_tfr_cxt->u4_y_inc;
-          ps_tfr_cxt->pu1_mb_u += ps_tfr_cxt->u4_uv_inc;
-          ps_tfr_cxt->pu1_mb_v += ps_tfr_cxt->u4_uv_inc;
-
-          i2_mb_x = 0;
-          i2_mb_y--;
-          u1_first_row = 0;
-        }
-      }
+      ih264d_deblock_picture_rows(ps_dec, ps_tfr_cxt);
     }
   }
 
@@ -1390,11 +1780,11 @@ void ih264d_filter_boundary_left_mbaff(
 
   /* Chroma cb values */
   {
-    UWORD8 u1_mb_qp1, u1_mb_qp2;
-    u1_mb_qp1 = (ps_left_mb->u1_mb_qp + i1_cb_qp_idx_ofst);
-    u1_mb_qp2 = (ps_cur_mb->u1_mb_qp + i1_cb_qp_idx_ofst);
-    qp_avg = (UWORD8) ((gau1_ih264d_qp_scale_cr[12 + u1_mb_qp1] +
-                        gau1_ih264d_qp_scale_cr[12 + u1_mb_qp2] + 1) >>
+    WORD32 i4_mb_qp1, i4_mb_qp2;
+    i4_mb_qp1 = (ps_left_mb->u1_mb_qp + i1_cb_qp_idx_ofst);
+    i4_mb_qp2 = (ps_cur_mb->u1_mb_qp + i1_cb_qp_idx_ofst);
+    qp_avg = (UWORD8) ((gau1_ih264d_qp_scale_cr[12 + i4_mb_qp1] +
+                        gau1_ih264d_qp_scale_cr[12 + i4_mb_qp2] + 1) >>
                        1);
   }
   idx_a_u = qp_avg + ofst_a;
@@ -1404,11 +1794,11 @@ void ih264d_filter_boundary_left_mbaff(
 
   /* Chroma cr values */
   {
-    UWORD8 u1_mb_qp1, u1_mb_qp2;
-    u1_mb_qp1 = (ps_left_mb->u1_mb_qp + i1_cr_qp_idx_ofst);
-    u1_mb_qp2 = (ps_cur_mb->u1_mb_qp + i1_cr_qp_idx_ofst);
-    qp_avg = (UWORD8) ((gau1_ih264d_qp_scale_cr[12 + u1_mb_qp1] +
-                        gau1_ih264d_qp_scale_cr[12 + u1_mb_qp2] + 1) >>
+    WORD32 i4_mb_qp1, i4_mb_qp2;
+    i4_mb_qp1 = (ps_left_mb->u1_mb_qp + i1_cr_qp_idx_ofst);
+    i4_mb_qp2 = (ps_cur_mb->u1_mb_qp + i1_cr_qp_idx_ofst);
+    qp_avg = (UWORD8) ((gau1_ih264d_qp_scale_cr[12 + i4_mb_qp1] +
+                        gau1_ih264d_qp_scale_cr[12 + i4_mb_qp2] + 1) >>
                        1);
   }
   idx_a_v = qp_avg + ofst_a;
@@ -1475,11 +1865,11 @@ void ih264d_filter_boundary_left_mbaff(
     u4_bs_val = pu4_bs_tab[9];
 
     {
-      UWORD8 u1_mb_qp1, u1_mb_qp2;
-      u1_mb_qp1 = ((ps_left_mb + 1)->u1_mb_qp + i1_cb_qp_idx_ofst);
-      u1_mb_qp2 = (ps_cur_mb->u1_mb_qp + i1_cb_qp_idx_ofst);
-      qp_avg = (UWORD8) ((gau1_ih264d_qp_scale_cr[12 + u1_mb_qp1] +
-                          gau1_ih264d_qp_scale_cr[12 + u1_mb_qp2] + 1) >>
+      WORD32 i4_mb_qp1, i4_mb_qp2;
+      i4_mb_qp1 = ((ps_left_mb + 1)->u1_mb_qp + i1_cb_qp_idx_ofst);
+      i4_mb_qp2 = (ps_cur_mb->u1_mb_qp + i1_cb_qp_idx_ofst);
+      qp_avg = (UWORD8) ((gau1_ih264d_qp_scale_cr[12 + i4_mb_qp1] +
+                          gau1_ih264d_qp_scale_cr[12 + i4_mb_qp2] + 1) >>
                          1);
     }
     idx_a_u = qp_avg + ofst_a;
@@ -1488,11 +1878,11 @@ void ih264d_filter_boundary_left_mbaff(
     beta_u = gau1_ih264d_beta_table[12 + idx_b_u];
     u4_bs_val = pu4_bs_tab[9];
     {
-      UWORD8 u1_mb_qp1, u1_mb_qp2;
-      u1_mb_qp1 = ((ps_left_mb + 1)->u1_mb_qp + i1_cr_qp_idx_ofst);
-      u1_mb_qp2 = (ps_cur_mb->u1_mb_qp + i1_cr_qp_idx_ofst);
-      qp_avg = (UWORD8) ((gau1_ih264d_qp_scale_cr[12 + u1_mb_qp1] +
-                          gau1_ih264d_qp_scale_cr[12 + u1_mb_qp2] + 1) >>
+      WORD32 i4_mb_qp1, i4_mb_qp2;
+      i4_mb_qp1 = ((ps_left_mb + 1)->u1_mb_qp + i1_cr_qp_idx_ofst);
+      i4_mb_qp2 = (ps_cur_mb->u1_mb_qp + i1_cr_qp_idx_ofst);
+      qp_avg = (UWORD8) ((gau1_ih264d_qp_scale_cr[12 + i4_mb_qp1] +
+                          gau1_ih264d_qp_scale_cr[12 + i4_mb_qp2] + 1) >>
                          1);
     }
     idx_a_v = qp_avg + ofst_a;
@@ -1549,11 +1939,11 @@ void ih264d_filter_boundary_topmbaff(
 
   /* CHROMA cb values */
   {
-    UWORD8 u1_mb_qp1, u1_mb_qp2;
-    u1_mb_qp1 = (ps_top_mb->u1_mb_qp + i1_cb_qp_idx_ofst);
-    u1_mb_qp2 = (ps_cur_mb->u1_mb_qp + i1_cb_qp_idx_ofst);
-    qp_avg = (UWORD8) ((gau1_ih264d_qp_scale_cr[12 + u1_mb_qp1] +
-                        gau1_ih264d_qp_scale_cr[12 + u1_mb_qp2] + 1) >>
+    WORD32 i4_mb_qp1, i4_mb_qp2;
+    i4_mb_qp1 = (ps_top_mb->u1_mb_qp + i1_cb_qp_idx_ofst);
+    i4_mb_qp2 = (ps_cur_mb->u1_mb_qp + i1_cb_qp_idx_ofst);
+    qp_avg = (UWORD8) ((gau1_ih264d_qp_scale_cr[12 + i4_mb_qp1] +
+                        gau1_ih264d_qp_scale_cr[12 + i4_mb_qp2] + 1) >>
                        1);
   }
 
@@ -1563,11 +1953,11 @@ void ih264d_filter_boundary_topmbaff(
   beta_u = gau1_ih264d_beta_table[12 + idx_b_u];
   /* CHROMA cr values */
   {
-    UWORD8 u1_mb_qp1, u1_mb_qp2;
-    u1_mb_qp1 = (ps_top_mb->u1_mb_qp + i1_cr_qp_idx_ofst);
-    u1_mb_qp2 = (ps_cur_mb->u1_mb_qp + i1_cr_qp_idx_ofst);
-    qp_avg = (UWORD8) ((gau1_ih264d_qp_scale_cr[12 + u1_mb_qp1] +
-                        gau1_ih264d_qp_scale_cr[12 + u1_mb_qp2] + 1) >>
+    WORD32 i4_mb_qp1, i4_mb_qp2;
+    i4_mb_qp1 = (ps_top_mb->u1_mb_qp + i1_cr_qp_idx_ofst);
+    i4_mb_qp2 = (ps_cur_mb->u1_mb_qp + i1_cr_qp_idx_ofst);
+    qp_avg = (UWORD8) ((gau1_ih264d_qp_scale_cr[12 + i4_mb_qp1] +
+                        gau1_ih264d_qp_scale_cr[12 + i4_mb_qp2] + 1) >>
                        1);
   }
 
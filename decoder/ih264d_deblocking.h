@@ -136,6 +136,19 @@ void ih264d_fill_bs1_non16x16mb_bslice(
     mv_pred_t *ps_leftmost_mv_pred, neighbouradd_t *ps_left_addr,
     void **u4_pic_addrress, WORD32 i4_ver_mvlimit);
 
+/* x86 SSE4.2 */
+void ih264d_fill_bs1_non16x16mb_pslice_sse42(
+    mv_pred_t *ps_cur_mv_pred, mv_pred_t *ps_top_mv_pred,
+    void **ppv_map_ref_idx_to_poc, UWORD32 *pu4_bs_table,
+    mv_pred_t *ps_leftmost_mv_pred, neighbouradd_t *ps_left_addr,
+    void **u4_pic_addrress, WORD32 i4_ver_mvlimit);
+
+void ih264d_fill_bs1_non16x16mb_bslice_sse42(
+    mv_pred_t *ps_cur_mv_pred, mv_pred_t *ps_top_mv_pred,
+    void **ppv_map_ref_idx_to_poc, UWORD32 *pu4_bs_table,
+    mv_pred_t *ps_leftmost_mv_pred, neighbouradd_t *ps_left_addr,
+    void **u4_pic_addrress, WORD32 i4_ver_mvlimit);
+
 void ih264d_fill_bs_xtra_left_edge_cur_fld(UWORD32 *pu4_bs,
                                            WORD32 u4_left_mb_t_csbp,
                                            WORD32 u4_left_mb_b_csbp,
@@ -161,4 +174,21 @@ void ih264d_init_deblk_tfr_ctxt(dec_struct_t *ps_dec, pad_mgr_t *ps_pad_mgr,
 void ih264d_deblock_mb_level(dec_struct_t *ps_dec,
                              dec_mb_info_t *ps_cur_mb_info, UWORD32 nmb_index);
 
+void ih264d_deblk_row_nonmbaff(dec_struct_t *ps_dec, UWORD8 *pu1_y,
+                               UWORD8 *pu1_uv, WORD32 i4_strd_y,
+                               WORD32 i4_strd_uv, deblk_row_mb_t *ps_row_mb,
+                               WORD32 i4_num_mbs);
+/* x86 SSE4.2 */
+void ih264d_deblk_row_nonmbaff_sse42(dec_struct_t *ps_dec, UWORD8 *pu1_y,
+                                     UWORD8 *pu1_uv, WORD32 i4_strd_y,
+                                     WORD32 i4_strd_uv,
+                                     deblk_row_mb_t *ps_row_mb,
+                                     WORD32 i4_num_mbs);
+UWORD32 ih264d_check_deblk_top_row(dec_struct_t *ps_dec, UWORD32 u4_x,
+                                   UWORD32 u4_y);
+void ih264d_start_deblk_workers(dec_struct_t *ps_dec,
+                                void (*pf_job)(deblk_worker_ctxt_t *));
+void ih264d_wait_deblk_workers(dec_struct_t *ps_dec);
+void ih264d_stop_deblk_workers(dec_struct_t *ps_dec);
+
 #endif /* _IH264D_DEBLOCKING_H_ */
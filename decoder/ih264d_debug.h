@@ -105,9 +105,14 @@
 #define SWITCHOFFTRACECABAC
 #define SWITCHONTRACECABAC
 
+#ifdef PERF_STATS_ENABLE
+#define INC_BIN_COUNT(ps_cab_env) (ps_cab_env)->u8_num_bins++
+#define INC_BYPASS_BINS(ps_cab_env) (ps_cab_env)->u8_num_bypass_bins++
+#else
 #define INC_BIN_COUNT(ps_cab_env)
-#define INC_DECISION_BINS(ps_cab_env)
 #define INC_BYPASS_BINS(ps_cab_env)
+#endif
+#define INC_DECISION_BINS(ps_cab_env)
 #define INC_SYM_COUNT(ps_cab_env)
 #define PRINT_BIN_BIT_RATIO(ps_dec)
 #define RESET_BIN_COUNTS(ps_cab_env)
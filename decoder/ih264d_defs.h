@@ -138,6 +138,9 @@
                               // //0+33+33+17+17+17+17
 #define PAD_MV_BANK_ROW 64
 #define OFFSET_MV_BANK_ROW ((PAD_MV_BANK_ROW) >> 1)
+/* Index of the co-located MV of 4x4 block i when they are kept one per 8x8 */
+#define COL_MV_IDX_8x8(i) \
+  ((((i) >> 4) << 2) + (((i) >> 2) & 2) + (((i) >> 1) & 1))
 #define PAD_PUC_CURNNZ 32
 #define OFFSET_PUC_CURNNZ (PAD_PUC_CURNNZ)
 #define PAD_MAP_IDX_POC (1)
@@ -288,6 +291,12 @@ enum {
   /*holds structure related to MV buffer manager*/
   MEM_REC_MV_BUF_MGR,
 
+  /* holds the trace event rings, see ih264d_trace.h */
+  MEM_REC_TRACE,
+
+  /* holds the film grain patterns, see ih264d_film_grain.c */
+  MEM_REC_FILM_GRAIN,
+
   /**
    * Place holder to compute number of memory records.
    */
@@ -309,8 +318,23 @@ enum {
 #define BASE_PROFILE_IDC 66
 #define MAIN_PROFILE_IDC 77
 #define HIGH_PROFILE_IDC 100
+#define HIGH10_PROFILE_IDC 110
+#define HIGH422_PROFILE_IDC 122
+#define HIGH444_PROFILE_IDC 244
+#define CAVLC444_PROFILE_IDC 44
 #define MAIN_PROFILE 1
 
+/** Profiles that carry the High profile SPS and PPS syntax and tools */
+#define IS_HIGH_PROFILE(profile_idc)                                      \
+  (((profile_idc) == HIGH_PROFILE_IDC) ||                                 \
+   ((profile_idc) == HIGH10_PROFILE_IDC) ||                               \
+   ((profile_idc) == HIGH422_PROFILE_IDC) ||                              \
+   ((profile_idc) == HIGH444_PROFILE_IDC) ||                              \
+   ((profile_idc) == CAVLC444_PROFILE_IDC))
+
+/** 4:0:0 sequences carry no chroma syntax; chroma planes are left at 128 */
+#define IS_MONOCHROME(ps_dec) ((ps_dec)->ps_cur_sps->i4_chroma_format_idc == 0)
+
 #define MB_SIZE 16
 #define BLK8x8SIZE 8
 #define BLK_SIZE 4
@@ -606,6 +630,59 @@ enum {
 #define H264_DEFAULT_NUM_CORES 1
 #define DEFAULT_SEPARATE_PARSE (H264_DEFAULT_NUM_CORES == 2) ? 1 : 0
 
+/** Maximum number of cores. Parse, decode and compute bs use at most three
+ threads, the cores beyond that are used as deblocking workers */
+#define H264_MAX_NUM_CORES 8
+
+/** Maximum number of workers deblocking a picture, each one handles every
+ N-th MB (pair) row */
+#define MAX_DEBLK_WORKERS H264_MAX_NUM_CORES
+
+/** Logical threads keeping separate profiling counters, so that a counter is
+ only ever updated by one thread: the API thread (which also runs deblocking
+ worker 0), the decode thread, the compute bs thread and deblocking workers 1
+ onwards. They are also the IH264D_TRACE_THREAD_T values of the trace events */
+#define PERF_SLOT_MAIN 0
+#define PERF_SLOT_DEC 1
+#define PERF_SLOT_BS 2
+#define PERF_SLOT_DEBLK_WORKER 3
+#define PERF_NUM_SLOTS (PERF_SLOT_DEBLK_WORKER + MAX_DEBLK_WORKERS - 1)
+
+/** Trace events kept per profiling slot, a power of 2 */
+#define TRACE_EVENTS_PER_SLOT 65536
+
+/** Number of memory records allocated on SPS activation when the decoder is
+ initialized with u4_alloc_per_sps, see ih264d_alloc_sps_mem() */
+#define NUM_SPS_MEM_RECS 12
+
+/** The per SPS allocation is shrunk only after this many consecutive SPS
+ activations needed less than half of it, so that a stream switching back
+ and forth between two resolutions does not reallocate every time */
+#define SPS_MEM_SHRINK_ACTIVATIONS 3
+
+/** Default and maximum number of MBs for which MC reference is prefetched
+ ahead of the MB being motion compensated. Off by default: on 1080p decode
+ no distance was faster than none beyond the run to run variation, measure
+ with --mc_prefetch_dist of app264_bench before changing it on a platform */
+#define DEFAULT_MC_PREFETCH_DIST 0
+#define MAX_MC_PREFETCH_DIST 8
+
+/** Largest deadline in microseconds and target fps accepted by
+ IH264D_CMD_CTL_SET_DEADLINE */
+#define MAX_DEADLINE_US 10000000
+#define MAX_DEADLINE_FPS 1000
+
+/** Film grain synthesis: cutoff frequencies 2 to 14 select one of
+ FG_NUM_CUTOFFS patterns of FG_PATTERN_SIZE x FG_PATTERN_SIZE per direction.
+ The grain is blended in runs of up to FG_SEG_BLKS 8x8 blocks after every
+ FG_CONV_ROWS rows of format conversion */
+#define FG_NUM_CUTOFFS 13
+#define FG_PATTERN_SIZE 64
+#define FG_GAUSSIAN_LUT_SIZE 2048
+#define FG_SEED_LUT_SIZE 256
+#define FG_SEG_BLKS 32
+#define FG_CONV_ROWS 16
+
 /** Maximum number of Slice groups */
 #define MAX_NUM_SLICE_GROUPS 8
 #define MAX_NUM_REF_FRAMES_OFFSET 255
@@ -617,6 +694,15 @@ enum {
 #define MIN_DBLK_FIL_OFF -12
 #define MAX_DBLK_FIL_OFF 12
 
+/** Number of MBs of a row deblocked in a single row deblocking call */
+#define DEBLK_ROW_MBS 16
+
+/** Edge types with separate filter parameters in row deblocking */
+#define DEBLK_EDGE_LEFT 0
+#define DEBLK_EDGE_TOP 1
+#define DEBLK_EDGE_INNER 2
+#define NUM_DEBLK_EDGE_TYPES 3
+
 /** Width of the predictor buffers used for MC */
 #define MB_SIZE 16
 #define BLK8x8SIZE 8
@@ -139,6 +139,9 @@ typedef enum {
   ERROR_INV_SEI_CLLI_PARAMS = 0x9B,
   ERROR_SEI_FGC_PARAMS_NOT_FOUND = 0x9C,
   ERROR_INV_SEI_FGC_PARAMS = 0x9D,
+  ERROR_MEM_BUDGET_TOO_SMALL = 0x9E,
+  ERROR_NOT_SUPP_BIT_DEPTH = 0x9F,
+  ERROR_NOT_SUPP_CHROMA_FMT = 0xA0,
 
 } h264_decoder_error_code_t;
 
@@ -0,0 +1,752 @@
+/* Copyright (c) [2020]-[2023] Ittiam Systems Pvt. Ltd.
+   All rights reserved.
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted (subject to the limitations in the
+   disclaimer below) provided that the following conditions are met:
+   •    Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+   •    Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+   •    None of the names of Ittiam Systems Pvt. Ltd., its affiliates,
+   investors, business partners, nor the names of its contributors may be
+   used to endorse or promote products derived from this software without
+   specific prior written permission.
+
+   NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED
+   BY THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+   BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+   FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+   HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+   OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+   WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+   OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+   EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+   This Software is an implementation of the AVC/H.264
+   standard by Ittiam Systems Pvt. Ltd. (“Ittiam”).
+   Additional patent licenses may be required for this Software,
+   including, but not limited to, a license from MPEG LA’s AVC/H.264
+   licensing program (see https://www.mpegla.com/programs/avc-h-264/).
+
+   NOTWITHSTANDING ANYTHING TO THE CONTRARY, THIS DOES NOT GRANT ANY
+   EXPRESS OR IMPLIED LICENSES TO ANY PATENT CLAIMS OF ANY AFFILIATE
+   (TO THE EXTENT NOT IN THE LEGAL ENTITY), INVESTOR, OR OTHER
+   BUSINESS PARTNER OF ITTIAM. You may only use this software or
+   modifications thereto for purposes that are authorized by
+   appropriate patent licenses. You should seek legal advice based
+   upon your implementation details.
+
+---------------------------------------------------------------
+*/
+/*****************************************************************************/
+/*                                                                           */
+/*  File Name         : ih264d_film_grain.c                                  */
+/*                                                                           */
+/*  Description       : Contains the film grain synthesis of the frequency   */
+/*                      filtering model with additive blending, signalled by */
+/*                      film grain characteristics SEI, in the manner of     */
+/*                      SMPTE RDD 5. A 64x64 grain pattern is generated per  */
+/*                      pair of cutoff frequencies the first time a picture  */
+/*                      uses it. Each 16x16 luma or 8x8 chroma block then    */
+/*                      takes its grain from a random offset of the pattern  */
+/*                      of the intensity interval of each 8x8 block, scaled  */
+/*                      and added to the display buffer right after the      */
+/*                      rows are format converted                            */
+/*                                                                           */
+/*  List of Functions : ih264d_film_grain_prng()                             */
+/*                      ih264d_film_grain_gen_pattern()                      */
+/*                      ih264d_film_grain_init()                             */
+/*                      ih264d_film_grain_pic_init()                         */
+/*                      ih264d_film_grain_blk()                              */
+/*                      ih264d_film_grain_smooth()                           */
+/*                      ih264d_film_grain_rows()                             */
+/*                      ih264d_film_grain_apply()                            */
+/*                      ih264d_film_grain_avg_luma()                         */
+/*                      ih264d_film_grain_avg_chroma()                       */
+/*                      ih264d_film_grain_synth_row()                        */
+/*                      ih264d_film_grain_blend()                            */
+/*                      ih264d_film_grain_blend_uv()                         */
+/*                                                                           */
+/*  Issues / Problems : Film grain model 1, multiplicative blending and bit  */
+/*                      depths above 8 are not synthesised                   */
+/*                                                                           */
+/*****************************************************************************/
+/*****************************************************************************/
+/* File Includes                                                             */
+/*****************************************************************************/
+
+/* System include files */
+#include <string.h>
+
+/* User include files */
+#include "ih264_typedefs.h"
+#include "ih264_macros.h"
+#include "ih264_platform_macros.h"
+#include "ih264d_defs.h"
+#include "ih264d_structs.h"
+#include "ih264d_film_grain.h"
+
+/* Seeds of the pseudo random generator filling the Gaussian and seed LUTs */
+#define FG_GAUSSIAN_SEED 0x2A5D13B7
+#define FG_SEED_LUT_SEED 0x6C8E9CF5
+
+/* Attenuation of the first and the last row of each 8 rows of a pattern, */
+/* by vertical cutoff, in 1/128 units                                     */
+static const UWORD8 gau1_ih264d_fg_deblk_factor[FG_NUM_CUTOFFS] = {
+    64, 71, 77, 84, 90, 96, 103, 109, 116, 122, 128, 128, 128};
+
+/* Quarter wave of the transform, round(64 * sqrt(2) * cos(m * pi / 128)) */
+static const UWORD8 gau1_ih264d_fg_cos[65] = {
+    91, 90, 90, 90, 90, 90, 90, 89, 89, 88, 88, 87, 87, 86, 85, 84, 84,
+    83, 82, 81, 80, 79, 78, 76, 75, 74, 73, 71, 70, 69, 67, 66, 64, 62,
+    61, 59, 57, 56, 54, 52, 50, 48, 47, 45, 43, 41, 39, 37, 35, 33, 30,
+    28, 26, 24, 22, 20, 18, 15, 13, 11, 9,  7,  4,  2,  0};
+
+/* Pattern offset of each colour component in the seed LUT */
+static const UWORD8 gau1_ih264d_fg_comp_ofst[3] = {0, 85, 170};
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264d_film_grain_prng                                   */
+/*                                                                           */
+/*  Description   : Advances the 32 bit pseudo random generator by a bit     */
+/*                                                                           */
+/*  Inputs        : u4_x - generator state                                   */
+/*  Returns       : Next state                                               */
+/*                                                                           */
+/*****************************************************************************/
+static UWORD32 ih264d_film_grain_prng(UWORD32 u4_x) {
+  return (u4_x << 1) | ((1 ^ (u4_x >> 2) ^ (u4_x >> 30)) & 1);
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264d_film_grain_gen_pattern                            */
+/*                                                                           */
+/*  Description   : Generates the grain pattern of a pair of cutoffs. The    */
+/*                  coefficients up to the cutoffs are filled with Gaussian  */
+/*                  samples, four per random number, and inverse transformed */
+/*                                                                           */
+/*  Inputs        : ps_fg - film grain context                               */
+/*                  i4_h  - horizontal cutoff less 2                         */
+/*                  i4_v  - vertical cutoff less 2                           */
+/*                                                                           */
+/*****************************************************************************/
+static void ih264d_film_grain_gen_pattern(film_grain_ctxt_t *ps_fg, WORD32 i4_h,
+                                          WORD32 i4_v) {
+  WORD8 *pi1_out = ps_fg->ai1_pattern[i4_h][i4_v];
+  WORD16 *pi2_tmp = ps_fg->ai2_tmp;
+  WORD32 i4_freq_h = ((i4_h + 3) << 2) - 1;
+  WORD32 i4_freq_v = ((i4_v + 3) << 2) - 1;
+  UWORD32 u4_seed = ps_fg->au4_seed[i4_h + i4_v * FG_NUM_CUTOFFS];
+  WORD32 x, y, p;
+
+  /* Coefficients, vertical frequency in the row */
+  memset(pi1_out, 0, FG_PATTERN_SIZE * FG_PATTERN_SIZE);
+  for (y = 0; y <= i4_freq_v; y++) {
+    for (x = 0; x <= i4_freq_h; x += 4) {
+      const WORD8 *pi1_gauss =
+          &ps_fg->ai1_gaussian[u4_seed % FG_GAUSSIAN_LUT_SIZE];
+
+      pi1_out[y * FG_PATTERN_SIZE + x] = pi1_gauss[0];
+      pi1_out[y * FG_PATTERN_SIZE + x + 1] = pi1_gauss[1];
+      pi1_out[y * FG_PATTERN_SIZE + x + 2] = pi1_gauss[2];
+      pi1_out[y * FG_PATTERN_SIZE + x + 3] = pi1_gauss[3];
+      u4_seed = ih264d_film_grain_prng(u4_seed);
+    }
+  }
+  pi1_out[0] = 0;
+
+  /* Vertical inverse transform of the columns that have coefficients */
+  for (y = 0; y < FG_PATTERN_SIZE; y++) {
+    for (x = 0; x <= i4_freq_h; x++) {
+      WORD32 i4_sum = 0;
+
+      for (p = 0; p <= i4_freq_v; p++)
+        i4_sum += ps_fg->ai1_transform[y][p] * pi1_out[p * FG_PATTERN_SIZE + x];
+      pi2_tmp[y * FG_PATTERN_SIZE + x] = (WORD16) ((i4_sum + 128) >> 8);
+    }
+  }
+
+  /* Horizontal inverse transform */
+  for (y = 0; y < FG_PATTERN_SIZE; y++) {
+    for (x = 0; x < FG_PATTERN_SIZE; x++) {
+      WORD32 i4_sum = 0;
+
+      for (p = 0; p <= i4_freq_h; p++)
+        i4_sum += pi2_tmp[y * FG_PATTERN_SIZE + p] * ps_fg->ai1_transform[x][p];
+      i4_sum = (i4_sum + 128) >> 8;
+      pi1_out[y * FG_PATTERN_SIZE + x] = (WORD8) CLIP3(-127, 127, i4_sum);
+    }
+  }
+
+  /* Soften the horizontal edges between the 8x8 blocks */
+  for (y = 0; y < FG_PATTERN_SIZE; y++) {
+    if ((y & 7) && (7 != (y & 7))) continue;
+
+    for (x = 0; x < FG_PATTERN_SIZE; x++) {
+      WORD32 i4_val = pi1_out[y * FG_PATTERN_SIZE + x];
+
+      pi1_out[y * FG_PATTERN_SIZE + x] =
+          (WORD8) ((i4_val * gau1_ih264d_fg_deblk_factor[i4_v]) >> 7);
+    }
+  }
+
+  ps_fg->au2_pattern_ready[i4_h] |= (UWORD16) (1 << i4_v);
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264d_film_grain_init                                   */
+/*                                                                           */
+/*  Description   : Sets up the film grain context in its memory record and  */
+/*                  generates the transform, Gaussian and seed LUTs. The     */
+/*                  patterns are generated when a picture first uses them    */
+/*                                                                           */
+/*  Inputs        : ps_dec      - decoder context                            */
+/*                  pv_buf      - MEM_REC_FILM_GRAIN                         */
+/*                  u4_max_rows - rows of 16x16 blocks of the largest        */
+/*                                picture                                    */
+/*  Returns       : Film grain context                                       */
+/*                                                                           */
+/*****************************************************************************/
+film_grain_ctxt_t *ih264d_film_grain_init(dec_struct_t *ps_dec, void *pv_buf,
+                                          UWORD32 u4_max_rows) {
+  film_grain_ctxt_t *ps_fg = (film_grain_ctxt_t *) pv_buf;
+  UWORD32 u4_x;
+  WORD32 i, j;
+
+  UNUSED(ps_dec);
+
+  memset(ps_fg->au2_pattern_ready, 0, sizeof(ps_fg->au2_pattern_ready));
+  ps_fg->u4_apply = 0;
+  ps_fg->pu4_row_seed =
+      (UWORD32 *) ((UWORD8 *) pv_buf + ALIGN64(sizeof(film_grain_ctxt_t)));
+  ps_fg->u4_max_rows = u4_max_rows;
+
+  /* Basis k at sample n is cos((2n + 1) k pi / 128), folded onto the */
+  /* quarter wave                                                     */
+  for (i = 0; i < FG_PATTERN_SIZE; i++) {
+    ps_fg->ai1_transform[i][0] = 64;
+    for (j = 1; j < FG_PATTERN_SIZE; j++) {
+      WORD32 m = ((2 * i + 1) * j) & 255;
+
+      if (m > 128) m = 256 - m;
+      if (m <= 64)
+        ps_fg->ai1_transform[i][j] = (WORD8) gau1_ih264d_fg_cos[m];
+      else
+        ps_fg->ai1_transform[i][j] = (WORD8) (-gau1_ih264d_fg_cos[128 - m]);
+    }
+  }
+
+  /* Sum of four uniform bytes, scaled to a deviation of about 16 */
+  u4_x = FG_GAUSSIAN_SEED;
+  for (i = 0; i < FG_GAUSSIAN_LUT_SIZE; i++) {
+    WORD32 i4_sum = 0;
+
+    for (j = 0; j < 32; j++) {
+      u4_x = ih264d_film_grain_prng(u4_x);
+      if (7 == (j & 7)) i4_sum += u4_x & 0xff;
+    }
+    i4_sum = ((i4_sum - 510) * 7) >> 6;
+    ps_fg->ai1_gaussian[i] = (WORD8) CLIP3(-127, 127, i4_sum);
+  }
+  for (i = 0; i < 4; i++)
+    ps_fg->ai1_gaussian[FG_GAUSSIAN_LUT_SIZE + i] = ps_fg->ai1_gaussian[i];
+
+  u4_x = FG_SEED_LUT_SEED;
+  for (i = 0; i < FG_SEED_LUT_SIZE; i++) {
+    for (j = 0; j < 32; j++) u4_x = ih264d_film_grain_prng(u4_x);
+    ps_fg->au4_seed[i] = u4_x;
+  }
+
+  return ps_fg;
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264d_film_grain_pic_init                               */
+/*                                                                           */
+/*  Description   : Prepares the grain of the picture returned for display   */
+/*                  from the film grain characteristics that apply to it:    */
+/*                  the interval of each block average, the patterns of the  */
+/*                  intervals and the seed of each row of random offset      */
+/*                  blocks. Grain is not added when the characteristics are  */
+/*                  not supported or the output is not converted             */
+/*                                                                           */
+/*  Inputs        : ps_dec          - decoder context                        */
+/*                  ps_sei          - SEI of the picture, NULL for none      */
+/*                  e_output_format - output format                          */
+/*                                                                           */
+/*****************************************************************************/
+void ih264d_film_grain_pic_init(dec_struct_t *ps_dec, sei *ps_sei,
+                                IV_COLOR_FORMAT_T e_output_format) {
+  film_grain_ctxt_t *ps_fg = ps_dec->ps_film_grain;
+  sei_fgc_params_t *ps_fgc;
+  iv_yuv_buf_t *ps_frm = &ps_dec->s_disp_frame_info;
+  UWORD32 u4_pic_ofst, u4_any = 0;
+  WORD32 c, i, v;
+
+  if (NULL == ps_fg) return;
+  ps_fg->u4_apply = 0;
+
+  if ((NULL == ps_sei) || (0 == ps_sei->u1_sei_fgc_params_present_flag))
+    return;
+  if (ps_dec->u4_share_disp_buf) return;
+  if ((IV_YUV_420P != e_output_format) &&
+      (IV_YUV_420SP_UV != e_output_format) &&
+      (IV_YUV_420SP_VU != e_output_format))
+    return;
+  if (((ps_frm->u4_y_ht + 15) >> 4) > ps_fg->u4_max_rows) return;
+
+  ps_fgc = &ps_sei->s_sei_fgc_params;
+  if (ps_fgc->u1_film_grain_characteristics_cancel_flag ||
+      ps_fgc->u1_film_grain_model_id || ps_fgc->u1_blending_mode_id)
+    return;
+  if (ps_fgc->u1_separate_colour_description_present_flag &&
+      (ps_fgc->u1_film_grain_bit_depth_luma_minus8 ||
+       ps_fgc->u1_film_grain_bit_depth_chroma_minus8))
+    return;
+
+  ps_fg->u4_shift = ps_fgc->u1_log2_scale_factor + 6;
+
+  for (c = 0; c < 3; c++) {
+    UWORD32 u4_num_values = ps_fgc->au1_num_model_values_minus1[c] + 1;
+
+    memset(ps_fg->au1_interval[c], 0, sizeof(ps_fg->au1_interval[c]));
+    ps_fg->au1_comp_present[c] = ps_fgc->au1_comp_model_present_flag[c];
+    if (0 == ps_fg->au1_comp_present[c]) continue;
+
+    for (i = 0; i <= ps_fgc->au1_num_intensity_intervals_minus1[c]; i++) {
+      WORD32 *pi4_value = ps_fgc->ai4_comp_model_value[c][i];
+      WORD32 i4_cut_h = (u4_num_values > 1) ? pi4_value[1] : 8;
+      WORD32 i4_cut_v = (u4_num_values > 2) ? pi4_value[2] : i4_cut_h;
+      WORD32 i4_h = CLIP3(2, 14, i4_cut_h) - 2;
+
+      v = CLIP3(2, 14, i4_cut_v) - 2;
+      if (0 == (ps_fg->au2_pattern_ready[i4_h] & (1 << v)))
+        ih264d_film_grain_gen_pattern(ps_fg, i4_h, v);
+
+      ps_fg->as_interval[c][i].pi1_pattern = ps_fg->ai1_pattern[i4_h][v];
+      ps_fg->as_interval[c][i].i4_scale = pi4_value[0];
+
+      /* The first interval that holds an average is used */
+      for (v = ps_fgc->au1_intensity_interval_lower_bound[c][i];
+           v <= ps_fgc->au1_intensity_interval_upper_bound[c][i]; v++) {
+        if (0 == ps_fg->au1_interval[c][v])
+          ps_fg->au1_interval[c][v] = (UWORD8) (i + 1);
+      }
+    }
+    u4_any = 1;
+  }
+  if (0 == u4_any) return;
+
+  u4_pic_ofst = (UWORD32) ps_fgc->i4_poc + (ps_fgc->u4_idr_pic_id << 5);
+  for (c = 0; c < 3; c++) {
+    UWORD32 *pu4_row_seed = ps_fg->pu4_row_seed + c * ps_fg->u4_max_rows;
+    UWORD32 u4_seed =
+        ps_fg->au4_seed[(u4_pic_ofst + gau1_ih264d_fg_comp_ofst[c]) &
+                        (FG_SEED_LUT_SIZE - 1)];
+    UWORD32 u4_rows, u4_cols, u4_row, u4_col;
+
+    /* Random offset blocks are 16x16 luma or 8x8 chroma samples */
+    if (0 == c) {
+      u4_rows = (ps_frm->u4_y_ht + 15) >> 4;
+      u4_cols = (ps_frm->u4_y_wd + 15) >> 4;
+    } else {
+      u4_rows = ((ps_frm->u4_y_ht >> 1) + 7) >> 3;
+      u4_cols = ((ps_frm->u4_y_wd >> 1) + 7) >> 3;
+    }
+    for (u4_row = 0; u4_row < u4_rows; u4_row++) {
+      pu4_row_seed[u4_row] = u4_seed;
+      for (u4_col = 0; u4_col < u4_cols; u4_col++)
+        u4_seed = ih264d_film_grain_prng(u4_seed);
+    }
+  }
+
+  ps_fg->u4_apply = 1;
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264d_film_grain_blk                                    */
+/*                                                                           */
+/*  Description   : Sets the pattern and scale of an 8x8 block from its      */
+/*                  average and the seed of its random offset block          */
+/*                                                                           */
+/*  Inputs        : ps_fg   - film grain context                             */
+/*                  i4_comp - colour component                               */
+/*                  u4_avg  - average of the block                           */
+/*                  u4_seed - seed of the random offset block                */
+/*                  i4_yy   - row of the block in the random offset block    */
+/*                  i4_xx   - column of the block in the random offset block */
+/*  Outputs       : ps_blk  - block                                          */
+/*                                                                           */
+/*****************************************************************************/
+static void ih264d_film_grain_blk(film_grain_ctxt_t *ps_fg, WORD32 i4_comp,
+                                  UWORD32 u4_avg, UWORD32 u4_seed,
+                                  WORD32 i4_yy, WORD32 i4_xx,
+                                  film_grain_blk_t *ps_blk) {
+  UWORD32 u4_interval = ps_fg->au1_interval[i4_comp][u4_avg];
+  film_grain_blk_t *ps_interval;
+  UWORD32 u4_y_ofst, u4_x_ofst;
+
+  if (0 == u4_interval) {
+    ps_blk->pi1_pattern = NULL;
+    ps_blk->i4_scale = 0;
+    return;
+  }
+  ps_interval = &ps_fg->as_interval[i4_comp][u4_interval - 1];
+
+  u4_y_ofst = ((u4_seed >> 16) % 52) & ~3u;
+  u4_x_ofst = ((u4_seed & 0xffff) % 56) & ~7u;
+  ps_blk->pi1_pattern = ps_interval->pi1_pattern +
+                        (u4_y_ofst + i4_yy) * FG_PATTERN_SIZE + u4_x_ofst +
+                        i4_xx;
+  ps_blk->i4_scale =
+      (u4_seed & 1) ? -ps_interval->i4_scale : ps_interval->i4_scale;
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264d_film_grain_smooth                                 */
+/*                                                                           */
+/*  Description   : Smooths a row of grain across the vertical edges of the  */
+/*                  run of blocks that are followed by a block with grain.   */
+/*                  The edges read only the samples they do not modify, so   */
+/*                  every edge is filtered from the unsmoothed grain         */
+/*                                                                           */
+/*  Inputs        : pi2_grain - grain of the run, block 0 is left of it      */
+/*                  ps_blk    - blocks of the run                            */
+/*                  i4_n      - blocks of the run excluding the neighbours   */
+/*                  i4_first  - the run starts at the left picture edge      */
+/*                                                                           */
+/*****************************************************************************/
+static void ih264d_film_grain_smooth(WORD16 *pi2_grain,
+                                     const film_grain_blk_t *ps_blk,
+                                     WORD32 i4_n, WORD32 i4_first) {
+  WORD32 j;
+
+  for (j = i4_first ? 2 : 1; j <= i4_n + 1; j++) {
+    WORD16 *pi2_edge = pi2_grain + (j << 3);
+    WORD32 i4_l1 = pi2_edge[-2], i4_l0 = pi2_edge[-1];
+    WORD32 i4_r0 = pi2_edge[0], i4_r1 = pi2_edge[1];
+
+    if (NULL == ps_blk[j].pi1_pattern) continue;
+
+    pi2_edge[-1] = (WORD16) ((i4_l1 + 2 * i4_l0 + i4_r0) >> 2);
+    pi2_edge[0] = (WORD16) ((i4_l0 + 2 * i4_r0 + i4_r1) >> 2);
+  }
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264d_film_grain_rows                                   */
+/*                                                                           */
+/*  Description   : Adds grain to rows of luma or of both chroma components. */
+/*                  Each row of 8x8 blocks is done in runs of FG_SEG_BLKS    */
+/*                  blocks, with the block on either side of a run taken     */
+/*                  along for the edge smoothing                             */
+/*                                                                           */
+/*  Inputs        : ps_dec      - decoder context                            */
+/*                  i4_chroma   - 1 for chroma                               */
+/*                  pu1_src     - decoded plane, interleaved for chroma      */
+/*                  i4_src_strd - stride of pu1_src                          */
+/*                  pu1_dst     - converted luma, U or interleaved chroma    */
+/*                  pu1_dst_v   - converted V, NULL when interleaved         */
+/*                  i4_dst_strd - stride of the converted planes             */
+/*                  i4_swap_uv  - interleaved chroma is V first              */
+/*                  i4_wd       - width of a component in samples            */
+/*                  i4_start    - first row                                  */
+/*                  i4_end      - row after the last one                     */
+/*                                                                           */
+/*****************************************************************************/
+static void ih264d_film_grain_rows(dec_struct_t *ps_dec, WORD32 i4_chroma,
+                                   const UWORD8 *pu1_src, WORD32 i4_src_strd,
+                                   UWORD8 *pu1_dst, UWORD8 *pu1_dst_v,
+                                   WORD32 i4_dst_strd, WORD32 i4_swap_uv,
+                                   WORD32 i4_wd, WORD32 i4_start,
+                                   WORD32 i4_end) {
+  film_grain_ctxt_t *ps_fg = ps_dec->ps_film_grain;
+  film_grain_blk_t as_blk[2][FG_SEG_BLKS + 2];
+  UWORD8 au1_avg[2][FG_SEG_BLKS + 1];
+  WORD16 ai2_grain[2][(FG_SEG_BLKS + 2) << 3];
+  UWORD32 au4_seed[2];
+  WORD32 i4_num_comps = i4_chroma ? 2 : 1;
+  /* log2 of the 8x8 blocks along a side of a random offset block */
+  WORD32 i4_ofst_shift = i4_chroma ? 0 : 1;
+  WORD32 i4_num_blks = (i4_wd + 7) >> 3;
+  WORD32 i4_blk_row, k;
+
+  for (i4_blk_row = i4_start >> 3; (i4_blk_row << 3) < i4_end; i4_blk_row++) {
+    WORD32 i4_y = i4_blk_row << 3;
+    WORD32 i4_r0 = MAX(i4_start, i4_y) - i4_y;
+    WORD32 i4_r1 = MIN(i4_end, i4_y + 8) - i4_y;
+    WORD32 i4_ofst_row = i4_blk_row >> i4_ofst_shift;
+    WORD32 i4_yy = (i4_blk_row - (i4_ofst_row << i4_ofst_shift)) << 3;
+    WORD32 i4_cur_ofst = 0;
+    WORD32 i4_blk;
+    const UWORD8 *pu1_src_row = pu1_src + i4_y * i4_src_strd;
+
+    for (k = 0; k < i4_num_comps; k++) {
+      au4_seed[k] =
+          ps_fg->pu4_row_seed[(i4_chroma + k) * ps_fg->u4_max_rows +
+                              i4_ofst_row];
+      as_blk[k][0].pi1_pattern = NULL;
+      as_blk[k][0].i4_scale = 0;
+    }
+
+    for (i4_blk = 0; i4_blk < i4_num_blks; i4_blk += FG_SEG_BLKS) {
+      WORD32 i4_n = MIN(FG_SEG_BLKS, i4_num_blks - i4_blk);
+      /* Entry j is block i4_blk - 1 + j, the previous run set the first */
+      /* two of the later runs                                           */
+      WORD32 i4_j0 = i4_blk ? 2 : 1;
+      WORD32 i4_first_avg = i4_blk + i4_j0 - 1;
+      WORD32 i4_num_avg = MIN(i4_blk + i4_n + 1, i4_num_blks) - i4_first_avg;
+      WORD32 j, r;
+
+      if (i4_chroma)
+        ps_dec->pf_film_grain_avg_chroma(pu1_src_row + (i4_first_avg << 4),
+                                         i4_src_strd, i4_num_avg, au1_avg[0],
+                                         au1_avg[1]);
+      else
+        ps_dec->pf_film_grain_avg_luma(pu1_src_row + (i4_first_avg << 3),
+                                       i4_src_strd, i4_num_avg, au1_avg[0]);
+
+      for (j = i4_j0; j <= i4_n + 1; j++) {
+        WORD32 i4_b = i4_blk - 1 + j;
+        WORD32 i4_ofst_blk = i4_b >> i4_ofst_shift;
+        WORD32 i4_xx = (i4_b - (i4_ofst_blk << i4_ofst_shift)) << 3;
+
+        for (k = 0; k < i4_num_comps; k++) {
+          if (i4_b >= i4_num_blks) {
+            as_blk[k][j].pi1_pattern = NULL;
+            as_blk[k][j].i4_scale = 0;
+            continue;
+          }
+          if (i4_cur_ofst < i4_ofst_blk)
+            au4_seed[k] = ih264d_film_grain_prng(au4_seed[k]);
+          ih264d_film_grain_blk(ps_fg, i4_chroma + k, au1_avg[k][j - i4_j0],
+                                au4_seed[k], i4_yy, i4_xx, &as_blk[k][j]);
+        }
+        if (i4_b < i4_num_blks) i4_cur_ofst = i4_ofst_blk;
+      }
+
+      for (r = i4_r0; r < i4_r1; r++) {
+        UWORD8 *pu1_dst_row = pu1_dst + (i4_y + r) * i4_dst_strd;
+        WORD32 i4_x = i4_blk << 3;
+        WORD32 i4_cols = MIN(i4_n << 3, i4_wd - i4_x);
+
+        for (k = 0; k < i4_num_comps; k++) {
+          ps_dec->pf_film_grain_synth_row(ai2_grain[k], as_blk[k], i4_n + 2, r,
+                                          ps_fg->u4_shift);
+          ih264d_film_grain_smooth(ai2_grain[k], as_blk[k], i4_n, 0 == i4_blk);
+        }
+
+        if (0 == i4_chroma) {
+          ps_dec->pf_film_grain_blend(pu1_dst_row + i4_x, ai2_grain[0] + 8,
+                                      i4_cols);
+        } else if (NULL != pu1_dst_v) {
+          ps_dec->pf_film_grain_blend(pu1_dst_row + i4_x, ai2_grain[0] + 8,
+                                      i4_cols);
+          ps_dec->pf_film_grain_blend(
+              pu1_dst_v + (i4_y + r) * i4_dst_strd + i4_x, ai2_grain[1] + 8,
+              i4_cols);
+        } else {
+          ps_dec->pf_film_grain_blend_uv(pu1_dst_row + (i4_x << 1),
+                                         ai2_grain[i4_swap_uv] + 8,
+                                         ai2_grain[!i4_swap_uv] + 8, i4_cols);
+        }
+      }
+
+      for (k = 0; k < i4_num_comps; k++) {
+        as_blk[k][0] = as_blk[k][i4_n];
+        as_blk[k][1] = as_blk[k][i4_n + 1];
+      }
+    }
+  }
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264d_film_grain_apply                                  */
+/*                                                                           */
+/*  Description   : Adds grain to rows of the display buffer that were just  */
+/*                  format converted. The block averages are taken from the  */
+/*                  decoded picture                                          */
+/*                                                                           */
+/*  Inputs        : ps_dec        - decoder context                          */
+/*                  pv_disp_op    - display frame output                     */
+/*                  u4_start_y    - first luma row, even                     */
+/*                  u4_num_rows_y - number of luma rows, even                */
+/*                                                                           */
+/*****************************************************************************/
+void ih264d_film_grain_apply(dec_struct_t *ps_dec,
+                             ivd_get_display_frame_op_t *pv_disp_op,
+                             UWORD32 u4_start_y, UWORD32 u4_num_rows_y) {
+  film_grain_ctxt_t *ps_fg = ps_dec->ps_film_grain;
+  iv_yuv_buf_t *ps_src = &ps_dec->s_disp_frame_info;
+  iv_yuv_buf_t *ps_dst = &pv_disp_op->s_disp_frm_buf;
+  WORD32 i4_start = u4_start_y;
+  WORD32 i4_end = MIN(u4_start_y + u4_num_rows_y, ps_src->u4_y_ht);
+  WORD32 i4_wd = ps_src->u4_y_wd;
+
+  if ((NULL == ps_fg) || (0 == ps_fg->u4_apply) || (i4_start >= i4_end))
+    return;
+
+  if (ps_fg->au1_comp_present[0])
+    ih264d_film_grain_rows(ps_dec, 0, ps_src->pv_y_buf, ps_src->u4_y_strd,
+                           ps_dst->pv_y_buf, NULL, ps_dst->u4_y_strd, 0, i4_wd,
+                           i4_start, i4_end);
+
+  if (ps_fg->au1_comp_present[1] || ps_fg->au1_comp_present[2]) {
+    UWORD8 *pu1_dst_v = NULL;
+
+    if (IV_YUV_420P == pv_disp_op->e_output_format)
+      pu1_dst_v = ps_dst->pv_v_buf;
+    ih264d_film_grain_rows(
+        ps_dec, 1, ps_src->pv_u_buf, ps_src->u4_u_strd, ps_dst->pv_u_buf,
+        pu1_dst_v, ps_dst->u4_u_strd,
+        IV_YUV_420SP_VU == pv_disp_op->e_output_format, i4_wd >> 1,
+        i4_start >> 1, (i4_end + 1) >> 1);
+  }
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264d_film_grain_avg_luma                               */
+/*                                                                           */
+/*  Description   : Rounded averages of a row of 8x8 blocks                  */
+/*                                                                           */
+/*  Inputs        : pu1_src     - top left of the first block                */
+/*                  i4_strd     - stride                                     */
+/*                  i4_num_blks - number of blocks                           */
+/*  Outputs       : pu1_avg     - average of each block                      */
+/*                                                                           */
+/*****************************************************************************/
+void ih264d_film_grain_avg_luma(const UWORD8 *pu1_src, WORD32 i4_strd,
+                                WORD32 i4_num_blks, UWORD8 *pu1_avg) {
+  WORD32 b, y, x;
+
+  for (b = 0; b < i4_num_blks; b++) {
+    const UWORD8 *pu1_blk = pu1_src + (b << 3);
+    UWORD32 u4_sum = 0;
+
+    for (y = 0; y < 8; y++)
+      for (x = 0; x < 8; x++) u4_sum += pu1_blk[y * i4_strd + x];
+    pu1_avg[b] = (UWORD8) ((u4_sum + 32) >> 6);
+  }
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264d_film_grain_avg_chroma                             */
+/*                                                                           */
+/*  Description   : Rounded averages of a row of 8x8 blocks of interleaved   */
+/*                  chroma                                                   */
+/*                                                                           */
+/*  Inputs        : pu1_src     - top left of the first block                */
+/*                  i4_strd     - stride                                     */
+/*                  i4_num_blks - number of blocks                           */
+/*  Outputs       : pu1_avg_u   - average of each U block                    */
+/*                  pu1_avg_v   - average of each V block                    */
+/*                                                                           */
+/*****************************************************************************/
+void ih264d_film_grain_avg_chroma(const UWORD8 *pu1_src, WORD32 i4_strd,
+                                  WORD32 i4_num_blks, UWORD8 *pu1_avg_u,
+                                  UWORD8 *pu1_avg_v) {
+  WORD32 b, y, x;
+
+  for (b = 0; b < i4_num_blks; b++) {
+    const UWORD8 *pu1_blk = pu1_src + (b << 4);
+    UWORD32 u4_sum_u = 0, u4_sum_v = 0;
+
+    for (y = 0; y < 8; y++) {
+      for (x = 0; x < 16; x += 2) {
+        u4_sum_u += pu1_blk[y * i4_strd + x];
+        u4_sum_v += pu1_blk[y * i4_strd + x + 1];
+      }
+    }
+    pu1_avg_u[b] = (UWORD8) ((u4_sum_u + 32) >> 6);
+    pu1_avg_v[b] = (UWORD8) ((u4_sum_v + 32) >> 6);
+  }
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264d_film_grain_synth_row                              */
+/*                                                                           */
+/*  Description   : One row of grain of a run of 8x8 blocks, the pattern     */
+/*                  samples scaled and shifted down. Blocks without grain    */
+/*                  give zeros                                               */
+/*                                                                           */
+/*  Inputs        : ps_blk      - blocks                                     */
+/*                  i4_num_blks - number of blocks                           */
+/*                  i4_row      - row in the blocks                          */
+/*                  i4_shift    - right shift of the scaled samples          */
+/*  Outputs       : pi2_grain   - 8 samples per block                        */
+/*                                                                           */
+/*****************************************************************************/
+void ih264d_film_grain_synth_row(WORD16 *pi2_grain,
+                                 const film_grain_blk_t *ps_blk,
+                                 WORD32 i4_num_blks, WORD32 i4_row,
+                                 WORD32 i4_shift) {
+  WORD32 b, x;
+
+  for (b = 0; b < i4_num_blks; b++, pi2_grain += 8) {
+    const WORD8 *pi1_src = ps_blk[b].pi1_pattern;
+
+    if (NULL == pi1_src) {
+      memset(pi2_grain, 0, 8 * sizeof(WORD16));
+      continue;
+    }
+    pi1_src += i4_row * FG_PATTERN_SIZE;
+    for (x = 0; x < 8; x++)
+      pi2_grain[x] = (WORD16) ((ps_blk[b].i4_scale * pi1_src[x]) >> i4_shift);
+  }
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264d_film_grain_blend                                  */
+/*                                                                           */
+/*  Description   : Adds a row of grain to a row of samples                  */
+/*                                                                           */
+/*  Inputs        : pu1_dst   - samples                                      */
+/*                  pi2_grain - grain                                        */
+/*                  i4_wd     - number of samples                            */
+/*                                                                           */
+/*****************************************************************************/
+void ih264d_film_grain_blend(UWORD8 *pu1_dst, const WORD16 *pi2_grain,
+                             WORD32 i4_wd) {
+  WORD32 x;
+
+  for (x = 0; x < i4_wd; x++) pu1_dst[x] = CLIP_U8(pu1_dst[x] + pi2_grain[x]);
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264d_film_grain_blend_uv                               */
+/*                                                                           */
+/*  Description   : Adds rows of grain of two components to a row of         */
+/*                  interleaved samples                                      */
+/*                                                                           */
+/*  Inputs        : pu1_dst     - interleaved samples                        */
+/*                  pi2_grain_u - grain of the first component               */
+/*                  pi2_grain_v - grain of the second component              */
+/*                  i4_wd       - number of samples of a component           */
+/*                                                                           */
+/*****************************************************************************/
+void ih264d_film_grain_blend_uv(UWORD8 *pu1_dst, const WORD16 *pi2_grain_u,
+                                const WORD16 *pi2_grain_v, WORD32 i4_wd) {
+  WORD32 x;
+
+  for (x = 0; x < i4_wd; x++) {
+    pu1_dst[2 * x] = CLIP_U8(pu1_dst[2 * x] + pi2_grain_u[x]);
+    pu1_dst[2 * x + 1] = CLIP_U8(pu1_dst[2 * x + 1] + pi2_grain_v[x]);
+  }
+}
@@ -0,0 +1,117 @@
+/* Copyright (c) [2020]-[2023] Ittiam Systems Pvt. Ltd.
+   All rights reserved.
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted (subject to the limitations in the
+   disclaimer below) provided that the following conditions are met:
+   •    Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+   •    Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+   •    None of the names of Ittiam Systems Pvt. Ltd., its affiliates,
+   investors, business partners, nor the names of its contributors may be
+   used to endorse or promote products derived from this software without
+   specific prior written permission.
+
+   NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED
+   BY THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+   BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+   FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+   HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+   OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+   WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+   OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+   EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+   This Software is an implementation of the AVC/H.264
+   standard by Ittiam Systems Pvt. Ltd. (“Ittiam”).
+   Additional patent licenses may be required for this Software,
+   including, but not limited to, a license from MPEG LA’s AVC/H.264
+   licensing program (see https://www.mpegla.com/programs/avc-h-264/).
+
+   NOTWITHSTANDING ANYTHING TO THE CONTRARY, THIS DOES NOT GRANT ANY
+   EXPRESS OR IMPLIED LICENSES TO ANY PATENT CLAIMS OF ANY AFFILIATE
+   (TO THE EXTENT NOT IN THE LEGAL ENTITY), INVESTOR, OR OTHER
+   BUSINESS PARTNER OF ITTIAM. You may only use this software or
+   modifications thereto for purposes that are authorized by
+   appropriate patent licenses. You should seek legal advice based
+   upon your implementation details.
+
+---------------------------------------------------------------
+*/
+/*****************************************************************************/
+/*                                                                           */
+/*  File Name         : ih264d_film_grain.h                                  */
+/*                                                                           */
+/*  Description       : Functions synthesising the film grain of film grain  */
+/*                      characteristics SEI and adding it to the display     */
+/*                      buffer during format conversion                      */
+/*                                                                           */
+/*  List of Functions : ih264d_film_grain_init()                             */
+/*                      ih264d_film_grain_pic_init()                         */
+/*                      ih264d_film_grain_apply()                            */
+/*                      ih264d_film_grain_avg_luma()                         */
+/*                      ih264d_film_grain_avg_chroma()                       */
+/*                      ih264d_film_grain_synth_row()                        */
+/*                      ih264d_film_grain_blend()                            */
+/*                      ih264d_film_grain_blend_uv()                         */
+/*                                                                           */
+/*  Issues / Problems : None                                                 */
+/*                                                                           */
+/*****************************************************************************/
+
+#ifndef _IH264D_FILM_GRAIN_H_
+#define _IH264D_FILM_GRAIN_H_
+
+film_grain_ctxt_t *ih264d_film_grain_init(dec_struct_t *ps_dec, void *pv_buf,
+                                          UWORD32 u4_max_rows);
+
+void ih264d_film_grain_pic_init(dec_struct_t *ps_dec, sei *ps_sei,
+                                IV_COLOR_FORMAT_T e_output_format);
+
+void ih264d_film_grain_apply(dec_struct_t *ps_dec,
+                             ivd_get_display_frame_op_t *pv_disp_op,
+                             UWORD32 u4_start_y, UWORD32 u4_num_rows_y);
+
+/* Kernels, selected through the function pointers of dec_struct_t */
+void ih264d_film_grain_avg_luma(const UWORD8 *pu1_src, WORD32 i4_strd,
+                                WORD32 i4_num_blks, UWORD8 *pu1_avg);
+
+void ih264d_film_grain_avg_chroma(const UWORD8 *pu1_src, WORD32 i4_strd,
+                                  WORD32 i4_num_blks, UWORD8 *pu1_avg_u,
+                                  UWORD8 *pu1_avg_v);
+
+void ih264d_film_grain_synth_row(WORD16 *pi2_grain,
+                                 const film_grain_blk_t *ps_blk,
+                                 WORD32 i4_num_blks, WORD32 i4_row,
+                                 WORD32 i4_shift);
+
+void ih264d_film_grain_blend(UWORD8 *pu1_dst, const WORD16 *pi2_grain,
+                             WORD32 i4_wd);
+
+void ih264d_film_grain_blend_uv(UWORD8 *pu1_dst, const WORD16 *pi2_grain_u,
+                                const WORD16 *pi2_grain_v, WORD32 i4_wd);
+
+void ih264d_film_grain_avg_luma_sse42(const UWORD8 *pu1_src, WORD32 i4_strd,
+                                      WORD32 i4_num_blks, UWORD8 *pu1_avg);
+
+void ih264d_film_grain_avg_chroma_sse42(const UWORD8 *pu1_src, WORD32 i4_strd,
+                                        WORD32 i4_num_blks, UWORD8 *pu1_avg_u,
+                                        UWORD8 *pu1_avg_v);
+
+void ih264d_film_grain_synth_row_sse42(WORD16 *pi2_grain,
+                                       const film_grain_blk_t *ps_blk,
+                                       WORD32 i4_num_blks, WORD32 i4_row,
+                                       WORD32 i4_shift);
+
+void ih264d_film_grain_blend_sse42(UWORD8 *pu1_dst, const WORD16 *pi2_grain,
+                                   WORD32 i4_wd);
+
+void ih264d_film_grain_blend_uv_sse42(UWORD8 *pu1_dst,
+                                      const WORD16 *pi2_grain_u,
+                                      const WORD16 *pi2_grain_v, WORD32 i4_wd);
+
+#endif /* _IH264D_FILM_GRAIN_H_ */
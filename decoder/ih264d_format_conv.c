@@ -71,6 +71,7 @@
 #include "ih264d_structs.h"
 #include "ih264d_format_conv.h"
 #include "ih264d_defs.h"
+#include "ih264d_film_grain.h"
 
 #ifdef LOGO_EN
 #include "ih264d_ittiam_logo.h"
@@ -609,31 +610,25 @@ void ih264d_fmt_conv_420sp_to_420p(UWORD8 *pu1_y_src, UWORD8 *pu1_uv_src,
 }
 
 /*****************************************************************************/
-/*  Function Name : ih264d_format_convert */
-/*                                                                           */
-/*  Description   : Implements format conversion/frame copy                  */
-/*  Inputs        : ps_dec - Decoder parameters                              */
-/*  Globals       : None                                                     */
-/*  Processing    : Refer bumping process in the standard                    */
-/*  Outputs       : Assigns display sequence number.                         */
-/*  Returns       : None                                                     */
 /*                                                                           */
-/*  Issues        : None                                                     */
+/*  Function Name : ih264d_format_convert_rows                               */
 /*                                                                           */
-/*  Revision History:                                                        */
+/*  Description   : Converts rows of the display picture to the output       */
+/*                  format                                                   */
 /*                                                                           */
-/*         DD MM YYYY   Author(s)       Changes (Describe the changes made)  */
-/*         27 04 2005   NS              Draft                                */
+/*  Inputs        : ps_dec        - decoder context                          */
+/*                  pv_disp_op    - display frame output                     */
+/*                  u4_start_y    - first luma row, even                     */
+/*                  u4_num_rows_y - number of luma rows                      */
 /*                                                                           */
 /*****************************************************************************/
-void ih264d_format_convert(dec_struct_t *ps_dec,
-                           ivd_get_display_frame_op_t *pv_disp_op,
-                           UWORD32 u4_start_y, UWORD32 u4_num_rows_y) {
+static void ih264d_format_convert_rows(dec_struct_t *ps_dec,
+                                       ivd_get_display_frame_op_t *pv_disp_op,
+                                       UWORD32 u4_start_y,
+                                       UWORD32 u4_num_rows_y) {
   UWORD32 convert_uv_only = 0;
   iv_yuv_buf_t *ps_op_frm;
 
-  if (1 == pv_disp_op->u4_error_code) return;
-
   ps_op_frm = &(ps_dec->s_disp_frame_info);
 
   /* Requires u4_start_y and u4_num_rows_y to be even */
@@ -644,10 +639,6 @@ void ih264d_format_convert(dec_struct_t *ps_dec,
     return;
   }
 
-  if ((1 == ps_dec->u4_share_disp_buf) &&
-      ((pv_disp_op->e_output_format == IV_YUV_420SP_UV))) {
-    return;
-  }
   if (pv_disp_op->e_output_format == IV_YUV_420P) {
     UWORD32 start_uv = u4_start_y >> 1;
 
@@ -689,10 +680,10 @@ void ih264d_format_convert(dec_struct_t *ps_dec,
 
       width = ps_op_frm->u4_y_wd;
       height = u4_num_rows_y;
-      ih264d_fmt_conv_420sp_to_420p(pu1_y_src, pu1_u_src, pu1_y_dst, pu1_u_dst,
-                                    pu1_v_dst, width, height, src_luma_stride,
-                                    src_chroma_stride, dst_luma_stride,
-                                    dst_chroma_stride, 1, convert_uv_only);
+      ps_dec->pf_fmt_conv_420sp_to_420p(
+          pu1_y_src, pu1_u_src, pu1_y_dst, pu1_u_dst, pu1_v_dst, width, height,
+          src_luma_stride, src_chroma_stride, dst_luma_stride,
+          dst_chroma_stride, 1, convert_uv_only);
     }
   }
 
@@ -714,7 +705,7 @@ void ih264d_format_convert(dec_struct_t *ps_dec,
           ps_op_frm->u4_u_strd, pv_disp_op->s_disp_frm_buf.u4_y_strd,
           pv_disp_op->s_disp_frm_buf.u4_u_strd);
     } else {
-      ih264d_fmt_conv_420sp_to_420sp_swap_uv(
+      ps_dec->pf_fmt_conv_420sp_to_420sp_swap_uv(
           (UWORD8 *) ps_op_frm->pv_y_buf + u4_start_y * ps_op_frm->u4_y_strd,
           ((UWORD8 *) ps_op_frm->pv_u_buf + start_uv * ps_op_frm->u4_u_strd),
           ((UWORD8 *) pv_disp_op->s_disp_frm_buf.pv_y_buf +
@@ -736,6 +727,52 @@ void ih264d_format_convert(dec_struct_t *ps_dec,
         ps_op_frm->u4_y_wd, u4_num_rows_y, ps_op_frm->u4_y_strd,
         ps_op_frm->u4_u_strd, pv_disp_op->s_disp_frm_buf.u4_y_strd, 1);
   }
+}
+
+/*****************************************************************************/
+/*  Function Name : ih264d_format_convert */
+/*                                                                           */
+/*  Description   : Implements format conversion/frame copy. Film grain is   */
+/*                  added to every FG_CONV_ROWS rows right after they are    */
+/*                  converted, while they are still in the cache             */
+/*  Inputs        : ps_dec - Decoder parameters                              */
+/*  Globals       : None                                                     */
+/*  Processing    : Refer bumping process in the standard                    */
+/*  Outputs       : Assigns display sequence number.                         */
+/*  Returns       : None                                                     */
+/*                                                                           */
+/*  Issues        : None                                                     */
+/*                                                                           */
+/*  Revision History:                                                        */
+/*                                                                           */
+/*         DD MM YYYY   Author(s)       Changes (Describe the changes made)  */
+/*         27 04 2005   NS              Draft                                */
+/*                                                                           */
+/*****************************************************************************/
+void ih264d_format_convert(dec_struct_t *ps_dec,
+                           ivd_get_display_frame_op_t *pv_disp_op,
+                           UWORD32 u4_start_y, UWORD32 u4_num_rows_y) {
+  film_grain_ctxt_t *ps_fg = ps_dec->ps_film_grain;
+
+  if (1 == pv_disp_op->u4_error_code) return;
+
+  if ((1 == ps_dec->u4_share_disp_buf) &&
+      ((pv_disp_op->e_output_format == IV_YUV_420SP_UV))) {
+    return;
+  }
+
+  if ((NULL != ps_fg) && ps_fg->u4_apply && (0 == (u4_start_y & 1))) {
+    UWORD32 u4_end_y = u4_start_y + u4_num_rows_y;
+    UWORD32 u4_y, u4_rows;
+
+    for (u4_y = u4_start_y; u4_y < u4_end_y; u4_y += u4_rows) {
+      u4_rows = MIN(FG_CONV_ROWS, u4_end_y - u4_y);
+      ih264d_format_convert_rows(ps_dec, pv_disp_op, u4_y, u4_rows);
+      ih264d_film_grain_apply(ps_dec, pv_disp_op, u4_y, u4_rows);
+    }
+  } else {
+    ih264d_format_convert_rows(ps_dec, pv_disp_op, u4_start_y, u4_num_rows_y);
+  }
 
   if ((u4_start_y + u4_num_rows_y) >= ps_dec->s_disp_frame_info.u4_y_ht) {
     INSERT_LOGO(pv_disp_op->s_disp_frm_buf.pv_y_buf,
@@ -743,7 +780,8 @@ void ih264d_format_convert(dec_struct_t *ps_dec,
                 pv_disp_op->s_disp_frm_buf.pv_v_buf,
                 pv_disp_op->s_disp_frm_buf.u4_y_strd, ps_dec->u2_disp_width,
                 ps_dec->u2_disp_height, pv_disp_op->e_output_format,
-                ps_op_frm->u4_y_wd, ps_op_frm->u4_y_ht);
+                ps_dec->s_disp_frame_info.u4_y_wd,
+                ps_dec->s_disp_frame_info.u4_y_ht);
   }
 
   return;
@@ -113,6 +113,17 @@ void ih264d_fmt_conv_420sp_to_rgb565(UWORD8 *pu1_y_src, UWORD8 *pu1_uv_src,
 #define COEFF3 -6664
 #define COEFF4 16530
 
+void ih264d_fmt_conv_420sp_to_420p_simd128(
+    UWORD8 *pu1_y_src, UWORD8 *pu1_uv_src, UWORD8 *pu1_y_dst,
+    UWORD8 *pu1_u_dst, UWORD8 *pu1_v_dst, WORD32 wd, WORD32 ht,
+    WORD32 src_y_strd, WORD32 src_uv_strd, WORD32 dst_y_strd,
+    WORD32 dst_uv_strd, WORD32 is_u_first, WORD32 disable_luma_copy);
+
+void ih264d_fmt_conv_420sp_to_420sp_swap_uv_simd128(
+    UWORD8 *pu1_y_src, UWORD8 *pu1_uv_src, UWORD8 *pu1_y_dst,
+    UWORD8 *pu1_uv_dst, WORD32 wd, WORD32 ht, WORD32 src_y_strd,
+    WORD32 src_uv_strd, WORD32 dst_y_strd, WORD32 dst_uv_strd);
+
 void ih264d_format_convert(dec_struct_t *ps_dec,
                            ivd_get_display_frame_op_t *pv_disp_op,
                            UWORD32 u4_start_y, UWORD32 u4_num_rows_y);
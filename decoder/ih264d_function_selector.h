@@ -81,6 +81,8 @@
 #define D_ARCH_X86_AVX2 14
 #define D_ARCH_MIPS_GENERIC 15
 #define D_ARCH_MIPS_32 16
+#define D_ARCH_WASM_GENERIC 17
+#define D_ARCH_WASM_SIMD128 18
 
 void ih264d_init_arch(dec_struct_t *ps_codec);
 
@@ -89,6 +91,7 @@ void ih264d_init_function_ptr(dec_struct_t *ps_codec);
 void ih264d_init_function_ptr_generic(dec_struct_t *ps_codec);
 void ih264d_init_function_ptr_ssse3(dec_struct_t *ps_codec);
 void ih264d_init_function_ptr_sse42(dec_struct_t *ps_codec);
+void ih264d_init_function_ptr_simd128(dec_struct_t *ps_codec);
 
 #ifndef DISABLE_AVX2
 void ih264d_init_function_ptr_avx2(dec_struct_t *ps_codec);
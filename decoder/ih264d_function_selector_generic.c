@@ -83,6 +83,10 @@
 #include "ih264_inter_pred_filters.h"
 
 #include "ih264d_structs.h"
+#include "ih264d_deblocking.h"
+#include "ih264d_process_intra_mb.h"
+#include "ih264d_film_grain.h"
+#include "ih264d_format_conv.h"
 #include "ih264d_function_selector.h"
 
 /**
@@ -175,6 +179,10 @@ void ih264d_init_function_ptr_generic(dec_struct_t *ps_codec) {
   ps_codec->pf_iquant_itrans_recon_chroma_4x4_dc =
       ih264_iquant_itrans_recon_chroma_4x4_dc;
   ps_codec->pf_ihadamard_scaling_4x4 = ih264_ihadamard_scaling_4x4;
+  ps_codec->pf_iquant_itrans_recon_luma_4x4_mb =
+      ih264d_iquant_itrans_recon_luma_4x4_mb;
+  ps_codec->pf_iquant_itrans_recon_chroma_4x4_mb =
+      ih264d_iquant_itrans_recon_chroma_4x4_mb;
 
   /* Init fn ptr luma deblocking */
   ps_codec->pf_deblk_luma_vert_bs4 = ih264_deblk_luma_vert_bs4;
@@ -195,6 +203,18 @@ void ih264d_init_function_ptr_generic(dec_struct_t *ps_codec) {
   ps_codec->pf_deblk_chroma_horz_bs4 = ih264_deblk_chroma_horz_bs4;
   ps_codec->pf_deblk_chroma_horz_bslt4 = ih264_deblk_chroma_horz_bslt4;
 
+  ps_codec->pf_deblk_row_nonmbaff = ih264d_deblk_row_nonmbaff;
+
+  ps_codec->pf_film_grain_avg_luma = ih264d_film_grain_avg_luma;
+  ps_codec->pf_film_grain_avg_chroma = ih264d_film_grain_avg_chroma;
+  ps_codec->pf_film_grain_synth_row = ih264d_film_grain_synth_row;
+  ps_codec->pf_film_grain_blend = ih264d_film_grain_blend;
+  ps_codec->pf_film_grain_blend_uv = ih264d_film_grain_blend_uv;
+
+  ps_codec->pf_fmt_conv_420sp_to_420p = ih264d_fmt_conv_420sp_to_420p;
+  ps_codec->pf_fmt_conv_420sp_to_420sp_swap_uv =
+      ih264d_fmt_conv_420sp_to_420sp_swap_uv;
+
   /* Inter pred leaf level functions */
   ps_codec->apf_inter_pred_luma[0] = ih264_inter_pred_luma_copy;
   ps_codec->apf_inter_pred_luma[1] = ih264_inter_pred_luma_horz_qpel;
@@ -215,5 +235,12 @@ void ih264d_init_function_ptr_generic(dec_struct_t *ps_codec) {
 
   ps_codec->pf_inter_pred_chroma = ih264_inter_pred_chroma;
 
+  /* Bs calculation functions for P and B, 16x16/non16x16 */
+  ps_codec->pf_fill_bs1[0][0] = ih264d_fill_bs1_16x16mb_pslice;
+  ps_codec->pf_fill_bs1[0][1] = ih264d_fill_bs1_non16x16mb_pslice;
+
+  ps_codec->pf_fill_bs1[1][0] = ih264d_fill_bs1_16x16mb_bslice;
+  ps_codec->pf_fill_bs1[1][1] = ih264d_fill_bs1_non16x16mb_bslice;
+
   return;
 }
@@ -218,8 +218,8 @@ WORD32 ih264d_form_mb_part_info_bp(pred_info_pkd_t *ps_pred_pkd,
   GET_YPOS_PRED(u1_sub_y, i1_size_pos_info);
   GET_WIDTH_PRED(u1_part_wd, i1_size_pos_info);
   GET_HEIGHT_PRED(u1_part_ht, i1_size_pos_info);
-  i2_mv_x = ps_pred_pkd->i2_mv[0];
-  i2_mv_y = ps_pred_pkd->i2_mv[1];
+  i2_mv_x = ps_pred_pkd->i2_mv[0] & ps_dec->i4_mv_frac_mask;
+  i2_mv_y = ps_pred_pkd->i2_mv[1] & ps_dec->i4_mv_frac_mask;
   i1_buf_id = ps_pred_pkd->i1_buf_id;
 
   ps_ref_frm = ps_dec->apv_buf_id_pic_buf_map[i1_buf_id];
@@ -493,8 +493,8 @@ WORD32 ih264d_form_mb_part_info_mp(pred_info_pkd_t *ps_pred_pkd,
   GET_YPOS_PRED(u1_sub_y, i1_size_pos_info);
   GET_WIDTH_PRED(u1_part_wd, i1_size_pos_info);
   GET_HEIGHT_PRED(u1_part_ht, i1_size_pos_info);
-  i2_mv_x = ps_pred_pkd->i2_mv[0];
-  i2_mv_y = ps_pred_pkd->i2_mv[1];
+  i2_mv_x = ps_pred_pkd->i2_mv[0] & ps_dec->i4_mv_frac_mask;
+  i2_mv_y = ps_pred_pkd->i2_mv[1] & ps_dec->i4_mv_frac_mask;
   i1_ref_idx = ps_pred_pkd->i1_ref_idx_info & 0x3f;
   i1_buf_id = ps_pred_pkd->i1_buf_id;
   ps_ref_frm = ps_dec->apv_buf_id_pic_buf_map[i1_buf_id];
@@ -825,6 +825,120 @@ WORD32 ih264d_form_mb_part_info_mp(pred_info_pkd_t *ps_pred_pkd,
   return OK;
 }
 
+/*****************************************************************************/
+/* \if Function name : ih264d_prefetch_mb_ref \endif                         */
+/*                                                                           */
+/* \brief                                                                    */
+/*    Issues software prefetches for the luma and chroma reference regions   */
+/*    of all partitions of an inter MB, so that the lines are in cache by    */
+/*    the time the MC of that MB is done                                     */
+/*                                                                           */
+/* \return                                                                   */
+/*    None                                                                   */
+/* \note                                                                     */
+/*    Addresses are derived the same way as in ih264d_form_mb_part_info_mp  */
+/*    but no state in ps_dec is updated. Pad on demand regions are not      */
+/*    prefetched separately, the clipped region is                          */
+/*****************************************************************************/
+void ih264d_prefetch_mb_ref(dec_struct_t *ps_dec,
+                            dec_mb_info_t *ps_cur_mb_info) {
+  pred_info_pkd_t *ps_pred_pkd;
+  struct pic_buffer_t *ps_ref_frm;
+  UWORD8 *pu1_ref, *pu1_ref_uv;
+  UWORD32 u4_pred_info_pkd_idx;
+  WORD32 pred_cnt, i4_row;
+  WORD32 i4_frm_x, i4_frm_y, i4_mc_wd, i4_mc_ht;
+  WORD32 i4_frm_wd_y, i4_frm_wd_uv, i4_pic_ht;
+  UWORD8 u1_sub_x, u1_sub_y, u1_part_wd, u1_part_ht;
+  WORD8 i1_size_pos_info;
+  WORD16 i2_mv_x, i2_mv_y;
+  const UWORD32 u1_pic_fld = ps_dec->ps_cur_slice->u1_field_pic_flag;
+  UWORD32 u1_mb_fld = 0, u1_mb_bot = 0;
+
+  if (!u1_pic_fld) {
+    u1_mb_fld = ps_cur_mb_info->u1_mb_field_decodingflag;
+    u1_mb_bot = 1 - ps_cur_mb_info->u1_topmb;
+  }
+
+  i4_pic_ht = ps_dec->u2_pic_ht >> u1_pic_fld;
+  i4_frm_wd_y = ps_dec->u2_frm_wd_y << u1_pic_fld;
+  i4_frm_wd_uv = ps_dec->u2_frm_wd_uv << u1_pic_fld;
+
+  u4_pred_info_pkd_idx = ps_cur_mb_info->u4_pred_info_pkd_idx;
+
+  for (pred_cnt = 0; pred_cnt < ps_cur_mb_info->u1_num_pred_parts;
+       pred_cnt++) {
+    ps_pred_pkd = ps_dec->ps_pred_pkd + u4_pred_info_pkd_idx + pred_cnt;
+
+    i1_size_pos_info = ps_pred_pkd->i1_size_pos_info;
+    GET_XPOS_PRED(u1_sub_x, i1_size_pos_info);
+    GET_YPOS_PRED(u1_sub_y, i1_size_pos_info);
+    GET_WIDTH_PRED(u1_part_wd, i1_size_pos_info);
+    GET_HEIGHT_PRED(u1_part_ht, i1_size_pos_info);
+    i2_mv_x = ps_pred_pkd->i2_mv[0];
+    i2_mv_y = ps_pred_pkd->i2_mv[1];
+
+    ps_ref_frm = ps_dec->apv_buf_id_pic_buf_map[ps_pred_pkd->i1_buf_id];
+    if (NULL == ps_ref_frm) continue;
+
+    pu1_ref = ps_ref_frm->pu1_buf1;
+    pu1_ref_uv = ps_ref_frm->pu1_buf2;
+    if ((ps_pred_pkd->u1_pic_type & PIC_MASK) == BOT_FLD) {
+      pu1_ref += ps_ref_frm->u2_frm_wd_y;
+      pu1_ref_uv += ps_ref_frm->u2_frm_wd_uv;
+    }
+
+    /* Luma: region read by the 6 tap filter */
+    i4_mc_wd = u1_part_wd << 2;
+    i4_mc_ht = u1_part_ht << 2;
+    i4_frm_x = (ps_cur_mb_info->u2_mbx << 4) + (u1_sub_x << 2) + (i2_mv_x >> 2);
+    i4_frm_y = (i2_mv_y >> 2) + (u1_sub_y << 2);
+    if (i2_mv_x & 0x3) {
+      i4_frm_x -= 2;
+      i4_mc_wd += 5;
+    }
+    if (i2_mv_y & 0x3) {
+      i4_frm_y -= 2;
+      i4_mc_ht += 5;
+    }
+    i4_frm_y = ((ps_cur_mb_info->u2_mby + (u1_mb_bot && !u1_mb_fld)) << 4) +
+               (i4_frm_y << u1_mb_fld);
+
+    i4_frm_x =
+        CLIP3(MAX_OFFSET_OUTSIDE_X_FRM, (ps_dec->u2_pic_wd - 1), i4_frm_x);
+    i4_frm_y = CLIP3(((1 - i4_mc_ht) << u1_mb_fld),
+                     (i4_pic_ht - (1 << u1_mb_fld)), i4_frm_y);
+
+    pu1_ref += i4_frm_y * i4_frm_wd_y + i4_frm_x;
+    for (i4_row = 0; i4_row < i4_mc_ht; i4_row++) {
+      PREFETCH((const char *) pu1_ref, _MM_HINT_T0)
+      PREFETCH((const char *) (pu1_ref + i4_mc_wd - 1), _MM_HINT_T0)
+      pu1_ref += i4_frm_wd_y << u1_mb_fld;
+    }
+
+    /* Chroma: interleaved UV, one extra row and column for 1/8 pel MVs */
+    i4_mc_wd = (u1_part_wd << 1) + 1;
+    i4_mc_ht = (u1_part_ht << 1) + 1;
+    i4_frm_x = (ps_cur_mb_info->u2_mbx << 3) + (u1_sub_x << 1) +
+               SIGN_POW2_DIV(i2_mv_x, 3);
+    i4_frm_y = ((ps_cur_mb_info->u2_mby + (u1_mb_bot && !u1_mb_fld)) << 3) +
+               (((u1_sub_y << 1) + SIGN_POW2_DIV(i2_mv_y, 3)) << u1_mb_fld);
+
+    i4_frm_x = CLIP3(MAX_OFFSET_OUTSIDE_UV_FRM, ((ps_dec->u2_pic_wd >> 1) - 1),
+                     i4_frm_x);
+    i4_frm_y = CLIP3(((1 - i4_mc_ht) << u1_mb_fld),
+                     ((i4_pic_ht >> 1) - (1 << u1_mb_fld)), i4_frm_y);
+
+    pu1_ref_uv += i4_frm_y * i4_frm_wd_uv + i4_frm_x * YUV420SP_FACTOR;
+    i4_mc_wd *= YUV420SP_FACTOR;
+    for (i4_row = 0; i4_row < i4_mc_ht; i4_row++) {
+      PREFETCH((const char *) pu1_ref_uv, _MM_HINT_T0)
+      PREFETCH((const char *) (pu1_ref_uv + i4_mc_wd - 1), _MM_HINT_T0)
+      pu1_ref_uv += i4_frm_wd_uv << u1_mb_fld;
+    }
+  }
+}
+
 /*!
  **************************************************************************
  * \if Function name : MotionCompensate \endif
@@ -96,6 +96,9 @@ WORD32 ih264d_form_mb_part_info_mp(pred_info_pkd_t *ps_pred_pkd,
                                    UWORD16 u2_mb_y, WORD32 mb_index,
                                    dec_mb_info_t *ps_cur_mb_info);
 
+void ih264d_prefetch_mb_ref(dec_struct_t *ps_dec,
+                            dec_mb_info_t *ps_cur_mb_info);
+
 void ih264d_motion_compensate_bp(dec_struct_t *ps_dec,
                                  dec_mb_info_t *ps_cur_mb_info);
 void ih264d_motion_compensate_mp(dec_struct_t *ps_dec,
@@ -81,6 +81,7 @@
 #include "ih264d_mvpred.h"
 #include "ih264d_cabac.h"
 #include "ih264d_utils.h"
+#include "ih264d_perf_stats.h"
 
 void ih264d_init_cabac_contexts(UWORD8 u1_slice_type, dec_struct_t *ps_dec);
 
@@ -748,8 +749,13 @@ WORD32 ih264d_parse_bmb_cavlc(dec_struct_t *ps_dec,
     *pu4_bitstrm_ofst = u4_bitstream_offset;
     u4_cbp = ((1 << u4_ldz) + u4_word - 1);
     // Inlined ih264d_uev
-    if (u4_cbp > 47) return ERROR_CBP;
-    u4_cbp = puc_CbpInter[u4_cbp];
+    if (IS_MONOCHROME(ps_dec)) {
+      if (u4_cbp > 15) return ERROR_CBP;
+      u4_cbp = gau1_ih264d_cbp_table_gray[u4_cbp][1];
+    } else {
+      if (u4_cbp > 47) return ERROR_CBP;
+      u4_cbp = puc_CbpInter[u4_cbp];
+    }
 
     if ((ps_dec->s_high_profile.u1_transform8x8_present) && (u4_cbp & (0xf)) &&
         (ps_dec->s_high_profile.u1_no_submb_part_size_lt8x8_flag) &&
@@ -1051,9 +1057,12 @@ WORD32 ih264d_mv_pred_ref_tfr_nby2_bmb(dec_struct_t *ps_dec, UWORD8 u1_mb_idx,
 
     /*if num _cores is set to 3 ,compute bs will be done in another thread*/
     if (ps_dec->u4_num_cores < 3) {
-      if (ps_dec->u4_app_disable_deblk_frm == 0)
+      if (ps_dec->u4_app_disable_deblk_frm == 0) {
+        PERF_STAGE_BEGIN(ps_dec, PERF_SLOT_MAIN, IH264D_PERF_STAGE_BS);
         ps_dec->pf_compute_bs(ps_dec, ps_cur_mb_info,
                               (UWORD16) (i >> u1_mbaff));
+        PERF_STAGE_END(ps_dec, PERF_SLOT_MAIN, IH264D_PERF_STAGE_BS);
+      }
     }
   }
   return OK;
@@ -1389,7 +1398,8 @@ WORD32 ih264d_parse_bslice(dec_struct_t *ps_dec, UWORD16 u2_first_mb_in_slice) {
   }
 
   if (ps_pps->u1_wted_bipred_idc == 1) {
-    ret = ih264d_parse_pred_weight_table(ps_slice, ps_bitstrm);
+    ret = ih264d_parse_pred_weight_table(ps_slice, ps_bitstrm,
+                                         !IS_MONOCHROME(ps_dec));
     if (ret != OK) return ret;
     ih264d_form_pred_weight_matrix(ps_dec);
     ps_dec->pu4_wt_ofsts = ps_dec->pu4_wts_ofsts_mat;
@@ -136,6 +136,9 @@ UWORD8 ih264d_read_coeff4x4_cabac(
       CHECK_IF_LPS(u4_code_int_range, u4_code_int_val_ofst, u4_symbol,
                    u4_int_range_lps, u1_mps_state, table_lookup)
 
+      INC_BIN_COUNT(ps_cab_env);
+      INC_DECISION_BINS(ps_cab_env);
+
       if (u4_code_int_range < ONE_RIGHT_SHIFTED_BY_8) {
         RENORM_RANGE_OFFSET(u4_code_int_range, u4_code_int_val_ofst, u4_offset,
                             pu4_buffer)
@@ -208,7 +211,7 @@ UWORD8 ih264d_read_coeff4x4_cabac(
             u4_code_int_val_ofst = (u4_code_int_val_ofst << u4_clz) | read_bits;
           }
 
-          INC_BIN_COUNT(ps_cab_env)
+          INC_BIN_COUNT(ps_cab_env);
 
           ps_ctxt_sig_coeff->u1_mps_state = u1_mps_state;
           uc_bin = u4_symbol;
@@ -252,7 +255,7 @@ UWORD8 ih264d_read_coeff4x4_cabac(
             CHECK_IF_LPS(u4_code_int_range, u4_code_int_val_ofst, u4_symbol,
                          u4_int_range_lps, u1_mps_state, table_lookup)
 
-            INC_BIN_COUNT(ps_cab_env)
+            INC_BIN_COUNT(ps_cab_env);
 
             p_binCtxt_last->u1_mps_state = u1_mps_state;
             uc_bin = u4_symbol;
@@ -484,6 +487,9 @@ UWORD8 ih264d_read_coeff4x4_cabac(
               u4_code_int_val_ofst -= u4_code_int_range;
               i2_abs_lvl = (-i2_abs_lvl);
             }
+
+            INC_BIN_COUNT(ps_cab_env);
+            INC_BYPASS_BINS(ps_cab_env);
           }
           num_sig_coeffs--;
           *pi2_coeff_data++ = i2_abs_lvl;
@@ -615,6 +621,9 @@ void ih264d_read_coeff8x8_cabac(
       CHECK_IF_LPS(u4_code_int_range, u4_code_int_val_ofst, u4_symbol,
                    u4_int_range_lps, u1_mps_state, table_lookup)
 
+      INC_BIN_COUNT(ps_cab_env);
+      INC_DECISION_BINS(ps_cab_env);
+
       if (u4_code_int_range < ONE_RIGHT_SHIFTED_BY_14) {
         UWORD32 read_bits, u4_clz;
         u4_clz = CLZ(u4_code_int_range);
@@ -664,6 +673,9 @@ void ih264d_read_coeff8x8_cabac(
         CHECK_IF_LPS(u4_code_int_range, u4_code_int_val_ofst, u4_symbol,
                      u4_int_range_lps, u1_mps_state, table_lookup)
 
+        INC_BIN_COUNT(ps_cab_env);
+        INC_DECISION_BINS(ps_cab_env);
+
         p_binCtxt_last->u1_mps_state = u1_mps_state;
         uc_bin = u4_symbol;
       }
@@ -739,6 +751,9 @@ label_read_levels:;
             CHECK_IF_LPS(u4_code_int_range, u4_code_int_val_ofst, u4_symbol,
                          u4_int_range_lps, u1_mps_state, table_lookup)
 
+            INC_BIN_COUNT(ps_cab_env);
+            INC_DECISION_BINS(ps_cab_env);
+
             if (u4_code_int_range < ONE_RIGHT_SHIFTED_BY_9) {
               RENORM_RANGE_OFFSET(u4_code_int_range, u4_code_int_val_ofst,
                                   u4_offset, pu4_buffer)
@@ -795,6 +810,9 @@ label_read_levels:;
               uc_bin = 0;
             }
 
+            INC_BIN_COUNT(ps_cab_env);
+            INC_BYPASS_BINS(ps_cab_env);
+
           } while (uc_bin && (bits_to_flush < max_bits));
 
           u4_value = (bits_to_flush - 1);
@@ -839,6 +857,9 @@ label_read_levels:;
                 uc_bin = 0;
               }
 
+              INC_BIN_COUNT(ps_cab_env);
+              INC_BYPASS_BINS(ps_cab_env);
+
               ui_bins = ((ui_bins << 1) | uc_bin);
 
             } while (bits_to_flush < u1_max_bins);
@@ -877,6 +898,9 @@ label_read_levels:;
           u4_code_int_val_ofst -= u4_code_int_range;
           i2_abs_lvl = (-i2_abs_lvl);
         }
+
+        INC_BIN_COUNT(ps_cab_env);
+        INC_BYPASS_BINS(ps_cab_env);
       }
 
       *pi2_coeff_data++ = i2_abs_lvl;
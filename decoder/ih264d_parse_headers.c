@@ -84,6 +84,7 @@
 #include "ih264d_defs.h"
 #include "ivd.h"
 #include "ih264d.h"
+#include "ih264d_trace.h"
 
 /*****************************************************************************/
 /*                                                                           */
@@ -383,7 +384,7 @@ WORD32 ih264d_parse_pps(dec_struct_t *ps_dec, dec_bit_stream_t *ps_bitstrm) {
   /* High profile related syntax elements */
   u1_more_data_flag = MORE_RBSP_DATA(ps_bitstrm);
   if (u1_more_data_flag &&
-      (ps_pps->ps_sps->u1_profile_idc == HIGH_PROFILE_IDC)) {
+      IS_HIGH_PROFILE(ps_pps->ps_sps->u1_profile_idc)) {
     /* read transform_8x8_mode_flag  */
     ps_pps->i4_transform_8x8_mode_flag =
         (WORD32) ih264d_get_bit_h264(ps_bitstrm);
@@ -525,6 +526,7 @@ WORD32 ih264d_parse_sps(dec_struct_t *ps_dec, dec_bit_stream_t *ps_bitstrm) {
   UWORD32 *pu4_bitstrm_buf = ps_bitstrm->pu4_buffer;
   UWORD32 *pu4_bitstrm_ofst = &ps_bitstrm->u4_ofst;
   UWORD8 u1_frm, uc_constraint_set0_flag, uc_constraint_set1_flag;
+  UWORD8 uc_constraint_set3_flag;
 
   UWORD32 u4_temp;
   WORD32 pic_height_in_map_units_minus1 = 0;
@@ -561,7 +563,8 @@ WORD32 ih264d_parse_sps(dec_struct_t *ps_dec, dec_bit_stream_t *ps_bitstrm) {
   /* Read 5 bits for uc_constraint_set3_flag (1 bit)   */
   /* and reserved_zero_4bits (4 bits) - Sushant        */
   /*****************************************************/
-  ih264d_get_bits_h264(ps_bitstrm, 5);
+  uc_constraint_set3_flag = ih264d_get_bit_h264(ps_bitstrm);
+  ih264d_get_bits_h264(ps_bitstrm, 4);
   /* G050 */
 
   /* Check whether particular profile is suported or not */
@@ -570,7 +573,7 @@ WORD32 ih264d_parse_sps(dec_struct_t *ps_dec, dec_bit_stream_t *ps_bitstrm) {
 
       (u1_profile_idc != BASE_PROFILE_IDC) &&
 
-      (u1_profile_idc != HIGH_PROFILE_IDC)
+      (!IS_HIGH_PROFILE(u1_profile_idc))
 
   ) {
     if ((uc_constraint_set1_flag != 1) && (uc_constraint_set0_flag != 1)) {
@@ -617,6 +620,14 @@ WORD32 ih264d_parse_sps(dec_struct_t *ps_dec, dec_bit_stream_t *ps_bitstrm) {
   *ps_seq = ps_dec->ps_sps[u1_seq_parameter_set_id];
   ps_seq->u1_profile_idc = u1_profile_idc;
   ps_seq->u1_level_idc = u1_level_idc;
+
+  /* High 10/4:2:2/4:4:4 Intra signal constraint_set3_flag, CAVLC 4:4:4 */
+  /* Intra has its own profile_idc                                      */
+  ps_seq->u1_intra_profile =
+      (CAVLC444_PROFILE_IDC == u1_profile_idc) ||
+      (uc_constraint_set3_flag && (HIGH10_PROFILE_IDC == u1_profile_idc ||
+                                   HIGH422_PROFILE_IDC == u1_profile_idc ||
+                                   HIGH444_PROFILE_IDC == u1_profile_idc));
   ps_seq->u1_seq_parameter_set_id = u1_seq_parameter_set_id;
 
   /*******************************************************************/
@@ -627,32 +638,44 @@ WORD32 ih264d_parse_sps(dec_struct_t *ps_dec, dec_bit_stream_t *ps_bitstrm) {
   ps_seq->i4_bit_depth_chroma_minus8 = 0;
   ps_seq->i4_qpprime_y_zero_transform_bypass_flag = 0;
   ps_seq->i4_seq_scaling_matrix_present_flag = 0;
-  if (u1_profile_idc == HIGH_PROFILE_IDC) {
+  if (IS_HIGH_PROFILE(u1_profile_idc)) {
     /* reading chroma_format_idc   */
     ps_seq->i4_chroma_format_idc =
         ih264d_uev(pu4_bitstrm_ofst, pu4_bitstrm_buf);
-
-    /* Monochrome is not supported */
-    if (ps_seq->i4_chroma_format_idc != 1) {
+    if (ps_seq->i4_chroma_format_idc > 3) {
       return ERROR_INV_SPS_PPS_T;
     }
 
+    /* reading separate_colour_plane_flag   */
+    if (ps_seq->i4_chroma_format_idc == 3) {
+      ih264d_get_bit_h264(ps_bitstrm);
+    }
+
     /* reading bit_depth_luma_minus8   */
     ps_seq->i4_bit_depth_luma_minus8 =
         ih264d_uev(pu4_bitstrm_ofst, pu4_bitstrm_buf);
 
-    if (ps_seq->i4_bit_depth_luma_minus8 != 0) {
-      return ERROR_INV_SPS_PPS_T;
-    }
-
     /* reading bit_depth_chroma_minus8   */
     ps_seq->i4_bit_depth_chroma_minus8 =
         ih264d_uev(pu4_bitstrm_ofst, pu4_bitstrm_buf);
 
-    if (ps_seq->i4_bit_depth_chroma_minus8 != 0) {
+    if ((ps_seq->i4_bit_depth_luma_minus8 > 6) ||
+        (ps_seq->i4_bit_depth_chroma_minus8 > 6)) {
       return ERROR_INV_SPS_PPS_T;
     }
 
+    /* High 10, 4:2:2 and 4:4:4 profile streams are decoded as long as */
+    /* they only use 8 bit 4:2:0 or 4:0:0 samples; others are valid    */
+    /* streams the decoder can not handle, so they are reported as     */
+    /* unsupported. 4:0:0 is output as 4:2:0 with neutral chroma       */
+    if (ps_seq->i4_chroma_format_idc > 1) {
+      return ERROR_NOT_SUPP_CHROMA_FMT;
+    }
+    if ((ps_seq->i4_bit_depth_luma_minus8 != 0) ||
+        (ps_seq->i4_bit_depth_chroma_minus8 != 0)) {
+      return ERROR_NOT_SUPP_BIT_DEPTH;
+    }
+
     /* reading qpprime_y_zero_transform_bypass_flag   */
     ps_seq->i4_qpprime_y_zero_transform_bypass_flag =
         (WORD32) ih264d_get_bit_h264(ps_bitstrm);
@@ -1085,9 +1108,12 @@ WORD32 ih264d_parse_nal_unit(iv_obj_t *dec_hdl,
 
               ih264d_rbsp_to_sodb(ps_dec->ps_bitstrm);
 
+              TRACE_BEGIN(ps_dec, PERF_SLOT_MAIN, IH264D_TRACE_SLICE,
+                          ps_dec->u2_cur_slice_num);
               i_status = ih264d_parse_decode_slice(
                   (UWORD8) (u1_nal_unit_type == IDR_SLICE_NAL), u1_nal_ref_idc,
                   ps_dec);
+              TRACE_END(ps_dec, PERF_SLOT_MAIN, IH264D_TRACE_SLICE);
 
               if (i_status != OK) return i_status;
             } else {
@@ -1109,7 +1135,10 @@ WORD32 ih264d_parse_nal_unit(iv_obj_t *dec_hdl,
           /* ! */
           ih264d_rbsp_to_sodb(ps_dec->ps_bitstrm);
           i_status = ih264d_parse_sps(ps_dec, ps_bitstrm);
-          if (i_status == ERROR_INV_SPS_PPS_T) return i_status;
+          if ((i_status == ERROR_INV_SPS_PPS_T) ||
+              (i_status == ERROR_NOT_SUPP_BIT_DEPTH) ||
+              (i_status == ERROR_NOT_SUPP_CHROMA_FMT))
+            return i_status;
           if (!i_status) ps_dec->i4_header_decoded |= 0x1;
           break;
 
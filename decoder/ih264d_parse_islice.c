@@ -86,6 +86,7 @@
 #include "assert.h"
 #include "ih264d_utils.h"
 #include "ih264d_format_conv.h"
+#include "ih264d_perf_stats.h"
 
 void ih264d_init_cabac_contexts(UWORD8 u1_slice_type, dec_struct_t *ps_dec);
 
@@ -173,7 +174,9 @@ WORD32 ih264d_parse_imb_cavlc(dec_struct_t *ps_dec,
     /* Read the IntraPrediction mode for CHROMA                           */
     /*--------------------------------------------------------------------*/
     // Inlined ih264d_uev
-    {
+    if (IS_MONOCHROME(ps_dec)) {
+      ps_cur_mb_info->u1_chroma_pred_mode = 0;
+    } else {
       UWORD32 u4_bitstream_offset = *pu4_bitstrm_ofst;
       UWORD32 u4_word, u4_ldz, u4_temp;
 
@@ -220,11 +223,17 @@ WORD32 ih264d_parse_imb_cavlc(dec_struct_t *ps_dec,
       *pu4_bitstrm_ofst = u4_bitstream_offset;
       u4_cbp = ((1 << u4_ldz) + u4_word - 1);
     }
-    if (u4_cbp > 47) {
-      return ERROR_CBP;
+    if (IS_MONOCHROME(ps_dec)) {
+      if (u4_cbp > 15) {
+        return ERROR_CBP;
+      }
+      u4_cbp = gau1_ih264d_cbp_table_gray[u4_cbp][0];
+    } else {
+      if (u4_cbp > 47) {
+        return ERROR_CBP;
+      }
+      u4_cbp = gau1_ih264d_cbp_table[u4_cbp][0];
     }
-
-    u4_cbp = gau1_ih264d_cbp_table[u4_cbp][0];
     COPYTHECONTEXT("coded_block_pattern", u1_cbp);
     ps_cur_mb_info->u1_cbp = u4_cbp;
 
@@ -275,7 +284,9 @@ WORD32 ih264d_parse_imb_cavlc(dec_struct_t *ps_dec,
     /*-------------------------------------------------------------------*/
     /* Read the IntraPrediction mode for CHROMA                          */
     /*-------------------------------------------------------------------*/
-    {
+    if (IS_MONOCHROME(ps_dec)) {
+      ps_cur_mb_info->u1_chroma_pred_mode = 0;
+    } else {
       UWORD32 u4_bitstream_offset = *pu4_bitstrm_ofst;
       UWORD32 u4_word, u4_ldz;
 
@@ -307,6 +318,9 @@ WORD32 ih264d_parse_imb_cavlc(dec_struct_t *ps_dec,
     /* Read the Coded block pattern                                      */
     /*-------------------------------------------------------------------*/
     u4_cbp = gau1_ih264d_cbp_tab[(u1_mb_type - 1) >> 2];
+    if (IS_MONOCHROME(ps_dec) && (u4_cbp & 0x30)) {
+      return ERROR_CBP;
+    }
     ps_cur_mb_info->u1_cbp = u4_cbp;
 
     /*-------------------------------------------------------------------*/
@@ -529,7 +543,9 @@ WORD32 ih264d_parse_imb_cabac(dec_struct_t *ps_dec,
     /*--------------------------------------------------------------------*/
     /* Read the IntraPrediction mode for CHROMA                           */
     /*--------------------------------------------------------------------*/
-    u1_intra_chrom_pred_mode = ih264d_parse_chroma_pred_mode_cabac(ps_dec);
+    u1_intra_chrom_pred_mode = 0;
+    if (!IS_MONOCHROME(ps_dec))
+      u1_intra_chrom_pred_mode = ih264d_parse_chroma_pred_mode_cabac(ps_dec);
     COPYTHECONTEXT("intra_chroma_pred_mode", u1_intra_chrom_pred_mode);
     p_curr_ctxt->u1_intra_chroma_pred_mode =
         ps_cur_mb_info->u1_chroma_pred_mode = u1_intra_chrom_pred_mode;
@@ -566,7 +582,9 @@ WORD32 ih264d_parse_imb_cabac(dec_struct_t *ps_dec,
     /*--------------------------------------------------------------------*/
     /* Read the IntraPrediction mode for CHROMA                           */
     /*--------------------------------------------------------------------*/
-    u1_intra_chrom_pred_mode = ih264d_parse_chroma_pred_mode_cabac(ps_dec);
+    u1_intra_chrom_pred_mode = 0;
+    if (!IS_MONOCHROME(ps_dec))
+      u1_intra_chrom_pred_mode = ih264d_parse_chroma_pred_mode_cabac(ps_dec);
     if (u1_intra_chrom_pred_mode > 3) return ERROR_CHROMA_PRED_MODE;
 
     COPYTHECONTEXT("Chroma intra_chroma_pred_mode pred mode",
@@ -578,6 +596,7 @@ WORD32 ih264d_parse_imb_cabac(dec_struct_t *ps_dec,
     /* Read the Coded block pattern                                       */
     /*--------------------------------------------------------------------*/
     u1_cbp = gau1_ih264d_cbp_tab[(u1_mb_type - 1) >> 2];
+    if (IS_MONOCHROME(ps_dec) && (u1_cbp & 0x30)) return ERROR_CBP;
     ps_cur_mb_info->u1_cbp = u1_cbp;
     p_curr_ctxt->u1_cbp = u1_cbp;
 
@@ -800,8 +819,8 @@ WORD32 ih264d_parse_islice_data_cavlc(dec_struct_t *ps_dec,
     i2_cur_mb_addr++;
     uc_more_data_flag = MORE_RBSP_DATA(ps_bitstrm);
 
-    /* Store the colocated information */
-    {
+    /* Store the colocated information, only temporal direct reads it */
+    if (!ps_dec->u1_intra_only) {
       mv_pred_t *ps_mv_nmb_start = ps_dec->ps_mv_cur + (u1_num_mbs << 4);
 
       mv_pred_t s_mvPred = {{0, 0, 0, 0}, {-1, -1}, 0, 0};
@@ -811,9 +830,12 @@ WORD32 ih264d_parse_islice_data_cavlc(dec_struct_t *ps_dec,
 
     /*if num _cores is set to 3,compute bs will be done in another thread*/
     if (ps_dec->u4_num_cores < 3) {
-      if (ps_dec->u4_app_disable_deblk_frm == 0)
+      if (ps_dec->u4_app_disable_deblk_frm == 0) {
+        PERF_STAGE_BEGIN(ps_dec, PERF_SLOT_MAIN, IH264D_PERF_STAGE_BS);
         ps_dec->pf_compute_bs(ps_dec, ps_cur_mb_info,
                               (UWORD16) (u1_num_mbs >> u1_mbaff));
+        PERF_STAGE_END(ps_dec, PERF_SLOT_MAIN, IH264D_PERF_STAGE_BS);
+      }
     }
     u1_num_mbs++;
     ps_dec->u2_total_mbs_coded++;
@@ -988,8 +1010,8 @@ WORD32 ih264d_parse_islice_data_cabac(dec_struct_t *ps_dec,
         uc_more_data_flag = !uc_more_data_flag;
         COPYTHECONTEXT("Decode Sliceterm", !uc_more_data_flag);
       }
-      /* Store the colocated information */
-      {
+      /* Store the colocated information, only temporal direct reads it */
+      if (!ps_dec->u1_intra_only) {
         mv_pred_t *ps_mv_nmb_start = ps_dec->ps_mv_cur + (u1_num_mbs << 4);
         mv_pred_t s_mvPred = {{0, 0, 0, 0}, {-1, -1}, 0, 0};
         ih264d_rep_mv_colz(ps_dec, &s_mvPred, ps_mv_nmb_start, 0,
@@ -998,9 +1020,12 @@ WORD32 ih264d_parse_islice_data_cabac(dec_struct_t *ps_dec,
       }
       /*if num _cores is set to 3,compute bs will be done in another thread*/
       if (ps_dec->u4_num_cores < 3) {
-        if (ps_dec->u4_app_disable_deblk_frm == 0)
+        if (ps_dec->u4_app_disable_deblk_frm == 0) {
+          PERF_STAGE_BEGIN(ps_dec, PERF_SLOT_MAIN, IH264D_PERF_STAGE_BS);
           ps_dec->pf_compute_bs(ps_dec, ps_cur_mb_info,
                                 (UWORD16) (u1_num_mbs >> u1_mbaff));
+          PERF_STAGE_END(ps_dec, PERF_SLOT_MAIN, IH264D_PERF_STAGE_BS);
+        }
       }
       u1_num_mbs++;
       ps_dec->u2_total_mbs_coded++;
@@ -1147,19 +1172,26 @@ WORD32 ih264d_parse_ipcm_mb(dec_struct_t *ps_dec, dec_mb_info_t *ps_cur_mb_info,
     pu1_y += u4_rec_width_y;
   }
 
-  /* Read Chroma samples */
-  for (u1_y = 0; u1_y < 8; u1_y++) {
-    for (u1_x = 0; u1_x < 8; u1_x++)
-      pu1_u[u1_x * YUV420SP_FACTOR] = ih264d_get_bits_h264(ps_bitstrm, 8);
+  /* Read Chroma samples; 4:0:0 streams have none, use the neutral value */
+  if (IS_MONOCHROME(ps_dec)) {
+    for (u1_y = 0; u1_y < 8; u1_y++) {
+      memset(pu1_u, 128, 8 * YUV420SP_FACTOR);
+      pu1_u += u4_rec_width_uv;
+    }
+  } else {
+    for (u1_y = 0; u1_y < 8; u1_y++) {
+      for (u1_x = 0; u1_x < 8; u1_x++)
+        pu1_u[u1_x * YUV420SP_FACTOR] = ih264d_get_bits_h264(ps_bitstrm, 8);
 
-    pu1_u += u4_rec_width_uv;
-  }
+      pu1_u += u4_rec_width_uv;
+    }
 
-  for (u1_y = 0; u1_y < 8; u1_y++) {
-    for (u1_x = 0; u1_x < 8; u1_x++)
-      pu1_v[u1_x * YUV420SP_FACTOR] = ih264d_get_bits_h264(ps_bitstrm, 8);
+    for (u1_y = 0; u1_y < 8; u1_y++) {
+      for (u1_x = 0; u1_x < 8; u1_x++)
+        pu1_v[u1_x * YUV420SP_FACTOR] = ih264d_get_bits_h264(ps_bitstrm, 8);
 
-    pu1_v += u4_rec_width_uv;
+      pu1_v += u4_rec_width_uv;
+    }
   }
 
   if (CABAC == ps_dec->ps_cur_pps->u1_entropy_coding_mode) {
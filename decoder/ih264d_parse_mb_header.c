@@ -638,6 +638,10 @@ WORD32 ih264d_read_intra_pred_modes_cabac(
     DECODE_ONE_BIN_MACRO(ps_ctxt_ipred_luma_mpm, u4_code_int_range,
                          u4_code_int_val_ofst, pu4_table, ps_bitstrm,
                          u4_prev_intra4x4_pred_mode_flag)
+
+    INC_BIN_COUNT(ps_cab_env);
+    INC_DECISION_BINS(ps_cab_env);
+
     *pu1_prev_intra4x4_pred_mode_flag = u4_prev_intra4x4_pred_mode_flag;
 
     i4_rem_intra4x4_pred_mode = -1;
@@ -887,7 +891,8 @@ UWORD32 ih264d_parse_ctx_cbp_cabac(struct _DecStruct *ps_dec) {
                         pu4_buffer)
   }
 
-  {
+  /* 4:0:0 streams carry no CodedBlockPatternChroma bins */
+  if (!IS_MONOCHROME(ps_dec)) {
     UWORD32 u4_cxt_inc;
     WORD8 a, b, c, d;
     bin_ctxt_model_t *p_CtxtCbpChroma = ps_dec->p_cbp_chroma_t;
@@ -1252,6 +1257,9 @@ WORD16 ih264d_parse_mvd_cabac(dec_bit_stream_t *ps_bitstrm,
       i2_mvd = (-i2_mvd);
     }
 
+    INC_BIN_COUNT(ps_cab_env);
+    INC_BYPASS_BINS(ps_cab_env);
+
     ps_cab_env->u4_code_int_val_ofst = u4_code_int_val_ofst;
     ps_cab_env->u4_code_int_range = u4_code_int_range;
 
@@ -337,9 +337,13 @@ WORD32 ih264d_parse_pmb_cavlc(dec_struct_t *ps_dec,
     *pu4_bitstrm_ofst = u4_bitstream_offset;
     u4_cbp = ((1 << u4_ldz) + u4_word - 1);
 
-    if (u4_cbp > 47) return ERROR_CBP;
-
-    u4_cbp = *((UWORD8 *) gau1_ih264d_cbp_inter + u4_cbp);
+    if (IS_MONOCHROME(ps_dec)) {
+      if (u4_cbp > 15) return ERROR_CBP;
+      u4_cbp = gau1_ih264d_cbp_table_gray[u4_cbp][1];
+    } else {
+      if (u4_cbp > 47) return ERROR_CBP;
+      u4_cbp = *((UWORD8 *) gau1_ih264d_cbp_inter + u4_cbp);
+    }
     COPYTHECONTEXT("coded_block_pattern", u4_cbp);
     ps_cur_mb_info->u1_cbp = u4_cbp;
 
@@ -1465,7 +1469,8 @@ WORD32 ih264d_parse_pslice(dec_struct_t *ps_dec, UWORD16 u2_first_mb_in_slice) {
     }
   }
   if (ps_pps->u1_wted_pred_flag) {
-    ret = ih264d_parse_pred_weight_table(ps_cur_slice, ps_bitstrm);
+    ret = ih264d_parse_pred_weight_table(ps_cur_slice, ps_bitstrm,
+                                         !IS_MONOCHROME(ps_dec));
     if (ret != OK) return ret;
     ih264d_form_pred_weight_matrix(ps_dec);
     ps_dec->pu4_wt_ofsts = ps_dec->pu4_wts_ofsts_mat;
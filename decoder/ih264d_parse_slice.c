@@ -93,6 +93,7 @@
 #include "ih264d_thread_parse_decode.h"
 #include "ih264d_thread_compute_bs.h"
 #include "ih264d_dpb_manager.h"
+#include "ih264d_deadline.h"
 #include <assert.h>
 #include "ih264d_parse_islice.h"
 #define RET_LAST_SKIP 0x80000000
@@ -224,6 +225,7 @@ WORD32 ih264d_start_of_pic(dec_struct_t *ps_dec, WORD32 i4_poc,
   }
 
   ps_dec->u4_app_disable_deblk_frm = 0;
+  ps_dec->i4_mv_frac_mask = ~0;
   /* If degrade is enabled, set the degrade flags appropriately */
   if (ps_dec->i4_degrade_type && ps_dec->i4_degrade_pics) {
     WORD32 degrade_pic;
@@ -263,13 +265,14 @@ WORD32 ih264d_start_of_pic(dec_struct_t *ps_dec, WORD32 i4_poc,
 
       /* MC degrading is done only for non-ref pictures */
       if (0 == ps_cur_slice->u1_nal_ref_idc) {
-        if (ps_dec->i4_degrade_type & 0x4) ps_dec->i4_mv_frac_mask = 0;
+        if (ps_dec->i4_degrade_type & 0x4) ps_dec->i4_mv_frac_mask = ~0x3;
 
-        if (ps_dec->i4_degrade_type & 0x8) ps_dec->i4_mv_frac_mask = 0;
+        if (ps_dec->i4_degrade_type & 0x8) ps_dec->i4_mv_frac_mask = ~0x7;
       }
     } else
       ps_dec->i4_degrade_pic_cnt = 0;
   }
+  ih264d_deadline_degrade_pic(ps_dec);
 
   {
     dec_err_status_t *ps_err = ps_dec->ps_dec_err_status;
@@ -316,7 +319,12 @@ WORD32 ih264d_start_of_pic(dec_struct_t *ps_dec, WORD32 i4_poc,
     ps_dec->s_prev_seq_params.u1_eoseq_pending = 0;
   }
   ret = ih264d_init_pic(ps_dec, u2_frame_num, i4_poc, ps_pps);
-  if (ret != OK) return ret;
+  if (ret != OK) {
+    /* No picture was started, e.g. the memory for the SPS could not be */
+    /* allocated; the next slice tries again                            */
+    ps_dec->u1_first_nal_in_pic = 1;
+    return ret;
+  }
 
   ps_dec->pv_parse_tu_coeff_data = ps_dec->pv_pic_tu_coeff_data;
   ps_dec->pv_proc_tu_coeff_data = ps_dec->pv_pic_tu_coeff_data;
@@ -414,7 +422,8 @@ WORD32 ih264d_start_of_pic(dec_struct_t *ps_dec, WORD32 i4_poc,
     ps_dec->au1_pic_buf_id_mv_buf_id_map[cur_pic_buf_id] = cur_mv_buf_id;
 
     ps_cur_pic->pu1_col_zero_flag = (UWORD8 *) ps_col_mv->pv_col_zero_flag;
-    ps_cur_pic->ps_mv = (mv_pred_t *) ps_col_mv->pv_mv;
+    ps_cur_pic->ps_mv = ps_dec->ps_mv_bank_base;
+    ps_cur_pic->ps_col_mv = (col_mv_t *) ps_col_mv->pv_mv;
     ps_dec->au1_pic_buf_ref_flag[cur_pic_buf_id] = 0;
 
     if (!ps_dec->ps_cur_pic) {
@@ -434,6 +443,7 @@ WORD32 ih264d_start_of_pic(dec_struct_t *ps_dec, WORD32 i4_poc,
       ps_dec->i4_cur_display_seq = 0;
       ps_dec->i4_prev_max_display_seq = 0;
       ps_dec->i4_max_poc = 0;
+      ps_dec->i4_low_delay_prev_poc = (WORD32) 0x80000000;
 
       ps_cur_pic = (pic_buffer_t *) ih264_buf_mgr_get_next_free(
           (buf_mgr_t *) ps_dec->pv_pic_buf_mgr, &cur_pic_buf_id);
@@ -458,7 +468,8 @@ WORD32 ih264d_start_of_pic(dec_struct_t *ps_dec, WORD32 i4_poc,
       ps_dec->au1_pic_buf_id_mv_buf_id_map[cur_pic_buf_id] = cur_mv_buf_id;
 
       ps_cur_pic->pu1_col_zero_flag = (UWORD8 *) ps_col_mv->pv_col_zero_flag;
-      ps_cur_pic->ps_mv = (mv_pred_t *) ps_col_mv->pv_mv;
+      ps_cur_pic->ps_mv = ps_dec->ps_mv_bank_base;
+      ps_cur_pic->ps_col_mv = (col_mv_t *) ps_col_mv->pv_mv;
       ps_dec->au1_pic_buf_ref_flag[cur_pic_buf_id] = 0;
     }
 
@@ -489,6 +500,8 @@ WORD32 ih264d_start_of_pic(dec_struct_t *ps_dec, WORD32 i4_poc,
     ps_dec->s_cur_pic.pu1_buf2 += ps_dec->s_cur_pic.u2_frm_wd_uv;
     ps_dec->s_cur_pic.pu1_buf3 += ps_dec->s_cur_pic.u2_frm_wd_uv;
     ps_dec->s_cur_pic.ps_mv += ((ps_dec->u2_pic_ht * ps_dec->u2_pic_wd) >> 5);
+    ps_dec->s_cur_pic.ps_col_mv +=
+        ((ps_dec->u2_pic_ht * ps_dec->u2_pic_wd) >> 5);
     ps_dec->s_cur_pic.pu1_col_zero_flag +=
         ((ps_dec->u2_pic_ht * ps_dec->u2_pic_wd) >> 5);
     ps_dec->ps_cur_pic->u1_picturetype |= BOT_FLD;
@@ -642,7 +655,7 @@ WORD32 ih264d_start_of_pic(dec_struct_t *ps_dec, WORD32 i4_poc,
   /**********************************************************************/
   /* High profile related initialization at pictrue level               */
   /**********************************************************************/
-  if (ps_seq->u1_profile_idc == HIGH_PROFILE_IDC) {
+  if (IS_HIGH_PROFILE(ps_seq->u1_profile_idc)) {
     if ((ps_seq->i4_seq_scaling_matrix_present_flag) ||
         (ps_pps->i4_pic_scaling_matrix_present_flag)) {
       ih264d_form_scaling_matrix_picture(ps_seq, ps_pps, ps_dec);
@@ -698,13 +711,13 @@ WORD32 ih264d_end_of_pic_dispbuf_mgr(dec_struct_t *ps_dec) {
           ih264d_reset_ref_bufs(ps_dec->ps_dpb_mgr);
         ih264d_release_display_bufs(ps_dec);
       }
-      if (ps_dec->u4_num_reorder_frames_at_init != 0) {
+      if (!ps_dec->u1_low_delay) {
         ret = ih264d_assign_display_seq(ps_dec);
         if (ret != OK) return ret;
       }
     }
 
-    if (ps_cur_slice->u1_nal_ref_idc) {
+    if (ps_cur_slice->u1_nal_ref_idc && !ps_dec->u1_intra_only) {
       /* Mark pic buf as needed for reference */
       ih264_buf_mgr_set_status((buf_mgr_t *) ps_dec->pv_pic_buf_mgr,
                                ps_dec->u1_pic_buf_id, BUF_MGR_REF);
@@ -738,6 +751,9 @@ WORD32 ih264d_end_of_pic_dispbuf_mgr(dec_struct_t *ps_dec) {
       ps_cur_pic->u2_crop_offset_uv = ps_dec->u2_crop_offset_uv;
       ps_cur_pic->u1_pic_type = 0;
 
+      ih264d_check_low_delay_poc(
+          ps_dec, ps_dec->i4_prev_max_display_seq + ps_dec->ps_cur_pic->i4_poc);
+
       ret = ih264d_insert_pic_in_display_list(
           ps_dec->ps_dpb_mgr, ps_dec->u1_pic_buf_id,
           ps_dec->i4_prev_max_display_seq + ps_dec->ps_cur_pic->i4_poc,
@@ -770,7 +786,7 @@ WORD32 ih264d_end_of_pic_dispbuf_mgr(dec_struct_t *ps_dec) {
 
     if (!ps_cur_slice->u1_field_pic_flag ||
         ((TOP_FIELD_ONLY | BOT_FIELD_ONLY) == ps_dec->u1_top_bottom_decoded)) {
-      if (ps_dec->u4_num_reorder_frames_at_init == 0) {
+      if (ps_dec->u1_low_delay) {
         ret = ih264d_assign_display_seq(ps_dec);
         if (ret != OK) return ret;
       }
@@ -1048,6 +1064,11 @@ WORD32 ih264d_parse_decode_slice(UWORD8 u1_is_idr_slice, UWORD8 u1_nal_ref_idc,
   if (!ps_seq) return ERROR_INV_SPS_PPS_T;
   if (FALSE == ps_seq->u1_is_valid) return ERROR_INV_SPS_PPS_T;
 
+  /* References are neither padded nor carry co-located MVs. The slice is */
+  /* rejected before a picture and its decode threads are started for it */
+  if ((I_SLICE != u1_slice_type) && ih264d_is_intra_only(ps_dec, ps_seq))
+    return ERROR_INV_SLC_TYPE_T;
+
   /* Get the frame num */
   u2_frame_num = ih264d_get_bits_h264(ps_bitstrm, ps_seq->u1_bits_in_frm_num);
   //    H264_DEC_DEBUG_PRINT("FRAME %d First MB in slice: %d\n", u2_frame_num,
@@ -1345,10 +1366,23 @@ WORD32 ih264d_parse_decode_slice(UWORD8 u1_is_idr_slice, UWORD8 u1_nal_ref_idc,
       if ((ps_dec->u4_num_cores == 3) &&
           (ps_dec->u4_app_disable_deblk_frm == 0) &&
           (ps_dec->u4_bs_deblk_thread_created == 0)) {
+        UWORD32 i;
+
         ps_dec->u4_start_bs_deblk = 0;
+
+        /* Cores beyond parse, decode and compute bs are deblocking workers,
+         * the compute bs thread being worker 0 */
+        ps_dec->u4_num_deblk_workers =
+            MAX(1, MIN(ps_dec->u4_num_deblk_cores - 2,
+                       (UWORD32) ps_dec->u2_frm_ht_in_mbs));
+        for (i = 0; i < ps_dec->u4_num_deblk_workers; i++)
+          ps_dec->as_deblk_worker[i].u4_deblk_num = 0;
+
         ithread_create(ps_dec->pv_bs_deblk_thread_handle, NULL,
                        (void *) ih264d_computebs_deblk_thread, (void *) ps_dec);
         ps_dec->u4_bs_deblk_thread_created = 1;
+
+        ih264d_start_deblk_workers(ps_dec, ih264d_deblk_worker_job);
       }
     }
   }
@@ -0,0 +1,255 @@
+/* Copyright (c) [2020]-[2023] Ittiam Systems Pvt. Ltd.
+   All rights reserved.
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted (subject to the limitations in the
+   disclaimer below) provided that the following conditions are met:
+   •    Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+   •    Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+   •    None of the names of Ittiam Systems Pvt. Ltd., its affiliates,
+   investors, business partners, nor the names of its contributors may be
+   used to endorse or promote products derived from this software without
+   specific prior written permission.
+
+   NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED
+   BY THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+   BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+   FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+   HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+   OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+   WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+   OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+   EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+   This Software is an implementation of the AVC/H.264
+   standard by Ittiam Systems Pvt. Ltd. (“Ittiam”).
+   Additional patent licenses may be required for this Software,
+   including, but not limited to, a license from MPEG LA’s AVC/H.264
+   licensing program (see https://www.mpegla.com/programs/avc-h-264/).
+
+   NOTWITHSTANDING ANYTHING TO THE CONTRARY, THIS DOES NOT GRANT ANY
+   EXPRESS OR IMPLIED LICENSES TO ANY PATENT CLAIMS OF ANY AFFILIATE
+   (TO THE EXTENT NOT IN THE LEGAL ENTITY), INVESTOR, OR OTHER
+   BUSINESS PARTNER OF ITTIAM. You may only use this software or
+   modifications thereto for purposes that are authorized by
+   appropriate patent licenses. You should seek legal advice based
+   upon your implementation details.
+
+---------------------------------------------------------------
+*/
+/*****************************************************************************/
+/*                                                                           */
+/*  File Name         : ih264d_perf_stats.c                                  */
+/*                                                                           */
+/*  Description       : Contains the functions updating and reading the      */
+/*                      profiling counters. Every logical thread updates its */
+/*                      own slot of counters, the slots are summed up only   */
+/*                      when the counters are read                           */
+/*                                                                           */
+/*  List of Functions : ih264d_perf_clock_ns()                               */
+/*                      ih264d_perf_timer()                                  */
+/*                      ih264d_perf_ticks_per_sec()                          */
+/*                      ih264d_perf_reset()                                  */
+/*                      ih264d_perf_count_mb()                               */
+/*                      ih264d_perf_get_stats()                              */
+/*                                                                           */
+/*  Issues / Problems : None                                                 */
+/*                                                                           */
+/*****************************************************************************/
+/*****************************************************************************/
+/* File Includes                                                             */
+/*****************************************************************************/
+
+/* System include files */
+#include <string.h>
+#ifndef WINDOWS
+#include <time.h>
+#endif
+#ifdef X86
+#ifdef WINDOWS
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#endif
+
+/* User include files */
+#include "ih264_typedefs.h"
+#include "ih264_macros.h"
+#include "ih264_platform_macros.h"
+#include "ih264d_defs.h"
+#include "ih264d_structs.h"
+#include "ih264d_perf_stats.h"
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264d_perf_clock_ns                                     */
+/*                                                                           */
+/*  Description   : Reads the monotonic clock                                */
+/*                                                                           */
+/*  Inputs        : None                                                     */
+/*  Returns       : Clock in nanoseconds, 0 where it is not available        */
+/*                                                                           */
+/*****************************************************************************/
+UWORD64 ih264d_perf_clock_ns(void) {
+#ifdef WINDOWS
+  return 0;
+#else
+  struct timespec s_time;
+
+  clock_gettime(CLOCK_MONOTONIC, &s_time);
+  return (UWORD64) s_time.tv_sec * 1000000000 + s_time.tv_nsec;
+#endif
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264d_perf_timer                                        */
+/*                                                                           */
+/*  Description   : Reads the timer used for the stage times                 */
+/*                                                                           */
+/*  Inputs        : None                                                     */
+/*  Returns       : Time stamp counter on x86, monotonic clock in            */
+/*                  nanoseconds elsewhere                                    */
+/*                                                                           */
+/*****************************************************************************/
+UWORD64 ih264d_perf_timer(void) {
+#ifdef X86
+  return __rdtsc();
+#else
+  return ih264d_perf_clock_ns();
+#endif
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264d_perf_ticks_per_sec                                */
+/*                                                                           */
+/*  Description   : Finds the timer frequency. The time stamp counter is     */
+/*                  measured against the clock since the counters were       */
+/*                  cleared                                                  */
+/*                                                                           */
+/*  Inputs        : ps_dec - decoder context                                 */
+/*  Returns       : Timer ticks per second, 0 if it could not be determined  */
+/*                                                                           */
+/*****************************************************************************/
+UWORD64 ih264d_perf_ticks_per_sec(dec_struct_t *ps_dec) {
+  UWORD64 u8_ns = ih264d_perf_clock_ns() - ps_dec->u8_perf_ref_ns;
+
+#ifdef X86
+  if (ps_dec->u8_perf_ref_ns && u8_ns)
+    return (UWORD64) ((double) (ih264d_perf_timer() -
+                                ps_dec->u8_perf_ref_ticks) *
+                      1000000000.0 / (double) u8_ns);
+  return 0;
+#else
+  UNUSED(u8_ns);
+  return ps_dec->u8_perf_ref_ns ? 1000000000 : 0;
+#endif
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264d_perf_reset                                        */
+/*                                                                           */
+/*  Description   : Clears the profiling counters and notes the timer and    */
+/*                  the clock, to find the timer frequency when the counters */
+/*                  are read                                                 */
+/*                                                                           */
+/*  Inputs        : ps_dec - decoder context                                 */
+/*                                                                           */
+/*****************************************************************************/
+void ih264d_perf_reset(dec_struct_t *ps_dec) {
+  memset(ps_dec->as_perf_slot, 0, sizeof(ps_dec->as_perf_slot));
+  ps_dec->s_cab_dec_env.u8_num_bins = 0;
+  ps_dec->s_cab_dec_env.u8_num_bypass_bins = 0;
+
+  ps_dec->u8_perf_ref_ticks = ih264d_perf_timer();
+  ps_dec->u8_perf_ref_ns = ih264d_perf_clock_ns();
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264d_perf_count_mb                                     */
+/*                                                                           */
+/*  Description   : Counts a MB about to be reconstructed by its type        */
+/*                                                                           */
+/*  Inputs        : ps_dec         - decoder context                         */
+/*                  u4_slot        - counters slot of the calling thread     */
+/*                  ps_cur_mb_info - MB, with the type as parsed             */
+/*                  i4_skip_th     - last inter MB type of the slice type    */
+/*                  u4_ipcm_th     - I PCM MB type of the slice type, - 25   */
+/*                  u4_is_b        - 1 for a B slice                         */
+/*                                                                           */
+/*****************************************************************************/
+void ih264d_perf_count_mb(dec_struct_t *ps_dec, UWORD32 u4_slot,
+                          dec_mb_info_t *ps_cur_mb_info, WORD32 i4_skip_th,
+                          UWORD32 u4_ipcm_th, UWORD32 u4_is_b) {
+  WORD32 i4_mb_type = ps_cur_mb_info->u1_mb_type;
+  UWORD32 u4_type;
+
+  if (i4_mb_type <= i4_skip_th)
+    u4_type = u4_is_b ? IH264D_PERF_MB_B : IH264D_PERF_MB_P;
+  else if (MB_SKIP == i4_mb_type)
+    u4_type = u4_is_b ? IH264D_PERF_MB_B_SKIP : IH264D_PERF_MB_P_SKIP;
+  else if ((WORD32) (u4_ipcm_th + 25) == i4_mb_type)
+    u4_type = IH264D_PERF_MB_IPCM;
+  else if (I_4x4_MB == (i4_mb_type - (i4_skip_th + 1)))
+    u4_type = ps_cur_mb_info->u1_tran_form8x8 ? IH264D_PERF_MB_I8x8
+                                              : IH264D_PERF_MB_I4x4;
+  else
+    u4_type = IH264D_PERF_MB_I16x16;
+
+  ps_dec->as_perf_slot[u4_slot].au8_num_mbs[u4_type]++;
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264d_perf_get_stats                                    */
+/*                                                                           */
+/*  Description   : Sums up the counters of all the slots. The main thread   */
+/*                  time in the API calls not spent in any timed stage is    */
+/*                  reported as parsing                                      */
+/*                                                                           */
+/*  Inputs        : ps_dec - decoder context                                 */
+/*                  ps_op  - output structure of the control call            */
+/*                                                                           */
+/*****************************************************************************/
+void ih264d_perf_get_stats(dec_struct_t *ps_dec,
+                           ih264d_ctl_get_perf_stats_op_t *ps_op) {
+  perf_slot_t *ps_main = &ps_dec->as_perf_slot[PERF_SLOT_MAIN];
+  UWORD64 u8_main_ticks = 0;
+  UWORD32 i, j;
+
+  memset(ps_op->au8_stage_ticks, 0, sizeof(ps_op->au8_stage_ticks));
+  memset(ps_op->au8_num_mbs, 0, sizeof(ps_op->au8_num_mbs));
+  ps_op->u8_num_spin_waits = 0;
+
+  for (i = 0; i < PERF_NUM_SLOTS; i++) {
+    perf_slot_t *ps_slot = &ps_dec->as_perf_slot[i];
+
+    for (j = IH264D_PERF_STAGE_PARSE + 1; j < IH264D_PERF_NUM_STAGES; j++)
+      ps_op->au8_stage_ticks[j] += ps_slot->au8_ticks[j];
+    for (j = 0; j < IH264D_PERF_NUM_MB_TYPES; j++)
+      ps_op->au8_num_mbs[j] += ps_slot->au8_num_mbs[j];
+    ps_op->u8_num_spin_waits += ps_slot->u8_num_spin_waits;
+  }
+
+  for (j = IH264D_PERF_STAGE_PARSE + 1; j < IH264D_PERF_NUM_STAGES; j++)
+    u8_main_ticks += ps_main->au8_ticks[j];
+
+  ps_op->u8_call_ticks = ps_main->au8_ticks[PERF_TIMER_CALL];
+  if (ps_op->u8_call_ticks > u8_main_ticks)
+    ps_op->au8_stage_ticks[IH264D_PERF_STAGE_PARSE] =
+        ps_op->u8_call_ticks - u8_main_ticks;
+
+  ps_op->u8_num_bins = ps_dec->s_cab_dec_env.u8_num_bins;
+  ps_op->u8_num_bypass_bins = ps_dec->s_cab_dec_env.u8_num_bypass_bins;
+
+  ps_op->u8_ticks_per_sec = ih264d_perf_ticks_per_sec(ps_dec);
+}
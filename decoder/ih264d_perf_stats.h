@@ -0,0 +1,129 @@
+/* Copyright (c) [2020]-[2023] Ittiam Systems Pvt. Ltd.
+   All rights reserved.
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted (subject to the limitations in the
+   disclaimer below) provided that the following conditions are met:
+   •    Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+   •    Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+   •    None of the names of Ittiam Systems Pvt. Ltd., its affiliates,
+   investors, business partners, nor the names of its contributors may be
+   used to endorse or promote products derived from this software without
+   specific prior written permission.
+
+   NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED
+   BY THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+   BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+   FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+   HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+   OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+   WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+   OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+   EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+   This Software is an implementation of the AVC/H.264
+   standard by Ittiam Systems Pvt. Ltd. (“Ittiam”).
+   Additional patent licenses may be required for this Software,
+   including, but not limited to, a license from MPEG LA’s AVC/H.264
+   licensing program (see https://www.mpegla.com/programs/avc-h-264/).
+
+   NOTWITHSTANDING ANYTHING TO THE CONTRARY, THIS DOES NOT GRANT ANY
+   EXPRESS OR IMPLIED LICENSES TO ANY PATENT CLAIMS OF ANY AFFILIATE
+   (TO THE EXTENT NOT IN THE LEGAL ENTITY), INVESTOR, OR OTHER
+   BUSINESS PARTNER OF ITTIAM. You may only use this software or
+   modifications thereto for purposes that are authorized by
+   appropriate patent licenses. You should seek legal advice based
+   upon your implementation details.
+
+---------------------------------------------------------------
+*/
+/*****************************************************************************/
+/*                                                                           */
+/*  File Name         : ih264d_perf_stats.h                                  */
+/*                                                                           */
+/*  Description       : Macros and functions updating the profiling counters */
+/*                      read through IH264D_CMD_CTL_GET_PERF_STATS. The      */
+/*                      macros compile to nothing unless the library is      */
+/*                      built with PERF_STATS_ENABLE                         */
+/*                                                                           */
+/*  List of Functions : ih264d_perf_clock_ns()                               */
+/*                      ih264d_perf_timer()                                  */
+/*                      ih264d_perf_ticks_per_sec()                          */
+/*                      ih264d_perf_reset()                                  */
+/*                      ih264d_perf_count_mb()                               */
+/*                      ih264d_perf_get_stats()                              */
+/*                                                                           */
+/*  Issues / Problems : None                                                 */
+/*                                                                           */
+/*****************************************************************************/
+
+#ifndef _IH264D_PERF_STATS_H_
+#define _IH264D_PERF_STATS_H_
+
+/* Counters slot of a deblocking worker, worker 0 being the thread owning */
+/* slot u4_slot0                                                          */
+#define PERF_DEBLK_SLOT(u4_id, u4_slot0) \
+  ((u4_id) ? (PERF_SLOT_DEBLK_WORKER + (u4_id) - 1) : (u4_slot0))
+
+#ifdef PERF_STATS_ENABLE
+
+#define PERF_STAGE_BEGIN(ps_dec, u4_slot, e_stage) \
+  ((ps_dec)->as_perf_slot[u4_slot].au8_start[e_stage] = ih264d_perf_timer())
+
+#define PERF_STAGE_END(ps_dec, u4_slot, e_stage)            \
+  ((ps_dec)->as_perf_slot[u4_slot].au8_ticks[e_stage] +=   \
+   ih264d_perf_timer() - (ps_dec)->as_perf_slot[u4_slot].au8_start[e_stage])
+
+#define PERF_SPIN(ps_dec, u4_slot) \
+  ((ps_dec)->as_perf_slot[u4_slot].u8_num_spin_waits++)
+
+#define PERF_COUNT_MB(ps_dec, u4_slot, ps_cur_mb_info, i4_skip_th, \
+                      u4_ipcm_th, u4_is_b)                         \
+  ih264d_perf_count_mb(ps_dec, u4_slot, ps_cur_mb_info, i4_skip_th, \
+                       u4_ipcm_th, u4_is_b)
+
+#else
+
+/* The slot is consumed so that slots computed only for the counters do not */
+/* turn into unused variables                                              */
+#define PERF_STAGE_BEGIN(ps_dec, u4_slot, e_stage) ((void) (u4_slot))
+#define PERF_STAGE_END(ps_dec, u4_slot, e_stage) ((void) (u4_slot))
+#define PERF_SPIN(ps_dec, u4_slot) ((void) (u4_slot))
+#define PERF_COUNT_MB(ps_dec, u4_slot, ps_cur_mb_info, i4_skip_th, \
+                      u4_ipcm_th, u4_is_b)                         \
+  ((void) 0)
+
+#endif
+
+/* One iteration of a spin-wait loop, timed as a wait. It also opens a   */
+/* trace wait span, see ih264d_trace.h, to be closed after the loop       */
+#define PERF_NOP(ps_dec, u4_slot, nop_cnt)                    \
+  {                                                           \
+    PERF_STAGE_BEGIN(ps_dec, u4_slot, IH264D_PERF_STAGE_WAIT); \
+    TRACE_SPIN(ps_dec, u4_slot);                              \
+    NOP(nop_cnt);                                             \
+    PERF_SPIN(ps_dec, u4_slot);                               \
+    PERF_STAGE_END(ps_dec, u4_slot, IH264D_PERF_STAGE_WAIT);   \
+  }
+
+UWORD64 ih264d_perf_clock_ns(void);
+
+UWORD64 ih264d_perf_timer(void);
+
+UWORD64 ih264d_perf_ticks_per_sec(dec_struct_t *ps_dec);
+
+void ih264d_perf_reset(dec_struct_t *ps_dec);
+
+void ih264d_perf_count_mb(dec_struct_t *ps_dec, UWORD32 u4_slot,
+                          dec_mb_info_t *ps_cur_mb_info, WORD32 i4_skip_th,
+                          UWORD32 u4_ipcm_th, UWORD32 u4_is_b);
+
+void ih264d_perf_get_stats(dec_struct_t *ps_dec,
+                           ih264d_ctl_get_perf_stats_op_t *ps_op);
+
+#endif /* _IH264D_PERF_STATS_H_ */
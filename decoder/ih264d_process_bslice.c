@@ -546,7 +546,8 @@ WORD32 ih264d_decode_temporal_direct(dec_struct_t *ps_dec, UWORD8 u1_wd_x,
                                      dec_mb_info_t *ps_cur_mb_info,
                                      UWORD8 u1_mb_num) {
   struct pic_buffer_t *ps_pic_buff0, *ps_pic_buff1, *ps_col_pic;
-  mv_pred_t *ps_mv, s_temp_mv_pred;
+  mv_pred_t s_temp_mv_pred;
+  col_mv_t *ps_col_mv;
   UWORD8 u1_sub_mb_num;
   UWORD8 u1_mbaff = ps_dec->ps_cur_slice->u1_mbaff_frame_flag;
   WORD16 i2_mv_x0, i2_mv_y0, i2_mv_x1, i2_mv_y1;
@@ -575,7 +576,11 @@ WORD32 ih264d_decode_temporal_direct(dec_struct_t *ps_dec, UWORD8 u1_wd_x,
     UWORD8 u1_colz;
     partition_size = s_mvdirect.i1_partitionsize[i];
     u1_sub_mb_num = s_mvdirect.i1_submb_num[i];
-    ps_mv = ps_col_pic->ps_mv + s_mvdirect.i4_mv_indices[i];
+    if (ps_dec->u1_col_mv_8x8)
+      ps_col_mv =
+          ps_col_pic->ps_col_mv + COL_MV_IDX_8x8(s_mvdirect.i4_mv_indices[i]);
+    else
+      ps_col_mv = ps_col_pic->ps_col_mv + s_mvdirect.i4_mv_indices[i];
 
     /* This should be removed to catch unitialized memory read */
     u1_ref_idx0 = 0;
@@ -588,8 +593,8 @@ WORD32 ih264d_decode_temporal_direct(dec_struct_t *ps_dec, UWORD8 u1_wd_x,
       u1_mb_partw >>= 1;
       u1_mb_parth >>= 1;
     }
-    c_refFrm0 = ps_mv->i1_ref_frame[0];
-    c_refFrm1 = ps_mv->i1_ref_frame[1];
+    c_refFrm0 = ps_col_mv->i1_ref_frame[0];
+    c_refFrm1 = ps_col_mv->i1_ref_frame[1];
 
     if ((c_refFrm0 == -1) && (c_refFrm1 == -1)) {
       u1_ref_idx0 = 0;
@@ -614,8 +619,8 @@ WORD32 ih264d_decode_temporal_direct(dec_struct_t *ps_dec, UWORD8 u1_wd_x,
     } else {
       UWORD8 uc_i, u1_num_frw_ref_pics;
       UWORD8 buf_id, u1_pic_type;
-      buf_id = ps_mv->u1_col_ref_pic_idx;
-      u1_pic_type = ps_mv->u1_pic_type;
+      buf_id = ps_col_mv->u1_col_ref_pic_idx;
+      u1_pic_type = ps_col_mv->u1_pic_type;
       if (ps_dec->ps_cur_slice->u1_field_pic_flag) {
         if (s_mvdirect.u1_vert_mv_scale == FRM_TO_FLD) {
           u1_pic_type = TOP_FLD;
@@ -681,16 +686,9 @@ WORD32 ih264d_decode_temporal_direct(dec_struct_t *ps_dec, UWORD8 u1_wd_x,
     {
       WORD16 i16_td;
 
-      if (c_refFrm0 >= 0) {
-        i2_mv_x0 = ps_mv->i2_mv[0];
-        i2_mv_y0 = ps_mv->i2_mv[1];
-      } else if (c_refFrm1 >= 0) {
-        i2_mv_x0 = ps_mv->i2_mv[2];
-        i2_mv_y0 = ps_mv->i2_mv[3];
-      } else {
-        i2_mv_x0 = 0;
-        i2_mv_y0 = 0;
-      }
+      /* Packed as the L0 MV, else the L1 MV, else zero */
+      i2_mv_x0 = ps_col_mv->i2_mv[0];
+      i2_mv_y0 = ps_col_mv->i2_mv[1];
       /* If FRM_TO_FLD or FLD_TO_FRM scale the "y" component of the colocated
        * Mv*/
       if (s_mvdirect.u1_vert_mv_scale == FRM_TO_FLD) {
@@ -879,7 +877,7 @@ void ih264d_convert_frm_to_fld_list(struct pic_buffer_t *ps_ref_pic_buf_lx,
           ps_ref_pic_lx->pu1_buf3 += ps_ref_pic_lx->u2_frm_wd_uv;
           if (ps_ref_pic_lx->u1_picturetype & 0x3) {
             ps_ref_pic_lx->pu1_col_zero_flag += ui_half_num_of_sub_mbs;
-            ps_ref_pic_lx->ps_mv += ui_half_num_of_sub_mbs;
+            ps_ref_pic_lx->ps_col_mv += ui_half_num_of_sub_mbs;
           }
           ps_ref_pic_lx->i4_poc = ps_ref_pic_lx->i4_bottom_field_order_cnt;
           ps_ref_pic_lx->i4_avg_poc = ps_ref_pic_lx->i4_bottom_field_order_cnt;
@@ -914,7 +912,7 @@ void ih264d_convert_frm_to_fld_list(struct pic_buffer_t *ps_ref_pic_buf_lx,
               ps_ref_pic_lx->pu1_buf3 += ps_ref_pic_lx->u2_frm_wd_uv;
               if (ps_ref_pic_lx->u1_picturetype & 0x3) {
                 ps_ref_pic_lx->pu1_col_zero_flag += ui_half_num_of_sub_mbs;
-                ps_ref_pic_lx->ps_mv += ui_half_num_of_sub_mbs;
+                ps_ref_pic_lx->ps_col_mv += ui_half_num_of_sub_mbs;
               }
               ps_ref_pic_lx->i4_poc = ps_ref_pic_lx->i4_bottom_field_order_cnt;
               ps_ref_pic_lx->i4_avg_poc =
@@ -951,7 +949,7 @@ void ih264d_convert_frm_to_fld_list(struct pic_buffer_t *ps_ref_pic_buf_lx,
             ps_ref_pic_lx->pu1_buf3 += ps_ref_pic_lx->u2_frm_wd_uv;
             if (ps_ref_pic_lx->u1_picturetype & 0x3) {
               ps_ref_pic_lx->pu1_col_zero_flag += ui_half_num_of_sub_mbs;
-              ps_ref_pic_lx->ps_mv += ui_half_num_of_sub_mbs;
+              ps_ref_pic_lx->ps_col_mv += ui_half_num_of_sub_mbs;
             }
             ps_ref_pic_lx->i4_poc = ps_ref_pic_lx->i4_bottom_field_order_cnt;
             ps_ref_pic_lx->i4_avg_poc =
@@ -1003,8 +1001,8 @@ void ih264d_convert_frm_mbaff_list(dec_struct_t *ps_dec) {
     if (ps_ref_pic_buf_lx[idx]->u1_picturetype & 0x3) {
       ps_ref_pic_lx[idx + MAX_REF_BUFS]->pu1_col_zero_flag =
           ps_ref_pic_buf_lx[idx]->pu1_col_zero_flag + u4_half_num_of_sub_mbs;
-      ps_ref_pic_lx[idx + MAX_REF_BUFS]->ps_mv =
-          ps_ref_pic_buf_lx[idx]->ps_mv + u4_half_num_of_sub_mbs;
+      ps_ref_pic_lx[idx + MAX_REF_BUFS]->ps_col_mv =
+          ps_ref_pic_buf_lx[idx]->ps_col_mv + u4_half_num_of_sub_mbs;
     }
   }
 
@@ -1032,8 +1030,8 @@ void ih264d_convert_frm_mbaff_list(dec_struct_t *ps_dec) {
       if (ps_ref_pic_buf_lx[idx]->u1_picturetype & 0x3) {
         ps_ref_pic_lx[idx + MAX_REF_BUFS]->pu1_col_zero_flag =
             ps_ref_pic_buf_lx[idx]->pu1_col_zero_flag + u4_half_num_of_sub_mbs;
-        ps_ref_pic_lx[idx + MAX_REF_BUFS]->ps_mv =
-            ps_ref_pic_buf_lx[idx]->ps_mv + u4_half_num_of_sub_mbs;
+        ps_ref_pic_lx[idx + MAX_REF_BUFS]->ps_col_mv =
+            ps_ref_pic_buf_lx[idx]->ps_col_mv + u4_half_num_of_sub_mbs;
       }
     }
   }
@@ -1690,7 +1688,8 @@ WORD32 ih264d_cal_col_pic(dec_struct_t *ps_dec) {
         ps_col_pic->pu1_buf3 = ps_tempPic->pu1_buf3 + ps_tempPic->u2_frm_wd_uv;
         ps_col_pic->pu1_col_zero_flag =
             ps_tempPic->pu1_col_zero_flag + ui_half_num_of_sub_mbs;
-        ps_col_pic->ps_mv = ps_tempPic->ps_mv + ui_half_num_of_sub_mbs;
+        ps_col_pic->ps_col_mv =
+            ps_tempPic->ps_col_mv + ui_half_num_of_sub_mbs;
 
         ps_col_pic->u1_pic_type =
             0; /*complementary reference field pair-refering as frame */
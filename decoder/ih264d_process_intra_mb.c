@@ -595,6 +595,95 @@ UWORD32 ih264d_unpack_luma_coeff8x8_mb(dec_struct_t *ps_dec,
 
   return u4_luma_dc_only_cbp;
 }
+/*!
+ **************************************************************************
+ * \if Function name : ih264d_iquant_itrans_recon_luma_4x4_mb \endif
+ *
+ * \brief
+ *    Inverse quantizes, inverse transforms and reconstructs all the coded
+ *    4x4 luma blocks of a MB in place. Block i of the MB in raster order has
+ *    its coefficients at pi2_coeff + 16 * i. Blocks in u4_dc_only_csbp only
+ *    have a DC coefficient, which is skipped when zero.
+ *
+ * \return
+ *    None
+ **************************************************************************
+ */
+void ih264d_iquant_itrans_recon_luma_4x4_mb(
+    dec_struct_t *ps_dec, WORD16 *pi2_coeff, UWORD8 *pu1_rec,
+    WORD32 i4_rec_strd, const UWORD16 *pu2_iscal_mat,
+    const UWORD16 *pu2_weigh_mat, UWORD32 u4_qp_div_6, UWORD32 u4_csbp,
+    UWORD32 u4_dc_only_csbp, WORD32 i4_iq_start_idx) {
+  UWORD32 i;
+  WORD16 ai2_tmp[16];
+
+  for (i = 0; i < 16; i++) {
+    WORD16 *pi2_level = pi2_coeff + (i << 4);
+    UWORD8 *pu1_pred_sblk =
+        pu1_rec + ((i & 0x3) * BLK_SIZE) + (i >> 2) * (i4_rec_strd << 2);
+    WORD16 *pi2_dc_ld_addr = i4_iq_start_idx ? pi2_level : NULL;
+
+    if (!CHECKBIT(u4_csbp, i)) continue;
+
+    if (CHECKBIT(u4_dc_only_csbp, i)) {
+      if (pi2_level[0] != 0)
+        ps_dec->pf_iquant_itrans_recon_luma_4x4_dc(
+            pi2_level, pu1_pred_sblk, pu1_pred_sblk, i4_rec_strd, i4_rec_strd,
+            pu2_iscal_mat, pu2_weigh_mat, u4_qp_div_6, ai2_tmp,
+            i4_iq_start_idx, pi2_dc_ld_addr);
+    } else {
+      ps_dec->pf_iquant_itrans_recon_luma_4x4(
+          pi2_level, pu1_pred_sblk, pu1_pred_sblk, i4_rec_strd, i4_rec_strd,
+          pu2_iscal_mat, pu2_weigh_mat, u4_qp_div_6, ai2_tmp, i4_iq_start_idx,
+          pi2_dc_ld_addr);
+    }
+  }
+}
+
+/*!
+ **************************************************************************
+ * \if Function name : ih264d_iquant_itrans_recon_chroma_4x4_mb \endif
+ *
+ * \brief
+ *    Inverse quantizes, inverse transforms and reconstructs the 4x4 blocks
+ *    of both chroma planes of a MB in place. The Cb blocks are followed by
+ *    the Cr blocks in pi2_coeff and the DC of every block is already scaled.
+ *    Blocks not in u4_csbp only have a DC coefficient, which is skipped
+ *    when zero.
+ *
+ * \return
+ *    None
+ **************************************************************************
+ */
+void ih264d_iquant_itrans_recon_chroma_4x4_mb(
+    dec_struct_t *ps_dec, WORD16 *pi2_coeff, UWORD8 *pu1_rec,
+    WORD32 i4_rec_strd, const UWORD16 *pu2_iscal_mat_u,
+    const UWORD16 *pu2_iscal_mat_v, const UWORD16 *pu2_weigh_mat_u,
+    const UWORD16 *pu2_weigh_mat_v, UWORD32 u4_qp_div_6_u,
+    UWORD32 u4_qp_div_6_v, UWORD32 u4_csbp) {
+  UWORD32 i;
+  WORD16 ai2_tmp[16];
+
+  for (i = 0; i < 8; i++) {
+    WORD16 *pi2_level = pi2_coeff + (i << 4);
+    UWORD8 *pu1_pred_sblk = pu1_rec + (i >> 2) +
+                            ((i & 0x1) * BLK_SIZE * YUV420SP_FACTOR) +
+                            ((i >> 1) & 0x1) * (i4_rec_strd << 2);
+    const UWORD16 *pu2_iscal_mat = (i < 4) ? pu2_iscal_mat_u : pu2_iscal_mat_v;
+    const UWORD16 *pu2_weigh_mat = (i < 4) ? pu2_weigh_mat_u : pu2_weigh_mat_v;
+    UWORD32 u4_qp_div_6 = (i < 4) ? u4_qp_div_6_u : u4_qp_div_6_v;
+
+    if (CHECKBIT(u4_csbp, i)) {
+      ps_dec->pf_iquant_itrans_recon_chroma_4x4(
+          pi2_level, pu1_pred_sblk, pu1_pred_sblk, i4_rec_strd, i4_rec_strd,
+          pu2_iscal_mat, pu2_weigh_mat, u4_qp_div_6, ai2_tmp, pi2_level);
+    } else if (pi2_level[0] != 0) {
+      ps_dec->pf_iquant_itrans_recon_chroma_4x4_dc(
+          pi2_level, pu1_pred_sblk, pu1_pred_sblk, i4_rec_strd, i4_rec_strd,
+          pu2_iscal_mat, pu2_weigh_mat, u4_qp_div_6, ai2_tmp, pi2_level);
+    }
+  }
+}
 /*!
  **************************************************************************
  * \if Function name : ih264d_process_intra_mb \endif
@@ -813,31 +902,14 @@ WORD32 ih264d_process_intra_mb(dec_struct_t *ps_dec,
           au1_ngbr_pels, pu1_luma_rei1_buffer, 1, ui_rec_width,
           ((uc_useTopMB << 2) | u2_use_left_mb));
     }
-    {
-      UWORD32 i;
-      WORD16 ai2_tmp[16];
-      for (i = 0; i < 16; i++) {
-        WORD16 *pi2_level = pi2_y_coeff + (i << 4);
-        UWORD8 *pu1_pred_sblk = pu1_luma_rei1_buffer + ((i & 0x3) * BLK_SIZE) +
-                                (i >> 2) * (ui_rec_width << 2);
-        PROFILE_DISABLE_IQ_IT_RECON() {
-          if (CHECKBIT(ps_cur_mb_info->u2_luma_csbp, i)) {
-            ps_dec->pf_iquant_itrans_recon_luma_4x4(
-                pi2_level, pu1_pred_sblk, pu1_pred_sblk, ui_rec_width,
-                ui_rec_width,
-                gau2_ih264_iquant_scale_4x4[ps_cur_mb_info->u1_qp_rem6],
-                (UWORD16 *) ps_dec->s_high_profile.i2_scalinglist4x4[0],
-                ps_cur_mb_info->u1_qp_div6, ai2_tmp, 1, pi2_level);
-          } else if ((CHECKBIT(u4_luma_dc_only_csbp, i)) && pi2_level[0] != 0) {
-            ps_dec->pf_iquant_itrans_recon_luma_4x4_dc(
-                pi2_level, pu1_pred_sblk, pu1_pred_sblk, ui_rec_width,
-                ui_rec_width,
-                gau2_ih264_iquant_scale_4x4[ps_cur_mb_info->u1_qp_rem6],
-                (UWORD16 *) ps_dec->s_high_profile.i2_scalinglist4x4[0],
-                ps_cur_mb_info->u1_qp_div6, ai2_tmp, 1, pi2_level);
-          }
-        }
-      }
+    PROFILE_DISABLE_IQ_IT_RECON() {
+      ps_dec->pf_iquant_itrans_recon_luma_4x4_mb(
+          ps_dec, pi2_y_coeff, pu1_luma_rei1_buffer, ui_rec_width,
+          gau2_ih264_iquant_scale_4x4[ps_cur_mb_info->u1_qp_rem6],
+          (UWORD16 *) ps_dec->s_high_profile.i2_scalinglist4x4[0],
+          ps_cur_mb_info->u1_qp_div6,
+          ps_cur_mb_info->u2_luma_csbp | u4_luma_dc_only_csbp,
+          u4_luma_dc_only_csbp & ~ps_cur_mb_info->u2_luma_csbp, 1);
     }
   } else if (!ps_cur_mb_info->u1_tran_form8x8) {
     UWORD8 u1_is_left_sub_block, u1_is_top_sub_block = uc_useTopMB;
@@ -1426,8 +1498,6 @@ WORD32 ih264d_process_intra_mb(dec_struct_t *ps_dec,
     if (u1_chroma_cbp != CBPC_ALLZERO) {
       UWORD16 u2_chroma_csbp =
           (u1_chroma_cbp == CBPC_ACZERO) ? 0 : ps_cur_mb_info->u2_chroma_csbp;
-      UWORD32 u4_scale_u;
-      UWORD32 u4_scale_v;
 
       {
         UWORD16 au2_ngbr_pels[33];
@@ -1477,66 +1547,17 @@ WORD32 ih264d_process_intra_mb(dec_struct_t *ps_dec,
             pu1_ngbr_pels, pu1_mb_cb_rei1_buffer, 1, u4_recwidth_cr,
             ((uc_useTopMB << 2) | (use_left2 << 4) | use_left1));
       }
-      u4_scale_u = ps_cur_mb_info->u1_qpc_div6;
-      u4_scale_v = ps_cur_mb_info->u1_qpcr_div6;
       pi2_y_coeff = ps_dec->pi2_coeff_data;
 
-      {
-        UWORD32 i;
-        WORD16 ai2_tmp[16];
-        for (i = 0; i < 4; i++) {
-          WORD16 *pi2_level = pi2_y_coeff + (i << 4);
-          UWORD8 *pu1_pred_sblk = pu1_mb_cb_rei1_buffer +
-                                  ((i & 0x1) * BLK_SIZE * YUV420SP_FACTOR) +
-                                  (i >> 1) * (u4_recwidth_cr << 2);
-          PROFILE_DISABLE_IQ_IT_RECON() {
-            if (CHECKBIT(u2_chroma_csbp, i)) {
-              ps_dec->pf_iquant_itrans_recon_chroma_4x4(
-                  pi2_level, pu1_pred_sblk, pu1_pred_sblk, u4_recwidth_cr,
-                  u4_recwidth_cr,
-                  gau2_ih264_iquant_scale_4x4[ps_cur_mb_info->u1_qpc_rem6],
-                  (UWORD16 *) ps_dec->s_high_profile.i2_scalinglist4x4[1],
-                  u4_scale_u, ai2_tmp, pi2_level);
-            } else if (pi2_level[0] != 0) {
-              ps_dec->pf_iquant_itrans_recon_chroma_4x4_dc(
-                  pi2_level, pu1_pred_sblk, pu1_pred_sblk, u4_recwidth_cr,
-                  u4_recwidth_cr,
-                  gau2_ih264_iquant_scale_4x4[ps_cur_mb_info->u1_qpc_rem6],
-                  (UWORD16 *) ps_dec->s_high_profile.i2_scalinglist4x4[1],
-                  u4_scale_u, ai2_tmp, pi2_level);
-            }
-          }
-        }
-      }
-
-      pi2_y_coeff += MB_CHROM_SIZE;
-      u2_chroma_csbp = u2_chroma_csbp >> 4;
-      {
-        UWORD32 i;
-        WORD16 ai2_tmp[16];
-        for (i = 0; i < 4; i++) {
-          WORD16 *pi2_level = pi2_y_coeff + (i << 4);
-          UWORD8 *pu1_pred_sblk = pu1_mb_cb_rei1_buffer + 1 +
-                                  ((i & 0x1) * BLK_SIZE * YUV420SP_FACTOR) +
-                                  (i >> 1) * (u4_recwidth_cr << 2);
-          PROFILE_DISABLE_IQ_IT_RECON() {
-            if (CHECKBIT(u2_chroma_csbp, i)) {
-              ps_dec->pf_iquant_itrans_recon_chroma_4x4(
-                  pi2_level, pu1_pred_sblk, pu1_pred_sblk, u4_recwidth_cr,
-                  u4_recwidth_cr,
-                  gau2_ih264_iquant_scale_4x4[ps_cur_mb_info->u1_qpcr_rem6],
-                  (UWORD16 *) ps_dec->s_high_profile.i2_scalinglist4x4[2],
-                  u4_scale_v, ai2_tmp, pi2_level);
-            } else if (pi2_level[0] != 0) {
-              ps_dec->pf_iquant_itrans_recon_chroma_4x4_dc(
-                  pi2_level, pu1_pred_sblk, pu1_pred_sblk, u4_recwidth_cr,
-                  u4_recwidth_cr,
-                  gau2_ih264_iquant_scale_4x4[ps_cur_mb_info->u1_qpcr_rem6],
-                  (UWORD16 *) ps_dec->s_high_profile.i2_scalinglist4x4[2],
-                  u4_scale_v, ai2_tmp, pi2_level);
-            }
-          }
-        }
+      PROFILE_DISABLE_IQ_IT_RECON() {
+        ps_dec->pf_iquant_itrans_recon_chroma_4x4_mb(
+            ps_dec, pi2_y_coeff, pu1_mb_cb_rei1_buffer, u4_recwidth_cr,
+            gau2_ih264_iquant_scale_4x4[ps_cur_mb_info->u1_qpc_rem6],
+            gau2_ih264_iquant_scale_4x4[ps_cur_mb_info->u1_qpcr_rem6],
+            (UWORD16 *) ps_dec->s_high_profile.i2_scalinglist4x4[1],
+            (UWORD16 *) ps_dec->s_high_profile.i2_scalinglist4x4[2],
+            ps_cur_mb_info->u1_qpc_div6, ps_cur_mb_info->u1_qpcr_div6,
+            u2_chroma_csbp);
       }
     } else {
       /* If no inverse transform is needed, pass recon buffer pointer */
@@ -77,6 +77,31 @@ void ih264d_unpack_chroma_coeff4x4_mb(dec_struct_t *ps_dec,
 UWORD32 ih264d_unpack_luma_coeff8x8_mb(dec_struct_t *ps_dec,
                                        dec_mb_info_t *ps_cur_mb_info);
 
+void ih264d_iquant_itrans_recon_luma_4x4_mb(
+    dec_struct_t *ps_dec, WORD16 *pi2_coeff, UWORD8 *pu1_rec,
+    WORD32 i4_rec_strd, const UWORD16 *pu2_iscal_mat,
+    const UWORD16 *pu2_weigh_mat, UWORD32 u4_qp_div_6, UWORD32 u4_csbp,
+    UWORD32 u4_dc_only_csbp, WORD32 i4_iq_start_idx);
+void ih264d_iquant_itrans_recon_chroma_4x4_mb(
+    dec_struct_t *ps_dec, WORD16 *pi2_coeff, UWORD8 *pu1_rec,
+    WORD32 i4_rec_strd, const UWORD16 *pu2_iscal_mat_u,
+    const UWORD16 *pu2_iscal_mat_v, const UWORD16 *pu2_weigh_mat_u,
+    const UWORD16 *pu2_weigh_mat_v, UWORD32 u4_qp_div_6_u,
+    UWORD32 u4_qp_div_6_v, UWORD32 u4_csbp);
+
+/* x86 SSE4.2 */
+void ih264d_iquant_itrans_recon_luma_4x4_mb_sse42(
+    dec_struct_t *ps_dec, WORD16 *pi2_coeff, UWORD8 *pu1_rec,
+    WORD32 i4_rec_strd, const UWORD16 *pu2_iscal_mat,
+    const UWORD16 *pu2_weigh_mat, UWORD32 u4_qp_div_6, UWORD32 u4_csbp,
+    UWORD32 u4_dc_only_csbp, WORD32 i4_iq_start_idx);
+void ih264d_iquant_itrans_recon_chroma_4x4_mb_sse42(
+    dec_struct_t *ps_dec, WORD16 *pi2_coeff, UWORD8 *pu1_rec,
+    WORD32 i4_rec_strd, const UWORD16 *pu2_iscal_mat_u,
+    const UWORD16 *pu2_iscal_mat_v, const UWORD16 *pu2_weigh_mat_u,
+    const UWORD16 *pu2_weigh_mat_v, UWORD32 u4_qp_div_6_u,
+    UWORD32 u4_qp_div_6_v, UWORD32 u4_csbp);
+
 WORD32 ih264d_read_intra_pred_modes(dec_struct_t *ps_dec,
                                     UWORD8 *pu1_prev_intra4x4_pred_mode_flag,
                                     UWORD8 *pu1_rem_intra4x4_pred_mode,
@@ -78,6 +78,8 @@
 #include "ih264d_cabac.h"
 #include "ih264d_debug.h"
 #include "ih264d_tables.h"
+#include "ih264d_perf_stats.h"
+#include "ih264d_trace.h"
 #include "ih264d_parse_slice.h"
 #include "ih264d_utils.h"
 #include "ih264d_parse_islice.h"
@@ -296,9 +298,12 @@ WORD32 ih264d_mv_pred_ref_tfr_nby2_pmb(dec_struct_t *ps_dec, UWORD8 u1_mb_idx,
     }
     /*if num _cores is set to 3,compute bs will be done in another thread*/
     if (ps_dec->u4_num_cores < 3) {
-      if (ps_dec->u4_app_disable_deblk_frm == 0)
+      if (ps_dec->u4_app_disable_deblk_frm == 0) {
+        PERF_STAGE_BEGIN(ps_dec, PERF_SLOT_MAIN, IH264D_PERF_STAGE_BS);
         ps_dec->pf_compute_bs(ps_dec, ps_cur_mb_info,
                               (UWORD16) (i >> u1_mbaff));
+        PERF_STAGE_END(ps_dec, PERF_SLOT_MAIN, IH264D_PERF_STAGE_BS);
+      }
     }
   }
 
@@ -324,11 +329,24 @@ WORD32 ih264d_decode_recon_tfr_nmb(dec_struct_t *ps_dec, UWORD8 u1_mb_idx,
       ((u1_slice_type != I_SLICE) ? (ps_dec->u1_B ? 23 : 5) : 0);
 
   /* N Mb MC Loop */
+  PERF_STAGE_BEGIN(ps_dec, PERF_SLOT_MAIN, IH264D_PERF_STAGE_MC);
   for (i = u1_mb_idx; i < u1_num_mbs; i++) {
     ps_cur_mb_info = ps_dec->ps_nmb_info + i;
     ps_dec->u4_dma_buf_idx = 0;
     ps_dec->u4_pred_info_idx = 0;
 
+    /* Prefetch the reference of an MB later in the group, its MVs are */
+    /* already available as the whole group has been parsed            */
+    if (ps_dec->u4_mc_prefetch_dist &&
+        ((i + ps_dec->u4_mc_prefetch_dist) < u1_num_mbs)) {
+      dec_mb_info_t *ps_pf_mb_info =
+          ps_cur_mb_info + ps_dec->u4_mc_prefetch_dist;
+
+      if ((ps_pf_mb_info->u1_mb_type <= u1_skip_th) ||
+          (ps_pf_mb_info->u1_mb_type == MB_SKIP))
+        ih264d_prefetch_mb_ref(ps_dec, ps_pf_mb_info);
+    }
+
     if (ps_cur_mb_info->u1_mb_type <= u1_skip_th) {
       {
         WORD32 pred_cnt = 0;
@@ -372,11 +390,15 @@ WORD32 ih264d_decode_recon_tfr_nmb(dec_struct_t *ps_dec, UWORD8 u1_mb_idx,
       ps_dec->p_motion_compensate(ps_dec, ps_cur_mb_info);
     }
   }
+  PERF_STAGE_END(ps_dec, PERF_SLOT_MAIN, IH264D_PERF_STAGE_MC);
 
   /* N Mb IQ IT RECON  Loop */
   for (j = u1_mb_idx; j < i; j++) {
     ps_cur_mb_info = ps_dec->ps_nmb_info + j;
 
+    PERF_COUNT_MB(ps_dec, PERF_SLOT_MAIN, ps_cur_mb_info, u1_skip_th,
+                  u1_ipcm_th, ps_dec->u1_B);
+    PERF_STAGE_BEGIN(ps_dec, PERF_SLOT_MAIN, IH264D_PERF_STAGE_RECON);
     if (ps_cur_mb_info->u1_mb_type <= u1_skip_th) {
       ih264d_process_inter_mb(ps_dec, ps_cur_mb_info, j);
     } else if (ps_cur_mb_info->u1_mb_type != MB_SKIP) {
@@ -386,9 +408,12 @@ WORD32 ih264d_decode_recon_tfr_nmb(dec_struct_t *ps_dec, UWORD8 u1_mb_idx,
         if (ret != OK) return ret;
       }
     }
+    PERF_STAGE_END(ps_dec, PERF_SLOT_MAIN, IH264D_PERF_STAGE_RECON);
 
     if (ps_dec->u4_mb_level_deblk == 1) {
+      PERF_STAGE_BEGIN(ps_dec, PERF_SLOT_MAIN, IH264D_PERF_STAGE_DEBLK);
       ih264d_deblock_mb_level(ps_dec, ps_cur_mb_info, j);
+      PERF_STAGE_END(ps_dec, PERF_SLOT_MAIN, IH264D_PERF_STAGE_DEBLK);
     }
 
     if (u1_mbaff) {
@@ -424,8 +449,10 @@ WORD32 ih264d_decode_recon_tfr_nmb(dec_struct_t *ps_dec, UWORD8 u1_mb_idx,
     /* N-Mb MV Data             ( To Ext MV Buffer )                */
     /* N-Mb MVTop/TopRight Data ( To Int MV Top Scratch Buffers)    */
     /****************************************************************/
+    TRACE_BEGIN(ps_dec, PERF_SLOT_MAIN, IH264D_TRACE_MB_GROUP, u1_num_mbs);
     ih264d_transfer_mb_group_data(ps_dec, u1_num_mbs, u1_end_of_row,
                                   u1_end_of_row_next);
+    TRACE_END(ps_dec, PERF_SLOT_MAIN, IH264D_TRACE_MB_GROUP);
     ps_dec->u4_num_mbs_prev_nmb = u1_num_mbs;
 
     if (u1_end_of_row) {
@@ -517,31 +544,13 @@ WORD32 ih264d_process_inter_mb(dec_struct_t *ps_dec,
   if (ps_cur_mb_info->u1_cbp & 0x0f) {
     /* CHANGED CODE */
     if (!ps_cur_mb_info->u1_tran_form8x8) {
-      UWORD32 i;
-      WORD16 ai2_tmp[16];
-      for (i = 0; i < 16; i++) {
-        if (CHECKBIT(ps_cur_mb_info->u2_luma_csbp, i)) {
-          WORD16 *pi2_level = pi2_y_coeff + (i << 4);
-          UWORD8 *pu1_pred_sblk = pu1_rec_y + ((i & 0x3) * BLK_SIZE) +
-                                  (i >> 2) * (ui_rec_width << 2);
-          PROFILE_DISABLE_IQ_IT_RECON() {
-            if (CHECKBIT(u4_luma_dc_only_csbp, i)) {
-              ps_dec->pf_iquant_itrans_recon_luma_4x4_dc(
-                  pi2_level, pu1_pred_sblk, pu1_pred_sblk, ui_rec_width,
-                  ui_rec_width,
-                  gau2_ih264_iquant_scale_4x4[ps_cur_mb_info->u1_qp_rem6],
-                  (UWORD16 *) ps_dec->s_high_profile.i2_scalinglist4x4[3],
-                  ps_cur_mb_info->u1_qp_div6, ai2_tmp, 0, NULL);
-            } else {
-              ps_dec->pf_iquant_itrans_recon_luma_4x4(
-                  pi2_level, pu1_pred_sblk, pu1_pred_sblk, ui_rec_width,
-                  ui_rec_width,
-                  gau2_ih264_iquant_scale_4x4[ps_cur_mb_info->u1_qp_rem6],
-                  (UWORD16 *) ps_dec->s_high_profile.i2_scalinglist4x4[3],
-                  ps_cur_mb_info->u1_qp_div6, ai2_tmp, 0, NULL);
-            }
-          }
-        }
+      PROFILE_DISABLE_IQ_IT_RECON() {
+        ps_dec->pf_iquant_itrans_recon_luma_4x4_mb(
+            ps_dec, pi2_y_coeff, pu1_rec_y, ui_rec_width,
+            gau2_ih264_iquant_scale_4x4[ps_cur_mb_info->u1_qp_rem6],
+            (UWORD16 *) ps_dec->s_high_profile.i2_scalinglist4x4[3],
+            ps_cur_mb_info->u1_qp_div6, ps_cur_mb_info->u2_luma_csbp,
+            u4_luma_dc_only_csbp, 0);
       }
     } else {
       WORD16 *pi2_scale_matrix_ptr;
@@ -588,69 +597,17 @@ WORD32 ih264d_process_inter_mb(dec_struct_t *ps_dec,
     UWORD8 u1_chroma_cbp = (UWORD8) (ps_cur_mb_info->u1_cbp >> 4);
 
     if (u1_chroma_cbp != CBPC_ALLZERO) {
-      UWORD32 u4_scale_u = ps_cur_mb_info->u1_qpc_div6;
-      UWORD32 u4_scale_v = ps_cur_mb_info->u1_qpcr_div6;
-      UWORD16 u2_chroma_csbp = ps_cur_mb_info->u2_chroma_csbp;
-
       pi2_y_coeff = ps_dec->pi2_coeff_data;
 
-      {
-        UWORD32 i;
-        WORD16 ai2_tmp[16];
-        for (i = 0; i < 4; i++) {
-          WORD16 *pi2_level = pi2_y_coeff + (i << 4);
-          UWORD8 *pu1_pred_sblk = pu1_rec_u +
-                                  ((i & 0x1) * BLK_SIZE * YUV420SP_FACTOR) +
-                                  (i >> 1) * (u4_recwidth_cr << 2);
-          PROFILE_DISABLE_IQ_IT_RECON() {
-            if (CHECKBIT(u2_chroma_csbp, i)) {
-              ps_dec->pf_iquant_itrans_recon_chroma_4x4(
-                  pi2_level, pu1_pred_sblk, pu1_pred_sblk, u4_recwidth_cr,
-                  u4_recwidth_cr,
-                  gau2_ih264_iquant_scale_4x4[ps_cur_mb_info->u1_qpc_rem6],
-                  (UWORD16 *) ps_dec->s_high_profile.i2_scalinglist4x4[4],
-                  u4_scale_u, ai2_tmp, pi2_level);
-            } else if (pi2_level[0] != 0) {
-              ps_dec->pf_iquant_itrans_recon_chroma_4x4_dc(
-                  pi2_level, pu1_pred_sblk, pu1_pred_sblk, u4_recwidth_cr,
-                  u4_recwidth_cr,
-                  gau2_ih264_iquant_scale_4x4[ps_cur_mb_info->u1_qpc_rem6],
-                  (UWORD16 *) ps_dec->s_high_profile.i2_scalinglist4x4[4],
-                  u4_scale_u, ai2_tmp, pi2_level);
-            }
-          }
-        }
-      }
-
-      pi2_y_coeff += MB_CHROM_SIZE;
-      u2_chroma_csbp >>= 4;
-
-      {
-        UWORD32 i;
-        WORD16 ai2_tmp[16];
-        for (i = 0; i < 4; i++) {
-          WORD16 *pi2_level = pi2_y_coeff + (i << 4);
-          UWORD8 *pu1_pred_sblk = pu1_rec_u + 1 +
-                                  ((i & 0x1) * BLK_SIZE * YUV420SP_FACTOR) +
-                                  (i >> 1) * (u4_recwidth_cr << 2);
-          PROFILE_DISABLE_IQ_IT_RECON() {
-            if (CHECKBIT(u2_chroma_csbp, i)) {
-              ps_dec->pf_iquant_itrans_recon_chroma_4x4(
-                  pi2_level, pu1_pred_sblk, pu1_pred_sblk, u4_recwidth_cr,
-                  u4_recwidth_cr,
-                  gau2_ih264_iquant_scale_4x4[ps_cur_mb_info->u1_qpcr_rem6],
-                  (UWORD16 *) ps_dec->s_high_profile.i2_scalinglist4x4[5],
-                  u4_scale_v, ai2_tmp, pi2_level);
-            } else if (pi2_level[0] != 0) {
-              ps_dec->pf_iquant_itrans_recon_chroma_4x4_dc(
-                  pi2_level, pu1_pred_sblk, pu1_pred_sblk, u4_recwidth_cr,
-                  u4_recwidth_cr,
-                  gau2_ih264_iquant_scale_4x4[ps_cur_mb_info->u1_qpcr_rem6],
-                  (UWORD16 *) ps_dec->s_high_profile.i2_scalinglist4x4[5],
-                  u4_scale_v, ai2_tmp, pi2_level);
-            }
-          }
-        }
+      PROFILE_DISABLE_IQ_IT_RECON() {
+        ps_dec->pf_iquant_itrans_recon_chroma_4x4_mb(
+            ps_dec, pi2_y_coeff, pu1_rec_u, u4_recwidth_cr,
+            gau2_ih264_iquant_scale_4x4[ps_cur_mb_info->u1_qpc_rem6],
+            gau2_ih264_iquant_scale_4x4[ps_cur_mb_info->u1_qpcr_rem6],
+            (UWORD16 *) ps_dec->s_high_profile.i2_scalinglist4x4[4],
+            (UWORD16 *) ps_dec->s_high_profile.i2_scalinglist4x4[5],
+            ps_cur_mb_info->u1_qpc_div6, ps_cur_mb_info->u1_qpcr_div6,
+            ps_cur_mb_info->u2_chroma_csbp);
       }
     }
   }
@@ -662,7 +619,8 @@ WORD32 ih264d_process_inter_mb(dec_struct_t *ps_dec,
  * \if Function name : ih264d_parse_pred_weight_table \endif
  *
  * \brief
- *    Implements pred_weight_table() of 7.3.3.2.
+ *    Implements pred_weight_table() of 7.3.3.2. Chroma weights are only
+ *    present when u1_chroma_present is set, i.e. for non 4:0:0 streams.
  *
  * \return
  *    None
@@ -670,7 +628,8 @@ WORD32 ih264d_process_inter_mb(dec_struct_t *ps_dec,
  **************************************************************************
  */
 WORD32 ih264d_parse_pred_weight_table(dec_slice_params_t *ps_cur_slice,
-                                      dec_bit_stream_t *ps_bitstrm) {
+                                      dec_bit_stream_t *ps_bitstrm,
+                                      UWORD8 u1_chroma_present) {
   UWORD32 *pu4_bitstrm_buf = ps_bitstrm->pu4_buffer;
   UWORD32 *pu4_bitstrm_ofst = &ps_bitstrm->u4_ofst;
   WORD8 i, cont, lx;
@@ -694,7 +653,9 @@ WORD32 ih264d_parse_pred_weight_table(dec_slice_params_t *ps_cur_slice,
   COPYTHECONTEXT("SH: luma_log2_weight_denom", uc_luma_log2_weight_denom);
   ui32_y_def_weight_ofst = (1 << uc_luma_log2_weight_denom);
 
-  u4_temp = ih264d_uev(pu4_bitstrm_ofst, pu4_bitstrm_buf);
+  u4_temp = 0;
+  if (u1_chroma_present)
+    u4_temp = ih264d_uev(pu4_bitstrm_ofst, pu4_bitstrm_buf);
   if (u4_temp & MASK_LOG2_WEIGHT_DENOM) {
     return ERROR_PRED_WEIGHT_TABLE_T;
   }
@@ -735,7 +696,9 @@ WORD32 ih264d_parse_pred_weight_table(dec_slice_params_t *ps_cur_slice,
 
       {
         WORD8 c_weightCb, c_weightCr, c_offsetCb, c_offsetCr;
-        uc_weight_flag = ih264d_get_bit_h264(ps_bitstrm);
+        uc_weight_flag = 0;
+        if (u1_chroma_present)
+          uc_weight_flag = ih264d_get_bit_h264(ps_bitstrm);
         pu4_bitstrm_buf = ps_bitstrm->pu4_buffer;
         COPYTHECONTEXT("SH: chroma_weight_l0_flag", uc_weight_flag);
         if (uc_weight_flag) {
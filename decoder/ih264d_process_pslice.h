@@ -65,7 +65,8 @@
 #include "ih264d_structs.h"
 WORD32 ih264d_parse_pslice(dec_struct_t *ps_dec, UWORD16 u2_first_mb_in_slice);
 WORD32 ih264d_parse_pred_weight_table(dec_slice_params_t *ps_cur_slice,
-                                      dec_bit_stream_t *ps_bitstrm);
+                                      dec_bit_stream_t *ps_bitstrm,
+                                      UWORD8 u1_chroma_present);
 
 WORD32 parsePSliceData(dec_struct_t *ps_dec, dec_slice_params_t *ps_slice,
                        UWORD16 u2_first_mb_in_slice);
@@ -196,6 +196,20 @@ typedef struct _mv_pred_t {
 
 } mv_pred_t;
 
+/**
+ * Co-located motion of a reference picture, as read by temporal direct
+ * prediction. Only the MV that temporal direct picks is kept: the L0 MV when
+ * i1_ref_frame[0] >= 0, else the L1 MV when i1_ref_frame[1] >= 0, else zero.
+ */
+typedef struct {
+  WORD16 i2_mv[2];
+  WORD8 i1_ref_frame[2];
+
+  UWORD8 u1_col_ref_pic_idx; /** MV buffer id of the picture referred to */
+  UWORD8 u1_pic_type;        /** Pic type of the picture referred to */
+
+} col_mv_t;
+
 typedef struct {
   WORD32 i4_mv_indices[16];
   WORD8 i1_submb_num[16];
@@ -233,8 +247,9 @@ typedef struct pic_buffer_t {
   UWORD8 u1_mv_buf_id;
   WORD32 i4_seq;
   UWORD8 *pu1_col_zero_flag;
-  mv_pred_t *ps_mv; /** Pointer to the MV bank array */
-  WORD32 i4_poc;    /** POC */
+  mv_pred_t *ps_mv;     /** Pointer to the MV bank array */
+  col_mv_t *ps_col_mv;  /** Pointer to the co-located MV array */
+  WORD32 i4_poc;        /** POC */
   WORD32 i4_pic_num;
   WORD32 i4_frame_num;
   WORD32 i4_top_field_order_cnt;    /** TopPOC */
@@ -289,7 +304,7 @@ typedef struct {
   void *pv_col_zero_flag;
 
   /**
-   * Pointer to buffer that holds mv_pred
+   * Pointer to buffer that holds the co-located MVs (col_mv_t)
    */
   void *pv_mv;
 
@@ -380,6 +395,7 @@ typedef struct {
 
   UWORD8 u1_profile_idc; /** profile value */
   UWORD8 u1_level_idc;   /** level value */
+  UWORD8 u1_intra_profile; /** 1 - Intra profile, only I slices */
 
   /* high profile related syntax elements   */
   WORD32 i4_chroma_format_idc;
@@ -611,6 +627,17 @@ typedef struct {
 
 } deblk_mb_t;
 
+/* Filter parameters of a MB without MBAFF, used by the row deblocking */
+typedef struct {
+  /* Packed Bs of top and horizontal edges 1-3 followed by left and vertical */
+  /* edges 1-3, as in u4_bs_table. Zero for the edges that are not filtered  */
+  UWORD32 au4_bs[8];
+  /* alpha, beta and tc0 table of Y, Cb and Cr for each edge type */
+  const UWORD8 *apu1_cliptab[NUM_DEBLK_EDGE_TYPES][3];
+  UWORD8 au1_alpha[NUM_DEBLK_EDGE_TYPES][3];
+  UWORD8 au1_beta[NUM_DEBLK_EDGE_TYPES][3];
+} deblk_row_mb_t;
+
 typedef struct {
   UWORD8 u1_mb_type;
   UWORD8 u1_mb_qp;
@@ -743,6 +770,273 @@ typedef struct {
   UWORD32 u4_num_rows_y;
 } fmt_conv_part_t;
 
+/**
+ * Context of a deblocking worker. MB row (MB pair row for MBAFF) r of the
+ * picture is deblocked by worker (r % number of workers)
+ */
+typedef struct _deblk_worker_ctxt_t {
+  /**
+   * Decoder context
+   */
+  void *pv_dec;
+
+  /**
+   * Transfer context of the picture, used by picture level deblocking
+   */
+  tfr_ctxt_t *ps_tfr_cxt;
+
+  /**
+   * Thread handle, unused for worker 0
+   */
+  void *pv_thread_handle;
+
+  /**
+   * Worker index
+   */
+  UWORD32 u4_id;
+
+  /**
+   * Set if the thread of the worker is created. The thread is created on the
+   * first picture that needs it and is parked between pictures until the
+   * decoder is cleared
+   */
+  UWORD32 u4_thread_created;
+
+  /**
+   * Mutex and condition the parked thread waits on, unused for worker 0
+   */
+  void *pv_park_mutex;
+  void *pv_park_cond;
+
+  /**
+   * Deblocking of the current picture run by the thread, valid while
+   * u4_job_pending is set
+   */
+  void (*pf_job)(struct _deblk_worker_ctxt_t *ps_worker);
+
+  /**
+   * Set by the thread dispatching a picture, cleared by the worker once done
+   */
+  UWORD32 u4_job_pending;
+
+  /**
+   * Set to make the parked thread exit
+   */
+  UWORD32 u4_exit;
+
+  /**
+   * Progress in raster order of MBs (MB pairs for MBAFF). All the units before
+   * this one that are handled by this worker are deblocked
+   */
+  volatile UWORD32 u4_deblk_num;
+} deblk_worker_ctxt_t;
+
+/** Timer of the decode and get display frame calls, next to the stage timers */
+#define PERF_TIMER_CALL IH264D_PERF_NUM_STAGES
+#define PERF_NUM_TIMERS (IH264D_PERF_NUM_STAGES + 1)
+
+/**
+ * Profiling counters of one logical thread. They are updated only when the
+ * library is built with PERF_STATS_ENABLE
+ */
+typedef struct {
+  /**
+   * Ticks spent in each stage, and in decode calls for the API thread
+   */
+  UWORD64 au8_ticks[PERF_NUM_TIMERS];
+
+  /**
+   * Timer value at the start of the stage being timed
+   */
+  UWORD64 au8_start[PERF_NUM_TIMERS];
+
+  /**
+   * Number of reconstructed MBs of each type
+   */
+  UWORD64 au8_num_mbs[IH264D_PERF_NUM_MB_TYPES];
+
+  /**
+   * Number of spin-wait loop iterations
+   */
+  UWORD64 u8_num_spin_waits;
+
+  /**
+   * Keeps the counters of different threads in different cache lines
+   */
+  UWORD8 au1_pad[64];
+} perf_slot_t;
+
+/**
+ * Trace events of a profiling slot, written only by the thread owning the
+ * slot and read between API calls
+ */
+typedef struct {
+  /**
+   * Ring of TRACE_EVENTS_PER_SLOT events
+   */
+  ih264d_trace_event_t *ps_events;
+
+  /**
+   * Number of events written and read since the decoder was created
+   */
+  UWORD32 u4_num_written;
+  UWORD32 u4_num_read;
+
+  /**
+   * 1 while a wait span opened by a spin-wait loop iteration is not closed
+   */
+  UWORD32 u4_wait_open;
+
+  /**
+   * Keeps the rings of different threads in different cache lines
+   */
+  UWORD8 au1_pad[64];
+} trace_ring_t;
+
+/**
+ * State of the deadline controller, see ih264d_deadline.c
+ */
+typedef struct {
+  /**
+   * Decode time allowed per picture in microseconds, 0 when it is off
+   */
+  UWORD32 u4_deadline_us;
+
+  /**
+   * Degrade level applied to the next non-reference picture
+   */
+  UWORD32 u4_level;
+
+  /**
+   * Decode calls left before the level may change again
+   */
+  UWORD32 u4_hold;
+
+  /**
+   * Running averages in microseconds: all calls, decoded reference and
+   * non-reference pictures, and I, P, B pictures
+   */
+  UWORD32 u4_avg_us;
+  UWORD32 u4_ref_avg_us;
+  UWORD32 u4_non_ref_avg_us;
+  UWORD32 au4_type_avg_us[3];
+
+  /**
+   * Share of non-reference pictures in 1/256 units, running average
+   */
+  UWORD32 u4_non_ref_share;
+
+  /**
+   * Monotonic clock (ns) at the start of the decode call
+   */
+  UWORD64 u8_call_start_ns;
+
+  /**
+   * Non-reference picture dropped in the current decode call
+   */
+  UWORD32 u4_dropped_in_call;
+
+  /**
+   * Counters read through IH264D_CMD_CTL_GET_DEADLINE_STATS
+   */
+  UWORD32 u4_max_level;
+  UWORD32 u4_num_pics;
+  UWORD32 u4_num_over_deadline;
+  UWORD32 u4_num_escalations;
+  UWORD32 u4_num_relaxations;
+  UWORD32 u4_num_deblk_skipped;
+  UWORD32 u4_num_full_pel;
+  UWORD32 u4_num_dropped;
+} deadline_ctxt_t;
+
+/**
+ * One 8x8 block of film grain, see ih264d_film_grain.c
+ */
+typedef struct {
+  /**
+   * First sample of the block in its 64x64 grain pattern, rows
+   * FG_PATTERN_SIZE apart. NULL for a block without grain
+   */
+  const WORD8 *pi1_pattern;
+
+  /**
+   * Scale of the intensity interval of the block, negated to invert it
+   */
+  WORD32 i4_scale;
+} film_grain_blk_t;
+
+/**
+ * Film grain synthesis state, held in MEM_REC_FILM_GRAIN
+ */
+typedef struct {
+  /**
+   * Grain pattern of each horizontal and vertical cutoff frequency pair.
+   * A pattern is generated the first time a picture uses it
+   */
+  WORD8 ai1_pattern[FG_NUM_CUTOFFS][FG_NUM_CUTOFFS]
+                   [FG_PATTERN_SIZE * FG_PATTERN_SIZE];
+
+  /**
+   * Bit v of entry h is set once pattern [h][v] is generated
+   */
+  UWORD16 au2_pattern_ready[FG_NUM_CUTOFFS];
+
+  /**
+   * Integer 64 point inverse DCT, basis k sampled at n in entry [n][k]
+   */
+  WORD8 ai1_transform[FG_PATTERN_SIZE][FG_PATTERN_SIZE];
+
+  /**
+   * Intermediate of the separable transform
+   */
+  WORD16 ai2_tmp[FG_PATTERN_SIZE * FG_PATTERN_SIZE];
+
+  /**
+   * Gaussian samples, padded so that four can be read from any entry
+   */
+  WORD8 ai1_gaussian[FG_GAUSSIAN_LUT_SIZE + 4];
+
+  /**
+   * Seeds of the pseudo random generator
+   */
+  UWORD32 au4_seed[FG_SEED_LUT_SIZE];
+
+  /**
+   * Following members describe the picture being output and are set
+   * before its format conversion. u4_apply is 0 when no grain is added
+   */
+  UWORD32 u4_apply;
+
+  /**
+   * Right shift of the scaled grain, log2_scale_factor + 6
+   */
+  UWORD32 u4_shift;
+
+  /**
+   * Grain is added to the colour component
+   */
+  UWORD8 au1_comp_present[3];
+
+  /**
+   * Intensity interval of each 8x8 block average plus 1, 0 for none,
+   * per colour component
+   */
+  UWORD8 au1_interval[3][256];
+
+  /**
+   * Pattern and scale of each intensity interval, per colour component
+   */
+  film_grain_blk_t as_interval[3][256];
+
+  /**
+   * Seed of the first random offset block of each row of them, per
+   * colour component, u4_max_rows apart. A random offset block is 16x16
+   * luma or 8x8 chroma samples
+   */
+  UWORD32 *pu4_row_seed;
+  UWORD32 u4_max_rows;
+} film_grain_ctxt_t;
+
 /**
  * Structure to hold coefficient info for a 4x4 transform
  */
@@ -857,6 +1151,8 @@ typedef struct _DecStruct {
   WORD16 i2_only_backwarddma_info_idx;
   mv_pred_t *ps_mv;            /** Pointer to the MV bank array */
   mv_pred_t *ps_mv_bank_cur;   /** Pointer to the MV bank array */
+  mv_pred_t *ps_mv_bank_base;  /** Working MV bank of the current picture */
+  UWORD8 u1_col_mv_8x8;        /** Co-located MVs kept one per 8x8 block */
   mv_pred_t s_default_mv_pred; /** Structure containing the default values
    for MV predictor */
 
@@ -1327,6 +1623,53 @@ typedef struct _DecStruct {
   UWORD32 u4_num_extra_disp_bufs_at_init;
   UWORD32 u4_num_disp_bufs_requested;
   WORD32 i4_display_delay;
+
+  /**
+   * Low delay output asked for through IH264D_CMD_CTL_SET_LOW_DELAY
+   */
+  UWORD32 u4_low_delay;
+
+  /**
+   * Pictures are sent to display at the end of their decode
+   */
+  UWORD8 u1_low_delay;
+
+  /**
+   * Output order is not known from the SPS, POCs are checked
+   */
+  UWORD8 u1_low_delay_check_poc;
+
+  /**
+   * A picture came out of POC order, low delay is off until a reset
+   */
+  UWORD8 u1_low_delay_dropped;
+
+  /**
+   * Display delay of the sequence, restored when low delay is dropped
+   */
+  WORD32 i4_seq_display_delay;
+
+  /**
+   * POC of the previous picture sent to display in low delay
+   */
+  WORD32 i4_low_delay_prev_poc;
+
+  /**
+   * Intra only decode asked for through IH264D_CMD_CTL_SET_INTRA_ONLY
+   */
+  UWORD32 u4_intra_only;
+
+  /**
+   * Memory records were sized for intra only decode at init: no co-located
+   * MVs and no reference pictures
+   */
+  UWORD32 u4_intra_only_at_init;
+
+  /**
+   * Active sequence has I slices only: reference pictures are not padded
+   * and co-located MVs are not stored
+   */
+  UWORD8 u1_intra_only;
   UWORD32 u4_slice_start_code_found;
 
   UWORD32 u4_mb_level_deblk;
@@ -1335,8 +1678,18 @@ typedef struct _DecStruct {
   UWORD32 u4_app_deblk_disable_level;
   UWORD32 u4_app_disable_deblk_frm;
   WORD32 i4_app_skip_mode;
+
+  /**
+   * Mask applied to the MVs of the current picture for MC, clears the
+   * fractional bits when inter prediction is degraded
+   */
   WORD32 i4_mv_frac_mask;
 
+  /**
+   * Number of MBs ahead of the current MB whose MC reference is prefetched
+   */
+  UWORD32 u4_mc_prefetch_dist;
+
   disp_buf_t disp_bufs[MAX_DISP_BUFS_NEW];
   UWORD32 u4_disp_buf_mapping[MAX_DISP_BUFS_NEW];
   UWORD32 u4_disp_buf_to_be_freed[MAX_DISP_BUFS_NEW];
@@ -1360,6 +1713,49 @@ typedef struct _DecStruct {
   UWORD32 u4_deblk_mb_y;
   deblk_mb_t *ps_cur_deblk_thrd_mb;
 
+  /**
+   * Number of cores set by the application, which is also the number of
+   * deblocking workers for picture level deblocking
+   */
+  UWORD32 u4_num_deblk_cores;
+
+  /**
+   * Number of workers deblocking the current picture
+   */
+  UWORD32 u4_num_deblk_workers;
+
+  deblk_worker_ctxt_t as_deblk_worker[MAX_DEBLK_WORKERS];
+
+  /**
+   * Profiling counters, see ih264d_perf_stats.h
+   */
+  perf_slot_t as_perf_slot[PERF_NUM_SLOTS];
+
+  /**
+   * Timer and monotonic clock (ns) when the counters were last cleared, used
+   * to find the timer frequency
+   */
+  UWORD64 u8_perf_ref_ticks;
+  UWORD64 u8_perf_ref_ns;
+
+  /**
+   * Trace events, see ih264d_trace.h
+   */
+  trace_ring_t as_trace_ring[PERF_NUM_SLOTS];
+
+  /**
+   * Allocation of the picture sized records on SPS activation. The records
+   * given by the application are kept to be handed back on retrieve
+   */
+  UWORD32 u4_alloc_per_sps;
+  void *(*pf_aligned_alloc)(void *pv_mem_ctxt, WORD32 alignment, WORD32 size);
+  void (*pf_aligned_free)(void *pv_mem_ctxt, void *pv_buf);
+  void *pv_mem_ctxt;
+  void *pv_sps_mem;
+  UWORD32 u4_sps_mem_size;
+  UWORD32 u4_sps_mem_shrink_cnt;
+  iv_mem_rec_t as_sps_mem_rec_app[NUM_SPS_MEM_RECS];
+
   iv_yuv_buf_t s_disp_frame_info;
   UWORD32 u4_fmt_conv_num_rows;
   UWORD32 u4_fmt_conv_cur_row;
@@ -1422,6 +1818,18 @@ typedef struct _DecStruct {
    */
   WORD32 i4_degrade_pic_cnt;
 
+  /**
+   * Deadline controller degrading non-reference pictures
+   */
+  deadline_ctxt_t s_deadline;
+
+  /**
+   * Film grain added at format conversion, see ih264d_film_grain.c.
+   * ps_film_grain is NULL when it is not enabled at init
+   */
+  UWORD32 u4_film_grain;
+  film_grain_ctxt_t *ps_film_grain;
+
   fmt_conv_part_t as_fmt_conv_part[2];
   UWORD32 u4_fmt_conv_in_process;
   UWORD32 u4_pic_buf_got;
@@ -1496,6 +1904,27 @@ typedef struct _DecStruct {
 
   ih264_ihadamard_scaling_ft *pf_ihadamard_scaling_4x4;
 
+  /**
+   * inverse quantize, inverse transform and reconstruct the coded 4x4 luma
+   * blocks of a MB
+   */
+  void (*pf_iquant_itrans_recon_luma_4x4_mb)(
+      struct _DecStruct *ps_dec, WORD16 *pi2_coeff, UWORD8 *pu1_rec,
+      WORD32 i4_rec_strd, const UWORD16 *pu2_iscal_mat,
+      const UWORD16 *pu2_weigh_mat, UWORD32 u4_qp_div_6, UWORD32 u4_csbp,
+      UWORD32 u4_dc_only_csbp, WORD32 i4_iq_start_idx);
+
+  /**
+   * inverse quantize, inverse transform and reconstruct the 4x4 Cb and Cr
+   * blocks of a MB
+   */
+  void (*pf_iquant_itrans_recon_chroma_4x4_mb)(
+      struct _DecStruct *ps_dec, WORD16 *pi2_coeff, UWORD8 *pu1_rec,
+      WORD32 i4_rec_strd, const UWORD16 *pu2_iscal_mat_u,
+      const UWORD16 *pu2_iscal_mat_v, const UWORD16 *pu2_weigh_mat_u,
+      const UWORD16 *pu2_weigh_mat_v, UWORD32 u4_qp_div_6_u,
+      UWORD32 u4_qp_div_6_v, UWORD32 u4_csbp);
+
   /**
    * deblock vertical luma edge with blocking strength 4
    */
@@ -1556,6 +1985,65 @@ typedef struct _DecStruct {
    */
   ih264_deblk_chroma_edge_bslt4_ft *pf_deblk_chroma_horz_bslt4;
 
+  /**
+   * deblock a run of MBs of a row without MBAFF, vertical edges of each MB
+   * followed by its horizontal edges
+   */
+  void (*pf_deblk_row_nonmbaff)(struct _DecStruct *ps_dec, UWORD8 *pu1_y,
+                                UWORD8 *pu1_uv, WORD32 i4_strd_y,
+                                WORD32 i4_strd_uv, deblk_row_mb_t *ps_row_mb,
+                                WORD32 i4_num_mbs);
+
+  /**
+   * film grain: 8x8 block averages of a row of luma blocks
+   */
+  void (*pf_film_grain_avg_luma)(const UWORD8 *pu1_src, WORD32 i4_strd,
+                                 WORD32 i4_num_blks, UWORD8 *pu1_avg);
+
+  /**
+   * film grain: 8x8 block averages of a row of interleaved chroma blocks
+   */
+  void (*pf_film_grain_avg_chroma)(const UWORD8 *pu1_src, WORD32 i4_strd,
+                                   WORD32 i4_num_blks, UWORD8 *pu1_avg_u,
+                                   UWORD8 *pu1_avg_v);
+
+  /**
+   * film grain: one row of grain of a run of 8x8 blocks
+   */
+  void (*pf_film_grain_synth_row)(WORD16 *pi2_grain,
+                                  const film_grain_blk_t *ps_blk,
+                                  WORD32 i4_num_blks, WORD32 i4_row,
+                                  WORD32 i4_shift);
+
+  /**
+   * film grain: adds a row of grain to a planar row of samples
+   */
+  void (*pf_film_grain_blend)(UWORD8 *pu1_dst, const WORD16 *pi2_grain,
+                              WORD32 i4_wd);
+
+  /**
+   * film grain: adds rows of grain of two components to an interleaved row
+   */
+  void (*pf_film_grain_blend_uv)(UWORD8 *pu1_dst, const WORD16 *pi2_grain_u,
+                                 const WORD16 *pi2_grain_v, WORD32 i4_wd);
+
+  /**
+   * output conversion of rows of the 420SP display picture to 420P
+   */
+  void (*pf_fmt_conv_420sp_to_420p)(
+      UWORD8 *pu1_y_src, UWORD8 *pu1_uv_src, UWORD8 *pu1_y_dst,
+      UWORD8 *pu1_u_dst, UWORD8 *pu1_v_dst, WORD32 wd, WORD32 ht,
+      WORD32 src_y_strd, WORD32 src_uv_strd, WORD32 dst_y_strd,
+      WORD32 dst_uv_strd, WORD32 is_u_first, WORD32 disable_luma_copy);
+
+  /**
+   * output conversion of rows of the 420SP display picture to 420SP VU
+   */
+  void (*pf_fmt_conv_420sp_to_420sp_swap_uv)(
+      UWORD8 *pu1_y_src, UWORD8 *pu1_uv_src, UWORD8 *pu1_y_dst,
+      UWORD8 *pu1_uv_dst, WORD32 wd, WORD32 ht, WORD32 src_y_strd,
+      WORD32 src_uv_strd, WORD32 dst_y_strd, WORD32 dst_uv_strd);
+
 } dec_struct_t;
 
 #endif /* _H264_DEC_STRUCTS_H */
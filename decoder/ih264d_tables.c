@@ -60,6 +60,9 @@
 #include "ih264_macros.h"
 #include "ih264_platform_macros.h"
 #include "ih264d_defs.h"
+#include "iv.h"
+#include "ivd.h"
+#include "ih264d.h"
 
 const UWORD8 gau1_ih264d_qp_scale_cr[] = {
     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  1,  2,  3,  4,  5,  6,
@@ -320,6 +323,14 @@ const UWORD8 gau1_ih264d_cbp_table[48][2] = {
     {20, 24}, {24, 19}, {6, 21},  {9, 26},  {22, 28}, {25, 23}, {32, 27},
     {33, 29}, {34, 30}, {36, 22}, {40, 25}, {38, 38}, {41, 41},
 };
+
+/** gives CBP value from codeword number for 4:0:0 streams, which have no */
+/** chroma bits in the CBP, both for intra and inter                     */
+
+const UWORD8 gau1_ih264d_cbp_table_gray[16][2] = {
+    {15, 0}, {0, 1}, {7, 2},  {11, 4}, {13, 8}, {14, 3}, {3, 5}, {5, 10},
+    {10, 12}, {12, 15}, {1, 7}, {2, 11}, {4, 13}, {8, 14}, {6, 6}, {9, 9},
+};
 /****************PARSING TABLES ENDS *******************/
 
 /****************DECODE SLICE TABLES STARTS *******************/
@@ -955,3 +966,94 @@ const UWORD8 gau1_ih264d_submb_indx_mod_sp_drct[] = {
     0, 1,
     3, 1 /* 4x4 */
 };
+
+/*!
+ **************************************************************************
+ *   \brief   gau1_ih264d_sps_mem_recs
+ *
+ *   Memory records whose size scales with the picture. When the decoder is
+ *   initialized with u4_alloc_per_sps they are allocated on SPS activation,
+ *   in this order from one block, instead of by the application.
+ **************************************************************************
+ */
+const UWORD8 gau1_ih264d_sps_mem_recs[NUM_SPS_MEM_RECS] = {
+    MEM_REC_REF_PIC,       MEM_REC_MVBANK,        MEM_REC_MV_BUF_MGR,
+    MEM_REC_COEFF_DATA,    MEM_REC_PRED_INFO_PKD, MEM_REC_SLICE_HDR,
+    MEM_REC_MB_INFO,       MEM_REC_DEBLK_MB_INFO, MEM_REC_INTERNAL_PERSIST,
+    MEM_REC_PARSE_MAP,     MEM_REC_PROC_MAP,      MEM_REC_SLICE_NUM_MAP};
+
+/*!
+ **************************************************************************
+ *   \brief   gau1_ih264d_mem_rec_placement
+ *
+ *   Placement hint of every memory record, indexed by record. Reference
+ *   pictures and the MV bank are read at random by MC and direct prediction
+ *   of every MB; MB level context is walked in order once per picture.
+ **************************************************************************
+ */
+const UWORD8 gau1_ih264d_mem_rec_placement[MEM_REC_CNT] = {
+    IH264D_MEM_PLACEMENT_COLD,      /* MEM_REC_IV_OBJ */
+    IH264D_MEM_PLACEMENT_HOT,       /* MEM_REC_CODEC */
+    IH264D_MEM_PLACEMENT_STREAMING, /* MEM_REC_BITSBUF */
+    IH264D_MEM_PLACEMENT_STREAMING, /* MEM_REC_COEFF_DATA */
+    IH264D_MEM_PLACEMENT_HOT,       /* MEM_REC_MVBANK */
+    IH264D_MEM_PLACEMENT_COLD,      /* MEM_REC_BACKUP */
+    IH264D_MEM_PLACEMENT_COLD,      /* MEM_REC_SPS */
+    IH264D_MEM_PLACEMENT_COLD,      /* MEM_REC_PPS */
+    IH264D_MEM_PLACEMENT_COLD,      /* MEM_REC_SLICE_HDR */
+    IH264D_MEM_PLACEMENT_COLD,      /* MEM_REC_THREAD_HANDLE */
+    IH264D_MEM_PLACEMENT_STREAMING, /* MEM_REC_PARSE_MAP */
+    IH264D_MEM_PLACEMENT_STREAMING, /* MEM_REC_PROC_MAP */
+    IH264D_MEM_PLACEMENT_STREAMING, /* MEM_REC_SLICE_NUM_MAP */
+    IH264D_MEM_PLACEMENT_COLD,      /* MEM_REC_DPB_MGR */
+    IH264D_MEM_PLACEMENT_HOT,       /* MEM_REC_NEIGHBOR_INFO */
+    IH264D_MEM_PLACEMENT_HOT,       /* MEM_REC_PRED_INFO */
+    IH264D_MEM_PLACEMENT_STREAMING, /* MEM_REC_PRED_INFO_PKD */
+    IH264D_MEM_PLACEMENT_STREAMING, /* MEM_REC_MB_INFO */
+    IH264D_MEM_PLACEMENT_STREAMING, /* MEM_REC_DEBLK_MB_INFO */
+    IH264D_MEM_PLACEMENT_HOT,       /* MEM_REC_REF_PIC */
+    IH264D_MEM_PLACEMENT_STREAMING, /* MEM_REC_EXTRA_MEM */
+    IH264D_MEM_PLACEMENT_HOT,       /* MEM_REC_INTERNAL_SCRATCH */
+    IH264D_MEM_PLACEMENT_STREAMING, /* MEM_REC_INTERNAL_PERSIST */
+    IH264D_MEM_PLACEMENT_COLD,      /* MEM_REC_PIC_BUF_MGR */
+    IH264D_MEM_PLACEMENT_COLD,      /* MEM_REC_MV_BUF_MGR */
+    IH264D_MEM_PLACEMENT_COLD,      /* MEM_REC_TRACE */
+    IH264D_MEM_PLACEMENT_HOT};      /* MEM_REC_FILM_GRAIN */
+
+/*!
+ **************************************************************************
+ *   \brief   gau1_ih264d_mem_rec_component
+ *
+ *   Component of every memory record, indexed by record, for the memory
+ *   footprint reported by fill mem rec. The co-located zero flags are in
+ *   the MV buffer manager record, so it is counted with the MV bank.
+ **************************************************************************
+ */
+const UWORD8 gau1_ih264d_mem_rec_component[MEM_REC_CNT] = {
+    IH264D_MEM_COMPONENT_OTHER,          /* MEM_REC_IV_OBJ */
+    IH264D_MEM_COMPONENT_OTHER,          /* MEM_REC_CODEC */
+    IH264D_MEM_COMPONENT_BITSTREAM,      /* MEM_REC_BITSBUF */
+    IH264D_MEM_COMPONENT_MB_CONTEXT,     /* MEM_REC_COEFF_DATA */
+    IH264D_MEM_COMPONENT_MV_BANK,        /* MEM_REC_MVBANK */
+    IH264D_MEM_COMPONENT_OTHER,          /* MEM_REC_BACKUP */
+    IH264D_MEM_COMPONENT_OTHER,          /* MEM_REC_SPS */
+    IH264D_MEM_COMPONENT_OTHER,          /* MEM_REC_PPS */
+    IH264D_MEM_COMPONENT_MB_CONTEXT,     /* MEM_REC_SLICE_HDR */
+    IH264D_MEM_COMPONENT_THREAD_SCRATCH, /* MEM_REC_THREAD_HANDLE */
+    IH264D_MEM_COMPONENT_THREAD_SCRATCH, /* MEM_REC_PARSE_MAP */
+    IH264D_MEM_COMPONENT_THREAD_SCRATCH, /* MEM_REC_PROC_MAP */
+    IH264D_MEM_COMPONENT_MB_CONTEXT,     /* MEM_REC_SLICE_NUM_MAP */
+    IH264D_MEM_COMPONENT_DPB,            /* MEM_REC_DPB_MGR */
+    IH264D_MEM_COMPONENT_MB_CONTEXT,     /* MEM_REC_NEIGHBOR_INFO */
+    IH264D_MEM_COMPONENT_MB_CONTEXT,     /* MEM_REC_PRED_INFO */
+    IH264D_MEM_COMPONENT_MB_CONTEXT,     /* MEM_REC_PRED_INFO_PKD */
+    IH264D_MEM_COMPONENT_MB_CONTEXT,     /* MEM_REC_MB_INFO */
+    IH264D_MEM_COMPONENT_MB_CONTEXT,     /* MEM_REC_DEBLK_MB_INFO */
+    IH264D_MEM_COMPONENT_DPB,            /* MEM_REC_REF_PIC */
+    IH264D_MEM_COMPONENT_OTHER,          /* MEM_REC_EXTRA_MEM */
+    IH264D_MEM_COMPONENT_THREAD_SCRATCH, /* MEM_REC_INTERNAL_SCRATCH */
+    IH264D_MEM_COMPONENT_MB_CONTEXT,     /* MEM_REC_INTERNAL_PERSIST */
+    IH264D_MEM_COMPONENT_DPB,            /* MEM_REC_PIC_BUF_MGR */
+    IH264D_MEM_COMPONENT_MV_BANK,        /* MEM_REC_MV_BUF_MGR */
+    IH264D_MEM_COMPONENT_OTHER,          /* MEM_REC_TRACE */
+    IH264D_MEM_COMPONENT_OTHER};         /* MEM_REC_FILM_GRAIN */
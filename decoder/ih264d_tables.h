@@ -77,6 +77,7 @@ extern const UWORD32 gau4_ih264d_packed_bs2[16];
 extern const UWORD16 gau2_ih264d_4x4_v2h_reorder[16];
 extern const UWORD8 gau1_ih264d_subblk_offset[16];
 extern const UWORD8 gau1_ih264d_cbp_table[48][2];
+extern const UWORD8 gau1_ih264d_cbp_table_gray[16][2];
 
 /*Decode Slice Table declaration*/
 extern const UWORD8 gau1_ih264d_inv_scan[16];
@@ -180,4 +181,19 @@ extern const UWORD8 gau1_ih264d_sei_fld_usage[9][3];
 extern const UWORD8 gau1_ih264d_top_left_mb_part_indx_mod[];
 extern const UWORD8 gau1_ih264d_submb_indx_mod_sp_drct[];
 
+/*****************************************************************************/
+/* Memory records allocated on SPS activation in per SPS allocation mode     */
+/*****************************************************************************/
+extern const UWORD8 gau1_ih264d_sps_mem_recs[];
+
+/*****************************************************************************/
+/* Placement hint of each memory record                                      */
+/*****************************************************************************/
+extern const UWORD8 gau1_ih264d_mem_rec_placement[];
+
+/*****************************************************************************/
+/* Component each memory record is reported under                            */
+/*****************************************************************************/
+extern const UWORD8 gau1_ih264d_mem_rec_component[];
+
 #endif /*TABLES_H*/
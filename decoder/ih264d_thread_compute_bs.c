@@ -69,6 +69,8 @@
 #include "ih264d_mb_utils.h"
 
 #include "ih264d_thread_compute_bs.h"
+#include "ih264d_perf_stats.h"
+#include "ih264d_trace.h"
 #include "ithread.h"
 #include "ih264d_deblocking.h"
 #include "ih264d_mb_utils.h"
@@ -222,7 +224,7 @@ void ih264d_compute_bs_non_mbaff_thread(dec_struct_t *ps_dec,
   u2_top_csbp = ps_cur_mb_info->ps_top_mb->u2_luma_csbp;
 
   /* Compute BS function */
-  if (ps_dec->ps_cur_sps->u1_profile_idc == HIGH_PROFILE_IDC) {
+  if (IS_HIGH_PROFILE(ps_dec->ps_cur_sps->u1_profile_idc)) {
     if (ps_cur_mb_info->u1_tran_form8x8 == 1) {
       u2_cur_csbp =
           ih264d_update_csbp_8x8(ps_cur_mb_info->ps_curmb->u2_luma_csbp);
@@ -307,6 +309,40 @@ void ih264d_compute_bs_non_mbaff_thread(dec_struct_t *ps_dec,
   }
 }
 
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264d_skip_deblk_worker_rows                            */
+/*                                                                           */
+/*  Description   : Moves the deblocking position of the compute bs thread   */
+/*                  (worker 0) past the MB rows handled by the other         */
+/*                  deblocking workers                                       */
+/*                                                                           */
+/*  Inputs        : ps_dec      - decoder context                            */
+/*                  ps_tfr_cxt  - transfer context of the compute bs thread  */
+/*                  pu4_mb_num  - MB to be deblocked next, at start of row   */
+/*                  pu4_mb_y    - its MB row                                 */
+/*                  pps_cur_mb  - its deblocking parameters                  */
+/*                                                                           */
+/*****************************************************************************/
+static void ih264d_skip_deblk_worker_rows(dec_struct_t *ps_dec,
+                                          tfr_ctxt_t *ps_tfr_cxt,
+                                          UWORD32 *pu4_mb_num,
+                                          UWORD32 *pu4_mb_y,
+                                          deblk_mb_t **pps_cur_mb) {
+  UWORD32 u4_num_workers = ps_dec->u4_num_deblk_workers;
+  UWORD32 u4_image_wd_mb = ps_dec->u2_frm_wd_in_mbs;
+  UWORD32 u4_max_addr = ps_dec->ps_cur_sps->u2_max_mb_addr;
+
+  while ((*pu4_mb_y % u4_num_workers) && (*pu4_mb_num <= u4_max_addr)) {
+    *pu4_mb_num += u4_image_wd_mb;
+    *pps_cur_mb += u4_image_wd_mb;
+    ps_tfr_cxt->pu1_mb_y += (u4_image_wd_mb << 4) + ps_tfr_cxt->u4_y_inc;
+    ps_tfr_cxt->pu1_mb_u += (u4_image_wd_mb << 4) + ps_tfr_cxt->u4_uv_inc;
+    ps_tfr_cxt->pu1_mb_v += (u4_image_wd_mb << 3) + ps_tfr_cxt->u4_uv_inc;
+    (*pu4_mb_y)++;
+  }
+}
+
 void ih264d_check_mb_map_deblk(dec_struct_t *ps_dec, UWORD32 deblk_mb_grp,
                                tfr_ctxt_t *ps_tfr_cxt) {
   UWORD32 i = 0;
@@ -324,6 +360,8 @@ void ih264d_check_mb_map_deblk(dec_struct_t *ps_dec, UWORD32 deblk_mb_grp,
 
   UWORD32 u4_wd_y, u4_wd_uv;
   UWORD8 u1_field_pic_flag = ps_dec->ps_cur_slice->u1_field_pic_flag;
+  UWORD32 u4_num_workers = ps_dec->u4_num_deblk_workers;
+  UWORD32 u4_max_addr = ps_dec->ps_cur_sps->u2_max_mb_addr;
 
   u4_mb_num = ps_dec->u4_cur_deblk_mb_num;
   u4_mb_x = ps_dec->u4_deblk_mb_x;
@@ -334,6 +372,12 @@ void ih264d_check_mb_map_deblk(dec_struct_t *ps_dec, UWORD32 deblk_mb_grp,
   ps_cur_mb = ps_dec->ps_cur_deblk_thrd_mb;
 
   for (i = 0; i < deblk_mb_grp; i++) {
+    if ((u4_num_workers > 1) && (0 == u4_mb_x)) {
+      ih264d_skip_deblk_worker_rows(ps_dec, ps_tfr_cxt, &u4_mb_num, &u4_mb_y,
+                                    &ps_cur_mb);
+      if (u4_mb_num > u4_max_addr) break;
+    }
+
     // while(1)
     //{
     CHECK_MB_MAP_BYTE(u4_mb_num, mb_map, u4_cur_mb);
@@ -345,12 +389,16 @@ void ih264d_check_mb_map_deblk(dec_struct_t *ps_dec, UWORD32 deblk_mb_grp,
     } else
       u4_right_mb = 1;
 
-    if ((u4_cur_mb && u4_right_mb) == 0) {
+    if ((u4_cur_mb && u4_right_mb &&
+         ih264d_check_deblk_top_row(ps_dec, u4_mb_x, u4_mb_y)) == 0) {
       break;
     } else {
     }
     //}
 
+    /* Only groups with a MB ready are traced, as this is polled */
+    if (0 == i) TRACE_BEGIN(ps_dec, PERF_SLOT_BS, IH264D_TRACE_DEBLK, u4_mb_y);
+
     u4_mb_num++;
     {
       UWORD32 u4_deb_mode, u4_mbs_next;
@@ -370,9 +418,11 @@ void ih264d_check_mb_map_deblk(dec_struct_t *ps_dec, UWORD32 deblk_mb_grp,
         if (u4_deb_mode & MB_DISABLE_LEFT_EDGE) ps_left_mb = NULL;
         if (u4_deb_mode & MB_DISABLE_TOP_EDGE) ps_top_mb = NULL;
 
+        PERF_STAGE_BEGIN(ps_dec, PERF_SLOT_BS, IH264D_PERF_STAGE_DEBLK);
         ih264d_deblock_mb_nonmbaff(ps_dec, ps_tfr_cxt, i4_cb_qp_idx_ofst,
                                    i4_cr_qp_idx_ofst, ps_cur_mb, u4_wd_y,
                                    u4_wd_uv, ps_top_mb, ps_left_mb);
+        PERF_STAGE_END(ps_dec, PERF_SLOT_BS, IH264D_PERF_STAGE_DEBLK);
       }
 
       ps_cur_mb++;
@@ -391,7 +441,18 @@ void ih264d_check_mb_map_deblk(dec_struct_t *ps_dec, UWORD32 deblk_mb_grp,
         u4_mb_x = 0;
       }
     }
+
+    if (u4_num_workers > 1) {
+      DATA_SYNC();
+      ps_dec->as_deblk_worker[0].u4_deblk_num = u4_mb_num;
+    }
+  }
+
+  if (u4_num_workers > 1) {
+    DATA_SYNC();
+    ps_dec->as_deblk_worker[0].u4_deblk_num = u4_mb_num;
   }
+  if (i) TRACE_END(ps_dec, PERF_SLOT_BS, IH264D_TRACE_DEBLK);
 
   ps_dec->u4_cur_deblk_mb_num = u4_mb_num;
   ps_dec->u4_deblk_mb_x = u4_mb_x;
@@ -416,6 +477,8 @@ void ih264d_check_mb_map_deblk_wait(dec_struct_t *ps_dec, UWORD32 deblk_mb_grp,
 
   UWORD32 u4_wd_y, u4_wd_uv;
   UWORD8 u1_field_pic_flag = ps_dec->ps_cur_slice->u1_field_pic_flag;
+  UWORD32 u4_num_workers = ps_dec->u4_num_deblk_workers;
+  UWORD32 u4_max_addr = ps_dec->ps_cur_sps->u2_max_mb_addr;
 
   u4_mb_num = ps_dec->u4_cur_deblk_mb_num;
   u4_mb_x = ps_dec->u4_deblk_mb_x;
@@ -425,7 +488,19 @@ void ih264d_check_mb_map_deblk_wait(dec_struct_t *ps_dec, UWORD32 deblk_mb_grp,
   u4_wd_uv = ps_dec->u2_frm_wd_uv << u1_field_pic_flag;
   ps_cur_mb = ps_dec->ps_cur_deblk_thrd_mb;
 
+  if (deblk_mb_grp)
+    TRACE_BEGIN(ps_dec, PERF_SLOT_BS, IH264D_TRACE_DEBLK, u4_mb_y);
   for (i = 0; i < deblk_mb_grp; i++) {
+    if ((u4_num_workers > 1) && (0 == u4_mb_x)) {
+      ih264d_skip_deblk_worker_rows(ps_dec, ps_tfr_cxt, &u4_mb_num, &u4_mb_y,
+                                    &ps_cur_mb);
+
+      /* Boundary strength of the MBs after the skipped rows is not ready */
+      if ((u4_mb_num > u4_max_addr) ||
+          (ps_dec->u4_cur_bs_mb_num <= u4_mb_num))
+        break;
+    }
+
     while (1) {
       CHECK_MB_MAP_BYTE(u4_mb_num, mb_map, u4_cur_mb);
 
@@ -444,22 +519,30 @@ void ih264d_check_mb_map_deblk_wait(dec_struct_t *ps_dec, UWORD32 deblk_mb_grp,
       if (ps_dec->u2_skip_deblock == 1) {
         break;
       }
-      if ((u4_cur_mb && u4_right_mb) == 0) {
+      if ((u4_cur_mb && u4_right_mb &&
+           ih264d_check_deblk_top_row(ps_dec, u4_mb_x, u4_mb_y)) == 0) {
         if (ps_dec->u4_output_present &&
             ps_dec->u4_fmt_conv_cur_row < ps_dec->s_disp_frame_info.u4_y_ht) {
           ps_dec->u4_fmt_conv_num_rows = MIN(
               ps_dec->u4_fmt_conv_num_rows, (ps_dec->s_disp_frame_info.u4_y_ht -
                                              ps_dec->u4_fmt_conv_cur_row));
+          TRACE_WAIT_END(ps_dec, PERF_SLOT_BS);
+          PERF_STAGE_BEGIN(ps_dec, PERF_SLOT_BS, IH264D_PERF_STAGE_FMT_CONV);
+          TRACE_BEGIN(ps_dec, PERF_SLOT_BS, IH264D_TRACE_FMT_CONV,
+                      ps_dec->u4_fmt_conv_cur_row);
           ih264d_format_convert(ps_dec, &(ps_dec->s_disp_op),
                                 ps_dec->u4_fmt_conv_cur_row,
                                 ps_dec->u4_fmt_conv_num_rows);
+          TRACE_END(ps_dec, PERF_SLOT_BS, IH264D_TRACE_FMT_CONV);
+          PERF_STAGE_END(ps_dec, PERF_SLOT_BS, IH264D_PERF_STAGE_FMT_CONV);
           ps_dec->u4_fmt_conv_cur_row += ps_dec->u4_fmt_conv_num_rows;
         } else
-          NOP(32);
+          PERF_NOP(ps_dec, PERF_SLOT_BS, 32);
       } else {
         break;
       }
     }
+    TRACE_WAIT_END(ps_dec, PERF_SLOT_BS);
 
     u4_mb_num++;
     {
@@ -480,9 +563,11 @@ void ih264d_check_mb_map_deblk_wait(dec_struct_t *ps_dec, UWORD32 deblk_mb_grp,
         if (u4_deb_mode & MB_DISABLE_LEFT_EDGE) ps_left_mb = NULL;
         if (u4_deb_mode & MB_DISABLE_TOP_EDGE) ps_top_mb = NULL;
 
+        PERF_STAGE_BEGIN(ps_dec, PERF_SLOT_BS, IH264D_PERF_STAGE_DEBLK);
         ih264d_deblock_mb_nonmbaff(ps_dec, ps_tfr_cxt, i4_cb_qp_idx_ofst,
                                    i4_cr_qp_idx_ofst, ps_cur_mb, u4_wd_y,
                                    u4_wd_uv, ps_top_mb, ps_left_mb);
+        PERF_STAGE_END(ps_dec, PERF_SLOT_BS, IH264D_PERF_STAGE_DEBLK);
       }
 
       ps_cur_mb++;
@@ -501,7 +586,18 @@ void ih264d_check_mb_map_deblk_wait(dec_struct_t *ps_dec, UWORD32 deblk_mb_grp,
         u4_mb_x = 0;
       }
     }
+
+    if (u4_num_workers > 1) {
+      DATA_SYNC();
+      ps_dec->as_deblk_worker[0].u4_deblk_num = u4_mb_num;
+    }
+  }
+
+  if (u4_num_workers > 1) {
+    DATA_SYNC();
+    ps_dec->as_deblk_worker[0].u4_deblk_num = u4_mb_num;
   }
+  if (deblk_mb_grp) TRACE_END(ps_dec, PERF_SLOT_BS, IH264D_TRACE_DEBLK);
 
   ps_dec->u4_cur_deblk_mb_num = u4_mb_num;
   ps_dec->u4_deblk_mb_x = u4_mb_x;
@@ -571,8 +667,13 @@ void ih264d_computebs_deblk_slice(dec_struct_t *ps_dec,
 
       DEBUG_THREADS_PRINTF("ps_dec->u4_cur_bs_mb_num = %d\n",
                            ps_dec->u4_cur_bs_mb_num);
+      PERF_STAGE_BEGIN(ps_dec, PERF_SLOT_BS, IH264D_PERF_STAGE_BS);
       ih264d_compute_bs_non_mbaff_thread(ps_dec, p_cur_mb,
                                          ps_dec->u4_cur_bs_mb_num);
+      PERF_STAGE_END(ps_dec, PERF_SLOT_BS, IH264D_PERF_STAGE_BS);
+
+      /* Boundary strength is read by the other deblocking workers */
+      if (ps_dec->u4_num_deblk_workers > 1) DATA_SYNC();
       ps_dec->u4_cur_bs_mb_num++;
       ps_dec->u4_bs_cur_slice_num_mbs++;
     }
@@ -611,14 +712,12 @@ void ih264d_computebs_deblk_thread(dec_struct_t *ps_dec) {
   // 0: un-identified state, 1 - bs needed, 2 - bs not needed
   while (1) {
     if (ps_dec->u4_start_bs_deblk == 0) {
-      NOP(128);
-      NOP(128);
-      NOP(128);
-      NOP(128);
+      PERF_NOP(ps_dec, PERF_SLOT_BS, 512);
     } else {
       break;
     }
   }
+  TRACE_WAIT_END(ps_dec, PERF_SLOT_BS);
 
   if (ps_dec->u4_start_bs_deblk == 1) {
     ps_dec->u4_cur_deblk_mb_num = 0;
@@ -639,12 +738,16 @@ void ih264d_computebs_deblk_thread(dec_struct_t *ps_dec) {
       DATA_SYNC();
       /*wait untill all the slice params have been populated*/
       while (ps_dec->ps_computebs_cur_slice->slice_header_done == 0) {
-        NOP(32);
+        PERF_NOP(ps_dec, PERF_SLOT_BS, 32);
         DEBUG_THREADS_PRINTF(" waiting for slice header at compute bs\n");
       }
+      TRACE_WAIT_END(ps_dec, PERF_SLOT_BS);
 
       DEBUG_THREADS_PRINTF(" Entering compute bs slice\n");
+      TRACE_BEGIN(ps_dec, PERF_SLOT_BS, IH264D_TRACE_SLICE,
+                  ps_dec->u2_cur_slice_num_bs);
       ih264d_computebs_deblk_slice(ps_dec, ps_tfr_cxt);
+      TRACE_END(ps_dec, PERF_SLOT_BS, IH264D_TRACE_SLICE);
 
       DEBUG_THREADS_PRINTF(" Exit  compute bs slice \n");
 
@@ -666,8 +769,9 @@ void ih264d_computebs_deblk_thread(dec_struct_t *ps_dec) {
         DEBUG_THREADS_PRINTF(
             "Waiting at compute bs for next slice  or end of frame\n");
 
-        NOP(32);
+        PERF_NOP(ps_dec, PERF_SLOT_BS, 32);
       }
+      TRACE_WAIT_END(ps_dec, PERF_SLOT_BS);
 
       DEBUG_THREADS_PRINTF("CBS thread:Got next slice/end of frame signal \n ");
 
@@ -685,8 +789,12 @@ void ih264d_computebs_deblk_thread(dec_struct_t *ps_dec) {
     {
       UWORD32 u4_num_mbs;
 
-      u4_num_mbs =
-          ps_dec->ps_cur_sps->u2_max_mb_addr - ps_dec->u4_cur_deblk_mb_num + 1;
+      /* Rows of the other workers can take the position past the end */
+      if (ps_dec->u4_cur_deblk_mb_num <= ps_dec->ps_cur_sps->u2_max_mb_addr)
+        u4_num_mbs = ps_dec->ps_cur_sps->u2_max_mb_addr -
+                     ps_dec->u4_cur_deblk_mb_num + 1;
+      else
+        u4_num_mbs = 0;
 
       DEBUG_PERF_PRINTF("mbs left for deblocking= %d \n", u4_num_mbs);
 
@@ -696,6 +804,148 @@ void ih264d_computebs_deblk_thread(dec_struct_t *ps_dec) {
     }
   }
 
-  ps_dec->u4_start_bs_deblk = 0;
   ithread_exit(0);
 }
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264d_deblk_worker_rows                                 */
+/*                                                                           */
+/*  Description   : Deblocks the MB rows handled by a deblocking worker      */
+/*                  other than the compute bs thread, lagging behind the     */
+/*                  reconstruction, the boundary strength computation and    */
+/*                  the row above                                            */
+/*                                                                           */
+/*  Inputs        : ps_worker - worker context                               */
+/*                                                                           */
+/*****************************************************************************/
+static void ih264d_deblk_worker_rows(deblk_worker_ctxt_t *ps_worker) {
+  dec_struct_t *ps_dec = (dec_struct_t *) ps_worker->pv_dec;
+  tfr_ctxt_t s_tfr_ctxt;
+  tfr_ctxt_t *ps_tfr_cxt = &s_tfr_ctxt;
+  pad_mgr_t s_pad_mgr;
+  volatile UWORD8 *mb_map = ps_dec->pu1_recon_mb_map;
+  volatile UWORD32 *pu4_cur_bs_mb_num = &ps_dec->u4_cur_bs_mb_num;
+  volatile UWORD16 *pu2_mb_skip_error = &ps_dec->u2_mb_skip_error;
+  UWORD32 u4_image_wd_mb = ps_dec->u2_frm_wd_in_mbs;
+  UWORD32 u4_num_rows = ps_dec->u2_frm_ht_in_mbs;
+  UWORD32 u4_num_workers = ps_dec->u4_num_deblk_workers;
+  UWORD8 u1_field_pic_flag = ps_dec->ps_cur_slice->u1_field_pic_flag;
+  UWORD32 u4_wd_y = ps_dec->u2_frm_wd_y << u1_field_pic_flag;
+  UWORD32 u4_wd_uv = ps_dec->u2_frm_wd_uv << u1_field_pic_flag;
+  const WORD32 i4_cb_qp_idx_ofst =
+      ps_dec->ps_cur_pps->i1_chroma_qp_index_offset;
+  const WORD32 i4_cr_qp_idx_ofst =
+      ps_dec->ps_cur_pps->i1_second_chroma_qp_index_offset;
+  const UWORD32 u4_perf_slot =
+      PERF_DEBLK_SLOT(ps_worker->u4_id, PERF_SLOT_BS);
+  UWORD32 u4_mb_x, u4_mb_y;
+
+  /* Padding of the picture is set up by the compute bs thread */
+  ih264d_init_deblk_tfr_ctxt(ps_dec, &s_pad_mgr, ps_tfr_cxt, u4_image_wd_mb,
+                             0);
+
+  for (u4_mb_y = ps_worker->u4_id; u4_mb_y < u4_num_rows;
+       u4_mb_y += u4_num_workers) {
+    UWORD32 u4_mb_num = u4_mb_y * u4_image_wd_mb;
+    deblk_mb_t *ps_cur_mb = ps_dec->ps_deblk_pic + u4_mb_num;
+
+    ps_tfr_cxt->pu1_mb_y =
+        ps_tfr_cxt->pu1_src_y + 4 +
+        u4_mb_y * ((u4_image_wd_mb << 4) + ps_tfr_cxt->u4_y_inc);
+    ps_tfr_cxt->pu1_mb_u =
+        ps_tfr_cxt->pu1_src_u + 4 +
+        u4_mb_y * ((u4_image_wd_mb << 4) + ps_tfr_cxt->u4_uv_inc);
+    ps_tfr_cxt->pu1_mb_v =
+        ps_tfr_cxt->pu1_src_v + 4 +
+        u4_mb_y * ((u4_image_wd_mb << 3) + ps_tfr_cxt->u4_uv_inc);
+
+    TRACE_BEGIN(ps_dec, u4_perf_slot, IH264D_TRACE_DEBLK, u4_mb_y);
+    for (u4_mb_x = 0; u4_mb_x < u4_image_wd_mb; u4_mb_x++, u4_mb_num++) {
+      UWORD32 u4_deb_mode;
+      deblk_mb_t *ps_top_mb;
+      deblk_mb_t *ps_left_mb;
+
+      while (1) {
+        UWORD32 u4_cur_mb, u4_right_mb;
+
+        if (ps_dec->u2_skip_deblock || *pu2_mb_skip_error) {
+          TRACE_WAIT_END(ps_dec, u4_perf_slot);
+          TRACE_END(ps_dec, u4_perf_slot, IH264D_TRACE_DEBLK);
+          return;
+        }
+
+        CHECK_MB_MAP_BYTE(u4_mb_num, mb_map, u4_cur_mb);
+
+        if (*pu4_cur_bs_mb_num <= u4_mb_num) u4_cur_mb = 0;
+
+        if (u4_mb_x < (u4_image_wd_mb - 1)) {
+          CHECK_MB_MAP_BYTE((u4_mb_num + 1), mb_map, u4_right_mb);
+        } else
+          u4_right_mb = 1;
+
+        if (u4_cur_mb && u4_right_mb &&
+            ih264d_check_deblk_top_row(ps_dec, u4_mb_x, u4_mb_y))
+          break;
+
+        PERF_NOP(ps_dec, u4_perf_slot, 32);
+      }
+      TRACE_WAIT_END(ps_dec, u4_perf_slot);
+
+      u4_deb_mode = ps_cur_mb->u1_deblocking_mode;
+      if (!(u4_deb_mode & MB_DISABLE_FILTERING)) {
+        if (u4_mb_x) {
+          ps_left_mb = ps_cur_mb - 1;
+        } else {
+          ps_left_mb = NULL;
+        }
+        if (u4_mb_y != 0) {
+          ps_top_mb = ps_cur_mb - (u4_image_wd_mb);
+        } else {
+          ps_top_mb = NULL;
+        }
+
+        if (u4_deb_mode & MB_DISABLE_LEFT_EDGE) ps_left_mb = NULL;
+        if (u4_deb_mode & MB_DISABLE_TOP_EDGE) ps_top_mb = NULL;
+
+        PERF_STAGE_BEGIN(ps_dec, u4_perf_slot, IH264D_PERF_STAGE_DEBLK);
+        ih264d_deblock_mb_nonmbaff(ps_dec, ps_tfr_cxt, i4_cb_qp_idx_ofst,
+                                   i4_cr_qp_idx_ofst, ps_cur_mb, u4_wd_y,
+                                   u4_wd_uv, ps_top_mb, ps_left_mb);
+        PERF_STAGE_END(ps_dec, u4_perf_slot, IH264D_PERF_STAGE_DEBLK);
+      }
+
+      ps_cur_mb++;
+
+      ps_tfr_cxt->pu1_mb_y += 16;
+      ps_tfr_cxt->pu1_mb_u += 8 * YUV420SP_FACTOR;
+      ps_tfr_cxt->pu1_mb_v += 8;
+
+      DATA_SYNC();
+      ps_worker->u4_deblk_num = u4_mb_num + 1;
+    }
+    TRACE_END(ps_dec, u4_perf_slot, IH264D_TRACE_DEBLK);
+  }
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264d_deblk_worker_job                                  */
+/*                                                                           */
+/*  Description   : Deblocking of a picture run by a parked worker thread    */
+/*                  along with the compute bs thread                         */
+/*                                                                           */
+/*  Inputs        : ps_worker - worker context                               */
+/*                                                                           */
+/*****************************************************************************/
+void ih264d_deblk_worker_job(deblk_worker_ctxt_t *ps_worker) {
+  dec_struct_t *ps_dec = (dec_struct_t *) ps_worker->pv_dec;
+
+  /* 0: un-identified state, 1 - deblock, 2 - picture not decoded */
+  while (ps_dec->u4_start_bs_deblk == 0) {
+    PERF_NOP(ps_dec, PERF_DEBLK_SLOT(ps_worker->u4_id, PERF_SLOT_BS), 128);
+  }
+  TRACE_WAIT_END(ps_dec, PERF_DEBLK_SLOT(ps_worker->u4_id, PERF_SLOT_BS));
+
+  if (ps_dec->u4_start_bs_deblk == 1) ih264d_deblk_worker_rows(ps_worker);
+}
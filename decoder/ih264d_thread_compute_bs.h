@@ -56,4 +56,6 @@ void ih264d_compute_bs_non_mbaff_thread(dec_struct_t *ps_dec,
                                         UWORD32 u4_mb_num);
 
 void ih264d_computebs_deblk_thread(dec_struct_t *ps_dec);
+
+void ih264d_deblk_worker_job(deblk_worker_ctxt_t *ps_worker);
 #endif /* _IH264D_THREAD_COMPUTE_BS_H_ */
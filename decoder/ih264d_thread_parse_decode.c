@@ -75,6 +75,8 @@
 #include "ih264d_process_intra_mb.h"
 #include "ih264d_deblocking.h"
 #include "ih264d_format_conv.h"
+#include "ih264d_perf_stats.h"
+#include "ih264d_trace.h"
 
 void ih264d_deblock_mb_level(dec_struct_t *ps_dec,
                              dec_mb_info_t *ps_cur_mb_info, UWORD32 nmb_index);
@@ -205,8 +207,10 @@ void ih264d_decode_tfr_nmb(dec_struct_t *ps_dec, UWORD8 u1_num_mbs,
   if (u1_end_of_row) {
     ps_dec->i2_dec_thread_mb_y += (1 << u1_mbaff);
   }
+  TRACE_BEGIN(ps_dec, PERF_SLOT_DEC, IH264D_TRACE_MB_GROUP, u1_num_mbs);
   ih264d_transfer_mb_group_data(ps_dec, u1_num_mbs, u1_end_of_row,
                                 u1_end_of_row_next);
+  TRACE_END(ps_dec, PERF_SLOT_DEC, IH264D_TRACE_MB_GROUP);
 
   if (u1_end_of_row) {
     /* Reset the N-Mb Recon Buf Index to default Values */
@@ -253,6 +257,7 @@ WORD32 ih264d_decode_recon_tfr_nmb_thread(
     DATA_SYNC();
 
     u4_max_addr = ps_dec->ps_cur_sps->u2_max_mb_addr;
+    PERF_STAGE_BEGIN(ps_dec, PERF_SLOT_DEC, IH264D_PERF_STAGE_WAIT);
     while (1) {
       UWORD32 u4_mb_num = u2_cur_dec_mb_num;
 
@@ -263,7 +268,11 @@ WORD32 ih264d_decode_recon_tfr_nmb_thread(
       if (u4_cond) {
         break;
       } else {
-        { NOP(128); }
+        {
+          TRACE_SPIN(ps_dec, PERF_SLOT_DEC);
+          NOP(128);
+          PERF_SPIN(ps_dec, PERF_SLOT_DEC);
+        }
 
         DEBUG_THREADS_PRINTF(
             "waiting for mb mapcur_dec_mb_num = %d,ps_dec->u2_cur_mb_addr  = "
@@ -271,6 +280,8 @@ WORD32 ih264d_decode_recon_tfr_nmb_thread(
             u2_cur_dec_mb_num, ps_dec->u2_cur_mb_addr);
       }
     }
+    PERF_STAGE_END(ps_dec, PERF_SLOT_DEC, IH264D_PERF_STAGE_WAIT);
+    TRACE_WAIT_END(ps_dec, PERF_SLOT_DEC);
 
     GET_SLICE_NUM_MAP(ps_dec->pu2_slice_num_map, u2_cur_dec_mb_num,
                       u2_slice_num);
@@ -286,6 +297,30 @@ WORD32 ih264d_decode_recon_tfr_nmb_thread(
     ps_dec->u4_dma_buf_idx = 0;
     ps_dec->u4_pred_info_idx = 0;
 
+    PERF_STAGE_BEGIN(ps_dec, PERF_SLOT_DEC, IH264D_PERF_STAGE_MC);
+
+    /* Prefetch the reference of an MB later in the group, only if the */
+    /* parse thread is already done with it                            */
+    if (ps_dec->u4_mc_prefetch_dist &&
+        ((i + ps_dec->u4_mc_prefetch_dist) < u1_num_mbs)) {
+      UWORD32 u4_pf_mb_num = u2_cur_dec_mb_num + ps_dec->u4_mc_prefetch_dist;
+
+      if (u4_pf_mb_num < u4_max_addr) {
+        CHECK_MB_MAP_BYTE(u4_pf_mb_num + 1, ps_dec->pu1_dec_mb_map, u4_cond);
+        GET_SLICE_NUM_MAP(ps_dec->pu2_slice_num_map, u4_pf_mb_num,
+                          u2_slice_num);
+
+        if (u4_cond && (u2_slice_num == ps_dec->u2_cur_slice_num_dec_thread)) {
+          dec_mb_info_t *ps_pf_mb_info =
+              &ps_dec->ps_frm_mb_info[u4_pf_mb_num & PD_MB_BUF_SIZE_MOD];
+
+          if ((ps_pf_mb_info->u1_mb_type <= u1_skip_th) ||
+              (ps_pf_mb_info->u1_mb_type == MB_SKIP))
+            ih264d_prefetch_mb_ref(ps_dec, ps_pf_mb_info);
+        }
+      }
+    }
+
     if (ps_cur_mb_info->u1_mb_type <= u1_skip_th) {
       {
         WORD32 pred_cnt = 0;
@@ -328,6 +363,7 @@ WORD32 ih264d_decode_recon_tfr_nmb_thread(
       /* Decode MB skip */
       ps_dec->p_mc_dec_thread(ps_dec, ps_cur_mb_info);
     }
+    PERF_STAGE_END(ps_dec, PERF_SLOT_DEC, IH264D_PERF_STAGE_MC);
 
     u2_cur_dec_mb_num++;
   }
@@ -339,6 +375,9 @@ WORD32 ih264d_decode_recon_tfr_nmb_thread(
     ps_cur_mb_info =
         &ps_dec->ps_frm_mb_info[ps_dec->cur_dec_mb_num & PD_MB_BUF_SIZE_MOD];
 
+    PERF_COUNT_MB(ps_dec, PERF_SLOT_DEC, ps_cur_mb_info, u1_skip_th,
+                  u1_ipcm_th, u1_B);
+    PERF_STAGE_BEGIN(ps_dec, PERF_SLOT_DEC, IH264D_PERF_STAGE_RECON);
     if (ps_cur_mb_info->u1_mb_type <= u1_skip_th) {
       ih264d_process_inter_mb(ps_dec, ps_cur_mb_info, j);
     } else if (ps_cur_mb_info->u1_mb_type != MB_SKIP) {
@@ -348,9 +387,12 @@ WORD32 ih264d_decode_recon_tfr_nmb_thread(
         if (ret != OK) return ret;
       }
     }
+    PERF_STAGE_END(ps_dec, PERF_SLOT_DEC, IH264D_PERF_STAGE_RECON);
 
     if (ps_dec->u4_mb_level_deblk == 1) {
+      PERF_STAGE_BEGIN(ps_dec, PERF_SLOT_DEC, IH264D_PERF_STAGE_DEBLK);
       ih264d_deblock_mb_level(ps_dec, ps_cur_mb_info, j);
+      PERF_STAGE_END(ps_dec, PERF_SLOT_DEC, IH264D_PERF_STAGE_DEBLK);
     }
 
     if ((ps_dec->u4_num_cores >= 3) && (u1_mbaff == 0))
@@ -528,9 +570,10 @@ void ih264d_decode_picture_thread(dec_struct_t *ps_dec) {
     if (ps_dec->u4_start_frame_decode) {
       break;
     } else {
-      NOP(32);
+      PERF_NOP(ps_dec, PERF_SLOT_DEC, 32);
     }
   }
+  TRACE_WAIT_END(ps_dec, PERF_SLOT_DEC);
 
   DEBUG_THREADS_PRINTF("Got start of frame u4_flag\n");
 
@@ -540,13 +583,17 @@ void ih264d_decode_picture_thread(dec_struct_t *ps_dec) {
       DATA_SYNC();
       /*wait untill all the slice params have been populated*/
       while (ps_dec->ps_decode_cur_slice->slice_header_done == 0) {
-        NOP(32);
+        PERF_NOP(ps_dec, PERF_SLOT_DEC, 32);
         DEBUG_THREADS_PRINTF(" waiting for slice header \n");
       }
+      TRACE_WAIT_END(ps_dec, PERF_SLOT_DEC);
 
       DEBUG_THREADS_PRINTF(" Entering decode slice\n");
 
+      TRACE_BEGIN(ps_dec, PERF_SLOT_DEC, IH264D_TRACE_SLICE,
+                  ps_dec->u2_cur_slice_num_dec_thread);
       ih264d_decode_slice_thread(ps_dec);
+      TRACE_END(ps_dec, PERF_SLOT_DEC, IH264D_TRACE_SLICE);
       DEBUG_THREADS_PRINTF(" Exit  ih264d_decode_slice_thread \n");
 
       /*Complete all writes before processing next slice*/
@@ -566,7 +613,7 @@ void ih264d_decode_picture_thread(dec_struct_t *ps_dec) {
 
         DEBUG_THREADS_PRINTF("Waiting for next slice or end of frame\n");
 
-        NOP(32);
+        PERF_NOP(ps_dec, PERF_SLOT_DEC, 32);
         if (i4_err_status != 0) {
           /*In the case of error set decode Mb number ,so that the
            parse thread does not wait because of mb difference being
@@ -574,6 +621,7 @@ void ih264d_decode_picture_thread(dec_struct_t *ps_dec) {
           ps_dec->cur_dec_mb_num = ps_dec->u2_cur_mb_addr - 1;
         }
       }
+      TRACE_WAIT_END(ps_dec, PERF_SLOT_DEC);
 
       DEBUG_THREADS_PRINTF("Got next slice/end of frame signal \n ");
 
@@ -595,17 +643,24 @@ void ih264d_decode_picture_thread(dec_struct_t *ps_dec) {
       DEBUG_THREADS_PRINTF(" Format conversion loop in decode *u4_flag = %d\n",
                            *u4_flag);
       if (2 == *u4_flag) {
-        if (ps_dec->as_fmt_conv_part[1].u4_num_rows_y)
+        if (ps_dec->as_fmt_conv_part[1].u4_num_rows_y) {
+          PERF_STAGE_BEGIN(ps_dec, PERF_SLOT_DEC, IH264D_PERF_STAGE_FMT_CONV);
+          TRACE_BEGIN(ps_dec, PERF_SLOT_DEC, IH264D_TRACE_FMT_CONV,
+                      ps_dec->as_fmt_conv_part[1].u4_start_y);
           ih264d_format_convert(ps_dec, &(ps_dec->s_disp_op),
                                 ps_dec->as_fmt_conv_part[1].u4_start_y,
                                 ps_dec->as_fmt_conv_part[1].u4_num_rows_y);
+          TRACE_END(ps_dec, PERF_SLOT_DEC, IH264D_TRACE_FMT_CONV);
+          PERF_STAGE_END(ps_dec, PERF_SLOT_DEC, IH264D_PERF_STAGE_FMT_CONV);
+        }
 
         break;
       } else if (1 == *u4_flag) {
-        NOP(32);
+        PERF_NOP(ps_dec, PERF_SLOT_DEC, 32);
       } else
         break;
     }
+    TRACE_WAIT_END(ps_dec, PERF_SLOT_DEC);
   }
 
   ithread_exit(0);
@@ -619,7 +674,11 @@ void ih264d_signal_decode_thread(dec_struct_t *ps_dec) {
       /*to indicate frame in error*/
       ps_dec->u4_start_frame_decode = 2;
 
+    PERF_STAGE_BEGIN(ps_dec, PERF_SLOT_MAIN, IH264D_PERF_STAGE_WAIT);
+    TRACE_BEGIN(ps_dec, PERF_SLOT_MAIN, IH264D_TRACE_WAIT, 0);
     ithread_join(ps_dec->pv_dec_thread_handle, NULL);
+    TRACE_END(ps_dec, PERF_SLOT_MAIN, IH264D_TRACE_WAIT);
+    PERF_STAGE_END(ps_dec, PERF_SLOT_MAIN, IH264D_PERF_STAGE_WAIT);
     ps_dec->u4_dec_thread_created = 0;
   }
 }
@@ -628,7 +687,15 @@ void ih264d_signal_bs_deblk_thread(dec_struct_t *ps_dec) {
     /*signal error*/
     if (ps_dec->u4_start_bs_deblk == 0) ps_dec->u4_start_bs_deblk = 2;
 
+    PERF_STAGE_BEGIN(ps_dec, PERF_SLOT_MAIN, IH264D_PERF_STAGE_WAIT);
+    TRACE_BEGIN(ps_dec, PERF_SLOT_MAIN, IH264D_TRACE_WAIT, 0);
     ithread_join(ps_dec->pv_bs_deblk_thread_handle, NULL);
     ps_dec->u4_bs_deblk_thread_created = 0;
+    ih264d_wait_deblk_workers(ps_dec);
+    TRACE_END(ps_dec, PERF_SLOT_MAIN, IH264D_TRACE_WAIT);
+    PERF_STAGE_END(ps_dec, PERF_SLOT_MAIN, IH264D_PERF_STAGE_WAIT);
+
+    /* Reset only after all the deblocking workers have seen the signal */
+    ps_dec->u4_start_bs_deblk = 0;
   }
 }
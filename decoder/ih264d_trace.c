@@ -0,0 +1,217 @@
+/* Copyright (c) [2020]-[2023] Ittiam Systems Pvt. Ltd.
+   All rights reserved.
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted (subject to the limitations in the
+   disclaimer below) provided that the following conditions are met:
+   •    Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+   •    Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+   •    None of the names of Ittiam Systems Pvt. Ltd., its affiliates,
+   investors, business partners, nor the names of its contributors may be
+   used to endorse or promote products derived from this software without
+   specific prior written permission.
+
+   NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED
+   BY THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+   BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+   FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+   HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+   OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+   WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+   OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+   EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+   This Software is an implementation of the AVC/H.264
+   standard by Ittiam Systems Pvt. Ltd. (“Ittiam”).
+   Additional patent licenses may be required for this Software,
+   including, but not limited to, a license from MPEG LA’s AVC/H.264
+   licensing program (see https://www.mpegla.com/programs/avc-h-264/).
+
+   NOTWITHSTANDING ANYTHING TO THE CONTRARY, THIS DOES NOT GRANT ANY
+   EXPRESS OR IMPLIED LICENSES TO ANY PATENT CLAIMS OF ANY AFFILIATE
+   (TO THE EXTENT NOT IN THE LEGAL ENTITY), INVESTOR, OR OTHER
+   BUSINESS PARTNER OF ITTIAM. You may only use this software or
+   modifications thereto for purposes that are authorized by
+   appropriate patent licenses. You should seek legal advice based
+   upon your implementation details.
+
+---------------------------------------------------------------
+*/
+/*****************************************************************************/
+/*                                                                           */
+/*  File Name         : ih264d_trace.c                                       */
+/*                                                                           */
+/*  Description       : Contains the functions recording and reading the     */
+/*                      trace events. Every logical thread writes the ring   */
+/*                      of its profiling slot without any lock, the rings    */
+/*                      are read between API calls when no thread is running */
+/*                                                                           */
+/*  List of Functions : ih264d_trace_reset()                                 */
+/*                      ih264d_trace_event()                                 */
+/*                      ih264d_trace_spin()                                  */
+/*                      ih264d_trace_wait_end()                              */
+/*                      ih264d_trace_get_events()                            */
+/*                                                                           */
+/*  Issues / Problems : None                                                 */
+/*                                                                           */
+/*****************************************************************************/
+/*****************************************************************************/
+/* File Includes                                                             */
+/*****************************************************************************/
+
+/* System include files */
+#include <string.h>
+
+/* User include files */
+#include "ih264_typedefs.h"
+#include "ih264_macros.h"
+#include "ih264_platform_macros.h"
+#include "ih264d_defs.h"
+#include "ih264d_structs.h"
+#include "ih264d_perf_stats.h"
+#include "ih264d_trace.h"
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264d_trace_reset                                       */
+/*                                                                           */
+/*  Description   : Empties the rings and points them to the trace memory    */
+/*                  record, which holds no rings without TRACE_ENABLE        */
+/*                                                                           */
+/*  Inputs        : ps_dec  - decoder context                                */
+/*                  pu1_buf - base of the trace memory record                */
+/*                                                                           */
+/*****************************************************************************/
+void ih264d_trace_reset(dec_struct_t *ps_dec, UWORD8 *pu1_buf) {
+  UWORD32 i;
+
+  memset(ps_dec->as_trace_ring, 0, sizeof(ps_dec->as_trace_ring));
+
+  for (i = 0; i < PERF_NUM_SLOTS; i++) {
+#ifdef TRACE_ENABLE
+    ps_dec->as_trace_ring[i].ps_events =
+        (ih264d_trace_event_t *) pu1_buf + i * TRACE_EVENTS_PER_SLOT;
+#else
+    ps_dec->as_trace_ring[i].ps_events = NULL;
+    UNUSED(pu1_buf);
+#endif
+  }
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264d_trace_event                                       */
+/*                                                                           */
+/*  Description   : Records the start or the end of a span, overwriting the  */
+/*                  oldest event of the ring when it is full                 */
+/*                                                                           */
+/*  Inputs        : ps_dec   - decoder context                               */
+/*                  u4_slot  - profiling slot of the calling thread          */
+/*                  u4_event - span, of type IH264D_TRACE_EVENT_T            */
+/*                  u4_begin - 1 at the start of the span, 0 at its end      */
+/*                  u4_arg   - argument of the span                          */
+/*                                                                           */
+/*****************************************************************************/
+void ih264d_trace_event(dec_struct_t *ps_dec, UWORD32 u4_slot,
+                        UWORD32 u4_event, UWORD32 u4_begin, UWORD32 u4_arg) {
+  trace_ring_t *ps_ring = &ps_dec->as_trace_ring[u4_slot];
+  ih264d_trace_event_t *ps_event =
+      &ps_ring->ps_events[ps_ring->u4_num_written &
+                          (TRACE_EVENTS_PER_SLOT - 1)];
+
+  ps_event->u8_ts = ih264d_perf_timer();
+  ps_event->u4_arg = u4_arg;
+  ps_event->u1_event = (UWORD8) u4_event;
+  ps_event->u1_begin = (UWORD8) u4_begin;
+  ps_event->u1_thread = (UWORD8) u4_slot;
+  ps_event->u1_rsvd = 0;
+  ps_ring->u4_num_written++;
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264d_trace_spin                                        */
+/*                                                                           */
+/*  Description   : Opens a wait span at a spin-wait loop iteration, unless  */
+/*                  an earlier iteration of the same wait already did        */
+/*                                                                           */
+/*  Inputs        : ps_dec  - decoder context                                */
+/*                  u4_slot - profiling slot of the calling thread           */
+/*                                                                           */
+/*****************************************************************************/
+void ih264d_trace_spin(dec_struct_t *ps_dec, UWORD32 u4_slot) {
+  trace_ring_t *ps_ring = &ps_dec->as_trace_ring[u4_slot];
+
+  if (0 == ps_ring->u4_wait_open) {
+    ih264d_trace_event(ps_dec, u4_slot, IH264D_TRACE_WAIT, 1, 0);
+    ps_ring->u4_wait_open = 1;
+  }
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264d_trace_wait_end                                    */
+/*                                                                           */
+/*  Description   : Closes the wait span of a spin-wait loop, if it spun     */
+/*                                                                           */
+/*  Inputs        : ps_dec  - decoder context                                */
+/*                  u4_slot - profiling slot of the calling thread           */
+/*                                                                           */
+/*****************************************************************************/
+void ih264d_trace_wait_end(dec_struct_t *ps_dec, UWORD32 u4_slot) {
+  trace_ring_t *ps_ring = &ps_dec->as_trace_ring[u4_slot];
+
+  if (ps_ring->u4_wait_open) {
+    ih264d_trace_event(ps_dec, u4_slot, IH264D_TRACE_WAIT, 0, 0);
+    ps_ring->u4_wait_open = 0;
+  }
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264d_trace_get_events                                  */
+/*                                                                           */
+/*  Description   : Moves the events recorded since the last call to the     */
+/*                  buffer of the application, slot by slot. Events that     */
+/*                  were overwritten are counted as dropped, the ones that   */
+/*                  do not fit are left for the next call                    */
+/*                                                                           */
+/*  Inputs        : ps_dec - decoder context                                 */
+/*                  ps_ip  - input structure of the control call             */
+/*                  ps_op  - output structure of the control call            */
+/*                                                                           */
+/*****************************************************************************/
+void ih264d_trace_get_events(dec_struct_t *ps_dec,
+                             ih264d_ctl_get_trace_events_ip_t *ps_ip,
+                             ih264d_ctl_get_trace_events_op_t *ps_op) {
+  UWORD32 u4_num_events = 0;
+  UWORD32 u4_num_dropped = 0;
+  UWORD32 i;
+
+  for (i = 0; i < PERF_NUM_SLOTS; i++) {
+    trace_ring_t *ps_ring = &ps_dec->as_trace_ring[i];
+    UWORD32 u4_num_avail = ps_ring->u4_num_written - ps_ring->u4_num_read;
+
+    if (u4_num_avail > TRACE_EVENTS_PER_SLOT) {
+      u4_num_dropped += u4_num_avail - TRACE_EVENTS_PER_SLOT;
+      ps_ring->u4_num_read = ps_ring->u4_num_written - TRACE_EVENTS_PER_SLOT;
+      u4_num_avail = TRACE_EVENTS_PER_SLOT;
+    }
+
+    while (u4_num_avail && (u4_num_events < ps_ip->u4_max_events)) {
+      ps_ip->ps_events[u4_num_events++] =
+          ps_ring->ps_events[ps_ring->u4_num_read++ &
+                             (TRACE_EVENTS_PER_SLOT - 1)];
+      u4_num_avail--;
+    }
+  }
+
+  ps_op->u8_ticks_per_sec = ih264d_perf_ticks_per_sec(ps_dec);
+  ps_op->u4_num_events = u4_num_events;
+  ps_op->u4_num_dropped = u4_num_dropped;
+}
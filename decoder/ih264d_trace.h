@@ -0,0 +1,105 @@
+/* Copyright (c) [2020]-[2023] Ittiam Systems Pvt. Ltd.
+   All rights reserved.
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted (subject to the limitations in the
+   disclaimer below) provided that the following conditions are met:
+   •    Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+   •    Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+   •    None of the names of Ittiam Systems Pvt. Ltd., its affiliates,
+   investors, business partners, nor the names of its contributors may be
+   used to endorse or promote products derived from this software without
+   specific prior written permission.
+
+   NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED
+   BY THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+   BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+   FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+   HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+   OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+   WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+   OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+   EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+   This Software is an implementation of the AVC/H.264
+   standard by Ittiam Systems Pvt. Ltd. (“Ittiam”).
+   Additional patent licenses may be required for this Software,
+   including, but not limited to, a license from MPEG LA’s AVC/H.264
+   licensing program (see https://www.mpegla.com/programs/avc-h-264/).
+
+   NOTWITHSTANDING ANYTHING TO THE CONTRARY, THIS DOES NOT GRANT ANY
+   EXPRESS OR IMPLIED LICENSES TO ANY PATENT CLAIMS OF ANY AFFILIATE
+   (TO THE EXTENT NOT IN THE LEGAL ENTITY), INVESTOR, OR OTHER
+   BUSINESS PARTNER OF ITTIAM. You may only use this software or
+   modifications thereto for purposes that are authorized by
+   appropriate patent licenses. You should seek legal advice based
+   upon your implementation details.
+
+---------------------------------------------------------------
+*/
+/*****************************************************************************/
+/*                                                                           */
+/*  File Name         : ih264d_trace.h                                       */
+/*                                                                           */
+/*  Description       : Macros and functions recording the trace events read */
+/*                      through IH264D_CMD_CTL_GET_TRACE_EVENTS. The macros  */
+/*                      compile to nothing unless the library is built with  */
+/*                      TRACE_ENABLE                                         */
+/*                                                                           */
+/*  List of Functions : ih264d_trace_reset()                                 */
+/*                      ih264d_trace_event()                                 */
+/*                      ih264d_trace_spin()                                  */
+/*                      ih264d_trace_wait_end()                              */
+/*                      ih264d_trace_get_events()                            */
+/*                                                                           */
+/*  Issues / Problems : None                                                 */
+/*                                                                           */
+/*****************************************************************************/
+
+#ifndef _IH264D_TRACE_H_
+#define _IH264D_TRACE_H_
+
+#ifdef TRACE_ENABLE
+
+#define TRACE_BEGIN(ps_dec, u4_slot, e_event, u4_arg) \
+  ih264d_trace_event(ps_dec, u4_slot, e_event, 1, u4_arg)
+
+#define TRACE_END(ps_dec, u4_slot, e_event) \
+  ih264d_trace_event(ps_dec, u4_slot, e_event, 0, 0)
+
+/* A wait span is opened by the first iteration of a spin-wait loop that */
+/* actually spins, and has to be closed with TRACE_WAIT_END after the    */
+/* loop, so that checks that do not wait record nothing                  */
+#define TRACE_SPIN(ps_dec, u4_slot) ih264d_trace_spin(ps_dec, u4_slot)
+
+#define TRACE_WAIT_END(ps_dec, u4_slot) ih264d_trace_wait_end(ps_dec, u4_slot)
+
+#else
+
+/* The slot is consumed as with the disabled profiling counters */
+#define TRACE_BEGIN(ps_dec, u4_slot, e_event, u4_arg) ((void) (u4_slot))
+#define TRACE_END(ps_dec, u4_slot, e_event) ((void) (u4_slot))
+#define TRACE_SPIN(ps_dec, u4_slot) ((void) (u4_slot))
+#define TRACE_WAIT_END(ps_dec, u4_slot) ((void) (u4_slot))
+
+#endif
+
+void ih264d_trace_reset(dec_struct_t *ps_dec, UWORD8 *pu1_buf);
+
+void ih264d_trace_event(dec_struct_t *ps_dec, UWORD32 u4_slot,
+                        UWORD32 u4_event, UWORD32 u4_begin, UWORD32 u4_arg);
+
+void ih264d_trace_spin(dec_struct_t *ps_dec, UWORD32 u4_slot);
+
+void ih264d_trace_wait_end(dec_struct_t *ps_dec, UWORD32 u4_slot);
+
+void ih264d_trace_get_events(dec_struct_t *ps_dec,
+                             ih264d_ctl_get_trace_events_ip_t *ps_ip,
+                             ih264d_ctl_get_trace_events_op_t *ps_op);
+
+#endif /* _IH264D_TRACE_H_ */
@@ -81,7 +81,9 @@
 #include "ih264d_dpb_manager.h"
 #include "iv.h"
 #include "ivd.h"
+#include "ih264d.h"
 #include "ih264d_format_conv.h"
+#include "ih264d_film_grain.h"
 #include "ih264_error.h"
 #include "ih264_disp_mgr.h"
 #include "ih264_buf_mgr.h"
@@ -413,7 +415,13 @@ WORD32 ih264d_end_of_pic_processing(dec_struct_t *ps_dec) {
   u1_pic_type = 0;
   u1_nal_ref_idc = ps_cur_slice->u1_nal_ref_idc;
 
+  /* Nothing is predicted from an intra only picture, it is not kept */
+  if (ps_dec->u1_intra_only) u1_nal_ref_idc = 0;
+
   if (u1_nal_ref_idc) {
+    /* Only reference pictures can be co-located */
+    ih264d_pack_col_mvs(ps_dec);
+
     if (ps_cur_slice->u1_nal_unit_type == IDR_SLICE_NAL) {
       if (ps_dec->ps_dpb_cmds->u1_long_term_reference_flag == 0) {
         ih264d_reset_ref_bufs(ps_dec->ps_dpb_mgr);
@@ -848,12 +856,17 @@ WORD32 ih264d_init_pic(dec_struct_t *ps_dec, UWORD16 u2_frame_num,
   ps_dec->u2_frm_ht_in_mbs =
       (ps_dec->u2_pic_ht >> (4 + ps_dec->ps_cur_slice->u1_field_pic_flag));
 
+  ps_dec->u1_intra_only = ih264d_is_intra_only(ps_dec, ps_seq);
+
   /***************************************************************************/
   /* If change in Level or the required PicBuffers i4_size is more than the  */
   /* current one FREE the current PicBuffers and allocate affresh            */
   /***************************************************************************/
   if (!ps_dec->u1_init_dec_flag ||
       ih264d_is_sps_changed(ps_prev_seq_params, ps_seq)) {
+    ret = ih264d_alloc_sps_mem(ps_dec);
+    if (ret != OK) return ret;
+
     if (ps_dec->u4_share_disp_buf == 0) {
       i4_pic_bufs = get_numbuf_dpb_bank(ps_dec);
     } else {
@@ -895,6 +908,9 @@ WORD32 ih264d_init_pic(dec_struct_t *ps_dec, UWORD16 u2_frame_num,
                 ((UWORD32) ps_seq->s_vui.u4_num_reorder_frames + 1) * 2);
     }
 
+    ps_dec->i4_seq_display_delay = ps_dec->i4_display_delay;
+    ih264d_set_low_delay(ps_dec, ps_seq);
+
     /* Temporary hack to run Tractor Cav/Cab/MbAff Profiler streams  also for
      * CAFI1_SVA_C.264 in conformance*/
     if (ps_dec->u1_init_dec_flag) {
@@ -1161,6 +1177,11 @@ WORD32 ih264d_get_next_display_field(dec_struct_t *ps_dec,
     }
   }
 
+  /* Film grain of the picture, added when it is format converted */
+  if (NULL != ps_dec->ps_film_grain)
+    ih264d_film_grain_pic_init(ps_dec, u4_api_ret ? NULL : &pic_buf->s_sei_pic,
+                               pv_disp_op->e_output_format);
+
   return u4_api_ret;
 }
 
@@ -1284,6 +1305,107 @@ WORD32 ih264d_assign_display_seq(dec_struct_t *ps_dec) {
   return OK;
 }
 
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264d_set_low_delay                                     */
+/*                                                                           */
+/*  Description   : Decides whether pictures of the sequence go to display   */
+/*                  as soon as they are decoded. Called on SPS activation    */
+/*  Inputs        : ps_dec - Decoder parameters                              */
+/*                  ps_seq - Active SPS                                      */
+/*  Globals       : None                                                     */
+/*  Processing    : Zero reorder at init always outputs at once. Otherwise  */
+/*                  the SPS is trusted when it says whether pictures are     */
+/*                  reordered, and POCs are checked when it does not         */
+/*  Outputs       : Display delay to use                                     */
+/*  Returns       : None                                                     */
+/*                                                                           */
+/*  Issues        : None                                                     */
+/*                                                                           */
+/*****************************************************************************/
+void ih264d_set_low_delay(dec_struct_t *ps_dec, dec_seq_params_t *ps_seq) {
+  ps_dec->u1_low_delay = 0;
+  ps_dec->u1_low_delay_check_poc = 0;
+  ps_dec->i4_low_delay_prev_poc = (WORD32) 0x80000000;
+
+  if (0 == ps_dec->u4_num_reorder_frames_at_init) {
+    ps_dec->u1_low_delay = 1;
+  } else if (ps_dec->u4_low_delay && !ps_dec->u1_low_delay_dropped) {
+    /* 64 is set when bitstream_restriction is absent */
+    if (ps_seq->u1_vui_parameters_present_flag &&
+        (64 != ps_seq->s_vui.u4_num_reorder_frames)) {
+      ps_dec->u1_low_delay = (0 == ps_seq->s_vui.u4_num_reorder_frames);
+    } else if (2 == ps_seq->u1_pic_order_cnt_type) {
+      /* Output order is the decoding order with POC type 2 */
+      ps_dec->u1_low_delay = 1;
+    } else {
+      ps_dec->u1_low_delay = 1;
+      ps_dec->u1_low_delay_check_poc = 1;
+    }
+  }
+
+  ps_dec->i4_display_delay =
+      ps_dec->u1_low_delay ? 0 : ps_dec->i4_seq_display_delay;
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264d_is_intra_only                                     */
+/*                                                                           */
+/*  Description   : Decides whether the sequence is decoded as intra only.  */
+/*                  Called for every picture, as an SPS update that keeps   */
+/*                  the picture size may still change max_num_ref_frames,   */
+/*                  and for every slice header to reject P and B slices     */
+/*                  before a picture is started for them                    */
+/*  Inputs        : ps_dec - Decoder parameters                              */
+/*                  ps_seq - Active SPS                                      */
+/*  Globals       : None                                                     */
+/*  Processing    : The application hint is trusted. Otherwise a sequence   */
+/*                  is intra only when it has no reference frames or uses   */
+/*                  an Intra profile                                         */
+/*  Outputs       : None                                                     */
+/*  Returns       : 1 if intra only, 0 otherwise                             */
+/*                                                                           */
+/*  Issues        : None                                                     */
+/*                                                                           */
+/*****************************************************************************/
+UWORD8 ih264d_is_intra_only(dec_struct_t *ps_dec, dec_seq_params_t *ps_seq) {
+  return (ps_dec->u4_intra_only || (0 == ps_seq->u1_num_ref_frames) ||
+          ps_seq->u1_intra_profile);
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264d_check_low_delay_poc                               */
+/*                                                                           */
+/*  Description   : Drops low delay output until the next reset when a      */
+/*                  picture follows one with a higher POC                    */
+/*  Inputs        : ps_dec - Decoder parameters                              */
+/*                  i4_poc - POC the picture is put in the display list with */
+/*  Globals       : None                                                     */
+/*  Processing    : The picture that showed the reordering is still output,  */
+/*                  after the one before it, later ones are bumped as usual. */
+/*                  Not turned back on at an IDR, as the pictures the IDR    */
+/*                  bumps would stay queued ahead of every later one         */
+/*  Outputs       : Display delay to use                                     */
+/*  Returns       : None                                                     */
+/*                                                                           */
+/*  Issues        : None                                                     */
+/*                                                                           */
+/*****************************************************************************/
+void ih264d_check_low_delay_poc(dec_struct_t *ps_dec, WORD32 i4_poc) {
+  if (!ps_dec->u1_low_delay_check_poc) return;
+
+  if (i4_poc < ps_dec->i4_low_delay_prev_poc) {
+    ps_dec->u1_low_delay = 0;
+    ps_dec->u1_low_delay_check_poc = 0;
+    ps_dec->u1_low_delay_dropped = 1;
+    ps_dec->i4_display_delay = ps_dec->i4_seq_display_delay;
+    return;
+  }
+  ps_dec->i4_low_delay_prev_poc = i4_poc;
+}
+
 /*****************************************************************************/
 /*                                                                           */
 /*  Function Name : ih264d_release_display_bufs */
@@ -1857,6 +1979,10 @@ WORD16 ih264d_get_memory_dec_params(dec_struct_t *ps_dec) {
   ps_dec->pv_pic_tu_coeff_data =
       (void *) (ps_dec->pi2_coeff_data + MB_LUM_SIZE);
 
+  ps_dec->ps_pred_pkd = ps_dec->ps_mem_tab[MEM_REC_PRED_INFO_PKD].pv_base;
+  memset(ps_dec->ps_pred_pkd, 0,
+         ps_dec->ps_mem_tab[MEM_REC_PRED_INFO_PKD].u4_mem_size);
+
   /*scratch memory allocations*/
   {
     UWORD8 *pu1_scratch_mem_base;
@@ -2259,13 +2385,14 @@ WORD16 ih264d_get_memory_dec_params(dec_struct_t *ps_dec) {
 WORD32 ih264d_create_mv_bank(void *pv_dec, UWORD32 ui_width,
                              UWORD32 ui_height) {
   UWORD8 i;
-  UWORD32 col_flag_buffer_size, mvpred_buffer_size;
+  UWORD32 col_flag_buffer_size, mvpred_buffer_size, col_mv_buffer_size;
   UWORD8 *pu1_mv_buf_mgr_base, *pu1_mv_bank_base;
   UWORD32 u4_mv_buf_mgr_mem_used, u4_mv_bank_mem_used;
   col_mv_buf_t *ps_col_mv;
   mv_pred_t *ps_mv;
   UWORD8 *pu1_col_zero_flag_buf;
   dec_struct_t *ps_dec = (dec_struct_t *) pv_dec;
+  dec_seq_params_t *ps_seq = ps_dec->ps_cur_sps;
   WORD32 buf_ret;
 
   pu1_mv_buf_mgr_base = ps_dec->ps_mem_tab[MEM_REC_MV_BUF_MGR].pv_base;
@@ -2274,11 +2401,39 @@ WORD32 ih264d_create_mv_bank(void *pv_dec, UWORD32 ui_width,
   memset(pu1_mv_buf_mgr_base, 0,
          ps_dec->ps_mem_tab[MEM_REC_MV_BUF_MGR].u4_mem_size);
 
+  /* Temporal direct reads the co-located MVs only at the corner 4x4 of     */
+  /* each 8x8 block when direct_8x8_inference applies to frame pictures,    */
+  /* so a quarter of the co-located MVs is kept for such sequences          */
+  ps_dec->u1_col_mv_8x8 =
+      ps_seq->u1_frame_mbs_only_flag && ps_seq->u1_direct_8x8_inference_flag;
+  col_mv_buffer_size = sizeof(col_mv_t) * (col_flag_buffer_size >>
+                                           (ps_dec->u1_col_mv_8x8 << 1));
+
+  /* Records sized for intra only decode hold no co-located MVs, the MV    */
+  /* buffers are only handed out to keep the picture start code common     */
+  if (ps_dec->u4_intra_only_at_init) {
+    col_flag_buffer_size = 0;
+    col_mv_buffer_size = 0;
+  }
+
+  /* One working MV bank, with pad rows, is shared by the pictures being    */
+  /* decoded. It is packed into the co-located MVs of the MV buffer of a    */
+  /* reference picture at the end of the picture                            */
   pu1_mv_bank_base = ps_dec->ps_mem_tab[MEM_REC_MVBANK].pv_base;
-  u4_mv_bank_mem_used = 0;
   mvpred_buffer_size =
       sizeof(mv_pred_t) * ((ui_width * (ui_height + PAD_MV_BANK_ROW)) >> 4);
-  memset(pu1_mv_bank_base, 0, ps_dec->ps_mem_tab[MEM_REC_MVBANK].u4_mem_size);
+  u4_mv_bank_mem_used =
+      ALIGN128(mvpred_buffer_size) +
+      col_mv_buffer_size * (ps_dec->u1_max_dec_frame_buffering + 1);
+  if (u4_mv_bank_mem_used > ps_dec->ps_mem_tab[MEM_REC_MVBANK].u4_mem_size) {
+    ps_dec->i4_error_code = ERROR_BUF_MGR;
+    return ERROR_BUF_MGR;
+  }
+  memset(pu1_mv_bank_base, 0, u4_mv_bank_mem_used);
+
+  ps_mv = (mv_pred_t *) pu1_mv_bank_base;
+  ps_dec->ps_mv_bank_base = ps_mv + ((ui_width * OFFSET_MV_BANK_ROW) >> 4);
+  u4_mv_bank_mem_used = ALIGN128(mvpred_buffer_size);
 
   ps_dec->pv_mv_buf_mgr =
       (void *) (pu1_mv_buf_mgr_base + u4_mv_buf_mgr_mem_used);
@@ -2293,15 +2448,10 @@ WORD32 ih264d_create_mv_bank(void *pv_dec, UWORD32 ui_width,
     pu1_col_zero_flag_buf = pu1_mv_buf_mgr_base + u4_mv_buf_mgr_mem_used;
     u4_mv_buf_mgr_mem_used += col_flag_buffer_size;
 
-    ps_mv = (mv_pred_t *) (pu1_mv_bank_base + u4_mv_bank_mem_used);
-    u4_mv_bank_mem_used += mvpred_buffer_size;
-
-    memset(ps_mv, 0,
-           ((ui_width * OFFSET_MV_BANK_ROW) >> 4) * sizeof(mv_pred_t));
-    ps_mv += (ui_width * OFFSET_MV_BANK_ROW) >> 4;
-
     ps_col_mv->pv_col_zero_flag = (void *) pu1_col_zero_flag_buf;
-    ps_col_mv->pv_mv = (void *) ps_mv;
+    ps_col_mv->pv_mv = (void *) (pu1_mv_bank_base + u4_mv_bank_mem_used);
+    u4_mv_bank_mem_used += col_mv_buffer_size;
+
     buf_ret =
         ih264_buf_mgr_add((buf_mgr_t *) ps_dec->pv_mv_buf_mgr, ps_col_mv, i);
     if (0 != buf_ret) {
@@ -2311,9 +2461,8 @@ WORD32 ih264d_create_mv_bank(void *pv_dec, UWORD32 ui_width,
     ps_col_mv++;
   }
 
-  if ((u4_mv_buf_mgr_mem_used >
-       ps_dec->ps_mem_tab[MEM_REC_MV_BUF_MGR].u4_mem_size) ||
-      (u4_mv_bank_mem_used > ps_dec->ps_mem_tab[MEM_REC_MVBANK].u4_mem_size)) {
+  if (u4_mv_buf_mgr_mem_used >
+      ps_dec->ps_mem_tab[MEM_REC_MV_BUF_MGR].u4_mem_size) {
     ps_dec->i4_error_code = ERROR_BUF_MGR;
     return ERROR_BUF_MGR;
   }
@@ -2321,6 +2470,210 @@ WORD32 ih264d_create_mv_bank(void *pv_dec, UWORD32 ui_width,
   return OK;
 }
 
+static void ih264d_pack_col_mv(col_mv_t *ps_col_mv, const mv_pred_t *ps_mv) {
+  if (ps_mv->i1_ref_frame[0] >= 0) {
+    ps_col_mv->i2_mv[0] = ps_mv->i2_mv[0];
+    ps_col_mv->i2_mv[1] = ps_mv->i2_mv[1];
+  } else if (ps_mv->i1_ref_frame[1] >= 0) {
+    ps_col_mv->i2_mv[0] = ps_mv->i2_mv[2];
+    ps_col_mv->i2_mv[1] = ps_mv->i2_mv[3];
+  } else {
+    ps_col_mv->i2_mv[0] = 0;
+    ps_col_mv->i2_mv[1] = 0;
+  }
+  ps_col_mv->i1_ref_frame[0] = ps_mv->i1_ref_frame[0];
+  ps_col_mv->i1_ref_frame[1] = ps_mv->i1_ref_frame[1];
+  ps_col_mv->u1_col_ref_pic_idx = ps_mv->u1_col_ref_pic_idx;
+  ps_col_mv->u1_pic_type = ps_mv->u1_pic_type;
+}
+
+/*!
+ **************************************************************************
+ * \if Function name : ih264d_pack_col_mvs \endif
+ *
+ * \brief
+ *    Packs the MVs of the current picture from the working MV bank into
+ *    the co-located MVs of its MV buffer.
+ *
+ * \param ps_dec: Pointer to dec_struct_t.
+ *
+ * \return
+ *    None
+ *
+ * \note
+ *    Called at the end of a reference picture, as only reference pictures
+ *    can be co-located. For a field, only the half of the MV buffer that
+ *    belongs to the field is written. In 8x8 mode the corner 4x4 blocks
+ *    0, 3, 12 and 15 of each MB are kept, which are the only ones temporal
+ *    direct reads with direct_8x8_inference in frame pictures.
+ **************************************************************************
+ */
+void ih264d_pack_col_mvs(dec_struct_t *ps_dec) {
+  const mv_pred_t *ps_mv = ps_dec->s_cur_pic.ps_mv;
+  col_mv_t *ps_col_mv = ps_dec->s_cur_pic.ps_col_mv;
+  UWORD32 u4_num_blks, u4_blk;
+
+  u4_num_blks = (ps_dec->u2_pic_wd * ps_dec->u2_pic_ht) >>
+                (4 + ps_dec->ps_cur_slice->u1_field_pic_flag);
+
+  if (ps_dec->u1_col_mv_8x8) {
+    for (u4_blk = 0; u4_blk < u4_num_blks; u4_blk += 16) {
+      ih264d_pack_col_mv(ps_col_mv++, ps_mv + u4_blk);
+      ih264d_pack_col_mv(ps_col_mv++, ps_mv + u4_blk + 3);
+      ih264d_pack_col_mv(ps_col_mv++, ps_mv + u4_blk + 12);
+      ih264d_pack_col_mv(ps_col_mv++, ps_mv + u4_blk + 15);
+    }
+  } else {
+    for (u4_blk = 0; u4_blk < u4_num_blks; u4_blk++)
+      ih264d_pack_col_mv(ps_col_mv++, ps_mv + u4_blk);
+  }
+}
+
+/*!
+ **************************************************************************
+ * \if Function name : ih264d_alloc_sps_mem \endif
+ *
+ * \brief
+ *    Allocates the picture sized memory records for the SPS being
+ *    activated, when the decoder is initialized with u4_alloc_per_sps.
+ *
+ * \param ps_dec: Pointer to dec_struct_t.
+ *
+ * \return
+ *    0 on Success and error code otherwise
+ *
+ * \note
+ *    The records are sized by the fill mem rec query at the resolution of
+ *    the SPS, with the level and frame counts given at init, and are carved
+ *    out of one block got from the application's allocator. The block grows
+ *    as soon as an SPS needs more and shrinks only after
+ *    SPS_MEM_SHRINK_ACTIVATIONS consecutive activations needed less than
+ *    half of it. It is reallocated only after a decoder reset, which is
+ *    where a change in resolution is taken, so that no buffer of the
+ *    previous sequence is in use.
+ **************************************************************************
+ */
+WORD32 ih264d_alloc_sps_mem(dec_struct_t *ps_dec) {
+  iv_mem_rec_t as_mem_rec[MEM_REC_CNT];
+  ih264d_fill_mem_rec_ip_t s_fill_mem_rec_ip;
+  ih264d_fill_mem_rec_op_t s_fill_mem_rec_op;
+  UWORD32 au4_offset[NUM_SPS_MEM_RECS];
+  UWORD32 u4_mem_size, u4_realloc;
+  UWORD8 *pu1_mem;
+  WORD32 i;
+
+  if (0 == ps_dec->u4_alloc_per_sps) return OK;
+
+  for (i = 0; i < MEM_REC_CNT; i++)
+    as_mem_rec[i].u4_size = sizeof(iv_mem_rec_t);
+
+  s_fill_mem_rec_ip.s_ivd_fill_mem_rec_ip_t.u4_size =
+      sizeof(ih264d_fill_mem_rec_ip_t);
+  s_fill_mem_rec_ip.s_ivd_fill_mem_rec_ip_t.e_cmd = IV_CMD_FILL_NUM_MEM_REC;
+  s_fill_mem_rec_ip.s_ivd_fill_mem_rec_ip_t.pv_mem_rec_location = as_mem_rec;
+  s_fill_mem_rec_ip.s_ivd_fill_mem_rec_ip_t.u4_max_frm_wd = ps_dec->u2_pic_wd;
+  s_fill_mem_rec_ip.s_ivd_fill_mem_rec_ip_t.u4_max_frm_ht = ps_dec->u2_pic_ht;
+  s_fill_mem_rec_ip.i4_level = ps_dec->u4_level_at_init;
+  s_fill_mem_rec_ip.u4_num_reorder_frames =
+      ps_dec->u4_num_reorder_frames_at_init;
+  s_fill_mem_rec_ip.u4_num_ref_frames = ps_dec->u4_num_ref_frames_at_init;
+  s_fill_mem_rec_ip.u4_share_disp_buf = ps_dec->u4_share_disp_buf;
+  s_fill_mem_rec_ip.e_output_format =
+      (IV_COLOR_FORMAT_T) ps_dec->u1_chroma_format;
+  s_fill_mem_rec_ip.u4_num_extra_disp_buf =
+      ps_dec->u4_num_extra_disp_bufs_at_init;
+  s_fill_mem_rec_ip.u4_alloc_per_sps = 0;
+  s_fill_mem_rec_ip.pe_mem_placement = NULL;
+  s_fill_mem_rec_ip.u4_mem_budget = 0;
+  s_fill_mem_rec_ip.u4_film_grain = ps_dec->u4_film_grain;
+  s_fill_mem_rec_ip.u4_intra_only = ps_dec->u4_intra_only_at_init;
+  s_fill_mem_rec_op.s_ivd_fill_mem_rec_op_t.u4_size =
+      sizeof(ih264d_fill_mem_rec_op_t);
+
+  if (IV_SUCCESS != ih264d_api_function(NULL, (void *) &s_fill_mem_rec_ip,
+                                        (void *) &s_fill_mem_rec_op)) {
+    return ERROR_NOT_SUPP_RESOLUTION;
+  }
+
+  /* All the records ask for 128 byte alignment */
+  u4_mem_size = 0;
+  for (i = 0; i < NUM_SPS_MEM_RECS; i++) {
+    au4_offset[i] = u4_mem_size;
+    u4_mem_size +=
+        ALIGN128(as_mem_rec[gau1_ih264d_sps_mem_recs[i]].u4_mem_size);
+  }
+
+  u4_realloc = 0;
+  if (NULL == ps_dec->pv_sps_mem) {
+    u4_realloc = 1;
+  } else if (ps_dec->u1_init_dec_flag) {
+    /* Buffers of the current sequence are still in use */
+    if (u4_mem_size > ps_dec->u4_sps_mem_size)
+      return ERROR_DYNAMIC_RESOLUTION_NOT_SUPPORTED;
+  } else if (u4_mem_size > ps_dec->u4_sps_mem_size) {
+    u4_realloc = 1;
+  } else if ((u4_mem_size << 1) < ps_dec->u4_sps_mem_size) {
+    ps_dec->u4_sps_mem_shrink_cnt++;
+    if (ps_dec->u4_sps_mem_shrink_cnt >= SPS_MEM_SHRINK_ACTIVATIONS)
+      u4_realloc = 1;
+  } else {
+    ps_dec->u4_sps_mem_shrink_cnt = 0;
+  }
+
+  if (u4_realloc) {
+    ih264d_free_sps_mem(ps_dec);
+
+    ps_dec->pv_sps_mem =
+        ps_dec->pf_aligned_alloc(ps_dec->pv_mem_ctxt, 128, u4_mem_size);
+    if (NULL == ps_dec->pv_sps_mem) return ERROR_MEM_ALLOC_SDRAM_T;
+
+    ps_dec->u4_sps_mem_size = u4_mem_size;
+    ps_dec->u4_sps_mem_shrink_cnt = 0;
+  }
+
+  /* Records keep the size needed by this SPS even when the block is larger,
+   so that the number of picture buffers follows the SPS */
+  pu1_mem = (UWORD8 *) ps_dec->pv_sps_mem;
+  for (i = 0; i < NUM_SPS_MEM_RECS; i++) {
+    iv_mem_rec_t *ps_mem_rec =
+        &ps_dec->ps_mem_tab[gau1_ih264d_sps_mem_recs[i]];
+
+    ps_mem_rec->pv_base = pu1_mem + au4_offset[i];
+    ps_mem_rec->u4_mem_size =
+        as_mem_rec[gau1_ih264d_sps_mem_recs[i]].u4_mem_size;
+  }
+
+  return OK;
+}
+
+/*!
+ **************************************************************************
+ * \if Function name : ih264d_free_sps_mem \endif
+ *
+ * \brief
+ *    Frees the block allocated by ih264d_alloc_sps_mem() and restores the
+ *    memory records given by the application.
+ *
+ * \param ps_dec: Pointer to dec_struct_t.
+ *
+ * \return
+ *    None
+ **************************************************************************
+ */
+void ih264d_free_sps_mem(dec_struct_t *ps_dec) {
+  WORD32 i;
+
+  if (NULL == ps_dec->pv_sps_mem) return;
+
+  ps_dec->pf_aligned_free(ps_dec->pv_mem_ctxt, ps_dec->pv_sps_mem);
+  ps_dec->pv_sps_mem = NULL;
+  ps_dec->u4_sps_mem_size = 0;
+
+  for (i = 0; i < NUM_SPS_MEM_RECS; i++)
+    ps_dec->ps_mem_tab[gau1_ih264d_sps_mem_recs[i]] =
+        ps_dec->as_sps_mem_rec_app[i];
+}
+
 void ih264d_unpack_coeff4x4_dc_4x4blk(tu_sblk4x4_coeff_data_t *ps_tu_4x4,
                                       WORD16 *pi2_out_coeff_data,
                                       UWORD8 *pu1_inv_scan) {
@@ -88,6 +88,9 @@ WORD32 ih264d_decode_pic_order_cnt(
     UWORD8 u1_bottom_field_flag, UWORD8 u1_field_pic_flag, WORD32 *pi4_poc);
 void ih264d_release_display_bufs(dec_struct_t *ps_dec);
 WORD32 ih264d_assign_display_seq(dec_struct_t *ps_dec);
+void ih264d_set_low_delay(dec_struct_t *ps_dec, dec_seq_params_t *ps_seq);
+UWORD8 ih264d_is_intra_only(dec_struct_t *ps_dec, dec_seq_params_t *ps_seq);
+void ih264d_check_low_delay_poc(dec_struct_t *ps_dec, WORD32 i4_poc);
 void ih264d_assign_pic_num(dec_struct_t *ps_dec);
 
 void ih264d_unpack_coeff4x4_dc_4x4blk(tu_sblk4x4_coeff_data_t *ps_tu_4x4,
@@ -0,0 +1,179 @@
+/* Copyright (c) [2020]-[2023] Ittiam Systems Pvt. Ltd.
+   All rights reserved.
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted (subject to the limitations in the
+   disclaimer below) provided that the following conditions are met:
+   •    Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+   •    Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+   •    None of the names of Ittiam Systems Pvt. Ltd., its affiliates,
+   investors, business partners, nor the names of its contributors may be
+   used to endorse or promote products derived from this software without
+   specific prior written permission.
+
+   NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED
+   BY THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+   BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+   FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+   HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+   OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+   WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+   OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+   EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+   This Software is an implementation of the AVC/H.264
+   standard by Ittiam Systems Pvt. Ltd. (“Ittiam”).
+   Additional patent licenses may be required for this Software,
+   including, but not limited to, a license from MPEG LA’s AVC/H.264
+   licensing program (see https://www.mpegla.com/programs/avc-h-264/).
+
+   NOTWITHSTANDING ANYTHING TO THE CONTRARY, THIS DOES NOT GRANT ANY
+   EXPRESS OR IMPLIED LICENSES TO ANY PATENT CLAIMS OF ANY AFFILIATE
+   (TO THE EXTENT NOT IN THE LEGAL ENTITY), INVESTOR, OR OTHER
+   BUSINESS PARTNER OF ITTIAM. You may only use this software or
+   modifications thereto for purposes that are authorized by
+   appropriate patent licenses. You should seek legal advice based
+   upon your implementation details.
+
+---------------------------------------------------------------
+*/
+/*****************************************************************************/
+/*                                                                           */
+/*  File Name         : ih264d_format_conv_simd128.c                         */
+/*                                                                           */
+/*  Description       : Contains the 420SP output conversions in            */
+/*                      WebAssembly SIMD128 intrinsics. Luma rows are        */
+/*                      copied with memcpy, which lowers to a bulk memory    */
+/*                      copy, chroma rows are split or swapped 16 bytes at   */
+/*                      a time                                               */
+/*                                                                           */
+/*  List of Functions : ih264d_fmt_conv_420sp_to_420p_simd128()              */
+/*                      ih264d_fmt_conv_420sp_to_420sp_swap_uv_simd128()     */
+/*                                                                           */
+/*  Issues / Problems : None                                                 */
+/*                                                                           */
+/*****************************************************************************/
+/*****************************************************************************/
+/* File Includes
+/*****************************************************************************/
+
+#include <string.h>
+#include <wasm_simd128.h>
+#include "ih264_typedefs.h"
+#include "iv.h"
+#include "ivd.h"
+#include "ih264d_structs.h"
+#include "ih264d_format_conv.h"
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264d_fmt_conv_420sp_to_420p_simd128                    */
+/*                                                                           */
+/*  Description   : Copies luma and de-interleaves chroma of a 420SP         */
+/*                  buffer, 16 output samples of each component per step     */
+/*                                                                           */
+/*  Inputs        : as ih264d_fmt_conv_420sp_to_420p                         */
+/*  Outputs       : pu1_y_dst, pu1_u_dst, pu1_v_dst                          */
+/*                                                                           */
+/*****************************************************************************/
+void ih264d_fmt_conv_420sp_to_420p_simd128(
+    UWORD8 *pu1_y_src, UWORD8 *pu1_uv_src, UWORD8 *pu1_y_dst,
+    UWORD8 *pu1_u_dst, UWORD8 *pu1_v_dst, WORD32 wd, WORD32 ht,
+    WORD32 src_y_strd, WORD32 src_uv_strd, WORD32 dst_y_strd,
+    WORD32 dst_uv_strd, WORD32 is_u_first, WORD32 disable_luma_copy) {
+  UWORD8 *pu1_u_src, *pu1_v_src;
+  WORD32 num_cols = wd >> 1;
+  WORD32 i, j;
+
+  if (0 == disable_luma_copy) {
+    for (i = 0; i < ht; i++) {
+      memcpy(pu1_y_dst, pu1_y_src, wd);
+      pu1_y_dst += dst_y_strd;
+      pu1_y_src += src_y_strd;
+    }
+  }
+
+  if (is_u_first) {
+    pu1_u_src = pu1_uv_src;
+    pu1_v_src = pu1_uv_src + 1;
+  } else {
+    pu1_u_src = pu1_uv_src + 1;
+    pu1_v_src = pu1_uv_src;
+  }
+
+  for (i = 0; i < (ht >> 1); i++) {
+    for (j = 0; j + 16 <= num_cols; j += 16) {
+      v128_t lo_16x8b = wasm_v128_load(pu1_uv_src + 2 * j);
+      v128_t hi_16x8b = wasm_v128_load(pu1_uv_src + 2 * j + 16);
+      v128_t even_16x8b =
+          wasm_i8x16_shuffle(lo_16x8b, hi_16x8b, 0, 2, 4, 6, 8, 10, 12, 14, 16,
+                             18, 20, 22, 24, 26, 28, 30);
+      v128_t odd_16x8b =
+          wasm_i8x16_shuffle(lo_16x8b, hi_16x8b, 1, 3, 5, 7, 9, 11, 13, 15, 17,
+                             19, 21, 23, 25, 27, 29, 31);
+
+      if (is_u_first) {
+        wasm_v128_store(pu1_u_dst + j, even_16x8b);
+        wasm_v128_store(pu1_v_dst + j, odd_16x8b);
+      } else {
+        wasm_v128_store(pu1_u_dst + j, odd_16x8b);
+        wasm_v128_store(pu1_v_dst + j, even_16x8b);
+      }
+    }
+    for (; j < num_cols; j++) {
+      pu1_u_dst[j] = pu1_u_src[j * 2];
+      pu1_v_dst[j] = pu1_v_src[j * 2];
+    }
+
+    pu1_uv_src += src_uv_strd;
+    pu1_u_src += src_uv_strd;
+    pu1_v_src += src_uv_strd;
+    pu1_u_dst += dst_uv_strd;
+    pu1_v_dst += dst_uv_strd;
+  }
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264d_fmt_conv_420sp_to_420sp_swap_uv_simd128           */
+/*                                                                           */
+/*  Description   : Copies luma and swaps the two components of each         */
+/*                  chroma pair of a 420SP buffer, 8 pairs per step          */
+/*                                                                           */
+/*  Inputs        : as ih264d_fmt_conv_420sp_to_420sp_swap_uv                */
+/*  Outputs       : pu1_y_dst, pu1_uv_dst                                    */
+/*                                                                           */
+/*****************************************************************************/
+void ih264d_fmt_conv_420sp_to_420sp_swap_uv_simd128(
+    UWORD8 *pu1_y_src, UWORD8 *pu1_uv_src, UWORD8 *pu1_y_dst,
+    UWORD8 *pu1_uv_dst, WORD32 wd, WORD32 ht, WORD32 src_y_strd,
+    WORD32 src_uv_strd, WORD32 dst_y_strd, WORD32 dst_uv_strd) {
+  WORD32 i, j;
+
+  for (i = 0; i < ht; i++) {
+    memcpy(pu1_y_dst, pu1_y_src, wd);
+    pu1_y_dst += dst_y_strd;
+    pu1_y_src += src_y_strd;
+  }
+
+  for (i = 0; i < (ht >> 1); i++) {
+    for (j = 0; j + 16 <= wd; j += 16) {
+      v128_t uv_16x8b = wasm_v128_load(pu1_uv_src + j);
+
+      uv_16x8b = wasm_i8x16_shuffle(uv_16x8b, uv_16x8b, 1, 0, 3, 2, 5, 4, 7, 6,
+                                    9, 8, 11, 10, 13, 12, 15, 14);
+      wasm_v128_store(pu1_uv_dst + j, uv_16x8b);
+    }
+    for (; j < wd; j += 2) {
+      pu1_uv_dst[j + 0] = pu1_uv_src[j + 1];
+      pu1_uv_dst[j + 1] = pu1_uv_src[j + 0];
+    }
+    pu1_uv_dst += dst_uv_strd;
+    pu1_uv_src += src_uv_strd;
+  }
+}
@@ -0,0 +1,118 @@
+/* Copyright (c) [2020]-[2023] Ittiam Systems Pvt. Ltd.
+   All rights reserved.
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted (subject to the limitations in the
+   disclaimer below) provided that the following conditions are met:
+   •    Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+   •    Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+   •    None of the names of Ittiam Systems Pvt. Ltd., its affiliates,
+   investors, business partners, nor the names of its contributors may be
+   used to endorse or promote products derived from this software without
+   specific prior written permission.
+
+   NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED
+   BY THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+   BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+   FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+   HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+   OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+   WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+   OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+   EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+   This Software is an implementation of the AVC/H.264
+   standard by Ittiam Systems Pvt. Ltd. (“Ittiam”).
+   Additional patent licenses may be required for this Software,
+   including, but not limited to, a license from MPEG LA’s AVC/H.264
+   licensing program (see https://www.mpegla.com/programs/avc-h-264/).
+
+   NOTWITHSTANDING ANYTHING TO THE CONTRARY, THIS DOES NOT GRANT ANY
+   EXPRESS OR IMPLIED LICENSES TO ANY PATENT CLAIMS OF ANY AFFILIATE
+   (TO THE EXTENT NOT IN THE LEGAL ENTITY), INVESTOR, OR OTHER
+   BUSINESS PARTNER OF ITTIAM. You may only use this software or
+   modifications thereto for purposes that are authorized by
+   appropriate patent licenses. You should seek legal advice based
+   upon your implementation details.
+
+---------------------------------------------------------------
+*/
+/**
+*******************************************************************************
+* @file
+*  ih264d_function_selector.c
+*
+* @brief
+*  Contains functions to initialize function pointers of the decoder built
+*  for WebAssembly
+*
+* @author
+*  Ittiam
+*
+* @par List of Functions:
+*  - ih264d_init_function_ptr
+*  - ih264d_init_arch
+*
+* @remarks
+*  The x86 intrinsic kernels are built too, emscripten maps them to SIMD128,
+*  and the SIMD128 kernels replace those whose emulation is costly
+*
+*******************************************************************************
+*/
+/*****************************************************************************/
+/* File Includes                                                             */
+/*****************************************************************************/
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* User Include files */
+#include "ih264_typedefs.h"
+#include "iv.h"
+#include "ivd.h"
+#include "ih264_defs.h"
+#include "ih264_size_defs.h"
+#include "ih264_error.h"
+#include "ih264_trans_quant_itrans_iquant.h"
+#include "ih264_inter_pred_filters.h"
+
+#include "ih264d_structs.h"
+#include "ih264d_function_selector.h"
+
+void ih264d_init_function_ptr(dec_struct_t *ps_codec) {
+  ih264d_init_function_ptr_generic(ps_codec);
+  switch (ps_codec->e_processor_arch) {
+    case ARCH_WASM_GENERIC:
+      break;
+    case ARCH_X86_SSE42:
+      ih264d_init_function_ptr_ssse3(ps_codec);
+      ih264d_init_function_ptr_sse42(ps_codec);
+      break;
+    case ARCH_WASM_SIMD128:
+    default:
+      ih264d_init_function_ptr_ssse3(ps_codec);
+      ih264d_init_function_ptr_sse42(ps_codec);
+      ih264d_init_function_ptr_simd128(ps_codec);
+      break;
+  }
+}
+void ih264d_init_arch(dec_struct_t *ps_codec) {
+#ifdef DEFAULT_ARCH
+#if DEFAULT_ARCH == D_ARCH_WASM_SIMD128
+  ps_codec->e_processor_arch = ARCH_WASM_SIMD128;
+#elif DEFAULT_ARCH == D_ARCH_X86_SSE42
+  ps_codec->e_processor_arch = ARCH_X86_SSE42;
+#else
+  ps_codec->e_processor_arch = ARCH_WASM_GENERIC;
+#endif
+#else
+  ps_codec->e_processor_arch = ARCH_WASM_SIMD128;
+#endif
+}
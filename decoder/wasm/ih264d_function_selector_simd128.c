@@ -0,0 +1,177 @@
+/* Copyright (c) [2020]-[2023] Ittiam Systems Pvt. Ltd.
+   All rights reserved.
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted (subject to the limitations in the
+   disclaimer below) provided that the following conditions are met:
+   •    Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+   •    Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+   •    None of the names of Ittiam Systems Pvt. Ltd., its affiliates,
+   investors, business partners, nor the names of its contributors may be
+   used to endorse or promote products derived from this software without
+   specific prior written permission.
+
+   NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED
+   BY THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+   BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+   FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+   HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+   OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+   WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+   OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+   EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+   This Software is an implementation of the AVC/H.264
+   standard by Ittiam Systems Pvt. Ltd. (“Ittiam”).
+   Additional patent licenses may be required for this Software,
+   including, but not limited to, a license from MPEG LA’s AVC/H.264
+   licensing program (see https://www.mpegla.com/programs/avc-h-264/).
+
+   NOTWITHSTANDING ANYTHING TO THE CONTRARY, THIS DOES NOT GRANT ANY
+   EXPRESS OR IMPLIED LICENSES TO ANY PATENT CLAIMS OF ANY AFFILIATE
+   (TO THE EXTENT NOT IN THE LEGAL ENTITY), INVESTOR, OR OTHER
+   BUSINESS PARTNER OF ITTIAM. You may only use this software or
+   modifications thereto for purposes that are authorized by
+   appropriate patent licenses. You should seek legal advice based
+   upon your implementation details.
+
+---------------------------------------------------------------
+*/
+/**
+*******************************************************************************
+* @file
+*  ih264d_function_selector_simd128.c
+*
+* @brief
+*  Contains functions to initialize function pointers of codec context
+*
+* @author
+*  Ittiam
+*
+* @par List of Functions:
+*  - ih264d_init_function_ptr_simd128
+*
+* @remarks
+*  None
+*
+*******************************************************************************
+*/
+
+/*****************************************************************************/
+/* File Includes                                                             */
+/*****************************************************************************/
+
+/* System Include files */
+#include <stdio.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* User Include files */
+#include "ih264_typedefs.h"
+#include "iv.h"
+#include "ivd.h"
+#include "ih264_defs.h"
+#include "ih264_size_defs.h"
+#include "ih264_error.h"
+#include "ih264_trans_quant_itrans_iquant.h"
+#include "ih264_inter_pred_filters.h"
+
+#include "ih264d_structs.h"
+#include "ih264d_deblocking.h"
+#include "ih264d_process_intra_mb.h"
+#include "ih264d_format_conv.h"
+
+/**
+*******************************************************************************
+*
+* @brief Initialize the inter/transform/deblk/output function pointers of
+* codec context with the SIMD128 kernels
+*
+* @par Description: called after the SSSE3 and SSE4.2 initializations, which
+* supply the kernels not listed here. The row deblocking and the MB level
+* iquant drivers are the C ones, so that they reach the SIMD128 edge and
+* 4x4 kernels through the function pointers
+*
+* @param[in] ps_codec
+*  Codec context pointer
+*
+* @returns  none
+*
+* @remarks MBAFF edges keep the SSSE3 kernels
+*
+*******************************************************************************
+*/
+void ih264d_init_function_ptr_simd128(dec_struct_t *ps_codec) {
+  /* Inter pred leaf level functions */
+  ps_codec->apf_inter_pred_luma[0] = ih264_inter_pred_luma_copy_simd128;
+  ps_codec->apf_inter_pred_luma[1] = ih264_inter_pred_luma_horz_qpel_simd128;
+  ps_codec->apf_inter_pred_luma[2] = ih264_inter_pred_luma_horz_simd128;
+  ps_codec->apf_inter_pred_luma[3] = ih264_inter_pred_luma_horz_qpel_simd128;
+  ps_codec->apf_inter_pred_luma[4] = ih264_inter_pred_luma_vert_qpel_simd128;
+  ps_codec->apf_inter_pred_luma[5] =
+      ih264_inter_pred_luma_horz_qpel_vert_qpel_simd128;
+  ps_codec->apf_inter_pred_luma[6] =
+      ih264_inter_pred_luma_horz_hpel_vert_qpel_simd128;
+  ps_codec->apf_inter_pred_luma[7] =
+      ih264_inter_pred_luma_horz_qpel_vert_qpel_simd128;
+  ps_codec->apf_inter_pred_luma[8] = ih264_inter_pred_luma_vert_simd128;
+  ps_codec->apf_inter_pred_luma[9] =
+      ih264_inter_pred_luma_horz_qpel_vert_hpel_simd128;
+  ps_codec->apf_inter_pred_luma[10] =
+      ih264_inter_pred_luma_horz_hpel_vert_hpel_simd128;
+  ps_codec->apf_inter_pred_luma[11] =
+      ih264_inter_pred_luma_horz_qpel_vert_hpel_simd128;
+  ps_codec->apf_inter_pred_luma[12] = ih264_inter_pred_luma_vert_qpel_simd128;
+  ps_codec->apf_inter_pred_luma[13] =
+      ih264_inter_pred_luma_horz_qpel_vert_qpel_simd128;
+  ps_codec->apf_inter_pred_luma[14] =
+      ih264_inter_pred_luma_horz_hpel_vert_qpel_simd128;
+  ps_codec->apf_inter_pred_luma[15] =
+      ih264_inter_pred_luma_horz_qpel_vert_qpel_simd128;
+
+  ps_codec->pf_inter_pred_chroma = ih264_inter_pred_chroma_simd128;
+
+  ps_codec->pf_iquant_itrans_recon_luma_4x4 =
+      ih264_iquant_itrans_recon_4x4_simd128;
+  ps_codec->pf_iquant_itrans_recon_luma_4x4_dc =
+      ih264_iquant_itrans_recon_4x4_dc_simd128;
+  ps_codec->pf_iquant_itrans_recon_luma_8x8 =
+      ih264_iquant_itrans_recon_8x8_simd128;
+  ps_codec->pf_iquant_itrans_recon_luma_8x8_dc =
+      ih264_iquant_itrans_recon_8x8_dc_simd128;
+  ps_codec->pf_iquant_itrans_recon_chroma_4x4 =
+      ih264_iquant_itrans_recon_chroma_4x4_simd128;
+  ps_codec->pf_iquant_itrans_recon_chroma_4x4_dc =
+      ih264_iquant_itrans_recon_chroma_4x4_dc_simd128;
+  ps_codec->pf_iquant_itrans_recon_luma_4x4_mb =
+      ih264d_iquant_itrans_recon_luma_4x4_mb;
+  ps_codec->pf_iquant_itrans_recon_chroma_4x4_mb =
+      ih264d_iquant_itrans_recon_chroma_4x4_mb;
+
+  /* Init fn ptr luma deblocking */
+  ps_codec->pf_deblk_luma_vert_bs4 = ih264_deblk_luma_vert_bs4_simd128;
+  ps_codec->pf_deblk_luma_vert_bslt4 = ih264_deblk_luma_vert_bslt4_simd128;
+  ps_codec->pf_deblk_luma_horz_bs4 = ih264_deblk_luma_horz_bs4_simd128;
+  ps_codec->pf_deblk_luma_horz_bslt4 = ih264_deblk_luma_horz_bslt4_simd128;
+
+  /* Init fn ptr chroma deblocking */
+  ps_codec->pf_deblk_chroma_vert_bs4 = ih264_deblk_chroma_vert_bs4_simd128;
+  ps_codec->pf_deblk_chroma_vert_bslt4 =
+      ih264_deblk_chroma_vert_bslt4_simd128;
+  ps_codec->pf_deblk_chroma_horz_bs4 = ih264_deblk_chroma_horz_bs4_simd128;
+  ps_codec->pf_deblk_chroma_horz_bslt4 =
+      ih264_deblk_chroma_horz_bslt4_simd128;
+
+  ps_codec->pf_deblk_row_nonmbaff = ih264d_deblk_row_nonmbaff;
+
+  ps_codec->pf_fmt_conv_420sp_to_420p = ih264d_fmt_conv_420sp_to_420p_simd128;
+  ps_codec->pf_fmt_conv_420sp_to_420sp_swap_uv =
+      ih264d_fmt_conv_420sp_to_420sp_swap_uv_simd128;
+  return;
+}
@@ -0,0 +1,343 @@
+/* Copyright (c) [2020]-[2023] Ittiam Systems Pvt. Ltd.
+   All rights reserved.
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted (subject to the limitations in the
+   disclaimer below) provided that the following conditions are met:
+   •    Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+   •    Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+   •    None of the names of Ittiam Systems Pvt. Ltd., its affiliates,
+   investors, business partners, nor the names of its contributors may be
+   used to endorse or promote products derived from this software without
+   specific prior written permission.
+
+   NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED
+   BY THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+   BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+   FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+   HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+   OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+   WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+   OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+   EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+   This Software is an implementation of the AVC/H.264
+   standard by Ittiam Systems Pvt. Ltd. (“Ittiam”).
+   Additional patent licenses may be required for this Software,
+   including, but not limited to, a license from MPEG LA’s AVC/H.264
+   licensing program (see https://www.mpegla.com/programs/avc-h-264/).
+
+   NOTWITHSTANDING ANYTHING TO THE CONTRARY, THIS DOES NOT GRANT ANY
+   EXPRESS OR IMPLIED LICENSES TO ANY PATENT CLAIMS OF ANY AFFILIATE
+   (TO THE EXTENT NOT IN THE LEGAL ENTITY), INVESTOR, OR OTHER
+   BUSINESS PARTNER OF ITTIAM. You may only use this software or
+   modifications thereto for purposes that are authorized by
+   appropriate patent licenses. You should seek legal advice based
+   upon your implementation details.
+
+---------------------------------------------------------------
+*/
+/*****************************************************************************/
+/*                                                                           */
+/*  File Name         : ih264d_compute_bs_sse42.c                            */
+/*                                                                           */
+/*  Description       : Contains function definitions for boundary strength  */
+/*                      computation in x86 sse4 intrinsics                   */
+/*                                                                           */
+/*  List of Functions : ih264d_fill_bs1_non16x16mb_pslice_sse42()            */
+/*                      ih264d_fill_bs1_non16x16mb_bslice_sse42()            */
+/*                                                                           */
+/*  Issues / Problems : None                                                 */
+/*                                                                           */
+/*****************************************************************************/
+/*****************************************************************************/
+/* File Includes                                                             */
+/*****************************************************************************/
+
+#include <immintrin.h>
+#include "ih264_typedefs.h"
+#include "ih264_macros.h"
+#include "ih264_platform_macros.h"
+#include "ih264d_defs.h"
+#include "ih264d_structs.h"
+#include "ih264d_deblocking.h"
+
+/*****************************************************************************/
+/* MVs and reference picture addresses of the 16 blocks of a MB, preceded by */
+/* the 4 neighbouring blocks across the MB edge. In raster order (top row    */
+/* first) block k + 4 and block k are the q and p blocks of the horz edge    */
+/* k. In column major order (left column first) the same holds for the vert  */
+/* edges. Edge k has edge number k >> 2 and position k & 3                   */
+/*****************************************************************************/
+#define NUM_BLKS_4x4 20
+
+typedef struct {
+  WORD16 ai2_mv[4][NUM_BLKS_4x4];
+  void *apv_addr[2][NUM_BLKS_4x4];
+} bs_blk_data_t;
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264d_ptr_neq_16x8b                                     */
+/*                                                                           */
+/*  Description   : Compares 16 pairs of picture addresses and returns one   */
+/*                  byte per pair, 0xff if the addresses differ              */
+/*                                                                           */
+/*  Inputs        : ppv_a, ppv_b - arrays of 16 addresses                    */
+/*                                                                           */
+/*  Returns       : Byte mask                                                */
+/*                                                                           */
+/*****************************************************************************/
+static __inline __m128i ih264d_ptr_neq_16x8b(void **ppv_a, void **ppv_b) {
+  __m128i eq_4x32b[4];
+  WORD32 i;
+
+  for (i = 0; i < 4; i++) {
+    if (sizeof(void *) == 8) {
+      __m128i a0_2x64b = _mm_loadu_si128((__m128i *) (ppv_a + 4 * i));
+      __m128i a1_2x64b = _mm_loadu_si128((__m128i *) (ppv_a + 4 * i + 2));
+      __m128i b0_2x64b = _mm_loadu_si128((__m128i *) (ppv_b + 4 * i));
+      __m128i b1_2x64b = _mm_loadu_si128((__m128i *) (ppv_b + 4 * i + 2));
+      __m128i eq0_2x64b = _mm_cmpeq_epi64(a0_2x64b, b0_2x64b);
+      __m128i eq1_2x64b = _mm_cmpeq_epi64(a1_2x64b, b1_2x64b);
+
+      /* Low dword of each 64 bit mask, for the four addresses */
+      eq_4x32b[i] = _mm_castps_si128(_mm_shuffle_ps(
+          _mm_castsi128_ps(eq0_2x64b), _mm_castsi128_ps(eq1_2x64b), 0x88));
+    } else {
+      __m128i a_4x32b = _mm_loadu_si128((__m128i *) (ppv_a + 4 * i));
+      __m128i b_4x32b = _mm_loadu_si128((__m128i *) (ppv_b + 4 * i));
+
+      eq_4x32b[i] = _mm_cmpeq_epi32(a_4x32b, b_4x32b);
+    }
+  }
+
+  return _mm_xor_si128(
+      _mm_packs_epi16(_mm_packs_epi32(eq_4x32b[0], eq_4x32b[1]),
+                      _mm_packs_epi32(eq_4x32b[2], eq_4x32b[3])),
+      _mm_set1_epi8(-1));
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264d_mv_diff_16x8b                                     */
+/*                                                                           */
+/*  Description   : Compares one MV component of 16 block pairs and returns  */
+/*                  one byte per pair, 0xff if ABS(p - q) >= limit           */
+/*                                                                           */
+/*  Inputs        : pi2_p, pi2_q   - arrays of 16 MV components              */
+/*                  limit_8x16b    - limit replicated in all lanes           */
+/*                                                                           */
+/*  Returns       : Byte mask                                                */
+/*                                                                           */
+/*  Issues        : Difference saturates to 16 bits which does not change    */
+/*                  the result as the limit is small                         */
+/*                                                                           */
+/*****************************************************************************/
+static __inline __m128i ih264d_mv_diff_16x8b(WORD16 *pi2_p, WORD16 *pi2_q,
+                                             __m128i limit_8x16b) {
+  __m128i p0_8x16b = _mm_loadu_si128((__m128i *) pi2_p);
+  __m128i p1_8x16b = _mm_loadu_si128((__m128i *) (pi2_p + 8));
+  __m128i q0_8x16b = _mm_loadu_si128((__m128i *) pi2_q);
+  __m128i q1_8x16b = _mm_loadu_si128((__m128i *) (pi2_q + 8));
+  __m128i d0_8x16b = _mm_abs_epi16(_mm_subs_epi16(p0_8x16b, q0_8x16b));
+  __m128i d1_8x16b = _mm_abs_epi16(_mm_subs_epi16(p1_8x16b, q1_8x16b));
+
+  /* Unsigned d >= limit */
+  d0_8x16b = _mm_cmpeq_epi16(_mm_max_epu16(d0_8x16b, limit_8x16b), d0_8x16b);
+  d1_8x16b = _mm_cmpeq_epi16(_mm_max_epu16(d1_8x16b, limit_8x16b), d1_8x16b);
+
+  return _mm_packs_epi16(d0_8x16b, d1_8x16b);
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264d_compute_bs1_edges                                 */
+/*                                                                           */
+/*  Description   : Evaluates the Bs = 1 condition for the 16 edges of one   */
+/*                  direction and merges it into the four BS words of that   */
+/*                  direction, only for the edges whose Bs is not set yet    */
+/*                                                                           */
+/*  Inputs        : ps_blk         - block data in edge order                */
+/*                  pu4_bs         - four BS words of one direction          */
+/*                  i4_ver_mvlimit - vertical MV limit                       */
+/*                  u4_is_b        - B slice                                 */
+/*                                                                           */
+/*****************************************************************************/
+static void ih264d_compute_bs1_edges(bs_blk_data_t *ps_blk, UWORD32 *pu4_bs,
+                                     WORD32 i4_ver_mvlimit, UWORD32 u4_is_b) {
+  __m128i hor_lim_8x16b = _mm_set1_epi16(4);
+  __m128i ver_lim_8x16b = _mm_set1_epi16((WORD16) i4_ver_mvlimit);
+  __m128i bs_16x8b, bs_old_16x8b, zero_16x8b;
+  /* Edge k has its Bs in byte (3 - (k & 3)) of word (k >> 2) */
+  __m128i reorder_16x8b =
+      _mm_set_epi8(12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3);
+  WORD16 **ppi2_p, **ppi2_q;
+  WORD16 *api2_p[4], *api2_q[4];
+  void **ppv_p0 = ps_blk->apv_addr[0], **ppv_q0 = ps_blk->apv_addr[0] + 4;
+  void **ppv_p1 = ps_blk->apv_addr[1], **ppv_q1 = ps_blk->apv_addr[1] + 4;
+  WORD32 i;
+
+  for (i = 0; i < 4; i++) {
+    api2_p[i] = ps_blk->ai2_mv[i];
+    api2_q[i] = ps_blk->ai2_mv[i] + 4;
+  }
+  ppi2_p = api2_p;
+  ppi2_q = api2_q;
+
+  /* Fwd-fwd, bwd-bwd */
+  bs_16x8b = _mm_or_si128(ih264d_ptr_neq_16x8b(ppv_p0, ppv_q0),
+                          ih264d_ptr_neq_16x8b(ppv_p1, ppv_q1));
+  bs_16x8b = _mm_or_si128(
+      bs_16x8b, ih264d_mv_diff_16x8b(ppi2_p[0], ppi2_q[0], hor_lim_8x16b));
+  bs_16x8b = _mm_or_si128(
+      bs_16x8b, ih264d_mv_diff_16x8b(ppi2_p[1], ppi2_q[1], ver_lim_8x16b));
+
+  if (u4_is_b) {
+    __m128i bs_x_16x8b;
+
+    bs_16x8b = _mm_or_si128(
+        bs_16x8b, ih264d_mv_diff_16x8b(ppi2_p[2], ppi2_q[2], hor_lim_8x16b));
+    bs_16x8b = _mm_or_si128(
+        bs_16x8b, ih264d_mv_diff_16x8b(ppi2_p[3], ppi2_q[3], ver_lim_8x16b));
+
+    /* Fwd-bwd, bwd-fwd */
+    bs_x_16x8b = _mm_or_si128(ih264d_ptr_neq_16x8b(ppv_p0, ppv_q1),
+                              ih264d_ptr_neq_16x8b(ppv_p1, ppv_q0));
+    bs_x_16x8b = _mm_or_si128(
+        bs_x_16x8b, ih264d_mv_diff_16x8b(ppi2_p[0], ppi2_q[2], hor_lim_8x16b));
+    bs_x_16x8b = _mm_or_si128(
+        bs_x_16x8b, ih264d_mv_diff_16x8b(ppi2_p[1], ppi2_q[3], ver_lim_8x16b));
+    bs_x_16x8b = _mm_or_si128(
+        bs_x_16x8b, ih264d_mv_diff_16x8b(ppi2_p[2], ppi2_q[0], hor_lim_8x16b));
+    bs_x_16x8b = _mm_or_si128(
+        bs_x_16x8b, ih264d_mv_diff_16x8b(ppi2_p[3], ppi2_q[1], ver_lim_8x16b));
+
+    bs_16x8b = _mm_and_si128(bs_16x8b, bs_x_16x8b);
+  }
+
+  bs_16x8b = _mm_shuffle_epi8(bs_16x8b, reorder_16x8b);
+  bs_16x8b = _mm_and_si128(bs_16x8b, _mm_set1_epi8(1));
+
+  /* Bs already set (2 or 4) is retained */
+  zero_16x8b = _mm_setzero_si128();
+  bs_old_16x8b = _mm_loadu_si128((__m128i *) pu4_bs);
+  bs_16x8b =
+      _mm_and_si128(bs_16x8b, _mm_cmpeq_epi8(bs_old_16x8b, zero_16x8b));
+  _mm_storeu_si128((__m128i *) pu4_bs, _mm_or_si128(bs_old_16x8b, bs_16x8b));
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264d_fill_bs1_non16x16mb_sse42                         */
+/*                                                                           */
+/*  Description   : Gathers MVs and reference addresses of the MB and its    */
+/*                  top and left neighbouring blocks, in raster and column   */
+/*                  major order, and computes the Bs = 1 condition of all    */
+/*                  32 edges                                                 */
+/*                                                                           */
+/*****************************************************************************/
+static void ih264d_fill_bs1_non16x16mb_sse42(
+    mv_pred_t *ps_cur_mv_pred, mv_pred_t *ps_top_mv_pred,
+    void **ppv_map_ref_idx_to_poc, UWORD32 *pu4_bs_table,
+    mv_pred_t *ps_leftmost_mv_pred, neighbouradd_t *ps_left_addr,
+    void **u4_pic_addrress, WORD32 i4_ver_mvlimit, UWORD32 u4_is_b) {
+  bs_blk_data_t s_horz, s_vert;
+  void **ppv_map_l0 = ppv_map_ref_idx_to_poc;
+  void **ppv_map_l1 = ppv_map_ref_idx_to_poc + POC_LIST_L0_TO_L1_DIFF;
+  UWORD32 u4_num_mv = u4_is_b ? 4 : 2;
+  UWORD32 i, j, k;
+
+  /* Neighbours across the MB edges, addresses are precomputed */
+  for (i = 0; i < 4; i++) {
+    mv_pred_t *ps_top = ps_top_mv_pred + i;
+    mv_pred_t *ps_left = ps_leftmost_mv_pred + (i << 2);
+
+    for (k = 0; k < u4_num_mv; k++) {
+      s_horz.ai2_mv[k][i] = ps_top->i2_mv[k];
+      s_vert.ai2_mv[k][i] = ps_left->i2_mv[k];
+    }
+    s_horz.apv_addr[0][i] = u4_pic_addrress[i & 2];
+    s_horz.apv_addr[1][i] = u4_pic_addrress[1 + (i & 2)];
+    s_vert.apv_addr[0][i] = ps_left_addr->u4_add[i & 2];
+    s_vert.apv_addr[1][i] = ps_left_addr->u4_add[1 + (i & 2)];
+  }
+
+  /* Current MB blocks */
+  for (i = 0; i < 4; i++) {
+    for (j = 0; j < 4; j++) {
+      mv_pred_t *ps_cur = ps_cur_mv_pred + (i << 2) + j;
+      UWORD32 u4_raster = 4 + (i << 2) + j;
+      UWORD32 u4_col = 4 + (j << 2) + i;
+      void *pv_addr0 = ppv_map_l0[ps_cur->i1_ref_frame[0]];
+      void *pv_addr1 = u4_is_b ? ppv_map_l1[ps_cur->i1_ref_frame[1]] : 0;
+
+      for (k = 0; k < u4_num_mv; k++) {
+        s_horz.ai2_mv[k][u4_raster] = ps_cur->i2_mv[k];
+        s_vert.ai2_mv[k][u4_col] = ps_cur->i2_mv[k];
+      }
+      s_horz.apv_addr[0][u4_raster] = pv_addr0;
+      s_horz.apv_addr[1][u4_raster] = pv_addr1;
+      s_vert.apv_addr[0][u4_col] = pv_addr0;
+      s_vert.apv_addr[1][u4_col] = pv_addr1;
+    }
+  }
+
+  ih264d_compute_bs1_edges(&s_horz, pu4_bs_table, i4_ver_mvlimit, u4_is_b);
+  ih264d_compute_bs1_edges(&s_vert, pu4_bs_table + 4, i4_ver_mvlimit, u4_is_b);
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264d_fill_bs1_non16x16mb_pslice_sse42                  */
+/*                                                                           */
+/*  Description   : SSE4.2 version of ih264d_fill_bs1_non16x16mb_pslice      */
+/*                                                                           */
+/*  Inputs        : Same as ih264d_fill_bs1_non16x16mb_pslice                */
+/*                                                                           */
+/*  Processing    : The MVs and reference picture addresses of both blocks   */
+/*                  of all 16 horz and 16 vert edges are gathered, and the   */
+/*                  Bs = 1 conditions are evaluated for 16 edges at a time   */
+/*                                                                           */
+/*  Outputs       : pu4_bs_table                                             */
+/*                                                                           */
+/*****************************************************************************/
+void ih264d_fill_bs1_non16x16mb_pslice_sse42(
+    mv_pred_t *ps_cur_mv_pred, mv_pred_t *ps_top_mv_pred,
+    void **ppv_map_ref_idx_to_poc, UWORD32 *pu4_bs_table,
+    mv_pred_t *ps_leftmost_mv_pred, neighbouradd_t *ps_left_addr,
+    void **u4_pic_addrress, WORD32 i4_ver_mvlimit) {
+  ih264d_fill_bs1_non16x16mb_sse42(
+      ps_cur_mv_pred, ps_top_mv_pred, ppv_map_ref_idx_to_poc, pu4_bs_table,
+      ps_leftmost_mv_pred, ps_left_addr, u4_pic_addrress, i4_ver_mvlimit, 0);
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264d_fill_bs1_non16x16mb_bslice_sse42                  */
+/*                                                                           */
+/*  Description   : SSE4.2 version of ih264d_fill_bs1_non16x16mb_bslice      */
+/*                                                                           */
+/*  Inputs        : Same as ih264d_fill_bs1_non16x16mb_bslice                */
+/*                                                                           */
+/*  Processing    : Same as the P slice version, the conditions are          */
+/*                  evaluated for both (fwd-fwd, bwd-bwd) and (fwd-bwd,      */
+/*                  bwd-fwd) pairings                                        */
+/*                                                                           */
+/*  Outputs       : pu4_bs_table                                             */
+/*                                                                           */
+/*****************************************************************************/
+void ih264d_fill_bs1_non16x16mb_bslice_sse42(
+    mv_pred_t *ps_cur_mv_pred, mv_pred_t *ps_top_mv_pred,
+    void **ppv_map_ref_idx_to_poc, UWORD32 *pu4_bs_table,
+    mv_pred_t *ps_leftmost_mv_pred, neighbouradd_t *ps_left_addr,
+    void **u4_pic_addrress, WORD32 i4_ver_mvlimit) {
+  ih264d_fill_bs1_non16x16mb_sse42(
+      ps_cur_mv_pred, ps_top_mv_pred, ppv_map_ref_idx_to_poc, pu4_bs_table,
+      ps_leftmost_mv_pred, ps_left_addr, u4_pic_addrress, i4_ver_mvlimit, 1);
+}
@@ -0,0 +1,917 @@
+/* Copyright (c) [2020]-[2023] Ittiam Systems Pvt. Ltd.
+   All rights reserved.
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted (subject to the limitations in the
+   disclaimer below) provided that the following conditions are met:
+   •    Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+   •    Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+   •    None of the names of Ittiam Systems Pvt. Ltd., its affiliates,
+   investors, business partners, nor the names of its contributors may be
+   used to endorse or promote products derived from this software without
+   specific prior written permission.
+
+   NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED
+   BY THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+   BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+   FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+   HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+   OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+   WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+   OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+   EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+   This Software is an implementation of the AVC/H.264
+   standard by Ittiam Systems Pvt. Ltd. (“Ittiam”).
+   Additional patent licenses may be required for this Software,
+   including, but not limited to, a license from MPEG LA’s AVC/H.264
+   licensing program (see https://www.mpegla.com/programs/avc-h-264/).
+
+   NOTWITHSTANDING ANYTHING TO THE CONTRARY, THIS DOES NOT GRANT ANY
+   EXPRESS OR IMPLIED LICENSES TO ANY PATENT CLAIMS OF ANY AFFILIATE
+   (TO THE EXTENT NOT IN THE LEGAL ENTITY), INVESTOR, OR OTHER
+   BUSINESS PARTNER OF ITTIAM. You may only use this software or
+   modifications thereto for purposes that are authorized by
+   appropriate patent licenses. You should seek legal advice based
+   upon your implementation details.
+
+---------------------------------------------------------------
+*/
+/*****************************************************************************/
+/*                                                                           */
+/*  File Name         : ih264d_deblk_row_sse42.c                             */
+/*                                                                           */
+/*  Description       : Contains function definitions for deblocking a run  */
+/*                      of MBs of a row in x86 sse4 intrinsics. The luma and */
+/*                      chroma of a MB are transposed once in registers for  */
+/*                      all the vertical edges, and the horizontal edges are */
+/*                      filtered on the rows before they are stored back     */
+/*                                                                           */
+/*  List of Functions : ih264d_deblk_row_nonmbaff_sse42()                    */
+/*                                                                           */
+/*  Issues / Problems : None                                                 */
+/*                                                                           */
+/*****************************************************************************/
+/*****************************************************************************/
+/* File Includes                                                             */
+/*****************************************************************************/
+
+#include <immintrin.h>
+#include "ih264_typedefs.h"
+#include "ih264_macros.h"
+#include "ih264_platform_macros.h"
+#include "ih264d_defs.h"
+#include "ih264d_structs.h"
+#include "ih264d_deblocking.h"
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264d_expand_bs_16x8b                                   */
+/*                                                                           */
+/*  Description   : Spreads a packed value with one byte per 4 pixel edge    */
+/*                  segment (segment 0 in the MSB) over the 16 pixels of the */
+/*                  edge. For interleaved chroma a segment is 2 Cb and 2 Cr  */
+/*                  pixels, which are 4 bytes as well                        */
+/*                                                                           */
+/*  Inputs        : u4_val - packed value                                    */
+/*                                                                           */
+/*  Returns       : One byte per pixel                                       */
+/*                                                                           */
+/*****************************************************************************/
+static __inline __m128i ih264d_expand_bs_16x8b(UWORD32 u4_val) {
+  const __m128i shuffle_16x8b =
+      _mm_setr_epi8(3, 3, 3, 3, 2, 2, 2, 2, 1, 1, 1, 1, 0, 0, 0, 0);
+
+  return _mm_shuffle_epi8(_mm_cvtsi32_si128((WORD32) u4_val), shuffle_16x8b);
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264d_pack_tc0                                          */
+/*                                                                           */
+/*  Description   : Looks up tc0 for the Bs of each edge segment             */
+/*                                                                           */
+/*  Inputs        : u4_bs       - packed Bs                                  */
+/*                  pu1_cliptab - tc0 table                                  */
+/*                                                                           */
+/*  Returns       : Packed tc0, in the same order as the Bs                  */
+/*                                                                           */
+/*****************************************************************************/
+static __inline UWORD32 ih264d_pack_tc0(UWORD32 u4_bs,
+                                        const UWORD8 *pu1_cliptab) {
+  UWORD32 u4_tc0 = 0;
+  WORD32 i;
+
+  for (i = 0; i < 32; i += 8)
+    u4_tc0 |= (UWORD32) pu1_cliptab[(u4_bs >> i) & 0xff] << i;
+
+  return u4_tc0;
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264d_transpose_16x16b                                  */
+/*                                                                           */
+/*  Description   : Transposes a 16x16 block of bytes                        */
+/*                                                                           */
+/*  Inputs        : pi_src - 16 rows                                         */
+/*                                                                           */
+/*  Outputs       : pi_dst - 16 columns                                      */
+/*                                                                           */
+/*****************************************************************************/
+static __inline void ih264d_transpose_16x16b(__m128i *pi_src,
+                                             __m128i *pi_dst) {
+  __m128i ai_a[16], ai_b[16], ai_c[16];
+  WORD32 i;
+
+  /* ai_a[i] and ai_a[i + 8]: columns 0-7 and 8-15 of rows 2i, 2i + 1 */
+  for (i = 0; i < 8; i++) {
+    ai_a[i] = _mm_unpacklo_epi8(pi_src[2 * i], pi_src[2 * i + 1]);
+    ai_a[i + 8] = _mm_unpackhi_epi8(pi_src[2 * i], pi_src[2 * i + 1]);
+  }
+
+  /* ai_b[4q + j]: columns 4q to 4q + 3 of rows 4j to 4j + 3 */
+  for (i = 0; i < 4; i++) {
+    ai_b[i] = _mm_unpacklo_epi16(ai_a[2 * i], ai_a[2 * i + 1]);
+    ai_b[i + 4] = _mm_unpackhi_epi16(ai_a[2 * i], ai_a[2 * i + 1]);
+    ai_b[i + 8] = _mm_unpacklo_epi16(ai_a[2 * i + 8], ai_a[2 * i + 9]);
+    ai_b[i + 12] = _mm_unpackhi_epi16(ai_a[2 * i + 8], ai_a[2 * i + 9]);
+  }
+
+  /* Pairs of columns of rows 0-7 and 8-15 */
+  for (i = 0; i < 16; i += 4) {
+    ai_c[i] = _mm_unpacklo_epi32(ai_b[i], ai_b[i + 1]);
+    ai_c[i + 1] = _mm_unpackhi_epi32(ai_b[i], ai_b[i + 1]);
+    ai_c[i + 2] = _mm_unpacklo_epi32(ai_b[i + 2], ai_b[i + 3]);
+    ai_c[i + 3] = _mm_unpackhi_epi32(ai_b[i + 2], ai_b[i + 3]);
+  }
+
+  for (i = 0; i < 16; i += 4) {
+    pi_dst[i] = _mm_unpacklo_epi64(ai_c[i], ai_c[i + 2]);
+    pi_dst[i + 1] = _mm_unpackhi_epi64(ai_c[i], ai_c[i + 2]);
+    pi_dst[i + 2] = _mm_unpacklo_epi64(ai_c[i + 1], ai_c[i + 3]);
+    pi_dst[i + 3] = _mm_unpackhi_epi64(ai_c[i + 1], ai_c[i + 3]);
+  }
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264d_transpose_8x8w                                    */
+/*                                                                           */
+/*  Description   : Transposes a 8x8 block of 16 bit words, which are the    */
+/*                  Cb Cr pairs of interleaved chroma                        */
+/*                                                                           */
+/*  Inputs        : pi_src - 8 rows                                          */
+/*                                                                           */
+/*  Outputs       : pi_dst - 8 columns                                       */
+/*                                                                           */
+/*****************************************************************************/
+static __inline void ih264d_transpose_8x8w(__m128i *pi_src, __m128i *pi_dst) {
+  __m128i ai_a[8], ai_b[8];
+  WORD32 i;
+
+  /* ai_a[i] and ai_a[i + 4]: columns 0-3 and 4-7 of rows 2i, 2i + 1 */
+  for (i = 0; i < 4; i++) {
+    ai_a[i] = _mm_unpacklo_epi16(pi_src[2 * i], pi_src[2 * i + 1]);
+    ai_a[i + 4] = _mm_unpackhi_epi16(pi_src[2 * i], pi_src[2 * i + 1]);
+  }
+
+  /* Pairs of columns of rows 0-3 and 4-7 */
+  for (i = 0; i < 8; i += 4) {
+    ai_b[i] = _mm_unpacklo_epi32(ai_a[i], ai_a[i + 1]);
+    ai_b[i + 1] = _mm_unpackhi_epi32(ai_a[i], ai_a[i + 1]);
+    ai_b[i + 2] = _mm_unpacklo_epi32(ai_a[i + 2], ai_a[i + 3]);
+    ai_b[i + 3] = _mm_unpackhi_epi32(ai_a[i + 2], ai_a[i + 3]);
+  }
+
+  for (i = 0; i < 8; i += 4) {
+    pi_dst[i] = _mm_unpacklo_epi64(ai_b[i], ai_b[i + 2]);
+    pi_dst[i + 1] = _mm_unpackhi_epi64(ai_b[i], ai_b[i + 2]);
+    pi_dst[i + 2] = _mm_unpacklo_epi64(ai_b[i + 1], ai_b[i + 3]);
+    pi_dst[i + 3] = _mm_unpackhi_epi64(ai_b[i + 1], ai_b[i + 3]);
+  }
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264d_load_luma_cols_4x16b                              */
+/*                                                                           */
+/*  Description   : Loads 4 columns of 16 luma rows as 4 vectors             */
+/*                                                                           */
+/*  Inputs        : pu1_src  - first column of the first row                 */
+/*                  src_strd - stride                                        */
+/*                                                                           */
+/*  Outputs       : pi_col   - 4 columns                                     */
+/*                                                                           */
+/*****************************************************************************/
+static __inline void ih264d_load_luma_cols_4x16b(UWORD8 *pu1_src,
+                                                 WORD32 src_strd,
+                                                 __m128i *pi_col) {
+  /* Transposes the 4x4 block of bytes in each dword */
+  const __m128i shuffle_16x8b =
+      _mm_setr_epi8(0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15);
+  __m128i ai_x[4], t0, t1, t2, t3;
+  WORD32 i;
+
+  for (i = 0; i < 4; i++, pu1_src += 4 * src_strd) {
+    ai_x[i] = _mm_setr_epi32(*(WORD32 *) pu1_src,
+                             *(WORD32 *) (pu1_src + src_strd),
+                             *(WORD32 *) (pu1_src + 2 * src_strd),
+                             *(WORD32 *) (pu1_src + 3 * src_strd));
+    ai_x[i] = _mm_shuffle_epi8(ai_x[i], shuffle_16x8b);
+  }
+
+  t0 = _mm_unpacklo_epi32(ai_x[0], ai_x[1]);
+  t1 = _mm_unpacklo_epi32(ai_x[2], ai_x[3]);
+  t2 = _mm_unpackhi_epi32(ai_x[0], ai_x[1]);
+  t3 = _mm_unpackhi_epi32(ai_x[2], ai_x[3]);
+  pi_col[0] = _mm_unpacklo_epi64(t0, t1);
+  pi_col[1] = _mm_unpackhi_epi64(t0, t1);
+  pi_col[2] = _mm_unpacklo_epi64(t2, t3);
+  pi_col[3] = _mm_unpackhi_epi64(t2, t3);
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264d_store_luma_cols_4x16b                             */
+/*                                                                           */
+/*  Description   : Stores 4 columns of 16 luma rows from 4 vectors          */
+/*                                                                           */
+/*  Inputs        : pi_col   - 4 columns                                     */
+/*                  pu1_dst  - first column of the first row                 */
+/*                  dst_strd - stride                                        */
+/*                                                                           */
+/*****************************************************************************/
+static __inline void ih264d_store_luma_cols_4x16b(__m128i *pi_col,
+                                                  UWORD8 *pu1_dst,
+                                                  WORD32 dst_strd) {
+  const __m128i shuffle_16x8b =
+      _mm_setr_epi8(0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15);
+  __m128i ai_x[4], t0, t1, t2, t3;
+  WORD32 i;
+
+  t0 = _mm_unpacklo_epi32(pi_col[0], pi_col[1]);
+  t1 = _mm_unpacklo_epi32(pi_col[2], pi_col[3]);
+  t2 = _mm_unpackhi_epi32(pi_col[0], pi_col[1]);
+  t3 = _mm_unpackhi_epi32(pi_col[2], pi_col[3]);
+  ai_x[0] = _mm_unpacklo_epi64(t0, t1);
+  ai_x[1] = _mm_unpackhi_epi64(t0, t1);
+  ai_x[2] = _mm_unpacklo_epi64(t2, t3);
+  ai_x[3] = _mm_unpackhi_epi64(t2, t3);
+
+  for (i = 0; i < 4; i++, pu1_dst += 4 * dst_strd) {
+    ai_x[i] = _mm_shuffle_epi8(ai_x[i], shuffle_16x8b);
+    *(WORD32 *) pu1_dst = _mm_extract_epi32(ai_x[i], 0);
+    *(WORD32 *) (pu1_dst + dst_strd) = _mm_extract_epi32(ai_x[i], 1);
+    *(WORD32 *) (pu1_dst + 2 * dst_strd) = _mm_extract_epi32(ai_x[i], 2);
+    *(WORD32 *) (pu1_dst + 3 * dst_strd) = _mm_extract_epi32(ai_x[i], 3);
+  }
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264d_load_chroma_cols_2x8w                             */
+/*                                                                           */
+/*  Description   : Loads 2 Cb Cr columns of 8 interleaved chroma rows as    */
+/*                  2 vectors                                                */
+/*                                                                           */
+/*  Inputs        : pu1_src  - first column of the first row                 */
+/*                  src_strd - stride                                        */
+/*                                                                           */
+/*  Outputs       : pi_col   - 2 columns                                     */
+/*                                                                           */
+/*****************************************************************************/
+static __inline void ih264d_load_chroma_cols_2x8w(UWORD8 *pu1_src,
+                                                  WORD32 src_strd,
+                                                  __m128i *pi_col) {
+  /* Even words to the low half and odd words to the high half */
+  const __m128i shuffle_16x8b =
+      _mm_setr_epi8(0, 1, 4, 5, 8, 9, 12, 13, 2, 3, 6, 7, 10, 11, 14, 15);
+  __m128i x0, x1;
+
+  x0 = _mm_setr_epi32(*(WORD32 *) pu1_src, *(WORD32 *) (pu1_src + src_strd),
+                      *(WORD32 *) (pu1_src + 2 * src_strd),
+                      *(WORD32 *) (pu1_src + 3 * src_strd));
+  pu1_src += 4 * src_strd;
+  x1 = _mm_setr_epi32(*(WORD32 *) pu1_src, *(WORD32 *) (pu1_src + src_strd),
+                      *(WORD32 *) (pu1_src + 2 * src_strd),
+                      *(WORD32 *) (pu1_src + 3 * src_strd));
+  x0 = _mm_shuffle_epi8(x0, shuffle_16x8b);
+  x1 = _mm_shuffle_epi8(x1, shuffle_16x8b);
+  pi_col[0] = _mm_unpacklo_epi64(x0, x1);
+  pi_col[1] = _mm_unpackhi_epi64(x0, x1);
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264d_store_chroma_cols_2x8w                            */
+/*                                                                           */
+/*  Description   : Stores 2 Cb Cr columns of 8 interleaved chroma rows from */
+/*                  2 vectors                                                */
+/*                                                                           */
+/*  Inputs        : pi_col   - 2 columns                                     */
+/*                  pu1_dst  - first column of the first row                 */
+/*                  dst_strd - stride                                        */
+/*                                                                           */
+/*****************************************************************************/
+static __inline void ih264d_store_chroma_cols_2x8w(__m128i *pi_col,
+                                                   UWORD8 *pu1_dst,
+                                                   WORD32 dst_strd) {
+  /* Inverse of the shuffle in ih264d_load_chroma_cols_2x8w */
+  const __m128i shuffle_16x8b =
+      _mm_setr_epi8(0, 1, 8, 9, 2, 3, 10, 11, 4, 5, 12, 13, 6, 7, 14, 15);
+  __m128i x0, x1;
+
+  x0 = _mm_shuffle_epi8(_mm_unpacklo_epi64(pi_col[0], pi_col[1]),
+                        shuffle_16x8b);
+  x1 = _mm_shuffle_epi8(_mm_unpackhi_epi64(pi_col[0], pi_col[1]),
+                        shuffle_16x8b);
+
+  *(WORD32 *) pu1_dst = _mm_extract_epi32(x0, 0);
+  *(WORD32 *) (pu1_dst + dst_strd) = _mm_extract_epi32(x0, 1);
+  *(WORD32 *) (pu1_dst + 2 * dst_strd) = _mm_extract_epi32(x0, 2);
+  *(WORD32 *) (pu1_dst + 3 * dst_strd) = _mm_extract_epi32(x0, 3);
+  pu1_dst += 4 * dst_strd;
+  *(WORD32 *) pu1_dst = _mm_extract_epi32(x1, 0);
+  *(WORD32 *) (pu1_dst + dst_strd) = _mm_extract_epi32(x1, 1);
+  *(WORD32 *) (pu1_dst + 2 * dst_strd) = _mm_extract_epi32(x1, 2);
+  *(WORD32 *) (pu1_dst + 3 * dst_strd) = _mm_extract_epi32(x1, 3);
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264d_luma_bs4_8x16b                                    */
+/*                                                                           */
+/*  Description   : Filters 8 pixels of a luma edge with Bs equal to 4, as   */
+/*                  described in Sec. 8.7.2.4 of ITU T Rec H.264             */
+/*                                                                           */
+/*  Inputs        : pi_x        - p3 to q3, 16 bit                           */
+/*                  alpha_8x16b - alpha                                      */
+/*                  beta_8x16b  - beta                                       */
+/*                                                                           */
+/*  Outputs       : pi_x        - filtered p2 to q2                          */
+/*                                                                           */
+/*****************************************************************************/
+static __inline void ih264d_luma_bs4_8x16b(__m128i *pi_x, __m128i alpha_8x16b,
+                                           __m128i beta_8x16b) {
+  const __m128i two_8x16b = _mm_set1_epi16(2);
+  const __m128i four_8x16b = _mm_set1_epi16(4);
+  __m128i p3 = pi_x[0], p2 = pi_x[1], p1 = pi_x[2], p0 = pi_x[3];
+  __m128i q0 = pi_x[4], q1 = pi_x[5], q2 = pi_x[6], q3 = pi_x[7];
+  __m128i ad_p0q0, filt, strong, flag_p, flag_q;
+  __m128i p0q0, sum, strong_val, weak_val;
+
+  ad_p0q0 = _mm_abs_epi16(_mm_sub_epi16(p0, q0));
+  filt = _mm_cmplt_epi16(ad_p0q0, alpha_8x16b);
+  filt = _mm_and_si128(
+      filt, _mm_cmplt_epi16(_mm_abs_epi16(_mm_sub_epi16(p1, p0)), beta_8x16b));
+  filt = _mm_and_si128(
+      filt, _mm_cmplt_epi16(_mm_abs_epi16(_mm_sub_epi16(q1, q0)), beta_8x16b));
+  strong = _mm_and_si128(
+      filt, _mm_cmplt_epi16(ad_p0q0, _mm_add_epi16(_mm_srli_epi16(alpha_8x16b, 2),
+                                                   two_8x16b)));
+  flag_p = _mm_and_si128(
+      strong,
+      _mm_cmplt_epi16(_mm_abs_epi16(_mm_sub_epi16(p2, p0)), beta_8x16b));
+  flag_q = _mm_and_si128(
+      strong,
+      _mm_cmplt_epi16(_mm_abs_epi16(_mm_sub_epi16(q2, q0)), beta_8x16b));
+
+  p0q0 = _mm_add_epi16(p0, q0);
+
+  /* p0' */
+  sum = _mm_add_epi16(_mm_add_epi16(p1, p0q0), _mm_add_epi16(p1, p0q0));
+  strong_val = _mm_srli_epi16(
+      _mm_add_epi16(_mm_add_epi16(sum, p2), _mm_add_epi16(q1, four_8x16b)), 3);
+  weak_val = _mm_srli_epi16(
+      _mm_add_epi16(_mm_add_epi16(_mm_slli_epi16(p1, 1), p0),
+                    _mm_add_epi16(q1, two_8x16b)),
+      2);
+  pi_x[3] = _mm_blendv_epi8(_mm_blendv_epi8(p0, weak_val, filt), strong_val,
+                            flag_p);
+  /* p1' */
+  sum = _mm_add_epi16(_mm_add_epi16(p2, p1), p0q0);
+  strong_val = _mm_srli_epi16(_mm_add_epi16(sum, two_8x16b), 2);
+  pi_x[2] = _mm_blendv_epi8(p1, strong_val, flag_p);
+  /* p2' */
+  strong_val = _mm_add_epi16(_mm_slli_epi16(_mm_add_epi16(p3, p2), 1),
+                             _mm_add_epi16(sum, four_8x16b));
+  pi_x[1] = _mm_blendv_epi8(p2, _mm_srli_epi16(strong_val, 3), flag_p);
+
+  /* q0' */
+  sum = _mm_add_epi16(_mm_add_epi16(q1, p0q0), _mm_add_epi16(q1, p0q0));
+  strong_val = _mm_srli_epi16(
+      _mm_add_epi16(_mm_add_epi16(sum, q2), _mm_add_epi16(p1, four_8x16b)), 3);
+  weak_val = _mm_srli_epi16(
+      _mm_add_epi16(_mm_add_epi16(_mm_slli_epi16(q1, 1), q0),
+                    _mm_add_epi16(p1, two_8x16b)),
+      2);
+  pi_x[4] = _mm_blendv_epi8(_mm_blendv_epi8(q0, weak_val, filt), strong_val,
+                            flag_q);
+  /* q1' */
+  sum = _mm_add_epi16(_mm_add_epi16(q2, q1), p0q0);
+  strong_val = _mm_srli_epi16(_mm_add_epi16(sum, two_8x16b), 2);
+  pi_x[5] = _mm_blendv_epi8(q1, strong_val, flag_q);
+  /* q2' */
+  strong_val = _mm_add_epi16(_mm_slli_epi16(_mm_add_epi16(q3, q2), 1),
+                             _mm_add_epi16(sum, four_8x16b));
+  pi_x[6] = _mm_blendv_epi8(q2, _mm_srli_epi16(strong_val, 3), flag_q);
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264d_lt_16x8b                                          */
+/*                                                                           */
+/*  Description   : Compares the absolute difference of 16 pixel pairs with  */
+/*                  a threshold                                              */
+/*                                                                           */
+/*  Inputs        : a_16x8b, b_16x8b - pixels                                */
+/*                  thr_16x8b        - threshold                             */
+/*                                                                           */
+/*  Returns       : Byte mask, 0xff if ABS(a - b) < threshold                */
+/*                                                                           */
+/*****************************************************************************/
+static __inline __m128i ih264d_lt_16x8b(__m128i a_16x8b, __m128i b_16x8b,
+                                        __m128i thr_16x8b) {
+  __m128i ad_16x8b = _mm_or_si128(_mm_subs_epu8(a_16x8b, b_16x8b),
+                                  _mm_subs_epu8(b_16x8b, a_16x8b));
+
+  return _mm_xor_si128(_mm_cmpeq_epi8(_mm_subs_epu8(thr_16x8b, ad_16x8b),
+                                      _mm_setzero_si128()),
+                       _mm_set1_epi8(-1));
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264d_filter_p0q0_16x8b                                 */
+/*                                                                           */
+/*  Description   : Filters p0 and q0 of an edge with Bs less than 4,        */
+/*                  p0 + delta and q0 - delta where delta is                 */
+/*                  CLIP3(-tc, tc, ((q0 - p0) * 4 + p1 - q1 + 4) >> 3)        */
+/*                                                                           */
+/*  Inputs        : pi_p0, pi_q0 - p0 and q0                                 */
+/*                  p1, q1       - p1 and q1                                 */
+/*                  tc_16x8b     - tc, zero for pixels not to be filtered    */
+/*                                                                           */
+/*  Outputs       : pi_p0, pi_q0 - filtered p0 and q0                        */
+/*                                                                           */
+/*  Issues        : delta is computed in 8 bits as averages biased by 161    */
+/*                                                                           */
+/*****************************************************************************/
+static __inline void ih264d_filter_p0q0_16x8b(__m128i *pi_p0, __m128i *pi_q0,
+                                              __m128i p1, __m128i q1,
+                                              __m128i tc_16x8b) {
+  const __m128i ones_16x8b = _mm_set1_epi8(-1);
+  const __m128i bias_16x8b = _mm_set1_epi8((WORD8) 0xa1);
+  __m128i p0 = *pi_p0, q0 = *pi_q0;
+  __m128i odd, d, d_q0p0, neg, pos;
+
+  odd = _mm_and_si128(_mm_xor_si128(p0, q0), _mm_set1_epi8(1));
+  /* (p1 - q1 + 256) >> 1, then ((p1 - q1) >> 2) + 66 */
+  d = _mm_avg_epu8(_mm_xor_si128(q1, ones_16x8b), p1);
+  d = _mm_avg_epu8(d, _mm_set1_epi8(3));
+  /* (q0 - p0 + 256) >> 1 */
+  d_q0p0 = _mm_avg_epu8(_mm_xor_si128(p0, ones_16x8b), q0);
+  d = _mm_adds_epu8(_mm_avg_epu8(d, odd), d_q0p0);
+
+  neg = _mm_min_epu8(_mm_subs_epu8(bias_16x8b, d), tc_16x8b);
+  pos = _mm_min_epu8(_mm_subs_epu8(d, bias_16x8b), tc_16x8b);
+
+  *pi_p0 = _mm_adds_epu8(_mm_subs_epu8(p0, neg), pos);
+  *pi_q0 = _mm_adds_epu8(_mm_subs_epu8(q0, pos), neg);
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264d_filter_p1_16x8b                                   */
+/*                                                                           */
+/*  Description   : Filters p1 (or q1) of a luma edge with Bs less than 4,   */
+/*                  CLIP3(p1 - tc0, p1 + tc0, (p2 + ((p0 + q0 + 1) >> 1)) >> 1)*/
+/*                                                                           */
+/*  Inputs        : p2, p1        - p2 and p1                                */
+/*                  avg_16x8b     - (p0 + q0 + 1) >> 1                       */
+/*                  tc0_16x8b     - tc0, zero for pixels not to be filtered  */
+/*                                                                           */
+/*  Returns       : Filtered p1                                              */
+/*                                                                           */
+/*****************************************************************************/
+static __inline __m128i ih264d_filter_p1_16x8b(__m128i p2, __m128i p1,
+                                               __m128i avg_16x8b,
+                                               __m128i tc0_16x8b) {
+  __m128i odd = _mm_and_si128(_mm_xor_si128(p2, avg_16x8b), _mm_set1_epi8(1));
+  __m128i val = _mm_subs_epu8(_mm_avg_epu8(p2, avg_16x8b), odd);
+
+  val = _mm_max_epu8(val, _mm_subs_epu8(p1, tc0_16x8b));
+  return _mm_min_epu8(val, _mm_adds_epu8(p1, tc0_16x8b));
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264d_luma_bslt4_16x8b                                  */
+/*                                                                           */
+/*  Description   : Filters a 16 pixel luma edge with Bs less than 4, as     */
+/*                  described in Sec. 8.7.2.3 of ITU T Rec H.264             */
+/*                                                                           */
+/*  Inputs        : pi_pix    - p3 to q3                                     */
+/*                  alpha     - alpha                                        */
+/*                  beta      - beta                                         */
+/*                  tc0_16x8b - tc0 of each pixel                            */
+/*                  bs_16x8b  - mask of the pixels with non zero Bs          */
+/*                                                                           */
+/*  Outputs       : pi_pix    - filtered p1 to q1                            */
+/*                                                                           */
+/*****************************************************************************/
+static __inline void ih264d_luma_bslt4_16x8b(__m128i *pi_pix,
+                                             __m128i alpha_16x8b,
+                                             __m128i beta_16x8b,
+                                             __m128i tc0_16x8b,
+                                             __m128i bs_16x8b) {
+  __m128i p2 = pi_pix[1], p1 = pi_pix[2], p0 = pi_pix[3];
+  __m128i q0 = pi_pix[4], q1 = pi_pix[5], q2 = pi_pix[6];
+  __m128i filt, flag_p, flag_q, tc, avg;
+
+  filt = _mm_and_si128(bs_16x8b, ih264d_lt_16x8b(p0, q0, alpha_16x8b));
+  filt = _mm_and_si128(filt, ih264d_lt_16x8b(p1, p0, beta_16x8b));
+  filt = _mm_and_si128(filt, ih264d_lt_16x8b(q1, q0, beta_16x8b));
+  flag_p = _mm_and_si128(filt, ih264d_lt_16x8b(p2, p0, beta_16x8b));
+  flag_q = _mm_and_si128(filt, ih264d_lt_16x8b(q2, q0, beta_16x8b));
+
+  /* tc, the flags are -1 when set */
+  tc0_16x8b = _mm_and_si128(tc0_16x8b, filt);
+  tc = _mm_sub_epi8(_mm_sub_epi8(tc0_16x8b, flag_p), flag_q);
+
+  avg = _mm_avg_epu8(p0, q0);
+  pi_pix[2] =
+      ih264d_filter_p1_16x8b(p2, p1, avg, _mm_and_si128(tc0_16x8b, flag_p));
+  pi_pix[5] =
+      ih264d_filter_p1_16x8b(q2, q1, avg, _mm_and_si128(tc0_16x8b, flag_q));
+
+  ih264d_filter_p0q0_16x8b(&pi_pix[3], &pi_pix[4], p1, q1, tc);
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264d_chroma_bs4_16x8b                                  */
+/*                                                                           */
+/*  Description   : Filters an interleaved chroma edge of 8 Cb and 8 Cr      */
+/*                  pixels with Bs equal to 4, as described in Sec. 8.7.2.4  */
+/*                  of ITU T Rec H.264. (2 * p1 + p0 + q1 + 2) >> 2 is       */
+/*                  computed as the average of p1 and (p0 + q1) >> 1         */
+/*                                                                           */
+/*  Inputs        : pi_pix      - p1 to q1                                   */
+/*                  alpha_16x8b - alpha of Cb and Cr in alternate lanes      */
+/*                  beta_16x8b  - beta of Cb and Cr in alternate lanes       */
+/*                                                                           */
+/*  Outputs       : pi_pix      - filtered p0 and q0                         */
+/*                                                                           */
+/*****************************************************************************/
+static __inline void ih264d_chroma_bs4_16x8b(__m128i *pi_pix,
+                                             __m128i alpha_16x8b,
+                                             __m128i beta_16x8b) {
+  const __m128i one_16x8b = _mm_set1_epi8(1);
+  __m128i p1 = pi_pix[0], p0 = pi_pix[1], q0 = pi_pix[2], q1 = pi_pix[3];
+  __m128i filt, val;
+
+  filt = ih264d_lt_16x8b(p0, q0, alpha_16x8b);
+  filt = _mm_and_si128(filt, ih264d_lt_16x8b(p1, p0, beta_16x8b));
+  filt = _mm_and_si128(filt, ih264d_lt_16x8b(q1, q0, beta_16x8b));
+
+  /* p0' */
+  val = _mm_subs_epu8(_mm_avg_epu8(p0, q1),
+                      _mm_and_si128(_mm_xor_si128(p0, q1), one_16x8b));
+  pi_pix[1] = _mm_blendv_epi8(p0, _mm_avg_epu8(val, p1), filt);
+  /* q0' */
+  val = _mm_subs_epu8(_mm_avg_epu8(q0, p1),
+                      _mm_and_si128(_mm_xor_si128(q0, p1), one_16x8b));
+  pi_pix[2] = _mm_blendv_epi8(q0, _mm_avg_epu8(val, q1), filt);
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264d_chroma_bslt4_16x8b                                */
+/*                                                                           */
+/*  Description   : Filters an interleaved chroma edge of 8 Cb and 8 Cr      */
+/*                  pixels with Bs less than 4, as described in Sec. 8.7.2.3 */
+/*                  of ITU T Rec H.264                                       */
+/*                                                                           */
+/*  Inputs        : pi_pix      - p1 to q1                                   */
+/*                  alpha_16x8b - alpha of Cb and Cr in alternate lanes      */
+/*                  beta_16x8b  - beta of Cb and Cr in alternate lanes       */
+/*                  tc0_16x8b   - tc0 of each pixel                          */
+/*                  bs_16x8b    - mask of the pixels with non zero Bs        */
+/*                                                                           */
+/*  Outputs       : pi_pix      - filtered p0 and q0                         */
+/*                                                                           */
+/*****************************************************************************/
+static __inline void ih264d_chroma_bslt4_16x8b(__m128i *pi_pix,
+                                               __m128i alpha_16x8b,
+                                               __m128i beta_16x8b,
+                                               __m128i tc0_16x8b,
+                                               __m128i bs_16x8b) {
+  __m128i p1 = pi_pix[0], p0 = pi_pix[1], q0 = pi_pix[2], q1 = pi_pix[3];
+  __m128i filt, tc;
+
+  filt = _mm_and_si128(bs_16x8b, ih264d_lt_16x8b(p0, q0, alpha_16x8b));
+  filt = _mm_and_si128(filt, ih264d_lt_16x8b(p1, p0, beta_16x8b));
+  filt = _mm_and_si128(filt, ih264d_lt_16x8b(q1, q0, beta_16x8b));
+
+  tc = _mm_and_si128(_mm_add_epi8(tc0_16x8b, _mm_set1_epi8(1)), filt);
+
+  ih264d_filter_p0q0_16x8b(&pi_pix[1], &pi_pix[2], p1, q1, tc);
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264d_deblk_luma_edge_16x8b                             */
+/*                                                                           */
+/*  Description   : Filters a 16 pixel luma edge held in registers. Bs less  */
+/*                  than 4 is filtered in 8 bits and Bs equal to 4 in 16     */
+/*                  bits                                                     */
+/*                                                                           */
+/*  Inputs        : pi_pix      - p3 to q3, each one vector of 16 pixels     */
+/*                  alpha       - alpha                                      */
+/*                  beta        - beta                                       */
+/*                  u4_bs       - packed Bs                                  */
+/*                  u4_bs4      - edge is filtered with Bs equal to 4        */
+/*                  pu1_cliptab - tc0 table                                  */
+/*                                                                           */
+/*  Outputs       : pi_pix      - filtered pixels                            */
+/*                                                                           */
+/*****************************************************************************/
+static __inline void ih264d_deblk_luma_edge_16x8b(__m128i *pi_pix,
+                                                  WORD32 alpha, WORD32 beta,
+                                                  UWORD32 u4_bs,
+                                                  UWORD32 u4_bs4,
+                                                  const UWORD8 *pu1_cliptab) {
+  const __m128i zero_16x8b = _mm_setzero_si128();
+
+  if (u4_bs4) {
+    __m128i alpha_8x16b = _mm_set1_epi16(alpha);
+    __m128i beta_8x16b = _mm_set1_epi16(beta);
+    __m128i ai_lo[8], ai_hi[8];
+    WORD32 i;
+
+    for (i = 0; i < 8; i++) {
+      ai_lo[i] = _mm_cvtepu8_epi16(pi_pix[i]);
+      ai_hi[i] = _mm_unpackhi_epi8(pi_pix[i], zero_16x8b);
+    }
+
+    ih264d_luma_bs4_8x16b(ai_lo, alpha_8x16b, beta_8x16b);
+    ih264d_luma_bs4_8x16b(ai_hi, alpha_8x16b, beta_8x16b);
+
+    for (i = 1; i < 7; i++) pi_pix[i] = _mm_packus_epi16(ai_lo[i], ai_hi[i]);
+  } else {
+    __m128i bs_16x8b = ih264d_expand_bs_16x8b(u4_bs);
+    __m128i tc0_16x8b =
+        ih264d_expand_bs_16x8b(ih264d_pack_tc0(u4_bs, pu1_cliptab));
+
+    ih264d_luma_bslt4_16x8b(pi_pix, _mm_set1_epi8(alpha), _mm_set1_epi8(beta),
+                            tc0_16x8b, _mm_cmpgt_epi8(bs_16x8b, zero_16x8b));
+  }
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264d_deblk_chroma_edge_16x8b                           */
+/*                                                                           */
+/*  Description   : Filters an interleaved chroma edge of 8 Cb and 8 Cr      */
+/*                  pixels held in registers                                 */
+/*                                                                           */
+/*  Inputs        : pi_pix       - p1 to q1, each one vector of 16 pixels    */
+/*                  pu1_alpha    - alpha of Y, Cb and Cr                     */
+/*                  pu1_beta     - beta of Y, Cb and Cr                      */
+/*                  u4_bs        - packed Bs                                 */
+/*                  u4_bs4       - edge is filtered with Bs equal to 4       */
+/*                  ppu1_cliptab - tc0 table of Y, Cb and Cr                 */
+/*                                                                           */
+/*  Outputs       : pi_pix       - filtered pixels                           */
+/*                                                                           */
+/*****************************************************************************/
+static __inline void ih264d_deblk_chroma_edge_16x8b(
+    __m128i *pi_pix, UWORD8 *pu1_alpha, UWORD8 *pu1_beta, UWORD32 u4_bs,
+    UWORD32 u4_bs4, const UWORD8 **ppu1_cliptab) {
+  __m128i alpha_16x8b = _mm_set1_epi16((pu1_alpha[2] << 8) | pu1_alpha[1]);
+  __m128i beta_16x8b = _mm_set1_epi16((pu1_beta[2] << 8) | pu1_beta[1]);
+
+  if (u4_bs4) {
+    ih264d_chroma_bs4_16x8b(pi_pix, alpha_16x8b, beta_16x8b);
+  } else {
+    __m128i bs_16x8b = ih264d_expand_bs_16x8b(u4_bs);
+    __m128i tc0_cb_16x8b =
+        ih264d_expand_bs_16x8b(ih264d_pack_tc0(u4_bs, ppu1_cliptab[1]));
+    __m128i tc0_cr_16x8b =
+        ih264d_expand_bs_16x8b(ih264d_pack_tc0(u4_bs, ppu1_cliptab[2]));
+    __m128i tc0_16x8b = _mm_blendv_epi8(tc0_cb_16x8b, tc0_cr_16x8b,
+                                        _mm_set1_epi16((WORD16) 0xff00));
+
+    ih264d_chroma_bslt4_16x8b(
+        pi_pix, alpha_16x8b, beta_16x8b, tc0_16x8b,
+        _mm_cmpgt_epi8(bs_16x8b, _mm_setzero_si128()));
+  }
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264d_deblk_mb_luma_sse42                               */
+/*                                                                           */
+/*  Description   : Deblocks the luma of a MB. The MB and the 4 columns to   */
+/*                  its left are transposed once for all the vertical edges  */
+/*                  and the horizontal edges are filtered on the rows held   */
+/*                  in registers                                             */
+/*                                                                           */
+/*  Inputs        : pu1_src   - luma of the MB                               */
+/*                  src_strd  - stride                                       */
+/*                  ps_row_mb - filter parameters of the MB                  */
+/*                                                                           */
+/*****************************************************************************/
+static void ih264d_deblk_mb_luma_sse42(UWORD8 *pu1_src, WORD32 src_strd,
+                                       deblk_row_mb_t *ps_row_mb) {
+  /* Columns -4 to 15 of the MB */
+  __m128i ai_col[20];
+  __m128i ai_row[16];
+  __m128i ai_top[8];
+  UWORD32 *pu4_bs = ps_row_mb->au4_bs;
+  UWORD8 *pu1_alpha = ps_row_mb->au1_alpha[DEBLK_EDGE_INNER];
+  UWORD8 *pu1_beta = ps_row_mb->au1_beta[DEBLK_EDGE_INNER];
+  const UWORD8 *pu1_cliptab = ps_row_mb->apu1_cliptab[DEBLK_EDGE_INNER][0];
+  WORD32 i;
+
+  for (i = 0; i < 16; i++)
+    ai_row[i] = _mm_loadu_si128((__m128i *) (pu1_src + i * src_strd));
+
+  /* Vertical edges */
+  if (pu4_bs[4] | pu4_bs[5] | pu4_bs[6] | pu4_bs[7]) {
+    ih264d_transpose_16x16b(ai_row, ai_col + 4);
+
+    if (pu4_bs[4]) {
+      ih264d_load_luma_cols_4x16b(pu1_src - 4, src_strd, ai_col);
+      ih264d_deblk_luma_edge_16x8b(
+          ai_col, ps_row_mb->au1_alpha[DEBLK_EDGE_LEFT][0],
+          ps_row_mb->au1_beta[DEBLK_EDGE_LEFT][0], pu4_bs[4],
+          (0x04040404 == pu4_bs[4]),
+          ps_row_mb->apu1_cliptab[DEBLK_EDGE_LEFT][0]);
+    }
+
+    for (i = 1; i < 4; i++) {
+      if (pu4_bs[4 + i])
+        ih264d_deblk_luma_edge_16x8b(ai_col + (i << 2), pu1_alpha[0],
+                                     pu1_beta[0], pu4_bs[4 + i], 0,
+                                     pu1_cliptab);
+    }
+
+    ih264d_transpose_16x16b(ai_col + 4, ai_row);
+
+    if (pu4_bs[4]) ih264d_store_luma_cols_4x16b(ai_col, pu1_src - 4, src_strd);
+  }
+
+  /* Horizontal edges */
+  if (pu4_bs[0]) {
+    for (i = 0; i < 4; i++) {
+      ai_top[i] =
+          _mm_loadu_si128((__m128i *) (pu1_src + (i - 4) * src_strd));
+      ai_top[i + 4] = ai_row[i];
+    }
+
+    ih264d_deblk_luma_edge_16x8b(
+        ai_top, ps_row_mb->au1_alpha[DEBLK_EDGE_TOP][0],
+        ps_row_mb->au1_beta[DEBLK_EDGE_TOP][0], pu4_bs[0],
+        (0x04040404 == pu4_bs[0]), ps_row_mb->apu1_cliptab[DEBLK_EDGE_TOP][0]);
+
+    for (i = 1; i < 4; i++)
+      _mm_storeu_si128((__m128i *) (pu1_src + (i - 4) * src_strd), ai_top[i]);
+    for (i = 0; i < 4; i++) ai_row[i] = ai_top[i + 4];
+  }
+
+  for (i = 1; i < 4; i++) {
+    if (pu4_bs[i])
+      ih264d_deblk_luma_edge_16x8b(ai_row + ((i - 1) << 2), pu1_alpha[0],
+                                   pu1_beta[0], pu4_bs[i], 0, pu1_cliptab);
+  }
+
+  for (i = 0; i < 16; i++)
+    _mm_storeu_si128((__m128i *) (pu1_src + i * src_strd), ai_row[i]);
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264d_deblk_mb_chroma_sse42                             */
+/*                                                                           */
+/*  Description   : Deblocks the interleaved chroma of a MB. The Cb Cr pairs */
+/*                  of the MB and the 2 columns to its left are transposed   */
+/*                  once for the vertical edges and the horizontal edges are */
+/*                  filtered on the rows held in registers                   */
+/*                                                                           */
+/*  Inputs        : pu1_src   - interleaved chroma of the MB                 */
+/*                  src_strd  - stride                                       */
+/*                  ps_row_mb - filter parameters of the MB                  */
+/*                                                                           */
+/*****************************************************************************/
+static void ih264d_deblk_mb_chroma_sse42(UWORD8 *pu1_src, WORD32 src_strd,
+                                         deblk_row_mb_t *ps_row_mb) {
+  /* Columns -2 to 7 of the MB */
+  __m128i ai_col[10];
+  __m128i ai_row[8];
+  __m128i ai_top[4];
+  UWORD32 *pu4_bs = ps_row_mb->au4_bs;
+  WORD32 i;
+
+  if (!(pu4_bs[0] | pu4_bs[2] | pu4_bs[4] | pu4_bs[6])) return;
+
+  for (i = 0; i < 8; i++)
+    ai_row[i] = _mm_loadu_si128((__m128i *) (pu1_src + i * src_strd));
+
+  /* Vertical edges */
+  if (pu4_bs[4] | pu4_bs[6]) {
+    ih264d_transpose_8x8w(ai_row, ai_col + 2);
+
+    if (pu4_bs[4]) {
+      ih264d_load_chroma_cols_2x8w(pu1_src - 4, src_strd, ai_col);
+      ih264d_deblk_chroma_edge_16x8b(
+          ai_col, ps_row_mb->au1_alpha[DEBLK_EDGE_LEFT],
+          ps_row_mb->au1_beta[DEBLK_EDGE_LEFT], pu4_bs[4],
+          (0x04040404 == pu4_bs[4]), ps_row_mb->apu1_cliptab[DEBLK_EDGE_LEFT]);
+    }
+
+    if (pu4_bs[6])
+      ih264d_deblk_chroma_edge_16x8b(
+          ai_col + 4, ps_row_mb->au1_alpha[DEBLK_EDGE_INNER],
+          ps_row_mb->au1_beta[DEBLK_EDGE_INNER], pu4_bs[6], 0,
+          ps_row_mb->apu1_cliptab[DEBLK_EDGE_INNER]);
+
+    ih264d_transpose_8x8w(ai_col + 2, ai_row);
+
+    if (pu4_bs[4])
+      ih264d_store_chroma_cols_2x8w(ai_col, pu1_src - 4, src_strd);
+  }
+
+  /* Horizontal edges */
+  if (pu4_bs[0]) {
+    ai_top[0] = _mm_loadu_si128((__m128i *) (pu1_src - 2 * src_strd));
+    ai_top[1] = _mm_loadu_si128((__m128i *) (pu1_src - src_strd));
+    ai_top[2] = ai_row[0];
+    ai_top[3] = ai_row[1];
+
+    ih264d_deblk_chroma_edge_16x8b(
+        ai_top, ps_row_mb->au1_alpha[DEBLK_EDGE_TOP],
+        ps_row_mb->au1_beta[DEBLK_EDGE_TOP], pu4_bs[0],
+        (0x04040404 == pu4_bs[0]), ps_row_mb->apu1_cliptab[DEBLK_EDGE_TOP]);
+
+    _mm_storeu_si128((__m128i *) (pu1_src - src_strd), ai_top[1]);
+    ai_row[0] = ai_top[2];
+    ai_row[1] = ai_top[3];
+  }
+
+  if (pu4_bs[2])
+    ih264d_deblk_chroma_edge_16x8b(
+        ai_row + 2, ps_row_mb->au1_alpha[DEBLK_EDGE_INNER],
+        ps_row_mb->au1_beta[DEBLK_EDGE_INNER], pu4_bs[2], 0,
+        ps_row_mb->apu1_cliptab[DEBLK_EDGE_INNER]);
+
+  for (i = 0; i < 8; i++)
+    _mm_storeu_si128((__m128i *) (pu1_src + i * src_strd), ai_row[i]);
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264d_deblk_row_nonmbaff_sse42                          */
+/*                                                                           */
+/*  Description   : Deblocks a run of MBs of a row without MBAFF. For each   */
+/*                  MB the vertical edges are filtered before the horizontal */
+/*                  edges, which the next MB's left edge depends on          */
+/*                                                                           */
+/*  Inputs        : ps_dec     - decoder context                             */
+/*                  pu1_y      - luma of the first MB                        */
+/*                  pu1_uv     - interleaved chroma of the first MB          */
+/*                  i4_strd_y  - luma stride                                 */
+/*                  i4_strd_uv - chroma stride                               */
+/*                  ps_row_mb  - filter parameters of the MBs                */
+/*                  i4_num_mbs - number of MBs                               */
+/*                                                                           */
+/*****************************************************************************/
+void ih264d_deblk_row_nonmbaff_sse42(dec_struct_t *ps_dec, UWORD8 *pu1_y,
+                                     UWORD8 *pu1_uv, WORD32 i4_strd_y,
+                                     WORD32 i4_strd_uv,
+                                     deblk_row_mb_t *ps_row_mb,
+                                     WORD32 i4_num_mbs) {
+  WORD32 i;
+
+  UNUSED(ps_dec);
+
+  for (i = 0; i < i4_num_mbs; i++, ps_row_mb++) {
+    UWORD32 *pu4_bs = ps_row_mb->au4_bs;
+
+    if (pu4_bs[0] | pu4_bs[1] | pu4_bs[2] | pu4_bs[3] | pu4_bs[4] |
+        pu4_bs[5] | pu4_bs[6] | pu4_bs[7]) {
+      ih264d_deblk_mb_luma_sse42(pu1_y, i4_strd_y, ps_row_mb);
+      ih264d_deblk_mb_chroma_sse42(pu1_uv, i4_strd_uv, ps_row_mb);
+    }
+
+    pu1_y += MB_SIZE;
+    pu1_uv += BLK8x8SIZE * YUV420SP_FACTOR;
+  }
+}
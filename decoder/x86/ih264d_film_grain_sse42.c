@@ -0,0 +1,273 @@
+/* Copyright (c) [2020]-[2023] Ittiam Systems Pvt. Ltd.
+   All rights reserved.
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted (subject to the limitations in the
+   disclaimer below) provided that the following conditions are met:
+   •    Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+   •    Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+   •    None of the names of Ittiam Systems Pvt. Ltd., its affiliates,
+   investors, business partners, nor the names of its contributors may be
+   used to endorse or promote products derived from this software without
+   specific prior written permission.
+
+   NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED
+   BY THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+   BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+   FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+   HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+   OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+   WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+   OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+   EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+   This Software is an implementation of the AVC/H.264
+   standard by Ittiam Systems Pvt. Ltd. (“Ittiam”).
+   Additional patent licenses may be required for this Software,
+   including, but not limited to, a license from MPEG LA’s AVC/H.264
+   licensing program (see https://www.mpegla.com/programs/avc-h-264/).
+
+   NOTWITHSTANDING ANYTHING TO THE CONTRARY, THIS DOES NOT GRANT ANY
+   EXPRESS OR IMPLIED LICENSES TO ANY PATENT CLAIMS OF ANY AFFILIATE
+   (TO THE EXTENT NOT IN THE LEGAL ENTITY), INVESTOR, OR OTHER
+   BUSINESS PARTNER OF ITTIAM. You may only use this software or
+   modifications thereto for purposes that are authorized by
+   appropriate patent licenses. You should seek legal advice based
+   upon your implementation details.
+
+---------------------------------------------------------------
+*/
+/*****************************************************************************/
+/*                                                                           */
+/*  File Name         : ih264d_film_grain_sse42.c                            */
+/*                                                                           */
+/*  Description       : Contains the film grain kernels in x86 sse4          */
+/*                      intrinsics. Block averages are sums of absolute      */
+/*                      differences against zero, the grain of a block row   */
+/*                      is the sign extended pattern row scaled in 16 bits   */
+/*                                                                           */
+/*  List of Functions : ih264d_film_grain_avg_luma_sse42()                   */
+/*                      ih264d_film_grain_avg_chroma_sse42()                 */
+/*                      ih264d_film_grain_synth_row_sse42()                  */
+/*                      ih264d_film_grain_blend_sse42()                      */
+/*                      ih264d_film_grain_blend_uv_sse42()                   */
+/*                                                                           */
+/*  Issues / Problems : None                                                 */
+/*                                                                           */
+/*****************************************************************************/
+/*****************************************************************************/
+/* File Includes                                                             */
+/*****************************************************************************/
+
+#include <immintrin.h>
+#include "ih264_typedefs.h"
+#include "ih264_macros.h"
+#include "ih264_platform_macros.h"
+#include "ih264d_defs.h"
+#include "ih264d_structs.h"
+#include "ih264d_film_grain.h"
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264d_film_grain_avg_luma_sse42                         */
+/*                                                                           */
+/*  Description   : Rounded averages of a row of 8x8 blocks, two blocks per  */
+/*                  sum of absolute differences                              */
+/*                                                                           */
+/*  Inputs        : pu1_src     - top left of the first block                */
+/*                  i4_strd     - stride                                     */
+/*                  i4_num_blks - number of blocks                           */
+/*  Outputs       : pu1_avg     - average of each block                      */
+/*                                                                           */
+/*****************************************************************************/
+void ih264d_film_grain_avg_luma_sse42(const UWORD8 *pu1_src, WORD32 i4_strd,
+                                      WORD32 i4_num_blks, UWORD8 *pu1_avg) {
+  const __m128i zero_16x8b = _mm_setzero_si128();
+  const __m128i rnd_2x64b = _mm_set1_epi64x(32);
+  WORD32 b, y;
+
+  for (b = 0; b < i4_num_blks; b += 2) {
+    const UWORD8 *pu1_blk = pu1_src + (b << 3);
+    __m128i sum_2x64b = zero_16x8b;
+
+    if (b + 1 < i4_num_blks) {
+      for (y = 0; y < 8; y++) {
+        __m128i src_16x8b =
+            _mm_loadu_si128((__m128i *) (pu1_blk + y * i4_strd));
+
+        sum_2x64b =
+            _mm_add_epi64(sum_2x64b, _mm_sad_epu8(src_16x8b, zero_16x8b));
+      }
+    } else {
+      for (y = 0; y < 8; y++) {
+        __m128i src_16x8b =
+            _mm_loadl_epi64((__m128i *) (pu1_blk + y * i4_strd));
+
+        sum_2x64b =
+            _mm_add_epi64(sum_2x64b, _mm_sad_epu8(src_16x8b, zero_16x8b));
+      }
+    }
+    sum_2x64b = _mm_srli_epi64(_mm_add_epi64(sum_2x64b, rnd_2x64b), 6);
+    pu1_avg[b] = (UWORD8) _mm_cvtsi128_si32(sum_2x64b);
+    if (b + 1 < i4_num_blks)
+      pu1_avg[b + 1] = (UWORD8) _mm_extract_epi32(sum_2x64b, 2);
+  }
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264d_film_grain_avg_chroma_sse42                       */
+/*                                                                           */
+/*  Description   : Rounded averages of a row of 8x8 blocks of interleaved   */
+/*                  chroma. The U and V samples of a block row are split     */
+/*                  into the low and high bytes of 16 bit lanes              */
+/*                                                                           */
+/*  Inputs        : pu1_src     - top left of the first block                */
+/*                  i4_strd     - stride                                     */
+/*                  i4_num_blks - number of blocks                           */
+/*  Outputs       : pu1_avg_u   - average of each U block                    */
+/*                  pu1_avg_v   - average of each V block                    */
+/*                                                                           */
+/*****************************************************************************/
+void ih264d_film_grain_avg_chroma_sse42(const UWORD8 *pu1_src, WORD32 i4_strd,
+                                        WORD32 i4_num_blks, UWORD8 *pu1_avg_u,
+                                        UWORD8 *pu1_avg_v) {
+  const __m128i zero_16x8b = _mm_setzero_si128();
+  const __m128i mask_8x16b = _mm_set1_epi16(0x00ff);
+  WORD32 b, y;
+
+  for (b = 0; b < i4_num_blks; b++) {
+    const UWORD8 *pu1_blk = pu1_src + (b << 4);
+    __m128i sum_u_2x64b = zero_16x8b;
+    __m128i sum_v_2x64b = zero_16x8b;
+    UWORD32 u4_sum_u, u4_sum_v;
+
+    for (y = 0; y < 8; y++) {
+      __m128i src_16x8b = _mm_loadu_si128((__m128i *) (pu1_blk + y * i4_strd));
+
+      sum_u_2x64b = _mm_add_epi64(
+          sum_u_2x64b,
+          _mm_sad_epu8(_mm_and_si128(src_16x8b, mask_8x16b), zero_16x8b));
+      sum_v_2x64b = _mm_add_epi64(
+          sum_v_2x64b,
+          _mm_sad_epu8(_mm_srli_epi16(src_16x8b, 8), zero_16x8b));
+    }
+    u4_sum_u =
+        _mm_cvtsi128_si32(sum_u_2x64b) + _mm_extract_epi32(sum_u_2x64b, 2);
+    u4_sum_v =
+        _mm_cvtsi128_si32(sum_v_2x64b) + _mm_extract_epi32(sum_v_2x64b, 2);
+    pu1_avg_u[b] = (UWORD8) ((u4_sum_u + 32) >> 6);
+    pu1_avg_v[b] = (UWORD8) ((u4_sum_v + 32) >> 6);
+  }
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264d_film_grain_synth_row_sse42                        */
+/*                                                                           */
+/*  Description   : One row of grain of a run of 8x8 blocks, the pattern     */
+/*                  samples scaled and shifted down. The products fit in 16  */
+/*                  bits as the scale is at most 255 and the samples at most */
+/*                  127 in magnitude                                         */
+/*                                                                           */
+/*  Inputs        : ps_blk      - blocks                                     */
+/*                  i4_num_blks - number of blocks                           */
+/*                  i4_row      - row in the blocks                          */
+/*                  i4_shift    - right shift of the scaled samples          */
+/*  Outputs       : pi2_grain   - 8 samples per block                        */
+/*                                                                           */
+/*****************************************************************************/
+void ih264d_film_grain_synth_row_sse42(WORD16 *pi2_grain,
+                                       const film_grain_blk_t *ps_blk,
+                                       WORD32 i4_num_blks, WORD32 i4_row,
+                                       WORD32 i4_shift) {
+  const __m128i shift_64b = _mm_cvtsi32_si128(i4_shift);
+  WORD32 b;
+
+  for (b = 0; b < i4_num_blks; b++, pi2_grain += 8) {
+    const WORD8 *pi1_src = ps_blk[b].pi1_pattern;
+    __m128i grain_8x16b = _mm_setzero_si128();
+
+    if (NULL != pi1_src) {
+      pi1_src += i4_row * FG_PATTERN_SIZE;
+      grain_8x16b = _mm_cvtepi8_epi16(_mm_loadl_epi64((__m128i *) pi1_src));
+      grain_8x16b = _mm_mullo_epi16(
+          grain_8x16b, _mm_set1_epi16((WORD16) ps_blk[b].i4_scale));
+      grain_8x16b = _mm_sra_epi16(grain_8x16b, shift_64b);
+    }
+    _mm_storeu_si128((__m128i *) pi2_grain, grain_8x16b);
+  }
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264d_film_grain_blend_sse42                            */
+/*                                                                           */
+/*  Description   : Adds a row of grain to a row of samples                  */
+/*                                                                           */
+/*  Inputs        : pu1_dst   - samples                                      */
+/*                  pi2_grain - grain                                        */
+/*                  i4_wd     - number of samples                            */
+/*                                                                           */
+/*****************************************************************************/
+void ih264d_film_grain_blend_sse42(UWORD8 *pu1_dst, const WORD16 *pi2_grain,
+                                   WORD32 i4_wd) {
+  const __m128i zero_16x8b = _mm_setzero_si128();
+  WORD32 x;
+
+  for (x = 0; x + 16 <= i4_wd; x += 16) {
+    __m128i dst_16x8b = _mm_loadu_si128((__m128i *) (pu1_dst + x));
+    __m128i lo_8x16b = _mm_unpacklo_epi8(dst_16x8b, zero_16x8b);
+    __m128i hi_8x16b = _mm_unpackhi_epi8(dst_16x8b, zero_16x8b);
+
+    lo_8x16b = _mm_add_epi16(
+        lo_8x16b, _mm_loadu_si128((__m128i *) (pi2_grain + x)));
+    hi_8x16b = _mm_add_epi16(
+        hi_8x16b, _mm_loadu_si128((__m128i *) (pi2_grain + x + 8)));
+    _mm_storeu_si128((__m128i *) (pu1_dst + x),
+                     _mm_packus_epi16(lo_8x16b, hi_8x16b));
+  }
+  for (; x < i4_wd; x++) pu1_dst[x] = CLIP_U8(pu1_dst[x] + pi2_grain[x]);
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264d_film_grain_blend_uv_sse42                         */
+/*                                                                           */
+/*  Description   : Adds rows of grain of two components to a row of         */
+/*                  interleaved samples, the grain interleaved in registers  */
+/*                                                                           */
+/*  Inputs        : pu1_dst     - interleaved samples                        */
+/*                  pi2_grain_u - grain of the first component               */
+/*                  pi2_grain_v - grain of the second component              */
+/*                  i4_wd       - number of samples of a component           */
+/*                                                                           */
+/*****************************************************************************/
+void ih264d_film_grain_blend_uv_sse42(UWORD8 *pu1_dst,
+                                      const WORD16 *pi2_grain_u,
+                                      const WORD16 *pi2_grain_v, WORD32 i4_wd) {
+  const __m128i zero_16x8b = _mm_setzero_si128();
+  WORD32 x;
+
+  for (x = 0; x + 8 <= i4_wd; x += 8) {
+    __m128i dst_16x8b = _mm_loadu_si128((__m128i *) (pu1_dst + (x << 1)));
+    __m128i u_8x16b = _mm_loadu_si128((__m128i *) (pi2_grain_u + x));
+    __m128i v_8x16b = _mm_loadu_si128((__m128i *) (pi2_grain_v + x));
+    __m128i lo_8x16b = _mm_unpacklo_epi8(dst_16x8b, zero_16x8b);
+    __m128i hi_8x16b = _mm_unpackhi_epi8(dst_16x8b, zero_16x8b);
+
+    lo_8x16b = _mm_add_epi16(lo_8x16b, _mm_unpacklo_epi16(u_8x16b, v_8x16b));
+    hi_8x16b = _mm_add_epi16(hi_8x16b, _mm_unpackhi_epi16(u_8x16b, v_8x16b));
+    _mm_storeu_si128((__m128i *) (pu1_dst + (x << 1)),
+                     _mm_packus_epi16(lo_8x16b, hi_8x16b));
+  }
+  for (; x < i4_wd; x++) {
+    pu1_dst[2 * x] = CLIP_U8(pu1_dst[2 * x] + pi2_grain_u[x]);
+    pu1_dst[2 * x + 1] = CLIP_U8(pu1_dst[2 * x + 1] + pi2_grain_v[x]);
+  }
+}
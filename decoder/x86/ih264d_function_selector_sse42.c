@@ -83,6 +83,9 @@
 #include "ih264_inter_pred_filters.h"
 
 #include "ih264d_structs.h"
+#include "ih264d_deblocking.h"
+#include "ih264d_process_intra_mb.h"
+#include "ih264d_film_grain.h"
 
 /**
 *******************************************************************************
@@ -117,5 +120,20 @@ void ih264d_init_function_ptr_sse42(dec_struct_t *ps_codec) {
   ps_codec->pf_iquant_itrans_recon_chroma_4x4 =
       ih264_iquant_itrans_recon_chroma_4x4_sse42;
   ps_codec->pf_ihadamard_scaling_4x4 = ih264_ihadamard_scaling_4x4_sse42;
+  ps_codec->pf_iquant_itrans_recon_luma_4x4_mb =
+      ih264d_iquant_itrans_recon_luma_4x4_mb_sse42;
+  ps_codec->pf_iquant_itrans_recon_chroma_4x4_mb =
+      ih264d_iquant_itrans_recon_chroma_4x4_mb_sse42;
+
+  ps_codec->pf_fill_bs1[0][1] = ih264d_fill_bs1_non16x16mb_pslice_sse42;
+  ps_codec->pf_fill_bs1[1][1] = ih264d_fill_bs1_non16x16mb_bslice_sse42;
+
+  ps_codec->pf_deblk_row_nonmbaff = ih264d_deblk_row_nonmbaff_sse42;
+
+  ps_codec->pf_film_grain_avg_luma = ih264d_film_grain_avg_luma_sse42;
+  ps_codec->pf_film_grain_avg_chroma = ih264d_film_grain_avg_chroma_sse42;
+  ps_codec->pf_film_grain_synth_row = ih264d_film_grain_synth_row_sse42;
+  ps_codec->pf_film_grain_blend = ih264d_film_grain_blend_sse42;
+  ps_codec->pf_film_grain_blend_uv = ih264d_film_grain_blend_uv_sse42;
   return;
 }
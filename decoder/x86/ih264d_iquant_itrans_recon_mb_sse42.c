@@ -0,0 +1,436 @@
+/* Copyright (c) [2020]-[2023] Ittiam Systems Pvt. Ltd.
+   All rights reserved.
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted (subject to the limitations in the
+   disclaimer below) provided that the following conditions are met:
+   •    Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+   •    Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+   •    None of the names of Ittiam Systems Pvt. Ltd., its affiliates,
+   investors, business partners, nor the names of its contributors may be
+   used to endorse or promote products derived from this software without
+   specific prior written permission.
+
+   NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED
+   BY THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+   BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+   FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+   HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+   OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+   WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+   OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+   EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+   This Software is an implementation of the AVC/H.264
+   standard by Ittiam Systems Pvt. Ltd. (“Ittiam”).
+   Additional patent licenses may be required for this Software,
+   including, but not limited to, a license from MPEG LA’s AVC/H.264
+   licensing program (see https://www.mpegla.com/programs/avc-h-264/).
+
+   NOTWITHSTANDING ANYTHING TO THE CONTRARY, THIS DOES NOT GRANT ANY
+   EXPRESS OR IMPLIED LICENSES TO ANY PATENT CLAIMS OF ANY AFFILIATE
+   (TO THE EXTENT NOT IN THE LEGAL ENTITY), INVESTOR, OR OTHER
+   BUSINESS PARTNER OF ITTIAM. You may only use this software or
+   modifications thereto for purposes that are authorized by
+   appropriate patent licenses. You should seek legal advice based
+   upon your implementation details.
+
+---------------------------------------------------------------
+*/
+/*****************************************************************************/
+/*                                                                           */
+/*  File Name         : ih264d_iquant_itrans_recon_mb_sse42.c                */
+/*                                                                           */
+/*  Description       : Contains function definitions for inverse            */
+/*                      quantization, inverse transform and reconstruction   */
+/*                      of all the 4x4 blocks of a MB in x86 sse4            */
+/*                      intrinsics. Two horizontally adjacent blocks are     */
+/*                      transformed together in 16 bit lanes                 */
+/*                                                                           */
+/*  List of Functions : ih264d_iquant_itrans_recon_luma_4x4_mb_sse42()       */
+/*                      ih264d_iquant_itrans_recon_chroma_4x4_mb_sse42()     */
+/*                                                                           */
+/*  Issues / Problems : None                                                 */
+/*                                                                           */
+/*****************************************************************************/
+/*****************************************************************************/
+/* File Includes                                                             */
+/*****************************************************************************/
+
+#include <immintrin.h>
+#include "ih264_typedefs.h"
+#include "ih264_macros.h"
+#include "ih264_platform_macros.h"
+#include "ih264d_defs.h"
+#include "ih264d_structs.h"
+#include "ih264d_process_intra_mb.h"
+
+/** Coefficients of a 4x4 block that are read */
+#define BLK_COEFF_NONE 0
+#define BLK_COEFF_DC 1
+#define BLK_COEFF_ALL 2
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264d_iquant_8x16b                                      */
+/*                                                                           */
+/*  Description   : Inverse quantizes two rows of a 4x4 block,               */
+/*                  (level * scale + rnd) << qp_div_6 >> 4                   */
+/*                                                                           */
+/*  Inputs        : src_8x16b   - levels                                     */
+/*                  scale_8x16b - product of the inverse scale and weight    */
+/*                  u4_qp_div_6 - floor(qp / 6)                              */
+/*                                                                           */
+/*  Returns       : Inverse quantized values                                 */
+/*                                                                           */
+/*****************************************************************************/
+static __inline __m128i ih264d_iquant_8x16b(__m128i src_8x16b,
+                                            __m128i scale_8x16b,
+                                            UWORD32 u4_qp_div_6) {
+  const __m128i zero_8x16b = _mm_setzero_si128();
+  __m128i lo_4x32b, hi_4x32b;
+
+  lo_4x32b = _mm_madd_epi16(_mm_unpacklo_epi16(src_8x16b, zero_8x16b),
+                            _mm_unpacklo_epi16(scale_8x16b, zero_8x16b));
+  hi_4x32b = _mm_madd_epi16(_mm_unpackhi_epi16(src_8x16b, zero_8x16b),
+                            _mm_unpackhi_epi16(scale_8x16b, zero_8x16b));
+
+  if (u4_qp_div_6 >= 4) {
+    lo_4x32b = _mm_slli_epi32(lo_4x32b, u4_qp_div_6 - 4);
+    hi_4x32b = _mm_slli_epi32(hi_4x32b, u4_qp_div_6 - 4);
+  } else {
+    __m128i rnd_4x32b = _mm_set1_epi32(1 << (3 - u4_qp_div_6));
+
+    lo_4x32b = _mm_srai_epi32(_mm_add_epi32(lo_4x32b, rnd_4x32b),
+                              4 - u4_qp_div_6);
+    hi_4x32b = _mm_srai_epi32(_mm_add_epi32(hi_4x32b, rnd_4x32b),
+                              4 - u4_qp_div_6);
+  }
+  return _mm_packs_epi32(lo_4x32b, hi_4x32b);
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264d_load_blk_coeff                                    */
+/*                                                                           */
+/*  Description   : Loads and inverse quantizes the coefficients of a 4x4    */
+/*                  block. Coefficients that are not read are zero           */
+/*                                                                           */
+/*  Inputs        : pi2_src        - levels of the block                     */
+/*                  u4_type        - BLK_COEFF_NONE, _DC or _ALL             */
+/*                  ai_scale       - scale of rows 0, 1 and rows 2, 3        */
+/*                  u4_qp_div_6    - floor(qp / 6)                           */
+/*                  i4_iq_start_idx - 1 if the DC is already scaled          */
+/*                                                                           */
+/*  Outputs       : pi_coeff       - rows 0, 1 and rows 2, 3                 */
+/*                                                                           */
+/*****************************************************************************/
+static __inline void ih264d_load_blk_coeff(WORD16 *pi2_src, UWORD32 u4_type,
+                                           __m128i *ai_scale,
+                                           UWORD32 u4_qp_div_6,
+                                           WORD32 i4_iq_start_idx,
+                                           __m128i *pi_coeff) {
+  pi_coeff[0] = _mm_setzero_si128();
+  pi_coeff[1] = _mm_setzero_si128();
+
+  if (BLK_COEFF_ALL == u4_type) {
+    pi_coeff[0] = ih264d_iquant_8x16b(_mm_loadu_si128((__m128i *) pi2_src),
+                                      ai_scale[0], u4_qp_div_6);
+    pi_coeff[1] =
+        ih264d_iquant_8x16b(_mm_loadu_si128((__m128i *) (pi2_src + 8)),
+                            ai_scale[1], u4_qp_div_6);
+  } else if (BLK_COEFF_DC == u4_type && !i4_iq_start_idx) {
+    pi_coeff[0] = ih264d_iquant_8x16b(
+        _mm_cvtsi32_si128((UWORD16) pi2_src[0]), ai_scale[0], u4_qp_div_6);
+  }
+
+  if (BLK_COEFF_NONE != u4_type && i4_iq_start_idx)
+    pi_coeff[0] = _mm_insert_epi16(pi_coeff[0], pi2_src[0], 0);
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264d_transpose_4x4_pair                                */
+/*                                                                           */
+/*  Description   : Transposes two 4x4 blocks of 16 bit values held side by  */
+/*                  side, the first block in the low half of each register   */
+/*                                                                           */
+/*  Inputs        : pi_x - 4 rows                                            */
+/*                                                                           */
+/*  Outputs       : pi_x - 4 columns                                         */
+/*                                                                           */
+/*****************************************************************************/
+static __inline void ih264d_transpose_4x4_pair(__m128i *pi_x) {
+  __m128i a01, a23, b01, b23, a_lo, a_hi, b_lo, b_hi;
+
+  a01 = _mm_unpacklo_epi16(pi_x[0], pi_x[1]);
+  a23 = _mm_unpacklo_epi16(pi_x[2], pi_x[3]);
+  b01 = _mm_unpackhi_epi16(pi_x[0], pi_x[1]);
+  b23 = _mm_unpackhi_epi16(pi_x[2], pi_x[3]);
+
+  a_lo = _mm_unpacklo_epi32(a01, a23);
+  a_hi = _mm_unpackhi_epi32(a01, a23);
+  b_lo = _mm_unpacklo_epi32(b01, b23);
+  b_hi = _mm_unpackhi_epi32(b01, b23);
+
+  pi_x[0] = _mm_unpacklo_epi64(a_lo, b_lo);
+  pi_x[1] = _mm_unpackhi_epi64(a_lo, b_lo);
+  pi_x[2] = _mm_unpacklo_epi64(a_hi, b_hi);
+  pi_x[3] = _mm_unpackhi_epi64(a_hi, b_hi);
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264d_itrans_4x4_pair                                   */
+/*                                                                           */
+/*  Description   : Inverse transforms two 4x4 blocks held side by side,     */
+/*                  horizontally and then vertically as in Sec. 8.5.12.2 of  */
+/*                  ITU T Rec H.264, with the final (x + 32) >> 6            */
+/*                                                                           */
+/*  Inputs        : pi_x - 4 rows of inverse quantized coefficients          */
+/*                                                                           */
+/*  Outputs       : pi_x - 4 rows of residue                                 */
+/*                                                                           */
+/*  Issues        : (x + 32) >> 6 is computed as ((x >> 1) + 16) >> 5 to     */
+/*                  stay within 16 bits                                      */
+/*                                                                           */
+/*****************************************************************************/
+static __inline void ih264d_itrans_4x4_pair(__m128i *pi_x) {
+  const __m128i rnd_8x16b = _mm_set1_epi16(16);
+  __m128i z0, z1, z2, z3;
+
+  /* horizontal transform on the columns */
+  ih264d_transpose_4x4_pair(pi_x);
+  z0 = _mm_add_epi16(pi_x[0], pi_x[2]);
+  z1 = _mm_sub_epi16(pi_x[0], pi_x[2]);
+  z2 = _mm_sub_epi16(_mm_srai_epi16(pi_x[1], 1), pi_x[3]);
+  z3 = _mm_add_epi16(pi_x[1], _mm_srai_epi16(pi_x[3], 1));
+  pi_x[0] = _mm_add_epi16(z0, z3);
+  pi_x[1] = _mm_add_epi16(z1, z2);
+  pi_x[2] = _mm_sub_epi16(z1, z2);
+  pi_x[3] = _mm_sub_epi16(z0, z3);
+
+  /* vertical transform on the rows */
+  ih264d_transpose_4x4_pair(pi_x);
+  z0 = _mm_add_epi16(pi_x[0], pi_x[2]);
+  z1 = _mm_sub_epi16(pi_x[0], pi_x[2]);
+  z2 = _mm_sub_epi16(_mm_srai_epi16(pi_x[1], 1), pi_x[3]);
+  z3 = _mm_add_epi16(pi_x[1], _mm_srai_epi16(pi_x[3], 1));
+  pi_x[0] = _mm_add_epi16(z0, z3);
+  pi_x[1] = _mm_add_epi16(z1, z2);
+  pi_x[2] = _mm_sub_epi16(z1, z2);
+  pi_x[3] = _mm_sub_epi16(z0, z3);
+
+  pi_x[0] = _mm_srai_epi16(
+      _mm_add_epi16(_mm_srai_epi16(pi_x[0], 1), rnd_8x16b), 5);
+  pi_x[1] = _mm_srai_epi16(
+      _mm_add_epi16(_mm_srai_epi16(pi_x[1], 1), rnd_8x16b), 5);
+  pi_x[2] = _mm_srai_epi16(
+      _mm_add_epi16(_mm_srai_epi16(pi_x[2], 1), rnd_8x16b), 5);
+  pi_x[3] = _mm_srai_epi16(
+      _mm_add_epi16(_mm_srai_epi16(pi_x[3], 1), rnd_8x16b), 5);
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264d_iquant_itrans_4x4_pair                            */
+/*                                                                           */
+/*  Description   : Loads, inverse quantizes and inverse transforms two      */
+/*                  horizontally adjacent 4x4 blocks                         */
+/*                                                                           */
+/*  Inputs        : pi2_src         - levels of the first block, followed by */
+/*                                    those of the second block              */
+/*                  u4_type0        - coefficients read of the first block   */
+/*                  u4_type1        - coefficients read of the second block  */
+/*                  ai_scale        - scale of rows 0, 1 and rows 2, 3       */
+/*                  u4_qp_div_6     - floor(qp / 6)                          */
+/*                  i4_iq_start_idx - 1 if the DC is already scaled          */
+/*                                                                           */
+/*  Outputs       : pi_res          - 4 rows of residue of both blocks       */
+/*                                                                           */
+/*****************************************************************************/
+static __inline void ih264d_iquant_itrans_4x4_pair(
+    WORD16 *pi2_src, UWORD32 u4_type0, UWORD32 u4_type1, __m128i *ai_scale,
+    UWORD32 u4_qp_div_6, WORD32 i4_iq_start_idx, __m128i *pi_res) {
+  __m128i ai_blk0[2], ai_blk1[2];
+
+  ih264d_load_blk_coeff(pi2_src, u4_type0, ai_scale, u4_qp_div_6,
+                        i4_iq_start_idx, ai_blk0);
+  ih264d_load_blk_coeff(pi2_src + 16, u4_type1, ai_scale, u4_qp_div_6,
+                        i4_iq_start_idx, ai_blk1);
+
+  pi_res[0] = _mm_unpacklo_epi64(ai_blk0[0], ai_blk1[0]);
+  pi_res[1] = _mm_unpackhi_epi64(ai_blk0[0], ai_blk1[0]);
+  pi_res[2] = _mm_unpacklo_epi64(ai_blk0[1], ai_blk1[1]);
+  pi_res[3] = _mm_unpackhi_epi64(ai_blk0[1], ai_blk1[1]);
+
+  ih264d_itrans_4x4_pair(pi_res);
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264d_load_scale                                        */
+/*                                                                           */
+/*  Description   : Multiplies the inverse scale and weight matrices         */
+/*                                                                           */
+/*  Inputs        : pu2_iscal_mat - inverse scale matrix                     */
+/*                  pu2_weigh_mat - weight matrix                            */
+/*                                                                           */
+/*  Outputs       : ai_scale      - scale of rows 0, 1 and rows 2, 3         */
+/*                                                                           */
+/*****************************************************************************/
+static __inline void ih264d_load_scale(const UWORD16 *pu2_iscal_mat,
+                                       const UWORD16 *pu2_weigh_mat,
+                                       __m128i *ai_scale) {
+  ai_scale[0] =
+      _mm_mullo_epi16(_mm_loadu_si128((__m128i *) pu2_iscal_mat),
+                      _mm_loadu_si128((__m128i *) pu2_weigh_mat));
+  ai_scale[1] =
+      _mm_mullo_epi16(_mm_loadu_si128((__m128i *) (pu2_iscal_mat + 8)),
+                      _mm_loadu_si128((__m128i *) (pu2_weigh_mat + 8)));
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264d_iquant_itrans_recon_luma_4x4_mb_sse42             */
+/*                                                                           */
+/*  Description   : Inverse quantizes, inverse transforms and reconstructs   */
+/*                  all the coded 4x4 luma blocks of a MB in place, two      */
+/*                  horizontally adjacent blocks at a time                   */
+/*                                                                           */
+/*  Inputs        : ps_dec          - decoder context                        */
+/*                  pi2_coeff       - levels of the 16 blocks, raster order  */
+/*                  pu1_rec         - prediction and output of the MB        */
+/*                  i4_rec_strd     - stride of pu1_rec                      */
+/*                  pu2_iscal_mat   - inverse scale matrix                   */
+/*                  pu2_weigh_mat   - weight matrix                          */
+/*                  u4_qp_div_6     - floor(qp / 6)                          */
+/*                  u4_csbp         - blocks to be reconstructed             */
+/*                  u4_dc_only_csbp - blocks with only a DC coefficient      */
+/*                  i4_iq_start_idx - 1 if the DC is already scaled          */
+/*                                                                           */
+/*****************************************************************************/
+void ih264d_iquant_itrans_recon_luma_4x4_mb_sse42(
+    dec_struct_t *ps_dec, WORD16 *pi2_coeff, UWORD8 *pu1_rec,
+    WORD32 i4_rec_strd, const UWORD16 *pu2_iscal_mat,
+    const UWORD16 *pu2_weigh_mat, UWORD32 u4_qp_div_6, UWORD32 u4_csbp,
+    UWORD32 u4_dc_only_csbp, WORD32 i4_iq_start_idx) {
+  const __m128i zero_8x16b = _mm_setzero_si128();
+  __m128i ai_scale[2];
+  UWORD32 i, j;
+  UNUSED(ps_dec);
+
+  ih264d_load_scale(pu2_iscal_mat, pu2_weigh_mat, ai_scale);
+
+  for (i = 0; i < 16; i += 2) {
+    UWORD32 u4_type0, u4_type1;
+    UWORD8 *pu1_blk;
+    __m128i ai_res[4];
+
+    if (!((u4_csbp >> i) & 0x3)) continue;
+
+    u4_type0 = CHECKBIT(u4_csbp, i)
+                   ? (CHECKBIT(u4_dc_only_csbp, i) ? BLK_COEFF_DC
+                                                   : BLK_COEFF_ALL)
+                   : BLK_COEFF_NONE;
+    u4_type1 = CHECKBIT(u4_csbp, (i + 1))
+                   ? (CHECKBIT(u4_dc_only_csbp, (i + 1)) ? BLK_COEFF_DC
+                                                         : BLK_COEFF_ALL)
+                   : BLK_COEFF_NONE;
+
+    ih264d_iquant_itrans_4x4_pair(pi2_coeff + (i << 4), u4_type0, u4_type1,
+                                  ai_scale, u4_qp_div_6, i4_iq_start_idx,
+                                  ai_res);
+
+    pu1_blk = pu1_rec + ((i & 0x3) * BLK_SIZE) + (i >> 2) * (i4_rec_strd << 2);
+    for (j = 0; j < 4; j++) {
+      __m128i pred_8x16b =
+          _mm_cvtepu8_epi16(_mm_loadl_epi64((__m128i *) pu1_blk));
+
+      _mm_storel_epi64(
+          (__m128i *) pu1_blk,
+          _mm_packus_epi16(_mm_add_epi16(ai_res[j], pred_8x16b), zero_8x16b));
+      pu1_blk += i4_rec_strd;
+    }
+  }
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264d_iquant_itrans_recon_chroma_4x4_mb_sse42           */
+/*                                                                           */
+/*  Description   : Inverse quantizes, inverse transforms and reconstructs   */
+/*                  the 4x4 blocks of both chroma planes of a MB in place.   */
+/*                  A row of two Cb and two Cr blocks is reconstructed at a  */
+/*                  time and written back interleaved                        */
+/*                                                                           */
+/*  Inputs        : ps_dec          - decoder context                        */
+/*                  pi2_coeff       - levels of the 4 Cb and 4 Cr blocks     */
+/*                  pu1_rec         - prediction and output of the MB        */
+/*                  i4_rec_strd     - stride of pu1_rec                      */
+/*                  pu2_iscal_mat_u - Cb inverse scale matrix                */
+/*                  pu2_iscal_mat_v - Cr inverse scale matrix                */
+/*                  pu2_weigh_mat_u - Cb weight matrix                       */
+/*                  pu2_weigh_mat_v - Cr weight matrix                       */
+/*                  u4_qp_div_6_u   - floor(qp / 6) of Cb                    */
+/*                  u4_qp_div_6_v   - floor(qp / 6) of Cr                    */
+/*                  u4_csbp         - blocks with AC coefficients            */
+/*                                                                           */
+/*****************************************************************************/
+void ih264d_iquant_itrans_recon_chroma_4x4_mb_sse42(
+    dec_struct_t *ps_dec, WORD16 *pi2_coeff, UWORD8 *pu1_rec,
+    WORD32 i4_rec_strd, const UWORD16 *pu2_iscal_mat_u,
+    const UWORD16 *pu2_iscal_mat_v, const UWORD16 *pu2_weigh_mat_u,
+    const UWORD16 *pu2_weigh_mat_v, UWORD32 u4_qp_div_6_u,
+    UWORD32 u4_qp_div_6_v, UWORD32 u4_csbp) {
+  const __m128i lo_byte_8x16b = _mm_set1_epi16(0x00ff);
+  const __m128i interleave_16x8b =
+      _mm_setr_epi8(0, 8, 1, 9, 2, 10, 3, 11, 4, 12, 5, 13, 6, 14, 7, 15);
+  __m128i ai_scale_u[2], ai_scale_v[2];
+  UWORD32 i, j;
+  UNUSED(ps_dec);
+
+  ih264d_load_scale(pu2_iscal_mat_u, pu2_weigh_mat_u, ai_scale_u);
+  ih264d_load_scale(pu2_iscal_mat_v, pu2_weigh_mat_v, ai_scale_v);
+
+  for (i = 0; i < 4; i += 2) {
+    WORD16 *pi2_u = pi2_coeff + (i << 4);
+    WORD16 *pi2_v = pi2_u + MB_CHROM_SIZE;
+    UWORD32 u4_type_u0 = CHECKBIT(u4_csbp, i) ? BLK_COEFF_ALL : BLK_COEFF_DC;
+    UWORD32 u4_type_u1 =
+        CHECKBIT(u4_csbp, (i + 1)) ? BLK_COEFF_ALL : BLK_COEFF_DC;
+    UWORD32 u4_type_v0 =
+        CHECKBIT(u4_csbp, (i + 4)) ? BLK_COEFF_ALL : BLK_COEFF_DC;
+    UWORD32 u4_type_v1 =
+        CHECKBIT(u4_csbp, (i + 5)) ? BLK_COEFF_ALL : BLK_COEFF_DC;
+    UWORD8 *pu1_blk = pu1_rec + (i >> 1) * (i4_rec_strd << 2);
+    __m128i ai_res_u[4], ai_res_v[4];
+
+    if (!((u4_csbp >> i) & 0x33) && !pi2_u[0] && !pi2_u[16] && !pi2_v[0] &&
+        !pi2_v[16])
+      continue;
+
+    ih264d_iquant_itrans_4x4_pair(pi2_u, u4_type_u0, u4_type_u1, ai_scale_u,
+                                  u4_qp_div_6_u, 1, ai_res_u);
+    ih264d_iquant_itrans_4x4_pair(pi2_v, u4_type_v0, u4_type_v1, ai_scale_v,
+                                  u4_qp_div_6_v, 1, ai_res_v);
+
+    for (j = 0; j < 4; j++) {
+      __m128i pred_16x8b = _mm_loadu_si128((__m128i *) pu1_blk);
+      __m128i u_8x16b = _mm_add_epi16(
+          ai_res_u[j], _mm_and_si128(pred_16x8b, lo_byte_8x16b));
+      __m128i v_8x16b =
+          _mm_add_epi16(ai_res_v[j], _mm_srli_epi16(pred_16x8b, 8));
+
+      _mm_storeu_si128((__m128i *) pu1_blk,
+                       _mm_shuffle_epi8(_mm_packus_epi16(u_8x16b, v_8x16b),
+                                        interleave_16x8b));
+      pu1_blk += i4_rec_strd;
+    }
+  }
+}
@@ -88,11 +88,14 @@ extern "C" {
 
 #define MAX_TIMESTAMP_CNT 64
 #define MAX_DISP_BUFFERS    64
+/* Packets queued ahead of the decode thread and frames queued behind it */
+#define PKT_QUEUE_SIZE      4
+#define FRM_QUEUE_SIZE      4
 
 #define MAX_BITS_SIZE               2 * 1024 * 1024
 
 #define LOG_ENABLE 1
-#define THREAD_ENABLE   0
+#define THREAD_ENABLE   1
 #define SPS_NAL_TYPE    33
 #define MAIN422_PROFILE  4
 #define MAIN10_PROFILE   2
@@ -111,7 +114,7 @@ extern "C" {
 #define MAX_LEVEL_SUPPORTED         50
 #define MAX_REF_FRAMES              16
 #define MAX_REORDER_FRAMES          16
-#define DEFAULT_SHARE_DISPLAY_BUF   0
+#define DEFAULT_SHARE_DISPLAY_BUF   1
 #define STRIDE                      0
 #define DEFAULT_NUM_CORES           1
 #define MAX_NUM_CORES               8
@@ -163,7 +166,7 @@ extern "C" {
 #define ENABLE_DYNAMIC_DEGRADE      0
 #endif
 
-#define DEFAULT_CHROMA_FMT  IV_YUV_420P
+#define DEFAULT_CHROMA_FMT  IV_YUV_420SP_UV
 #define DUMP_INPUT 0
 #define DUMP_INPUT_PATH "inp.raw"
 #define DUMP_INPUT_UNPARSED_PATH  "inp_unparsed.raw"
@@ -239,6 +242,31 @@ void ih264a_aligned_free(void *pv_buf);
 
 
 typedef int64_t  mtime_t;
+
+/* Display buffer shared with the decoder and lent out through an AVFrame */
+typedef struct
+{
+    UWORD8                      *pu1_buf;
+    AVBufferRef                 *ps_pool_ref;
+} disp_buf_entry_t;
+
+/* Refcounted pool of shared display buffers; outlives the plugin context */
+/* until the last AVFrame that borrowed one of its buffers is unreferenced */
+typedef struct
+{
+    UWORD32                     u4_num_bufs;
+    UWORD32                     u4_buf_size;
+    /* Buffers held by the application and the most it may hold before */
+    /* outputs are copied instead, so that the decoder is not starved   */
+    UWORD32                     u4_num_lent;
+    UWORD32                     u4_max_lent;
+    disp_buf_entry_t            as_entry[MAX_DISP_BUFFERS];
+    /* Buffers dropped by the application, released to the decoder by the */
+    /* decode thread as ih264d_rel_display_frame is not thread safe        */
+    UWORD8                      au1_rel_pending[MAX_DISP_BUFFERS];
+    void                        *pv_mutex;
+} disp_buf_pool_t;
+
 typedef struct ctxt_t
 {
 	const AVClass               *class;
@@ -277,6 +305,7 @@ typedef struct ctxt_t
     WORD32  					i4_num_disp_bufs;
     WORD32  					i4_cur_disp_buf;
     AVFrame 					*ps_disp_buf[MAX_DISP_BUFFERS];
+    AVBufferRef 				*ps_disp_pool;
     // TIMER   					first_pic_display_time;
     WORD32  					i4_first_pic_display_time_set;
     WORD32  					i4_expected_time;
@@ -285,7 +314,7 @@ typedef struct ctxt_t
     WORD32  					i4_skipb_enabled;
     UWORD32 					u4_max_num_frm_parse;
     WORD32  					i4_output_present;
-    AVPacket 					avpkt;
+    AVPacket 					*ps_in_pkt;
     AVFrame  					*disp_pic;
     WORD32  					i4_disp_strd;
     void    					*pv_disp_buf[3];
@@ -294,6 +323,21 @@ typedef struct ctxt_t
     void    					*pv_thread_handle;
     WORD32  					i4_thread_created;
     WORD32  					i4_thread_enable;
+    /* Queues shared by receive_frame and the persistent decode thread; */
+    /* all fields below are protected by pv_queue_mutex                 */
+    void    					*pv_queue_mutex;
+    void    					*pv_worker_cond;
+    void    					*pv_caller_cond;
+    AVPacket 					*aps_pkt_queue[PKT_QUEUE_SIZE];
+    WORD32  					i4_pkt_rd_idx;
+    WORD32  					i4_pkt_cnt;
+    AVFrame  					*aps_frm_queue[FRM_QUEUE_SIZE];
+    WORD32  					i4_frm_rd_idx;
+    WORD32  					i4_frm_cnt;
+    WORD32  					i4_worker_busy;
+    WORD32  					i4_worker_exit;
+    WORD32  					i4_eos_sent;
+    WORD32  					i4_eos_done;
 #ifdef PROFILE_ENABLE
     // TIMER   					s_last_end_timer;
     UWORD32 					u4_tot_cycles;
@@ -48,6 +48,7 @@
 
 #include "libavutil/attributes.h"
 #include "libavutil/common.h"
+#include "libavutil/imgutils.h"
 #include "libavutil/internal.h"
 #include "libavutil/md5.h"
 #include "libavutil/opt.h"
@@ -56,6 +57,7 @@
 #include "libavcodec/avcodec.h"
 #include "libavcodec/internal.h"
 #include "codec_internal.h"
+#include "decode.h"
 #include "itypedefs.h"
 #include "config.h"
 
@@ -84,7 +86,7 @@
 #define MAX_LEVEL_SUPPORTED         50
 #define MAX_REF_FRAMES              16
 #define MAX_REORDER_FRAMES          16
-#define DEFAULT_SHARE_DISPLAY_BUF   0
+#define DEFAULT_SHARE_DISPLAY_BUF   1
 #define STRIDE                      0
 #define DEFAULT_NUM_CORES           1
 
@@ -95,6 +97,8 @@
 #define ENABLE_DEGRADE 0
 #define MAX_DISP_BUFFERS    64
 #define EXTRA_DISP_BUFFERS  8
+/* Decoder is only sure to spare one buffer beyond the ones it is holding */
+#define MAX_LENT_DISP_BUFFERS 1
 #define STRLENGTH 1000
 
 #define DUMP_SINGLE_BUF 0
@@ -227,6 +231,31 @@ static void ivd_plugin_free(ctxt_t *ps_ctxt)
     iv_mem_rec_t *ps_mem_rec;
     UWORD32 i;
 
+    /* Stop the decode thread before the decoder memory goes away */
+    if(ps_ctxt->i4_thread_created)
+    {
+        ithread_mutex_lock(ps_ctxt->pv_queue_mutex);
+        ps_ctxt->i4_worker_exit = 1;
+        ithread_cond_broadcast(ps_ctxt->pv_worker_cond);
+        ithread_mutex_unlock(ps_ctxt->pv_queue_mutex);
+
+        ithread_join(ps_ctxt->pv_thread_handle, NULL);
+        ps_ctxt->i4_thread_created = 0;
+    }
+    while(ps_ctxt->i4_pkt_cnt)
+    {
+        av_packet_free(&ps_ctxt->aps_pkt_queue[ps_ctxt->i4_pkt_rd_idx]);
+        ps_ctxt->i4_pkt_rd_idx = (ps_ctxt->i4_pkt_rd_idx + 1) % PKT_QUEUE_SIZE;
+        ps_ctxt->i4_pkt_cnt--;
+    }
+    while(ps_ctxt->i4_frm_cnt)
+    {
+        av_frame_free(&ps_ctxt->aps_frm_queue[ps_ctxt->i4_frm_rd_idx]);
+        ps_ctxt->i4_frm_rd_idx = (ps_ctxt->i4_frm_rd_idx + 1) % FRM_QUEUE_SIZE;
+        ps_ctxt->i4_frm_cnt--;
+    }
+    av_packet_free(&ps_ctxt->ps_in_pkt);
+
     ps_mem_rec = (iv_mem_rec_t*)ps_ctxt->pv_mem_rec_location;
 
     for(i = 0; i < ps_ctxt->u4_num_mem_rec; i++)
@@ -254,6 +283,23 @@ static void ivd_plugin_free(ctxt_t *ps_ctxt)
         ih264a_aligned_free(ps_ctxt->pv_thread_handle);
         ps_ctxt->pv_thread_handle = NULL;
     }
+    if(ps_ctxt->pv_queue_mutex)
+    {
+        ithread_mutex_destroy(ps_ctxt->pv_queue_mutex);
+        av_freep(&ps_ctxt->pv_queue_mutex);
+    }
+    if(ps_ctxt->pv_worker_cond)
+    {
+        ithread_cond_destroy(ps_ctxt->pv_worker_cond);
+        av_freep(&ps_ctxt->pv_worker_cond);
+    }
+    if(ps_ctxt->pv_caller_cond)
+    {
+        ithread_cond_destroy(ps_ctxt->pv_caller_cond);
+        av_freep(&ps_ctxt->pv_caller_cond);
+    }
+    /* Pool stays alive till the application drops the frames it holds */
+    av_buffer_unref(&ps_ctxt->ps_disp_pool);
 
 
     return;
@@ -722,6 +768,11 @@ static WORD32 ih264d_create(ctxt_t *ps_ctxt)
             s_fill_mem_rec_ip.e_output_format =
                             (IV_COLOR_FORMAT_T)ps_ctxt->e_output_chroma_format;
             s_fill_mem_rec_ip.u4_num_extra_disp_buf = EXTRA_DISP_BUFFERS;
+            s_fill_mem_rec_ip.u4_alloc_per_sps = 0;
+            s_fill_mem_rec_ip.pe_mem_placement = NULL;
+            s_fill_mem_rec_ip.u4_mem_budget = 0;
+            s_fill_mem_rec_ip.u4_film_grain = 0;
+            s_fill_mem_rec_ip.u4_intra_only = 0;
 
             s_fill_mem_rec_ip.s_ivd_fill_mem_rec_ip_t.u4_size =
                             sizeof(ih264d_fill_mem_rec_ip_t);
@@ -789,6 +840,10 @@ static WORD32 ih264d_create(ctxt_t *ps_ctxt)
             s_init_ip.u4_num_reorder_frames = MAX_REORDER_FRAMES;
             s_init_ip.u4_share_disp_buf = ps_ctxt->share_disp_buf;
             s_init_ip.u4_num_extra_disp_buf = EXTRA_DISP_BUFFERS;
+            s_init_ip.u4_alloc_per_sps = 0;
+            s_init_ip.u4_mem_budget = 0;
+            s_init_ip.u4_film_grain = 0;
+            s_init_ip.u4_intra_only = 0;
             s_init_ip.s_ivd_init_ip_t.u4_num_mem_rec = ps_ctxt->u4_num_mem_rec;
 
             s_init_ip.s_ivd_init_ip_t.e_output_format =
@@ -956,6 +1011,307 @@ static void set_app_params(ctxt_t *ps_ctxt)
     return;
 }
 
+/**
+*******************************************************************************
+*
+* @brief
+* Free the shared display buffer pool
+*
+* @par   Description
+* Called once the plugin and every AVFrame that borrowed a display buffer
+* have dropped their reference to the pool
+*
+* @param[in] opaque
+* Unused
+*
+* @param[in] data
+* Display buffer pool
+*
+* @returns None
+*
+* @remarks
+*
+*******************************************************************************
+*/
+static void ivd_ff_disp_pool_free(void *opaque, uint8_t *data)
+{
+    disp_buf_pool_t *ps_pool = (disp_buf_pool_t *)data;
+    UWORD32 i;
+
+    UNUSED(opaque);
+    for(i = 0; i < ps_pool->u4_num_bufs; i++)
+    {
+        av_freep(&ps_pool->as_entry[i].pu1_buf);
+    }
+    if(ps_pool->pv_mutex)
+    {
+        ithread_mutex_destroy(ps_pool->pv_mutex);
+        av_freep(&ps_pool->pv_mutex);
+    }
+    av_free(ps_pool);
+}
+
+/**
+*******************************************************************************
+*
+* @brief
+* AVBufferRef free callback of a display buffer
+*
+* @par   Description
+* Marks the display buffer for release to the decoder. The release itself is
+* done by the decode thread in ivd_ff_rel_disp_bufs(), as the last reference
+* can be dropped from any thread, even after the decoder is closed
+*
+* @param[in] opaque
+* Display buffer entry
+*
+* @param[in] data
+* Display buffer
+*
+* @returns None
+*
+* @remarks
+*
+*******************************************************************************
+*/
+static void ivd_ff_disp_buf_free(void *opaque, uint8_t *data)
+{
+    disp_buf_entry_t *ps_entry = (disp_buf_entry_t *)opaque;
+    AVBufferRef *ps_pool_ref = ps_entry->ps_pool_ref;
+    disp_buf_pool_t *ps_pool = (disp_buf_pool_t *)ps_pool_ref->data;
+
+    UNUSED(data);
+    ithread_mutex_lock(ps_pool->pv_mutex);
+    ps_pool->au1_rel_pending[ps_entry - ps_pool->as_entry] = 1;
+    ps_pool->u4_num_lent--;
+    ps_entry->ps_pool_ref = NULL;
+    ithread_mutex_unlock(ps_pool->pv_mutex);
+
+    /* May free the pool, so entry is not to be accessed after this */
+    av_buffer_unref(&ps_pool_ref);
+}
+
+/**
+*******************************************************************************
+*
+* @brief
+* Release display buffers dropped by the application
+*
+* @par   Description
+* Returns every display buffer whose AVFrame was unreferenced since the last
+* call to the decoder through ih264d_rel_display_frame
+*
+* @param[in] ps_ctxt
+* Plugin context
+*
+* @returns None
+*
+* @remarks
+* Has to be called from the thread that calls decode
+*
+*******************************************************************************
+*/
+static void ivd_ff_rel_disp_bufs(ctxt_t *ps_ctxt)
+{
+    disp_buf_pool_t *ps_pool;
+    UWORD32 i;
+
+    if(NULL == ps_ctxt->ps_disp_pool)
+        return;
+
+    ps_pool = (disp_buf_pool_t *)ps_ctxt->ps_disp_pool->data;
+    ithread_mutex_lock(ps_pool->pv_mutex);
+    for(i = 0; i < ps_pool->u4_num_bufs; i++)
+    {
+        ivd_rel_display_frame_ip_t s_rel_ip;
+        ivd_rel_display_frame_op_t s_rel_op;
+        IV_API_CALL_STATUS_T ret;
+
+        if(0 == ps_pool->au1_rel_pending[i])
+            continue;
+
+        ps_pool->au1_rel_pending[i] = 0;
+        s_rel_ip.e_cmd = IVD_CMD_REL_DISPLAY_FRAME;
+        s_rel_ip.u4_size = sizeof(ivd_rel_display_frame_ip_t);
+        s_rel_ip.u4_disp_buf_id = i;
+        s_rel_op.u4_size = sizeof(ivd_rel_display_frame_op_t);
+
+        ret = ivd_api_function((iv_obj_t *)ps_ctxt->ps_codec_obj,
+            (void *)&s_rel_ip, (void *)&s_rel_op);
+        if(ret != IV_SUCCESS)
+        {
+            LOGE(ps_ctxt, 0, "Error in release display frame %d : %x",
+                i, s_rel_op.u4_error_code);
+        }
+    }
+    ithread_mutex_unlock(ps_pool->pv_mutex);
+}
+
+/**
+*******************************************************************************
+*
+* @brief
+* Reclaim display buffers at the end of a flush
+*
+* @par   Description
+* Once flush completes, the decoder takes every shared buffer back out of
+* circulation till it is released again. Marks all buffers the application
+* does not hold for release so that they reach the decoder before the next
+* decode call
+*
+* @param[in] ps_ctxt
+* Plugin context
+*
+* @returns None
+*
+* @remarks
+* Buffers still held by the application are released when their AVFrame is
+* unreferenced
+*
+*******************************************************************************
+*/
+static void ivd_ff_reclaim_disp_bufs(ctxt_t *ps_ctxt)
+{
+    disp_buf_pool_t *ps_pool;
+    UWORD32 i;
+
+    if(NULL == ps_ctxt->ps_disp_pool)
+        return;
+
+    ps_pool = (disp_buf_pool_t *)ps_ctxt->ps_disp_pool->data;
+    ithread_mutex_lock(ps_pool->pv_mutex);
+    for(i = 0; i < ps_pool->u4_num_bufs; i++)
+    {
+        if(NULL == ps_pool->as_entry[i].ps_pool_ref)
+            ps_pool->au1_rel_pending[i] = 1;
+    }
+    ithread_mutex_unlock(ps_pool->pv_mutex);
+}
+
+/**
+*******************************************************************************
+*
+* @brief
+* Register shared display buffers with the decoder
+*
+* @par   Description
+* Allocates a refcounted pool of display buffers sized for the stream, hands
+* them to the decoder as its display/reference buffers and releases all of
+* them so that the decoder can start using them
+*
+* @param[in] ps_ctxt
+* Plugin context
+*
+* @returns 0 on success, -1 on error
+*
+* @remarks
+* Buffer sizes are known only after the header is decoded
+*
+*******************************************************************************
+*/
+static int ivd_ff_set_disp_bufs(ctxt_t *ps_ctxt)
+{
+    ivd_ctl_getbufinfo_ip_t s_ctl_ip;
+    ivd_ctl_getbufinfo_op_t s_ctl_op;
+    ivd_set_display_frame_ip_t *ps_set_disp_ip;
+    ivd_set_display_frame_op_t s_set_disp_op;
+    disp_buf_pool_t *ps_pool;
+    IV_API_CALL_STATUS_T ret;
+    UWORD32 num_bufs;
+    UWORD32 i;
+
+    s_ctl_ip.e_cmd = IVD_CMD_VIDEO_CTL;
+    s_ctl_ip.e_sub_cmd = IVD_CMD_CTL_GETBUFINFO;
+    s_ctl_ip.u4_size = sizeof(ivd_ctl_getbufinfo_ip_t);
+    s_ctl_op.u4_size = sizeof(ivd_ctl_getbufinfo_op_t);
+    ret = ivd_api_function((iv_obj_t *)ps_ctxt->ps_codec_obj,
+        (void *)&s_ctl_ip, (void *)&s_ctl_op);
+    if(ret != IV_SUCCESS)
+    {
+        LOGE(ps_ctxt, 0, "Error in Get Buf Info %x", s_ctl_op.u4_error_code);
+        return -1;
+    }
+
+    ps_pool = av_mallocz(sizeof(disp_buf_pool_t));
+    if(NULL == ps_pool)
+        return -1;
+
+    ps_pool->pv_mutex = av_malloc(ithread_get_mutex_lock_size());
+    if(NULL == ps_pool->pv_mutex)
+    {
+        av_free(ps_pool);
+        return -1;
+    }
+    ithread_mutex_init(ps_pool->pv_mutex);
+
+    ps_ctxt->ps_disp_pool = av_buffer_create((uint8_t *)ps_pool,
+        sizeof(disp_buf_pool_t), ivd_ff_disp_pool_free, NULL, 0);
+    if(NULL == ps_ctxt->ps_disp_pool)
+    {
+        ivd_ff_disp_pool_free(NULL, (uint8_t *)ps_pool);
+        return -1;
+    }
+
+    /* Too large to be kept on the stack of a decode thread */
+    ps_set_disp_ip = av_mallocz(sizeof(ivd_set_display_frame_ip_t));
+    if(NULL == ps_set_disp_ip)
+        return -1;
+
+    ps_pool->u4_max_lent = MAX_LENT_DISP_BUFFERS;
+
+    /* Luma followed by interleaved chroma in a single buffer */
+    ps_pool->u4_buf_size = s_ctl_op.u4_min_out_buf_size[0]
+        + s_ctl_op.u4_min_out_buf_size[1];
+    num_bufs = MIN(s_ctl_op.u4_num_disp_bufs, MAX_DISP_BUFFERS);
+
+    for(i = 0; i < num_bufs; i++)
+    {
+        ivd_out_bufdesc_t *ps_disp_buf = &ps_set_disp_ip->s_disp_buffer[i];
+        UWORD8 *pu1_buf = av_malloc(ps_pool->u4_buf_size);
+
+        if(NULL == pu1_buf)
+        {
+            LOGE(ps_ctxt, 0, "Allocation failure for display buffer of size %d",
+                ps_pool->u4_buf_size);
+            av_free(ps_set_disp_ip);
+            return -1;
+        }
+        ps_pool->as_entry[i].pu1_buf = pu1_buf;
+        ps_pool->u4_num_bufs++;
+
+        ps_disp_buf->u4_min_out_buf_size[0] = s_ctl_op.u4_min_out_buf_size[0];
+        ps_disp_buf->u4_min_out_buf_size[1] = s_ctl_op.u4_min_out_buf_size[1];
+        ps_disp_buf->pu1_bufs[0] = pu1_buf;
+        ps_disp_buf->pu1_bufs[1] = pu1_buf + s_ctl_op.u4_min_out_buf_size[0];
+        ps_disp_buf->u4_num_bufs = s_ctl_op.u4_min_num_out_bufs;
+    }
+
+    ps_set_disp_ip->e_cmd = IVD_CMD_SET_DISPLAY_FRAME;
+    ps_set_disp_ip->u4_size = sizeof(ivd_set_display_frame_ip_t);
+    ps_set_disp_ip->num_disp_bufs = ps_pool->u4_num_bufs;
+    s_set_disp_op.u4_size = sizeof(ivd_set_display_frame_op_t);
+
+    ret = ivd_api_function((iv_obj_t *)ps_ctxt->ps_codec_obj,
+        (void *)ps_set_disp_ip, (void *)&s_set_disp_op);
+    av_free(ps_set_disp_ip);
+    if(ret != IV_SUCCESS)
+    {
+        LOGE(ps_ctxt, 0, "Error in Set Display Frame %x",
+            s_set_disp_op.u4_error_code);
+        return -1;
+    }
+    ps_ctxt->num_disp_buf = ps_pool->u4_num_bufs;
+    LOGI(ps_ctxt, 0, "Registered %d display buffers of size %d",
+        ps_pool->u4_num_bufs, ps_pool->u4_buf_size);
+
+    /* Registered buffers start out held by the application */
+    for(i = 0; i < ps_pool->u4_num_bufs; i++)
+        ps_pool->au1_rel_pending[i] = 1;
+    ivd_ff_rel_disp_bufs(ps_ctxt);
+
+    return 0;
+}
+
 /**
 *******************************************************************************
 *
@@ -1052,6 +1408,10 @@ static int ivd_h264_header_decode(ctxt_t *ps_ctxt,
             ps_ctxt->i4_pic_ht = s_video_decode_op.u4_pic_ht;
 
             ps_ctxt->avctx->pix_fmt = AV_PIX_FMT_YUV420P;
+            if(IV_YUV_420SP_UV == ps_ctxt->e_output_chroma_format)
+                ps_ctxt->avctx->pix_fmt = AV_PIX_FMT_NV12;
+            else if(IV_YUV_420SP_VU == ps_ctxt->e_output_chroma_format)
+                ps_ctxt->avctx->pix_fmt = AV_PIX_FMT_NV21;
 
             ps_ctxt->e_output_format = s_video_decode_op.e_output_format;
 
@@ -1059,6 +1419,16 @@ static int ivd_h264_header_decode(ctxt_t *ps_ctxt,
             {
                 ps_ctxt->i4_header_done = 1;
                 set_app_params(ps_ctxt);
+
+                /* Decoder renders straight into buffers lent out as AVFrames */
+                if(ps_ctxt->share_disp_buf && (NULL == ps_ctxt->ps_disp_pool))
+                {
+                    if(ivd_ff_set_disp_bufs(ps_ctxt) < 0)
+                    {
+                        LOGE(ps_ctxt, 100, "Error in setting display buffers");
+                        return -1;
+                    }
+                }
             }
 
     {
@@ -1171,6 +1541,99 @@ static AVFrame *ivd_ff_get_disp_pic(ctxt_t *ps_ctxt)
 
 }
 
+/**
+*******************************************************************************
+*
+* @brief
+* Wrap a shared display buffer returned by the decoder in the display picture
+*
+* @par   Description
+* Display picture borrows the decoder's buffer without a copy. The buffer goes
+* back to the decoder once the last reference to the AVFrame is dropped.
+* If the application already holds as many buffers as the decoder can spare,
+* the output is copied to a buffer from ffmpeg and returned right away
+*
+* @param[in] ps_ctxt
+* Plugin context
+*
+* @param[in] ps_dec_op
+* Decode output structure
+*
+* @returns 0 on success, AVERROR on error
+*
+* @remarks
+*
+*******************************************************************************
+*/
+static int ivd_ff_wrap_disp_buf(ctxt_t *ps_ctxt,
+    ivd_video_decode_op_t *ps_dec_op)
+{
+    disp_buf_pool_t *ps_pool = (disp_buf_pool_t *)ps_ctxt->ps_disp_pool->data;
+    UWORD32 u4_buf_id = ps_dec_op->u4_disp_buf_id;
+    disp_buf_entry_t *ps_entry = &ps_pool->as_entry[u4_buf_id];
+    AVFrame *disp_pic = ps_ctxt->disp_pic;
+    uint8_t *apu1_src[4] = { NULL };
+    int ai4_src_strd[4] = { 0 };
+    WORD32 lend;
+
+    apu1_src[0] = ps_dec_op->s_disp_frm_buf.pv_y_buf;
+    apu1_src[1] = ps_dec_op->s_disp_frm_buf.pv_u_buf;
+    ai4_src_strd[0] = ps_dec_op->s_disp_frm_buf.u4_y_strd;
+    ai4_src_strd[1] = ps_dec_op->s_disp_frm_buf.u4_u_strd;
+
+    ithread_mutex_lock(ps_pool->pv_mutex);
+    lend = (ps_pool->u4_num_lent < ps_pool->u4_max_lent);
+    if(lend)
+        ps_pool->u4_num_lent++;
+    ithread_mutex_unlock(ps_pool->pv_mutex);
+
+    if(0 == lend)
+    {
+        WORD32 ret = ff_get_buffer(ps_ctxt->avctx, disp_pic, 0);
+
+        if(0 == ret)
+        {
+            av_image_copy(disp_pic->data, disp_pic->linesize,
+                (const uint8_t **)apu1_src, ai4_src_strd,
+                disp_pic->format, disp_pic->width, disp_pic->height);
+        }
+
+        ithread_mutex_lock(ps_pool->pv_mutex);
+        ps_pool->au1_rel_pending[u4_buf_id] = 1;
+        ithread_mutex_unlock(ps_pool->pv_mutex);
+        return ret;
+    }
+
+    ps_entry->ps_pool_ref = av_buffer_ref(ps_ctxt->ps_disp_pool);
+    if(NULL == ps_entry->ps_pool_ref)
+    {
+        ithread_mutex_lock(ps_pool->pv_mutex);
+        ps_pool->au1_rel_pending[u4_buf_id] = 1;
+        ps_pool->u4_num_lent--;
+        ithread_mutex_unlock(ps_pool->pv_mutex);
+        return AVERROR(ENOMEM);
+    }
+
+    /* Decoder reads the buffer as a reference, application must not write */
+    disp_pic->buf[0] = av_buffer_create(ps_entry->pu1_buf, ps_pool->u4_buf_size,
+        ivd_ff_disp_buf_free, ps_entry, AV_BUFFER_FLAG_READONLY);
+    if(NULL == disp_pic->buf[0])
+    {
+        ivd_ff_disp_buf_free(ps_entry, NULL);
+        return AVERROR(ENOMEM);
+    }
+
+    disp_pic->format = ps_ctxt->avctx->pix_fmt;
+    disp_pic->width = ps_dec_op->s_disp_frm_buf.u4_y_wd;
+    disp_pic->height = ps_dec_op->s_disp_frm_buf.u4_y_ht;
+    disp_pic->data[0] = apu1_src[0];
+    disp_pic->data[1] = apu1_src[1];
+    disp_pic->linesize[0] = ai4_src_strd[0];
+    disp_pic->linesize[1] = ai4_src_strd[1];
+
+    return 0;
+}
+
 /**
 *******************************************************************************
 *
@@ -1229,9 +1692,6 @@ static int ivd_h264_decode_frame(ctxt_t *ps_ctxt)
         if((0 == ps_ctxt->i4_header_done) || (4 > ps_ctxt->u4_num_bytes))
         {
             LOGE(ps_ctxt, 0, "Header decode failed");
-            if(ps_ctxt->i4_thread_created)
-                ithread_exit(0);
-
             return AVERROR_INVALIDDATA;
         }
     }
@@ -1252,7 +1712,16 @@ static int ivd_h264_decode_frame(ctxt_t *ps_ctxt)
         ps_ctxt->ai4_timestamp_valid[timestamp_id] = 1;
     }
 
-    ps_ctxt->disp_pic = ivd_ff_get_disp_pic(ps_ctxt);
+    if(ps_ctxt->share_disp_buf)
+    {
+        /* Filled from the shared display buffer the decoder outputs */
+        ivd_ff_rel_disp_bufs(ps_ctxt);
+        ps_ctxt->disp_pic = av_frame_alloc();
+    }
+    else
+    {
+        ps_ctxt->disp_pic = ivd_ff_get_disp_pic(ps_ctxt);
+    }
 
     {
         ivd_ctl_set_config_ip_t s_ctl_ip;
@@ -1278,11 +1747,6 @@ static int ivd_h264_decode_frame(ctxt_t *ps_ctxt)
             LOGE(ps_ctxt, 100,
                 "\nError in setting the codec in frame decode mode 0x%x",
                 s_ctl_op.u4_error_code);
-            if(ps_ctxt->i4_thread_created)
-            {
-                ithread_exit(0);
-            }
-
             return ps_ctxt->u4_num_bytes;
         }
     }
@@ -1342,6 +1806,10 @@ static int ivd_h264_decode_frame(ctxt_t *ps_ctxt)
         s_video_decode_ip.s_out_buffer.pu1_bufs[2] = ps_ctxt->pv_disp_buf[2];
         s_video_decode_ip.s_out_buffer.u4_num_bufs = 3;
 
+        /* Shared display buffers were registered in ivd_ff_set_disp_bufs() */
+        if(ps_ctxt->share_disp_buf)
+            memset(&s_video_decode_ip.s_out_buffer, 0, sizeof(ivd_out_bufdesc_t));
+
         s_video_decode_op.u4_size = sizeof(ivd_video_decode_op_t);
         s_video_decode_op.s_sei_decode_op.u1_sei_mdcv_params_present_flag = 0;
         s_video_decode_op.s_sei_decode_op.u1_sei_cll_params_present_flag = 0;
@@ -1390,6 +1858,18 @@ static int ivd_h264_decode_frame(ctxt_t *ps_ctxt)
         {
             LOGI(ps_ctxt, 0, "Error in video Frame decode : ret %x Error %x\n",
                 ret, s_video_decode_op.u4_error_code);
+            /* Lend out fewer buffers from here on */
+            if(IVD_DEC_REF_BUF_NULL == (s_video_decode_op.u4_error_code & 0xFF))
+            {
+                disp_buf_pool_t *ps_pool =
+                    (disp_buf_pool_t *)ps_ctxt->ps_disp_pool->data;
+
+                ithread_mutex_lock(ps_pool->pv_mutex);
+                if(ps_pool->u4_num_lent)
+                    ps_pool->u4_max_lent = ps_pool->u4_num_lent - 1;
+                ithread_mutex_unlock(ps_pool->pv_mutex);
+                LOGE(ps_ctxt, 0, "Display buffers held by the application starved the decoder");
+            }
 
             //TODO Handle change in resolution by flushing the decoder output and calling reset
         }
@@ -1515,12 +1995,15 @@ static int ivd_h264_decode_frame(ctxt_t *ps_ctxt)
                 ps_ctxt->i4_annexb_ts += ps_ctxt->i4_pic_duration;
             }
             ps_ctxt->i4_output_present = 1;
+            if(ps_ctxt->share_disp_buf)
+            {
+                if(ivd_ff_wrap_disp_buf(ps_ctxt, &s_video_decode_op) < 0)
+                    ps_ctxt->i4_output_present = 0;
+            }
             ivd_set_lateness(ps_ctxt, ps_ctxt->out_pts);
         }
     }
 
-    if(ps_ctxt->i4_thread_created)
-        ithread_exit(0);
     return ps_ctxt->u4_num_bytes;
 }
 
@@ -1641,82 +2124,365 @@ static void ih264_get_input(ctxt_t *ps_ctxt, UWORD8 *pu1_buf, WORD32 i4_size)
 *******************************************************************************
 *
 * @brief
-*  Plugin's entry point for Decode picture
+* Queue a packet for the decode thread
 *
 * @par   Description
-* Get input and call decode frame. If threading is enabled call decode in a different thread
+* Adds a packet to the packet queue and wakes up the decode thread. A NULL
+* packet marks end of stream
 *
-* @param[in] avctx
-* Framework context
+* @param[in] ps_ctxt
+* Plugin context
 *
-* @param[in] data
-* Output pointer
+* @param[in] ps_pkt
+* Packet to be decoded, ownership passes to the queue
+*
+* @returns None
+*
+* @remarks
+* Has to be called with the queue mutex held and with room in the queue
+*
+*******************************************************************************
+*/
+static void ivd_ff_queue_packet(ctxt_t *ps_ctxt, AVPacket *ps_pkt)
+{
+    WORD32 idx;
+
+    idx = (ps_ctxt->i4_pkt_rd_idx + ps_ctxt->i4_pkt_cnt) % PKT_QUEUE_SIZE;
+    ps_ctxt->aps_pkt_queue[idx] = ps_pkt;
+    ps_ctxt->i4_pkt_cnt++;
+    ithread_cond_broadcast(ps_ctxt->pv_worker_cond);
+}
+
+/**
+*******************************************************************************
 *
-* @param[in] got_output
-* Flag to signal if output is present
+* @brief
+* Queue a decoded picture for receive_frame
 *
-* @param[in] avpkt
-* Input buffer structure
+* @par   Description
+* Waits for room in the frame queue while the application is behind. The
+* picture is dropped if the decode thread is asked to exit meanwhile
 *
-* @returns Number of bytes consumed
+* @param[in] ps_ctxt
+* Plugin context
+*
+* @param[in] ps_frame
+* Decoded picture, ownership passes to the queue
+*
+* @returns None
 *
 * @remarks
 *
 *******************************************************************************
 */
-static int ih264_decode_frame_wrapper(AVCodecContext *avctx,
-    AVFrame *data,
-    int *got_output,
-    AVPacket *avpkt)
+static void ivd_ff_queue_frame(ctxt_t *ps_ctxt, AVFrame *ps_frame)
 {
-    ctxt_t *ps_ctxt = avctx->priv_data;
-    int ret;
+    ithread_mutex_lock(ps_ctxt->pv_queue_mutex);
+    while((FRM_QUEUE_SIZE == ps_ctxt->i4_frm_cnt)
+        && (0 == ps_ctxt->i4_worker_exit))
+    {
+        ithread_cond_wait(ps_ctxt->pv_worker_cond, ps_ctxt->pv_queue_mutex);
+    }
 
-    *got_output = 0;
-    if(ps_ctxt->i4_thread_created)
+    if(ps_ctxt->i4_worker_exit)
     {
-        ithread_join(ps_ctxt->pv_thread_handle, NULL);
-        ps_ctxt->i4_thread_created = 0;
+        av_frame_free(&ps_frame);
+    }
+    else
+    {
+        WORD32 idx;
 
-        if(ps_ctxt->i4_output_present)
-        {
-            av_frame_move_ref(data, ps_ctxt->disp_pic);
-            *got_output = 1;
-        }
+        idx = (ps_ctxt->i4_frm_rd_idx + ps_ctxt->i4_frm_cnt) % FRM_QUEUE_SIZE;
+        ps_ctxt->aps_frm_queue[idx] = ps_frame;
+        ps_ctxt->i4_frm_cnt++;
+        ithread_cond_broadcast(ps_ctxt->pv_caller_cond);
+    }
+    ithread_mutex_unlock(ps_ctxt->pv_queue_mutex);
+}
 
+/**
+*******************************************************************************
+*
+* @brief
+* Drop all queued pictures
+*
+* @par   Description
+* Frees the pictures in the frame queue and wakes up the decode thread in
+* case it is waiting for room
+*
+* @param[in] ps_ctxt
+* Plugin context
+*
+* @returns None
+*
+* @remarks
+* Has to be called with the queue mutex held
+*
+*******************************************************************************
+*/
+static void ivd_ff_drop_frames(ctxt_t *ps_ctxt)
+{
+    while(ps_ctxt->i4_frm_cnt)
+    {
+        av_frame_free(&ps_ctxt->aps_frm_queue[ps_ctxt->i4_frm_rd_idx]);
+        ps_ctxt->i4_frm_rd_idx = (ps_ctxt->i4_frm_rd_idx + 1) % FRM_QUEUE_SIZE;
+        ps_ctxt->i4_frm_cnt--;
     }
-    ps_ctxt->avpkt = *avpkt;
+    ithread_cond_broadcast(ps_ctxt->pv_worker_cond);
+}
 
-    ps_ctxt->in_pts = avpkt->pts;
-    ih264_get_input(ps_ctxt, avpkt->data, avpkt->size);
+/**
+*******************************************************************************
+*
+* @brief
+* Decode a packet and queue its output
+*
+* @par   Description
+* Copies the packet to the input buffer, decodes it and queues the picture
+* output if any. A NULL packet outputs one of the pictures held by the
+* decoder in flush mode
+*
+* @param[in] ps_ctxt
+* Plugin context
+*
+* @param[in] ps_pkt
+* Packet to be decoded, NULL to flush
+*
+* @returns 1 if a picture was output, 0 otherwise
+*
+* @remarks
+* Only one thread decodes at a time, either the decode thread or the caller
+* of receive_frame when there is no decode thread
+*
+*******************************************************************************
+*/
+static WORD32 ivd_ff_decode_packet(ctxt_t *ps_ctxt, AVPacket *ps_pkt)
+{
+    WORD32 output_present;
 
-    if(ps_ctxt->i4_thread_enable && ps_ctxt->i4_num_cores > 1)
+    if(NULL != ps_pkt)
+    {
+        ps_ctxt->in_pts = ps_pkt->pts;
+        ih264_get_input(ps_ctxt, ps_pkt->data, ps_pkt->size);
+    }
+    else
     {
+        /* Nothing is held by the decoder before the headers */
+        if(0 == ps_ctxt->i4_header_done)
+            return 0;
 
-        ithread_create(ps_ctxt->pv_thread_handle, NULL,
-            (void *)&ivd_h264_decode_frame, (void *)ps_ctxt);
-        ps_ctxt->i4_thread_created = 1;
+        ps_ctxt->pu1_inp = ps_ctxt->pu1_bits_base;
+        ps_ctxt->u4_num_bytes = 0;
+    }
 
+    if(ivd_h264_decode_frame(ps_ctxt) < 0)
+    {
+        LOGE(ps_ctxt, 0, "Error in decoding packet");
+    }
+
+    output_present = ps_ctxt->i4_output_present;
+    if(output_present)
+    {
+        ps_ctxt->disp_pic->pts = ps_ctxt->out_pts;
+        ivd_ff_queue_frame(ps_ctxt, ps_ctxt->disp_pic);
+        ps_ctxt->disp_pic = NULL;
     }
     else
     {
-        ret = ivd_h264_decode_frame(ps_ctxt);
+        av_frame_free(&ps_ctxt->disp_pic);
 
-        if(ps_ctxt->i4_output_present)
+        /* Flush completes when there is nothing more to output */
+        if((NULL == ps_pkt) && ps_ctxt->share_disp_buf)
+            ivd_ff_reclaim_disp_bufs(ps_ctxt);
+    }
+
+    return output_present;
+}
+
+/**
+*******************************************************************************
+*
+* @brief
+* Persistent decode thread
+*
+* @par   Description
+* Decodes packets from the packet queue till asked to exit, so that demux,
+* decode and the application's processing of earlier pictures overlap. On
+* end of stream, drains all the pictures held by the decoder
+*
+* @param[in] pv_ctxt
+* Plugin context
+*
+* @returns NULL
+*
+* @remarks
+*
+*******************************************************************************
+*/
+static void *ivd_ff_decode_thread(void *pv_ctxt)
+{
+    ctxt_t *ps_ctxt = (ctxt_t *)pv_ctxt;
+
+    while(1)
+    {
+        AVPacket *ps_pkt;
+        WORD32 eos;
+
+        ithread_mutex_lock(ps_ctxt->pv_queue_mutex);
+        while((0 == ps_ctxt->i4_pkt_cnt) && (0 == ps_ctxt->i4_worker_exit))
         {
-            ps_ctxt->disp_pic->pts = ps_ctxt->out_pts;
-            av_frame_move_ref(data, ps_ctxt->disp_pic);
+            ithread_cond_wait(ps_ctxt->pv_worker_cond, ps_ctxt->pv_queue_mutex);
+        }
 
-            *got_output = 1;
+        if(ps_ctxt->i4_worker_exit)
+        {
+            ithread_mutex_unlock(ps_ctxt->pv_queue_mutex);
+            break;
         }
-        if(ret < 0)
+
+        ps_pkt = ps_ctxt->aps_pkt_queue[ps_ctxt->i4_pkt_rd_idx];
+        ps_ctxt->i4_pkt_rd_idx = (ps_ctxt->i4_pkt_rd_idx + 1) % PKT_QUEUE_SIZE;
+        ps_ctxt->i4_pkt_cnt--;
+        ps_ctxt->i4_worker_busy = 1;
+
+        /* Room for one more packet */
+        ithread_cond_broadcast(ps_ctxt->pv_caller_cond);
+        ithread_mutex_unlock(ps_ctxt->pv_queue_mutex);
+
+        eos = (NULL == ps_pkt);
+        if(eos)
         {
-            return AVERROR_INVALIDDATA;
+            while(ivd_ff_decode_packet(ps_ctxt, NULL))
+                ;
+        }
+        else
+        {
+            ivd_ff_decode_packet(ps_ctxt, ps_pkt);
+            av_packet_free(&ps_pkt);
         }
+
+        ithread_mutex_lock(ps_ctxt->pv_queue_mutex);
+        if(eos)
+            ps_ctxt->i4_eos_done = 1;
+        ps_ctxt->i4_worker_busy = 0;
+        ithread_cond_broadcast(ps_ctxt->pv_caller_cond);
+        ithread_mutex_unlock(ps_ctxt->pv_queue_mutex);
     }
 
-    return avpkt->size;
+    return NULL;
+}
+
+/**
+*******************************************************************************
+*
+* @brief
+* Plugin's entry point for receiving a decoded picture
+*
+* @par   Description
+* Returns a queued picture if one is available. Otherwise pulls packets from
+* the framework and hands them to the decode thread till its packet queue is
+* full, or decodes them in place if there is no decode thread. Waits for the
+* decode thread only when it can not take more input
+*
+* @param[in] avctx
+* Framework context
+*
+* @param[out] frame
+* Decoded picture
+*
+* @returns 0 on output, AVERROR(EAGAIN) if more input is needed, AVERROR_EOF
+* once all pictures are output after end of stream, other errors on failure
+*
+* @remarks
+*
+*******************************************************************************
+*/
+static int ih264_receive_frame(AVCodecContext *avctx, AVFrame *frame)
+{
+    ctxt_t *ps_ctxt = avctx->priv_data;
+    int ret;
+
+    ithread_mutex_lock(ps_ctxt->pv_queue_mutex);
+    while(1)
+    {
+        if(ps_ctxt->i4_frm_cnt)
+        {
+            AVFrame *ps_frame = ps_ctxt->aps_frm_queue[ps_ctxt->i4_frm_rd_idx];
+
+            ps_ctxt->i4_frm_rd_idx =
+                (ps_ctxt->i4_frm_rd_idx + 1) % FRM_QUEUE_SIZE;
+            ps_ctxt->i4_frm_cnt--;
+            ithread_cond_broadcast(ps_ctxt->pv_worker_cond);
+            ithread_mutex_unlock(ps_ctxt->pv_queue_mutex);
 
+            av_frame_move_ref(frame, ps_frame);
+            av_frame_free(&ps_frame);
+            return 0;
+        }
+
+        if(ps_ctxt->i4_eos_done)
+        {
+            ret = AVERROR_EOF;
+            break;
+        }
+
+        if(ps_ctxt->i4_thread_created)
+        {
+            if(ps_ctxt->i4_eos_sent || (PKT_QUEUE_SIZE == ps_ctxt->i4_pkt_cnt))
+            {
+                ithread_cond_wait(ps_ctxt->pv_caller_cond,
+                    ps_ctxt->pv_queue_mutex);
+                continue;
+            }
+        }
+        else if(ps_ctxt->i4_eos_sent)
+        {
+            /* Drain one picture per call */
+            ithread_mutex_unlock(ps_ctxt->pv_queue_mutex);
+            if(0 == ivd_ff_decode_packet(ps_ctxt, NULL))
+                ps_ctxt->i4_eos_done = 1;
+            ithread_mutex_lock(ps_ctxt->pv_queue_mutex);
+            continue;
+        }
+
+        ithread_mutex_unlock(ps_ctxt->pv_queue_mutex);
+        ret = ff_decode_get_packet(avctx, ps_ctxt->ps_in_pkt);
+        ithread_mutex_lock(ps_ctxt->pv_queue_mutex);
+
+        if(AVERROR_EOF == ret)
+        {
+            ps_ctxt->i4_eos_sent = 1;
+            if(ps_ctxt->i4_thread_created)
+                ivd_ff_queue_packet(ps_ctxt, NULL);
+            continue;
+        }
+        if(ret < 0)
+            break;
+
+        if(ps_ctxt->i4_thread_created)
+        {
+            AVPacket *ps_pkt = av_packet_alloc();
+
+            if(NULL == ps_pkt)
+            {
+                av_packet_unref(ps_ctxt->ps_in_pkt);
+                ret = AVERROR(ENOMEM);
+                break;
+            }
+            av_packet_move_ref(ps_pkt, ps_ctxt->ps_in_pkt);
+            ivd_ff_queue_packet(ps_ctxt, ps_pkt);
+        }
+        else
+        {
+            ithread_mutex_unlock(ps_ctxt->pv_queue_mutex);
+            ivd_ff_decode_packet(ps_ctxt, ps_ctxt->ps_in_pkt);
+            av_packet_unref(ps_ctxt->ps_in_pkt);
+            ithread_mutex_lock(ps_ctxt->pv_queue_mutex);
+        }
+    }
+    ithread_mutex_unlock(ps_ctxt->pv_queue_mutex);
+
+    return ret;
 }
 
 /**
@@ -1748,9 +2514,30 @@ static int ih264d_init_context(AVCodecContext *avctx)
     ps_ctxt->pv_thread_handle = ih264a_aligned_malloc(16, ithread_get_handle_size());
     ps_ctxt->i4_thread_created = 0;
     ps_ctxt->i4_thread_enable = THREAD_ENABLE;
+    ps_ctxt->pv_queue_mutex = av_mallocz(ithread_get_mutex_lock_size());
+    ps_ctxt->pv_worker_cond = av_mallocz(ithread_get_cond_size());
+    ps_ctxt->pv_caller_cond = av_mallocz(ithread_get_cond_size());
+    ps_ctxt->ps_in_pkt = av_packet_alloc();
+    if((NULL == ps_ctxt->pv_thread_handle) || (NULL == ps_ctxt->pv_queue_mutex)
+        || (NULL == ps_ctxt->pv_worker_cond) || (NULL == ps_ctxt->pv_caller_cond)
+        || (NULL == ps_ctxt->ps_in_pkt))
+        return -1;
+
+    ithread_mutex_init(ps_ctxt->pv_queue_mutex);
+    ithread_cond_init(ps_ctxt->pv_worker_cond);
+    ithread_cond_init(ps_ctxt->pv_caller_cond);
+    ps_ctxt->i4_pkt_rd_idx = 0;
+    ps_ctxt->i4_pkt_cnt = 0;
+    ps_ctxt->i4_frm_rd_idx = 0;
+    ps_ctxt->i4_frm_cnt = 0;
+    ps_ctxt->i4_worker_busy = 0;
+    ps_ctxt->i4_worker_exit = 0;
+    ps_ctxt->i4_eos_sent = 0;
+    ps_ctxt->i4_eos_done = 0;
     ps_ctxt->avctx = avctx;
     ps_ctxt->i4_num_cores = ivd_ff_get_num_cores(ps_ctxt);
     ps_ctxt->disp_pic = NULL;
+    ps_ctxt->ps_disp_pool = NULL;
 
     ps_ctxt->e_arch = ivd_ff_get_arch();
     ps_ctxt->e_soc                   = SOC_GENERIC;
@@ -1984,6 +2771,16 @@ static int ih264_decode_init(AVCodecContext *avctx)
         return -1;
     }
 
+    /* Decode thread lives till close, fed through the packet queue */
+    if(ps_ctxt->i4_thread_enable && ps_ctxt->i4_num_cores > 1)
+    {
+        if(0 == ithread_create(ps_ctxt->pv_thread_handle, NULL,
+            (void *)&ivd_ff_decode_thread, (void *)ps_ctxt))
+            ps_ctxt->i4_thread_created = 1;
+        else
+            LOGE(ps_ctxt, 0, "Decode thread creation failed, decoding inline");
+    }
+
     {
         IV_API_CALL_STATUS_T ret;
 
@@ -2001,9 +2798,6 @@ static int ih264_decode_init(AVCodecContext *avctx)
             if((0 == ps_ctxt->i4_header_done) || (4 > ps_ctxt->i4_bits_size))
             {
                 LOGE(ps_ctxt, 0, "Header decode failed");
-                if(ps_ctxt->i4_thread_created)
-                    ithread_exit(0);
-
                 return AVERROR_INVALIDDATA;
             }
         }
@@ -2020,7 +2814,8 @@ static int ih264_decode_init(AVCodecContext *avctx)
 * Plugin's entry point for flushing
 *
 * @par   Description
-* Since decoder flush is hanlded as part of decode, nothign to be done here
+* Drops the queued packets and pictures along with the pictures held by the
+* decoder for reordering, so that decoding restarts cleanly after a seek
 *
 * @param[in] avctx
 * Framework context
@@ -2033,8 +2828,39 @@ static int ih264_decode_init(AVCodecContext *avctx)
 */
 static void ih264_decode_flush(AVCodecContext *avctx)
 {
-    UNUSED(avctx);
-    return;
+    ctxt_t *ps_ctxt = avctx->priv_data;
+    WORD32 i;
+
+    ithread_mutex_lock(ps_ctxt->pv_queue_mutex);
+    while(ps_ctxt->i4_pkt_cnt)
+    {
+        av_packet_free(&ps_ctxt->aps_pkt_queue[ps_ctxt->i4_pkt_rd_idx]);
+        ps_ctxt->i4_pkt_rd_idx = (ps_ctxt->i4_pkt_rd_idx + 1) % PKT_QUEUE_SIZE;
+        ps_ctxt->i4_pkt_cnt--;
+    }
+
+    /* Let the decode thread finish the packet it is on, dropping its output */
+    while(1)
+    {
+        ivd_ff_drop_frames(ps_ctxt);
+        if(0 == ps_ctxt->i4_worker_busy)
+            break;
+        ithread_cond_wait(ps_ctxt->pv_caller_cond, ps_ctxt->pv_queue_mutex);
+    }
+    ps_ctxt->i4_eos_sent = 0;
+    ps_ctxt->i4_eos_done = 0;
+    ithread_mutex_unlock(ps_ctxt->pv_queue_mutex);
+
+    /* Decode thread is idle till the next packet, so flush in place */
+    while(ivd_ff_decode_packet(ps_ctxt, NULL))
+    {
+        ithread_mutex_lock(ps_ctxt->pv_queue_mutex);
+        ivd_ff_drop_frames(ps_ctxt);
+        ithread_mutex_unlock(ps_ctxt->pv_queue_mutex);
+    }
+
+    for(i = 0; i < MAX_TIMESTAMP_CNT; i++)
+        ps_ctxt->ai4_timestamp_valid[i] = 0;
 }
 
 #define OFFSET(x) offsetof(ctxt_t, x)
@@ -2065,8 +2891,10 @@ const FFCodec ff_ih264_decoder = {
     .priv_data_size = sizeof(ctxt_t),
     .init           = ih264_decode_init,
     .close          = ih264_decode_free,
-    FF_CODEC_DECODE_CB(ih264_decode_frame_wrapper),
-    .p.capabilities   = AV_CODEC_CAP_DR1 | AV_CODEC_CAP_DELAY,
+    FF_CODEC_RECEIVE_FRAME_CB(ih264_receive_frame),
+    /* Shared display buffers are the decoder's own, not from get_buffer2 */
+    .p.capabilities   = (DEFAULT_SHARE_DISPLAY_BUF ? 0 : AV_CODEC_CAP_DR1)
+                        | AV_CODEC_CAP_DELAY,
     .flush          = ih264_decode_flush,
     .p.pix_fmts       = (const enum AVPixelFormat[]) { AV_PIX_FMT_VDPAU,
                                                      AV_PIX_FMT_NONE},
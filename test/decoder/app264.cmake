@@ -1,2 +1,7 @@
 lib264_add_executable(lib264dec lib264_library SOURCES ${LIB264_ROOT}/test/decoder/main.c)
 target_compile_definitions(lib264dec PRIVATE PROFILE_ENABLE MD5_DISABLE)
+
+lib264_add_executable(
+  app264_bench lib264_library SOURCES ${LIB264_ROOT}/test/decoder/bench.c
+  ${LIB264_ROOT}/test/decoder/buf_pool.c)
+lib264_add_executable(app264_microbench lib264_library SOURCES ${LIB264_ROOT}/test/decoder/microbench.c)
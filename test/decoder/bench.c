@@ -0,0 +1,1955 @@
+/* Copyright (c) [2020]-[2023] Ittiam Systems Pvt. Ltd.
+   All rights reserved.
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted (subject to the limitations in the
+   disclaimer below) provided that the following conditions are met:
+   •    Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+   •    Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+   •    None of the names of Ittiam Systems Pvt. Ltd., its affiliates,
+   investors, business partners, nor the names of its contributors may be
+   used to endorse or promote products derived from this software without
+   specific prior written permission.
+
+   NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED
+   BY THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+   BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+   FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+   HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+   OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+   WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+   OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+   EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+   This Software is an implementation of the AVC/H.264
+   standard by Ittiam Systems Pvt. Ltd. (“Ittiam”).
+   Additional patent licenses may be required for this Software,
+   including, but not limited to, a license from MPEG LA’s AVC/H.264
+   licensing program (see https://www.mpegla.com/programs/avc-h-264/).
+
+   NOTWITHSTANDING ANYTHING TO THE CONTRARY, THIS DOES NOT GRANT ANY
+   EXPRESS OR IMPLIED LICENSES TO ANY PATENT CLAIMS OF ANY AFFILIATE
+   (TO THE EXTENT NOT IN THE LEGAL ENTITY), INVESTOR, OR OTHER
+   BUSINESS PARTNER OF ITTIAM. You may only use this software or
+   modifications thereto for purposes that are authorized by
+   appropriate patent licenses. You should seek legal advice based
+   upon your implementation details.
+
+---------------------------------------------------------------
+*/
+/*****************************************************************************/
+/*                                                                           */
+/*  File Name         : bench.c                                              */
+/*                                                                           */
+/*  Description       : Throughput and latency benchmark for the H264        */
+/*                      decoder. Streams are preloaded into memory and       */
+/*                      decoded repeatedly without any file I/O, display or  */
+/*                      checksum work in the timed region. Results are       */
+/*                      printed as JSON                                      */
+/*                                                                           */
+/*  List of Functions : bench_exit                                           */
+/*                      bench_time_ns                                        */
+/*                      bench_load_stream                                    */
+/*                      bench_create_decoder                                 */
+/*                      bench_set_cores_and_processor                        */
+/*                      bench_decode_header                                  */
+/*                      bench_set_display_frame                              */
+/*                      bench_release_disp_frame                             */
+/*                      bench_decode_call                                    */
+/*                      bench_flush                                          */
+/*                      bench_release_mem                                    */
+/*                      bench_add_perf_stats                                 */
+/*                      bench_add_deadline_stats                             */
+/*                      bench_get_trace_events                               */
+/*                      bench_write_trace_events                             */
+/*                      bench_run_iteration                                  */
+/*                      bench_delete_decoder                                 */
+/*                      bench_print_json                                     */
+/*                      main                                                 */
+/*                                                                           */
+/*  Issues / Problems : Uses POSIX clocks and getrusage, so the harness is   */
+/*                      not built for Windows                                */
+/*                                                                           */
+/*  Revision History  :                                                      */
+/*                                                                           */
+/*         DD MM YYYY   Author(s)       Changes                              */
+/*         19 10 2026                   Initial Version                      */
+/*****************************************************************************/
+/*****************************************************************************/
+/* File Includes                                                             */
+/*****************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <time.h>
+#include <sys/time.h>
+#include <sys/resource.h>
+
+#ifndef IOS
+#include <malloc.h>
+#endif
+#ifdef __linux__
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
+#include "ih264_typedefs.h"
+
+#include "iv.h"
+#include "ivd.h"
+#include "ih264d.h"
+#include "buf_pool.h"
+
+/*****************************************************************************/
+/* Constant Macros                                                           */
+/*****************************************************************************/
+#define ivd_api_function ih264d_api_function
+
+#define MAX_STREAMS 64
+#define MAX_DISP_BUFFERS 64
+#define EXTRA_DISP_BUFFERS 8
+#define MAX_FRAME_WIDTH 2560
+#define MAX_FRAME_HEIGHT 1600
+#define MAX_LEVEL_SUPPORTED 50
+#define MAX_REF_FRAMES 16
+#define MAX_REORDER_FRAMES 16
+
+#define DEFAULT_ITERATIONS 5
+#define DEFAULT_WARMUP 1
+#define DEFAULT_NUM_CORES 1
+
+/* Initial capacity of the per call latency array, grown on demand */
+#define LATENCY_INIT_SIZE 4096
+
+/* Trace events read from the decoder per control call */
+#define TRACE_CHUNK_EVENTS 4096
+
+/* Hot records smaller than this are not padded to a huge page */
+#define HUGE_PAGE_MIN_SIZE (512 * 1024)
+#define HUGE_PAGE_SIZE (2 * 1024 * 1024)
+
+/*****************************************************************************/
+/* Typedefs                                                                  */
+/*****************************************************************************/
+/* Benchmark configuration, common to all the streams */
+typedef struct {
+  CHAR *apc_stream_fname[MAX_STREAMS];
+  UWORD32 u4_num_streams;
+  UWORD32 u4_iterations;
+  UWORD32 u4_warmup;
+  UWORD32 u4_num_cores;
+  UWORD32 u4_share_disp_buf;
+  UWORD32 u4_alloc_per_sps;
+  UWORD32 u4_huge_pages;
+  UWORD32 u4_mem_budget;
+  UWORD32 u4_film_grain;
+  UWORD32 u4_max_wd;
+  UWORD32 u4_max_ht;
+  UWORD32 u4_max_level;
+  WORD32 i4_mc_prefetch_dist;
+  UWORD32 u4_low_delay;
+  UWORD32 u4_intra_only;
+  UWORD32 u4_deadline_us;
+  UWORD32 u4_target_fps;
+  WORD32 i4_arch_set;
+  IVD_ARCH_T e_arch;
+  IV_COLOR_FORMAT_T e_output_chroma_format;
+  CHAR *pc_json_fname;
+
+  /* Pool shared by the instances of all iterations and streams, --pool */
+  buf_pool_t *ps_pool;
+  UWORD32 u4_use_pool;
+  UWORD32 u4_pool_max_mb;
+  UWORD32 u4_pool_quota_mb;
+
+  /* Chrome trace output, events are time stamped against the first one */
+  FILE *ps_trace_file;
+  UWORD64 u8_trace_base;
+  UWORD32 u4_trace_base_set;
+  UWORD32 u4_trace_events_written;
+  UWORD32 u4_trace_events_dropped;
+} bench_cfg_t;
+
+/* One decoder instance along with the buffers given to it */
+typedef struct {
+  iv_obj_t *ps_codec_obj;
+  iv_mem_rec_t *ps_mem_rec;
+  UWORD32 u4_num_mem_recs;
+  UWORD32 u4_codec_mem_size;
+  UWORD32 u4_app_mem_size;
+  UWORD32 u4_ip_buf_len;
+
+  /* Footprint reported by fill mem records, and the depths it settled on */
+  UWORD32 au4_component_size[IH264D_MEM_COMPONENT_CNT];
+  UWORD32 u4_num_reorder_frames;
+  UWORD32 u4_num_extra_disp_buf;
+
+  /* Memory the decoder allocated on SPS activation, with --alloc_per_sps */
+  UWORD32 u4_sps_mem_size;
+  UWORD32 u4_sps_mem_peak;
+  buf_pool_client_t *ps_pool_client;
+  UWORD32 u4_huge_pages;
+
+  UWORD32 u4_pic_wd;
+  UWORD32 u4_pic_ht;
+  UWORD32 u4_num_disp_bufs;
+  ivd_out_bufdesc_t s_out_buf;
+  ivd_out_bufdesc_t as_disp_buf[MAX_DISP_BUFFERS];
+
+  /* Trace events of the iteration, read after every decode call */
+  ih264d_trace_event_t *ps_trace_events;
+  UWORD32 u4_num_trace_events;
+  UWORD32 u4_max_trace_events;
+  UWORD64 u8_trace_ticks_per_sec;
+} bench_dec_t;
+
+/* Preloaded stream and the statistics gathered over measured iterations */
+typedef struct {
+  CHAR *pc_fname;
+  UWORD32 u4_idx;
+  UWORD8 *pu1_buf;
+  UWORD32 u4_size;
+
+  UWORD32 u4_pic_wd;
+  UWORD32 u4_pic_ht;
+  UWORD32 u4_codec_mem_size;
+  UWORD32 u4_app_mem_size;
+  UWORD32 au4_component_size[IH264D_MEM_COMPONENT_CNT];
+  UWORD32 u4_num_reorder_frames;
+  UWORD32 u4_num_extra_disp_buf;
+
+  UWORD32 u4_frames_decoded;
+  UWORD32 u4_frames_output;
+
+  /* Most pictures decoded and not yet output at the end of a decode call */
+  UWORD32 u4_max_output_lag;
+  UWORD32 u4_decode_errors;
+  UWORD64 u8_wall_ns;
+  UWORD64 u8_init_ns;
+  UWORD64 u8_cpu_main_ns;
+  UWORD64 u8_cpu_process_ns;
+
+  /* Data TLB read misses of all the decoder threads, when the kernel */
+  /* allows the application to count them                             */
+  UWORD32 u4_dtlb_valid;
+  UWORD64 u8_dtlb_misses;
+
+  /* Time taken by each decode call that decoded a picture */
+  UWORD64 *pu8_latency_ns;
+  UWORD32 u4_num_latency;
+  UWORD32 u4_max_latency;
+
+  /* Decoder profiling counters, when the library is built to update them */
+  UWORD32 u4_perf_stats;
+  double ad_stage_ms[IH264D_PERF_NUM_STAGES];
+  UWORD64 au8_num_mbs[IH264D_PERF_NUM_MB_TYPES];
+  UWORD64 u8_num_bins;
+  UWORD64 u8_num_bypass_bins;
+  UWORD64 u8_num_spin_waits;
+
+  /* What the deadline controller did, summed over measured iterations */
+  UWORD32 u4_dl_max_level;
+  UWORD32 u4_dl_num_pics;
+  UWORD32 u4_dl_num_over_deadline;
+  UWORD32 u4_dl_num_escalations;
+  UWORD32 u4_dl_num_relaxations;
+  UWORD32 u4_dl_num_deblk_skipped;
+  UWORD32 u4_dl_num_full_pel;
+  UWORD32 u4_dl_num_dropped;
+} bench_stream_t;
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : bench_exit                                               */
+/*                                                                           */
+/*  Description   : Prints an error and exits the application                */
+/*                                                                           */
+/*  Inputs        : pc_err_message : Error string                            */
+/*  Globals       :                                                          */
+/*  Processing    :                                                          */
+/*                                                                           */
+/*  Outputs       :                                                          */
+/*  Returns       : Does not return                                          */
+/*                                                                           */
+/*****************************************************************************/
+static void bench_exit(CHAR *pc_err_message) {
+  fprintf(stderr, "%s\n", pc_err_message);
+  exit(-1);
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : bench_time_ns                                            */
+/*                                                                           */
+/*  Description   : Reads the given clock in nanoseconds                     */
+/*                                                                           */
+/*  Inputs        : e_clock : CLOCK_MONOTONIC for wall time, or one of the   */
+/*                            CPU time clocks                                */
+/*  Globals       :                                                          */
+/*  Processing    :                                                          */
+/*                                                                           */
+/*  Outputs       :                                                          */
+/*  Returns       : Time in nanoseconds                                      */
+/*                                                                           */
+/*****************************************************************************/
+static UWORD64 bench_time_ns(clockid_t e_clock) {
+  struct timespec s_ts;
+
+  clock_gettime(e_clock, &s_ts);
+  return (UWORD64) s_ts.tv_sec * 1000000000ULL + (UWORD64) s_ts.tv_nsec;
+}
+
+static void *bench_aligned_malloc(WORD32 alignment, WORD32 i4_size) {
+#ifdef IOS
+  return malloc(i4_size);
+#else
+  return memalign(alignment, i4_size);
+#endif
+}
+
+/* Allocates a hot memory record for --huge_pages. Large records are padded */
+/* and aligned to 2 MB so that transparent huge pages back all of them, and */
+/* every page is touched here so it is placed on this thread's NUMA node    */
+static void *bench_hot_malloc(WORD32 alignment, WORD32 i4_size) {
+  void *pv_buf;
+
+  if (i4_size >= HUGE_PAGE_MIN_SIZE) {
+    i4_size = (i4_size + HUGE_PAGE_SIZE - 1) & ~(HUGE_PAGE_SIZE - 1);
+    if (alignment < HUGE_PAGE_SIZE) alignment = HUGE_PAGE_SIZE;
+  }
+  pv_buf = bench_aligned_malloc(alignment, i4_size);
+  if (NULL == pv_buf) return NULL;
+#ifdef __linux__
+  if (i4_size >= HUGE_PAGE_SIZE) madvise(pv_buf, i4_size, MADV_HUGEPAGE);
+#endif
+  memset(pv_buf, 0, i4_size);
+  return pv_buf;
+}
+
+/* Opens a counter of the data TLB read misses of this thread and of the */
+/* threads it creates afterwards. Returns -1 when it is not available    */
+static WORD32 bench_open_dtlb_counter(void) {
+#ifdef __linux__
+  struct perf_event_attr s_attr;
+
+  memset(&s_attr, 0, sizeof(s_attr));
+  s_attr.size = sizeof(s_attr);
+  s_attr.type = PERF_TYPE_HW_CACHE;
+  s_attr.config = PERF_COUNT_HW_CACHE_DTLB |
+                  (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                  (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+  s_attr.disabled = 1;
+  s_attr.inherit = 1;
+  s_attr.exclude_kernel = 1;
+  s_attr.exclude_hv = 1;
+  return (WORD32) syscall(SYS_perf_event_open, &s_attr, 0, -1, -1, 0);
+#else
+  return -1;
+#endif
+}
+
+/* Stops the counter and adds its count to the stream, then closes it */
+static void bench_close_dtlb_counter(WORD32 i4_fd, bench_stream_t *ps_stream,
+                                     WORD32 i4_measure) {
+#ifdef __linux__
+  UWORD64 u8_count;
+
+  if (i4_fd < 0) return;
+  ioctl(i4_fd, PERF_EVENT_IOC_DISABLE, 0);
+  if (i4_measure && (sizeof(u8_count) == read(i4_fd, &u8_count,
+                                               sizeof(u8_count)))) {
+    ps_stream->u4_dtlb_valid = 1;
+    ps_stream->u8_dtlb_misses += u8_count;
+  }
+  close(i4_fd);
+#else
+  (void) i4_fd;
+  (void) ps_stream;
+  (void) i4_measure;
+#endif
+}
+
+/* Allocator given to the decoder for --alloc_per_sps. The alignment and */
+/* size are kept in front of the buffer to account for it on free. The   */
+/* block holds the reference pictures, so it is hot for --huge_pages     */
+static void *bench_sps_mem_alloc(void *pv_mem_ctxt, WORD32 alignment,
+                                 WORD32 size) {
+  bench_dec_t *ps_bdec = (bench_dec_t *) pv_mem_ctxt;
+  WORD32 *pi4_hdr;
+  UWORD8 *pu1_buf;
+
+  if (alignment < (WORD32) (2 * sizeof(WORD32)))
+    alignment = 2 * sizeof(WORD32);
+  if (NULL != ps_bdec->ps_pool_client)
+    pu1_buf = (UWORD8 *) buf_pool_alloc(ps_bdec->ps_pool_client, alignment,
+                                        size + alignment);
+  else if (ps_bdec->u4_huge_pages)
+    pu1_buf = (UWORD8 *) bench_hot_malloc(alignment, size + alignment);
+  else
+    pu1_buf = (UWORD8 *) bench_aligned_malloc(alignment, size + alignment);
+  if (NULL == pu1_buf) return NULL;
+
+  pu1_buf += alignment;
+  pi4_hdr = (WORD32 *) pu1_buf - 2;
+  pi4_hdr[0] = alignment;
+  pi4_hdr[1] = size;
+
+  ps_bdec->u4_sps_mem_size += size;
+  if (ps_bdec->u4_sps_mem_size > ps_bdec->u4_sps_mem_peak)
+    ps_bdec->u4_sps_mem_peak = ps_bdec->u4_sps_mem_size;
+  return pu1_buf;
+}
+
+static void bench_sps_mem_free(void *pv_mem_ctxt, void *pv_buf) {
+  bench_dec_t *ps_bdec = (bench_dec_t *) pv_mem_ctxt;
+  WORD32 *pi4_hdr = (WORD32 *) pv_buf - 2;
+
+  ps_bdec->u4_sps_mem_size -= pi4_hdr[1];
+  if (NULL != ps_bdec->ps_pool_client)
+    buf_pool_free(ps_bdec->ps_pool_client, (UWORD8 *) pv_buf - pi4_hdr[0]);
+  else
+    free((UWORD8 *) pv_buf - pi4_hdr[0]);
+}
+
+static IV_API_CALL_STATUS_T bench_ctl(bench_dec_t *ps_bdec, void *pv_ip,
+                                      void *pv_op) {
+  return ivd_api_function(ps_bdec->ps_codec_obj, pv_ip, pv_op);
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : bench_load_stream                                        */
+/*                                                                           */
+/*  Description   : Reads a complete elementary stream into memory           */
+/*                                                                           */
+/*  Inputs        : ps_stream : Stream context with file name filled in      */
+/*  Globals       :                                                          */
+/*  Processing    :                                                          */
+/*                                                                           */
+/*  Outputs       : Stream buffer and its size                               */
+/*  Returns       : None                                                     */
+/*                                                                           */
+/*****************************************************************************/
+static void bench_load_stream(bench_stream_t *ps_stream) {
+  FILE *ps_ip_file;
+  long i4_size;
+  CHAR ac_error_str[1024];
+
+  ps_ip_file = fopen(ps_stream->pc_fname, "rb");
+  if (NULL == ps_ip_file) {
+    sprintf(ac_error_str, "Could not open input file %.900s",
+            ps_stream->pc_fname);
+    bench_exit(ac_error_str);
+  }
+
+  fseek(ps_ip_file, 0, SEEK_END);
+  i4_size = ftell(ps_ip_file);
+  fseek(ps_ip_file, 0, SEEK_SET);
+
+  if (i4_size <= 0) {
+    sprintf(ac_error_str, "Empty input file %.900s", ps_stream->pc_fname);
+    bench_exit(ac_error_str);
+  }
+
+  ps_stream->pu1_buf = (UWORD8 *) malloc(i4_size);
+  if (NULL == ps_stream->pu1_buf) bench_exit("Allocation failure for stream");
+
+  if ((size_t) i4_size !=
+      fread(ps_stream->pu1_buf, 1, (size_t) i4_size, ps_ip_file)) {
+    sprintf(ac_error_str, "Unable to read input file %.900s",
+            ps_stream->pc_fname);
+    bench_exit(ac_error_str);
+  }
+  fclose(ps_ip_file);
+
+  ps_stream->u4_size = (UWORD32) i4_size;
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : bench_create_decoder                                     */
+/*                                                                           */
+/*  Description   : Creates a decoder instance and allocates the memory      */
+/*                  records, and the output buffer in non shared mode        */
+/*                                                                           */
+/*  Inputs        : ps_cfg  : Benchmark configuration                        */
+/*                  ps_bdec : Decoder instance to be created                 */
+/*  Globals       :                                                          */
+/*  Processing    : Same create sequence as the sample application           */
+/*                                                                           */
+/*  Outputs       : Initialized decoder instance                             */
+/*  Returns       : None                                                     */
+/*                                                                           */
+/*****************************************************************************/
+static void bench_create_decoder(bench_cfg_t *ps_cfg, bench_dec_t *ps_bdec) {
+  iv_num_mem_rec_ip_t s_num_mem_rec_ip;
+  iv_num_mem_rec_op_t s_num_mem_rec_op;
+  ih264d_fill_mem_rec_ip_t s_fill_mem_rec_ip;
+  ih264d_fill_mem_rec_op_t s_fill_mem_rec_op;
+  IH264D_MEM_PLACEMENT_T *pe_mem_placement;
+  ih264d_init_ip_t s_init_ip;
+  ih264d_init_op_t s_init_op;
+  ivd_ctl_getbufinfo_ip_t s_ctl_ip;
+  ivd_ctl_getbufinfo_op_t s_ctl_op;
+  UWORD32 u4_max_wd, u4_max_ht, u4_level;
+  UWORD32 i;
+  CHAR ac_error_str[256];
+
+  memset(ps_bdec, 0, sizeof(bench_dec_t));
+  ps_bdec->u4_huge_pages = ps_cfg->u4_huge_pages;
+
+  if (NULL != ps_cfg->ps_pool) {
+    ps_bdec->ps_pool_client = buf_pool_add_client(
+        ps_cfg->ps_pool, (UWORD64) ps_cfg->u4_pool_quota_mb << 20);
+    if (NULL == ps_bdec->ps_pool_client)
+      bench_exit("Allocation failure for pool client");
+  }
+
+  u4_max_wd = (0 == ps_cfg->u4_max_wd) ? MAX_FRAME_WIDTH : ps_cfg->u4_max_wd;
+  u4_max_ht = (0 == ps_cfg->u4_max_ht) ? MAX_FRAME_HEIGHT : ps_cfg->u4_max_ht;
+  u4_level = (0 == ps_cfg->u4_max_level) ? MAX_LEVEL_SUPPORTED
+                                         : ps_cfg->u4_max_level;
+
+  s_num_mem_rec_ip.u4_size = sizeof(s_num_mem_rec_ip);
+  s_num_mem_rec_op.u4_size = sizeof(s_num_mem_rec_op);
+  s_num_mem_rec_ip.e_cmd = IV_CMD_GET_NUM_MEM_REC;
+
+  if (IV_SUCCESS != ivd_api_function(NULL, (void *) &s_num_mem_rec_ip,
+                                     (void *) &s_num_mem_rec_op))
+    bench_exit("Error in get mem records");
+
+  ps_bdec->u4_num_mem_recs = s_num_mem_rec_op.u4_num_mem_rec;
+  ps_bdec->ps_mem_rec = (iv_mem_rec_t *) malloc(ps_bdec->u4_num_mem_recs *
+                                                sizeof(iv_mem_rec_t));
+  if (NULL == ps_bdec->ps_mem_rec)
+    bench_exit("Allocation failure for mem_rec_location");
+
+  for (i = 0; i < ps_bdec->u4_num_mem_recs; i++)
+    ps_bdec->ps_mem_rec[i].u4_size = sizeof(iv_mem_rec_t);
+
+  pe_mem_placement = (IH264D_MEM_PLACEMENT_T *) malloc(
+      ps_bdec->u4_num_mem_recs * sizeof(IH264D_MEM_PLACEMENT_T));
+  if (NULL == pe_mem_placement)
+    bench_exit("Allocation failure for mem_placement");
+
+  s_fill_mem_rec_ip.s_ivd_fill_mem_rec_ip_t.e_cmd = IV_CMD_FILL_NUM_MEM_REC;
+  s_fill_mem_rec_ip.s_ivd_fill_mem_rec_ip_t.pv_mem_rec_location =
+      ps_bdec->ps_mem_rec;
+  s_fill_mem_rec_ip.s_ivd_fill_mem_rec_ip_t.u4_max_frm_wd = u4_max_wd;
+  s_fill_mem_rec_ip.s_ivd_fill_mem_rec_ip_t.u4_max_frm_ht = u4_max_ht;
+  s_fill_mem_rec_ip.i4_level = u4_level;
+  s_fill_mem_rec_ip.u4_num_ref_frames = MAX_REF_FRAMES;
+  s_fill_mem_rec_ip.u4_num_reorder_frames = MAX_REORDER_FRAMES;
+  s_fill_mem_rec_ip.u4_share_disp_buf = ps_cfg->u4_share_disp_buf;
+  s_fill_mem_rec_ip.e_output_format = ps_cfg->e_output_chroma_format;
+  s_fill_mem_rec_ip.u4_num_extra_disp_buf = EXTRA_DISP_BUFFERS;
+  s_fill_mem_rec_ip.u4_alloc_per_sps = ps_cfg->u4_alloc_per_sps;
+  s_fill_mem_rec_ip.pe_mem_placement = pe_mem_placement;
+  s_fill_mem_rec_ip.u4_mem_budget = ps_cfg->u4_mem_budget;
+  s_fill_mem_rec_ip.u4_film_grain = ps_cfg->u4_film_grain;
+  s_fill_mem_rec_ip.u4_intra_only = ps_cfg->u4_intra_only;
+  s_fill_mem_rec_ip.s_ivd_fill_mem_rec_ip_t.u4_size =
+      sizeof(ih264d_fill_mem_rec_ip_t);
+  s_fill_mem_rec_op.s_ivd_fill_mem_rec_op_t.u4_size =
+      sizeof(ih264d_fill_mem_rec_op_t);
+
+  if (IV_SUCCESS != ivd_api_function(NULL, (void *) &s_fill_mem_rec_ip,
+                                     (void *) &s_fill_mem_rec_op)) {
+    sprintf(ac_error_str, "Error in fill mem records: %x",
+            s_fill_mem_rec_op.s_ivd_fill_mem_rec_op_t.u4_error_code);
+    bench_exit(ac_error_str);
+  }
+  ps_bdec->u4_num_mem_recs =
+      s_fill_mem_rec_op.s_ivd_fill_mem_rec_op_t.u4_num_mem_rec_filled;
+  memcpy(ps_bdec->au4_component_size, s_fill_mem_rec_op.au4_component_size,
+         sizeof(ps_bdec->au4_component_size));
+  ps_bdec->u4_num_reorder_frames = s_fill_mem_rec_op.u4_num_reorder_frames;
+  ps_bdec->u4_num_extra_disp_buf = s_fill_mem_rec_op.u4_num_extra_disp_buf;
+
+  for (i = 0; i < ps_bdec->u4_num_mem_recs; i++) {
+    iv_mem_rec_t *ps_mem_rec = &ps_bdec->ps_mem_rec[i];
+
+    if (ps_cfg->u4_huge_pages &&
+        (IH264D_MEM_PLACEMENT_HOT == pe_mem_placement[i]))
+      ps_mem_rec->pv_base = bench_hot_malloc(ps_mem_rec->u4_mem_alignment,
+                                             ps_mem_rec->u4_mem_size);
+    else
+      ps_mem_rec->pv_base = bench_aligned_malloc(
+          ps_mem_rec->u4_mem_alignment, ps_mem_rec->u4_mem_size);
+    if (NULL == ps_mem_rec->pv_base) {
+      sprintf(ac_error_str, "Allocation failure for mem record id %d size %d",
+              i, ps_mem_rec->u4_mem_size);
+      bench_exit(ac_error_str);
+    }
+    ps_bdec->u4_codec_mem_size += ps_mem_rec->u4_mem_size;
+  }
+  free(pe_mem_placement);
+
+  s_init_ip.s_ivd_init_ip_t.e_cmd = (IVD_API_COMMAND_TYPE_T) IV_CMD_INIT;
+  s_init_ip.s_ivd_init_ip_t.pv_mem_rec_location = ps_bdec->ps_mem_rec;
+  s_init_ip.s_ivd_init_ip_t.u4_frm_max_wd = u4_max_wd;
+  s_init_ip.s_ivd_init_ip_t.u4_frm_max_ht = u4_max_ht;
+  s_init_ip.i4_level = u4_level;
+  s_init_ip.u4_num_ref_frames = MAX_REF_FRAMES;
+  s_init_ip.u4_num_reorder_frames = MAX_REORDER_FRAMES;
+  s_init_ip.u4_share_disp_buf = ps_cfg->u4_share_disp_buf;
+  s_init_ip.u4_num_extra_disp_buf = EXTRA_DISP_BUFFERS;
+  s_init_ip.u4_alloc_per_sps = ps_cfg->u4_alloc_per_sps;
+  s_init_ip.pf_aligned_alloc = bench_sps_mem_alloc;
+  s_init_ip.pf_aligned_free = bench_sps_mem_free;
+  s_init_ip.pv_mem_ctxt = ps_bdec;
+  s_init_ip.u4_mem_budget = ps_cfg->u4_mem_budget;
+  s_init_ip.u4_film_grain = ps_cfg->u4_film_grain;
+  s_init_ip.u4_intra_only = ps_cfg->u4_intra_only;
+  s_init_ip.s_ivd_init_ip_t.u4_num_mem_rec = ps_bdec->u4_num_mem_recs;
+  s_init_ip.s_ivd_init_ip_t.e_output_format = ps_cfg->e_output_chroma_format;
+  s_init_ip.s_ivd_init_ip_t.u4_size = sizeof(ih264d_init_ip_t);
+  s_init_op.s_ivd_init_op_t.u4_size = sizeof(ih264d_init_op_t);
+
+  ps_bdec->ps_codec_obj = (iv_obj_t *) ps_bdec->ps_mem_rec[0].pv_base;
+  ps_bdec->ps_codec_obj->pv_fxns = (void *) &ivd_api_function;
+  ps_bdec->ps_codec_obj->u4_size = sizeof(iv_obj_t);
+
+  if (IV_SUCCESS !=
+      bench_ctl(ps_bdec, (void *) &s_init_ip, (void *) &s_init_op)) {
+    sprintf(ac_error_str, "Error in Init %8x",
+            s_init_op.s_ivd_init_op_t.u4_error_code);
+    bench_exit(ac_error_str);
+  }
+
+  s_ctl_ip.e_cmd = IVD_CMD_VIDEO_CTL;
+  s_ctl_ip.e_sub_cmd = IVD_CMD_CTL_GETBUFINFO;
+  s_ctl_ip.u4_size = sizeof(ivd_ctl_getbufinfo_ip_t);
+  s_ctl_op.u4_size = sizeof(ivd_ctl_getbufinfo_op_t);
+  if (IV_SUCCESS != bench_ctl(ps_bdec, (void *) &s_ctl_ip, (void *) &s_ctl_op))
+    bench_exit("Error in Get Buf Info");
+
+  ps_bdec->u4_ip_buf_len = s_ctl_op.u4_min_in_buf_size[0];
+
+  /* Output buffer is needed unless the display buffers are shared with */
+  /* the codec in a semi planar format                                  */
+  if ((0 == ps_cfg->u4_share_disp_buf) ||
+      (IV_YUV_420P == ps_cfg->e_output_chroma_format)) {
+    ivd_out_bufdesc_t *ps_out_buf = &ps_bdec->s_out_buf;
+    UWORD32 outlen = 0;
+
+    for (i = 0; i < s_ctl_op.u4_min_num_out_bufs; i++) {
+      ps_out_buf->u4_min_out_buf_size[i] = s_ctl_op.u4_min_out_buf_size[i];
+      outlen += s_ctl_op.u4_min_out_buf_size[i];
+    }
+
+    ps_out_buf->pu1_bufs[0] = (UWORD8 *) malloc(outlen);
+    if (NULL == ps_out_buf->pu1_bufs[0])
+      bench_exit("Allocation failure for output buffer");
+
+    for (i = 1; i < s_ctl_op.u4_min_num_out_bufs; i++)
+      ps_out_buf->pu1_bufs[i] =
+          ps_out_buf->pu1_bufs[i - 1] + s_ctl_op.u4_min_out_buf_size[i - 1];
+
+    ps_out_buf->u4_num_bufs = s_ctl_op.u4_min_num_out_bufs;
+    ps_bdec->u4_app_mem_size += outlen;
+  }
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : bench_set_cores_and_processor                            */
+/*                                                                           */
+/*  Description   : Applies the number of cores, architecture and MC         */
+/*                  prefetch distance. Called after create and after every   */
+/*                  reset of the decoder                                     */
+/*                                                                           */
+/*  Inputs        : ps_cfg  : Benchmark configuration                        */
+/*                  ps_bdec : Decoder instance                               */
+/*  Globals       :                                                          */
+/*  Processing    :                                                          */
+/*                                                                           */
+/*  Outputs       :                                                          */
+/*  Returns       : None                                                     */
+/*                                                                           */
+/*****************************************************************************/
+static void bench_set_cores_and_processor(bench_cfg_t *ps_cfg,
+                                          bench_dec_t *ps_bdec) {
+  ih264d_ctl_set_num_cores_ip_t s_cores_ip;
+  ih264d_ctl_set_num_cores_op_t s_cores_op;
+
+  s_cores_ip.e_cmd = IVD_CMD_VIDEO_CTL;
+  s_cores_ip.e_sub_cmd =
+      (IVD_CONTROL_API_COMMAND_TYPE_T) IH264D_CMD_CTL_SET_NUM_CORES;
+  s_cores_ip.u4_num_cores = ps_cfg->u4_num_cores;
+  s_cores_ip.u4_size = sizeof(ih264d_ctl_set_num_cores_ip_t);
+  s_cores_op.u4_size = sizeof(ih264d_ctl_set_num_cores_op_t);
+  if (IV_SUCCESS !=
+      bench_ctl(ps_bdec, (void *) &s_cores_ip, (void *) &s_cores_op))
+    bench_exit("Error in setting number of cores");
+
+  /* Without --arch the library picks its default for the build */
+  if (ps_cfg->i4_arch_set) {
+    ih264d_ctl_set_processor_ip_t s_proc_ip;
+    ih264d_ctl_set_processor_op_t s_proc_op;
+
+    s_proc_ip.e_cmd = IVD_CMD_VIDEO_CTL;
+    s_proc_ip.e_sub_cmd =
+        (IVD_CONTROL_API_COMMAND_TYPE_T) IH264D_CMD_CTL_SET_PROCESSOR;
+    s_proc_ip.u4_arch = ps_cfg->e_arch;
+    s_proc_ip.u4_soc = SOC_GENERIC;
+    s_proc_ip.u4_size = sizeof(ih264d_ctl_set_processor_ip_t);
+    s_proc_op.u4_size = sizeof(ih264d_ctl_set_processor_op_t);
+    if (IV_SUCCESS !=
+        bench_ctl(ps_bdec, (void *) &s_proc_ip, (void *) &s_proc_op))
+      bench_exit("Error in setting processor type");
+  }
+
+  if (ps_cfg->i4_mc_prefetch_dist >= 0) {
+    ih264d_ctl_set_mc_prefetch_ip_t s_pf_ip;
+    ih264d_ctl_set_mc_prefetch_op_t s_pf_op;
+
+    s_pf_ip.e_cmd = IVD_CMD_VIDEO_CTL;
+    s_pf_ip.e_sub_cmd =
+        (IVD_CONTROL_API_COMMAND_TYPE_T) IH264D_CMD_CTL_SET_MC_PREFETCH;
+    s_pf_ip.u4_prefetch_dist = (UWORD32) ps_cfg->i4_mc_prefetch_dist;
+    s_pf_ip.u4_size = sizeof(ih264d_ctl_set_mc_prefetch_ip_t);
+    s_pf_op.u4_size = sizeof(ih264d_ctl_set_mc_prefetch_op_t);
+    if (IV_SUCCESS != bench_ctl(ps_bdec, (void *) &s_pf_ip, (void *) &s_pf_op))
+      bench_exit("Error in setting MC prefetch distance");
+  }
+
+  if (ps_cfg->u4_low_delay) {
+    ih264d_ctl_set_low_delay_ip_t s_ld_ip;
+    ih264d_ctl_set_low_delay_op_t s_ld_op;
+
+    s_ld_ip.e_cmd = IVD_CMD_VIDEO_CTL;
+    s_ld_ip.e_sub_cmd =
+        (IVD_CONTROL_API_COMMAND_TYPE_T) IH264D_CMD_CTL_SET_LOW_DELAY;
+    s_ld_ip.u4_low_delay = ps_cfg->u4_low_delay;
+    s_ld_ip.u4_size = sizeof(ih264d_ctl_set_low_delay_ip_t);
+    s_ld_op.u4_size = sizeof(ih264d_ctl_set_low_delay_op_t);
+    if (IV_SUCCESS != bench_ctl(ps_bdec, (void *) &s_ld_ip, (void *) &s_ld_op))
+      bench_exit("Error in setting low delay");
+  }
+
+  if (ps_cfg->u4_intra_only) {
+    ih264d_ctl_set_intra_only_ip_t s_io_ip;
+    ih264d_ctl_set_intra_only_op_t s_io_op;
+
+    s_io_ip.e_cmd = IVD_CMD_VIDEO_CTL;
+    s_io_ip.e_sub_cmd =
+        (IVD_CONTROL_API_COMMAND_TYPE_T) IH264D_CMD_CTL_SET_INTRA_ONLY;
+    s_io_ip.u4_intra_only = ps_cfg->u4_intra_only;
+    s_io_ip.u4_size = sizeof(ih264d_ctl_set_intra_only_ip_t);
+    s_io_op.u4_size = sizeof(ih264d_ctl_set_intra_only_op_t);
+    if (IV_SUCCESS != bench_ctl(ps_bdec, (void *) &s_io_ip, (void *) &s_io_op))
+      bench_exit("Error in setting intra only");
+  }
+
+  if (ps_cfg->u4_deadline_us || ps_cfg->u4_target_fps) {
+    ih264d_ctl_set_deadline_ip_t s_dl_ip;
+    ih264d_ctl_set_deadline_op_t s_dl_op;
+
+    s_dl_ip.e_cmd = IVD_CMD_VIDEO_CTL;
+    s_dl_ip.e_sub_cmd =
+        (IVD_CONTROL_API_COMMAND_TYPE_T) IH264D_CMD_CTL_SET_DEADLINE;
+    s_dl_ip.u4_deadline_us = ps_cfg->u4_deadline_us;
+    s_dl_ip.u4_target_fps = ps_cfg->u4_target_fps;
+    s_dl_ip.u4_size = sizeof(ih264d_ctl_set_deadline_ip_t);
+    s_dl_op.u4_size = sizeof(ih264d_ctl_set_deadline_op_t);
+    if (IV_SUCCESS != bench_ctl(ps_bdec, (void *) &s_dl_ip, (void *) &s_dl_op))
+      bench_exit("Error in setting deadline");
+  }
+}
+
+static void bench_set_params(bench_dec_t *ps_bdec,
+                             IVD_VIDEO_DECODE_MODE_T e_mode) {
+  ivd_ctl_set_config_ip_t s_ctl_ip;
+  ivd_ctl_set_config_op_t s_ctl_op;
+
+  s_ctl_ip.u4_disp_wd = 0;
+  s_ctl_ip.e_frm_skip_mode = IVD_SKIP_NONE;
+  s_ctl_ip.e_frm_out_mode = IVD_DISPLAY_FRAME_OUT;
+  s_ctl_ip.e_vid_dec_mode = e_mode;
+  s_ctl_ip.e_cmd = IVD_CMD_VIDEO_CTL;
+  s_ctl_ip.e_sub_cmd = IVD_CMD_CTL_SETPARAMS;
+  s_ctl_ip.u4_size = sizeof(ivd_ctl_set_config_ip_t);
+  s_ctl_op.u4_size = sizeof(ivd_ctl_set_config_op_t);
+  if (IV_SUCCESS != bench_ctl(ps_bdec, (void *) &s_ctl_ip, (void *) &s_ctl_op))
+    bench_exit("Error in setting decode mode");
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : bench_decode_header                                      */
+/*                                                                           */
+/*  Description   : Decodes the sequence header to learn the picture size    */
+/*                                                                           */
+/*  Inputs        : ps_bdec   : Decoder instance                             */
+/*                  ps_stream : Preloaded stream                             */
+/*  Globals       :                                                          */
+/*  Processing    : Feeds the stream in header mode until a call succeeds    */
+/*                                                                           */
+/*  Outputs       : Picture width and height                                 */
+/*  Returns       : Number of bytes consumed by the header decode            */
+/*                                                                           */
+/*****************************************************************************/
+static UWORD32 bench_decode_header(bench_dec_t *ps_bdec,
+                                   bench_stream_t *ps_stream) {
+  ivd_video_decode_ip_t s_video_decode_ip;
+  ivd_video_decode_op_t s_video_decode_op;
+  IV_API_CALL_STATUS_T ret;
+  UWORD32 u4_offset = 0;
+
+  bench_set_params(ps_bdec, IVD_DECODE_HEADER);
+
+  do {
+    UWORD32 u4_bytes = ps_stream->u4_size - u4_offset;
+
+    if (0 == u4_bytes) bench_exit("No sequence header found in stream");
+    if (u4_bytes > ps_bdec->u4_ip_buf_len) u4_bytes = ps_bdec->u4_ip_buf_len;
+
+    memset(&s_video_decode_ip, 0, sizeof(ivd_video_decode_ip_t));
+    s_video_decode_ip.e_cmd = IVD_CMD_VIDEO_DECODE;
+    s_video_decode_ip.pv_stream_buffer = ps_stream->pu1_buf + u4_offset;
+    s_video_decode_ip.u4_num_Bytes = u4_bytes;
+    s_video_decode_ip.u4_size = sizeof(ivd_video_decode_ip_t);
+    s_video_decode_op.u4_size = sizeof(ivd_video_decode_op_t);
+
+    ret = bench_ctl(ps_bdec, (void *) &s_video_decode_ip,
+                    (void *) &s_video_decode_op);
+
+    if ((IV_SUCCESS != ret) && (0 == s_video_decode_op.u4_num_bytes_consumed))
+      bench_exit("Header decode made no progress");
+
+    u4_offset += s_video_decode_op.u4_num_bytes_consumed;
+  } while (IV_SUCCESS != ret);
+
+  ps_bdec->u4_pic_wd = s_video_decode_op.u4_pic_wd;
+  ps_bdec->u4_pic_ht = s_video_decode_op.u4_pic_ht;
+
+  return u4_offset;
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : bench_set_display_frame                                  */
+/*                                                                           */
+/*  Description   : In shared mode allocates the display buffers for the     */
+/*                  decoded picture size and hands them to the codec         */
+/*                                                                           */
+/*  Inputs        : ps_bdec : Decoder instance                               */
+/*  Globals       :                                                          */
+/*  Processing    :                                                          */
+/*                                                                           */
+/*  Outputs       :                                                          */
+/*  Returns       : None                                                     */
+/*                                                                           */
+/*****************************************************************************/
+static void bench_set_display_frame(bench_dec_t *ps_bdec) {
+  ivd_ctl_getbufinfo_ip_t s_ctl_ip;
+  ivd_ctl_getbufinfo_op_t s_ctl_op;
+  ivd_set_display_frame_ip_t s_set_disp_ip;
+  ivd_set_display_frame_op_t s_set_disp_op;
+  UWORD32 i, j;
+
+  s_ctl_ip.e_cmd = IVD_CMD_VIDEO_CTL;
+  s_ctl_ip.e_sub_cmd = IVD_CMD_CTL_GETBUFINFO;
+  s_ctl_ip.u4_size = sizeof(ivd_ctl_getbufinfo_ip_t);
+  s_ctl_op.u4_size = sizeof(ivd_ctl_getbufinfo_op_t);
+  if (IV_SUCCESS != bench_ctl(ps_bdec, (void *) &s_ctl_ip, (void *) &s_ctl_op))
+    bench_exit("Error in Get Buf Info");
+
+  if (s_ctl_op.u4_num_disp_bufs > MAX_DISP_BUFFERS)
+    s_ctl_op.u4_num_disp_bufs = MAX_DISP_BUFFERS;
+
+  for (i = 0; i < s_ctl_op.u4_num_disp_bufs; i++) {
+    ivd_out_bufdesc_t *ps_disp_buf = &ps_bdec->as_disp_buf[i];
+    UWORD32 outlen = 0;
+
+    for (j = 0; j < s_ctl_op.u4_min_num_out_bufs; j++) {
+      ps_disp_buf->u4_min_out_buf_size[j] = s_ctl_op.u4_min_out_buf_size[j];
+      outlen += s_ctl_op.u4_min_out_buf_size[j];
+    }
+
+    ps_disp_buf->pu1_bufs[0] = (UWORD8 *) malloc(outlen);
+    if (NULL == ps_disp_buf->pu1_bufs[0])
+      bench_exit("Allocation failure for display buffer");
+
+    for (j = 1; j < s_ctl_op.u4_min_num_out_bufs; j++)
+      ps_disp_buf->pu1_bufs[j] =
+          ps_disp_buf->pu1_bufs[j - 1] + s_ctl_op.u4_min_out_buf_size[j - 1];
+
+    ps_disp_buf->u4_num_bufs = s_ctl_op.u4_min_num_out_bufs;
+    ps_bdec->u4_app_mem_size += outlen;
+  }
+  ps_bdec->u4_num_disp_bufs = s_ctl_op.u4_num_disp_bufs;
+
+  s_set_disp_ip.e_cmd = IVD_CMD_SET_DISPLAY_FRAME;
+  s_set_disp_ip.u4_size = sizeof(ivd_set_display_frame_ip_t);
+  s_set_disp_op.u4_size = sizeof(ivd_set_display_frame_op_t);
+  s_set_disp_ip.num_disp_bufs = ps_bdec->u4_num_disp_bufs;
+  memcpy(&s_set_disp_ip.s_disp_buffer, ps_bdec->as_disp_buf,
+         ps_bdec->u4_num_disp_bufs * sizeof(ivd_out_bufdesc_t));
+
+  if (IV_SUCCESS !=
+      bench_ctl(ps_bdec, (void *) &s_set_disp_ip, (void *) &s_set_disp_op))
+    bench_exit("Error in Set display frame");
+}
+
+static void bench_release_disp_frame(bench_dec_t *ps_bdec, UWORD32 u4_buf_id) {
+  ivd_rel_display_frame_ip_t s_rel_ip;
+  ivd_rel_display_frame_op_t s_rel_op;
+
+  s_rel_ip.e_cmd = IVD_CMD_REL_DISPLAY_FRAME;
+  s_rel_ip.u4_size = sizeof(ivd_rel_display_frame_ip_t);
+  s_rel_op.u4_size = sizeof(ivd_rel_display_frame_op_t);
+  s_rel_ip.u4_disp_buf_id = u4_buf_id;
+  bench_ctl(ps_bdec, (void *) &s_rel_ip, (void *) &s_rel_op);
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : bench_get_trace_events                                   */
+/*                                                                           */
+/*  Description   : Moves the trace events recorded by the decoder since the */
+/*                  previous call to the events of the iteration             */
+/*                                                                           */
+/*  Inputs        : ps_cfg  : Benchmark configuration                        */
+/*                  ps_bdec : Decoder instance                               */
+/*  Globals       :                                                          */
+/*  Processing    : Events are read in chunks until the decoder has none     */
+/*                  left. A library built without the events fails the       */
+/*                  control and the trace stays empty                        */
+/*                                                                           */
+/*  Outputs       : Events of the iteration                                  */
+/*  Returns       : None                                                     */
+/*                                                                           */
+/*****************************************************************************/
+static void bench_get_trace_events(bench_cfg_t *ps_cfg, bench_dec_t *ps_bdec) {
+  ih264d_ctl_get_trace_events_ip_t s_trace_ip;
+  ih264d_ctl_get_trace_events_op_t s_trace_op;
+
+  do {
+    if (ps_bdec->u4_max_trace_events - ps_bdec->u4_num_trace_events <
+        TRACE_CHUNK_EVENTS) {
+      UWORD32 u4_new_max = ps_bdec->u4_max_trace_events * 2 +
+                           TRACE_CHUNK_EVENTS;
+      ih264d_trace_event_t *ps_new = (ih264d_trace_event_t *) realloc(
+          ps_bdec->ps_trace_events, u4_new_max * sizeof(ih264d_trace_event_t));
+
+      if (NULL == ps_new) bench_exit("Allocation failure for trace events");
+      ps_bdec->ps_trace_events = ps_new;
+      ps_bdec->u4_max_trace_events = u4_new_max;
+    }
+
+    s_trace_ip.e_cmd = IVD_CMD_VIDEO_CTL;
+    s_trace_ip.e_sub_cmd =
+        (IVD_CONTROL_API_COMMAND_TYPE_T) IH264D_CMD_CTL_GET_TRACE_EVENTS;
+    s_trace_ip.ps_events =
+        ps_bdec->ps_trace_events + ps_bdec->u4_num_trace_events;
+    s_trace_ip.u4_max_events = TRACE_CHUNK_EVENTS;
+    s_trace_ip.u4_size = sizeof(ih264d_ctl_get_trace_events_ip_t);
+    s_trace_op.u4_size = sizeof(ih264d_ctl_get_trace_events_op_t);
+    if (IV_SUCCESS !=
+        bench_ctl(ps_bdec, (void *) &s_trace_ip, (void *) &s_trace_op))
+      return;
+
+    ps_bdec->u4_num_trace_events += s_trace_op.u4_num_events;
+    ps_bdec->u8_trace_ticks_per_sec = s_trace_op.u8_ticks_per_sec;
+    ps_cfg->u4_trace_events_dropped += s_trace_op.u4_num_dropped;
+  } while (s_trace_op.u4_num_events == TRACE_CHUNK_EVENTS);
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : bench_decode_call                                        */
+/*                                                                           */
+/*  Description   : Issues one video decode call. In shared mode the output  */
+/*                  buffer is released right away, as a display that keeps   */
+/*                  up with the decoder would                                */
+/*                                                                           */
+/*  Inputs        : ps_bdec   : Decoder instance                             */
+/*                  pu1_buf   : Bitstream, NULL when flushing                */
+/*                  u4_bytes  : Bytes available in pu1_buf                   */
+/*                  ps_op     : Decode output arguments                      */
+/*  Globals       :                                                          */
+/*  Processing    :                                                          */
+/*                                                                           */
+/*  Outputs       : Decode output arguments                                  */
+/*  Returns       : Status of the decode call                                */
+/*                                                                           */
+/*****************************************************************************/
+static IV_API_CALL_STATUS_T bench_decode_call(bench_cfg_t *ps_cfg,
+                                              bench_dec_t *ps_bdec,
+                                              UWORD8 *pu1_buf,
+                                              UWORD32 u4_bytes,
+                                              ivd_video_decode_op_t *ps_op) {
+  ivd_video_decode_ip_t s_video_decode_ip;
+  IV_API_CALL_STATUS_T ret;
+
+  memset(&s_video_decode_ip, 0, sizeof(ivd_video_decode_ip_t));
+  s_video_decode_ip.e_cmd = IVD_CMD_VIDEO_DECODE;
+  s_video_decode_ip.pv_stream_buffer = pu1_buf;
+  s_video_decode_ip.u4_num_Bytes = u4_bytes;
+  s_video_decode_ip.u4_size = sizeof(ivd_video_decode_ip_t);
+  s_video_decode_ip.s_out_buffer = ps_bdec->s_out_buf;
+
+  memset(ps_op, 0, sizeof(ivd_video_decode_op_t));
+  ps_op->u4_size = sizeof(ivd_video_decode_op_t);
+
+  ret = bench_ctl(ps_bdec, (void *) &s_video_decode_ip, (void *) ps_op);
+
+  if (ps_cfg->u4_share_disp_buf && ps_op->u4_output_present)
+    bench_release_disp_frame(ps_bdec, ps_op->u4_disp_buf_id);
+
+  if (NULL != ps_cfg->ps_trace_file) bench_get_trace_events(ps_cfg, ps_bdec);
+
+  return ret;
+}
+
+static void bench_flush(bench_cfg_t *ps_cfg, bench_dec_t *ps_bdec,
+                        bench_stream_t *ps_stream, WORD32 i4_measure) {
+  ivd_ctl_flush_ip_t s_ctl_ip;
+  ivd_ctl_flush_op_t s_ctl_op;
+  ivd_video_decode_op_t s_video_decode_op;
+
+  s_ctl_ip.e_cmd = IVD_CMD_VIDEO_CTL;
+  s_ctl_ip.e_sub_cmd = IVD_CMD_CTL_FLUSH;
+  s_ctl_ip.u4_size = sizeof(ivd_ctl_flush_ip_t);
+  s_ctl_op.u4_size = sizeof(ivd_ctl_flush_op_t);
+  if (IV_SUCCESS != bench_ctl(ps_bdec, (void *) &s_ctl_ip, (void *) &s_ctl_op))
+    return;
+
+  do {
+    bench_decode_call(ps_cfg, ps_bdec, ps_stream->pu1_buf, 0,
+                      &s_video_decode_op);
+    if (i4_measure && s_video_decode_op.u4_output_present)
+      ps_stream->u4_frames_output++;
+  } while (s_video_decode_op.u4_output_present);
+}
+
+/* Returns the picture memory of a reset instance to the pool, so that the */
+/* next SPS is served the best fitting buffer of the pool                  */
+static void bench_release_mem(bench_dec_t *ps_bdec) {
+  ih264d_ctl_release_mem_ip_t s_ctl_ip;
+  ih264d_ctl_release_mem_op_t s_ctl_op;
+
+  s_ctl_ip.e_cmd = IVD_CMD_VIDEO_CTL;
+  s_ctl_ip.e_sub_cmd =
+      (IVD_CONTROL_API_COMMAND_TYPE_T) IH264D_CMD_CTL_RELEASE_MEM;
+  s_ctl_ip.u4_size = sizeof(ih264d_ctl_release_mem_ip_t);
+  s_ctl_op.u4_size = sizeof(ih264d_ctl_release_mem_op_t);
+  if (IV_SUCCESS != bench_ctl(ps_bdec, (void *) &s_ctl_ip, (void *) &s_ctl_op))
+    bench_exit("Error in Release Mem");
+}
+
+static void bench_add_latency(bench_stream_t *ps_stream, UWORD64 u8_ns) {
+  if (ps_stream->u4_num_latency == ps_stream->u4_max_latency) {
+    UWORD32 u4_new_max = ps_stream->u4_max_latency
+                             ? 2 * ps_stream->u4_max_latency
+                             : LATENCY_INIT_SIZE;
+    UWORD64 *pu8_new = (UWORD64 *) realloc(
+        ps_stream->pu8_latency_ns, u4_new_max * sizeof(UWORD64));
+
+    if (NULL == pu8_new) bench_exit("Allocation failure for latency array");
+    ps_stream->pu8_latency_ns = pu8_new;
+    ps_stream->u4_max_latency = u4_new_max;
+  }
+  ps_stream->pu8_latency_ns[ps_stream->u4_num_latency++] = u8_ns;
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : bench_add_perf_stats                                     */
+/*                                                                           */
+/*  Description   : Reads the decoder profiling counters of an iteration     */
+/*                  and adds them to the stream statistics                   */
+/*                                                                           */
+/*  Inputs        : ps_bdec   : Decoder instance                             */
+/*                  ps_stream : Stream statistics                            */
+/*  Globals       :                                                          */
+/*  Processing    : The control fails on a library built without the         */
+/*                  counters, the stream then has no perf_stats reported     */
+/*                                                                           */
+/*  Outputs       : Updated stream statistics                                */
+/*  Returns       : None                                                     */
+/*                                                                           */
+/*****************************************************************************/
+static void bench_add_perf_stats(bench_dec_t *ps_bdec,
+                                 bench_stream_t *ps_stream) {
+  ih264d_ctl_get_perf_stats_ip_t s_perf_ip;
+  ih264d_ctl_get_perf_stats_op_t s_perf_op;
+  UWORD32 i;
+
+  s_perf_ip.e_cmd = IVD_CMD_VIDEO_CTL;
+  s_perf_ip.e_sub_cmd =
+      (IVD_CONTROL_API_COMMAND_TYPE_T) IH264D_CMD_CTL_GET_PERF_STATS;
+  s_perf_ip.u4_reset = 0;
+  s_perf_ip.u4_size = sizeof(ih264d_ctl_get_perf_stats_ip_t);
+  s_perf_op.u4_size = sizeof(ih264d_ctl_get_perf_stats_op_t);
+  if (IV_SUCCESS !=
+      bench_ctl(ps_bdec, (void *) &s_perf_ip, (void *) &s_perf_op))
+    return;
+
+  ps_stream->u4_perf_stats = 1;
+  for (i = 0; i < IH264D_PERF_NUM_STAGES; i++)
+    if (s_perf_op.u8_ticks_per_sec)
+      ps_stream->ad_stage_ms[i] += s_perf_op.au8_stage_ticks[i] * 1e3 /
+                                   s_perf_op.u8_ticks_per_sec;
+  for (i = 0; i < IH264D_PERF_NUM_MB_TYPES; i++)
+    ps_stream->au8_num_mbs[i] += s_perf_op.au8_num_mbs[i];
+  ps_stream->u8_num_bins += s_perf_op.u8_num_bins;
+  ps_stream->u8_num_bypass_bins += s_perf_op.u8_num_bypass_bins;
+  ps_stream->u8_num_spin_waits += s_perf_op.u8_num_spin_waits;
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : bench_add_deadline_stats                                 */
+/*                                                                           */
+/*  Description   : Reads what the deadline controller did in an iteration   */
+/*                  and adds it to the stream statistics                     */
+/*                                                                           */
+/*  Inputs        : ps_bdec   : Decoder instance                             */
+/*                  ps_stream : Stream statistics                            */
+/*  Globals       :                                                          */
+/*  Processing    : None                                                     */
+/*                                                                           */
+/*  Outputs       : Updated stream statistics                                */
+/*  Returns       : None                                                     */
+/*                                                                           */
+/*****************************************************************************/
+static void bench_add_deadline_stats(bench_dec_t *ps_bdec,
+                                     bench_stream_t *ps_stream) {
+  ih264d_ctl_get_deadline_stats_ip_t s_dl_ip;
+  ih264d_ctl_get_deadline_stats_op_t s_dl_op;
+
+  s_dl_ip.e_cmd = IVD_CMD_VIDEO_CTL;
+  s_dl_ip.e_sub_cmd =
+      (IVD_CONTROL_API_COMMAND_TYPE_T) IH264D_CMD_CTL_GET_DEADLINE_STATS;
+  s_dl_ip.u4_size = sizeof(ih264d_ctl_get_deadline_stats_ip_t);
+  s_dl_op.u4_size = sizeof(ih264d_ctl_get_deadline_stats_op_t);
+  if (IV_SUCCESS != bench_ctl(ps_bdec, (void *) &s_dl_ip, (void *) &s_dl_op))
+    return;
+
+  if (s_dl_op.u4_max_level > ps_stream->u4_dl_max_level)
+    ps_stream->u4_dl_max_level = s_dl_op.u4_max_level;
+  ps_stream->u4_dl_num_pics += s_dl_op.u4_num_pics;
+  ps_stream->u4_dl_num_over_deadline += s_dl_op.u4_num_over_deadline;
+  ps_stream->u4_dl_num_escalations += s_dl_op.u4_num_escalations;
+  ps_stream->u4_dl_num_relaxations += s_dl_op.u4_num_relaxations;
+  ps_stream->u4_dl_num_deblk_skipped += s_dl_op.u4_num_deblk_skipped;
+  ps_stream->u4_dl_num_full_pel += s_dl_op.u4_num_full_pel;
+  ps_stream->u4_dl_num_dropped += s_dl_op.u4_num_dropped;
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : bench_write_trace_events                                 */
+/*                                                                           */
+/*  Description   : Writes the trace events of an iteration as Chrome trace  */
+/*                  duration events, one process per stream and one thread   */
+/*                  per decoder thread                                       */
+/*                                                                           */
+/*  Inputs        : ps_cfg  : Benchmark configuration                        */
+/*                  ps_bdec : Decoder instance                               */
+/*                  u4_pid  : Index of the stream                            */
+/*  Globals       :                                                          */
+/*  Processing    : Ends whose start was overwritten in the decoder are      */
+/*                  skipped, so that every thread's spans stay nested        */
+/*                                                                           */
+/*  Outputs       : Events appended to the trace file                        */
+/*  Returns       : None                                                     */
+/*                                                                           */
+/*****************************************************************************/
+static void bench_write_trace_events(bench_cfg_t *ps_cfg, bench_dec_t *ps_bdec,
+                                     UWORD32 u4_pid) {
+  static const CHAR *apc_event_name[IH264D_TRACE_NUM_EVENTS] = {
+      "decode_call", "slice", "mb_group", "deblock", "fmt_conv", "wait"};
+  UWORD32 au4_depth[256];
+  UWORD32 i;
+
+  if (0 == ps_bdec->u8_trace_ticks_per_sec) return;
+
+  memset(au4_depth, 0, sizeof(au4_depth));
+  if ((0 == ps_cfg->u4_trace_base_set) && ps_bdec->u4_num_trace_events) {
+    ps_cfg->u8_trace_base = ps_bdec->ps_trace_events[0].u8_ts;
+    ps_cfg->u4_trace_base_set = 1;
+  }
+
+  for (i = 0; i < ps_bdec->u4_num_trace_events; i++) {
+    ih264d_trace_event_t *ps_event = &ps_bdec->ps_trace_events[i];
+    double d_ts_us;
+
+    if (ps_event->u1_event >= IH264D_TRACE_NUM_EVENTS) continue;
+    if (ps_event->u1_begin) {
+      au4_depth[ps_event->u1_thread]++;
+    } else {
+      if (0 == au4_depth[ps_event->u1_thread]) continue;
+      au4_depth[ps_event->u1_thread]--;
+    }
+
+    /* Events of the first iteration can precede the first one read */
+    if (ps_event->u8_ts >= ps_cfg->u8_trace_base)
+      d_ts_us = (double) (ps_event->u8_ts - ps_cfg->u8_trace_base) * 1e6 /
+                ps_bdec->u8_trace_ticks_per_sec;
+    else
+      d_ts_us = -(double) (ps_cfg->u8_trace_base - ps_event->u8_ts) * 1e6 /
+                ps_bdec->u8_trace_ticks_per_sec;
+
+    fprintf(ps_cfg->ps_trace_file,
+            "%s\n{\"name\": \"%s\", \"ph\": \"%s\", \"ts\": %.3f, "
+            "\"pid\": %u, \"tid\": %u",
+            ps_cfg->u4_trace_events_written ? "," : "",
+            apc_event_name[ps_event->u1_event],
+            ps_event->u1_begin ? "B" : "E", d_ts_us, u4_pid,
+            ps_event->u1_thread);
+    if (ps_event->u1_begin)
+      fprintf(ps_cfg->ps_trace_file, ", \"args\": {\"arg\": %u}}",
+              ps_event->u4_arg);
+    else
+      fprintf(ps_cfg->ps_trace_file, "}");
+    ps_cfg->u4_trace_events_written++;
+  }
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : bench_delete_decoder                                     */
+/*                                                                           */
+/*  Description   : Retrieves the memory records from the codec and frees    */
+/*                  them along with the output and display buffers           */
+/*                                                                           */
+/*  Inputs        : ps_bdec : Decoder instance                               */
+/*  Globals       :                                                          */
+/*  Processing    :                                                          */
+/*                                                                           */
+/*  Outputs       :                                                          */
+/*  Returns       : None                                                     */
+/*                                                                           */
+/*****************************************************************************/
+static void bench_delete_decoder(bench_dec_t *ps_bdec) {
+  iv_retrieve_mem_rec_ip_t s_retrieve_ip;
+  iv_retrieve_mem_rec_op_t s_retrieve_op;
+  UWORD32 i;
+
+  s_retrieve_ip.pv_mem_rec_location = ps_bdec->ps_mem_rec;
+  s_retrieve_ip.e_cmd = IV_CMD_RETRIEVE_MEMREC;
+  s_retrieve_ip.u4_size = sizeof(iv_retrieve_mem_rec_ip_t);
+  s_retrieve_op.u4_size = sizeof(iv_retrieve_mem_rec_op_t);
+  if (IV_SUCCESS !=
+      bench_ctl(ps_bdec, (void *) &s_retrieve_ip, (void *) &s_retrieve_op))
+    bench_exit("Error in Retrieve Memrec");
+
+  for (i = 0; i < s_retrieve_op.u4_num_mem_rec_filled; i++)
+    free(ps_bdec->ps_mem_rec[i].pv_base);
+  free(ps_bdec->ps_mem_rec);
+  if (NULL != ps_bdec->ps_pool_client)
+    buf_pool_remove_client(ps_bdec->ps_pool_client);
+
+  free(ps_bdec->s_out_buf.pu1_bufs[0]);
+  for (i = 0; i < ps_bdec->u4_num_disp_bufs; i++)
+    free(ps_bdec->as_disp_buf[i].pu1_bufs[0]);
+  free(ps_bdec->ps_trace_events);
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : bench_run_iteration                                      */
+/*                                                                           */
+/*  Description   : Decodes a stream once from a fresh decoder instance      */
+/*                                                                           */
+/*  Inputs        : ps_cfg     : Benchmark configuration                     */
+/*                  ps_stream  : Preloaded stream and its statistics         */
+/*                  i4_measure : 0 for warmup iterations                     */
+/*  Globals       :                                                          */
+/*  Processing    : Only the decode and flush calls are inside the timed     */
+/*                  region; create, header decode and delete are reported    */
+/*                  separately as init time                                  */
+/*                                                                           */
+/*  Outputs       : Updated stream statistics                                */
+/*  Returns       : None                                                     */
+/*                                                                           */
+/*****************************************************************************/
+static void bench_run_iteration(bench_cfg_t *ps_cfg, bench_stream_t *ps_stream,
+                                WORD32 i4_measure) {
+  bench_dec_t *ps_bdec;
+  ivd_video_decode_op_t s_video_decode_op;
+  UWORD64 u8_init_start, u8_wall_start, u8_main_start, u8_proc_start;
+  WORD32 i4_dtlb_fd;
+  UWORD32 u4_offset;
+  UWORD32 u4_num_pending;
+  UWORD32 i;
+
+  ps_bdec = (bench_dec_t *) malloc(sizeof(bench_dec_t));
+  if (NULL == ps_bdec) bench_exit("Allocation failure for decoder context");
+
+  u8_init_start = bench_time_ns(CLOCK_MONOTONIC);
+
+  bench_create_decoder(ps_cfg, ps_bdec);
+  bench_set_cores_and_processor(ps_cfg, ps_bdec);
+  u4_offset = bench_decode_header(ps_bdec, ps_stream);
+  if (ps_cfg->u4_share_disp_buf) {
+    bench_set_display_frame(ps_bdec);
+    for (i = 0; i < ps_bdec->u4_num_disp_bufs; i++)
+      bench_release_disp_frame(ps_bdec, i);
+  }
+  bench_set_params(ps_bdec, IVD_DECODE_FRAME);
+
+  ps_stream->u4_pic_wd = ps_bdec->u4_pic_wd;
+  ps_stream->u4_pic_ht = ps_bdec->u4_pic_ht;
+  ps_stream->u4_app_mem_size = ps_bdec->u4_app_mem_size;
+
+  /* Opened before the decoder creates its threads so that they inherit it */
+  i4_dtlb_fd = bench_open_dtlb_counter();
+#ifdef __linux__
+  if (i4_dtlb_fd >= 0) ioctl(i4_dtlb_fd, PERF_EVENT_IOC_ENABLE, 0);
+#endif
+
+  u8_wall_start = bench_time_ns(CLOCK_MONOTONIC);
+  u8_main_start = bench_time_ns(CLOCK_THREAD_CPUTIME_ID);
+  u8_proc_start = bench_time_ns(CLOCK_PROCESS_CPUTIME_ID);
+  if (i4_measure) ps_stream->u8_init_ns += u8_wall_start - u8_init_start;
+
+  u4_num_pending = 0;
+  while (u4_offset < ps_stream->u4_size) {
+    IV_API_CALL_STATUS_T ret;
+    UWORD64 u8_call_start, u8_call_end;
+    UWORD32 u4_bytes = ps_stream->u4_size - u4_offset;
+
+    if (u4_bytes > ps_bdec->u4_ip_buf_len) u4_bytes = ps_bdec->u4_ip_buf_len;
+
+    u8_call_start = bench_time_ns(CLOCK_MONOTONIC);
+    ret = bench_decode_call(ps_cfg, ps_bdec, ps_stream->pu1_buf + u4_offset,
+                            u4_bytes, &s_video_decode_op);
+    u8_call_end = bench_time_ns(CLOCK_MONOTONIC);
+
+    if ((IV_SUCCESS != ret) &&
+        ((s_video_decode_op.u4_error_code & 0xFF) == IVD_RES_CHANGED)) {
+      ivd_ctl_reset_ip_t s_reset_ip;
+      ivd_ctl_reset_op_t s_reset_op;
+
+      bench_flush(ps_cfg, ps_bdec, ps_stream, i4_measure);
+
+      s_reset_ip.e_cmd = IVD_CMD_VIDEO_CTL;
+      s_reset_ip.e_sub_cmd = IVD_CMD_CTL_RESET;
+      s_reset_ip.u4_size = sizeof(ivd_ctl_reset_ip_t);
+      s_reset_op.u4_size = sizeof(ivd_ctl_reset_op_t);
+      if (IV_SUCCESS !=
+          bench_ctl(ps_bdec, (void *) &s_reset_ip, (void *) &s_reset_op))
+        bench_exit("Error in Reset");
+
+      if (NULL != ps_bdec->ps_pool_client) bench_release_mem(ps_bdec);
+      bench_set_cores_and_processor(ps_cfg, ps_bdec);
+      continue;
+    }
+
+    if (i4_measure) {
+      /* Pictures dropped by the deadline controller are not errors */
+      if ((IV_SUCCESS != ret) &&
+          ((s_video_decode_op.u4_error_code & 0xFF) != IVD_DEC_FRM_SKIPPED))
+        ps_stream->u4_decode_errors++;
+      if (s_video_decode_op.u4_frame_decoded_flag) {
+        ps_stream->u4_frames_decoded++;
+        bench_add_latency(ps_stream, u8_call_end - u8_call_start);
+      }
+      if (s_video_decode_op.u4_output_present) ps_stream->u4_frames_output++;
+    }
+
+    if (s_video_decode_op.u4_frame_decoded_flag) u4_num_pending++;
+    if (s_video_decode_op.u4_output_present && u4_num_pending)
+      u4_num_pending--;
+    if (i4_measure && (u4_num_pending > ps_stream->u4_max_output_lag))
+      ps_stream->u4_max_output_lag = u4_num_pending;
+
+    /* Guard against a stream tail the decoder cannot make progress on */
+    if (0 == s_video_decode_op.u4_num_bytes_consumed) break;
+    u4_offset += s_video_decode_op.u4_num_bytes_consumed;
+  }
+
+  bench_flush(ps_cfg, ps_bdec, ps_stream, i4_measure);
+  bench_close_dtlb_counter(i4_dtlb_fd, ps_stream, i4_measure);
+
+  /* The per SPS allocation is only known once pictures have been decoded */
+  ps_stream->u4_codec_mem_size =
+      ps_bdec->u4_codec_mem_size + ps_bdec->u4_sps_mem_peak;
+  memcpy(ps_stream->au4_component_size, ps_bdec->au4_component_size,
+         sizeof(ps_stream->au4_component_size));
+  ps_stream->u4_num_reorder_frames = ps_bdec->u4_num_reorder_frames;
+  ps_stream->u4_num_extra_disp_buf = ps_bdec->u4_num_extra_disp_buf;
+
+  if (i4_measure) {
+    ps_stream->u8_wall_ns += bench_time_ns(CLOCK_MONOTONIC) - u8_wall_start;
+    ps_stream->u8_cpu_main_ns +=
+        bench_time_ns(CLOCK_THREAD_CPUTIME_ID) - u8_main_start;
+    ps_stream->u8_cpu_process_ns +=
+        bench_time_ns(CLOCK_PROCESS_CPUTIME_ID) - u8_proc_start;
+    bench_add_perf_stats(ps_bdec, ps_stream);
+    bench_add_deadline_stats(ps_bdec, ps_stream);
+    if (NULL != ps_cfg->ps_trace_file)
+      bench_write_trace_events(ps_cfg, ps_bdec, ps_stream->u4_idx);
+  }
+
+  bench_delete_decoder(ps_bdec);
+  free(ps_bdec);
+}
+
+static int bench_cmp_u64(const void *pv_a, const void *pv_b) {
+  UWORD64 u8_a = *(const UWORD64 *) pv_a;
+  UWORD64 u8_b = *(const UWORD64 *) pv_b;
+
+  return (u8_a > u8_b) - (u8_a < u8_b);
+}
+
+/* Nearest rank percentile of a sorted array, in microseconds */
+static double bench_percentile_us(UWORD64 *pu8_sorted, UWORD32 u4_num,
+                                  UWORD32 u4_pct) {
+  UWORD32 u4_rank;
+
+  if (0 == u4_num) return 0.0;
+  u4_rank = (u4_num * u4_pct + 99) / 100;
+  if (u4_rank > 0) u4_rank--;
+  return pu8_sorted[u4_rank] / 1000.0;
+}
+
+static void bench_print_str(FILE *ps_fp, const CHAR *pc_str) {
+  fputc('"', ps_fp);
+  for (; *pc_str; pc_str++) {
+    if (('"' == *pc_str) || ('\\' == *pc_str))
+      fprintf(ps_fp, "\\%c", *pc_str);
+    else if ((UWORD8) *pc_str < 0x20)
+      fprintf(ps_fp, "\\u%04x", (UWORD8) *pc_str);
+    else
+      fputc(*pc_str, ps_fp);
+  }
+  fputc('"', ps_fp);
+}
+
+static const CHAR *bench_arch_name(bench_cfg_t *ps_cfg) {
+  if (0 == ps_cfg->i4_arch_set) return "DEFAULT";
+
+  switch (ps_cfg->e_arch) {
+    case ARCH_ARM_NONEON:
+      return "ARM_NONEON";
+    case ARCH_ARM_A9Q:
+      return "ARM_A9Q";
+    case ARCH_ARM_A7:
+      return "ARM_A7";
+    case ARCH_ARM_A5:
+      return "ARM_A5";
+    case ARCH_ARM_NEONINTR:
+      return "ARM_NEONINTR";
+    case ARCH_ARMV8_GENERIC:
+      return "ARMV8_GENERIC";
+    case ARCH_X86_GENERIC:
+      return "X86_GENERIC";
+    case ARCH_X86_SSSE3:
+      return "X86_SSSE3";
+    case ARCH_X86_SSE42:
+      return "X86_SSE42";
+    case ARCH_X86_AVX2:
+      return "X86_AVX2";
+    case ARCH_MIPS_GENERIC:
+      return "MIPS_GENERIC";
+    case ARCH_MIPS_32:
+      return "MIPS_32";
+    case ARCH_WASM_GENERIC:
+      return "WASM_GENERIC";
+    case ARCH_WASM_SIMD128:
+      return "WASM_SIMD128";
+    default:
+      return "UNKNOWN";
+  }
+}
+
+static const CHAR *bench_chroma_format_name(IV_COLOR_FORMAT_T e_fmt) {
+  switch (e_fmt) {
+    case IV_YUV_420P:
+      return "YUV_420P";
+    case IV_YUV_420SP_UV:
+      return "YUV_420SP_UV";
+    case IV_YUV_420SP_VU:
+      return "YUV_420SP_VU";
+    case IV_YUV_422ILE:
+      return "YUV_422ILE";
+    case IV_RGB_565:
+      return "RGB_565";
+    case IV_RGBA_8888:
+      return "RGBA_8888";
+    default:
+      return "UNKNOWN";
+  }
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : bench_print_json                                         */
+/*                                                                           */
+/*  Description   : Prints the configuration and per stream results          */
+/*                                                                           */
+/*  Inputs        : ps_fp       : Output file                                */
+/*                  ps_cfg      : Benchmark configuration                    */
+/*                  ps_streams  : Streams with gathered statistics           */
+/*  Globals       :                                                          */
+/*  Processing    : Latencies are of decode calls that decoded a picture.    */
+/*                  CPU time of the decoder's worker threads is the process  */
+/*                  CPU time less that of the calling thread, since the      */
+/*                  workers are created and joined within each picture       */
+/*                                                                           */
+/*  Outputs       :                                                          */
+/*  Returns       : None                                                     */
+/*                                                                           */
+/*****************************************************************************/
+static void bench_print_json(FILE *ps_fp, bench_cfg_t *ps_cfg,
+                             bench_stream_t *ps_streams) {
+  struct rusage s_usage;
+  UWORD64 u8_tot_wall_ns = 0;
+  UWORD32 u4_tot_frames = 0;
+  UWORD32 i;
+
+  getrusage(RUSAGE_SELF, &s_usage);
+
+  fprintf(ps_fp, "{\n  \"config\": {\n");
+  fprintf(ps_fp, "    \"num_cores\": %u,\n", ps_cfg->u4_num_cores);
+  fprintf(ps_fp, "    \"arch\": \"%s\",\n", bench_arch_name(ps_cfg));
+  fprintf(ps_fp, "    \"chroma_format\": \"%s\",\n",
+          bench_chroma_format_name(ps_cfg->e_output_chroma_format));
+  fprintf(ps_fp, "    \"share_display_buf\": %u,\n",
+          ps_cfg->u4_share_disp_buf);
+  fprintf(ps_fp, "    \"alloc_per_sps\": %u,\n", ps_cfg->u4_alloc_per_sps);
+  fprintf(ps_fp, "    \"huge_pages\": %u,\n", ps_cfg->u4_huge_pages);
+  fprintf(ps_fp, "    \"mem_budget\": %u,\n", ps_cfg->u4_mem_budget);
+  fprintf(ps_fp, "    \"film_grain\": %u,\n", ps_cfg->u4_film_grain);
+  fprintf(ps_fp, "    \"pool\": %u,\n", ps_cfg->u4_use_pool);
+  fprintf(ps_fp, "    \"pool_max_mb\": %u,\n", ps_cfg->u4_pool_max_mb);
+  fprintf(ps_fp, "    \"pool_quota_mb\": %u,\n", ps_cfg->u4_pool_quota_mb);
+  fprintf(ps_fp, "    \"mc_prefetch_dist\": %d,\n",
+          ps_cfg->i4_mc_prefetch_dist);
+  fprintf(ps_fp, "    \"low_delay\": %u,\n", ps_cfg->u4_low_delay);
+  fprintf(ps_fp, "    \"intra_only\": %u,\n", ps_cfg->u4_intra_only);
+  fprintf(ps_fp, "    \"deadline_us\": %u,\n", ps_cfg->u4_deadline_us);
+  fprintf(ps_fp, "    \"target_fps\": %u,\n", ps_cfg->u4_target_fps);
+  fprintf(ps_fp, "    \"iterations\": %u,\n", ps_cfg->u4_iterations);
+  fprintf(ps_fp, "    \"warmup\": %u\n  },\n", ps_cfg->u4_warmup);
+
+  fprintf(ps_fp, "  \"streams\": [\n");
+  for (i = 0; i < ps_cfg->u4_num_streams; i++) {
+    bench_stream_t *ps_stream = &ps_streams[i];
+    UWORD64 u8_cpu_workers_ns = 0;
+    double d_wall_s = ps_stream->u8_wall_ns / 1e9;
+    double d_mean_us = 0.0;
+    UWORD32 j;
+
+    if (ps_stream->u8_cpu_process_ns > ps_stream->u8_cpu_main_ns)
+      u8_cpu_workers_ns =
+          ps_stream->u8_cpu_process_ns - ps_stream->u8_cpu_main_ns;
+
+    qsort(ps_stream->pu8_latency_ns, ps_stream->u4_num_latency,
+          sizeof(UWORD64), bench_cmp_u64);
+    for (j = 0; j < ps_stream->u4_num_latency; j++)
+      d_mean_us += ps_stream->pu8_latency_ns[j] / 1000.0;
+    if (ps_stream->u4_num_latency) d_mean_us /= ps_stream->u4_num_latency;
+
+    u8_tot_wall_ns += ps_stream->u8_wall_ns;
+    u4_tot_frames += ps_stream->u4_frames_decoded;
+
+    fprintf(ps_fp, "    {\n      \"input\": ");
+    bench_print_str(ps_fp, ps_stream->pc_fname);
+    fprintf(ps_fp, ",\n");
+    fprintf(ps_fp, "      \"bytes\": %u,\n", ps_stream->u4_size);
+    fprintf(ps_fp, "      \"width\": %u,\n", ps_stream->u4_pic_wd);
+    fprintf(ps_fp, "      \"height\": %u,\n", ps_stream->u4_pic_ht);
+    fprintf(ps_fp, "      \"frames_decoded\": %u,\n",
+            ps_stream->u4_frames_decoded);
+    fprintf(ps_fp, "      \"frames_output\": %u,\n",
+            ps_stream->u4_frames_output);
+    fprintf(ps_fp, "      \"max_output_lag\": %u,\n",
+            ps_stream->u4_max_output_lag);
+    fprintf(ps_fp, "      \"decode_errors\": %u,\n",
+            ps_stream->u4_decode_errors);
+    fprintf(ps_fp, "      \"wall_ms\": %.3f,\n", ps_stream->u8_wall_ns / 1e6);
+    fprintf(ps_fp, "      \"init_ms\": %.3f,\n", ps_stream->u8_init_ns / 1e6);
+    fprintf(ps_fp, "      \"fps\": %.2f,\n",
+            (d_wall_s > 0) ? ps_stream->u4_frames_decoded / d_wall_s : 0.0);
+    fprintf(ps_fp,
+            "      \"latency_us\": {\"mean\": %.1f, \"p50\": %.1f, "
+            "\"p99\": %.1f, \"max\": %.1f},\n",
+            d_mean_us,
+            bench_percentile_us(ps_stream->pu8_latency_ns,
+                                ps_stream->u4_num_latency, 50),
+            bench_percentile_us(ps_stream->pu8_latency_ns,
+                                ps_stream->u4_num_latency, 99),
+            bench_percentile_us(ps_stream->pu8_latency_ns,
+                                ps_stream->u4_num_latency, 100));
+    fprintf(ps_fp,
+            "      \"cpu_ms\": {\"main_thread\": %.3f, "
+            "\"worker_threads\": %.3f, \"total\": %.3f},\n",
+            ps_stream->u8_cpu_main_ns / 1e6, u8_cpu_workers_ns / 1e6,
+            ps_stream->u8_cpu_process_ns / 1e6);
+    fprintf(ps_fp, "      \"cpu_utilization\": %.2f,\n",
+            (d_wall_s > 0) ? ps_stream->u8_cpu_process_ns / 1e9 / d_wall_s
+                           : 0.0);
+    if (ps_stream->u4_dtlb_valid)
+      fprintf(ps_fp, "      \"dtlb_misses\": %llu,\n",
+              (unsigned long long) ps_stream->u8_dtlb_misses);
+    if (ps_stream->u4_perf_stats) {
+      fprintf(ps_fp,
+              "      \"perf_stats\": {\"stage_ms\": {\"parse\": %.3f, "
+              "\"mc\": %.3f, \"recon\": %.3f, \"bs\": %.3f, "
+              "\"deblk\": %.3f, \"fmt_conv\": %.3f, \"wait\": %.3f},\n",
+              ps_stream->ad_stage_ms[IH264D_PERF_STAGE_PARSE],
+              ps_stream->ad_stage_ms[IH264D_PERF_STAGE_MC],
+              ps_stream->ad_stage_ms[IH264D_PERF_STAGE_RECON],
+              ps_stream->ad_stage_ms[IH264D_PERF_STAGE_BS],
+              ps_stream->ad_stage_ms[IH264D_PERF_STAGE_DEBLK],
+              ps_stream->ad_stage_ms[IH264D_PERF_STAGE_FMT_CONV],
+              ps_stream->ad_stage_ms[IH264D_PERF_STAGE_WAIT]);
+      fprintf(ps_fp,
+              "        \"mbs\": {\"i4x4\": %llu, \"i8x8\": %llu, "
+              "\"i16x16\": %llu, \"ipcm\": %llu, \"p\": %llu, "
+              "\"p_skip\": %llu, \"b\": %llu, \"b_skip\": %llu},\n",
+              (unsigned long long) ps_stream->au8_num_mbs[IH264D_PERF_MB_I4x4],
+              (unsigned long long) ps_stream->au8_num_mbs[IH264D_PERF_MB_I8x8],
+              (unsigned long long)
+                  ps_stream->au8_num_mbs[IH264D_PERF_MB_I16x16],
+              (unsigned long long) ps_stream->au8_num_mbs[IH264D_PERF_MB_IPCM],
+              (unsigned long long) ps_stream->au8_num_mbs[IH264D_PERF_MB_P],
+              (unsigned long long)
+                  ps_stream->au8_num_mbs[IH264D_PERF_MB_P_SKIP],
+              (unsigned long long) ps_stream->au8_num_mbs[IH264D_PERF_MB_B],
+              (unsigned long long)
+                  ps_stream->au8_num_mbs[IH264D_PERF_MB_B_SKIP]);
+      fprintf(ps_fp,
+              "        \"bins\": %llu, \"bypass_bins\": %llu, "
+              "\"spin_waits\": %llu},\n",
+              (unsigned long long) ps_stream->u8_num_bins,
+              (unsigned long long) ps_stream->u8_num_bypass_bins,
+              (unsigned long long) ps_stream->u8_num_spin_waits);
+    }
+    if (ps_cfg->u4_deadline_us || ps_cfg->u4_target_fps)
+      fprintf(ps_fp,
+              "      \"deadline\": {\"max_level\": %u, \"pics\": %u, "
+              "\"over_deadline\": %u, \"escalations\": %u, "
+              "\"relaxations\": %u, \"deblk_skipped\": %u, "
+              "\"full_pel\": %u, \"dropped\": %u},\n",
+              ps_stream->u4_dl_max_level, ps_stream->u4_dl_num_pics,
+              ps_stream->u4_dl_num_over_deadline,
+              ps_stream->u4_dl_num_escalations,
+              ps_stream->u4_dl_num_relaxations,
+              ps_stream->u4_dl_num_deblk_skipped,
+              ps_stream->u4_dl_num_full_pel, ps_stream->u4_dl_num_dropped);
+    fprintf(ps_fp,
+            "      \"mem_components\": {\"dpb\": %u, \"mv_bank\": %u, "
+            "\"bitstream\": %u, \"mb_context\": %u, "
+            "\"thread_scratch\": %u, \"other\": %u, "
+            "\"reorder_frames\": %u, \"extra_disp_bufs\": %u},\n",
+            ps_stream->au4_component_size[IH264D_MEM_COMPONENT_DPB],
+            ps_stream->au4_component_size[IH264D_MEM_COMPONENT_MV_BANK],
+            ps_stream->au4_component_size[IH264D_MEM_COMPONENT_BITSTREAM],
+            ps_stream->au4_component_size[IH264D_MEM_COMPONENT_MB_CONTEXT],
+            ps_stream->au4_component_size[IH264D_MEM_COMPONENT_THREAD_SCRATCH],
+            ps_stream->au4_component_size[IH264D_MEM_COMPONENT_OTHER],
+            ps_stream->u4_num_reorder_frames,
+            ps_stream->u4_num_extra_disp_buf);
+    fprintf(ps_fp, "      \"codec_mem_bytes\": %u,\n",
+            ps_stream->u4_codec_mem_size);
+    fprintf(ps_fp, "      \"app_buf_bytes\": %u\n    }%s\n",
+            ps_stream->u4_app_mem_size,
+            (i + 1 < ps_cfg->u4_num_streams) ? "," : "");
+  }
+  fprintf(ps_fp, "  ],\n");
+
+  fprintf(ps_fp, "  \"total_frames\": %u,\n", u4_tot_frames);
+  fprintf(ps_fp, "  \"total_fps\": %.2f,\n",
+          (u8_tot_wall_ns > 0) ? u4_tot_frames / (u8_tot_wall_ns / 1e9) : 0.0);
+  if (NULL != ps_cfg->ps_pool) {
+    buf_pool_stats_t s_pool_stats;
+
+    buf_pool_get_stats(ps_cfg->ps_pool, &s_pool_stats);
+    fprintf(ps_fp,
+            "  \"pool\": {\"peak_bytes\": %llu, \"cached_bytes\": %llu, "
+            "\"hits\": %u, \"misses\": %u, \"quota_fails\": %u, "
+            "\"limit_fails\": %u},\n",
+            (unsigned long long) s_pool_stats.u8_peak_bytes,
+            (unsigned long long) s_pool_stats.u8_bytes_cached,
+            s_pool_stats.u4_num_hits, s_pool_stats.u4_num_misses,
+            s_pool_stats.u4_num_quota_fails, s_pool_stats.u4_num_limit_fails);
+  }
+  /* ru_maxrss is in kilobytes on Linux */
+  fprintf(ps_fp, "  \"peak_rss_kb\": %ld\n}\n", (long) s_usage.ru_maxrss);
+}
+
+/* Names the decoder threads of every stream and closes the trace */
+static void bench_close_trace(bench_cfg_t *ps_cfg, bench_stream_t *ps_streams) {
+  UWORD32 u4_num_tids = IH264D_TRACE_THREAD_DEBLK_WORKER;
+  UWORD32 u4_strm, u4_tid;
+
+  if (ps_cfg->u4_num_cores > 1) u4_num_tids += ps_cfg->u4_num_cores - 1;
+
+  for (u4_strm = 0; u4_strm < ps_cfg->u4_num_streams; u4_strm++) {
+    fprintf(ps_cfg->ps_trace_file,
+            "%s\n{\"name\": \"process_name\", \"ph\": \"M\", \"pid\": %u, "
+            "\"args\": {\"name\": ",
+            ps_cfg->u4_trace_events_written ? "," : "", u4_strm);
+    bench_print_str(ps_cfg->ps_trace_file, ps_streams[u4_strm].pc_fname);
+    fprintf(ps_cfg->ps_trace_file, "}}");
+    ps_cfg->u4_trace_events_written++;
+
+    /* There can be as many deblocking workers as cores, the first one */
+    /* running on the main or the compute bs thread                    */
+    for (u4_tid = 0; u4_tid < u4_num_tids; u4_tid++) {
+      CHAR ac_name[32];
+
+      if (IH264D_TRACE_THREAD_MAIN == u4_tid)
+        sprintf(ac_name, "main (parse)");
+      else if (IH264D_TRACE_THREAD_DEC == u4_tid)
+        sprintf(ac_name, "decode");
+      else if (IH264D_TRACE_THREAD_BS == u4_tid)
+        sprintf(ac_name, "compute bs / deblock");
+      else
+        sprintf(ac_name, "deblock worker %u",
+                u4_tid - IH264D_TRACE_THREAD_DEBLK_WORKER + 1);
+      fprintf(ps_cfg->ps_trace_file,
+              ",\n{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": %u, "
+              "\"tid\": %u, \"args\": {\"name\": \"%s\"}}",
+              u4_strm, u4_tid, ac_name);
+    }
+  }
+  fprintf(ps_cfg->ps_trace_file, "\n]}\n");
+  fclose(ps_cfg->ps_trace_file);
+
+  if (ps_cfg->u4_trace_events_dropped)
+    fprintf(stderr, "%u trace events were overwritten before being read\n",
+            ps_cfg->u4_trace_events_dropped);
+}
+
+static void bench_usage(void) {
+  printf("Usage: app264_bench [options] --input <stream> [--input <stream>]\n");
+  printf("  --input <file>          Elementary stream, may be repeated\n");
+  printf("  --iterations <n>        Measured decodes of each stream "
+         "(Default: %d)\n", DEFAULT_ITERATIONS);
+  printf("  --warmup <n>            Unmeasured decodes before them "
+         "(Default: %d)\n", DEFAULT_WARMUP);
+  printf("  --num_cores <n>         Number of cores (Default: %d)\n",
+         DEFAULT_NUM_CORES);
+  printf("  --arch <arch>           ARM_NONEON, ARM_A9Q, ARM_A7, ARM_A5, "
+         "ARM_NEONINTR, ARMV8_GENERIC, X86_GENERIC, X86_SSSE3, X86_SSE42, "
+         "WASM_GENERIC, WASM_SIMD128\n");
+  printf("  --chroma_format <fmt>   YUV_420P, YUV_420SP_UV, YUV_420SP_VU, "
+         "YUV_422ILE, RGB_565, RGBA_8888 (Default: YUV_420P)\n");
+  printf("  --share_display_buf <0|1>  Share display buffers with codec\n");
+  printf("  --alloc_per_sps <0|1>   Allocate picture sized memory on SPS "
+         "activation\n");
+  printf("  --huge_pages <0|1>      Back the memory records the decoder marks "
+         "as hot with huge pages\n");
+  printf("  --mem_budget <bytes>    Fit the memory records in a budget by "
+         "lowering the extra display buffers and the reorder depth\n");
+  printf("  --film_grain <0|1>      Add the film grain of film grain "
+         "characteristics SEI to the output\n");
+  printf("  --pool <0|1>            Draw the memory of --alloc_per_sps from a "
+         "pool shared by all instances\n");
+  printf("  --pool_max_mb <n>       Limit on the memory the pool takes from "
+         "the system (Default: none)\n");
+  printf("  --pool_quota_mb <n>     Limit on the pool memory of one instance "
+         "(Default: none)\n");
+  printf("  --mc_prefetch_dist <n>  MC reference prefetch distance\n");
+  printf("  --low_delay <0|1>       Output each picture in the decode call "
+         "that decodes it when the stream allows\n");
+  printf("  --intra_only <0|1>      Stream has I slices only, no reference "
+         "pictures, padding or co-located MVs\n");
+  printf("  --deadline_us <n>       Decode time per picture above which "
+         "non-reference pictures are degraded (Default: 0, off)\n");
+  printf("  --target_fps <n>        Deadline given as a frame rate, used "
+         "when --deadline_us is 0 (Default: 0, off)\n");
+  printf("  --max_wd <n>            Maximum width (Default: %d)\n",
+         MAX_FRAME_WIDTH);
+  printf("  --max_ht <n>            Maximum height (Default: %d)\n",
+         MAX_FRAME_HEIGHT);
+  printf("  --max_level <n>         Maximum level (Default: %d)\n",
+         MAX_LEVEL_SUPPORTED);
+  printf("  --json <file>           Write results to file instead of stdout\n");
+  printf("  --trace <file>          Write the decoder trace events of measured "
+         "iterations as Chrome trace JSON\n");
+}
+
+static IVD_ARCH_T bench_parse_arch(CHAR *pc_value) {
+  if (0 == strcmp(pc_value, "ARM_NONEON")) return ARCH_ARM_NONEON;
+  if (0 == strcmp(pc_value, "ARM_A9Q")) return ARCH_ARM_A9Q;
+  if (0 == strcmp(pc_value, "ARM_A7")) return ARCH_ARM_A7;
+  if (0 == strcmp(pc_value, "ARM_A5")) return ARCH_ARM_A5;
+  if (0 == strcmp(pc_value, "ARM_NEONINTR")) return ARCH_ARM_NEONINTR;
+  if (0 == strcmp(pc_value, "ARMV8_GENERIC")) return ARCH_ARMV8_GENERIC;
+  if (0 == strcmp(pc_value, "X86_GENERIC")) return ARCH_X86_GENERIC;
+  if (0 == strcmp(pc_value, "X86_SSSE3")) return ARCH_X86_SSSE3;
+  if (0 == strcmp(pc_value, "X86_SSE42")) return ARCH_X86_SSE42;
+  if (0 == strcmp(pc_value, "X86_AVX2")) return ARCH_X86_AVX2;
+  if (0 == strcmp(pc_value, "MIPS_GENERIC")) return ARCH_MIPS_GENERIC;
+  if (0 == strcmp(pc_value, "MIPS_32")) return ARCH_MIPS_32;
+  if (0 == strcmp(pc_value, "WASM_GENERIC")) return ARCH_WASM_GENERIC;
+  if (0 == strcmp(pc_value, "WASM_SIMD128")) return ARCH_WASM_SIMD128;
+  bench_exit("Invalid --arch");
+  return ARCH_NA;
+}
+
+static IV_COLOR_FORMAT_T bench_parse_chroma_format(CHAR *pc_value) {
+  if (0 == strcmp(pc_value, "YUV_420P")) return IV_YUV_420P;
+  if (0 == strcmp(pc_value, "YUV_420SP_UV")) return IV_YUV_420SP_UV;
+  if (0 == strcmp(pc_value, "YUV_420SP_VU")) return IV_YUV_420SP_VU;
+  if (0 == strcmp(pc_value, "YUV_422ILE")) return IV_YUV_422ILE;
+  if (0 == strcmp(pc_value, "RGB_565")) return IV_RGB_565;
+  if (0 == strcmp(pc_value, "RGBA_8888")) return IV_RGBA_8888;
+  bench_exit("Invalid --chroma_format");
+  return IV_CHROMA_NA;
+}
+
+int main(WORD32 argc, CHAR *argv[]) {
+  bench_cfg_t s_cfg;
+  bench_stream_t *ps_streams;
+  FILE *ps_json_file = stdout;
+  CHAR *pc_trace_fname = NULL;
+  WORD32 i;
+  UWORD32 u4_strm, u4_iter;
+
+  memset(&s_cfg, 0, sizeof(bench_cfg_t));
+  s_cfg.u4_iterations = DEFAULT_ITERATIONS;
+  s_cfg.u4_warmup = DEFAULT_WARMUP;
+  s_cfg.u4_num_cores = DEFAULT_NUM_CORES;
+  s_cfg.i4_mc_prefetch_dist = -1;
+  s_cfg.e_output_chroma_format = IV_YUV_420P;
+
+  for (i = 1; i < argc; i++) {
+    CHAR *pc_arg = argv[i];
+    CHAR *pc_value = (i + 1 < argc) ? argv[i + 1] : NULL;
+
+    if ((0 == strcmp(pc_arg, "--help")) || (0 == strcmp(pc_arg, "-h"))) {
+      bench_usage();
+      return 0;
+    }
+    if (NULL == pc_value) {
+      bench_usage();
+      bench_exit("Missing value for the last argument");
+    }
+    i++;
+
+    if (0 == strcmp(pc_arg, "--input")) {
+      if (s_cfg.u4_num_streams == MAX_STREAMS) bench_exit("Too many streams");
+      s_cfg.apc_stream_fname[s_cfg.u4_num_streams++] = pc_value;
+    } else if (0 == strcmp(pc_arg, "--iterations")) {
+      s_cfg.u4_iterations = atoi(pc_value);
+    } else if (0 == strcmp(pc_arg, "--warmup")) {
+      s_cfg.u4_warmup = atoi(pc_value);
+    } else if (0 == strcmp(pc_arg, "--num_cores")) {
+      s_cfg.u4_num_cores = atoi(pc_value);
+    } else if (0 == strcmp(pc_arg, "--arch")) {
+      s_cfg.e_arch = bench_parse_arch(pc_value);
+      s_cfg.i4_arch_set = 1;
+    } else if (0 == strcmp(pc_arg, "--chroma_format")) {
+      s_cfg.e_output_chroma_format = bench_parse_chroma_format(pc_value);
+    } else if (0 == strcmp(pc_arg, "--share_display_buf")) {
+      s_cfg.u4_share_disp_buf = atoi(pc_value);
+    } else if (0 == strcmp(pc_arg, "--alloc_per_sps")) {
+      s_cfg.u4_alloc_per_sps = atoi(pc_value);
+    } else if (0 == strcmp(pc_arg, "--huge_pages")) {
+      s_cfg.u4_huge_pages = atoi(pc_value);
+    } else if (0 == strcmp(pc_arg, "--mem_budget")) {
+      s_cfg.u4_mem_budget = (UWORD32) strtoul(pc_value, NULL, 10);
+    } else if (0 == strcmp(pc_arg, "--film_grain")) {
+      s_cfg.u4_film_grain = atoi(pc_value);
+    } else if (0 == strcmp(pc_arg, "--pool")) {
+      s_cfg.u4_use_pool = atoi(pc_value);
+    } else if (0 == strcmp(pc_arg, "--pool_max_mb")) {
+      s_cfg.u4_pool_max_mb = atoi(pc_value);
+    } else if (0 == strcmp(pc_arg, "--pool_quota_mb")) {
+      s_cfg.u4_pool_quota_mb = atoi(pc_value);
+    } else if (0 == strcmp(pc_arg, "--mc_prefetch_dist")) {
+      s_cfg.i4_mc_prefetch_dist = atoi(pc_value);
+    } else if (0 == strcmp(pc_arg, "--low_delay")) {
+      s_cfg.u4_low_delay = atoi(pc_value);
+    } else if (0 == strcmp(pc_arg, "--intra_only")) {
+      s_cfg.u4_intra_only = atoi(pc_value);
+    } else if (0 == strcmp(pc_arg, "--deadline_us")) {
+      s_cfg.u4_deadline_us = atoi(pc_value);
+    } else if (0 == strcmp(pc_arg, "--target_fps")) {
+      s_cfg.u4_target_fps = atoi(pc_value);
+    } else if (0 == strcmp(pc_arg, "--max_wd")) {
+      s_cfg.u4_max_wd = atoi(pc_value);
+    } else if (0 == strcmp(pc_arg, "--max_ht")) {
+      s_cfg.u4_max_ht = atoi(pc_value);
+    } else if (0 == strcmp(pc_arg, "--max_level")) {
+      s_cfg.u4_max_level = atoi(pc_value);
+    } else if (0 == strcmp(pc_arg, "--json")) {
+      s_cfg.pc_json_fname = pc_value;
+    } else if (0 == strcmp(pc_arg, "--trace")) {
+      pc_trace_fname = pc_value;
+    } else {
+      bench_usage();
+      bench_exit("Unknown argument");
+    }
+  }
+
+  if (0 == s_cfg.u4_num_streams) {
+    bench_usage();
+    bench_exit("No input stream given");
+  }
+  if (0 == s_cfg.u4_iterations) s_cfg.u4_iterations = 1;
+
+  /* The codec falls back to unshared buffers for other formats */
+  if ((IV_YUV_420P != s_cfg.e_output_chroma_format) &&
+      (IV_YUV_420SP_UV != s_cfg.e_output_chroma_format) &&
+      (IV_YUV_420SP_VU != s_cfg.e_output_chroma_format))
+    s_cfg.u4_share_disp_buf = 0;
+
+  /* Only the memory allocated on SPS activation comes from the pool */
+  if (s_cfg.u4_use_pool) {
+    s_cfg.u4_alloc_per_sps = 1;
+    s_cfg.ps_pool = buf_pool_create((UWORD64) s_cfg.u4_pool_max_mb << 20);
+    if (NULL == s_cfg.ps_pool) bench_exit("Allocation failure for pool");
+  }
+
+  ps_streams = (bench_stream_t *) calloc(s_cfg.u4_num_streams,
+                                         sizeof(bench_stream_t));
+  if (NULL == ps_streams) bench_exit("Allocation failure for streams");
+
+  /* Load everything before decoding anything, so that no file I/O */
+  /* happens between measured iterations                           */
+  for (u4_strm = 0; u4_strm < s_cfg.u4_num_streams; u4_strm++) {
+    ps_streams[u4_strm].pc_fname = s_cfg.apc_stream_fname[u4_strm];
+    ps_streams[u4_strm].u4_idx = u4_strm;
+    bench_load_stream(&ps_streams[u4_strm]);
+  }
+
+  if (NULL != pc_trace_fname) {
+    s_cfg.ps_trace_file = fopen(pc_trace_fname, "w");
+    if (NULL == s_cfg.ps_trace_file) bench_exit("Could not open trace file");
+    fprintf(s_cfg.ps_trace_file, "{\"traceEvents\": [");
+  }
+
+  for (u4_strm = 0; u4_strm < s_cfg.u4_num_streams; u4_strm++) {
+    for (u4_iter = 0; u4_iter < s_cfg.u4_warmup; u4_iter++)
+      bench_run_iteration(&s_cfg, &ps_streams[u4_strm], 0);
+    for (u4_iter = 0; u4_iter < s_cfg.u4_iterations; u4_iter++)
+      bench_run_iteration(&s_cfg, &ps_streams[u4_strm], 1);
+  }
+
+  if (NULL != s_cfg.pc_json_fname) {
+    ps_json_file = fopen(s_cfg.pc_json_fname, "w");
+    if (NULL == ps_json_file) bench_exit("Could not open json file");
+  }
+  bench_print_json(ps_json_file, &s_cfg, ps_streams);
+  if (stdout != ps_json_file) fclose(ps_json_file);
+  if (NULL != s_cfg.ps_trace_file) bench_close_trace(&s_cfg, ps_streams);
+
+  for (u4_strm = 0; u4_strm < s_cfg.u4_num_streams; u4_strm++) {
+    free(ps_streams[u4_strm].pu1_buf);
+    free(ps_streams[u4_strm].pu8_latency_ns);
+  }
+  free(ps_streams);
+  if (NULL != s_cfg.ps_pool) buf_pool_delete(s_cfg.ps_pool);
+
+  return 0;
+}
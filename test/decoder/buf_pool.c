@@ -0,0 +1,366 @@
+/* Copyright (c) [2020]-[2023] Ittiam Systems Pvt. Ltd.
+   All rights reserved.
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted (subject to the limitations in the
+   disclaimer below) provided that the following conditions are met:
+   •    Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+   •    Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+   •    None of the names of Ittiam Systems Pvt. Ltd., its affiliates,
+   investors, business partners, nor the names of its contributors may be
+   used to endorse or promote products derived from this software without
+   specific prior written permission.
+
+   NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED
+   BY THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+   BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+   FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+   HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+   OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+   WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+   OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+   EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+   This Software is an implementation of the AVC/H.264
+   standard by Ittiam Systems Pvt. Ltd. (“Ittiam”).
+   Additional patent licenses may be required for this Software,
+   including, but not limited to, a license from MPEG LA’s AVC/H.264
+   licensing program (see https://www.mpegla.com/programs/avc-h-264/).
+
+   NOTWITHSTANDING ANYTHING TO THE CONTRARY, THIS DOES NOT GRANT ANY
+   EXPRESS OR IMPLIED LICENSES TO ANY PATENT CLAIMS OF ANY AFFILIATE
+   (TO THE EXTENT NOT IN THE LEGAL ENTITY), INVESTOR, OR OTHER
+   BUSINESS PARTNER OF ITTIAM. You may only use this software or
+   modifications thereto for purposes that are authorized by
+   appropriate patent licenses. You should seek legal advice based
+   upon your implementation details.
+
+---------------------------------------------------------------
+*/
+/*****************************************************************************/
+/*                                                                           */
+/*  File Name         : buf_pool.c                                           */
+/*                                                                           */
+/*  Description       : Process wide pool of aligned buffers shared by many  */
+/*                      decoder instances. Buffers returned by a client are  */
+/*                      kept in a free list of the NUMA node they were first */
+/*                      touched on and handed to the next request from that  */
+/*                      node that they fit                                   */
+/*                                                                           */
+/*  List of Functions : buf_pool_aligned_malloc                              */
+/*                      buf_pool_cur_node                                    */
+/*                      buf_pool_release_largest                             */
+/*                      buf_pool_create                                      */
+/*                      buf_pool_delete                                      */
+/*                      buf_pool_add_client                                  */
+/*                      buf_pool_remove_client                               */
+/*                      buf_pool_alloc                                       */
+/*                      buf_pool_free                                        */
+/*                      buf_pool_get_stats                                   */
+/*                                                                           */
+/*  Issues / Problems : None                                                 */
+/*                                                                           */
+/*  Revision History  :                                                      */
+/*                                                                           */
+/*         DD MM YYYY   Author(s)       Changes                              */
+/*         19 10 2026                   Initial Version                      */
+/*****************************************************************************/
+/*****************************************************************************/
+/* File Includes                                                             */
+/*****************************************************************************/
+#ifdef __linux__
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+#include <unistd.h>
+#include <sys/syscall.h>
+#endif
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+#ifndef IOS
+#include <malloc.h>
+#endif
+
+#include "ih264_typedefs.h"
+#include "ithread.h"
+#include "buf_pool.h"
+
+/*****************************************************************************/
+/* Constant Macros                                                           */
+/*****************************************************************************/
+/* A free buffer is reused for requests down to half its size, so that a */
+/* small picture does not pin a much larger buffer                       */
+#define BUF_POOL_MIN_FILL_SHIFT 1
+
+/*****************************************************************************/
+/* Typedefs                                                                  */
+/*****************************************************************************/
+/* Kept right in front of every buffer handed out */
+typedef struct buf_pool_blk_t {
+  struct buf_pool_blk_t *ps_next;
+  UWORD8 *pu1_raw;
+  buf_pool_client_t *ps_client;
+  UWORD32 u4_size;
+  UWORD32 u4_alignment;
+  UWORD32 u4_node;
+} buf_pool_blk_t;
+
+struct buf_pool_t {
+  void *pv_mutex;
+  buf_pool_blk_t *aps_free[BUF_POOL_MAX_NODES];
+  UWORD64 u8_max_bytes;
+  UWORD32 u4_num_clients;
+  buf_pool_stats_t s_stats;
+};
+
+struct buf_pool_client_t {
+  buf_pool_t *ps_pool;
+  UWORD64 u8_quota;
+  UWORD64 u8_bytes_in_use;
+};
+
+static void *buf_pool_aligned_malloc(WORD32 alignment, WORD32 i4_size) {
+#ifdef IOS
+  return malloc(i4_size);
+#else
+  return memalign(alignment, i4_size);
+#endif
+}
+
+/* Node of the CPU the caller runs on */
+static UWORD32 buf_pool_cur_node(void) {
+#if defined(__linux__) && defined(SYS_getcpu)
+  unsigned int u4_cpu, u4_node;
+
+  if (0 == syscall(SYS_getcpu, &u4_cpu, &u4_node, NULL))
+    return (u4_node < BUF_POOL_MAX_NODES) ? u4_node : BUF_POOL_MAX_NODES - 1;
+#endif
+  return 0;
+}
+
+/* Hands the largest cached buffer of any node back to the system. Called */
+/* with the pool locked. Returns 0 when nothing is cached                  */
+static WORD32 buf_pool_release_largest(buf_pool_t *ps_pool) {
+  buf_pool_blk_t **pps_largest = NULL;
+  buf_pool_blk_t *ps_blk;
+  UWORD32 u4_node;
+
+  for (u4_node = 0; u4_node < BUF_POOL_MAX_NODES; u4_node++) {
+    buf_pool_blk_t **pps_blk;
+
+    for (pps_blk = &ps_pool->aps_free[u4_node]; NULL != *pps_blk;
+         pps_blk = &(*pps_blk)->ps_next) {
+      if ((NULL == pps_largest) ||
+          ((*pps_blk)->u4_size > (*pps_largest)->u4_size))
+        pps_largest = pps_blk;
+    }
+  }
+  if (NULL == pps_largest) return 0;
+
+  ps_blk = *pps_largest;
+  *pps_largest = ps_blk->ps_next;
+  ps_pool->s_stats.u8_bytes_cached -= ps_blk->u4_size;
+  free(ps_blk->pu1_raw);
+  return 1;
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : buf_pool_create                                          */
+/*                                                                           */
+/*  Description   : Creates an empty pool                                    */
+/*                                                                           */
+/*  Inputs        : u8_max_bytes : Limit on the memory taken from the        */
+/*                                 system, 0 for no limit                    */
+/*  Globals       :                                                          */
+/*  Processing    :                                                          */
+/*                                                                           */
+/*  Outputs       :                                                          */
+/*  Returns       : Pool, NULL on allocation failure                         */
+/*                                                                           */
+/*****************************************************************************/
+buf_pool_t *buf_pool_create(UWORD64 u8_max_bytes) {
+  buf_pool_t *ps_pool;
+
+  ps_pool = (buf_pool_t *) calloc(1, sizeof(buf_pool_t) +
+                                         ithread_get_mutex_lock_size());
+  if (NULL == ps_pool) return NULL;
+
+  ps_pool->pv_mutex = ps_pool + 1;
+  ithread_mutex_init(ps_pool->pv_mutex);
+  ps_pool->u8_max_bytes = u8_max_bytes;
+  return ps_pool;
+}
+
+void buf_pool_delete(buf_pool_t *ps_pool) {
+  while (buf_pool_release_largest(ps_pool))
+    ;
+  ithread_mutex_destroy(ps_pool->pv_mutex);
+  free(ps_pool);
+}
+
+buf_pool_client_t *buf_pool_add_client(buf_pool_t *ps_pool, UWORD64 u8_quota) {
+  buf_pool_client_t *ps_client;
+
+  ps_client = (buf_pool_client_t *) calloc(1, sizeof(buf_pool_client_t));
+  if (NULL == ps_client) return NULL;
+
+  ps_client->ps_pool = ps_pool;
+  ps_client->u8_quota = u8_quota;
+
+  ithread_mutex_lock(ps_pool->pv_mutex);
+  ps_pool->u4_num_clients++;
+  ithread_mutex_unlock(ps_pool->pv_mutex);
+  return ps_client;
+}
+
+void buf_pool_remove_client(buf_pool_client_t *ps_client) {
+  buf_pool_t *ps_pool = ps_client->ps_pool;
+
+  ithread_mutex_lock(ps_pool->pv_mutex);
+  ps_pool->u4_num_clients--;
+  ithread_mutex_unlock(ps_pool->pv_mutex);
+  free(ps_client);
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : buf_pool_alloc                                           */
+/*                                                                           */
+/*  Description   : Gets a buffer for a client                               */
+/*                                                                           */
+/*  Inputs        : pv_client : Client returned by buf_pool_add_client()     */
+/*                  alignment : Power of two alignment                       */
+/*                  size      : Size in bytes                                */
+/*  Globals       :                                                          */
+/*  Processing    : The smallest free buffer of the caller's node that fits  */
+/*                  is reused. Otherwise a new buffer is allocated, after    */
+/*                  releasing cached ones if the pool limit needs it, and    */
+/*                  is first touched by the caller so that its pages are     */
+/*                  placed on the caller's node                              */
+/*                                                                           */
+/*  Outputs       :                                                          */
+/*  Returns       : Buffer, NULL if the quota or the pool limit is exceeded  */
+/*                                                                           */
+/*****************************************************************************/
+void *buf_pool_alloc(void *pv_client, WORD32 alignment, WORD32 size) {
+  buf_pool_client_t *ps_client = (buf_pool_client_t *) pv_client;
+  buf_pool_t *ps_pool = ps_client->ps_pool;
+  buf_pool_stats_t *ps_stats = &ps_pool->s_stats;
+  buf_pool_blk_t **pps_best = NULL;
+  buf_pool_blk_t **pps_blk;
+  buf_pool_blk_t *ps_blk;
+  UWORD32 u4_node = buf_pool_cur_node();
+  UWORD32 u4_hdr_size;
+  UWORD8 *pu1_raw;
+
+  if (size <= 0) return NULL;
+  if (alignment < (WORD32) sizeof(void *)) alignment = sizeof(void *);
+  u4_hdr_size = (sizeof(buf_pool_blk_t) + alignment - 1) & ~(alignment - 1);
+
+  ithread_mutex_lock(ps_pool->pv_mutex);
+
+  for (pps_blk = &ps_pool->aps_free[u4_node]; NULL != *pps_blk;
+       pps_blk = &(*pps_blk)->ps_next) {
+    ps_blk = *pps_blk;
+    if ((ps_blk->u4_size < (UWORD32) size) ||
+        ((ps_blk->u4_size >> BUF_POOL_MIN_FILL_SHIFT) > (UWORD32) size) ||
+        (ps_blk->u4_alignment % alignment))
+      continue;
+    if ((NULL == pps_best) || (ps_blk->u4_size < (*pps_best)->u4_size))
+      pps_best = pps_blk;
+  }
+
+  if ((NULL != pps_best) &&
+      ((0 == ps_client->u8_quota) ||
+       (ps_client->u8_bytes_in_use + (*pps_best)->u4_size <=
+        ps_client->u8_quota))) {
+    ps_blk = *pps_best;
+    *pps_best = ps_blk->ps_next;
+    ps_blk->ps_client = ps_client;
+    ps_client->u8_bytes_in_use += ps_blk->u4_size;
+    ps_stats->u8_bytes_cached -= ps_blk->u4_size;
+    ps_stats->u8_bytes_in_use += ps_blk->u4_size;
+    ps_stats->u4_num_hits++;
+    ithread_mutex_unlock(ps_pool->pv_mutex);
+    return (UWORD8 *) (ps_blk + 1);
+  }
+
+  if (ps_client->u8_quota &&
+      (ps_client->u8_bytes_in_use + size > ps_client->u8_quota)) {
+    ps_stats->u4_num_quota_fails++;
+    ithread_mutex_unlock(ps_pool->pv_mutex);
+    return NULL;
+  }
+
+  /* Cached buffers are given up before a live request is refused */
+  while (ps_pool->u8_max_bytes &&
+         (ps_stats->u8_bytes_in_use + ps_stats->u8_bytes_cached + size >
+          ps_pool->u8_max_bytes) &&
+         buf_pool_release_largest(ps_pool))
+    ;
+  if (ps_pool->u8_max_bytes &&
+      (ps_stats->u8_bytes_in_use + ps_stats->u8_bytes_cached + size >
+       ps_pool->u8_max_bytes)) {
+    ps_stats->u4_num_limit_fails++;
+    ithread_mutex_unlock(ps_pool->pv_mutex);
+    return NULL;
+  }
+
+  pu1_raw = (UWORD8 *) buf_pool_aligned_malloc(alignment, u4_hdr_size + size);
+  if (NULL == pu1_raw) {
+    ithread_mutex_unlock(ps_pool->pv_mutex);
+    return NULL;
+  }
+
+  ps_blk = (buf_pool_blk_t *) (pu1_raw + u4_hdr_size) - 1;
+  ps_blk->ps_next = NULL;
+  ps_blk->pu1_raw = pu1_raw;
+  ps_blk->ps_client = ps_client;
+  ps_blk->u4_size = size;
+  ps_blk->u4_alignment = alignment;
+  ps_blk->u4_node = u4_node;
+
+  ps_client->u8_bytes_in_use += size;
+  ps_stats->u8_bytes_in_use += size;
+  ps_stats->u4_num_misses++;
+  if (ps_stats->u8_bytes_in_use + ps_stats->u8_bytes_cached >
+      ps_stats->u8_peak_bytes)
+    ps_stats->u8_peak_bytes =
+        ps_stats->u8_bytes_in_use + ps_stats->u8_bytes_cached;
+
+  ithread_mutex_unlock(ps_pool->pv_mutex);
+
+  /* First touch outside the lock; the pages land on the caller's node */
+  memset(ps_blk + 1, 0, size);
+  return (UWORD8 *) (ps_blk + 1);
+}
+
+void buf_pool_free(void *pv_client, void *pv_buf) {
+  buf_pool_client_t *ps_client = (buf_pool_client_t *) pv_client;
+  buf_pool_t *ps_pool = ps_client->ps_pool;
+  buf_pool_blk_t *ps_blk = (buf_pool_blk_t *) pv_buf - 1;
+
+  ithread_mutex_lock(ps_pool->pv_mutex);
+  ps_client->u8_bytes_in_use -= ps_blk->u4_size;
+  ps_pool->s_stats.u8_bytes_in_use -= ps_blk->u4_size;
+  ps_pool->s_stats.u8_bytes_cached += ps_blk->u4_size;
+  ps_blk->ps_client = NULL;
+  ps_blk->ps_next = ps_pool->aps_free[ps_blk->u4_node];
+  ps_pool->aps_free[ps_blk->u4_node] = ps_blk;
+  ithread_mutex_unlock(ps_pool->pv_mutex);
+}
+
+void buf_pool_get_stats(buf_pool_t *ps_pool, buf_pool_stats_t *ps_stats) {
+  ithread_mutex_lock(ps_pool->pv_mutex);
+  *ps_stats = ps_pool->s_stats;
+  ithread_mutex_unlock(ps_pool->pv_mutex);
+}
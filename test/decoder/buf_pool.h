@@ -0,0 +1,122 @@
+/* Copyright (c) [2020]-[2023] Ittiam Systems Pvt. Ltd.
+   All rights reserved.
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted (subject to the limitations in the
+   disclaimer below) provided that the following conditions are met:
+   •    Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+   •    Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+   •    None of the names of Ittiam Systems Pvt. Ltd., its affiliates,
+   investors, business partners, nor the names of its contributors may be
+   used to endorse or promote products derived from this software without
+   specific prior written permission.
+
+   NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED
+   BY THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+   BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+   FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+   HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+   OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+   WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+   OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+   EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+   This Software is an implementation of the AVC/H.264
+   standard by Ittiam Systems Pvt. Ltd. (“Ittiam”).
+   Additional patent licenses may be required for this Software,
+   including, but not limited to, a license from MPEG LA’s AVC/H.264
+   licensing program (see https://www.mpegla.com/programs/avc-h-264/).
+
+   NOTWITHSTANDING ANYTHING TO THE CONTRARY, THIS DOES NOT GRANT ANY
+   EXPRESS OR IMPLIED LICENSES TO ANY PATENT CLAIMS OF ANY AFFILIATE
+   (TO THE EXTENT NOT IN THE LEGAL ENTITY), INVESTOR, OR OTHER
+   BUSINESS PARTNER OF ITTIAM. You may only use this software or
+   modifications thereto for purposes that are authorized by
+   appropriate patent licenses. You should seek legal advice based
+   upon your implementation details.
+
+---------------------------------------------------------------
+*/
+/*****************************************************************************/
+/*                                                                           */
+/*  File Name         : buf_pool.h                                           */
+/*                                                                           */
+/*  Description       : Process wide pool of aligned buffers shared by many  */
+/*                      decoder instances. Each instance is a client with    */
+/*                      its own quota; buf_pool_alloc() and buf_pool_free()  */
+/*                      match pf_aligned_alloc and pf_aligned_free of        */
+/*                      ih264d_init_ip_t with the client as pv_mem_ctxt      */
+/*                                                                           */
+/*  List of Functions : buf_pool_create()                                    */
+/*                      buf_pool_delete()                                    */
+/*                      buf_pool_add_client()                                */
+/*                      buf_pool_remove_client()                             */
+/*                      buf_pool_alloc()                                     */
+/*                      buf_pool_free()                                      */
+/*                      buf_pool_get_stats()                                 */
+/*                                                                           */
+/*  Issues / Problems : NUMA placement relies on the first touch policy of   */
+/*                      Linux; elsewhere all memory is treated as one node   */
+/*                                                                           */
+/*****************************************************************************/
+
+#ifndef _BUF_POOL_H_
+#define _BUF_POOL_H_
+
+/*****************************************************************************/
+/* Constant Macros                                                           */
+/*****************************************************************************/
+/* Free lists are kept per NUMA node, nodes beyond this share the last one */
+#define BUF_POOL_MAX_NODES 8
+
+/*****************************************************************************/
+/* Typedefs                                                                  */
+/*****************************************************************************/
+typedef struct buf_pool_t buf_pool_t;
+typedef struct buf_pool_client_t buf_pool_client_t;
+
+typedef struct {
+  /* Bytes held by clients and bytes kept in the free lists */
+  UWORD64 u8_bytes_in_use;
+  UWORD64 u8_bytes_cached;
+
+  /* Highest value of in use plus cached, i.e. memory taken from the system */
+  UWORD64 u8_peak_bytes;
+
+  /* Requests served from a free list, and ones that needed a new buffer */
+  UWORD32 u4_num_hits;
+  UWORD32 u4_num_misses;
+
+  /* Requests refused by a client quota or by the pool limit */
+  UWORD32 u4_num_quota_fails;
+  UWORD32 u4_num_limit_fails;
+} buf_pool_stats_t;
+
+/*****************************************************************************/
+/* Function Declarations                                                     */
+/*****************************************************************************/
+/* u8_max_bytes caps the memory taken from the system, cached buffers are */
+/* released to make room before a request fails. 0 means no limit        */
+buf_pool_t *buf_pool_create(UWORD64 u8_max_bytes);
+
+/* All clients have to be removed before */
+void buf_pool_delete(buf_pool_t *ps_pool);
+
+/* u8_quota caps the bytes the client holds at a time. 0 means no quota */
+buf_pool_client_t *buf_pool_add_client(buf_pool_t *ps_pool, UWORD64 u8_quota);
+
+/* All buffers of the client have to be freed before */
+void buf_pool_remove_client(buf_pool_client_t *ps_client);
+
+void *buf_pool_alloc(void *pv_client, WORD32 alignment, WORD32 size);
+
+void buf_pool_free(void *pv_client, void *pv_buf);
+
+void buf_pool_get_stats(buf_pool_t *ps_pool, buf_pool_stats_t *ps_stats);
+
+#endif /* _BUF_POOL_H_ */
@@ -72,6 +72,9 @@
 #ifndef IOS
 #include <malloc.h>
 #endif
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
 #ifdef IOS_DISPLAY
 #include "cast_types.h"
 #else
@@ -220,11 +223,20 @@ typedef struct {
 
   void *cocodec_obj;
   UWORD32 u4_share_disp_buf;
+  UWORD32 u4_alloc_per_sps;
+  UWORD32 u4_huge_pages;
+  UWORD32 u4_mem_budget;
+  UWORD32 u4_film_grain;
   UWORD32 num_disp_buf;
   UWORD32 b_pic_present;
   UWORD32 u4_disable_dblk_level;
   WORD32 i4_degrade_type;
   WORD32 i4_degrade_pics;
+  WORD32 i4_mc_prefetch_dist;
+  UWORD32 u4_low_delay;
+  UWORD32 u4_intra_only;
+  UWORD32 u4_deadline_us;
+  UWORD32 u4_target_fps;
   UWORD32 u4_num_cores;
   UWORD32 disp_delay;
   WORD32 trace_enable;
@@ -301,6 +313,15 @@ typedef enum {
 
   DEGRADE_TYPE,
   DEGRADE_PICS,
+  MC_PREFETCH_DIST,
+  LOW_DELAY,
+  INTRA_ONLY,
+  DEADLINE_US,
+  TARGET_FPS,
+  ALLOC_PER_SPS,
+  HUGE_PAGES,
+  MEM_BUDGET,
+  FILM_GRAIN,
   ARCH,
   SOC,
   PICLEN,
@@ -359,6 +380,34 @@ static const argument_t argument_mapping[] = {
      "Degrade pics : 0 : No degrade  1 : Only on non-reference frames  2 : Do "
      "not degrade every 4th or key frames  3 : All non-key frames  4 : All "
      "frames"},
+    {"--", "--mc_prefetch_dist", MC_PREFETCH_DIST,
+     "Number of MBs ahead whose MC reference is prefetched : 0 to 8, 0 "
+     "disables prefetch (Default: 0)\n"},
+    {"--", "--low_delay", LOW_DELAY,
+     "Output each picture in the decode call that decodes it when the "
+     "stream allows : 0 or 1 (Default: 0)\n"},
+    {"--", "--intra_only", INTRA_ONLY,
+     "Stream has I slices only, no reference pictures, padding or co-located "
+     "MVs : 0 or 1 (Default: 0)\n"},
+    {"--", "--deadline_us", DEADLINE_US,
+     "Decode time per picture in microseconds above which non-reference "
+     "pictures are degraded, 0 disables (Default: 0)\n"},
+    {"--", "--target_fps", TARGET_FPS,
+     "Sets the deadline from a frame rate when --deadline_us is 0, 0 "
+     "disables (Default: 0)\n"},
+    {"--", "--alloc_per_sps", ALLOC_PER_SPS,
+     "Allocate picture sized memory on SPS activation instead of at the "
+     "maximum dimensions : 0 or 1 (Default: 0)\n"},
+    {"--", "--huge_pages", HUGE_PAGES,
+     "Back the memory records the decoder marks as hot with huge pages : "
+     "0 or 1 (Default: 0)\n"},
+    {"--", "--mem_budget", MEM_BUDGET,
+     "Bytes of memory records the decoder must fit in, lowering the extra "
+     "display buffers and then the reorder depth : 0 for no budget "
+     "(Default: 0)\n"},
+    {"--", "--film_grain", FILM_GRAIN,
+     "Add the film grain of film grain characteristics SEI to the output : "
+     "0 or 1 (Default: 0)\n"},
 
     {"--", "--arch", ARCH,
      "Set Architecture. Supported values  ARM_NONEON, ARM_A9Q, ARM_A7, ARM_A5, "
@@ -475,6 +524,48 @@ void ih264a_aligned_free(void *pv_buf) {
   return;
 }
 #endif
+/* Records smaller than this are not worth padding to a huge page */
+#define HUGE_PAGE_MIN_SIZE (512 * 1024)
+#define HUGE_PAGE_SIZE (2 * 1024 * 1024)
+
+/* Allocates a hot memory record for --huge_pages. The size is padded to a */
+/* 2 MB multiple and aligned to it so transparent huge pages can back the  */
+/* whole record, and every page is touched here so that it is placed on    */
+/* the NUMA node of the thread that set up the decoder                     */
+void *ih264a_hot_malloc(WORD32 alignment, WORD32 i4_size) {
+  void *pv_buf;
+
+  if (i4_size < HUGE_PAGE_MIN_SIZE) {
+    pv_buf = ih264a_aligned_malloc(alignment, i4_size);
+    if (pv_buf) memset(pv_buf, 0, i4_size);
+    return pv_buf;
+  }
+
+  i4_size = (i4_size + HUGE_PAGE_SIZE - 1) & ~(HUGE_PAGE_SIZE - 1);
+  if (alignment < HUGE_PAGE_SIZE) alignment = HUGE_PAGE_SIZE;
+  pv_buf = ih264a_aligned_malloc(alignment, i4_size);
+  if (NULL == pv_buf) return NULL;
+#ifdef __linux__
+  madvise(pv_buf, i4_size, MADV_HUGEPAGE);
+#endif
+  memset(pv_buf, 0, i4_size);
+  return pv_buf;
+}
+
+/* Allocator given to the decoder for --alloc_per_sps. The block holds the */
+/* reference pictures, so it is hot                                       */
+void *ih264a_sps_mem_alloc(void *pv_mem_ctxt, WORD32 alignment, WORD32 size) {
+  UWORD32 *pu4_huge_pages = (UWORD32 *) pv_mem_ctxt;
+
+  if (*pu4_huge_pages) return ih264a_hot_malloc(alignment, size);
+  return ih264a_aligned_malloc(alignment, size);
+}
+
+void ih264a_sps_mem_free(void *pv_mem_ctxt, void *pv_buf) {
+  (void) pv_mem_ctxt;
+  ih264a_aligned_free(pv_buf);
+}
+
 /*****************************************************************************/
 /*                                                                           */
 /*  Function Name : set_degrade                                 */
@@ -537,6 +628,225 @@ IV_API_CALL_STATUS_T set_degrade(void *codec_obj, UWORD32 type, WORD32 pics) {
   return (e_dec_status);
 }
 
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : set_mc_prefetch                                          */
+/*                                                                           */
+/*  Description   : Control call to set MC reference prefetch distance       */
+/*                                                                           */
+/*                                                                           */
+/*  Inputs        : codec_obj  - Codec Handle                                */
+/*                  dist - Number of MBs ahead whose reference is prefetched */
+/*                    0 : Prefetch disabled                                  */
+/*  Globals       :                                                          */
+/*  Processing    : Calls MC prefetch control to the codec                   */
+/*                                                                           */
+/*  Outputs       :                                                          */
+/*  Returns       : Control call return i4_status                            */
+/*                                                                           */
+/*  Issues        :                                                          */
+/*                                                                           */
+/*****************************************************************************/
+
+IV_API_CALL_STATUS_T set_mc_prefetch(void *codec_obj, UWORD32 dist) {
+  ih264d_ctl_set_mc_prefetch_ip_t s_ctl_ip;
+  ih264d_ctl_set_mc_prefetch_op_t s_ctl_op;
+  IV_API_CALL_STATUS_T e_dec_status;
+
+  s_ctl_ip.u4_size = sizeof(ih264d_ctl_set_mc_prefetch_ip_t);
+  s_ctl_ip.u4_prefetch_dist = dist;
+  s_ctl_ip.e_cmd = IVD_CMD_VIDEO_CTL;
+  s_ctl_ip.e_sub_cmd =
+      (IVD_CONTROL_API_COMMAND_TYPE_T) IH264D_CMD_CTL_SET_MC_PREFETCH;
+
+  s_ctl_op.u4_size = sizeof(ih264d_ctl_set_mc_prefetch_op_t);
+
+  e_dec_status = ivd_api_function((iv_obj_t *) codec_obj, (void *) &s_ctl_ip,
+                                  (void *) &s_ctl_op);
+
+  if (IV_SUCCESS != e_dec_status) {
+    printf("Error in setting MC prefetch distance \n");
+  }
+  return (e_dec_status);
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : set_low_delay                                            */
+/*                                                                           */
+/*  Description   : Control call to output pictures as soon as decoded       */
+/*                                                                           */
+/*                                                                           */
+/*  Inputs        : codec_obj  - Codec Handle                                */
+/*                  low_delay - 1 to enable, 0 to disable                    */
+/*  Globals       :                                                          */
+/*  Processing    : Calls low delay control to the codec                     */
+/*                                                                           */
+/*  Outputs       :                                                          */
+/*  Returns       : Control call return i4_status                            */
+/*                                                                           */
+/*  Issues        :                                                          */
+/*                                                                           */
+/*****************************************************************************/
+
+IV_API_CALL_STATUS_T set_low_delay(void *codec_obj, UWORD32 low_delay) {
+  ih264d_ctl_set_low_delay_ip_t s_ctl_ip;
+  ih264d_ctl_set_low_delay_op_t s_ctl_op;
+  IV_API_CALL_STATUS_T e_dec_status;
+
+  s_ctl_ip.u4_size = sizeof(ih264d_ctl_set_low_delay_ip_t);
+  s_ctl_ip.u4_low_delay = low_delay;
+  s_ctl_ip.e_cmd = IVD_CMD_VIDEO_CTL;
+  s_ctl_ip.e_sub_cmd =
+      (IVD_CONTROL_API_COMMAND_TYPE_T) IH264D_CMD_CTL_SET_LOW_DELAY;
+
+  s_ctl_op.u4_size = sizeof(ih264d_ctl_set_low_delay_op_t);
+
+  e_dec_status = ivd_api_function((iv_obj_t *) codec_obj, (void *) &s_ctl_ip,
+                                  (void *) &s_ctl_op);
+
+  if (IV_SUCCESS != e_dec_status) {
+    printf("Error in setting low delay \n");
+  }
+  return (e_dec_status);
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : set_intra_only                                           */
+/*                                                                           */
+/*  Description   : Control call to decode a stream of I slices only         */
+/*                                                                           */
+/*                                                                           */
+/*  Inputs        : codec_obj  - Codec Handle                                */
+/*                  intra_only - 1 to enable, 0 to disable                   */
+/*  Globals       :                                                          */
+/*  Processing    : Calls intra only control to the codec                    */
+/*                                                                           */
+/*  Outputs       :                                                          */
+/*  Returns       : Control call return i4_status                            */
+/*                                                                           */
+/*  Issues        :                                                          */
+/*                                                                           */
+/*****************************************************************************/
+
+IV_API_CALL_STATUS_T set_intra_only(void *codec_obj, UWORD32 intra_only) {
+  ih264d_ctl_set_intra_only_ip_t s_ctl_ip;
+  ih264d_ctl_set_intra_only_op_t s_ctl_op;
+  IV_API_CALL_STATUS_T e_dec_status;
+
+  s_ctl_ip.u4_size = sizeof(ih264d_ctl_set_intra_only_ip_t);
+  s_ctl_ip.u4_intra_only = intra_only;
+  s_ctl_ip.e_cmd = IVD_CMD_VIDEO_CTL;
+  s_ctl_ip.e_sub_cmd =
+      (IVD_CONTROL_API_COMMAND_TYPE_T) IH264D_CMD_CTL_SET_INTRA_ONLY;
+
+  s_ctl_op.u4_size = sizeof(ih264d_ctl_set_intra_only_op_t);
+
+  e_dec_status = ivd_api_function((iv_obj_t *) codec_obj, (void *) &s_ctl_ip,
+                                  (void *) &s_ctl_op);
+
+  if (IV_SUCCESS != e_dec_status) {
+    printf("Error in setting intra only \n");
+  }
+  return (e_dec_status);
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : set_deadline                                             */
+/*                                                                           */
+/*  Description   : Control call to degrade non-reference pictures when      */
+/*                  decoding falls behind the deadline                       */
+/*                                                                           */
+/*  Inputs        : codec_obj   - Codec Handle                               */
+/*                  deadline_us - Decode time per picture in microseconds    */
+/*                  target_fps  - Used when deadline_us is 0                 */
+/*  Globals       :                                                          */
+/*  Processing    : Calls deadline control to the codec                      */
+/*                                                                           */
+/*  Outputs       :                                                          */
+/*  Returns       : Control call return i4_status                            */
+/*                                                                           */
+/*  Issues        :                                                          */
+/*                                                                           */
+/*****************************************************************************/
+
+IV_API_CALL_STATUS_T set_deadline(void *codec_obj, UWORD32 deadline_us,
+                                  UWORD32 target_fps) {
+  ih264d_ctl_set_deadline_ip_t s_ctl_ip;
+  ih264d_ctl_set_deadline_op_t s_ctl_op;
+  IV_API_CALL_STATUS_T e_dec_status;
+
+  s_ctl_ip.u4_size = sizeof(ih264d_ctl_set_deadline_ip_t);
+  s_ctl_ip.u4_deadline_us = deadline_us;
+  s_ctl_ip.u4_target_fps = target_fps;
+  s_ctl_ip.e_cmd = IVD_CMD_VIDEO_CTL;
+  s_ctl_ip.e_sub_cmd =
+      (IVD_CONTROL_API_COMMAND_TYPE_T) IH264D_CMD_CTL_SET_DEADLINE;
+
+  s_ctl_op.u4_size = sizeof(ih264d_ctl_set_deadline_op_t);
+
+  e_dec_status = ivd_api_function((iv_obj_t *) codec_obj, (void *) &s_ctl_ip,
+                                  (void *) &s_ctl_op);
+
+  if (IV_SUCCESS != e_dec_status) {
+    printf("Error in setting deadline \n");
+  }
+  return (e_dec_status);
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : print_deadline_stats                                     */
+/*                                                                           */
+/*  Description   : Prints what the deadline controller measured and did     */
+/*                                                                           */
+/*  Inputs        : codec_obj - Codec Handle                                 */
+/*  Globals       :                                                          */
+/*  Processing    : Calls get deadline stats control to the codec            */
+/*                                                                           */
+/*  Outputs       :                                                          */
+/*  Returns       : Control call return i4_status                            */
+/*                                                                           */
+/*  Issues        :                                                          */
+/*                                                                           */
+/*****************************************************************************/
+
+IV_API_CALL_STATUS_T print_deadline_stats(void *codec_obj) {
+  ih264d_ctl_get_deadline_stats_ip_t s_ctl_ip;
+  ih264d_ctl_get_deadline_stats_op_t s_ctl_op;
+  IV_API_CALL_STATUS_T e_dec_status;
+
+  s_ctl_ip.u4_size = sizeof(ih264d_ctl_get_deadline_stats_ip_t);
+  s_ctl_ip.e_cmd = IVD_CMD_VIDEO_CTL;
+  s_ctl_ip.e_sub_cmd =
+      (IVD_CONTROL_API_COMMAND_TYPE_T) IH264D_CMD_CTL_GET_DEADLINE_STATS;
+
+  s_ctl_op.u4_size = sizeof(ih264d_ctl_get_deadline_stats_op_t);
+
+  e_dec_status = ivd_api_function((iv_obj_t *) codec_obj, (void *) &s_ctl_ip,
+                                  (void *) &s_ctl_op);
+
+  if (IV_SUCCESS != e_dec_status) {
+    printf("Error in getting deadline stats \n");
+    return (e_dec_status);
+  }
+
+  printf("Deadline %u us : level %u (max %u), %u up, %u down\n",
+         s_ctl_op.u4_deadline_us, s_ctl_op.u4_level, s_ctl_op.u4_max_level,
+         s_ctl_op.u4_num_escalations, s_ctl_op.u4_num_relaxations);
+  printf("Average decode time (us) : %u, I %u, P %u, B %u\n",
+         s_ctl_op.u4_avg_us, s_ctl_op.au4_type_avg_us[0],
+         s_ctl_op.au4_type_avg_us[1], s_ctl_op.au4_type_avg_us[2]);
+  printf("Pictures : %u, over deadline %u, not deblocked %u, full pel %u, "
+         "dropped %u\n",
+         s_ctl_op.u4_num_pics, s_ctl_op.u4_num_over_deadline,
+         s_ctl_op.u4_num_deblk_skipped, s_ctl_op.u4_num_full_pel,
+         s_ctl_op.u4_num_dropped);
+  return (e_dec_status);
+}
+
 /*****************************************************************************/
 /*                                                                           */
 /*  Function Name : enable_skipb_frames                                      */
@@ -1173,6 +1483,33 @@ void parse_argument(vid_dec_ctx_t *ps_app_ctx, CHAR *argument, CHAR *value) {
     case DEGRADE_TYPE:
       sscanf(value, "%d", &ps_app_ctx->i4_degrade_type);
       break;
+    case MC_PREFETCH_DIST:
+      sscanf(value, "%d", &ps_app_ctx->i4_mc_prefetch_dist);
+      break;
+    case LOW_DELAY:
+      sscanf(value, "%u", &ps_app_ctx->u4_low_delay);
+      break;
+    case INTRA_ONLY:
+      sscanf(value, "%u", &ps_app_ctx->u4_intra_only);
+      break;
+    case DEADLINE_US:
+      sscanf(value, "%u", &ps_app_ctx->u4_deadline_us);
+      break;
+    case TARGET_FPS:
+      sscanf(value, "%u", &ps_app_ctx->u4_target_fps);
+      break;
+    case ALLOC_PER_SPS:
+      sscanf(value, "%d", &ps_app_ctx->u4_alloc_per_sps);
+      break;
+    case HUGE_PAGES:
+      sscanf(value, "%d", &ps_app_ctx->u4_huge_pages);
+      break;
+    case MEM_BUDGET:
+      sscanf(value, "%u", &ps_app_ctx->u4_mem_budget);
+      break;
+    case FILM_GRAIN:
+      sscanf(value, "%u", &ps_app_ctx->u4_film_grain);
+      break;
     case SHARE_DISPLAY_BUF:
       sscanf(value, "%d", &ps_app_ctx->u4_share_disp_buf);
       break;
@@ -1226,6 +1563,10 @@ void parse_argument(vid_dec_ctx_t *ps_app_ctx, CHAR *argument, CHAR *value) {
         ps_app_ctx->e_arch = ARCH_MIPS_GENERIC;
       else if ((strcmp(value, "MIPS_32")) == 0)
         ps_app_ctx->e_arch = ARCH_MIPS_32;
+      else if ((strcmp(value, "WASM_GENERIC")) == 0)
+        ps_app_ctx->e_arch = ARCH_WASM_GENERIC;
+      else if ((strcmp(value, "WASM_SIMD128")) == 0)
+        ps_app_ctx->e_arch = ARCH_WASM_SIMD128;
       else if ((strcmp(value, "ARMV8_GENERIC")) == 0)
         ps_app_ctx->e_arch = ARCH_ARMV8_GENERIC;
       else {
@@ -1871,6 +2212,15 @@ int main(WORD32 argc, CHAR *argv[])
   s_app_ctx.u4_num_cores = DEFAULT_NUM_CORES;
   s_app_ctx.i4_degrade_type = 0;
   s_app_ctx.i4_degrade_pics = 0;
+  s_app_ctx.i4_mc_prefetch_dist = -1;
+  s_app_ctx.u4_low_delay = 0;
+  s_app_ctx.u4_intra_only = 0;
+  s_app_ctx.u4_deadline_us = 0;
+  s_app_ctx.u4_target_fps = 0;
+  s_app_ctx.u4_alloc_per_sps = 0;
+  s_app_ctx.u4_huge_pages = 0;
+  s_app_ctx.u4_mem_budget = 0;
+  s_app_ctx.u4_film_grain = 0;
   s_app_ctx.max_wd = 0;
   s_app_ctx.max_ht = 0;
   s_app_ctx.max_level = 0;
@@ -2108,6 +2458,7 @@ int main(WORD32 argc, CHAR *argv[])
       ih264d_fill_mem_rec_ip_t s_fill_mem_rec_ip;
       ih264d_fill_mem_rec_op_t s_fill_mem_rec_op;
       iv_mem_rec_t *ps_mem_rec;
+      IH264D_MEM_PLACEMENT_T *pe_mem_placement;
       UWORD32 total_size;
 
       s_fill_mem_rec_ip.s_ivd_fill_mem_rec_ip_t.e_cmd = IV_CMD_FILL_NUM_MEM_REC;
@@ -2126,6 +2477,18 @@ int main(WORD32 argc, CHAR *argv[])
       s_fill_mem_rec_ip.e_output_format =
           (IV_COLOR_FORMAT_T) s_app_ctx.e_output_chroma_format;
       s_fill_mem_rec_ip.u4_num_extra_disp_buf = EXTRA_DISP_BUFFERS;
+      s_fill_mem_rec_ip.u4_alloc_per_sps = s_app_ctx.u4_alloc_per_sps;
+      s_fill_mem_rec_ip.u4_mem_budget = s_app_ctx.u4_mem_budget;
+      s_fill_mem_rec_ip.u4_film_grain = s_app_ctx.u4_film_grain;
+      s_fill_mem_rec_ip.u4_intra_only = s_app_ctx.u4_intra_only;
+
+      pe_mem_placement =
+          malloc(u4_num_mem_recs * sizeof(IH264D_MEM_PLACEMENT_T));
+      if (pe_mem_placement == NULL) {
+        sprintf(ac_error_str, "Allocation failure for mem_placement");
+        codec_exit(ac_error_str);
+      }
+      s_fill_mem_rec_ip.pe_mem_placement = pe_mem_placement;
 
       s_fill_mem_rec_ip.s_ivd_fill_mem_rec_ip_t.u4_size =
           sizeof(ih264d_fill_mem_rec_ip_t);
@@ -2155,8 +2518,13 @@ int main(WORD32 argc, CHAR *argv[])
       ps_mem_rec = (iv_mem_rec_t *) pv_mem_rec_location;
       total_size = 0;
       for (i = 0; i < u4_num_mem_recs; i++) {
-        ps_mem_rec->pv_base = ih264a_aligned_malloc(
-            ps_mem_rec->u4_mem_alignment, ps_mem_rec->u4_mem_size);
+        if (s_app_ctx.u4_huge_pages &&
+            IH264D_MEM_PLACEMENT_HOT == pe_mem_placement[i])
+          ps_mem_rec->pv_base = ih264a_hot_malloc(ps_mem_rec->u4_mem_alignment,
+                                                  ps_mem_rec->u4_mem_size);
+        else
+          ps_mem_rec->pv_base = ih264a_aligned_malloc(
+              ps_mem_rec->u4_mem_alignment, ps_mem_rec->u4_mem_size);
         if (ps_mem_rec->pv_base == NULL) {
           sprintf(ac_error_str,
                   "\nAllocation failure for mem record id %d i4_size %d\n", i,
@@ -2166,7 +2534,22 @@ int main(WORD32 argc, CHAR *argv[])
         total_size += ps_mem_rec->u4_mem_size;
         ps_mem_rec++;
       }
+      free(pe_mem_placement);
       printf("\nTotal memory for codec %d\n", total_size);
+      printf("Memory per component: dpb %u mv_bank %u bitstream %u "
+             "mb_context %u thread_scratch %u other %u\n",
+             s_fill_mem_rec_op.au4_component_size[IH264D_MEM_COMPONENT_DPB],
+             s_fill_mem_rec_op.au4_component_size[IH264D_MEM_COMPONENT_MV_BANK],
+             s_fill_mem_rec_op
+                 .au4_component_size[IH264D_MEM_COMPONENT_BITSTREAM],
+             s_fill_mem_rec_op
+                 .au4_component_size[IH264D_MEM_COMPONENT_MB_CONTEXT],
+             s_fill_mem_rec_op
+                 .au4_component_size[IH264D_MEM_COMPONENT_THREAD_SCRATCH],
+             s_fill_mem_rec_op.au4_component_size[IH264D_MEM_COMPONENT_OTHER]);
+      printf("Reorder frames %u, extra display buffers %u\n",
+             s_fill_mem_rec_op.u4_num_reorder_frames,
+             s_fill_mem_rec_op.u4_num_extra_disp_buf);
     }
     /*****************************************************************************/
     /*   API Call: Initialize the Decoder */
@@ -2190,6 +2573,13 @@ int main(WORD32 argc, CHAR *argv[])
       s_init_ip.u4_num_reorder_frames = MAX_REORDER_FRAMES;
       s_init_ip.u4_share_disp_buf = s_app_ctx.u4_share_disp_buf;
       s_init_ip.u4_num_extra_disp_buf = EXTRA_DISP_BUFFERS;
+      s_init_ip.u4_alloc_per_sps = s_app_ctx.u4_alloc_per_sps;
+      s_init_ip.pf_aligned_alloc = ih264a_sps_mem_alloc;
+      s_init_ip.pf_aligned_free = ih264a_sps_mem_free;
+      s_init_ip.pv_mem_ctxt = &s_app_ctx.u4_huge_pages;
+      s_init_ip.u4_mem_budget = s_app_ctx.u4_mem_budget;
+      s_init_ip.u4_film_grain = s_app_ctx.u4_film_grain;
+      s_init_ip.u4_intra_only = s_app_ctx.u4_intra_only;
       s_init_ip.s_ivd_init_ip_t.u4_num_mem_rec = u4_num_mem_recs;
       s_init_ip.s_ivd_init_ip_t.e_output_format =
           (IV_COLOR_FORMAT_T) s_app_ctx.e_output_chroma_format;
@@ -2388,6 +2778,12 @@ int main(WORD32 argc, CHAR *argv[])
 
       if (ret != IV_SUCCESS) {
         printf("Error in header decode %x\n", s_video_decode_op.u4_error_code);
+        /* Bit depth or chroma format the decoder does not handle */
+        if ((s_video_decode_op.u4_error_code >> IVD_UNSUPPORTEDINPUT) & 1) {
+          sprintf(ac_error_str, "Unsupported stream format %x",
+                  s_video_decode_op.u4_error_code);
+          codec_exit(ac_error_str);
+        }
         // codec_exit(ac_error_str);
       }
 
@@ -2591,6 +2987,14 @@ int main(WORD32 argc, CHAR *argv[])
   /*************************************************************************/
 
   set_degrade(codec_obj, s_app_ctx.i4_degrade_type, s_app_ctx.i4_degrade_pics);
+
+  if (s_app_ctx.i4_mc_prefetch_dist >= 0)
+    set_mc_prefetch(codec_obj, s_app_ctx.i4_mc_prefetch_dist);
+  if (s_app_ctx.u4_low_delay) set_low_delay(codec_obj, s_app_ctx.u4_low_delay);
+  if (s_app_ctx.u4_intra_only)
+    set_intra_only(codec_obj, s_app_ctx.u4_intra_only);
+  if (s_app_ctx.u4_deadline_us || s_app_ctx.u4_target_fps)
+    set_deadline(codec_obj, s_app_ctx.u4_deadline_us, s_app_ctx.u4_target_fps);
 #ifdef WINDOWS_TIMER
   QueryPerformanceFrequency(&frequency);
 #endif
@@ -2844,6 +3248,15 @@ int main(WORD32 argc, CHAR *argv[])
             codec_exit(ac_error_str);
           }
         }
+        if (s_app_ctx.i4_mc_prefetch_dist >= 0)
+          set_mc_prefetch(codec_obj, s_app_ctx.i4_mc_prefetch_dist);
+        if (s_app_ctx.u4_low_delay)
+          set_low_delay(codec_obj, s_app_ctx.u4_low_delay);
+        if (s_app_ctx.u4_intra_only)
+          set_intra_only(codec_obj, s_app_ctx.u4_intra_only);
+        if (s_app_ctx.u4_deadline_us || s_app_ctx.u4_target_fps)
+          set_deadline(codec_obj, s_app_ctx.u4_deadline_us,
+                       s_app_ctx.u4_target_fps);
         /*************************************************************************/
         /* set processsor */
         /*************************************************************************/
@@ -3013,6 +3426,9 @@ int main(WORD32 argc, CHAR *argv[])
   flush_output(codec_obj, &s_app_ctx, ps_out_buf, pu1_bs_buf, &u4_op_frm_ts,
                ps_op_file, ps_op_chksum_file, u4_ip_frm_ts, u4_bytes_remaining);
 
+  if (s_app_ctx.u4_deadline_us || s_app_ctx.u4_target_fps)
+    print_deadline_stats(codec_obj);
+
   /* set disp_end u4_flag */
   s_app_ctx.quit = 1;
 
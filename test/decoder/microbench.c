@@ -0,0 +1,1260 @@
+/* Copyright (c) [2020]-[2023] Ittiam Systems Pvt. Ltd.
+   All rights reserved.
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted (subject to the limitations in the
+   disclaimer below) provided that the following conditions are met:
+   •    Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+   •    Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+   •    None of the names of Ittiam Systems Pvt. Ltd., its affiliates,
+   investors, business partners, nor the names of its contributors may be
+   used to endorse or promote products derived from this software without
+   specific prior written permission.
+
+   NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED
+   BY THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+   BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+   FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+   HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+   OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+   WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+   OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+   EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+   This Software is an implementation of the AVC/H.264
+   standard by Ittiam Systems Pvt. Ltd. (“Ittiam”).
+   Additional patent licenses may be required for this Software,
+   including, but not limited to, a license from MPEG LA’s AVC/H.264
+   licensing program (see https://www.mpegla.com/programs/avc-h-264/).
+
+   NOTWITHSTANDING ANYTHING TO THE CONTRARY, THIS DOES NOT GRANT ANY
+   EXPRESS OR IMPLIED LICENSES TO ANY PATENT CLAIMS OF ANY AFFILIATE
+   (TO THE EXTENT NOT IN THE LEGAL ENTITY), INVESTOR, OR OTHER
+   BUSINESS PARTNER OF ITTIAM. You may only use this software or
+   modifications thereto for purposes that are authorized by
+   appropriate patent licenses. You should seek legal advice based
+   upon your implementation details.
+
+---------------------------------------------------------------
+*/
+/*****************************************************************************/
+/*                                                                           */
+/*  File Name         : microbench.c                                         */
+/*                                                                           */
+/*  Description       : Microbenchmark for the DSP kernels used by the       */
+/*                      decoder. Each kernel is run for every function       */
+/*                      pointer tier that the decoder's function selector    */
+/*                      supports on the target, its output is compared with  */
+/*                      the generic C tier, and its cost is reported per     */
+/*                      pixel                                                */
+/*                                                                           */
+/*  List of Functions : kb_run_*                                             */
+/*                      kb_build_cases                                       */
+/*                      kb_init_ctx                                          */
+/*                      kb_reset_work                                        */
+/*                      kb_time_case                                         */
+/*                      main                                                 */
+/*                                                                           */
+/*  Issues / Problems : Cycles are read from the time stamp counter on x86,  */
+/*                      which ticks at the nominal frequency. Other targets  */
+/*                      report nanoseconds                                   */
+/*                                                                           */
+/*  Revision History  :                                                      */
+/*                                                                           */
+/*         DD MM YYYY   Author(s)       Changes                              */
+/*         19 10 2026                   Initial Version                      */
+/*****************************************************************************/
+/*****************************************************************************/
+/* File Includes                                                             */
+/*****************************************************************************/
+#include <stdio.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef X86
+#include <x86intrin.h>
+#endif
+
+#include "ih264_typedefs.h"
+#include "iv.h"
+#include "ivd.h"
+#include "ih264_defs.h"
+#include "ih264_macros.h"
+#include "ih264_platform_macros.h"
+#include "ih264_inter_pred_filters.h"
+#include "ih264_deblk_edge_filters.h"
+#include "ih264_trans_quant_itrans_iquant.h"
+#include "ih264_weighted_pred.h"
+#include "ih264_padding.h"
+#include "ih264_mem_fns.h"
+
+#include "ih264d_structs.h"
+#include "ih264d_tables.h"
+#include "ih264d_function_selector.h"
+
+/*****************************************************************************/
+/* Constant Macros                                                           */
+/*****************************************************************************/
+/* Default stride is that of a padded 1080p luma picture */
+#define KB_DEFAULT_STRD (1920 + 2 * PAD_LEN_Y_H)
+#define KB_ROWS 64
+#define KB_PAD_ROWS 40
+#define KB_COEFF_SIZE (16 * 16 + 64)
+#define KB_TMP_SIZE 4096
+
+#define KB_DEFAULT_CALLS 20000
+#define KB_DEFAULT_ROUNDS 5
+
+/* Offsets into the work area used as the origin of the kernels' blocks, */
+/* leaving room for the filter taps and pads on each side               */
+#define KB_ORG_ROW 8
+#define KB_ORG_COL 64
+
+/* Marks a kernel that has no pointer in dec_struct_t */
+#define KB_FN_MEMCPY_MUL_8 0xFFFFFFFF
+
+#define KB_FN_OFF(x) ((UWORD32) offsetof(dec_struct_t, x))
+
+/* MBs whose boundary strengths are computed per call, the reference indices */
+/* they use and the number of distinct reference pictures these map to      */
+#define KB_BS_MBS 64
+#define KB_BS_NUM_REFS 4
+#define KB_BS_NUM_PICS 2
+/* Entry 0 is reference index -1, L1 follows L0 as in the decoder's list */
+#define KB_BS_MAP_SIZE (1 + POC_LIST_L0_TO_L1_DIFF + KB_BS_NUM_REFS)
+
+/* MB rows of DEBLK_ROW_MBS MBs deblocked per call */
+#define KB_DEBLK_ROWS 4
+
+/*****************************************************************************/
+/* Typedefs                                                                  */
+/*****************************************************************************/
+typedef void (*kb_fn_t)(void);
+
+/* A function pointer tier, selected the way the decoder selects it */
+typedef struct {
+  const CHAR *pc_name;
+  IVD_ARCH_T e_arch;
+  ih264_memcpy_mul_8_ft *pf_memcpy_mul_8;
+} kb_tier_t;
+
+/* Inputs of one boundary strength call: the MB's 4x4 blocks, the bottom */
+/* blocks of the top MB, the right blocks of the left MB (4 apart, as in */
+/* the decoder), the neighbours' reference pictures and the Bs already   */
+/* set from the coded block patterns                                     */
+typedef struct {
+  mv_pred_t as_cur[16];
+  mv_pred_t as_top[4];
+  mv_pred_t as_left[16];
+  neighbouradd_t s_left_addr;
+  void *apv_top_addr[4];
+  UWORD32 au4_bs[8];
+  WORD32 i4_ver_mvlimit;
+} kb_bs_mb_t;
+
+/* Buffers shared by all the kernels. The pristine copies are restored into */
+/* the work buffers before each checked call                                */
+typedef struct {
+  WORD32 i4_strd;
+  UWORD32 u4_buf_size;
+  UWORD8 *pu1_src1_org;
+  UWORD8 *pu1_src2_org;
+  UWORD8 *pu1_dst_org;
+  UWORD8 *pu1_src1;
+  UWORD8 *pu1_src2;
+  UWORD8 *pu1_dst;
+  UWORD8 *pu1_tmp;
+  WORD16 *pi2_coeff_org;
+  WORD16 *pi2_coeff;
+  WORD16 *pi2_out;
+  WORD16 *pi2_tmp;
+  WORD32 *pi4_tmp;
+  kb_bs_mb_t *ps_bs_mbs;
+  void **ppv_bs_ref_map;
+  deblk_row_mb_t *ps_deblk_row_mbs;
+} kb_ctx_t;
+
+struct _kb_case_t;
+
+typedef void kb_run_ft(dec_struct_t *ps_dec, kb_ctx_t *ps_ctx, kb_fn_t pf_fn,
+                       const struct _kb_case_t *ps_case);
+
+/* One benchmarked call: kernel, block size and kernel specific parameter */
+typedef struct _kb_case_t {
+  CHAR ac_name[64];
+  kb_run_ft *pf_run;
+  UWORD32 u4_fn_off;
+  WORD32 i4_wd;
+  WORD32 i4_ht;
+  WORD32 i4_param;
+  UWORD32 u4_num_px;
+} kb_case_t;
+
+/*****************************************************************************/
+/* Tiers                                                                     */
+/*****************************************************************************/
+/* First entry is the reference every other tier is checked against */
+static const kb_tier_t gas_kb_tiers[] = {
+#if defined(ARMV8)
+    {"GENERIC", ARCH_ARM_NONEON, ih264_memcpy_mul_8},
+    {"AV8", ARCH_ARMV8_GENERIC, ih264_memcpy_mul_8_av8},
+#elif defined(ARMV7)
+    {"GENERIC", ARCH_ARM_NONEON, ih264_memcpy_mul_8},
+    {"A9Q", ARCH_ARM_A9Q, ih264_memcpy_mul_8_a9q},
+#elif defined(__wasm_simd128__)
+    {"GENERIC", ARCH_WASM_GENERIC, ih264_memcpy_mul_8},
+    {"SSE42", ARCH_X86_SSE42, ih264_memcpy_mul_8_ssse3},
+    {"SIMD128", ARCH_WASM_SIMD128, ih264_memcpy_mul_8_ssse3},
+#else
+    {"GENERIC", ARCH_X86_GENERIC, ih264_memcpy_mul_8},
+    {"SSSE3", ARCH_X86_SSSE3, ih264_memcpy_mul_8_ssse3},
+    {"SSE42", ARCH_X86_SSE42, ih264_memcpy_mul_8_ssse3},
+#endif
+};
+
+#define KB_NUM_TIERS (sizeof(gas_kb_tiers) / sizeof(gas_kb_tiers[0]))
+
+/* Flat (default) scaling list */
+static const UWORD16 gau2_kb_flat_weigh[64] = {
+    16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16,
+    16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16,
+    16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16,
+    16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16};
+
+/*****************************************************************************/
+/* Helpers                                                                   */
+/*****************************************************************************/
+static UWORD32 gu4_kb_seed = 0x12345678;
+
+static UWORD32 kb_rand(void) {
+  gu4_kb_seed = gu4_kb_seed * 1103515245 + 12345;
+  return gu4_kb_seed >> 8;
+}
+
+static WORD32 kb_rand_range(WORD32 i4_lim) {
+  return (WORD32) (kb_rand() % (UWORD32) (2 * i4_lim + 1)) - i4_lim;
+}
+
+static UWORD64 kb_timer(void) {
+#ifdef X86
+  return __rdtsc();
+#else
+  struct timespec s_ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &s_ts);
+  return (UWORD64) s_ts.tv_sec * 1000000000ULL + (UWORD64) s_ts.tv_nsec;
+#endif
+}
+
+static void *kb_aligned_malloc(UWORD32 u4_size) {
+  void *pv_buf = NULL;
+
+  if (posix_memalign(&pv_buf, 64, u4_size)) return NULL;
+  return pv_buf;
+}
+
+static kb_fn_t kb_get_fn(dec_struct_t *ps_dec, const kb_tier_t *ps_tier,
+                         const kb_case_t *ps_case) {
+  if (KB_FN_MEMCPY_MUL_8 == ps_case->u4_fn_off)
+    return (kb_fn_t) ps_tier->pf_memcpy_mul_8;
+  return *(kb_fn_t *) ((UWORD8 *) ps_dec + ps_case->u4_fn_off);
+}
+
+/* Block origin inside a work buffer */
+static UWORD8 *kb_org(kb_ctx_t *ps_ctx, UWORD8 *pu1_buf) {
+  return pu1_buf + (KB_PAD_ROWS + KB_ORG_ROW) * ps_ctx->i4_strd + KB_ORG_COL;
+}
+
+/*****************************************************************************/
+/* Kernel wrappers                                                           */
+/*****************************************************************************/
+static void kb_run_inter_pred_luma(dec_struct_t *ps_dec, kb_ctx_t *ps_ctx,
+                                   kb_fn_t pf_fn, const kb_case_t *ps_case) {
+  UNUSED(ps_dec);
+  ((ih264_inter_pred_luma_ft *) pf_fn)(
+      kb_org(ps_ctx, ps_ctx->pu1_src1), kb_org(ps_ctx, ps_ctx->pu1_dst),
+      ps_ctx->i4_strd, ps_ctx->i4_strd, ps_case->i4_ht, ps_case->i4_wd,
+      ps_ctx->pu1_tmp, ps_case->i4_param);
+}
+
+static void kb_run_inter_pred_chroma(dec_struct_t *ps_dec, kb_ctx_t *ps_ctx,
+                                     kb_fn_t pf_fn, const kb_case_t *ps_case) {
+  UNUSED(ps_dec);
+  ((ih264_inter_pred_chroma_ft *) pf_fn)(
+      kb_org(ps_ctx, ps_ctx->pu1_src1), kb_org(ps_ctx, ps_ctx->pu1_dst),
+      ps_ctx->i4_strd, ps_ctx->i4_strd, ps_case->i4_param & 7,
+      ps_case->i4_param >> 3, ps_case->i4_ht, ps_case->i4_wd);
+}
+
+static void kb_run_default_weighted_pred(dec_struct_t *ps_dec,
+                                         kb_ctx_t *ps_ctx, kb_fn_t pf_fn,
+                                         const kb_case_t *ps_case) {
+  UNUSED(ps_dec);
+  ((ih264_default_weighted_pred_ft *) pf_fn)(
+      kb_org(ps_ctx, ps_ctx->pu1_src1), kb_org(ps_ctx, ps_ctx->pu1_src2),
+      kb_org(ps_ctx, ps_ctx->pu1_dst), ps_ctx->i4_strd, ps_ctx->i4_strd,
+      ps_ctx->i4_strd, ps_case->i4_ht, ps_case->i4_wd);
+}
+
+/* i4_param 0 is luma, 1 is chroma with packed U and V weights/offsets */
+static void kb_run_weighted_pred(dec_struct_t *ps_dec, kb_ctx_t *ps_ctx,
+                                 kb_fn_t pf_fn, const kb_case_t *ps_case) {
+  WORD32 i4_wt = ps_case->i4_param ? ((40 & 0xffff) | (23 << 16)) : 40;
+  WORD32 i4_ofst = ps_case->i4_param ? ((-3 & 0xff) | (4 << 8)) : -3;
+
+  UNUSED(ps_dec);
+  ((ih264_weighted_pred_ft *) pf_fn)(
+      kb_org(ps_ctx, ps_ctx->pu1_src1), kb_org(ps_ctx, ps_ctx->pu1_dst),
+      ps_ctx->i4_strd, ps_ctx->i4_strd, 5, i4_wt, i4_ofst, ps_case->i4_ht,
+      ps_case->i4_wd);
+}
+
+static void kb_run_weighted_bi_pred(dec_struct_t *ps_dec, kb_ctx_t *ps_ctx,
+                                    kb_fn_t pf_fn, const kb_case_t *ps_case) {
+  WORD32 i4_wt1 = ps_case->i4_param ? ((40 & 0xffff) | (23 << 16)) : 40;
+  WORD32 i4_wt2 = ps_case->i4_param ? ((28 & 0xffff) | (41 << 16)) : 28;
+  WORD32 i4_ofst1 = ps_case->i4_param ? ((2 & 0xff) | (-5 << 8)) : 2;
+  WORD32 i4_ofst2 = ps_case->i4_param ? ((-1 & 0xff) | (3 << 8)) : -1;
+
+  UNUSED(ps_dec);
+  ((ih264_weighted_bi_pred_ft *) pf_fn)(
+      kb_org(ps_ctx, ps_ctx->pu1_src1), kb_org(ps_ctx, ps_ctx->pu1_src2),
+      kb_org(ps_ctx, ps_ctx->pu1_dst), ps_ctx->i4_strd, ps_ctx->i4_strd,
+      ps_ctx->i4_strd, 5, i4_wt1, i4_wt2, i4_ofst1 & 0xffff,
+      i4_ofst2 & 0xffff, ps_case->i4_ht, ps_case->i4_wd);
+}
+
+/* i4_param is the index into the alpha/beta/clip tables; edges are filtered */
+/* in place on the first source buffer                                       */
+static void kb_run_deblk_luma_bs4(dec_struct_t *ps_dec, kb_ctx_t *ps_ctx,
+                                  kb_fn_t pf_fn, const kb_case_t *ps_case) {
+  WORD32 idx = 12 + ps_case->i4_param;
+
+  UNUSED(ps_dec);
+  ((ih264_deblk_edge_bs4_ft *) pf_fn)(
+      kb_org(ps_ctx, ps_ctx->pu1_src1), ps_ctx->i4_strd,
+      gau1_ih264d_alpha_table[idx], gau1_ih264d_beta_table[idx]);
+}
+
+static void kb_run_deblk_luma_bslt4(dec_struct_t *ps_dec, kb_ctx_t *ps_ctx,
+                                    kb_fn_t pf_fn, const kb_case_t *ps_case) {
+  WORD32 idx = 12 + ps_case->i4_param;
+
+  UNUSED(ps_dec);
+  ((ih264_deblk_edge_bslt4_ft *) pf_fn)(
+      kb_org(ps_ctx, ps_ctx->pu1_src1), ps_ctx->i4_strd,
+      gau1_ih264d_alpha_table[idx], gau1_ih264d_beta_table[idx], 0x01020302,
+      gau1_ih264d_clip_table[idx]);
+}
+
+static void kb_run_deblk_chroma_bs4(dec_struct_t *ps_dec, kb_ctx_t *ps_ctx,
+                                    kb_fn_t pf_fn, const kb_case_t *ps_case) {
+  WORD32 idx_u = 12 + ps_case->i4_param;
+  WORD32 idx_v = idx_u - 2;
+
+  UNUSED(ps_dec);
+  ((ih264_deblk_chroma_edge_bs4_ft *) pf_fn)(
+      kb_org(ps_ctx, ps_ctx->pu1_src1), ps_ctx->i4_strd,
+      gau1_ih264d_alpha_table[idx_u], gau1_ih264d_beta_table[idx_u],
+      gau1_ih264d_alpha_table[idx_v], gau1_ih264d_beta_table[idx_v]);
+}
+
+static void kb_run_deblk_chroma_bslt4(dec_struct_t *ps_dec, kb_ctx_t *ps_ctx,
+                                      kb_fn_t pf_fn,
+                                      const kb_case_t *ps_case) {
+  WORD32 idx_u = 12 + ps_case->i4_param;
+  WORD32 idx_v = idx_u - 2;
+
+  UNUSED(ps_dec);
+  ((ih264_deblk_chroma_edge_bslt4_ft *) pf_fn)(
+      kb_org(ps_ctx, ps_ctx->pu1_src1), ps_ctx->i4_strd,
+      gau1_ih264d_alpha_table[idx_u], gau1_ih264d_beta_table[idx_u],
+      gau1_ih264d_alpha_table[idx_v], gau1_ih264d_beta_table[idx_v],
+      0x01020302, gau1_ih264d_clip_table[idx_u], gau1_ih264d_clip_table[idx_v]);
+}
+
+/* i4_param is qp; the coefficient block is reconstructed in place over the */
+/* prediction, as the decoder does                                          */
+static void kb_run_iquant_itrans_recon(dec_struct_t *ps_dec, kb_ctx_t *ps_ctx,
+                                       kb_fn_t pf_fn,
+                                       const kb_case_t *ps_case) {
+  UWORD8 *pu1_rec = kb_org(ps_ctx, ps_ctx->pu1_dst);
+  WORD32 i4_qp_rem6 = ps_case->i4_param % 6;
+  const UWORD16 *pu2_iscal = gau2_ih264_iquant_scale_4x4[i4_qp_rem6];
+
+  UNUSED(ps_dec);
+  if (8 == ps_case->i4_wd) pu2_iscal = gau1_ih264d_dequant8x8_cavlc[i4_qp_rem6];
+
+  ((ih264_iquant_itrans_recon_ft *) pf_fn)(
+      ps_ctx->pi2_coeff, pu1_rec, pu1_rec, ps_ctx->i4_strd, ps_ctx->i4_strd,
+      pu2_iscal, gau2_kb_flat_weigh, ps_case->i4_param / 6, ps_ctx->pi2_tmp,
+      0, ps_ctx->pi2_coeff);
+}
+
+static void kb_run_iquant_itrans_recon_chroma(dec_struct_t *ps_dec,
+                                              kb_ctx_t *ps_ctx, kb_fn_t pf_fn,
+                                              const kb_case_t *ps_case) {
+  UWORD8 *pu1_rec = kb_org(ps_ctx, ps_ctx->pu1_dst);
+
+  UNUSED(ps_dec);
+  ((ih264_iquant_itrans_recon_chroma_ft *) pf_fn)(
+      ps_ctx->pi2_coeff, pu1_rec, pu1_rec, ps_ctx->i4_strd, ps_ctx->i4_strd,
+      gau2_ih264_iquant_scale_4x4[ps_case->i4_param % 6], gau2_kb_flat_weigh,
+      ps_case->i4_param / 6, ps_ctx->pi2_tmp, ps_ctx->pi2_coeff);
+}
+
+static void kb_run_ihadamard_scaling(dec_struct_t *ps_dec, kb_ctx_t *ps_ctx,
+                                     kb_fn_t pf_fn, const kb_case_t *ps_case) {
+  UNUSED(ps_dec);
+  ((ih264_ihadamard_scaling_ft *) pf_fn)(
+      ps_ctx->pi2_coeff, ps_ctx->pi2_out,
+      gau2_ih264_iquant_scale_4x4[ps_case->i4_param % 6], gau2_kb_flat_weigh,
+      ps_case->i4_param / 6, ps_ctx->pi4_tmp);
+}
+
+/* All 16 luma blocks coded, as in a busy intra MB */
+static void kb_run_iquant_itrans_recon_luma_mb(dec_struct_t *ps_dec,
+                                               kb_ctx_t *ps_ctx, kb_fn_t pf_fn,
+                                               const kb_case_t *ps_case) {
+  ((void (*)(dec_struct_t *, WORD16 *, UWORD8 *, WORD32, const UWORD16 *,
+             const UWORD16 *, UWORD32, UWORD32, UWORD32, WORD32)) pf_fn)(
+      ps_dec, ps_ctx->pi2_coeff, kb_org(ps_ctx, ps_ctx->pu1_dst),
+      ps_ctx->i4_strd, gau2_ih264_iquant_scale_4x4[ps_case->i4_param % 6],
+      gau2_kb_flat_weigh, ps_case->i4_param / 6, 0xffff, 0, 0);
+}
+
+static void kb_run_iquant_itrans_recon_chroma_mb(dec_struct_t *ps_dec,
+                                                 kb_ctx_t *ps_ctx,
+                                                 kb_fn_t pf_fn,
+                                                 const kb_case_t *ps_case) {
+  const UWORD16 *pu2_iscal = gau2_ih264_iquant_scale_4x4[ps_case->i4_param % 6];
+
+  ((void (*)(dec_struct_t *, WORD16 *, UWORD8 *, WORD32, const UWORD16 *,
+             const UWORD16 *, const UWORD16 *, const UWORD16 *, UWORD32,
+             UWORD32, UWORD32)) pf_fn)(
+      ps_dec, ps_ctx->pi2_coeff, kb_org(ps_ctx, ps_ctx->pu1_dst),
+      ps_ctx->i4_strd, pu2_iscal, pu2_iscal, gau2_kb_flat_weigh,
+      gau2_kb_flat_weigh, ps_case->i4_param / 6, ps_case->i4_param / 6, 0xff);
+}
+
+/* i4_ht rows of i4_wd MBs, each row below the previous one as in the */
+/* decoder. Luma is filtered in place on src1 and chroma on dst        */
+static void kb_run_deblk_row(dec_struct_t *ps_dec, kb_ctx_t *ps_ctx,
+                             kb_fn_t pf_fn, const kb_case_t *ps_case) {
+  WORD32 i4_strd = ps_ctx->i4_strd;
+  UWORD8 *pu1_y = kb_org(ps_ctx, ps_ctx->pu1_src1);
+  UWORD8 *pu1_uv = kb_org(ps_ctx, ps_ctx->pu1_dst);
+  deblk_row_mb_t *ps_row_mb = ps_ctx->ps_deblk_row_mbs;
+  WORD32 i;
+
+  for (i = 0; i < ps_case->i4_ht; i++) {
+    ((void (*)(dec_struct_t *, UWORD8 *, UWORD8 *, WORD32, WORD32,
+               deblk_row_mb_t *, WORD32)) pf_fn)(
+        ps_dec, pu1_y, pu1_uv, i4_strd, i4_strd, ps_row_mb, ps_case->i4_wd);
+    pu1_y += i4_strd << 4;
+    pu1_uv += i4_strd << 3;
+    ps_row_mb += ps_case->i4_wd;
+  }
+}
+
+/* i4_wd MBs; the Bs tables are written to dst, starting from the Bs set */
+/* from the coded block patterns                                          */
+static void kb_run_fill_bs1(dec_struct_t *ps_dec, kb_ctx_t *ps_ctx,
+                            kb_fn_t pf_fn, const kb_case_t *ps_case) {
+  UWORD32 *pu4_bs = (UWORD32 *) ps_ctx->pu1_dst;
+  kb_bs_mb_t *ps_mb = ps_ctx->ps_bs_mbs;
+  WORD32 i;
+
+  UNUSED(ps_dec);
+  for (i = 0; i < ps_case->i4_wd; i++, ps_mb++, pu4_bs += 8) {
+    memcpy(pu4_bs, ps_mb->au4_bs, sizeof(ps_mb->au4_bs));
+    ((void (*)(mv_pred_t *, mv_pred_t *, void **, UWORD32 *, mv_pred_t *,
+               neighbouradd_t *, void **, WORD32)) pf_fn)(
+        ps_mb->as_cur, ps_mb->as_top, ps_ctx->ppv_bs_ref_map + 1, pu4_bs,
+        ps_mb->as_left, &ps_mb->s_left_addr, ps_mb->apv_top_addr,
+        ps_mb->i4_ver_mvlimit);
+  }
+}
+
+/* i4_param: 0 left, 1 right, 2 top, 3 bottom. For left/right i4_wd is the */
+/* pad size; for top/bottom it is the picture width and i4_ht the pad size  */
+static void kb_run_pad(dec_struct_t *ps_dec, kb_ctx_t *ps_ctx, kb_fn_t pf_fn,
+                       const kb_case_t *ps_case) {
+  UWORD8 *pu1_row0 = ps_ctx->pu1_src1 + KB_PAD_ROWS * ps_ctx->i4_strd;
+
+  UNUSED(ps_dec);
+  switch (ps_case->i4_param) {
+    case 0:
+      ((ih264_pad *) pf_fn)(pu1_row0 + ps_case->i4_wd, ps_ctx->i4_strd,
+                            ps_case->i4_ht, ps_case->i4_wd);
+      break;
+    case 1:
+      ((ih264_pad *) pf_fn)(pu1_row0 + ps_ctx->i4_strd - ps_case->i4_wd,
+                            ps_ctx->i4_strd, ps_case->i4_ht, ps_case->i4_wd);
+      break;
+    case 2:
+      ((ih264_pad *) pf_fn)(pu1_row0 + PAD_LEN_Y_H, ps_ctx->i4_strd,
+                            ps_case->i4_wd, ps_case->i4_ht);
+      break;
+    default:
+      ((ih264_pad *) pf_fn)(
+          pu1_row0 + (KB_ROWS - 1) * ps_ctx->i4_strd + PAD_LEN_Y_H,
+          ps_ctx->i4_strd, ps_case->i4_wd, ps_case->i4_ht);
+      break;
+  }
+}
+
+static void kb_run_memcpy_mul_8(dec_struct_t *ps_dec, kb_ctx_t *ps_ctx,
+                                kb_fn_t pf_fn, const kb_case_t *ps_case) {
+  UNUSED(ps_dec);
+  ((ih264_memcpy_mul_8_ft *) pf_fn)(kb_org(ps_ctx, ps_ctx->pu1_dst),
+                                    kb_org(ps_ctx, ps_ctx->pu1_src1),
+                                    ps_case->i4_wd);
+}
+
+/* The averages are written to pi2_out so that they are checked */
+static void kb_run_film_grain_avg_luma(dec_struct_t *ps_dec, kb_ctx_t *ps_ctx,
+                                       kb_fn_t pf_fn,
+                                       const kb_case_t *ps_case) {
+  UNUSED(ps_dec);
+  ((void (*)(const UWORD8 *, WORD32, WORD32, UWORD8 *)) pf_fn)(
+      kb_org(ps_ctx, ps_ctx->pu1_src1), ps_ctx->i4_strd, ps_case->i4_param,
+      (UWORD8 *) ps_ctx->pi2_out);
+}
+
+static void kb_run_film_grain_avg_chroma(dec_struct_t *ps_dec,
+                                         kb_ctx_t *ps_ctx, kb_fn_t pf_fn,
+                                         const kb_case_t *ps_case) {
+  UWORD8 *pu1_avg = (UWORD8 *) ps_ctx->pi2_out;
+
+  UNUSED(ps_dec);
+  ((void (*)(const UWORD8 *, WORD32, WORD32, UWORD8 *,
+             UWORD8 *)) pf_fn)(
+      kb_org(ps_ctx, ps_ctx->pu1_src1), ps_ctx->i4_strd, ps_case->i4_param,
+      pu1_avg, pu1_avg + ps_case->i4_param);
+}
+
+/* i4_param is the number of blocks. Every fifth block has no grain and */
+/* every third one a negative scale, within the +-255 the kernels take.  */
+/* The patterns are read from src1                                       */
+static void kb_run_film_grain_synth_row(dec_struct_t *ps_dec, kb_ctx_t *ps_ctx,
+                                        kb_fn_t pf_fn,
+                                        const kb_case_t *ps_case) {
+  film_grain_blk_t as_blk[KB_COEFF_SIZE / 8];
+  const WORD8 *pi1_pattern = (const WORD8 *) ps_ctx->pu1_src1;
+  WORD32 b;
+
+  UNUSED(ps_dec);
+  for (b = 0; b < ps_case->i4_param; b++) {
+    as_blk[b].pi1_pattern =
+        (4 == (b % 5)) ? NULL
+                       : pi1_pattern + (b % 7) * 8 * FG_PATTERN_SIZE + b * 8;
+    as_blk[b].i4_scale = (b * 37 + 3) & 255;
+    if (0 == (b % 3)) as_blk[b].i4_scale = -as_blk[b].i4_scale;
+  }
+  ((void (*)(WORD16 *, const film_grain_blk_t *, WORD32, WORD32,
+             WORD32)) pf_fn)(ps_ctx->pi2_out, as_blk, ps_case->i4_param, 5,
+                             6);
+}
+
+/* The grain comes from the coefficient buffer */
+static void kb_run_film_grain_blend(dec_struct_t *ps_dec, kb_ctx_t *ps_ctx,
+                                    kb_fn_t pf_fn, const kb_case_t *ps_case) {
+  UNUSED(ps_dec);
+  ((void (*)(UWORD8 *, const WORD16 *, WORD32)) pf_fn)(
+      kb_org(ps_ctx, ps_ctx->pu1_dst), ps_ctx->pi2_coeff, ps_case->i4_wd);
+}
+
+static void kb_run_film_grain_blend_uv(dec_struct_t *ps_dec, kb_ctx_t *ps_ctx,
+                                       kb_fn_t pf_fn,
+                                       const kb_case_t *ps_case) {
+  UNUSED(ps_dec);
+  ((void (*)(UWORD8 *, const WORD16 *, const WORD16 *, WORD32)) pf_fn)(
+      kb_org(ps_ctx, ps_ctx->pu1_dst), ps_ctx->pi2_coeff,
+      ps_ctx->pi2_coeff + KB_COEFF_SIZE / 2, ps_case->i4_wd);
+}
+
+/* Luma of i4_ht rows and chroma of half as many rows, read from src1 and */
+/* src2 and written one below the other in dst                            */
+static void kb_run_fmt_conv_420p(dec_struct_t *ps_dec, kb_ctx_t *ps_ctx,
+                                 kb_fn_t pf_fn, const kb_case_t *ps_case) {
+  WORD32 i4_strd = ps_ctx->i4_strd;
+  UWORD8 *pu1_y_dst = kb_org(ps_ctx, ps_ctx->pu1_dst);
+  UWORD8 *pu1_u_dst = pu1_y_dst + ps_case->i4_ht * i4_strd;
+  UWORD8 *pu1_v_dst = pu1_u_dst + (ps_case->i4_ht >> 1) * i4_strd;
+
+  UNUSED(ps_dec);
+  ((void (*)(UWORD8 *, UWORD8 *, UWORD8 *, UWORD8 *, UWORD8 *, WORD32, WORD32,
+             WORD32, WORD32, WORD32, WORD32, WORD32, WORD32)) pf_fn)(
+      kb_org(ps_ctx, ps_ctx->pu1_src1), kb_org(ps_ctx, ps_ctx->pu1_src2),
+      pu1_y_dst, pu1_u_dst, pu1_v_dst, ps_case->i4_wd, ps_case->i4_ht,
+      i4_strd, i4_strd, i4_strd, i4_strd, ps_case->i4_param, 0);
+}
+
+static void kb_run_fmt_conv_swap_uv(dec_struct_t *ps_dec, kb_ctx_t *ps_ctx,
+                                    kb_fn_t pf_fn, const kb_case_t *ps_case) {
+  WORD32 i4_strd = ps_ctx->i4_strd;
+  UWORD8 *pu1_y_dst = kb_org(ps_ctx, ps_ctx->pu1_dst);
+
+  UNUSED(ps_dec);
+  ((void (*)(UWORD8 *, UWORD8 *, UWORD8 *, UWORD8 *, WORD32, WORD32, WORD32,
+             WORD32, WORD32, WORD32)) pf_fn)(
+      kb_org(ps_ctx, ps_ctx->pu1_src1), kb_org(ps_ctx, ps_ctx->pu1_src2),
+      pu1_y_dst, pu1_y_dst + ps_case->i4_ht * i4_strd, ps_case->i4_wd,
+      ps_case->i4_ht, i4_strd, i4_strd, i4_strd, i4_strd);
+}
+
+/*****************************************************************************/
+/* Case list                                                                 */
+/*****************************************************************************/
+static void kb_add_case(kb_case_t *ps_cases, UWORD32 *pu4_num,
+                        const CHAR *pc_name,
+                        kb_run_ft *pf_run, UWORD32 u4_fn_off, WORD32 i4_wd,
+                        WORD32 i4_ht, WORD32 i4_param, UWORD32 u4_num_px) {
+  kb_case_t *ps_case = &ps_cases[(*pu4_num)++];
+
+  snprintf(ps_case->ac_name, sizeof(ps_case->ac_name), "%s", pc_name);
+  ps_case->pf_run = pf_run;
+  ps_case->u4_fn_off = u4_fn_off;
+  ps_case->i4_wd = i4_wd;
+  ps_case->i4_ht = i4_ht;
+  ps_case->i4_param = i4_param;
+  ps_case->u4_num_px = u4_num_px;
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : kb_build_cases                                           */
+/*                                                                           */
+/*  Description   : Lists every benchmarked call                             */
+/*                                                                           */
+/*  Inputs        : ps_cases : Array of at least KB_MAX_CASES entries        */
+/*                  i4_strd  : Stride of the work buffers                    */
+/*  Globals       :                                                          */
+/*  Processing    : Pixel counts are the samples a call produces. For the    */
+/*                  deblocking edges they are the samples on both sides of   */
+/*                  the edge that the filter may modify                      */
+/*                                                                           */
+/*  Outputs       : Case list                                                */
+/*  Returns       : Number of cases                                          */
+/*                                                                           */
+/*****************************************************************************/
+#define KB_MAX_CASES 128
+
+static UWORD32 kb_build_cases(kb_case_t *ps_cases, WORD32 i4_strd) {
+  WORD32 i4_pic_wd = i4_strd - 2 * PAD_LEN_Y_H;
+  static const WORD32 ai4_luma_sizes[][2] = {{16, 16}, {8, 8}, {4, 4}};
+  CHAR ac_name[64];
+  UWORD32 u4_num = 0;
+  UWORD32 i, dydx;
+
+  for (i = 0; i < sizeof(ai4_luma_sizes) / sizeof(ai4_luma_sizes[0]); i++) {
+    WORD32 wd = ai4_luma_sizes[i][0], ht = ai4_luma_sizes[i][1];
+
+    for (dydx = 0; dydx < 16; dydx++) {
+      sprintf(ac_name, "inter_pred_luma_%dx%d_dx%d_dy%d", wd, ht, dydx & 3,
+              dydx >> 2);
+      kb_add_case(ps_cases, &u4_num, ac_name, kb_run_inter_pred_luma,
+                  KB_FN_OFF(apf_inter_pred_luma) + dydx * sizeof(kb_fn_t), wd,
+                  ht, dydx, wd * ht);
+    }
+  }
+
+  /* Chroma widths are per plane; U and V are interleaved */
+  kb_add_case(ps_cases, &u4_num, "inter_pred_chroma_8x8_dx3_dy5",
+              kb_run_inter_pred_chroma, KB_FN_OFF(pf_inter_pred_chroma), 8, 8,
+              (5 << 3) | 3, 2 * 8 * 8);
+  kb_add_case(ps_cases, &u4_num, "inter_pred_chroma_4x4_dx3_dy5",
+              kb_run_inter_pred_chroma, KB_FN_OFF(pf_inter_pred_chroma), 4, 4,
+              (5 << 3) | 3, 2 * 4 * 4);
+  kb_add_case(ps_cases, &u4_num, "inter_pred_chroma_8x8_dx0_dy4",
+              kb_run_inter_pred_chroma, KB_FN_OFF(pf_inter_pred_chroma), 8, 8,
+              4 << 3, 2 * 8 * 8);
+
+  kb_add_case(ps_cases, &u4_num, "default_weighted_pred_luma_16x16",
+              kb_run_default_weighted_pred,
+              KB_FN_OFF(pf_default_weighted_pred_luma), 16, 16, 0, 16 * 16);
+  kb_add_case(ps_cases, &u4_num, "default_weighted_pred_chroma_8x8",
+              kb_run_default_weighted_pred,
+              KB_FN_OFF(pf_default_weighted_pred_chroma), 8, 8, 0, 2 * 8 * 8);
+  kb_add_case(ps_cases, &u4_num, "weighted_pred_luma_16x16",
+              kb_run_weighted_pred, KB_FN_OFF(pf_weighted_pred_luma), 16, 16,
+              0, 16 * 16);
+  kb_add_case(ps_cases, &u4_num, "weighted_pred_chroma_8x8",
+              kb_run_weighted_pred, KB_FN_OFF(pf_weighted_pred_chroma), 8, 8,
+              1, 2 * 8 * 8);
+  kb_add_case(ps_cases, &u4_num, "weighted_bi_pred_luma_16x16",
+              kb_run_weighted_bi_pred, KB_FN_OFF(pf_weighted_bi_pred_luma), 16,
+              16, 0, 16 * 16);
+  kb_add_case(ps_cases, &u4_num, "weighted_bi_pred_chroma_8x8",
+              kb_run_weighted_bi_pred, KB_FN_OFF(pf_weighted_bi_pred_chroma),
+              8, 8, 1, 2 * 8 * 8);
+
+  kb_add_case(ps_cases, &u4_num, "deblk_luma_vert_bs4", kb_run_deblk_luma_bs4,
+              KB_FN_OFF(pf_deblk_luma_vert_bs4), 8, 16, 36, 8 * 16);
+  kb_add_case(ps_cases, &u4_num, "deblk_luma_vert_bslt4",
+              kb_run_deblk_luma_bslt4, KB_FN_OFF(pf_deblk_luma_vert_bslt4), 8,
+              16, 36, 8 * 16);
+  kb_add_case(ps_cases, &u4_num, "deblk_luma_horz_bs4", kb_run_deblk_luma_bs4,
+              KB_FN_OFF(pf_deblk_luma_horz_bs4), 16, 8, 36, 8 * 16);
+  kb_add_case(ps_cases, &u4_num, "deblk_luma_horz_bslt4",
+              kb_run_deblk_luma_bslt4, KB_FN_OFF(pf_deblk_luma_horz_bslt4), 16,
+              8, 36, 8 * 16);
+  kb_add_case(ps_cases, &u4_num, "deblk_chroma_vert_bs4",
+              kb_run_deblk_chroma_bs4, KB_FN_OFF(pf_deblk_chroma_vert_bs4), 4,
+              8, 36, 2 * 4 * 8);
+  kb_add_case(ps_cases, &u4_num, "deblk_chroma_vert_bslt4",
+              kb_run_deblk_chroma_bslt4, KB_FN_OFF(pf_deblk_chroma_vert_bslt4),
+              4, 8, 36, 2 * 4 * 8);
+  kb_add_case(ps_cases, &u4_num, "deblk_chroma_horz_bs4",
+              kb_run_deblk_chroma_bs4, KB_FN_OFF(pf_deblk_chroma_horz_bs4), 8,
+              4, 36, 2 * 4 * 8);
+  kb_add_case(ps_cases, &u4_num, "deblk_chroma_horz_bslt4",
+              kb_run_deblk_chroma_bslt4, KB_FN_OFF(pf_deblk_chroma_horz_bslt4),
+              8, 4, 36, 2 * 4 * 8);
+
+  /* Only the non 16x16 variants, which evaluate all 32 edges */
+  kb_add_case(ps_cases, &u4_num, "fill_bs1_non16x16_pslice", kb_run_fill_bs1,
+              KB_FN_OFF(pf_fill_bs1) + 1 * sizeof(kb_fn_t), KB_BS_MBS, 1, 0,
+              KB_BS_MBS * 16 * 16);
+  kb_add_case(ps_cases, &u4_num, "fill_bs1_non16x16_bslice", kb_run_fill_bs1,
+              KB_FN_OFF(pf_fill_bs1) + 3 * sizeof(kb_fn_t), KB_BS_MBS, 1, 1,
+              KB_BS_MBS * 16 * 16);
+
+  kb_add_case(ps_cases, &u4_num, "deblk_row_nonmbaff", kb_run_deblk_row,
+              KB_FN_OFF(pf_deblk_row_nonmbaff), DEBLK_ROW_MBS, KB_DEBLK_ROWS,
+              0, DEBLK_ROW_MBS * KB_DEBLK_ROWS * 384);
+
+  kb_add_case(ps_cases, &u4_num, "iquant_itrans_recon_4x4",
+              kb_run_iquant_itrans_recon,
+              KB_FN_OFF(pf_iquant_itrans_recon_luma_4x4), 4, 4, 28, 16);
+  kb_add_case(ps_cases, &u4_num, "iquant_itrans_recon_4x4_dc",
+              kb_run_iquant_itrans_recon,
+              KB_FN_OFF(pf_iquant_itrans_recon_luma_4x4_dc), 4, 4, 28, 16);
+  kb_add_case(ps_cases, &u4_num, "iquant_itrans_recon_8x8",
+              kb_run_iquant_itrans_recon,
+              KB_FN_OFF(pf_iquant_itrans_recon_luma_8x8), 8, 8, 28, 64);
+  kb_add_case(ps_cases, &u4_num, "iquant_itrans_recon_8x8_dc",
+              kb_run_iquant_itrans_recon,
+              KB_FN_OFF(pf_iquant_itrans_recon_luma_8x8_dc), 8, 8, 28, 64);
+  kb_add_case(ps_cases, &u4_num, "iquant_itrans_recon_chroma_4x4",
+              kb_run_iquant_itrans_recon_chroma,
+              KB_FN_OFF(pf_iquant_itrans_recon_chroma_4x4), 4, 4, 28, 16);
+  kb_add_case(ps_cases, &u4_num, "iquant_itrans_recon_chroma_4x4_dc",
+              kb_run_iquant_itrans_recon_chroma,
+              KB_FN_OFF(pf_iquant_itrans_recon_chroma_4x4_dc), 4, 4, 28, 16);
+  kb_add_case(ps_cases, &u4_num, "ihadamard_scaling_4x4",
+              kb_run_ihadamard_scaling, KB_FN_OFF(pf_ihadamard_scaling_4x4), 4,
+              4, 28, 16);
+  kb_add_case(ps_cases, &u4_num, "iquant_itrans_recon_luma_4x4_mb",
+              kb_run_iquant_itrans_recon_luma_mb,
+              KB_FN_OFF(pf_iquant_itrans_recon_luma_4x4_mb), 16, 16, 28,
+              16 * 16);
+  kb_add_case(ps_cases, &u4_num, "iquant_itrans_recon_chroma_4x4_mb",
+              kb_run_iquant_itrans_recon_chroma_mb,
+              KB_FN_OFF(pf_iquant_itrans_recon_chroma_4x4_mb), 8, 8, 28,
+              2 * 8 * 8);
+
+  kb_add_case(ps_cases, &u4_num, "pad_left_luma", kb_run_pad,
+              KB_FN_OFF(pf_pad_left_luma), PAD_LEN_Y_H, KB_ROWS, 0,
+              PAD_LEN_Y_H * KB_ROWS);
+  kb_add_case(ps_cases, &u4_num, "pad_right_luma", kb_run_pad,
+              KB_FN_OFF(pf_pad_right_luma), PAD_LEN_Y_H, KB_ROWS, 1,
+              PAD_LEN_Y_H * KB_ROWS);
+  kb_add_case(ps_cases, &u4_num, "pad_left_chroma", kb_run_pad,
+              KB_FN_OFF(pf_pad_left_chroma), 2 * PAD_LEN_UV_H, KB_ROWS, 0,
+              2 * PAD_LEN_UV_H * KB_ROWS);
+  kb_add_case(ps_cases, &u4_num, "pad_right_chroma", kb_run_pad,
+              KB_FN_OFF(pf_pad_right_chroma), 2 * PAD_LEN_UV_H, KB_ROWS, 1,
+              2 * PAD_LEN_UV_H * KB_ROWS);
+  kb_add_case(ps_cases, &u4_num, "pad_top", kb_run_pad, KB_FN_OFF(pf_pad_top),
+              i4_pic_wd, PAD_LEN_Y_H, 2, i4_pic_wd * PAD_LEN_Y_H);
+  kb_add_case(ps_cases, &u4_num, "pad_bottom", kb_run_pad,
+              KB_FN_OFF(pf_pad_bottom), i4_pic_wd, PAD_LEN_Y_H, 3,
+              i4_pic_wd * PAD_LEN_Y_H);
+
+  kb_add_case(ps_cases, &u4_num, "memcpy_mul_8_64", kb_run_memcpy_mul_8,
+              KB_FN_MEMCPY_MUL_8, 64, 1, 0, 64);
+  kb_add_case(ps_cases, &u4_num, "memcpy_mul_8_1024", kb_run_memcpy_mul_8,
+              KB_FN_MEMCPY_MUL_8, 1024, 1, 0, 1024);
+
+  kb_add_case(ps_cases, &u4_num, "film_grain_avg_luma_33",
+              kb_run_film_grain_avg_luma, KB_FN_OFF(pf_film_grain_avg_luma),
+              33 * 8, 8, 33, 33 * 64);
+  kb_add_case(ps_cases, &u4_num, "film_grain_avg_chroma_33",
+              kb_run_film_grain_avg_chroma,
+              KB_FN_OFF(pf_film_grain_avg_chroma), 33 * 16, 8, 33, 33 * 128);
+  kb_add_case(ps_cases, &u4_num, "film_grain_synth_row_34",
+              kb_run_film_grain_synth_row,
+              KB_FN_OFF(pf_film_grain_synth_row), 34 * 8, 1, 34, 34 * 8);
+  kb_add_case(ps_cases, &u4_num, "film_grain_blend_150",
+              kb_run_film_grain_blend, KB_FN_OFF(pf_film_grain_blend), 150, 1,
+              0, 150);
+  kb_add_case(ps_cases, &u4_num, "film_grain_blend_uv_157",
+              kb_run_film_grain_blend_uv, KB_FN_OFF(pf_film_grain_blend_uv),
+              157, 1, 0, 2 * 157);
+
+  kb_add_case(ps_cases, &u4_num, "fmt_conv_420sp_to_420p_1912x16",
+              kb_run_fmt_conv_420p, KB_FN_OFF(pf_fmt_conv_420sp_to_420p), 1912,
+              16, 1, 1912 * 24);
+  kb_add_case(ps_cases, &u4_num, "fmt_conv_420sp_to_420p_vu_1912x16",
+              kb_run_fmt_conv_420p, KB_FN_OFF(pf_fmt_conv_420sp_to_420p), 1912,
+              16, 0, 1912 * 24);
+  kb_add_case(ps_cases, &u4_num, "fmt_conv_420sp_swap_uv_1912x16",
+              kb_run_fmt_conv_swap_uv,
+              KB_FN_OFF(pf_fmt_conv_420sp_to_420sp_swap_uv), 1912, 16, 0,
+              1912 * 24);
+
+  return u4_num;
+}
+
+/*****************************************************************************/
+/* Buffers                                                                   */
+/*****************************************************************************/
+static void kb_exit(const CHAR *pc_msg) {
+  printf("%s\n", pc_msg);
+  exit(-1);
+}
+
+static UWORD8 kb_clip_u8(WORD32 i4_val) {
+  return (UWORD8) ((i4_val < 0) ? 0 : ((i4_val > 255) ? 255 : i4_val));
+}
+
+/* Smooth content with a little noise and a few spikes, so that the    */
+/* deblocking filters both engage and get skipped across an edge        */
+static void kb_fill_plane(UWORD8 *pu1_buf, WORD32 i4_strd, WORD32 i4_rows,
+                          WORD32 i4_base) {
+  WORD32 x, y;
+
+  for (y = 0; y < i4_rows; y++) {
+    for (x = 0; x < i4_strd; x++) {
+      WORD32 i4_val = i4_base + ((x + 2 * y) >> 3) + kb_rand_range(3);
+
+      if (0 == (kb_rand() & 63)) i4_val += kb_rand_range(48);
+      pu1_buf[y * i4_strd + x] = kb_clip_u8(i4_val);
+    }
+  }
+}
+
+/* The base MV as in a larger partition, or one close to it so that the   */
+/* component differences fall on both sides of the Bs = 1 limits, or now  */
+/* and then an extreme value                                              */
+static WORD16 kb_bs_mv(WORD32 i4_base) {
+  UWORD32 u4_sel = kb_rand() & 31;
+
+  if (0 == u4_sel) return (kb_rand() & 1) ? 32767 : -32768;
+  if (u4_sel < 20) return (WORD16) i4_base;
+  return (WORD16) (i4_base + kb_rand_range(5));
+}
+
+static void kb_bs_fill_blk(mv_pred_t *ps_blk, const WORD32 *pi4_base) {
+  WORD32 k;
+
+  for (k = 0; k < 4; k++) ps_blk->i2_mv[k] = kb_bs_mv(pi4_base[k]);
+  /* L1 may be unused (-1); L0 of a P MB is always used */
+  ps_blk->i1_ref_frame[0] = (WORD8) (kb_rand() % KB_BS_NUM_REFS);
+  ps_blk->i1_ref_frame[1] =
+      (WORD8) ((WORD32) (kb_rand() % (KB_BS_NUM_REFS + 1)) - 1);
+  ps_blk->u1_col_ref_pic_idx = 0;
+  ps_blk->u1_pic_type = 0;
+}
+
+/* Bs of 2 where either side of an edge is coded, from random coded block */
+/* patterns of the MB and its neighbours, or 4 across an intra neighbour  */
+static void kb_bs_fill_bs2(UWORD32 *pu4_bs) {
+  UWORD32 u4_cur = kb_rand() & kb_rand() & 0xffff;
+  UWORD32 u4_top = kb_rand() & kb_rand() & 0xf;
+  UWORD32 u4_left = kb_rand() & kb_rand() & 0xf;
+  UWORD32 edge, i;
+
+  for (edge = 0; edge < 4; edge++) {
+    pu4_bs[edge] = 0;
+    pu4_bs[4 + edge] = 0;
+    for (i = 0; i < 4; i++) {
+      UWORD32 u4_q = (u4_cur >> ((edge << 2) + i)) & 1;
+      UWORD32 u4_top_p =
+          edge ? (u4_cur >> (((edge - 1) << 2) + i)) & 1 : (u4_top >> i) & 1;
+      UWORD32 u4_left_p =
+          edge ? (u4_cur >> ((i << 2) + edge - 1)) & 1 : (u4_left >> i) & 1;
+      UWORD32 u4_left_q = (u4_cur >> ((i << 2) + edge)) & 1;
+
+      /* Horz edge 'edge' at column i, vert edge 'edge' at row i */
+      if (u4_q | u4_top_p) pu4_bs[edge] |= 2 << (24 - (i << 3));
+      if (u4_left_q | u4_left_p) pu4_bs[4 + edge] |= 2 << (24 - (i << 3));
+    }
+  }
+  if (0 == (kb_rand() & 7)) pu4_bs[0] = 0x04040404;
+  if (0 == (kb_rand() & 7)) pu4_bs[4] = 0x04040404;
+}
+
+static void kb_init_bs_mbs(kb_ctx_t *ps_ctx) {
+  /* Any distinct addresses stand for the reference pictures */
+  static UWORD8 au1_pics[KB_BS_NUM_PICS];
+  UWORD32 i, j;
+
+  for (i = 0; i < KB_BS_MAP_SIZE; i++)
+    ps_ctx->ppv_bs_ref_map[i] = &au1_pics[kb_rand() % KB_BS_NUM_PICS];
+
+  for (i = 0; i < KB_BS_MBS; i++) {
+    kb_bs_mb_t *ps_mb = &ps_ctx->ps_bs_mbs[i];
+    WORD32 ai4_base[4];
+
+    for (j = 0; j < 4; j++) ai4_base[j] = kb_rand_range(64);
+    /* Same MVs in both lists, so that the fwd-bwd pairing decides Bs when */
+    /* the references are swapped across an edge                           */
+    if (kb_rand() & 1) {
+      ai4_base[2] = ai4_base[0];
+      ai4_base[3] = ai4_base[1];
+    }
+    for (j = 0; j < 16; j++) {
+      kb_bs_fill_blk(&ps_mb->as_cur[j], ai4_base);
+      kb_bs_fill_blk(&ps_mb->as_left[j], ai4_base);
+    }
+    for (j = 0; j < 4; j++) {
+      kb_bs_fill_blk(&ps_mb->as_top[j], ai4_base);
+      ps_mb->s_left_addr.u4_add[j] =
+          &au1_pics[kb_rand() % KB_BS_NUM_PICS];
+      ps_mb->apv_top_addr[j] = &au1_pics[kb_rand() % KB_BS_NUM_PICS];
+    }
+    kb_bs_fill_bs2(ps_mb->au4_bs);
+    /* Field MBs have half the vertical limit */
+    ps_mb->i4_ver_mvlimit = (kb_rand() & 1) ? 4 : 2;
+  }
+}
+
+/* Bs of the four edge segments, each 0 to u4_max */
+static UWORD32 kb_deblk_bs(UWORD32 u4_max) {
+  UWORD32 u4_bs = 0;
+  UWORD32 i;
+
+  for (i = 0; i < 4; i++) u4_bs = (u4_bs << 8) | (kb_rand() % (u4_max + 1));
+  return u4_bs;
+}
+
+/* Bs 4 on the MB edges and 3 on the inner edges of intra MBs, 0 to 2     */
+/* otherwise. alpha, beta and tc0 of each edge type and component are     */
+/* drawn independently over the whole QP range with the slice offsets    */
+static void kb_init_deblk_row_mbs(kb_ctx_t *ps_ctx) {
+  UWORD32 i, edge, t, c;
+
+  for (i = 0; i < KB_DEBLK_ROWS * DEBLK_ROW_MBS; i++) {
+    deblk_row_mb_t *ps_row_mb = &ps_ctx->ps_deblk_row_mbs[i];
+    WORD32 i4_intra = (0 == (kb_rand() & 3));
+
+    for (edge = 0; edge < 8; edge += 4) {
+      if (i4_intra || (0 == (kb_rand() & 7)))
+        ps_row_mb->au4_bs[edge] = 0x04040404;
+      else
+        ps_row_mb->au4_bs[edge] = (kb_rand() & 1) ? kb_deblk_bs(2) : 0;
+    }
+    for (edge = 1; edge < 4; edge++) {
+      ps_row_mb->au4_bs[edge] = i4_intra ? 0x03030303 : kb_deblk_bs(2);
+      ps_row_mb->au4_bs[4 + edge] = i4_intra ? 0x03030303 : kb_deblk_bs(2);
+    }
+
+    for (t = 0; t < NUM_DEBLK_EDGE_TYPES; t++) {
+      for (c = 0; c < 3; c++) {
+        WORD32 idx_a = kb_rand() % 52;
+        WORD32 idx_b = idx_a + kb_rand_range(12);
+
+        idx_b = CLIP3(0, 51, idx_b);
+
+        ps_row_mb->au1_alpha[t][c] = gau1_ih264d_alpha_table[12 + idx_a];
+        ps_row_mb->au1_beta[t][c] = gau1_ih264d_beta_table[12 + idx_b];
+        ps_row_mb->apu1_cliptab[t][c] = gau1_ih264d_clip_table[12 + idx_a];
+      }
+    }
+  }
+}
+
+static void kb_init_ctx(kb_ctx_t *ps_ctx, WORD32 i4_strd) {
+  WORD32 i4_rows = 2 * KB_PAD_ROWS + KB_ROWS;
+  UWORD32 i;
+
+  memset(ps_ctx, 0, sizeof(kb_ctx_t));
+  ps_ctx->i4_strd = i4_strd;
+  ps_ctx->u4_buf_size = i4_rows * i4_strd;
+
+  ps_ctx->pu1_src1_org = kb_aligned_malloc(ps_ctx->u4_buf_size);
+  ps_ctx->pu1_src2_org = kb_aligned_malloc(ps_ctx->u4_buf_size);
+  ps_ctx->pu1_dst_org = kb_aligned_malloc(ps_ctx->u4_buf_size);
+  ps_ctx->pu1_src1 = kb_aligned_malloc(ps_ctx->u4_buf_size);
+  ps_ctx->pu1_src2 = kb_aligned_malloc(ps_ctx->u4_buf_size);
+  ps_ctx->pu1_dst = kb_aligned_malloc(ps_ctx->u4_buf_size);
+  ps_ctx->pu1_tmp = kb_aligned_malloc(KB_TMP_SIZE);
+  ps_ctx->pi2_coeff_org = kb_aligned_malloc(KB_COEFF_SIZE * sizeof(WORD16));
+  ps_ctx->pi2_coeff = kb_aligned_malloc(KB_COEFF_SIZE * sizeof(WORD16));
+  ps_ctx->pi2_out = kb_aligned_malloc(KB_COEFF_SIZE * sizeof(WORD16));
+  ps_ctx->pi2_tmp = kb_aligned_malloc(KB_TMP_SIZE);
+  ps_ctx->pi4_tmp = kb_aligned_malloc(KB_TMP_SIZE);
+  ps_ctx->ps_bs_mbs = kb_aligned_malloc(KB_BS_MBS * sizeof(kb_bs_mb_t));
+  ps_ctx->ppv_bs_ref_map = kb_aligned_malloc(KB_BS_MAP_SIZE * sizeof(void *));
+  ps_ctx->ps_deblk_row_mbs = kb_aligned_malloc(
+      KB_DEBLK_ROWS * DEBLK_ROW_MBS * sizeof(deblk_row_mb_t));
+
+  if ((NULL == ps_ctx->pu1_src1_org) || (NULL == ps_ctx->pu1_src2_org) ||
+      (NULL == ps_ctx->pu1_dst_org) || (NULL == ps_ctx->pu1_src1) ||
+      (NULL == ps_ctx->pu1_src2) || (NULL == ps_ctx->pu1_dst) ||
+      (NULL == ps_ctx->pu1_tmp) || (NULL == ps_ctx->pi2_coeff_org) ||
+      (NULL == ps_ctx->pi2_coeff) || (NULL == ps_ctx->pi2_out) ||
+      (NULL == ps_ctx->pi2_tmp) || (NULL == ps_ctx->pi4_tmp) ||
+      (NULL == ps_ctx->ps_bs_mbs) || (NULL == ps_ctx->ppv_bs_ref_map) ||
+      (NULL == ps_ctx->ps_deblk_row_mbs))
+    kb_exit("Allocation failed");
+
+  kb_fill_plane(ps_ctx->pu1_src1_org, i4_strd, i4_rows, 96);
+  kb_fill_plane(ps_ctx->pu1_src2_org, i4_strd, i4_rows, 120);
+  kb_fill_plane(ps_ctx->pu1_dst_org, i4_strd, i4_rows, 80);
+
+  /* Mostly low frequency coefficients, as after quantization */
+  for (i = 0; i < KB_COEFF_SIZE; i++) {
+    WORD32 i4_lim = ((i & 15) < 4) ? 24 : 4;
+
+    ps_ctx->pi2_coeff_org[i] = (WORD16) kb_rand_range(i4_lim);
+  }
+
+  kb_init_bs_mbs(ps_ctx);
+  kb_init_deblk_row_mbs(ps_ctx);
+}
+
+static void kb_free_ctx(kb_ctx_t *ps_ctx) {
+  free(ps_ctx->pu1_src1_org);
+  free(ps_ctx->pu1_src2_org);
+  free(ps_ctx->pu1_dst_org);
+  free(ps_ctx->pu1_src1);
+  free(ps_ctx->pu1_src2);
+  free(ps_ctx->pu1_dst);
+  free(ps_ctx->pu1_tmp);
+  free(ps_ctx->pi2_coeff_org);
+  free(ps_ctx->pi2_coeff);
+  free(ps_ctx->pi2_out);
+  free(ps_ctx->pi2_tmp);
+  free(ps_ctx->pi4_tmp);
+  free(ps_ctx->ps_bs_mbs);
+  free(ps_ctx->ppv_bs_ref_map);
+  free(ps_ctx->ps_deblk_row_mbs);
+}
+
+static void kb_reset_work(kb_ctx_t *ps_ctx) {
+  memcpy(ps_ctx->pu1_src1, ps_ctx->pu1_src1_org, ps_ctx->u4_buf_size);
+  memcpy(ps_ctx->pu1_src2, ps_ctx->pu1_src2_org, ps_ctx->u4_buf_size);
+  memcpy(ps_ctx->pu1_dst, ps_ctx->pu1_dst_org, ps_ctx->u4_buf_size);
+  memcpy(ps_ctx->pi2_coeff, ps_ctx->pi2_coeff_org,
+         KB_COEFF_SIZE * sizeof(WORD16));
+  memset(ps_ctx->pi2_out, 0, KB_COEFF_SIZE * sizeof(WORD16));
+}
+
+/*****************************************************************************/
+/* Check and timing                                                          */
+/*****************************************************************************/
+/* Output of the reference tier for the case being checked */
+typedef struct {
+  UWORD8 *pu1_src1;
+  UWORD8 *pu1_dst;
+  WORD16 *pi2_coeff;
+  WORD16 *pi2_out;
+} kb_ref_t;
+
+static void kb_save_ref(kb_ref_t *ps_ref, kb_ctx_t *ps_ctx) {
+  memcpy(ps_ref->pu1_src1, ps_ctx->pu1_src1, ps_ctx->u4_buf_size);
+  memcpy(ps_ref->pu1_dst, ps_ctx->pu1_dst, ps_ctx->u4_buf_size);
+  memcpy(ps_ref->pi2_coeff, ps_ctx->pi2_coeff, KB_COEFF_SIZE * sizeof(WORD16));
+  memcpy(ps_ref->pi2_out, ps_ctx->pi2_out, KB_COEFF_SIZE * sizeof(WORD16));
+}
+
+/* Every byte a kernel may write is compared, so writes outside the block */
+/* are caught as well                                                     */
+static WORD32 kb_matches_ref(kb_ref_t *ps_ref, kb_ctx_t *ps_ctx) {
+  return (0 == memcmp(ps_ref->pu1_src1, ps_ctx->pu1_src1,
+                      ps_ctx->u4_buf_size)) &&
+         (0 == memcmp(ps_ref->pu1_dst, ps_ctx->pu1_dst,
+                      ps_ctx->u4_buf_size)) &&
+         (0 == memcmp(ps_ref->pi2_coeff, ps_ctx->pi2_coeff,
+                      KB_COEFF_SIZE * sizeof(WORD16))) &&
+         (0 == memcmp(ps_ref->pi2_out, ps_ctx->pi2_out,
+                      KB_COEFF_SIZE * sizeof(WORD16)));
+}
+
+/* Best of u4_rounds runs of u4_calls back to back calls, in timer ticks */
+/* per call                                                              */
+static double kb_time_case(dec_struct_t *ps_dec, kb_ctx_t *ps_ctx,
+                           kb_fn_t pf_fn, const kb_case_t *ps_case,
+                           UWORD32 u4_calls, UWORD32 u4_rounds) {
+  UWORD64 u8_best = 0;
+  UWORD32 u4_round, u4_call;
+
+  for (u4_round = 0; u4_round < u4_rounds; u4_round++) {
+    UWORD64 u8_start, u8_ticks;
+
+    kb_reset_work(ps_ctx);
+    u8_start = kb_timer();
+    for (u4_call = 0; u4_call < u4_calls; u4_call++)
+      ps_case->pf_run(ps_dec, ps_ctx, pf_fn, ps_case);
+    u8_ticks = kb_timer() - u8_start;
+
+    if ((0 == u4_round) || (u8_ticks < u8_best)) u8_best = u8_ticks;
+  }
+  return (double) u8_best / u4_calls;
+}
+
+static void kb_usage(void) {
+  printf("Usage: app264_microbench [options]\n");
+  printf("  --filter <str>          Only run cases whose name contains str\n");
+  printf("  --calls <n>             Calls per timed round (Default: %d)\n",
+         KB_DEFAULT_CALLS);
+  printf("  --rounds <n>            Timed rounds, best is reported "
+         "(Default: %d)\n", KB_DEFAULT_ROUNDS);
+  printf("  --stride <n>            Stride of the buffers (Default: %d)\n",
+         KB_DEFAULT_STRD);
+  printf("  --list                  List the cases and exit\n");
+}
+
+int main(WORD32 argc, CHAR *argv[]) {
+  kb_case_t as_cases[KB_MAX_CASES];
+  dec_struct_t *aps_dec[KB_NUM_TIERS];
+  kb_ctx_t s_ctx;
+  kb_ref_t s_ref;
+  const CHAR *pc_filter = NULL;
+  UWORD32 u4_calls = KB_DEFAULT_CALLS;
+  UWORD32 u4_rounds = KB_DEFAULT_ROUNDS;
+  WORD32 i4_strd = KB_DEFAULT_STRD;
+  WORD32 i4_list = 0;
+  UWORD32 u4_num_cases, u4_case, u4_tier;
+  UWORD32 u4_num_run = 0, u4_num_mismatch = 0;
+  WORD32 i;
+
+  for (i = 1; i < argc; i++) {
+    CHAR *pc_arg = argv[i];
+    CHAR *pc_value = (i + 1 < argc) ? argv[i + 1] : NULL;
+
+    if ((0 == strcmp(pc_arg, "--help")) || (0 == strcmp(pc_arg, "-h"))) {
+      kb_usage();
+      return 0;
+    }
+    if (0 == strcmp(pc_arg, "--list")) {
+      i4_list = 1;
+      continue;
+    }
+    if (NULL == pc_value) {
+      kb_usage();
+      kb_exit("Missing value for the last argument");
+    }
+    i++;
+
+    if (0 == strcmp(pc_arg, "--filter")) {
+      pc_filter = pc_value;
+    } else if (0 == strcmp(pc_arg, "--calls")) {
+      u4_calls = atoi(pc_value);
+    } else if (0 == strcmp(pc_arg, "--rounds")) {
+      u4_rounds = atoi(pc_value);
+    } else if (0 == strcmp(pc_arg, "--stride")) {
+      i4_strd = atoi(pc_value);
+    } else {
+      kb_usage();
+      kb_exit("Unknown argument");
+    }
+  }
+
+  /* Room for the block origin, the widest block and its filter taps; */
+  /* chroma kernels need an even stride                               */
+  if ((i4_strd < KB_ORG_COL + 2 * PAD_LEN_Y_H + 64) || (i4_strd & 1))
+    kb_exit("Invalid --stride");
+  if ((0 == u4_calls) || (0 == u4_rounds))
+    kb_exit("--calls and --rounds must be non zero");
+
+  u4_num_cases = kb_build_cases(as_cases, i4_strd);
+  if (i4_list) {
+    for (u4_case = 0; u4_case < u4_num_cases; u4_case++)
+      printf("%s\n", as_cases[u4_case].ac_name);
+    return 0;
+  }
+
+  /* One decoder context per tier, holding only its function pointers */
+  for (u4_tier = 0; u4_tier < KB_NUM_TIERS; u4_tier++) {
+    aps_dec[u4_tier] = calloc(1, sizeof(dec_struct_t));
+    if (NULL == aps_dec[u4_tier]) kb_exit("Allocation failed");
+    aps_dec[u4_tier]->e_processor_arch = gas_kb_tiers[u4_tier].e_arch;
+    ih264d_init_function_ptr(aps_dec[u4_tier]);
+  }
+
+  kb_init_ctx(&s_ctx, i4_strd);
+  s_ref.pu1_src1 = kb_aligned_malloc(s_ctx.u4_buf_size);
+  s_ref.pu1_dst = kb_aligned_malloc(s_ctx.u4_buf_size);
+  s_ref.pi2_coeff = kb_aligned_malloc(KB_COEFF_SIZE * sizeof(WORD16));
+  s_ref.pi2_out = kb_aligned_malloc(KB_COEFF_SIZE * sizeof(WORD16));
+  if ((NULL == s_ref.pu1_src1) || (NULL == s_ref.pu1_dst) ||
+      (NULL == s_ref.pi2_coeff) || (NULL == s_ref.pi2_out))
+    kb_exit("Allocation failed");
+
+#ifdef X86
+  printf("%-36s", "Kernel (TSC cycles/pixel)");
+#else
+  printf("%-36s", "Kernel (ns/pixel)");
+#endif
+  for (u4_tier = 0; u4_tier < KB_NUM_TIERS; u4_tier++)
+    printf(" %18s", gas_kb_tiers[u4_tier].pc_name);
+  printf("\n");
+
+  for (u4_case = 0; u4_case < u4_num_cases; u4_case++) {
+    const kb_case_t *ps_case = &as_cases[u4_case];
+    kb_fn_t pf_ref = kb_get_fn(aps_dec[0], &gas_kb_tiers[0], ps_case);
+    double d_ref_px = 0;
+
+    if (pc_filter && (NULL == strstr(ps_case->ac_name, pc_filter))) continue;
+    u4_num_run++;
+
+    kb_reset_work(&s_ctx);
+    ps_case->pf_run(aps_dec[0], &s_ctx, pf_ref, ps_case);
+    kb_save_ref(&s_ref, &s_ctx);
+
+    printf("%-36s", ps_case->ac_name);
+    for (u4_tier = 0; u4_tier < KB_NUM_TIERS; u4_tier++) {
+      kb_fn_t pf_fn = kb_get_fn(aps_dec[u4_tier], &gas_kb_tiers[u4_tier],
+                                ps_case);
+      double d_px;
+      CHAR ac_cell[32];
+
+      if (u4_tier) {
+        kb_reset_work(&s_ctx);
+        ps_case->pf_run(aps_dec[u4_tier], &s_ctx, pf_fn, ps_case);
+        if (!kb_matches_ref(&s_ref, &s_ctx)) {
+          printf(" %18s", "MISMATCH");
+          u4_num_mismatch++;
+          continue;
+        }
+      }
+
+      d_px = kb_time_case(aps_dec[u4_tier], &s_ctx, pf_fn, ps_case, u4_calls,
+                          u4_rounds) /
+             ps_case->u4_num_px;
+      if (0 == u4_tier) {
+        d_ref_px = d_px;
+        snprintf(ac_cell, sizeof(ac_cell), "%.3f", d_px);
+      } else {
+        /* (C) marks a tier that falls back to the generic kernel */
+        snprintf(ac_cell, sizeof(ac_cell), "%.3f x%.2f%s", d_px,
+                 d_ref_px / d_px, (pf_fn == pf_ref) ? "(C)" : "");
+      }
+      printf(" %18s", ac_cell);
+    }
+    printf("\n");
+  }
+
+  printf("%u cases, %u mismatches\n", u4_num_run, u4_num_mismatch);
+
+  free(s_ref.pu1_src1);
+  free(s_ref.pu1_dst);
+  free(s_ref.pi2_coeff);
+  free(s_ref.pi2_out);
+  kb_free_ctx(&s_ctx);
+  for (u4_tier = 0; u4_tier < KB_NUM_TIERS; u4_tier++) free(aps_dec[u4_tier]);
+
+  return u4_num_mismatch ? 1 : 0;
+}